@@ -56,6 +56,7 @@ set(INCLUDE_PATHS   ${TRPC_ROOT_PATH}
                     ${TRPC_ROOT_PATH}/cmake_third_party/picohttpparser
                     ${TRPC_ROOT_PATH}/cmake_third_party/snappy
                     ${TRPC_ROOT_PATH}/cmake_third_party/lz4
+                    ${TRPC_ROOT_PATH}/cmake_third_party/zstd/lib
                     ${TRPC_ROOT_PATH}/cmake_third_party/jwt_cpp/include)
 
 # When use tRPC as a third-party library, selectively inject the header files at including any-lib.cmake.
@@ -106,6 +107,7 @@ set(LIBS_BASIC
                     nghttp2
                     snappy
                     lz4
+                    zstd
                     flatbuffers
                     pthread
                     z
@@ -0,0 +1,65 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#include "test/end2end/unary/http/http2_server.h"
+
+#include "test/end2end/common/util.h"
+#include "trpc/common/trpc_app.h"
+#include "trpc/util/http/function_handlers.h"
+#include "trpc/util/http/routes.h"
+
+namespace trpc::testing {
+
+::trpc::Status TestPostString(::trpc::ServerContextPtr context, ::trpc::http::HttpRequestPtr req,
+                              ::trpc::http::HttpReply* rsp) {
+  if (req->GetContent() == "test-string-req") {
+    rsp->SetContent("test-string-rsp");
+  } else {
+    rsp->SetContent("error");
+  }
+  return ::trpc::kSuccStatus;
+}
+
+// Echoes the query parameter, to check that query strings survive HTTP/2.
+::trpc::Status TestGetQuery(::trpc::ServerContextPtr context, ::trpc::http::HttpRequestPtr req,
+                            ::trpc::http::HttpReply* rsp) {
+  rsp->SetContent("hello " + req->GetQueryParameter("name", "nobody"));
+  return ::trpc::kSuccStatus;
+}
+
+void SetHttpRoutes(::trpc::http::HttpRoutes& r) {
+  r.Add(::trpc::http::OperationType::POST, trpc::http::Path("/test-post-string"),
+        std::make_shared<::trpc::http::FuncHandler>(TestPostString, "text"));
+  r.Add(::trpc::http::OperationType::GET, trpc::http::Path("/test-get-query"),
+        std::make_shared<::trpc::http::FuncHandler>(TestGetQuery, "text"));
+}
+
+int Http2Server::Initialize() {
+  // Register two services of "http2" protocol:
+  // http2_service_h2c: Without SSL, serves h2c (prior knowledge or upgraded) and HTTP/1.1.
+  // http2_service_h2: With SSL, serves h2 and HTTP/1.1 as negotiated by ALPN.
+  bool auto_start = true;
+  auto http2_service_h2c = std::make_shared<::trpc::HttpService>();
+  http2_service_h2c->SetRoutes(SetHttpRoutes);
+  RegisterService("http2_service_h2c", http2_service_h2c, auto_start);
+  auto http2_service_h2 = std::make_shared<::trpc::HttpService>();
+  http2_service_h2->SetRoutes(SetHttpRoutes);
+  RegisterService("http2_service_h2", http2_service_h2, auto_start);
+
+  test_signal_->SignalClientToContinue();
+
+  return 0;
+}
+
+void Http2Server::Destroy() { GcovFlush(); }
+
+}  // namespace trpc::testing
@@ -0,0 +1,31 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#pragma once
+
+#include "test/end2end/common/test_signaller.h"
+#include "trpc/common/trpc_app.h"
+
+namespace trpc::testing {
+
+// HTTP/2 server, serving h2c and h2 as well as HTTP/1.1 on the same ports.
+class Http2Server : public ::trpc::TrpcApp {
+ public:
+  explicit Http2Server(TestSignaller* test_signal) : test_signal_(test_signal) {}
+  int Initialize() override;
+  void Destroy() override;
+
+ private:
+  TestSignaller* test_signal_{nullptr};
+};
+
+}  // namespace trpc::testing
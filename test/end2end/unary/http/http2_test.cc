@@ -0,0 +1,273 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "test/end2end/common/subprocess.h"
+#include "test/end2end/common/util.h"
+#include "test/end2end/unary/http/http2_server.h"
+#include "trpc/client/http/http_service_proxy.h"
+#include "trpc/future/future_utility.h"
+
+int test_argc;
+char** client_argv;
+char** server_argv;
+
+namespace trpc::testing {
+
+class Http2Test : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    // Run before the first test case.
+    test_signal_ = std::make_unique<TestSignaller>();
+    server_process_ = std::make_unique<SubProcess>([]() {
+      Http2Server server(test_signal_.get());
+      server.Main(test_argc, server_argv);
+      server.Wait();
+    });
+    // Wait for the server to start.
+    test_signal_->ClientWaitToContinue();
+
+    InitializeRuntimeEnv(test_argc, client_argv);
+    http2_proxy_h2c_ = ::trpc::GetTrpcClient()->GetProxy<::trpc::http::HttpServiceProxy>("http2_client_h2c");
+    http2_proxy_h2_ = ::trpc::GetTrpcClient()->GetProxy<::trpc::http::HttpServiceProxy>("http2_client_h2");
+    http_proxy_h2c_ = ::trpc::GetTrpcClient()->GetProxy<::trpc::http::HttpServiceProxy>("http_client_h2c");
+    http_proxy_h2_ = ::trpc::GetTrpcClient()->GetProxy<::trpc::http::HttpServiceProxy>("http_client_h2");
+  }
+
+  static void TearDownTestSuite() {
+    // After the last test case.
+    // Destroy the client environment.
+    DestroyRuntimeEnv();
+    // Kill the server.
+    server_process_.reset();
+  }
+
+  void SetUp() override {}
+
+  void TearDown() override {}
+
+ protected:
+  static std::unique_ptr<TestSignaller> test_signal_;
+  static std::unique_ptr<SubProcess> server_process_;
+
+ public:
+  // Clients of "http2" protocol, speaking h2c with prior knowledge and h2.
+  static std::shared_ptr<::trpc::http::HttpServiceProxy> http2_proxy_h2c_;
+  static std::shared_ptr<::trpc::http::HttpServiceProxy> http2_proxy_h2_;
+  // Clients of "http" protocol, served over HTTP/1.1 by the same services.
+  static std::shared_ptr<::trpc::http::HttpServiceProxy> http_proxy_h2c_;
+  static std::shared_ptr<::trpc::http::HttpServiceProxy> http_proxy_h2_;
+};
+
+std::unique_ptr<TestSignaller> Http2Test::test_signal_;
+std::unique_ptr<SubProcess> Http2Test::server_process_;
+std::shared_ptr<::trpc::http::HttpServiceProxy> Http2Test::http2_proxy_h2c_;
+std::shared_ptr<::trpc::http::HttpServiceProxy> Http2Test::http2_proxy_h2_;
+std::shared_ptr<::trpc::http::HttpServiceProxy> Http2Test::http_proxy_h2c_;
+std::shared_ptr<::trpc::http::HttpServiceProxy> Http2Test::http_proxy_h2_;
+
+void TestPostString(std::shared_ptr<::trpc::http::HttpServiceProxy> proxy) {
+  ::trpc::ClientContextPtr ctx = ::trpc::MakeClientContext(proxy);
+  std::string rsp;
+  ::trpc::Status status = proxy->Post(ctx, "http://test.com/test-post-string", std::string("test-string-req"), &rsp);
+  ASSERT_TRUE(status.OK()) << status.ToString();
+  ASSERT_EQ(rsp, "test-string-rsp");
+}
+
+void TestAsyncPostString(std::shared_ptr<::trpc::http::HttpServiceProxy> proxy) {
+  ::trpc::ClientContextPtr ctx = ::trpc::MakeClientContext(proxy);
+  bool succ = false;
+  std::string rsp;
+  ::trpc::Future<> fut = proxy->AsyncPost(ctx, "http://test.com/test-post-string", std::string("test-string-req"))
+                             .Then([&](::trpc::Future<std::string>&& response) {
+                               succ = !response.IsFailed();
+                               if (succ) {
+                                 rsp = response.GetValue0();
+                               }
+                               return ::trpc::MakeReadyFuture<>();
+                             });
+  future::BlockingGet(std::move(fut));
+  ASSERT_TRUE(succ);
+  ASSERT_EQ(rsp, "test-string-rsp");
+}
+
+void TestGetQuery(std::shared_ptr<::trpc::http::HttpServiceProxy> proxy) {
+  ::trpc::ClientContextPtr ctx = ::trpc::MakeClientContext(proxy);
+  std::string rsp;
+  ::trpc::Status status = proxy->GetString(ctx, "http://test.com/test-get-query?name=trpc", &rsp);
+  ASSERT_TRUE(status.OK()) << status.ToString();
+  ASSERT_EQ(rsp, "hello trpc");
+}
+
+// Testing case:
+// PostString over h2c with prior knowledge, HttpService <-> HttpServiceProxy both of "http2" protocol.
+TEST_F(Http2Test, TestPostStringH2c) {
+  RunByEnv([&]() { TestPostString(http2_proxy_h2c_); });
+}
+TEST_F(Http2Test, TestAsyncPostStringH2c) {
+  RunByEnv([&]() { TestAsyncPostString(http2_proxy_h2c_); });
+}
+
+// Testing case:
+// PostString over h2, which is negotiated by ALPN.
+TEST_F(Http2Test, TestPostStringH2) {
+  RunByEnv([&]() { TestPostString(http2_proxy_h2_); });
+}
+TEST_F(Http2Test, TestAsyncPostStringH2) {
+  RunByEnv([&]() { TestAsyncPostString(http2_proxy_h2_); });
+}
+
+// Testing case:
+// The query string of the request reaches the handler over both h2c and h2.
+TEST_F(Http2Test, TestGetQueryH2c) {
+  RunByEnv([&]() { TestGetQuery(http2_proxy_h2c_); });
+}
+TEST_F(Http2Test, TestGetQueryH2) {
+  RunByEnv([&]() { TestGetQuery(http2_proxy_h2_); });
+}
+
+// Testing case:
+// HTTP/1.1 clients are served on the same ports, detected by the first bytes without SSL and by ALPN with SSL.
+TEST_F(Http2Test, TestPostStringHttp1FallbackCleartext) {
+  RunByEnv([&]() {
+    TestPostString(http_proxy_h2c_);
+    TestGetQuery(http_proxy_h2c_);
+  });
+}
+TEST_F(Http2Test, TestPostStringHttp1FallbackAlpn) {
+  RunByEnv([&]() {
+    TestPostString(http_proxy_h2_);
+    TestGetQuery(http_proxy_h2_);
+  });
+}
+
+int ConnectTo(const std::string& target) {
+  auto pos = target.find(':');
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(std::stoi(target.substr(pos + 1)));
+  inet_pton(AF_INET, target.substr(0, pos).c_str(), &addr.sin_addr);
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  timeval timeout{3, 0};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// Reads from `fd` until `buf` holds at least `size` bytes.
+bool ReadAtLeast(int fd, std::string* buf, size_t size) {
+  char tmp[4096];
+  while (buf->size() < size) {
+    ssize_t n = read(fd, tmp, sizeof(tmp));
+    if (n <= 0) return false;
+    buf->append(tmp, n);
+  }
+  return true;
+}
+
+struct FrameHeader {
+  uint32_t length;
+  uint8_t type;
+  uint8_t flags;
+  uint32_t stream_id;
+};
+
+FrameHeader ParseFrameHeader(const std::string& buf, size_t pos) {
+  auto byte = [&](size_t i) { return static_cast<uint32_t>(static_cast<uint8_t>(buf[pos + i])); };
+  FrameHeader header;
+  header.length = (byte(0) << 16) | (byte(1) << 8) | byte(2);
+  header.type = byte(3);
+  header.flags = byte(4);
+  header.stream_id = ((byte(5) << 24) | (byte(6) << 16) | (byte(7) << 8) | byte(8)) & 0x7fffffff;
+  return header;
+}
+
+// Testing case:
+// An HTTP/1.1 request with `Upgrade: h2c` is switched to HTTP/2 and replied on stream 1.
+TEST_F(Http2Test, TestUpgradeH2c) {
+  constexpr size_t kFrameHeaderSize = 9;
+  constexpr uint8_t kData = 0x0, kHeaders = 0x1, kSettings = 0x4;
+  constexpr uint8_t kEndStream = 0x1;
+
+  int fd = ConnectTo(http2_proxy_h2c_->GetServiceProxyOption()->target);
+  ASSERT_GE(fd, 0);
+  std::string request =
+      "GET /test-get-query?name=h2c HTTP/1.1\r\n"
+      "Host: test.com\r\n"
+      "Connection: Upgrade, HTTP2-Settings\r\n"
+      "Upgrade: h2c\r\n"
+      // SETTINGS_MAX_CONCURRENT_STREAMS = 100, SETTINGS_INITIAL_WINDOW_SIZE = 65535.
+      "HTTP2-Settings: AAMAAABkAAQAAP__\r\n"
+      "\r\n";
+  ASSERT_EQ(write(fd, request.data(), request.size()), static_cast<ssize_t>(request.size()));
+
+  std::string buf;
+  size_t head_end = std::string::npos;
+  while ((head_end = buf.find("\r\n\r\n")) == std::string::npos) {
+    ASSERT_TRUE(ReadAtLeast(fd, &buf, buf.size() + 1));
+  }
+  ASSERT_EQ(buf.compare(0, 12, "HTTP/1.1 101"), 0) << buf;
+  size_t pos = head_end + 4;
+
+  // The server connection preface (a SETTINGS frame) follows the 101 response.
+  ASSERT_TRUE(ReadAtLeast(fd, &buf, pos + kFrameHeaderSize));
+  ASSERT_EQ(ParseFrameHeader(buf, pos).type, kSettings);
+
+  std::string preface("PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n");
+  preface.append("\x00\x00\x00\x04\x00\x00\x00\x00\x00", kFrameHeaderSize);
+  ASSERT_EQ(write(fd, preface.data(), preface.size()), static_cast<ssize_t>(preface.size()));
+
+  bool headers_received = false;
+  std::string content;
+  while (true) {
+    ASSERT_TRUE(ReadAtLeast(fd, &buf, pos + kFrameHeaderSize));
+    FrameHeader header = ParseFrameHeader(buf, pos);
+    ASSERT_TRUE(ReadAtLeast(fd, &buf, pos + kFrameHeaderSize + header.length));
+    if (header.stream_id == 1) {
+      if (header.type == kHeaders) {
+        headers_received = true;
+      } else if (header.type == kData) {
+        content.append(buf, pos + kFrameHeaderSize, header.length);
+      }
+      if (header.flags & kEndStream) break;
+    }
+    pos += kFrameHeaderSize + header.length;
+  }
+  close(fd);
+
+  ASSERT_TRUE(headers_received);
+  ASSERT_EQ(content, "hello h2c");
+}
+
+}  // namespace trpc::testing
+
+int main(int argc, char** argv) {
+  if (!::trpc::testing::ExtractServerAndClientArgs(argc, argv, &test_argc, &client_argv, &server_argv)) {
+    exit(EXIT_FAILURE);
+  }
+
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
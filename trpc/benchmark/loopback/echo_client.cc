@@ -0,0 +1,288 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "fmt/format.h"
+#include "gflags/gflags.h"
+
+#include "trpc/client/http/http_service_proxy.h"
+#include "trpc/client/make_client_context.h"
+#include "trpc/client/trpc_client.h"
+#include "trpc/common/runtime_manager.h"
+#include "trpc/coroutine/fiber.h"
+#include "trpc/coroutine/fiber_latch.h"
+#include "trpc/future/future_utility.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+#include "trpc/util/thread/latch.h"
+#include "trpc/util/time.h"
+
+#include "trpc/benchmark/loopback/echo.trpc.pb.h"
+#include "trpc/benchmark/loopback/latency_histogram.h"
+
+DEFINE_string(client_config, "", "framework config file of the client, which decides the thread model of the client");
+DEFINE_string(codec, "trpc", "protocol to benchmark: trpc, http or grpc");
+DEFINE_string(addr, "", "ip:port of the echo server, the default port of --codec on 127.0.0.1 if not specified");
+DEFINE_uint32(payload_size, 16, "bytes of payload of each request, echoed back by the server");
+DEFINE_uint32(concurrency, 64, "number of requests in flight");
+DEFINE_uint32(warmup_s, 2, "seconds to run before measuring");
+DEFINE_uint32(duration_s, 10, "seconds to measure");
+DEFINE_uint32(timeout_ms, 3000, "timeout of each request");
+DEFINE_string(label, "", "free-form label copied to the result, e.g. the thread model of the server");
+DEFINE_string(format, "text", "output format: text, or json (one object per line, for comparing runs by scripts)");
+
+namespace trpc::benchmark {
+
+namespace {
+
+using EchoProxy = ::trpc::benchmark::loopback::EchoServiceProxy;
+using EchoRequest = ::trpc::benchmark::loopback::EchoRequest;
+using EchoReply = ::trpc::benchmark::loopback::EchoReply;
+
+std::string GetDefaultAddr(const std::string& codec) {
+  // Keep the same as the ports in loopback/conf/*_server.yaml.
+  if (codec == "http") return "127.0.0.1:13452";
+  if (codec == "grpc") return "127.0.0.1:13453";
+  return "127.0.0.1:13451";
+}
+
+/// @brief Issues one echo request, by either the synchronous or the asynchronous (future) interface.
+class Caller {
+ public:
+  virtual ~Caller() = default;
+
+  virtual bool Call() = 0;
+
+  virtual Future<> AsyncCall() = 0;
+};
+
+// Shared by trpc and grpc, which both carry the protobuf messages.
+class PbEchoCaller : public Caller {
+ public:
+  PbEchoCaller(std::shared_ptr<EchoProxy> proxy, std::string payload) : proxy_(std::move(proxy)) {
+    request_.set_payload(std::move(payload));
+  }
+
+  bool Call() override {
+    auto context = MakeClientContext(proxy_);
+    EchoReply reply;
+    return proxy_->Echo(context, request_, &reply).OK();
+  }
+
+  Future<> AsyncCall() override {
+    auto context = MakeClientContext(proxy_);
+    return proxy_->AsyncEcho(context, request_).Then([](Future<EchoReply>&& fut) {
+      if (fut.IsFailed()) {
+        return MakeExceptionFuture<>(fut.GetException());
+      }
+      return MakeReadyFuture<>();
+    });
+  }
+
+ private:
+  std::shared_ptr<EchoProxy> proxy_;
+  EchoRequest request_;
+};
+
+class HttpEchoCaller : public Caller {
+ public:
+  HttpEchoCaller(std::shared_ptr<HttpServiceProxy> proxy, const std::string& addr, const std::string& payload)
+      : proxy_(std::move(proxy)), url_("http://" + addr + "/echo"), payload_(CreateBufferSlow(payload)) {}
+
+  bool Call() override {
+    auto context = MakeClientContext(proxy_);
+    NoncontiguousBuffer body;
+    return proxy_->Post(context, url_, NoncontiguousBuffer(payload_), &body).OK();
+  }
+
+  Future<> AsyncCall() override {
+    auto context = MakeClientContext(proxy_);
+    return proxy_->AsyncPost(context, url_, NoncontiguousBuffer(payload_)).Then([](Future<NoncontiguousBuffer>&& fut) {
+      if (fut.IsFailed()) {
+        return MakeExceptionFuture<>(fut.GetException());
+      }
+      return MakeReadyFuture<>();
+    });
+  }
+
+ private:
+  std::shared_ptr<HttpServiceProxy> proxy_;
+  std::string url_;
+  NoncontiguousBuffer payload_;
+};
+
+std::unique_ptr<Caller> CreateCaller() {
+  std::string addr = FLAGS_addr.empty() ? GetDefaultAddr(FLAGS_codec) : FLAGS_addr;
+
+  ServiceProxyOption option;
+  option.name = "trpc.benchmark.loopback.Echo";
+  option.codec_name = FLAGS_codec;
+  option.network = "tcp";
+  option.conn_type = "long";
+  option.timeout = FLAGS_timeout_ms;
+  option.selector_name = "direct";
+  option.target = addr;
+
+  std::string payload(FLAGS_payload_size, 'x');
+  if (FLAGS_codec == "http") {
+    return std::make_unique<HttpEchoCaller>(GetTrpcClient()->GetProxy<HttpServiceProxy>(option.name, option), addr,
+                                            payload);
+  } else if (FLAGS_codec == "trpc" || FLAGS_codec == "grpc") {
+    return std::make_unique<PbEchoCaller>(GetTrpcClient()->GetProxy<EchoProxy>(option.name, option),
+                                          std::move(payload));
+  }
+  return nullptr;
+}
+
+struct RunState {
+  std::unique_ptr<Caller> caller;
+  // Latencies are recorded only after warming up.
+  std::atomic<bool> recording{false};
+  std::atomic<bool> stopped{false};
+  std::atomic<std::uint64_t> errors{0};
+  LatencyHistogram latency_us;
+
+  void OnDone(std::uint64_t begin_us, bool succ) {
+    if (!recording.load(std::memory_order_relaxed)) {
+      return;
+    }
+    if (succ) {
+      latency_us.Record(trpc::time::GetMicroSeconds() - begin_us);
+    } else {
+      errors.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+};
+
+// Each fiber keeps one synchronous request in flight.
+void RunInFibers(RunState* state, FiberLatch* done) {
+  for (std::uint32_t i = 0; i != FLAGS_concurrency; ++i) {
+    StartFiberDetached([state, done] {
+      while (!state->stopped.load(std::memory_order_relaxed)) {
+        auto begin_us = trpc::time::GetMicroSeconds();
+        state->OnDone(begin_us, state->caller->Call());
+      }
+      done->CountDown();
+    });
+  }
+}
+
+// Each chain keeps one asynchronous request in flight, issuing the next one when the previous one completes.
+void IssueAsync(RunState* state, Latch* done) {
+  if (state->stopped.load(std::memory_order_relaxed)) {
+    done->count_down();
+    return;
+  }
+  auto begin_us = trpc::time::GetMicroSeconds();
+  state->caller->AsyncCall().Then([state, done, begin_us](Future<>&& fut) {
+    state->OnDone(begin_us, fut.IsReady());
+    IssueAsync(state, done);
+    return MakeReadyFuture<>();
+  });
+}
+
+void SleepFor(std::chrono::seconds duration) {
+  if (IsRunningInFiberWorker()) {
+    FiberSleepFor(duration);
+  } else {
+    std::this_thread::sleep_for(duration);
+  }
+}
+
+void Report(const RunState& state, double elapsed_s) {
+  const auto& latency = state.latency_us;
+  double qps = latency.Count() / elapsed_s;
+  if (FLAGS_format == "json") {
+    std::cout << fmt::format(
+                     "{{\"label\":\"{}\",\"codec\":\"{}\",\"payload_size\":{},\"concurrency\":{},\"duration_s\":{:.3f},"
+                     "\"requests\":{},\"errors\":{},\"qps\":{:.1f},\"latency_us\":{{\"p50\":{},\"p99\":{},"
+                     "\"p999\":{},\"max\":{}}}}}",
+                     FLAGS_label, FLAGS_codec, FLAGS_payload_size, FLAGS_concurrency, elapsed_s, latency.Count(),
+                     state.errors.load(), qps, latency.Percentile(0.5), latency.Percentile(0.99),
+                     latency.Percentile(0.999), latency.Max())
+              << std::endl;
+  } else {
+    std::cout << fmt::format(
+                     "label: {}, codec: {}, payload_size: {}, concurrency: {}, requests: {}, errors: {}, qps: {:.1f}, "
+                     "latency(us) p50: {}, p99: {}, p999: {}, max: {}",
+                     FLAGS_label, FLAGS_codec, FLAGS_payload_size, FLAGS_concurrency, latency.Count(),
+                     state.errors.load(), qps, latency.Percentile(0.5), latency.Percentile(0.99),
+                     latency.Percentile(0.999), latency.Max())
+              << std::endl;
+  }
+}
+
+int Run() {
+  RunState state;
+  state.caller = CreateCaller();
+  if (!state.caller) {
+    std::cerr << "unknown codec: " << FLAGS_codec << std::endl;
+    return -1;
+  }
+
+  bool in_fiber = IsRunningInFiberWorker();
+  std::unique_ptr<FiberLatch> fiber_done;
+  std::unique_ptr<Latch> thread_done;
+  if (in_fiber) {
+    fiber_done = std::make_unique<FiberLatch>(FLAGS_concurrency);
+    RunInFibers(&state, fiber_done.get());
+  } else {
+    thread_done = std::make_unique<Latch>(FLAGS_concurrency);
+    for (std::uint32_t i = 0; i != FLAGS_concurrency; ++i) {
+      IssueAsync(&state, thread_done.get());
+    }
+  }
+
+  SleepFor(std::chrono::seconds(FLAGS_warmup_s));
+  state.recording = true;
+  auto begin = std::chrono::steady_clock::now();
+
+  SleepFor(std::chrono::seconds(FLAGS_duration_s));
+  state.recording = false;
+  auto elapsed = std::chrono::steady_clock::now() - begin;
+
+  state.stopped = true;
+  if (in_fiber) {
+    fiber_done->Wait();
+  } else {
+    thread_done->wait();
+  }
+
+  Report(state, std::chrono::duration<double>(elapsed).count());
+  return 0;
+}
+
+}  // namespace trpc::benchmark
+
+int main(int argc, char* argv[]) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  if (FLAGS_client_config.empty()) {
+    std::cerr << "start client with client_config, for example: " << argv[0]
+              << " --client_config=trpc/benchmark/loopback/conf/fiber_client.yaml" << std::endl;
+    return -1;
+  }
+
+  if (::trpc::TrpcConfig::GetInstance()->Init(FLAGS_client_config) != 0) {
+    std::cerr << "load client_config failed." << std::endl;
+    return -1;
+  }
+
+  return ::trpc::RunInTrpcRuntime([]() { return ::trpc::benchmark::Run(); });
+}
@@ -0,0 +1,76 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "trpc/common/trpc_app.h"
+#include "trpc/server/http_service.h"
+#include "trpc/util/http/http_handler.h"
+#include "trpc/util/http/routes.h"
+
+#include "trpc/benchmark/loopback/echo.trpc.pb.h"
+
+namespace trpc::benchmark {
+
+/// @brief Echo service shared by the protocols built on protobuf (trpc and grpc).
+class EchoServiceImpl : public ::trpc::benchmark::loopback::Echo {
+ public:
+  ::trpc::Status Echo(::trpc::ServerContextPtr context, const ::trpc::benchmark::loopback::EchoRequest* request,
+                      ::trpc::benchmark::loopback::EchoReply* reply) override {
+    reply->set_payload(request->payload());
+    return ::trpc::kSuccStatus;
+  }
+};
+
+/// @brief Echo handler of HTTP, the body of a `POST /echo` is sent back.
+class EchoHandler : public ::trpc::http::HttpHandler {
+ public:
+  ::trpc::Status Post(const ::trpc::ServerContextPtr& context, const ::trpc::http::RequestPtr& req,
+                      ::trpc::http::Response* rsp) override {
+    rsp->SetNonContiguousBufferContent(std::move(*req->GetMutableNonContiguousBufferContent()));
+    return ::trpc::kSuccStatus;
+  }
+};
+
+/// @brief Loopback echo server, the thread model used is decided by the framework config.
+class EchoServer : public ::trpc::TrpcApp {
+ public:
+  int Initialize() override {
+    // Names must be the same as the `server:service:name` configuration items.
+    RegisterService("trpc.benchmark.loopback.Echo", std::make_shared<EchoServiceImpl>());
+    RegisterService("trpc.benchmark.loopback.EchoGrpc", std::make_shared<EchoServiceImpl>());
+
+    auto http_service = std::make_shared<::trpc::HttpService>();
+    http_service->SetRoutes([](::trpc::http::HttpRoutes& r) {
+      r.Add(::trpc::http::MethodType::POST, ::trpc::http::Path("/echo"), std::make_shared<EchoHandler>());
+    });
+    RegisterService("trpc.benchmark.loopback.EchoHttp", http_service);
+
+    return 0;
+  }
+
+  void Destroy() override {}
+};
+
+}  // namespace trpc::benchmark
+
+int main(int argc, char** argv) {
+  trpc::benchmark::EchoServer server;
+
+  server.Main(argc, argv);
+  server.Wait();
+
+  return 0;
+}
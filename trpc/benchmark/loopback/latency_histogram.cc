@@ -0,0 +1,53 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/benchmark/loopback/latency_histogram.h"
+
+#include <cmath>
+
+namespace trpc::benchmark {
+
+std::size_t LatencyHistogram::GetBucketIndex(std::uint64_t value) noexcept {
+  if (value < kSubBucketNum) {
+    return value;
+  }
+  int shift = 63 - __builtin_clzll(value) - kSubBucketBits;
+  return ((shift + 1) << kSubBucketBits) + ((value >> shift) & (kSubBucketNum - 1));
+}
+
+std::uint64_t LatencyHistogram::GetBucketLowerBound(std::size_t index) noexcept {
+  if (index < kSubBucketNum) {
+    return index;
+  }
+  int shift = static_cast<int>(index >> kSubBucketBits) - 1;
+  return (kSubBucketNum + (index & (kSubBucketNum - 1))) << shift;
+}
+
+std::uint64_t LatencyHistogram::Percentile(double percentile) const noexcept {
+  std::uint64_t count = Count();
+  if (count == 0) {
+    return 0;
+  }
+
+  auto rank = static_cast<std::uint64_t>(std::ceil(percentile * count));
+  std::uint64_t seen = 0;
+  for (std::size_t i = 0; i != kBucketNum; ++i) {
+    seen += counts_[i].load(std::memory_order_relaxed);
+    if (seen >= rank && seen != 0) {
+      return GetBucketLowerBound(i);
+    }
+  }
+  return Max();
+}
+
+}  // namespace trpc::benchmark
@@ -0,0 +1,62 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace trpc::benchmark {
+
+/// @brief Lock-free log-linear histogram of latencies, safe to record into from any thread.
+///        Values are bucketed by their highest bit, each power of two range is split into 64 sub-buckets, so a
+///        percentile is accurate to within 1/64 of its value.
+class LatencyHistogram {
+ public:
+  /// @brief Record a latency.
+  void Record(std::uint64_t value) noexcept {
+    counts_[GetBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    std::uint64_t max = max_.load(std::memory_order_relaxed);
+    while (value > max && !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  /// @brief Get the number of recorded latencies.
+  std::uint64_t Count() const noexcept { return count_.load(std::memory_order_relaxed); }
+
+  /// @brief Get the maximum recorded latency.
+  std::uint64_t Max() const noexcept { return max_.load(std::memory_order_relaxed); }
+
+  /// @brief Get the latency below which `percentile` of the recorded latencies fall.
+  /// @param percentile In range of [0, 1], e.g. 0.999 for p999.
+  /// @return The lower bound of the bucket the percentile falls into, 0 if nothing is recorded.
+  std::uint64_t Percentile(double percentile) const noexcept;
+
+ private:
+  static constexpr int kSubBucketBits = 6;
+  static constexpr std::uint64_t kSubBucketNum = 1 << kSubBucketBits;
+  static constexpr std::size_t kBucketNum = (64 - kSubBucketBits + 1) * kSubBucketNum;
+
+  static std::size_t GetBucketIndex(std::uint64_t value) noexcept;
+
+  static std::uint64_t GetBucketLowerBound(std::size_t index) noexcept;
+
+ private:
+  std::array<std::atomic<std::uint64_t>, kBucketNum> counts_{};
+  std::atomic<std::uint64_t> count_{0};
+  std::atomic<std::uint64_t> max_{0};
+};
+
+}  // namespace trpc::benchmark
@@ -0,0 +1,75 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/benchmark/loopback/latency_histogram.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::benchmark::testing {
+
+TEST(LatencyHistogram, Empty) {
+  LatencyHistogram histogram;
+  ASSERT_EQ(histogram.Count(), 0);
+  ASSERT_EQ(histogram.Percentile(0.99), 0);
+}
+
+TEST(LatencyHistogram, Percentile) {
+  LatencyHistogram histogram;
+  for (std::uint64_t i = 1; i <= 10000; ++i) {
+    histogram.Record(i);
+  }
+  ASSERT_EQ(histogram.Count(), 10000);
+  ASSERT_EQ(histogram.Max(), 10000);
+
+  // Accurate to within 1/64.
+  auto expect_near = [](std::uint64_t actual, std::uint64_t expected) {
+    ASSERT_LE(actual, expected);
+    ASSERT_GE(actual, expected - expected / 64);
+  };
+  expect_near(histogram.Percentile(0.5), 5000);
+  expect_near(histogram.Percentile(0.99), 9900);
+  expect_near(histogram.Percentile(0.999), 9990);
+  ASSERT_EQ(histogram.Percentile(0), 1);
+}
+
+TEST(LatencyHistogram, SmallAndLargeValues) {
+  LatencyHistogram histogram;
+  histogram.Record(0);
+  histogram.Record(63);
+  histogram.Record(1ULL << 40);
+  ASSERT_EQ(histogram.Percentile(0.3), 0);
+  ASSERT_EQ(histogram.Percentile(0.6), 63);
+  ASSERT_EQ(histogram.Percentile(1), 1ULL << 40);
+}
+
+TEST(LatencyHistogram, ConcurrentRecord) {
+  LatencyHistogram histogram;
+  std::vector<std::thread> threads;
+  for (int i = 0; i != 4; ++i) {
+    threads.emplace_back([&] {
+      for (int j = 0; j != 10000; ++j) {
+        histogram.Record(j);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  ASSERT_EQ(histogram.Count(), 40000);
+  ASSERT_EQ(histogram.Max(), 9999);
+}
+
+}  // namespace trpc::benchmark::testing
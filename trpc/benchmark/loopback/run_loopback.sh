@@ -0,0 +1,40 @@
+#!/bin/bash
+#
+# Runs the loopback echo benchmark over every thread model, codec and payload size, one JSON object per line is
+# appended to the result file so that runs from different builds can be compared by scripts.
+#
+# Usage: ./trpc/benchmark/loopback/run_loopback.sh [result_file]
+#   BIN_DIR      directory of echo_server/echo_client, default ./bazel-bin/trpc/benchmark/loopback
+#   DURATION_S   seconds to measure each case, default 10
+#   CONCURRENCY  requests in flight, default 64
+
+RESULT=${1:-loopback_result.jsonl}
+BIN_DIR=${BIN_DIR:-./bazel-bin/trpc/benchmark/loopback}
+CONF_DIR=./trpc/benchmark/loopback/conf
+DURATION_S=${DURATION_S:-10}
+CONCURRENCY=${CONCURRENCY:-64}
+
+THREAD_MODELS="fiber separate merge"
+CODECS="trpc http grpc"
+PAYLOAD_SIZES="16 128 1024 8192 65536 1048576"
+
+if [ -z "${BIN_DIR##./bazel-bin*}" ]; then
+  bazel build -c opt //trpc/benchmark/loopback/... || exit 1
+fi
+
+for model in ${THREAD_MODELS}; do
+  ${BIN_DIR}/echo_server --config=${CONF_DIR}/${model}_server.yaml &
+  server_pid=$!
+  sleep 1
+
+  for codec in ${CODECS}; do
+    for size in ${PAYLOAD_SIZES}; do
+      ${BIN_DIR}/echo_client --client_config=${CONF_DIR}/${model}_client.yaml --codec=${codec} \
+        --payload_size=${size} --concurrency=${CONCURRENCY} --duration_s=${DURATION_S} \
+        --label=${model} --format=json | tee -a ${RESULT}
+    done
+  done
+
+  kill ${server_pid}
+  wait ${server_pid}
+done
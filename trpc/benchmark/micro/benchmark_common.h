@@ -0,0 +1,23 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include "benchmark/benchmark.h"
+
+namespace trpc::benchmark {
+
+/// @brief Payload sizes covered by the benchmarks, from 16B to 1MB.
+inline void ApplyPayloadSizes(::benchmark::internal::Benchmark* b) { b->RangeMultiplier(8)->Range(16, 1 << 20); }
+
+}  // namespace trpc::benchmark
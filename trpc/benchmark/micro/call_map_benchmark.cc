@@ -0,0 +1,80 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "trpc/transport/client/fiber/common/call_map.h"
+
+namespace trpc::benchmark {
+
+namespace {
+
+// Shared by all benchmark threads, the same as connections share the call map of a fiber transport.
+CallMap* GetCallMap() {
+  static CallMap call_map;
+  return &call_map;
+}
+
+}  // namespace
+
+// Each thread keeps `state.range(0)` calls in flight, allocating one and reclaiming the oldest per iteration.
+void BM_CallMapAllocateAndReclaim(::benchmark::State& state) {
+  CallMap* call_map = GetCallMap();
+  const std::uint32_t inflight = state.range(0);
+  // Interleaved correlation ids, the same as the ids generated by a service proxy shared by all threads.
+  const std::uint32_t threads = state.threads();
+  std::uint32_t seq = state.thread_index();
+  auto next_id = [&] { return std::exchange(seq, seq + threads); };
+
+  std::vector<std::uint32_t> ids;
+  ids.reserve(inflight);
+  for (std::uint32_t i = 0; i != inflight; ++i) {
+    ids.push_back(next_id());
+    call_map->AllocateContext(ids.back());
+  }
+
+  std::size_t oldest = 0;
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(call_map->TryReclaimContext(ids[oldest]));
+    ids[oldest] = next_id();
+    call_map->AllocateContext(ids[oldest]);
+    oldest = (oldest + 1) % inflight;
+  }
+
+  for (auto id : ids) {
+    call_map->TryReclaimContext(id);
+  }
+}
+// 1024 and above (times the threads) go beyond the slots of the default table size and exercise the overflow map.
+BENCHMARK(BM_CallMapAllocateAndReclaim)
+    ->Arg(1)->Arg(16)->Arg(64)->Arg(1024)->Arg(4096)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+// Reclaiming timed out or already finished calls, which finds nothing.
+void BM_CallMapReclaimMissing(::benchmark::State& state) {
+  CallMap* call_map = GetCallMap();
+  // Ids never allocated by `BM_CallMapAllocateAndReclaim`.
+  std::uint32_t seq = 0x80000000 + state.thread_index();
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(call_map->TryReclaimContext(seq));
+    seq += state.threads();
+  }
+}
+BENCHMARK(BM_CallMapReclaimMissing)->ThreadRange(1, 16)->UseRealTime();
+
+}  // namespace trpc::benchmark
@@ -0,0 +1,186 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include <any>
+#include <deque>
+#include <string>
+#include <utility>
+
+#include "benchmark/benchmark.h"
+
+#include "trpc/benchmark/micro/benchmark_common.h"
+#include "trpc/client/client_context.h"
+#include "trpc/codec/grpc/grpc_protocol.h"
+#include "trpc/codec/http/http_proto_checker.h"
+#include "trpc/codec/http/http_server_codec.h"
+#include "trpc/codec/redis/redis_client_codec.h"
+#include "trpc/codec/redis/redis_proto_checker.h"
+#include "trpc/codec/trpc/trpc_proto_checker.h"
+#include "trpc/codec/trpc/trpc_protocol.h"
+#include "trpc/codec/trpc/trpc_server_codec.h"
+#include "trpc/runtime/iomodel/reactor/common/connection.h"
+#include "trpc/server/server_context.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc::benchmark {
+
+namespace {
+
+NoncontiguousBuffer MakeTrpcRequest(std::size_t payload_size) {
+  TrpcRequestProtocol req;
+  req.req_header.set_version(0);
+  req.req_header.set_call_type(kUnaryCall);
+  req.req_header.set_request_id(1);
+  req.req_header.set_timeout(1000);
+  req.req_header.set_caller("trpc.benchmark.loopback.client");
+  req.req_header.set_callee("trpc.benchmark.loopback.EchoService");
+  req.req_header.set_func("/trpc.benchmark.loopback.EchoService/Echo");
+  req.SetNonContiguousProtocolBody(CreateBufferSlow(std::string(payload_size, 'x')));
+
+  NoncontiguousBuffer buffer;
+  req.ZeroCopyEncode(buffer);
+  return buffer;
+}
+
+NoncontiguousBuffer MakeHttpRequest(std::size_t payload_size) {
+  std::string request =
+      "POST /echo HTTP/1.1\r\n"
+      "Host: 127.0.0.1\r\n"
+      "Content-Type: application/octet-stream\r\n"
+      "Content-Length: " +
+      std::to_string(payload_size) + "\r\n\r\n" + std::string(payload_size, 'x');
+  return CreateBufferSlow(request);
+}
+
+NoncontiguousBuffer MakeGrpcMessage(std::size_t payload_size) {
+  GrpcMessageContent content;
+  content.length = payload_size;
+  content.content = CreateBufferSlow(std::string(payload_size, 'x'));
+
+  NoncontiguousBuffer buffer;
+  content.Encode(&buffer);
+  return buffer;
+}
+
+NoncontiguousBuffer MakeRedisReply(std::size_t payload_size) {
+  return CreateBufferSlow("$" + std::to_string(payload_size) + "\r\n" + std::string(payload_size, 'x') + "\r\n");
+}
+
+}  // namespace
+
+void BM_TrpcZeroCopyCheck(::benchmark::State& state) {
+  NoncontiguousBuffer packet = MakeTrpcRequest(state.range(0));
+  ConnectionPtr conn = MakeRefCounted<Connection>();
+  std::deque<std::any> out;
+  for (auto _ : state) {
+    NoncontiguousBuffer in = packet;
+    ::benchmark::DoNotOptimize(CheckTrpcProtocolMessage(conn, in, out));
+    out.clear();
+  }
+  state.SetBytesProcessed(state.iterations() * packet.ByteSize());
+}
+BENCHMARK(BM_TrpcZeroCopyCheck)->Apply(ApplyPayloadSizes);
+
+void BM_TrpcZeroCopyDecode(::benchmark::State& state) {
+  NoncontiguousBuffer packet = MakeTrpcRequest(state.range(0));
+  TrpcServerCodec codec;
+  ServerContextPtr context = MakeRefCounted<ServerContext>();
+  ProtocolPtr req = codec.CreateRequestObject();
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(codec.ZeroCopyDecode(context, NoncontiguousBuffer(packet), req));
+  }
+  state.SetBytesProcessed(state.iterations() * packet.ByteSize());
+}
+BENCHMARK(BM_TrpcZeroCopyDecode)->Apply(ApplyPayloadSizes);
+
+void BM_HttpZeroCopyCheck(::benchmark::State& state) {
+  NoncontiguousBuffer packet = MakeHttpRequest(state.range(0));
+  ConnectionPtr conn = MakeRefCounted<Connection>();
+  conn->SetConnType(ConnectionType::kTcpLong);
+  std::deque<std::any> out;
+  for (auto _ : state) {
+    NoncontiguousBuffer in = packet;
+    ::benchmark::DoNotOptimize(HttpZeroCopyCheckRequest(conn, in, out));
+    out.clear();
+  }
+  state.SetBytesProcessed(state.iterations() * packet.ByteSize());
+}
+BENCHMARK(BM_HttpZeroCopyCheck)->Apply(ApplyPayloadSizes);
+
+void BM_HttpZeroCopyCheckAndDecode(::benchmark::State& state) {
+  NoncontiguousBuffer packet = MakeHttpRequest(state.range(0));
+  ConnectionPtr conn = MakeRefCounted<Connection>();
+  conn->SetConnType(ConnectionType::kTcpLong);
+  HttpServerCodec codec;
+  ServerContextPtr context = MakeRefCounted<ServerContext>();
+  ProtocolPtr req = codec.CreateRequestObject();
+  std::deque<std::any> out;
+  for (auto _ : state) {
+    NoncontiguousBuffer in = packet;
+    HttpZeroCopyCheckRequest(conn, in, out);
+    ::benchmark::DoNotOptimize(codec.ZeroCopyDecode(context, std::move(out.front()), req));
+    out.clear();
+  }
+  state.SetBytesProcessed(state.iterations() * packet.ByteSize());
+}
+BENCHMARK(BM_HttpZeroCopyCheckAndDecode)->Apply(ApplyPayloadSizes);
+
+// HTTP/2 framing of gRPC is done by the HTTP/2 session rather than `ZeroCopyCheck`, only the length-prefixed message
+// framing of gRPC is covered here.
+void BM_GrpcMessageCheckAndDecode(::benchmark::State& state) {
+  NoncontiguousBuffer packet = MakeGrpcMessage(state.range(0));
+  for (auto _ : state) {
+    NoncontiguousBuffer in = packet;
+    NoncontiguousBuffer message;
+    GrpcMessageContent::Check(&in, &message);
+    GrpcMessageContent content;
+    ::benchmark::DoNotOptimize(content.Decode(&message));
+  }
+  state.SetBytesProcessed(state.iterations() * packet.ByteSize());
+}
+BENCHMARK(BM_GrpcMessageCheckAndDecode)->Apply(ApplyPayloadSizes);
+
+// tRPC provides no redis server, the client side of the codec is covered instead.
+void BM_RedisZeroCopyCheck(::benchmark::State& state) {
+  NoncontiguousBuffer packet = MakeRedisReply(state.range(0));
+  ConnectionPtr conn = MakeRefCounted<Connection>();
+  conn->SetSupportPipeline();
+  std::deque<std::any> out;
+  for (auto _ : state) {
+    NoncontiguousBuffer in = packet;
+    ::benchmark::DoNotOptimize(RedisZeroCopyCheckResponse(conn, in, out));
+    out.clear();
+  }
+  state.SetBytesProcessed(state.iterations() * packet.ByteSize());
+}
+BENCHMARK(BM_RedisZeroCopyCheck)->Apply(ApplyPayloadSizes);
+
+void BM_RedisZeroCopyCheckAndDecode(::benchmark::State& state) {
+  NoncontiguousBuffer packet = MakeRedisReply(state.range(0));
+  ConnectionPtr conn = MakeRefCounted<Connection>();
+  conn->SetSupportPipeline();
+  RedisClientCodec codec;
+  ClientContextPtr context = MakeRefCounted<ClientContext>();
+  ProtocolPtr rsp = codec.CreateResponsePtr();
+  std::deque<std::any> out;
+  for (auto _ : state) {
+    NoncontiguousBuffer in = packet;
+    RedisZeroCopyCheckResponse(conn, in, out);
+    ::benchmark::DoNotOptimize(codec.ZeroCopyDecode(context, std::move(out.front()), rsp));
+    out.clear();
+  }
+  state.SetBytesProcessed(state.iterations() * packet.ByteSize());
+}
+BENCHMARK(BM_RedisZeroCopyCheckAndDecode)->Apply(ApplyPayloadSizes);
+
+}  // namespace trpc::benchmark
@@ -0,0 +1,138 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#include <strings.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "benchmark/benchmark.h"
+
+#include "trpc/util/http/header.h"
+
+// Counts the heap allocations of the whole binary, reported per iteration as `allocs`.
+namespace {
+
+std::atomic<std::size_t> allocations{0};
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace trpc::benchmark {
+
+namespace {
+
+// Header fields of a typical browser request.
+constexpr std::pair<const char*, const char*> kFields[] = {
+    {"Host", "www.example.com"},
+    {"User-Agent", "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0"},
+    {"Accept", "application/json, text/plain, */*"},
+    {"Accept-Language", "en-US,en;q=0.9"},
+    {"Accept-Encoding", "gzip, deflate, br"},
+    {"Content-Type", "application/json"},
+    {"Content-Length", "16"},
+    {"Origin", "https://www.example.com"},
+    {"Referer", "https://www.example.com/items"},
+    {"Cookie", "session=0123456789abcdef0123456789abcdef; theme=dark"},
+    {"Connection", "keep-alive"},
+    {"trpc-caller", "trpc.benchmark.http.client"},
+    {"trpc-callee", "trpc.benchmark.http.server"},
+};
+
+// Fields looked up while a request is handled, "Transfer-Encoding" is absent.
+constexpr const char* kLookups[] = {"Content-Length", "Transfer-Encoding", "Content-Type", "Content-Encoding",
+                                    "Accept-Encoding", "Connection",       "Host",         "trpc-caller"};
+
+// How the header was stored before: a multimap comparing keys by `strncasecmp`.
+struct MultiMapHeader {
+  struct Less {
+    using is_transparent = void;
+    bool operator()(std::string_view lhs, std::string_view rhs) const {
+      if (lhs.size() != rhs.size()) {
+        return lhs.size() < rhs.size();
+      }
+      return strncasecmp(lhs.data(), rhs.data(), lhs.size()) < 0;
+    }
+  };
+  using Map = std::multimap<std::string, std::string, Less>;
+
+  static void Add(Map& map, const char* key, const char* value) { map.emplace(key, value); }
+  static std::string_view Get(const Map& map, std::string_view key) {
+    auto found = map.find(key);
+    return found != map.end() ? std::string_view{found->second} : std::string_view{};
+  }
+};
+
+struct FieldMapHeader {
+  using Map = http::HeaderPairs;
+
+  static void Add(Map& map, const char* key, const char* value) { map.Add(key, value); }
+  static std::string_view Get(const Map& map, std::string_view key) { return map.GetView(key); }
+};
+
+template <typename Header>
+typename Header::Map MakeHeader() {
+  typename Header::Map map;
+  for (const auto& [key, value] : kFields) {
+    Header::Add(map, key, value);
+  }
+  return map;
+}
+
+}  // namespace
+
+template <typename Header>
+void BM_HttpHeaderBuild(::benchmark::State& state) {
+  std::size_t allocs = 0;
+  for (auto _ : state) {
+    std::size_t before = allocations.load(std::memory_order_relaxed);
+    auto map = MakeHeader<Header>();
+    ::benchmark::DoNotOptimize(map);
+    allocs += allocations.load(std::memory_order_relaxed) - before;
+  }
+  state.counters["allocs"] = ::benchmark::Counter(allocs, ::benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_TEMPLATE(BM_HttpHeaderBuild, MultiMapHeader);
+BENCHMARK_TEMPLATE(BM_HttpHeaderBuild, FieldMapHeader);
+
+template <typename Header>
+void BM_HttpHeaderLookup(::benchmark::State& state) {
+  auto map = MakeHeader<Header>();
+  for (auto _ : state) {
+    std::size_t size = 0;
+    for (const char* key : kLookups) {
+      size += Header::Get(map, key).size();
+    }
+    ::benchmark::DoNotOptimize(size);
+  }
+  state.SetItemsProcessed(state.iterations() * std::size(kLookups));
+}
+BENCHMARK_TEMPLATE(BM_HttpHeaderLookup, MultiMapHeader);
+BENCHMARK_TEMPLATE(BM_HttpHeaderLookup, FieldMapHeader);
+
+}  // namespace trpc::benchmark
@@ -0,0 +1,112 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+#include "trpc/util/http/common.h"
+#include "trpc/util/http/http_parser.h"
+#include "trpc/util/http/request.h"
+
+namespace trpc::benchmark {
+
+namespace {
+
+// A request with the header fields of a typical browser request, received in blocks of `block_size` bytes (in a
+// single block if 0).
+NoncontiguousBuffer MakeHttpRequest(std::size_t block_size) {
+  std::string request =
+      "POST /api/v1/resource/123/items?page=2&size=20 HTTP/1.1\r\n"
+      "Host: www.example.com\r\n"
+      "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0 Safari/537.36\r\n"
+      "Accept: application/json, text/plain, */*\r\n"
+      "Accept-Language: en-US,en;q=0.9\r\n"
+      "Accept-Encoding: gzip, deflate, br\r\n"
+      "Content-Type: application/json\r\n"
+      "Content-Length: 16\r\n"
+      "Origin: https://www.example.com\r\n"
+      "Referer: https://www.example.com/items\r\n"
+      "Cookie: session=0123456789abcdef0123456789abcdef; theme=dark\r\n"
+      "Connection: keep-alive\r\n"
+      "trpc-caller: trpc.benchmark.http.client\r\n"
+      "\r\n"
+      "{\"name\":\"item\"}\n";
+  if (block_size == 0) {
+    return CreateBufferSlow(request);
+  }
+  NoncontiguousBuffer buffer;
+  for (std::size_t pos = 0; pos < request.size(); pos += block_size) {
+    buffer.Append(CreateBufferSlow(request.substr(pos, block_size)));
+  }
+  return buffer;
+}
+
+// Bytes of the header fields of `req` stored out of the received blocks of `received`, plus `flattened` bytes copied
+// before parsing the head.
+std::size_t CopiedBytes(const http::Request& req, const NoncontiguousBuffer& received, std::size_t flattened) {
+  auto is_received = [&](std::string_view s) {
+    for (const auto& block : received) {
+      if (s.data() >= block.data() && s.data() + s.size() <= block.data() + block.size()) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  std::size_t copied = flattened;
+  req.RangeHeader([&](std::string_view key, std::string_view value) {
+    copied += (is_received(key) ? 0 : key.size()) + (is_received(value) ? 0 : value.size());
+    return true;
+  });
+  return copied;
+}
+
+// The head is flattened into a string first, and header fields are copied into the strings of the request, which is
+// how the http codecs used to parse. Returns the bytes copied.
+std::size_t ParseHeadFlatten(const NoncontiguousBuffer& packet, http::Request* req) {
+  NoncontiguousBuffer in = packet;
+  std::string head = FlattenSlowUntil(in, http::kEndOfHeaderMarker);
+  in.Skip(http::ParseHead(head, req));
+  return head.size();
+}
+
+// The head is parsed in place, header fields refer to the received bytes.
+std::size_t ParseHeadInPlace(const NoncontiguousBuffer& packet, http::Request* req) {
+  NoncontiguousBuffer in = packet;
+  http::ParseHead(in, in.ByteSize(), req);
+  return 0;
+}
+
+}  // namespace
+
+template <std::size_t (*Parse)(const NoncontiguousBuffer&, http::Request*)>
+void BM_HttpParseHead(::benchmark::State& state) {
+  NoncontiguousBuffer packet = MakeHttpRequest(state.range(0));
+  for (auto _ : state) {
+    http::Request req;
+    ::benchmark::DoNotOptimize(Parse(packet, &req));
+  }
+
+  http::Request req;
+  std::size_t flattened = Parse(packet, &req);
+  state.counters["bytes_copied"] = CopiedBytes(req, packet, flattened);
+}
+BENCHMARK_TEMPLATE(BM_HttpParseHead, ParseHeadFlatten)->Arg(0)->Arg(64);
+BENCHMARK_TEMPLATE(BM_HttpParseHead, ParseHeadInPlace)->Arg(0)->Arg(64);
+
+}  // namespace trpc::benchmark
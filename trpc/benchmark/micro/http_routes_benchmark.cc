@@ -0,0 +1,93 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "trpc/util/http/match_rule.h"
+#include "trpc/util/http/radix_router.h"
+
+namespace trpc::benchmark {
+
+namespace {
+
+class NoopHandler : public http::HandlerBase {
+ public:
+  Status Handle(const std::string& path, ServerContextPtr context, http::RequestPtr req,
+                http::Response* rsp) override {
+    return kDefaultStatus;
+  }
+};
+
+// Rules of a typical REST service: `routes` resources, each has a collection, an item and a nested collection.
+std::vector<http::Path> MakePaths(int routes) {
+  std::vector<http::Path> paths;
+  for (int i = 0; i < routes; ++i) {
+    std::string resource = "/api/v1/resource" + std::to_string(i);
+    paths.emplace_back(resource);
+    paths.emplace_back("<ph(" + resource + "/<id>)>");
+    paths.emplace_back("<ph(" + resource + "/<id>/items/<item_id>)>");
+  }
+  return paths;
+}
+
+// Requests hitting the item rule of the last resource, the worst case of matching rules one by one.
+std::string MakeRequestPath(int routes) { return "/api/v1/resource" + std::to_string(routes - 1) + "/123/items/456"; }
+
+}  // namespace
+
+void BM_HttpRoutesMatchRule(::benchmark::State& state) {
+  std::vector<std::shared_ptr<http::MatchRule>> rules;
+  for (const auto& path : MakePaths(state.range(0))) {
+    auto rule = std::make_shared<http::MatchRule>(std::make_shared<NoopHandler>());
+    rule->AddString(path.GetPath());
+    rules.push_back(std::move(rule));
+  }
+  std::string request_path = MakeRequestPath(state.range(0));
+
+  http::Parameters params;
+  for (auto _ : state) {
+    http::HandlerBase* handler = nullptr;
+    for (const auto& rule : rules) {
+      handler = rule->Get(request_path, params);
+      if (handler != nullptr) {
+        break;
+      }
+      params.Clear();
+    }
+    ::benchmark::DoNotOptimize(handler);
+    params.Clear();
+  }
+}
+
+void BM_HttpRoutesRadixRouter(::benchmark::State& state) {
+  http::RadixRouter router;
+  for (const auto& path : MakePaths(state.range(0))) {
+    router.Add(path, std::make_shared<NoopHandler>());
+  }
+  std::string request_path = MakeRequestPath(state.range(0));
+
+  for (auto _ : state) {
+    http::RadixRouter::Match match;
+    router.Find(request_path, &match);
+    ::benchmark::DoNotOptimize(match.handler);
+  }
+}
+
+BENCHMARK(BM_HttpRoutesMatchRule)->Arg(1)->Arg(16)->Arg(64);
+BENCHMARK(BM_HttpRoutesRadixRouter)->Arg(1)->Arg(16)->Arg(64);
+
+}  // namespace trpc::benchmark
@@ -0,0 +1,106 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "trpc/client/client_context.h"
+#include "trpc/codec/trpc/trpc_client_codec.h"
+#include "trpc/naming/common/util/loadbalance/hash/consistenthash_load_balance.h"
+#include "trpc/naming/common/util/loadbalance/hash/maglev_load_balance.h"
+#include "trpc/naming/common/util/loadbalance/hash/modulohash_load_balance.h"
+#include "trpc/naming/common/util/loadbalance/p2c/p2c_load_balance.h"
+#include "trpc/naming/common/util/loadbalance/polling/polling_load_balance.h"
+#include "trpc/naming/common/util/loadbalance/weighted_round_robin/weighted_round_robin_load_balancer.h"
+
+namespace trpc::benchmark {
+
+namespace {
+
+constexpr char kServiceName[] = "trpc.benchmark.loopback.EchoService";
+
+// Number of distinct hash keys the requests are spread over.
+constexpr std::size_t kHashKeyNum = 1024;
+
+std::vector<TrpcEndpointInfo> MakeEndpoints(std::size_t num) {
+  std::vector<TrpcEndpointInfo> endpoints;
+  for (std::size_t i = 0; i != num; ++i) {
+    TrpcEndpointInfo endpoint;
+    endpoint.host = "10.0." + std::to_string(i / 256) + "." + std::to_string(i % 256);
+    endpoint.port = 10000 + i;
+    endpoint.weight = 100 + i % 3 * 50;
+    endpoint.id = i;
+    endpoints.push_back(std::move(endpoint));
+  }
+  return endpoints;
+}
+
+}  // namespace
+
+// `state.range(0)` is the number of endpoints, all the benchmark threads share one load balancer.
+// With `kUseHashKey` false, hash load balancers build the key from `hash_args` (caller name by default).
+template <typename LoadBalanceType, bool kUseHashKey = true>
+void BM_LoadBalanceNext(::benchmark::State& state) {
+  static LoadBalancePtr load_balance;
+  static std::vector<TrpcEndpointInfo> endpoints;
+  static SelectorInfo update_info;
+
+  if (state.thread_index() == 0) {
+    load_balance = MakeRefCounted<LoadBalanceType>();
+    load_balance->Init();
+    endpoints = MakeEndpoints(state.range(0));
+    update_info.name = kServiceName;
+    LoadBalanceInfo info{&update_info, &endpoints};
+    load_balance->Update(&info);
+  }
+
+  std::vector<SelectorInfo> select_infos(kHashKeyNum);
+  auto codec = std::make_shared<TrpcClientCodec>();
+  for (std::size_t i = 0; i != kHashKeyNum; ++i) {
+    auto context = MakeRefCounted<ClientContext>(codec);
+    if (kUseHashKey) {
+      context->SetHashKey(std::to_string(i * 2654435761ULL));
+    } else {
+      context->SetCallerName("trpc.benchmark.loopback.Client" + std::to_string(i));
+    }
+    select_infos[i].name = kServiceName;
+    select_infos[i].context = context;
+  }
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    LoadBalanceResult result;
+    result.info = &select_infos[i++ % kHashKeyNum];
+    ::benchmark::DoNotOptimize(load_balance->Next(result));
+  }
+
+  if (state.thread_index() == 0) {
+    load_balance = nullptr;
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_LoadBalanceNext, PollingLoadBalance)->RangeMultiplier(8)->Range(8, 512)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(BM_LoadBalanceNext, SWRoundRobinLoadBalance)->RangeMultiplier(8)->Range(8, 512)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(BM_LoadBalanceNext, ConsistentHashLoadBalance)->RangeMultiplier(8)->Range(8, 512)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(BM_LoadBalanceNext, MaglevLoadBalance)->RangeMultiplier(8)->Range(8, 512)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(BM_LoadBalanceNext, ModuloHashLoadBalance)->RangeMultiplier(8)->Range(8, 512)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(BM_LoadBalanceNext, P2cLoadBalance)->RangeMultiplier(8)->Range(8, 512)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(BM_LoadBalanceNext, ConsistentHashLoadBalance, false)
+    ->RangeMultiplier(8)
+    ->Range(8, 512)
+    ->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(BM_LoadBalanceNext, MaglevLoadBalance, false)->RangeMultiplier(8)->Range(8, 512)->ThreadRange(1, 8);
+
+}  // namespace trpc::benchmark
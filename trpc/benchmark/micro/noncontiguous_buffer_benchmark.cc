@@ -0,0 +1,101 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include <algorithm>
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+#include "trpc/benchmark/micro/benchmark_common.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc::benchmark {
+
+namespace {
+
+NoncontiguousBuffer MakeBuffer(std::size_t size) {
+  NoncontiguousBufferBuilder builder;
+  builder.Append(std::string(size, 'x'));
+  return builder.DestructiveGet();
+}
+
+}  // namespace
+
+void BM_BuilderAppend(::benchmark::State& state) {
+  std::string payload(state.range(0), 'x');
+  for (auto _ : state) {
+    NoncontiguousBufferBuilder builder;
+    builder.Append(payload);
+    ::benchmark::DoNotOptimize(builder.DestructiveGet());
+  }
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(BM_BuilderAppend)->Apply(ApplyPayloadSizes);
+
+void BM_BuilderAppendWithExpectedSize(::benchmark::State& state) {
+  std::string payload(state.range(0), 'x');
+  for (auto _ : state) {
+    NoncontiguousBufferBuilder builder(payload.size());
+    builder.Append(payload);
+    ::benchmark::DoNotOptimize(builder.DestructiveGet());
+  }
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(BM_BuilderAppendWithExpectedSize)->Apply(ApplyPayloadSizes);
+
+void BM_BuilderAppendSmallPieces(::benchmark::State& state) {
+  // Typical of serializing headers field by field.
+  for (auto _ : state) {
+    NoncontiguousBufferBuilder builder;
+    for (int i = 0; i != state.range(0); ++i) {
+      builder.Append("key", ": ", "value", "\r\n");
+    }
+    ::benchmark::DoNotOptimize(builder.DestructiveGet());
+  }
+}
+BENCHMARK(BM_BuilderAppendSmallPieces)->Arg(8)->Arg(64);
+
+void BM_CutAndSkip(::benchmark::State& state) {
+  NoncontiguousBuffer source = MakeBuffer(state.range(0));
+  for (auto _ : state) {
+    NoncontiguousBuffer buffer = source;
+    auto head = buffer.Cut(std::min<std::size_t>(16, buffer.ByteSize()));
+    buffer.Skip(buffer.ByteSize() / 2);
+    ::benchmark::DoNotOptimize(head);
+    ::benchmark::DoNotOptimize(buffer);
+  }
+}
+BENCHMARK(BM_CutAndSkip)->Apply(ApplyPayloadSizes);
+
+void BM_FlattenSlow(::benchmark::State& state) {
+  NoncontiguousBuffer buffer = MakeBuffer(state.range(0));
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(FlattenSlow(buffer));
+  }
+  state.SetBytesProcessed(state.iterations() * buffer.ByteSize());
+  state.counters["blocks"] = buffer.size();
+}
+BENCHMARK(BM_FlattenSlow)->Apply(ApplyPayloadSizes);
+
+void BM_AppendBuffer(::benchmark::State& state) {
+  NoncontiguousBuffer source = MakeBuffer(state.range(0));
+  for (auto _ : state) {
+    NoncontiguousBuffer buffer;
+    buffer.Append(source);
+    buffer.Append(source);
+    ::benchmark::DoNotOptimize(buffer);
+  }
+}
+BENCHMARK(BM_AppendBuffer)->Apply(ApplyPayloadSizes);
+
+}  // namespace trpc::benchmark
@@ -0,0 +1,121 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "google/protobuf/arena.h"
+
+#include "trpc/benchmark/micro/pb_arena.pb.h"
+#include "trpc/serialization/pb/pb_serialization.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+// Counts the heap allocations of the whole binary, reported per call as `allocs`.
+namespace {
+
+std::atomic<std::size_t> allocations{0};
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace trpc::benchmark {
+
+namespace {
+
+NoncontiguousBuffer MakeListReply(std::size_t items) {
+  micro::ListReply reply;
+  for (std::size_t i = 0; i != items; ++i) {
+    auto* item = reply.add_items();
+    item->set_id(i);
+    item->set_name("item name longer than the small string optimization " + std::to_string(i));
+    item->add_tags("tag a of the item");
+    item->add_tags("tag b of the item");
+  }
+
+  NoncontiguousBuffer buffer;
+  serialization::PbSerialization serialization;
+  serialization.Serialize(serialization::kPbMessage, &reply, &buffer);
+  return buffer;
+}
+
+// Decodes the response the way `RpcServiceProxy` does, `create` gives the message to decode into.
+template <typename F>
+void DecodeListReply(::benchmark::State& state, F&& create) {
+  NoncontiguousBuffer encoded = MakeListReply(state.range(0));
+  serialization::PbSerialization serialization;
+
+  std::size_t allocs = 0;
+  for (auto _ : state) {
+    NoncontiguousBuffer in = encoded;
+    std::size_t before = allocations.load(std::memory_order_relaxed);
+    create([&](micro::ListReply* reply) {
+      ::benchmark::DoNotOptimize(serialization.Deserialize(&in, serialization::kPbMessage, reply));
+    });
+    allocs += allocations.load(std::memory_order_relaxed) - before;
+  }
+  state.counters["allocs"] = ::benchmark::Counter(allocs, ::benchmark::Counter::kAvgIterations);
+  state.SetBytesProcessed(state.iterations() * encoded.ByteSize());
+}
+
+void ApplyItemCounts(::benchmark::internal::Benchmark* b) { b->RangeMultiplier(8)->Range(8, 4096); }
+
+}  // namespace
+
+// `AsyncUnaryInvoke`/`UnaryInvoke` with a response message on the heap.
+void BM_DecodeResponseOnHeap(::benchmark::State& state) {
+  DecodeListReply(state, [](auto&& decode) {
+    micro::ListReply reply;
+    decode(&reply);
+  });
+}
+BENCHMARK(BM_DecodeResponseOnHeap)->Apply(ApplyItemCounts);
+
+// `*OnArena` calls with the arena owned by the client context, which lives as long as the call.
+void BM_DecodeResponseOnCallArena(::benchmark::State& state) {
+  DecodeListReply(state, [](auto&& decode) {
+    google::protobuf::Arena arena;
+    decode(google::protobuf::Arena::CreateMessage<micro::ListReply>(&arena));
+  });
+}
+BENCHMARK(BM_DecodeResponseOnCallArena)->Apply(ApplyItemCounts);
+
+// `*OnArena` calls with an arena reused by the successive calls of a fiber, whose initial block is reused.
+void BM_DecodeResponseOnReusedArena(::benchmark::State& state) {
+  std::vector<char> initial_block(1 << 20);
+  google::protobuf::ArenaOptions options;
+  options.initial_block = initial_block.data();
+  options.initial_block_size = initial_block.size();
+  google::protobuf::Arena arena(options);
+
+  DecodeListReply(state, [&arena](auto&& decode) {
+    decode(google::protobuf::Arena::CreateMessage<micro::ListReply>(&arena));
+    arena.Reset();
+  });
+}
+BENCHMARK(BM_DecodeResponseOnReusedArena)->Apply(ApplyItemCounts);
+
+}  // namespace trpc::benchmark
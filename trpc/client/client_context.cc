@@ -29,6 +29,14 @@ ClientContext::~ClientContext() {
   }
 }
 
+google::protobuf::Arena* ClientContext::GetPbArena() {
+  if (pb_arena_ == nullptr) {
+    owned_pb_arena_ = std::make_unique<google::protobuf::Arena>();
+    pb_arena_ = owned_pb_arena_.get();
+  }
+  return pb_arena_;
+}
+
 std::string ClientContext::GetTargetMetadata(const std::string& key) const {
   const auto& metadata = GetTargetMetadata();
   auto iter = metadata.find(key);
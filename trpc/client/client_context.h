@@ -23,6 +23,8 @@
 #include <utility>
 #include <vector>
 
+#include "google/protobuf/arena.h"
+
 #include "trpc/client/service_proxy_option.h"
 #include "trpc/codec/client_codec.h"
 #include "trpc/codec/protocol.h"
@@ -84,6 +86,16 @@ class ClientContext : public RefCounted<ClientContext> {
   /// @brief Get set user response data struct
   void* GetResponseData() { return rsp_data_; }
 
+  /// @brief Get the pb arena of the context. The response messages of the `*OnArena` calls of `RpcServiceProxy` are
+  ///        created on it, so can be the request messages by user.
+  /// @note Unless one has been set by `SetPbArena`, it is created on first use and released together with the context,
+  ///       so the messages created on it are valid as long as the context is.
+  google::protobuf::Arena* GetPbArena();
+
+  /// @brief Set the pb arena of the context, it is not owned by the context and must outlive the messages created on
+  ///        it, e.g. an arena reused by the successive calls of a fiber and reset between them.
+  void SetPbArena(google::protobuf::Arena* arena) { pb_arena_ = arena; }
+
   /// @brief Set request attachment
   void SetRequestAttachment(NoncontiguousBuffer&& attachment) {
     TRPC_ASSERT(req_msg_);
@@ -933,6 +945,11 @@ class ClientContext : public RefCounted<ClientContext> {
   // response attachment data
   NoncontiguousBuffer rsp_attachment_;
 
+  // pb arena of the messages of the call, either `owned_pb_arena_` or one set by user
+  google::protobuf::Arena* pb_arena_{nullptr};
+
+  std::unique_ptr<google::protobuf::Arena> owned_pb_arena_;
+
   Status status_;
 
   InvokeInfo invoke_info_;
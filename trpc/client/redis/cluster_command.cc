@@ -0,0 +1,237 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/client/redis/cluster_command.h"
+
+#include <cstdlib>
+#include <string_view>
+#include <utility>
+
+#include "trpc/client/redis/cluster_slot_map.h"
+#include "trpc/util/string/string_helper.h"
+
+namespace trpc {
+
+namespace redis {
+
+namespace {
+
+// Commands which are sent to any node.
+constexpr std::string_view kKeylessCommands[] = {
+    "AUTH", "CLIENT", "CLUSTER", "COMMAND", "CONFIG", "DBSIZE", "ECHO", "FLUSHALL", "FLUSHDB", "HELLO",
+    "INFO", "LASTSAVE", "PING", "QUIT", "RANDOMKEY", "SCAN", "SCRIPT", "SELECT", "TIME", "WAIT"};
+
+bool IsKeylessCommand(std::string_view name) {
+  for (auto keyless : kKeylessCommands) {
+    if (name == keyless) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Reads a "<prefix><integer>\r\n" line at `pos` of a RESP encoded command.
+bool ReadRespInteger(std::string_view data, char prefix, size_t* pos, int64_t* value) {
+  if (*pos >= data.size() || data[*pos] != prefix) {
+    return false;
+  }
+  size_t end = data.find("\r\n", *pos);
+  if (end == std::string_view::npos) {
+    return false;
+  }
+  *value = std::atoll(std::string(data.substr(*pos + 1, end - *pos - 1)).c_str());
+  *pos = end + 2;
+  return true;
+}
+
+bool ParseRawCommand(std::string_view data, std::vector<std::string>* args) {
+  if (data.empty()) {
+    return false;
+  }
+
+  if (data[0] != '*') {
+    // Inline command, such as "GET key\r\n"
+    size_t pos = 0;
+    while (pos < data.size()) {
+      size_t start = data.find_first_not_of(" \t\r\n", pos);
+      if (start == std::string_view::npos) {
+        break;
+      }
+      size_t end = data.find_first_of(" \t\r\n", start);
+      if (end == std::string_view::npos) {
+        end = data.size();
+      }
+      args->emplace_back(data.substr(start, end - start));
+      pos = end;
+    }
+    return !args->empty();
+  }
+
+  size_t pos = 0;
+  int64_t count = 0;
+  if (!ReadRespInteger(data, '*', &pos, &count) || count <= 0) {
+    return false;
+  }
+  args->reserve(count);
+  for (int64_t i = 0; i < count; ++i) {
+    int64_t len = 0;
+    if (!ReadRespInteger(data, '$', &pos, &len) || len < 0 || pos + len + 2 > data.size()) {
+      return false;
+    }
+    args->emplace_back(data.substr(pos, len));
+    pos += len + 2;
+  }
+  return true;
+}
+
+// Gets the position of the first key among `args`, 0 means no key.
+size_t GetFirstKeyPosition(const std::string& name, const std::vector<std::string>& args) {
+  if (args.size() < 2 || IsKeylessCommand(name)) {
+    return 0;
+  }
+  if (name == "EVAL" || name == "EVALSHA" || name == "EVAL_RO" || name == "EVALSHA_RO" || name == "FCALL" ||
+      name == "FCALL_RO") {
+    // EVAL script numkeys key [key ...] arg [arg ...]
+    return args.size() > 3 && std::atoll(args[2].c_str()) > 0 ? 3 : 0;
+  }
+  if (name == "XREAD" || name == "XREADGROUP") {
+    // XREAD [COUNT count] [BLOCK milliseconds] STREAMS key [key ...] id [id ...]
+    for (size_t i = 1; i + 1 < args.size(); ++i) {
+      if (ToUpper(args[i]) == "STREAMS") {
+        return i + 1;
+      }
+    }
+    return 0;
+  }
+  return 1;
+}
+
+}  // namespace
+
+bool GetCommandArgs(const Request& req, std::vector<std::string>* args) {
+  if (req.do_RESP_) {
+    *args = req.params_;
+    return !args->empty();
+  }
+  return !req.params_.empty() && ParseRawCommand(req.params_.front(), args);
+}
+
+bool GetCommandSlot(const Request& req, int32_t* slot) {
+  std::vector<std::string> args;
+  if (!GetCommandArgs(req, &args)) {
+    return false;
+  }
+  size_t key_pos = GetFirstKeyPosition(ToUpper(args[0]), args);
+  *slot = key_pos > 0 && key_pos < args.size() ? GetKeySlot(args[key_pos]) : -1;
+  return true;
+}
+
+bool SplitClusterCommand(Request&& req, ClusterCommand* cmd) {
+  std::vector<std::string> args;
+  if (!GetCommandArgs(req, &args)) {
+    return false;
+  }
+
+  std::string name = ToUpper(args[0]);
+  // Arguments per key of the splittable multi-key commands
+  size_t step = 0;
+  if (name == "MGET") {
+    cmd->merge_type = ClusterCommand::MergeType::kArray;
+    step = 1;
+  } else if (name == "DEL" || name == "UNLINK" || name == "EXISTS" || name == "TOUCH") {
+    cmd->merge_type = ClusterCommand::MergeType::kSum;
+    step = 1;
+  } else if (name == "MSET") {
+    cmd->merge_type = ClusterCommand::MergeType::kStatus;
+    step = 2;
+  }
+
+  if (step > 0 && args.size() > 1 && (args.size() - 1) % step == 0) {
+    cmd->key_num = (args.size() - 1) / step;
+    for (size_t i = 1; i < args.size(); i += step) {
+      int32_t slot = GetKeySlot(args[i]);
+      ClusterSubCommand* sub_cmd = nullptr;
+      for (auto& exist : cmd->sub_cmds) {
+        if (exist.slot == slot) {
+          sub_cmd = &exist;
+          break;
+        }
+      }
+      if (sub_cmd == nullptr) {
+        sub_cmd = &cmd->sub_cmds.emplace_back();
+        sub_cmd->slot = slot;
+        sub_cmd->req.params_.push_back(args[0]);
+      }
+      sub_cmd->key_indexes.push_back((i - 1) / step);
+      for (size_t j = i; j < i + step; ++j) {
+        sub_cmd->req.params_.push_back(args[j]);
+      }
+    }
+    if (cmd->sub_cmds.size() > 1) {
+      return true;
+    }
+    // All keys in one slot, send the original command as is.
+    cmd->sub_cmds.clear();
+  }
+
+  cmd->merge_type = ClusterCommand::MergeType::kNone;
+  cmd->key_num = 0;
+  size_t key_pos = GetFirstKeyPosition(name, args);
+  ClusterSubCommand& sub_cmd = cmd->sub_cmds.emplace_back();
+  sub_cmd.slot = key_pos > 0 && key_pos < args.size() ? GetKeySlot(args[key_pos]) : -1;
+  sub_cmd.req = std::move(req);
+  return true;
+}
+
+Reply MergeClusterReplies(const ClusterCommand& cmd, std::vector<Reply>&& replies) {
+  for (auto& reply : replies) {
+    if (reply.IsError() || cmd.merge_type == ClusterCommand::MergeType::kNone) {
+      return std::move(reply);
+    }
+  }
+
+  switch (cmd.merge_type) {
+    case ClusterCommand::MergeType::kArray: {
+      std::vector<Reply> merged(cmd.key_num);
+      for (size_t i = 0; i < replies.size(); ++i) {
+        const auto& key_indexes = cmd.sub_cmds[i].key_indexes;
+        if (!replies[i].IsArray() || replies[i].GetArray().size() != key_indexes.size()) {
+          return Reply(ErrorReplyMarker{}, "ERR unexpected reply of split command");
+        }
+        auto& array = std::get<std::vector<Reply>>(replies[i].u_);
+        for (size_t j = 0; j < key_indexes.size(); ++j) {
+          merged[key_indexes[j]] = std::move(array[j]);
+        }
+      }
+      return Reply(ArrayReplyMarker{}, std::move(merged));
+    }
+    case ClusterCommand::MergeType::kSum: {
+      int64_t sum = 0;
+      for (const auto& reply : replies) {
+        if (!reply.IsInteger()) {
+          return Reply(ErrorReplyMarker{}, "ERR unexpected reply of split command");
+        }
+        sum += reply.GetInteger();
+      }
+      return Reply(IntegerReplyMarker{}, sum);
+    }
+    case ClusterCommand::MergeType::kStatus:
+      return Reply(StatusReplyMarker{}, "OK");
+    default:
+      return Reply(ErrorReplyMarker{}, "ERR unexpected reply of split command");
+  }
+}
+
+}  // namespace redis
+
+}  // namespace trpc
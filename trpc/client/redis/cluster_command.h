@@ -0,0 +1,80 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "trpc/client/redis/reply.h"
+#include "trpc/client/redis/request.h"
+
+namespace trpc {
+
+namespace redis {
+
+/// @brief Part of a command that only touches keys of one slot.
+struct ClusterSubCommand {
+  /// @brief Hash slot of the keys, -1 if the command has no key and can be sent to any node.
+  int32_t slot{-1};
+
+  Request req;
+
+  /// @brief Positions of the keys among all the keys of the original command, used to merge the replies.
+  std::vector<size_t> key_indexes;
+};
+
+/// @brief A command prepared for a redis cluster.
+struct ClusterCommand {
+  /// @brief How the replies of the sub commands make up the reply of the original command.
+  enum class MergeType {
+    /// Not split, the reply of the only sub command is used as is.
+    kNone,
+    /// Array replies are merged by key positions, e.g. MGET.
+    kArray,
+    /// Integer replies are summed up, e.g. DEL, EXISTS.
+    kSum,
+    /// Status replies are merged into one, e.g. MSET.
+    kStatus,
+  };
+
+  MergeType merge_type{MergeType::kNone};
+
+  /// @brief Number of keys of the original command.
+  size_t key_num{0};
+
+  std::vector<ClusterSubCommand> sub_cmds;
+};
+
+/// @brief Gets the arguments of a request, the raw (already encoded) form is parsed as well.
+/// @return false if the raw form can not be parsed.
+bool GetCommandArgs(const Request& req, std::vector<std::string>* args);
+
+/// @brief Gets the hash slot of the first key of `req`, -1 if it has no key.
+/// @return false if the command can not be parsed.
+bool GetCommandSlot(const Request& req, int32_t* slot);
+
+/// @brief Prepares `req` for a redis cluster. Multi-key commands (MGET, MSET, DEL, UNLINK, EXISTS, TOUCH) whose keys
+///        span several slots are split into one sub command per slot, other commands are kept whole as one sub command.
+///        Other commands are routed by their first key, keys of different slots are refused by the cluster then.
+/// @return false if the command can not be parsed.
+bool SplitClusterCommand(Request&& req, ClusterCommand* cmd);
+
+/// @brief Merges the replies of the sub commands of `cmd`, `replies` in the order of `cmd.sub_cmds`. The first error
+///        reply (if any) is returned as the reply of the whole command.
+Reply MergeClusterReplies(const ClusterCommand& cmd, std::vector<Reply>&& replies);
+
+}  // namespace redis
+
+}  // namespace trpc
@@ -0,0 +1,164 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/client/redis/cluster_command.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/client/redis/cluster_slot_map.h"
+#include "trpc/client/redis/cmdgen.h"
+
+namespace trpc::testing {
+
+using redis::ArrayReplyMarker;
+using redis::ClusterCommand;
+using redis::ErrorReplyMarker;
+using redis::IntegerReplyMarker;
+using redis::Reply;
+using redis::Request;
+using redis::StatusReplyMarker;
+using redis::StringReplyMarker;
+
+namespace {
+
+Request MakeRawRequest(std::string cmd) {
+  Request req;
+  req.do_RESP_ = false;
+  req.params_.emplace_back(std::move(cmd));
+  return req;
+}
+
+}  // namespace
+
+TEST(ClusterCommandTest, GetCommandArgs) {
+  std::vector<std::string> args;
+  ASSERT_TRUE(redis::GetCommandArgs(MakeRawRequest(redis::cmdgen{}.set("key", "a b\r\nc")), &args));
+  ASSERT_EQ((std::vector<std::string>{"set", "key", "a b\r\nc"}), args);
+
+  args.clear();
+  ASSERT_TRUE(redis::GetCommandArgs(MakeRawRequest("get  key\r\n"), &args));
+  ASSERT_EQ((std::vector<std::string>{"get", "key"}), args);
+
+  args.clear();
+  ASSERT_FALSE(redis::GetCommandArgs(MakeRawRequest("*2\r\n$3\r\nGET\r\n$10\r\nkey\r\n"), &args));
+
+  Request req;
+  req.params_ = {"GET", "key"};
+  ASSERT_TRUE(redis::GetCommandArgs(req, &args));
+  ASSERT_EQ(req.params_, args);
+}
+
+TEST(ClusterCommandTest, GetCommandSlot) {
+  int32_t slot = 0;
+  ASSERT_TRUE(redis::GetCommandSlot(MakeRawRequest(redis::cmdgen{}.get("foo")), &slot));
+  ASSERT_EQ(12182, slot);
+  ASSERT_TRUE(redis::GetCommandSlot(MakeRawRequest("PING\r\n"), &slot));
+  ASSERT_EQ(-1, slot);
+  ASSERT_TRUE(redis::GetCommandSlot(MakeRawRequest("CLUSTER SLOTS\r\n"), &slot));
+  ASSERT_EQ(-1, slot);
+  ASSERT_TRUE(redis::GetCommandSlot(MakeRawRequest("EVAL script 1 foo arg\r\n"), &slot));
+  ASSERT_EQ(12182, slot);
+  ASSERT_TRUE(redis::GetCommandSlot(MakeRawRequest("EVAL script 0 foo\r\n"), &slot));
+  ASSERT_EQ(-1, slot);
+  ASSERT_TRUE(redis::GetCommandSlot(MakeRawRequest("XREAD COUNT 2 STREAMS foo 0\r\n"), &slot));
+  ASSERT_EQ(12182, slot);
+}
+
+TEST(ClusterCommandTest, NotSplit) {
+  ClusterCommand cmd;
+  ASSERT_TRUE(redis::SplitClusterCommand(MakeRawRequest(redis::cmdgen{}.get("foo")), &cmd));
+  ASSERT_EQ(ClusterCommand::MergeType::kNone, cmd.merge_type);
+  ASSERT_EQ(1, cmd.sub_cmds.size());
+  ASSERT_EQ(12182, cmd.sub_cmds[0].slot);
+  // The original request is kept as is
+  ASSERT_FALSE(cmd.sub_cmds[0].req.do_RESP_);
+
+  // Keys of one slot
+  ClusterCommand mget;
+  Request req;
+  req.params_ = {"MGET", "{foo}1", "{foo}2"};
+  ASSERT_TRUE(redis::SplitClusterCommand(std::move(req), &mget));
+  ASSERT_EQ(ClusterCommand::MergeType::kNone, mget.merge_type);
+  ASSERT_EQ(1, mget.sub_cmds.size());
+  ASSERT_EQ((std::vector<std::string>{"MGET", "{foo}1", "{foo}2"}), mget.sub_cmds[0].req.params_);
+
+  ASSERT_EQ("value", redis::MergeClusterReplies(mget, {Reply(StringReplyMarker{}, "value")}).GetString());
+}
+
+TEST(ClusterCommandTest, SplitMget) {
+  ClusterCommand cmd;
+  Request req;
+  req.params_ = {"MGET", "foo", "bar", "{foo}1"};
+  ASSERT_TRUE(redis::SplitClusterCommand(std::move(req), &cmd));
+  ASSERT_EQ(ClusterCommand::MergeType::kArray, cmd.merge_type);
+  ASSERT_EQ(3, cmd.key_num);
+  ASSERT_EQ(2, cmd.sub_cmds.size());
+  ASSERT_EQ(12182, cmd.sub_cmds[0].slot);
+  ASSERT_EQ((std::vector<std::string>{"MGET", "foo", "{foo}1"}), cmd.sub_cmds[0].req.params_);
+  ASSERT_EQ((std::vector<size_t>{0, 2}), cmd.sub_cmds[0].key_indexes);
+  ASSERT_EQ(5061, cmd.sub_cmds[1].slot);
+  ASSERT_EQ((std::vector<std::string>{"MGET", "bar"}), cmd.sub_cmds[1].req.params_);
+
+  std::vector<Reply> foo_replies;
+  foo_replies.emplace_back(StringReplyMarker{}, "1");
+  foo_replies.emplace_back(StringReplyMarker{}, "3");
+  std::vector<Reply> bar_replies;
+  bar_replies.emplace_back(StringReplyMarker{}, "2");
+  std::vector<Reply> replies;
+  replies.emplace_back(ArrayReplyMarker{}, std::move(foo_replies));
+  replies.emplace_back(ArrayReplyMarker{}, std::move(bar_replies));
+  Reply reply = redis::MergeClusterReplies(cmd, std::move(replies));
+  ASSERT_TRUE(reply.IsArray());
+  ASSERT_EQ(3, reply.GetArray().size());
+  ASSERT_EQ("1", reply.GetArray()[0].GetString());
+  ASSERT_EQ("2", reply.GetArray()[1].GetString());
+  ASSERT_EQ("3", reply.GetArray()[2].GetString());
+
+  // The first error is the reply of the whole command
+  std::vector<Reply> error_replies;
+  error_replies.emplace_back(ArrayReplyMarker{}, std::vector<Reply>(2));
+  error_replies.emplace_back(ErrorReplyMarker{}, "CLUSTERDOWN");
+  ASSERT_EQ("CLUSTERDOWN", redis::MergeClusterReplies(cmd, std::move(error_replies)).GetString());
+}
+
+TEST(ClusterCommandTest, SplitDelAndMset) {
+  ClusterCommand del;
+  ASSERT_TRUE(redis::SplitClusterCommand(MakeRawRequest(redis::cmdgen{}.del({"foo", "bar"})), &del));
+  ASSERT_EQ(ClusterCommand::MergeType::kSum, del.merge_type);
+  ASSERT_EQ(2, del.sub_cmds.size());
+  std::vector<Reply> del_replies;
+  del_replies.emplace_back(IntegerReplyMarker{}, 1);
+  del_replies.emplace_back(IntegerReplyMarker{}, 0);
+  ASSERT_EQ(1, redis::MergeClusterReplies(del, std::move(del_replies)).GetInteger());
+
+  ClusterCommand mset;
+  Request req;
+  req.params_ = {"MSET", "foo", "1", "bar", "2"};
+  ASSERT_TRUE(redis::SplitClusterCommand(std::move(req), &mset));
+  ASSERT_EQ(ClusterCommand::MergeType::kStatus, mset.merge_type);
+  ASSERT_EQ(2, mset.sub_cmds.size());
+  ASSERT_EQ((std::vector<std::string>{"MSET", "foo", "1"}), mset.sub_cmds[0].req.params_);
+  ASSERT_EQ((std::vector<std::string>{"MSET", "bar", "2"}), mset.sub_cmds[1].req.params_);
+  std::vector<Reply> mset_replies;
+  mset_replies.emplace_back(StatusReplyMarker{}, "OK");
+  mset_replies.emplace_back(StatusReplyMarker{}, "OK");
+  Reply reply = redis::MergeClusterReplies(mset, std::move(mset_replies));
+  ASSERT_TRUE(reply.IsStatus());
+  ASSERT_EQ("OK", reply.GetString());
+}
+
+}  // namespace trpc::testing
@@ -0,0 +1,198 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/client/redis/cluster_slot_map.h"
+
+#include <array>
+#include <cstdlib>
+#include <mutex>
+#include <utility>
+
+namespace trpc {
+
+namespace redis {
+
+namespace {
+
+// CRC16-CCITT (XMODEM) which redis cluster uses for key hashing: polynomial 0x1021, initial value 0.
+constexpr std::array<uint16_t, 256> MakeCrc16Table() {
+  std::array<uint16_t, 256> table{};
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint16_t crc = static_cast<uint16_t>(i << 8);
+    for (int j = 0; j < 8; ++j) {
+      crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+    }
+    table[i] = crc;
+  }
+  return table;
+}
+
+constexpr std::array<uint16_t, 256> kCrc16Table = MakeCrc16Table();
+
+uint16_t Crc16(std::string_view data) {
+  uint16_t crc = 0;
+  for (unsigned char c : data) {
+    crc = static_cast<uint16_t>((crc << 8) ^ kCrc16Table[((crc >> 8) ^ c) & 0xFF]);
+  }
+  return crc;
+}
+
+bool ParseNode(std::string_view addr, ClusterNode* node) {
+  // IPv6 addresses contain ':' as well, the port follows the last one.
+  size_t pos = addr.rfind(':');
+  if (pos == std::string_view::npos || pos == 0 || pos + 1 == addr.size()) {
+    return false;
+  }
+  int port = std::atoi(std::string(addr.substr(pos + 1)).c_str());
+  if (port <= 0 || port > 65535) {
+    return false;
+  }
+  node->ip = std::string(addr.substr(0, pos));
+  node->port = static_cast<uint16_t>(port);
+  return true;
+}
+
+}  // namespace
+
+uint16_t GetKeySlot(std::string_view key) {
+  size_t start = key.find('{');
+  if (start != std::string_view::npos) {
+    size_t end = key.find('}', start + 1);
+    // An empty hash tag "{}" does not count, the whole key is hashed then.
+    if (end != std::string_view::npos && end != start + 1) {
+      key = key.substr(start + 1, end - start - 1);
+    }
+  }
+  return Crc16(key) & (kClusterSlotNum - 1);
+}
+
+bool ParseRedirection(const Reply& reply, ClusterRedirection* redirection) {
+  if (!reply.IsError()) {
+    return false;
+  }
+
+  // Format: "MOVED <slot> <ip>:<port>" or "ASK <slot> <ip>:<port>"
+  std::string_view error = reply.GetString();
+  bool ask = false;
+  if (error.compare(0, 6, "MOVED ") == 0) {
+    error.remove_prefix(6);
+  } else if (error.compare(0, 4, "ASK ") == 0) {
+    ask = true;
+    error.remove_prefix(4);
+  } else {
+    return false;
+  }
+
+  size_t pos = error.find(' ');
+  if (pos == std::string_view::npos) {
+    return false;
+  }
+  int slot = std::atoi(std::string(error.substr(0, pos)).c_str());
+  if (slot < 0 || slot >= kClusterSlotNum) {
+    return false;
+  }
+
+  ClusterNode node;
+  if (!ParseNode(error.substr(pos + 1), &node)) {
+    return false;
+  }
+
+  redirection->ask = ask;
+  redirection->slot = static_cast<uint16_t>(slot);
+  redirection->node = std::move(node);
+  return true;
+}
+
+bool ClusterSlotMap::Update(const Reply& cluster_slots) {
+  if (!cluster_slots.IsArray()) {
+    return false;
+  }
+
+  // Each entry: [start slot, end slot, [master ip, master port, id, ...], [replica ...] ...]
+  std::vector<ClusterNode> nodes;
+  std::vector<int32_t> slots(kClusterSlotNum, -1);
+  for (const auto& entry : cluster_slots.GetArray()) {
+    if (!entry.IsArray() || entry.GetArray().size() < 3) {
+      return false;
+    }
+    const auto& items = entry.GetArray();
+    const auto& master = items[2];
+    if (!items[0].IsInteger() || !items[1].IsInteger() || !master.IsArray() || master.GetArray().size() < 2 ||
+        !master.GetArray()[0].IsString() || !master.GetArray()[1].IsInteger()) {
+      return false;
+    }
+
+    int64_t start = items[0].GetInteger();
+    int64_t end = items[1].GetInteger();
+    if (start < 0 || end >= kClusterSlotNum || start > end) {
+      return false;
+    }
+
+    ClusterNode node{master.GetArray()[0].GetString(), static_cast<uint16_t>(master.GetArray()[1].GetInteger())};
+    if (node.ip.empty()) {
+      // The endpoint of the node is unknown, its slots are left to redirections.
+      continue;
+    }
+
+    int32_t index = 0;
+    while (index < static_cast<int32_t>(nodes.size()) && !(nodes[index] == node)) {
+      ++index;
+    }
+    if (index == static_cast<int32_t>(nodes.size())) {
+      nodes.emplace_back(std::move(node));
+    }
+
+    for (int64_t slot = start; slot <= end; ++slot) {
+      slots[slot] = index;
+    }
+  }
+
+  std::unique_lock lock(mutex_);
+  nodes_.swap(nodes);
+  slots_.swap(slots);
+  return true;
+}
+
+void ClusterSlotMap::Update(uint16_t slot, const ClusterNode& node) {
+  std::unique_lock lock(mutex_);
+  slots_[slot % kClusterSlotNum] = GetNodeIndex(node);
+}
+
+bool ClusterSlotMap::GetNode(uint16_t slot, ClusterNode* node) const {
+  std::shared_lock lock(mutex_);
+  int32_t index = slots_[slot % kClusterSlotNum];
+  if (index < 0) {
+    return false;
+  }
+  *node = nodes_[index];
+  return true;
+}
+
+bool ClusterSlotMap::Empty() const {
+  std::shared_lock lock(mutex_);
+  return nodes_.empty();
+}
+
+int32_t ClusterSlotMap::GetNodeIndex(const ClusterNode& node) {
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    if (nodes_[i] == node) {
+      return static_cast<int32_t>(i);
+    }
+  }
+  nodes_.push_back(node);
+  return static_cast<int32_t>(nodes_.size() - 1);
+}
+
+}  // namespace redis
+
+}  // namespace trpc
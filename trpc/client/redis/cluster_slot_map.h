@@ -0,0 +1,88 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "trpc/client/redis/reply.h"
+
+namespace trpc {
+
+namespace redis {
+
+/// @brief Number of hash slots of a redis cluster.
+constexpr uint16_t kClusterSlotNum = 16384;
+
+/// @brief Address of a redis cluster node.
+struct ClusterNode {
+  std::string ip;
+  uint16_t port{0};
+
+  bool operator==(const ClusterNode& other) const { return ip == other.ip && port == other.port; }
+};
+
+/// @brief Redirection carried by a `MOVED` or `ASK` error reply of a redis cluster.
+struct ClusterRedirection {
+  /// @brief Whether it is an `ASK` redirection, which only applies to the next command with `ASKING` in front.
+  bool ask{false};
+  uint16_t slot{0};
+  ClusterNode node;
+};
+
+/// @brief Gets the hash slot of `key`, only the part within the first "{...}" (hash tag) is hashed if there is one.
+uint16_t GetKeySlot(std::string_view key);
+
+/// @brief Parses a `MOVED`/`ASK` error reply, such as "MOVED 3999 127.0.0.1:6381".
+/// @return Whether `reply` is a redirection.
+bool ParseRedirection(const Reply& reply, ClusterRedirection* redirection);
+
+/// @brief Map from the hash slots of a redis cluster to their master nodes, thread-safe.
+class ClusterSlotMap {
+ public:
+  ClusterSlotMap() : slots_(kClusterSlotNum, -1) {}
+
+  /// @brief Replaces the whole map by the reply of `CLUSTER SLOTS`.
+  /// @return false if the reply is malformed, the map is left unchanged then.
+  bool Update(const Reply& cluster_slots);
+
+  /// @brief Moves a single slot to `node`, used on `MOVED` redirections.
+  void Update(uint16_t slot, const ClusterNode& node);
+
+  /// @brief Gets the master node of `slot`.
+  /// @return false if the slot is not covered by the map.
+  bool GetNode(uint16_t slot, ClusterNode* node) const;
+
+  /// @brief Whether no slot is known yet.
+  bool Empty() const;
+
+ private:
+  int32_t GetNodeIndex(const ClusterNode& node);
+
+ private:
+  mutable std::shared_mutex mutex_;
+
+  // Known nodes, never shrink between full updates.
+  std::vector<ClusterNode> nodes_;
+
+  // Index of the master node in `nodes_` of each slot, -1 means unknown.
+  std::vector<int32_t> slots_;
+};
+
+}  // namespace redis
+
+}  // namespace trpc
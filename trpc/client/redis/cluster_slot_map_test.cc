@@ -0,0 +1,128 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/client/redis/cluster_slot_map.h"
+
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+using redis::ArrayReplyMarker;
+using redis::ClusterNode;
+using redis::ClusterRedirection;
+using redis::ClusterSlotMap;
+using redis::ErrorReplyMarker;
+using redis::IntegerReplyMarker;
+using redis::Reply;
+using redis::StringReplyMarker;
+
+namespace {
+
+Reply MakeSlotRange(int64_t start, int64_t end, std::string ip, int64_t port) {
+  std::vector<Reply> node;
+  node.emplace_back(StringReplyMarker{}, std::move(ip));
+  node.emplace_back(IntegerReplyMarker{}, port);
+  node.emplace_back(StringReplyMarker{}, "09dbe9720cda62f7865eabc5fd8857c5d2678366");
+
+  std::vector<Reply> range;
+  range.emplace_back(IntegerReplyMarker{}, start);
+  range.emplace_back(IntegerReplyMarker{}, end);
+  range.emplace_back(ArrayReplyMarker{}, std::move(node));
+  return Reply(ArrayReplyMarker{}, std::move(range));
+}
+
+}  // namespace
+
+TEST(ClusterSlotMapTest, GetKeySlot) {
+  ASSERT_EQ(12739, redis::GetKeySlot("123456789"));
+  ASSERT_EQ(12182, redis::GetKeySlot("foo"));
+  ASSERT_EQ(5061, redis::GetKeySlot("bar"));
+  ASSERT_EQ(0, redis::GetKeySlot(""));
+
+  // Only the hash tag is hashed
+  ASSERT_EQ(redis::GetKeySlot("user1000"), redis::GetKeySlot("{user1000}.following"));
+  ASSERT_EQ(redis::GetKeySlot("user1000"), redis::GetKeySlot("{user1000}.followers"));
+  ASSERT_EQ(redis::GetKeySlot("bar"), redis::GetKeySlot("foo{bar}{zap}"));
+  ASSERT_EQ(redis::GetKeySlot("{bar"), redis::GetKeySlot("foo{{bar}}zap"));
+  // Empty or unclosed hash tags do not count
+  ASSERT_NE(redis::GetKeySlot("bar"), redis::GetKeySlot("foo{}{bar}"));
+  ASSERT_NE(redis::GetKeySlot("bar"), redis::GetKeySlot("foo{bar"));
+}
+
+TEST(ClusterSlotMapTest, ParseRedirection) {
+  ClusterRedirection redirection;
+  ASSERT_TRUE(redis::ParseRedirection(Reply(ErrorReplyMarker{}, "MOVED 3999 127.0.0.1:6381"), &redirection));
+  ASSERT_FALSE(redirection.ask);
+  ASSERT_EQ(3999, redirection.slot);
+  ASSERT_EQ("127.0.0.1", redirection.node.ip);
+  ASSERT_EQ(6381, redirection.node.port);
+
+  ASSERT_TRUE(redis::ParseRedirection(Reply(ErrorReplyMarker{}, "ASK 16383 ::1:7000"), &redirection));
+  ASSERT_TRUE(redirection.ask);
+  ASSERT_EQ(16383, redirection.slot);
+  ASSERT_EQ("::1", redirection.node.ip);
+  ASSERT_EQ(7000, redirection.node.port);
+
+  ASSERT_FALSE(redis::ParseRedirection(Reply(ErrorReplyMarker{}, "ERR unknown command"), &redirection));
+  ASSERT_FALSE(redis::ParseRedirection(Reply(ErrorReplyMarker{}, "MOVED 16384 127.0.0.1:6381"), &redirection));
+  ASSERT_FALSE(redis::ParseRedirection(Reply(ErrorReplyMarker{}, "MOVED 3999 127.0.0.1"), &redirection));
+  ASSERT_FALSE(redis::ParseRedirection(Reply(StringReplyMarker{}, "MOVED 3999 127.0.0.1:6381"), &redirection));
+}
+
+TEST(ClusterSlotMapTest, Update) {
+  ClusterSlotMap slot_map;
+  ClusterNode node;
+  ASSERT_TRUE(slot_map.Empty());
+  ASSERT_FALSE(slot_map.GetNode(0, &node));
+
+  std::vector<Reply> ranges;
+  ranges.emplace_back(MakeSlotRange(0, 5460, "127.0.0.1", 7000));
+  ranges.emplace_back(MakeSlotRange(5461, 10922, "127.0.0.1", 7001));
+  ranges.emplace_back(MakeSlotRange(10923, 16383, "127.0.0.1", 7002));
+  ASSERT_TRUE(slot_map.Update(Reply(ArrayReplyMarker{}, std::move(ranges))));
+  ASSERT_FALSE(slot_map.Empty());
+
+  ASSERT_TRUE(slot_map.GetNode(5460, &node));
+  ASSERT_EQ(7000, node.port);
+  ASSERT_TRUE(slot_map.GetNode(5461, &node));
+  ASSERT_EQ(7001, node.port);
+  ASSERT_TRUE(slot_map.GetNode(16383, &node));
+  ASSERT_EQ(7002, node.port);
+
+  // Incremental update of a moved slot
+  slot_map.Update(5461, ClusterNode{"127.0.0.1", 7003});
+  ASSERT_TRUE(slot_map.GetNode(5461, &node));
+  ASSERT_EQ(7003, node.port);
+  ASSERT_TRUE(slot_map.GetNode(5462, &node));
+  ASSERT_EQ(7001, node.port);
+
+  // Malformed replies leave the map unchanged
+  std::vector<Reply> bad_ranges;
+  bad_ranges.emplace_back(MakeSlotRange(0, 16384, "127.0.0.1", 7000));
+  ASSERT_FALSE(slot_map.Update(Reply(ArrayReplyMarker{}, std::move(bad_ranges))));
+  ASSERT_FALSE(slot_map.Update(Reply(StringReplyMarker{}, "OK")));
+  ASSERT_TRUE(slot_map.GetNode(0, &node));
+  ASSERT_EQ(7000, node.port);
+
+  // Slots not covered by a full update are unknown
+  std::vector<Reply> part_ranges;
+  part_ranges.emplace_back(MakeSlotRange(0, 100, "127.0.0.1", 7000));
+  ASSERT_TRUE(slot_map.Update(Reply(ArrayReplyMarker{}, std::move(part_ranges))));
+  ASSERT_TRUE(slot_map.GetNode(100, &node));
+  ASSERT_FALSE(slot_map.GetNode(101, &node));
+}
+
+}  // namespace trpc::testing
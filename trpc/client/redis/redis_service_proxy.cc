@@ -15,21 +15,38 @@
 
 #include <utility>
 
+#include "trpc/client/redis/cmdgen.h"
+#include "trpc/future/future_utility.h"
+
 #include "trpc/codec/client_codec_factory.h"
-#include "trpc/util/log/logging.h"
+#include "trpc/codec/redis/redis_protocol.h"
+#include "trpc/coroutine/fiber.h"
+#include "trpc/coroutine/future.h"
 #include "trpc/transport/client/common/redis_client_io_handler.h"
+#include "trpc/util/log/logging.h"
 
 namespace trpc {
 
 namespace redis {
 
+namespace {
+
+// Redirections followed by a command at most, a slot is not expected to move more than once or twice during a call.
+constexpr int kMaxClusterRedirections = 5;
+
+RedisRequestProtocol* GetRedisRequestProtocol(const ClientContextPtr& context) {
+  return static_cast<RedisRequestProtocol*>(context->GetRequest().get());
+}
+
+}  // namespace
+
 Status RedisServiceProxy::Command(const ClientContextPtr& context, Reply* rsp, const std::string& cmd) {
   Request req;
 
   req.do_RESP_ = false;
   req.params_.push_back(cmd);
 
-  return UnaryInvoke<Request, Reply>(context, std::move(req), rsp);
+  return Invoke(context, std::move(req), rsp);
 }
 
 Status RedisServiceProxy::Command(const ClientContextPtr& context, Reply* rsp, std::string&& cmd) {
@@ -38,7 +55,7 @@ Status RedisServiceProxy::Command(const ClientContextPtr& context, Reply* rsp, s
   req.do_RESP_ = false;
   req.params_.emplace_back(std::move(cmd));
 
-  return UnaryInvoke<Request, Reply>(context, std::move(req), rsp);
+  return Invoke(context, std::move(req), rsp);
 }
 
 Status RedisServiceProxy::Command(const ClientContextPtr& context, Reply* rsp, const char* format, ...) {
@@ -52,14 +69,14 @@ Status RedisServiceProxy::Command(const ClientContextPtr& context, Reply* rsp, c
   }
   va_end(ap);
 
-  return UnaryInvoke<Request, Reply>(context, std::move(req), rsp);
+  return Invoke(context, std::move(req), rsp);
 }
 
 Future<Reply> RedisServiceProxy::AsyncCommand(const ClientContextPtr& context, std::string&& cmd) {
   Request req;
   req.do_RESP_ = false;
   req.params_.emplace_back(std::move(cmd));
-  return AsyncUnaryInvoke<Request, Reply>(context, std::move(req));
+  return AsyncInvoke(context, std::move(req));
 }
 
 Future<Reply> RedisServiceProxy::AsyncCommand(const ClientContextPtr& context, const std::string& cmd) {
@@ -68,7 +85,7 @@ Future<Reply> RedisServiceProxy::AsyncCommand(const ClientContextPtr& context, c
   req.do_RESP_ = false;
   req.params_.push_back(cmd);
 
-  return AsyncUnaryInvoke<Request, Reply>(context, std::move(req));
+  return AsyncInvoke(context, std::move(req));
 }
 
 Future<Reply> RedisServiceProxy::AsyncCommand(const ClientContextPtr& context, const char* format, ...) {
@@ -82,7 +99,7 @@ Future<Reply> RedisServiceProxy::AsyncCommand(const ClientContextPtr& context, c
   }
   va_end(ap);
 
-  return AsyncUnaryInvoke<Request, Reply>(context, std::move(req));
+  return AsyncInvoke(context, std::move(req));
 }
 
 Status RedisServiceProxy::CommandArgv(const ClientContextPtr& context, const Request& req, Reply* rsp) {
@@ -90,7 +107,7 @@ Status RedisServiceProxy::CommandArgv(const ClientContextPtr& context, const Req
   copy_req.do_RESP_ = req.do_RESP_;
   copy_req.params_.reserve(req.params_.size());
   copy_req.params_.insert(copy_req.params_.begin(), req.params_.begin(), req.params_.end());
-  return UnaryInvoke<Request, Reply>(context, std::move(copy_req), rsp);
+  return Invoke(context, std::move(copy_req), rsp);
 }
 
 Future<Reply> RedisServiceProxy::AsyncCommandArgv(const ClientContextPtr& context, const Request& req) {
@@ -98,23 +115,380 @@ Future<Reply> RedisServiceProxy::AsyncCommandArgv(const ClientContextPtr& contex
   copy_req.do_RESP_ = req.do_RESP_;
   copy_req.params_.reserve(req.params_.size());
   copy_req.params_.insert(copy_req.params_.begin(), req.params_.begin(), req.params_.end());
-  return AsyncUnaryInvoke<Request, Reply>(context, std::move(copy_req));
+  return AsyncInvoke(context, std::move(copy_req));
 }
 
 Status RedisServiceProxy::CommandArgv(const ClientContextPtr& context, Request&& req, Reply* rsp) {
-  return UnaryInvoke<Request, Reply>(context, std::move(req), rsp);
+  return Invoke(context, std::move(req), rsp);
 }
 
 Future<Reply> RedisServiceProxy::AsyncCommandArgv(const ClientContextPtr& context, Request&& req) {
+  return AsyncInvoke(context, std::move(req));
+}
+
+Status RedisServiceProxy::Pipeline(const ClientContextPtr& context, std::vector<Request>&& reqs,
+                                   std::vector<Reply>* replies) {
+  Status status = CheckPipeline(context, reqs);
+  if (!status.OK()) {
+    return status;
+  }
+  return UnaryInvoke<std::vector<Request>, std::vector<Reply>>(context, std::move(reqs), replies);
+}
+
+Status RedisServiceProxy::Pipeline(const ClientContextPtr& context, const std::vector<Request>& reqs,
+                                   std::vector<Reply>* replies) {
+  std::vector<Request> copy_reqs = reqs;
+  return Pipeline(context, std::move(copy_reqs), replies);
+}
+
+Future<std::vector<Reply>> RedisServiceProxy::AsyncPipeline(const ClientContextPtr& context,
+                                                            std::vector<Request>&& reqs) {
+  Status status = CheckPipeline(context, reqs);
+  if (!status.OK()) {
+    return MakeExceptionFuture<std::vector<Reply>>(CommonException(status.ErrorMessage().c_str()));
+  }
+  return AsyncUnaryInvoke<std::vector<Request>, std::vector<Reply>>(context, std::move(reqs));
+}
+
+Future<std::vector<Reply>> RedisServiceProxy::AsyncPipeline(const ClientContextPtr& context,
+                                                            const std::vector<Request>& reqs) {
+  std::vector<Request> copy_reqs = reqs;
+  return AsyncPipeline(context, std::move(copy_reqs));
+}
+
+Status RedisServiceProxy::CheckPipeline(const ClientContextPtr& context, const std::vector<Request>& reqs) {
+  if (reqs.empty()) {
+    return Status(-1, "redis pipeline has no request");
+  }
+  // Replies are matched to a call by their count, so the connection must not be shared by other calls in flight
+  if (codec_->Name() != "redis" || GetServiceProxyOption()->support_pipeline) {
+    return Status(-1, "redis pipeline requires redis protocol without connection-level pipeline");
+  }
+  if (slot_map_) {
+    // The whole pipeline goes to one node, all its keys must belong to one slot
+    int32_t slot = -1;
+    for (const auto& req : reqs) {
+      int32_t req_slot = -1;
+      if (!GetCommandSlot(req, &req_slot)) {
+        return Status(-1, "parse redis command failed");
+      }
+      if (req_slot >= 0 && slot >= 0 && req_slot != slot) {
+        return Status(-1, "redis pipeline in cluster mode requires keys of one slot");
+      }
+      slot = req_slot >= 0 ? req_slot : slot;
+    }
+    ClusterNode node;
+    if (slot >= 0 && slot_map_->GetNode(slot, &node)) {
+      context->SetAddr(node.ip, node.port);
+    }
+  }
+  context->SetPipelineCount(static_cast<uint32_t>(reqs.size()));
+  return kSuccStatus;
+}
+
+Status RedisServiceProxy::Invoke(const ClientContextPtr& context, Request&& req, Reply* rsp) {
+  if (slot_map_) {
+    return ClusterInvoke(context, std::move(req), rsp);
+  }
+  return UnaryInvoke<Request, Reply>(context, std::move(req), rsp);
+}
+
+Future<Reply> RedisServiceProxy::AsyncInvoke(const ClientContextPtr& context, Request&& req) {
+  if (slot_map_) {
+    return AsyncClusterInvoke(context, std::move(req));
+  }
   return AsyncUnaryInvoke<Request, Reply>(context, std::move(req));
 }
 
+Status RedisServiceProxy::Oneway(const ClientContextPtr& context, Request&& req) {
+  if (slot_map_) {
+    int32_t slot = -1;
+    ClusterNode node;
+    if (GetCommandSlot(req, &slot) && slot >= 0 && slot_map_->GetNode(slot, &node)) {
+      context->SetAddr(node.ip, node.port);
+    }
+  }
+  return OnewayInvoke<Request>(context, std::move(req));
+}
+
+ClientContextPtr RedisServiceProxy::MakeClusterContext(const ClientContextPtr& context, const ClusterNode* node) {
+  // A call to a node is made on behalf of the caller, so it carries what the caller set on its context
+  ClientContextPtr cluster_context = MakeRefCounted<ClientContext>(codec_);
+  cluster_context->SetTimeout(context->GetTimeout(), context->IsIgnoreProxyTimeout());
+  if (context->IsUseFullLinkTimeout()) {
+    cluster_context->SetFullLinkTimeout(context->GetTimeout());
+  }
+  cluster_context->SetCallerName(context->GetCallerName());
+  cluster_context->SetCalleeName(context->GetCalleeName());
+  cluster_context->SetFuncName(context->GetFuncName());
+  cluster_context->SetCallerFuncName(context->GetCallerFuncName());
+  cluster_context->SetMessageType(context->GetMessageType());
+  const auto& trans_info = context->GetPbReqTransInfo();
+  if (trans_info.size() > 0) {
+    cluster_context->SetReqTransInfo(trans_info.begin(), trans_info.end());
+  }
+  cluster_context->SetHashKey(context->GetHashKey());
+  cluster_context->SetServiceTarget(context->GetServiceTarget());
+  for (const auto& [id, filter_data] : context->GetAllFilterData()) {
+    cluster_context->GetAllFilterData().emplace(id, filter_data);
+  }
+  if (node != nullptr) {
+    cluster_context->SetAddr(node->ip, node->port);
+  }
+  return cluster_context;
+}
+
+ClientContextPtr RedisServiceProxy::MakeClusterContext(const ClientContextPtr& context, int32_t slot) {
+  ClusterNode node;
+  if (slot >= 0 && slot_map_->GetNode(slot, &node)) {
+    return MakeClusterContext(context, &node);
+  }
+  // Slot unknown or command without key, any node will do
+  return MakeClusterContext(context, nullptr);
+}
+
+void RedisServiceProxy::BackFillClusterContext(const ClientContextPtr& context,
+                                               const ClientContextPtr& cluster_context) {
+  context->SetStatus(cluster_context->GetStatus());
+  // Reported as the node chosen for the call, the caller's later calls are not bound to it
+  ExtendNodeAddr addr;
+  addr.addr = cluster_context->GetNodeAddr();
+  addr.metadata = cluster_context->GetTargetMetadata();
+  context->SetRequestAddrByNaming(std::move(addr));
+}
+
+Status RedisServiceProxy::ClusterInvoke(const ClientContextPtr& context, Request&& req, Reply* rsp) {
+  if (NeedRefreshSlotMap()) {
+    RefreshSlotMap(context);
+  }
+
+  auto call = std::make_shared<ClusterCall>();
+  if (!SplitClusterCommand(std::move(req), &call->cmd)) {
+    return Status(-1, "parse redis command failed");
+  }
+
+  if (call->cmd.sub_cmds.size() > 1) {
+    // Sub commands go to their nodes concurrently the same way as an asynchronous call, and all of them are waited for
+    Future<Reply> fut = AsyncClusterInvoke(context, call);
+    fut = IsRunningInFiberWorker() ? fiber::BlockingGet(std::move(fut)) : future::BlockingGet(std::move(fut));
+    if (fut.IsFailed()) {
+      if (context->GetStatus().OK()) {
+        context->SetStatus(Status(-1, fut.GetException().what()));
+      }
+      return context->GetStatus();
+    }
+    *rsp = fut.GetValue0();
+    return context->GetStatus();
+  }
+
+  ClusterSubCommand& sub_cmd = call->cmd.sub_cmds[0];
+  ClientContextPtr cluster_context = MakeClusterContext(context, sub_cmd.slot);
+  Reply reply;
+  bool asking = false;
+  for (int redirections = 0;; ++redirections) {
+    Status status = ClusterSend(cluster_context, sub_cmd.req, asking, &reply);
+    if (!status.OK()) {
+      BackFillClusterContext(context, cluster_context);
+      return status;
+    }
+    ClusterRedirection redirection;
+    if (redirections == kMaxClusterRedirections || !OnClusterRedirection(reply, &redirection)) {
+      break;
+    }
+    cluster_context = MakeClusterContext(context, &redirection.node);
+    asking = redirection.ask;
+  }
+
+  BackFillClusterContext(context, cluster_context);
+  std::vector<Reply> replies;
+  replies.emplace_back(std::move(reply));
+  *rsp = MergeClusterReplies(call->cmd, std::move(replies));
+  return context->GetStatus();
+}
+
+Status RedisServiceProxy::ClusterSend(const ClientContextPtr& cluster_context, Request& req, bool asking,
+                                      Reply* rsp) {
+  Status status;
+  if (asking) {
+    // `ASKING` only applies to the very next command on the same connection, so they go out as a pipeline
+    std::vector<Request> reqs(2);
+    reqs[0].params_.emplace_back("ASKING");
+    reqs[1] = std::move(req);
+    std::vector<Reply> replies;
+    cluster_context->SetPipelineCount(2);
+    status = UnaryInvoke<std::vector<Request>, std::vector<Reply>>(cluster_context, std::move(reqs), &replies);
+    if (status.OK()) {
+      req = std::move(GetRedisRequestProtocol(cluster_context)->redis_reqs[1]);
+      *rsp = std::move(replies[1]);
+    }
+  } else {
+    status = UnaryInvoke<Request, Reply>(cluster_context, std::move(req), rsp);
+    if (status.OK()) {
+      req = std::move(GetRedisRequestProtocol(cluster_context)->redis_req);
+    }
+  }
+
+  if (!status.OK() && cluster_context->IsSetAddr()) {
+    // The node may have left the cluster
+    slot_map_stale_.store(true, std::memory_order_relaxed);
+  }
+  return status;
+}
+
+Future<Reply> RedisServiceProxy::AsyncClusterInvoke(const ClientContextPtr& context, Request&& req) {
+  auto call = std::make_shared<ClusterCall>();
+  if (!SplitClusterCommand(std::move(req), &call->cmd)) {
+    return MakeExceptionFuture<Reply>(CommonException("parse redis command failed"));
+  }
+
+  Future<> ready = NeedRefreshSlotMap() ? AsyncRefreshSlotMap(context) : MakeReadyFuture<>();
+  return ready.Then([this, context, call]() { return AsyncClusterInvoke(context, call); });
+}
+
+Future<Reply> RedisServiceProxy::AsyncClusterInvoke(const ClientContextPtr& context,
+                                                    const std::shared_ptr<ClusterCall>& call) {
+  size_t count = call->cmd.sub_cmds.size();
+  call->contexts.resize(count);
+  std::vector<Future<Reply>> futs;
+  futs.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    futs.emplace_back(
+        AsyncClusterInvoke(context, call, i, MakeClusterContext(context, call->cmd.sub_cmds[i].slot), false, 0));
+  }
+  return WhenAll(futs.begin(), futs.end()).Then([context, call](std::vector<Future<Reply>>&& futs) {
+    // The caller's context reports the first failed call, or the last one if all of them succeeded
+    size_t result = futs.size() - 1;
+    for (size_t i = 0; i < futs.size(); ++i) {
+      if (futs[i].IsFailed()) {
+        result = i;
+        break;
+      }
+    }
+    BackFillClusterContext(context, call->contexts[result]);
+    if (futs[result].IsFailed()) {
+      return MakeExceptionFuture<Reply>(futs[result].GetException());
+    }
+
+    std::vector<Reply> replies;
+    replies.reserve(futs.size());
+    for (auto& fut : futs) {
+      replies.emplace_back(fut.GetValue0());
+    }
+    return MakeReadyFuture<Reply>(MergeClusterReplies(call->cmd, std::move(replies)));
+  });
+}
+
+Future<Reply> RedisServiceProxy::AsyncClusterInvoke(const ClientContextPtr& context,
+                                                    const std::shared_ptr<ClusterCall>& call, size_t index,
+                                                    const ClientContextPtr& cluster_context, bool asking,
+                                                    int redirections) {
+  // Each sub command only touches its own slot, so sub commands completing concurrently don't race
+  call->contexts[index] = cluster_context;
+  Request& req = call->cmd.sub_cmds[index].req;
+  Future<Reply> fut;
+  if (asking) {
+    // Same as `ClusterSend`, `ASKING` goes out together with the command
+    std::vector<Request> reqs(2);
+    reqs[0].params_.emplace_back("ASKING");
+    reqs[1] = std::move(req);
+    cluster_context->SetPipelineCount(2);
+    fut = AsyncUnaryInvoke<std::vector<Request>, std::vector<Reply>>(cluster_context, std::move(reqs))
+              .Then([cluster_context, &req](std::vector<Reply>&& replies) {
+                req = std::move(GetRedisRequestProtocol(cluster_context)->redis_reqs[1]);
+                return MakeReadyFuture<Reply>(std::move(replies[1]));
+              });
+  } else {
+    fut = AsyncUnaryInvoke<Request, Reply>(cluster_context, std::move(req)).Then([cluster_context, &req](Reply&& reply) {
+      req = std::move(GetRedisRequestProtocol(cluster_context)->redis_req);
+      return MakeReadyFuture<Reply>(std::move(reply));
+    });
+  }
+
+  return fut.Then([this, context, call, index, cluster_context, redirections](Future<Reply>&& fut) {
+    if (fut.IsFailed()) {
+      if (cluster_context->IsSetAddr()) {
+        slot_map_stale_.store(true, std::memory_order_relaxed);
+      }
+      return std::move(fut);
+    }
+
+    Reply reply = fut.GetValue0();
+    ClusterRedirection redirection;
+    if (redirections == kMaxClusterRedirections || !OnClusterRedirection(reply, &redirection)) {
+      return MakeReadyFuture<Reply>(std::move(reply));
+    }
+    return AsyncClusterInvoke(context, call, index, MakeClusterContext(context, &redirection.node), redirection.ask,
+                              redirections + 1);
+  });
+}
+
+bool RedisServiceProxy::OnClusterRedirection(const Reply& reply, ClusterRedirection* redirection) {
+  if (!ParseRedirection(reply, redirection)) {
+    return false;
+  }
+  if (!redirection->ask) {
+    // The slot has moved for good, only this slot is updated and other slots are left to their own redirections
+    slot_map_->Update(redirection->slot, redirection->node);
+  }
+  return true;
+}
+
+void RedisServiceProxy::RefreshSlotMap(const ClientContextPtr& context) {
+  if (refreshing_slot_map_.exchange(true)) {
+    return;
+  }
+
+  Request req;
+  req.do_RESP_ = false;
+  req.params_.emplace_back(cmdgen{}.cluster_slots());
+  Reply reply;
+  ClientContextPtr cluster_context = MakeClusterContext(context, nullptr);
+  Status status = UnaryInvoke<Request, Reply>(cluster_context, std::move(req), &reply);
+  if (status.OK() && slot_map_->Update(reply)) {
+    slot_map_stale_.store(false, std::memory_order_relaxed);
+  } else {
+    TRPC_FMT_ERROR("service name:{}, refresh redis cluster slot map failed: {}", GetServiceName(),
+                   status.OK() ? "unexpected reply" : status.ErrorMessage());
+  }
+
+  refreshing_slot_map_.store(false);
+}
+
+Future<> RedisServiceProxy::AsyncRefreshSlotMap(const ClientContextPtr& context) {
+  if (refreshing_slot_map_.exchange(true)) {
+    return MakeReadyFuture<>();
+  }
+
+  Request req;
+  req.do_RESP_ = false;
+  req.params_.emplace_back(cmdgen{}.cluster_slots());
+  return AsyncUnaryInvoke<Request, Reply>(MakeClusterContext(context, nullptr), std::move(req))
+      .Then([this](Future<Reply>&& fut) {
+        if (!fut.IsFailed() && slot_map_->Update(fut.GetValue0())) {
+          slot_map_stale_.store(false, std::memory_order_relaxed);
+        } else {
+          TRPC_FMT_ERROR("service name:{}, refresh redis cluster slot map failed", GetServiceName());
+        }
+        refreshing_slot_map_.store(false);
+        // Calls still work without the slot map, by following redirections
+        return MakeReadyFuture<>();
+      });
+}
+
 TransInfo RedisServiceProxy::ProxyOptionToTransInfo() {
   // codec MUST be in[redis,istore]
   TRPC_ASSERT((codec_->Name() == "redis" || codec_->Name() == "istore") && "protocol name must be redis or istore");
   TransInfo trans_info = ServiceProxy::ProxyOptionToTransInfo();
+  RedisClientConf redis_conf = GetServiceProxyOption()->redis_conf;
+  if (redis_conf.cluster) {
+    TRPC_ASSERT(codec_->Name() == "redis" && "redis cluster mode requires protocol redis");
+    slot_map_ = std::make_unique<ClusterSlotMap>();
+    // Redis cluster only has db 0, connections are initialized by auth only
+    redis_conf.db = 0;
+    redis_conf.enable = !redis_conf.password.empty();
+  }
   // set option_->redis_conf so we can use it
-  trans_info.user_data = GetServiceProxyOption()->redis_conf;
+  trans_info.user_data = redis_conf;
   return trans_info;
 }
 
@@ -124,7 +498,7 @@ Status RedisServiceProxy::Command(const ClientContextPtr& context, std::string&&
   req.do_RESP_ = false;
   req.params_.emplace_back(std::move(cmd));
 
-  return OnewayInvoke<Request>(context, std::move(req));
+  return Oneway(context, std::move(req));
 }
 
 Status RedisServiceProxy::Command(const ClientContextPtr& context, const std::string& cmd) {
@@ -133,7 +507,7 @@ Status RedisServiceProxy::Command(const ClientContextPtr& context, const std::st
   req.do_RESP_ = false;
   req.params_.push_back(cmd);
 
-  return OnewayInvoke<Request>(context, std::move(req));
+  return Oneway(context, std::move(req));
 }
 
 }  // namespace redis
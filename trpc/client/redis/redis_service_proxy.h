@@ -13,10 +13,15 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
+#include "trpc/client/redis/cluster_command.h"
+#include "trpc/client/redis/cluster_slot_map.h"
 #include "trpc/client/redis/formatter.h"
 #include "trpc/client/redis/reply.h"
 #include "trpc/client/redis/request.h"
@@ -28,6 +33,8 @@ namespace trpc {
 namespace redis {
 
 /// @brief Redis client proxy instance, supporting Redis Command such as set, get, mset, mget
+/// @note With `redis_conf.cluster` enabled, commands are routed to the owning node of their keys by the slot map of
+/// the redis cluster, which is fetched from the nodes of the target by `CLUSTER SLOTS`.
 class RedisServiceProxy : public ServiceProxy {
  public:
   RedisServiceProxy() : formatter_(new redis::Formatter()) {}
@@ -95,6 +102,30 @@ class RedisServiceProxy : public ServiceProxy {
   /// @brief Same as above interface which param cmd is right value
   Status Command(const ClientContextPtr& context, std::string&& cmd);
 
+  /// @brief Redis pipeline synchronous call, all the requests are written to one connection at once and their
+  /// replies are parsed in one pass.
+  /// @param context Client context
+  /// @param reqs are the redis requests, must not be empty.
+  /// @param replies are the response messages, one for each request in the same order.
+  /// @return Status Result of the interface execution; if successful, `Status::OK()` is true, otherwise it indicates
+  /// that the call failed.
+  /// @note Only available with the connection pool mode of redis protocol, it can not be used together with
+  /// connection-level pipeline (`support_pipeline`).
+  Status Pipeline(const ClientContextPtr& context, std::vector<Request>&& reqs, std::vector<Reply>* replies);
+
+  /// @brief Same as above interface which param reqs is left value
+  Status Pipeline(const ClientContextPtr& context, const std::vector<Request>& reqs, std::vector<Reply>* replies);
+
+  /// @brief Redis pipeline asynchronous call.
+  /// @param context Client context
+  /// @param reqs are the redis requests, must not be empty.
+  /// @return Future<std::vector<Reply>> of the interface execution, one reply for each request in the same order.
+  /// @note Same restrictions as the synchronous `Pipeline`.
+  Future<std::vector<Reply>> AsyncPipeline(const ClientContextPtr& context, std::vector<Request>&& reqs);
+
+  /// @brief Same as above interface which param reqs is left value
+  Future<std::vector<Reply>> AsyncPipeline(const ClientContextPtr& context, const std::vector<Request>& reqs);
+
  protected:
   /// @private For internal use purpose only.
   TransInfo ProxyOptionToTransInfo() override;
@@ -120,7 +151,69 @@ class RedisServiceProxy : public ServiceProxy {
   Status OnewayInvoke(const ClientContextPtr& context, RequestMessage&& req);
 
  private:
+  template <class RequestMessage>
+  static constexpr serialization::DataType GetReqEncodeDataType() {
+    return std::is_same_v<std::decay_t<RequestMessage>, std::vector<Request>> ? serialization::kRedisPipelineType
+                                                                               : serialization::kRedisType;
+  }
+
+  Status CheckPipeline(const ClientContextPtr& context, const std::vector<Request>& reqs);
+
+  Status Invoke(const ClientContextPtr& context, Request&& req, Reply* rsp);
+
+  Future<Reply> AsyncInvoke(const ClientContextPtr& context, Request&& req);
+
+  Status Oneway(const ClientContextPtr& context, Request&& req);
+
+  // A command in flight in cluster mode, with the context of the latest call made for each of its sub commands.
+  struct ClusterCall {
+    ClusterCommand cmd;
+    std::vector<ClientContextPtr> contexts;
+  };
+
+  // Creates the context of a call to a cluster node on behalf of the caller's `context`, which is chosen by the
+  // selector if `node` is nullptr.
+  ClientContextPtr MakeClusterContext(const ClientContextPtr& context, const ClusterNode* node);
+
+  // Creates the context of a call to the owning node of `slot`.
+  ClientContextPtr MakeClusterContext(const ClientContextPtr& context, int32_t slot);
+
+  // Reports the status and the node of a call to a cluster node on the caller's `context`.
+  static void BackFillClusterContext(const ClientContextPtr& context, const ClientContextPtr& cluster_context);
+
+  Status ClusterInvoke(const ClientContextPtr& context, Request&& req, Reply* rsp);
+
+  // Sends `req` by `cluster_context`, with `ASKING` in front if `asking`, and takes `req` back once it is sent.
+  Status ClusterSend(const ClientContextPtr& cluster_context, Request& req, bool asking, Reply* rsp);
+
+  Future<Reply> AsyncClusterInvoke(const ClientContextPtr& context, Request&& req);
+
+  // Sends the sub commands of `call` concurrently and merges their replies once all of them complete.
+  Future<Reply> AsyncClusterInvoke(const ClientContextPtr& context, const std::shared_ptr<ClusterCall>& call);
+
+  Future<Reply> AsyncClusterInvoke(const ClientContextPtr& context, const std::shared_ptr<ClusterCall>& call,
+                                   size_t index, const ClientContextPtr& cluster_context, bool asking,
+                                   int redirections);
+
+  // Handles a redirection reply, returns false if `reply` is not a redirection.
+  bool OnClusterRedirection(const Reply& reply, ClusterRedirection* redirection);
+
+  void RefreshSlotMap(const ClientContextPtr& context);
+
+  Future<> AsyncRefreshSlotMap(const ClientContextPtr& context);
+
+  bool NeedRefreshSlotMap() const { return slot_map_stale_.load(std::memory_order_relaxed) || slot_map_->Empty(); }
+
   std::shared_ptr<redis::Formatter> formatter_;
+
+  // Slot map of the redis cluster, only created in cluster mode
+  std::unique_ptr<ClusterSlotMap> slot_map_;
+
+  // Whether the slot map is being refreshed, only one refresh is in flight at a time
+  std::atomic<bool> refreshing_slot_map_{false};
+
+  // Whether the slot map may be outdated, e.g. a node can not be reached
+  std::atomic<bool> slot_map_stale_{false};
 };
 
 template <class RequestMessage, class ResponseMessage>
@@ -132,7 +225,7 @@ Status RedisServiceProxy::UnaryInvoke(const ClientContextPtr& context, RequestMe
   FillClientContext(context);
 
   context->SetRequestData(&req);
-  context->SetReqEncodeDataType(serialization::kRedisType);
+  context->SetReqEncodeDataType(GetReqEncodeDataType<RequestMessage>());
 
   context->SetRspEncodeType(serialization::kNoopType);
   context->SetRspEncodeDataType(serialization::kNoopType);
@@ -204,7 +297,7 @@ Future<ResponseMessage> RedisServiceProxy::AsyncUnaryInvoke(const ClientContextP
   FillClientContext(context);
 
   context->SetRequestData(&req);
-  context->SetReqEncodeDataType(serialization::kRedisType);
+  context->SetReqEncodeDataType(GetReqEncodeDataType<RequestMessage>());
 
   context->SetRspEncodeType(serialization::kNoopType);
   context->SetRspEncodeDataType(serialization::kNoopType);
@@ -292,7 +385,7 @@ Status RedisServiceProxy::OnewayInvoke(const ClientContextPtr& context, RequestM
   FillClientContext(context);
 
   context->SetRequestData(&req);
-  context->SetReqEncodeDataType(serialization::kRedisType);
+  context->SetReqEncodeDataType(GetReqEncodeDataType<RequestMessage>());
 
   auto filter_ret = RunFilters(FilterPoint::CLIENT_PRE_RPC_INVOKE, context);
   if (filter_ret == 0) {
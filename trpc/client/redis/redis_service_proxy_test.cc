@@ -15,7 +15,9 @@
 
 #include <memory>
 #include <sstream>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -43,6 +45,8 @@ class MockRedisServiceProxy : public trpc::redis::RedisServiceProxy {
   MOCK_METHOD(trpc::redis::Reply, GetReply, ());
 
   void UnaryTransportInvoke(const ClientContextPtr& context, const ProtocolPtr& req, ProtocolPtr& rsp) override {
+    ports.push_back(context->GetPort());
+    callers.push_back(context->GetCallerName());
     auto redis_rsp = GetReply();
     ProtocolPtr redis_protocol = codec_->CreateResponsePtr();
     codec_->ZeroCopyDecode(context, redis_rsp, redis_protocol);
@@ -51,6 +55,8 @@ class MockRedisServiceProxy : public trpc::redis::RedisServiceProxy {
 
   Future<ProtocolPtr> AsyncUnaryTransportInvoke(const ClientContextPtr& context,
                                                 const ProtocolPtr& req_protocol) override {
+    ports.push_back(context->GetPort());
+    callers.push_back(context->GetCallerName());
     auto redis_rsp = GetReply();
     ProtocolPtr redis_protocol = codec_->CreateResponsePtr();
     if (!codec_->ZeroCopyDecode(context, redis_rsp, redis_protocol)) {
@@ -68,6 +74,10 @@ class MockRedisServiceProxy : public trpc::redis::RedisServiceProxy {
   }
 
   void SetMockCodec(ClientCodecPtr&& codec) { codec_ = codec; }
+
+  // Ports of the nodes requested, and the caller names carried by the requests
+  std::vector<int> ports;
+  std::vector<std::string> callers;
 };
 
 using MockRedisServiceProxyPtr = std::shared_ptr<MockRedisServiceProxy>;
@@ -280,6 +290,140 @@ TEST_F(RedisServiceProxyTest, CommandArgvAsyncMove) {
   future::BlockingGet(std::move(fut));
 }
 
+TEST_F(RedisServiceProxyTest, Pipeline) {
+  std::vector<trpc::redis::Reply> replies;
+  replies.emplace_back(trpc::redis::StatusReplyMarker{}, "OK");
+  replies.emplace_back(trpc::redis::StringReplyMarker{}, "redis");
+  trpc::redis::Reply reply = trpc::redis::Reply(trpc::redis::ArrayReplyMarker{}, std::move(replies));
+  EXPECT_CALL(*mock_redis_service_proxy_, GetReply()).Times(1).WillOnce(::testing::Return(reply));
+
+  auto client_context = GetClientContext();
+  std::vector<trpc::redis::Request> reqs(2);
+  reqs[0].params_ = {"SET", "trpc", "redis"};
+  reqs[1].params_ = {"GET", "trpc"};
+  std::vector<trpc::redis::Reply> reps;
+  Status st = mock_redis_service_proxy_->Pipeline(client_context, reqs, &reps);
+  ASSERT_TRUE(st.OK());
+  ASSERT_EQ(2, client_context->GetPipelineCount());
+  ASSERT_EQ(2, reps.size());
+  ASSERT_TRUE(reps[0].IsStatus());
+  ASSERT_TRUE(reps[1].IsString());
+  ASSERT_EQ("redis", reps[1].GetString());
+}
+
+TEST_F(RedisServiceProxyTest, PipelineAsync) {
+  std::vector<trpc::redis::Reply> replies;
+  replies.emplace_back(trpc::redis::StatusReplyMarker{}, "OK");
+  replies.emplace_back(trpc::redis::StringReplyMarker{}, "redis");
+  trpc::redis::Reply reply = trpc::redis::Reply(trpc::redis::ArrayReplyMarker{}, std::move(replies));
+  EXPECT_CALL(*mock_redis_service_proxy_, GetReply()).Times(1).WillOnce(::testing::Return(reply));
+
+  auto client_context = GetClientContext();
+  std::vector<trpc::redis::Request> reqs(2);
+  reqs[0].params_ = {"SET", "trpc", "redis"};
+  reqs[1].params_ = {"GET", "trpc"};
+  auto fut = mock_redis_service_proxy_->AsyncPipeline(client_context, std::move(reqs))
+                 .Then([](std::vector<trpc::redis::Reply>&& reps) {
+                   EXPECT_EQ(2, reps.size());
+                   EXPECT_TRUE(reps[0].IsStatus());
+                   EXPECT_EQ("redis", reps[1].GetString());
+                   return MakeReadyFuture<>();
+                 });
+
+  future::BlockingGet(std::move(fut));
+}
+
+TEST_F(RedisServiceProxyTest, PipelineFailed) {
+  auto client_context = GetClientContext();
+  std::vector<trpc::redis::Reply> reps;
+  ASSERT_FALSE(mock_redis_service_proxy_->Pipeline(client_context, std::vector<trpc::redis::Request>{}, &reps).OK());
+
+  // Replies of two requests are expected, but only one arrives.
+  trpc::redis::Reply reply = trpc::redis::Reply(trpc::redis::StringReplyMarker{}, "redis");
+  EXPECT_CALL(*mock_redis_service_proxy_, GetReply()).Times(1).WillOnce(::testing::Return(reply));
+  std::vector<trpc::redis::Request> reqs(2);
+  reqs[0].params_ = {"GET", "trpc"};
+  reqs[1].params_ = {"GET", "redis"};
+  ASSERT_FALSE(mock_redis_service_proxy_->Pipeline(client_context, std::move(reqs), &reps).OK());
+
+  auto fut = mock_redis_service_proxy_->AsyncPipeline(client_context, std::vector<trpc::redis::Request>{})
+                 .Then([](Future<std::vector<trpc::redis::Reply>>&& r) {
+                   EXPECT_TRUE(r.IsFailed());
+                   return MakeReadyFuture<>();
+                 });
+  future::BlockingGet(std::move(fut));
+}
+
+TEST_F(RedisServiceProxyTest, Cluster) {
+  auto option = std::make_shared<ServiceProxyOption>(*option_);
+  option->name = "cluster_redis_service";
+  option->redis_conf.cluster = true;
+  auto proxy = std::make_shared<MockRedisServiceProxy>();
+  proxy->SetMockServiceProxyOption(option);
+
+  auto make_range = [](int64_t start, int64_t end, int64_t port) {
+    std::vector<trpc::redis::Reply> node;
+    node.emplace_back(trpc::redis::StringReplyMarker{}, "127.0.0.1");
+    node.emplace_back(trpc::redis::IntegerReplyMarker{}, port);
+    std::vector<trpc::redis::Reply> range;
+    range.emplace_back(trpc::redis::IntegerReplyMarker{}, start);
+    range.emplace_back(trpc::redis::IntegerReplyMarker{}, end);
+    range.emplace_back(trpc::redis::ArrayReplyMarker{}, std::move(node));
+    return trpc::redis::Reply(trpc::redis::ArrayReplyMarker{}, std::move(range));
+  };
+  std::vector<trpc::redis::Reply> ranges;
+  ranges.emplace_back(make_range(0, 8191, 7000));
+  ranges.emplace_back(make_range(8192, 16383, 7001));
+  trpc::redis::Reply slots(trpc::redis::ArrayReplyMarker{}, std::move(ranges));
+
+  // "foo" is in slot 12182, "bar" is in slot 5061
+  std::vector<trpc::redis::Reply> mget_foo;
+  mget_foo.emplace_back(trpc::redis::StringReplyMarker{}, "1");
+  std::vector<trpc::redis::Reply> mget_bar;
+  mget_bar.emplace_back(trpc::redis::StringReplyMarker{}, "2");
+  std::vector<trpc::redis::Reply> asking_mget_bar;
+  asking_mget_bar.emplace_back(trpc::redis::StatusReplyMarker{}, "OK");
+  asking_mget_bar.emplace_back(trpc::redis::ArrayReplyMarker{}, std::move(mget_bar));
+  EXPECT_CALL(*proxy, GetReply())
+      .Times(6)
+      .WillOnce(::testing::Return(slots))
+      .WillOnce(::testing::Return(trpc::redis::Reply(trpc::redis::ErrorReplyMarker{}, "MOVED 12182 127.0.0.1:7002")))
+      .WillOnce(::testing::Return(trpc::redis::Reply(trpc::redis::StringReplyMarker{}, "1")))
+      .WillOnce(::testing::Return(trpc::redis::Reply(trpc::redis::ArrayReplyMarker{}, std::move(mget_foo))))
+      .WillOnce(::testing::Return(trpc::redis::Reply(trpc::redis::ErrorReplyMarker{}, "ASK 5061 127.0.0.1:7003")))
+      .WillOnce(::testing::Return(trpc::redis::Reply(trpc::redis::ArrayReplyMarker{}, std::move(asking_mget_bar))));
+
+  // The slot map is fetched first, then "GET foo" follows the MOVED redirection
+  trpc::redis::Reply rep;
+  auto context = MakeClientContext(proxy);
+  context->SetCallerName("trpc.test.redis.caller");
+  ASSERT_TRUE(proxy->Command(context, &rep, trpc::redis::cmdgen{}.get("foo")).OK());
+  ASSERT_EQ("1", rep.GetString());
+  // The caller's context reports the node which answered
+  ASSERT_EQ(7002, context->GetPort());
+  ASSERT_FALSE(context->IsSetAddr());
+
+  // MGET is split per slot and sent concurrently, the slot of "bar" is being migrated and asked to another node
+  context = MakeClientContext(proxy);
+  context->SetCallerName("trpc.test.redis.caller");
+  ASSERT_TRUE(proxy->Command(context, &rep, trpc::redis::cmdgen{}.mget({"foo", "bar"})).OK());
+  ASSERT_TRUE(rep.IsArray());
+  ASSERT_EQ(2, rep.GetArray().size());
+  ASSERT_EQ("1", rep.GetArray()[0].GetString());
+  ASSERT_EQ("2", rep.GetArray()[1].GetString());
+  ASSERT_TRUE(context->GetStatus().OK());
+  ASSERT_EQ(7003, context->GetPort());
+
+  ASSERT_EQ((std::vector<int>{7001, 7002, 7002, 7000, 7003}),
+            std::vector<int>(proxy->ports.begin() + 1, proxy->ports.end()));
+  // Every call to a node is made on behalf of the caller
+  ASSERT_EQ(std::vector<std::string>(proxy->callers.size() - 1, "trpc.test.redis.caller"),
+            std::vector<std::string>(proxy->callers.begin() + 1, proxy->callers.end()));
+
+  proxy->Stop();
+  proxy->Destroy();
+}
+
 TEST_F(RedisServiceProxyTest, FillRequestFail) {
   std::string cmd = trpc::redis::cmdgen{}.get("trpc");
   mock_redis_service_proxy_->SetMockCodec(std::make_shared<MockRedisCodec>());
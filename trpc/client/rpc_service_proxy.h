@@ -14,8 +14,10 @@
 #pragma once
 
 #include <string>
+#include <type_traits>
 #include <utility>
 
+#include "google/protobuf/arena.h"
 #include "rapidjson/document.h"
 
 #include "trpc/client/client_context.h"
@@ -47,6 +49,19 @@ class RpcServiceProxy : public ServiceProxy {
   template <class RequestMessage, class ResponseMessage>
   Future<ResponseMessage> AsyncUnaryInvoke(const ClientContextPtr& context, const RequestMessage& req);
 
+  /// @brief Unary synchronous call whose pb response message is created on the pb arena of `context`, so that decoding
+  ///        it allocates from the arena instead of the heap. It is also the one to use in fiber runtime.
+  /// @param[out] rsp The response message, owned by the pb arena of `context` and valid as long as the arena is.
+  /// @note The function name of `context` must have been set, as the generated proxies do for the other calls.
+  template <class RequestMessage, class ResponseMessage>
+  Status UnaryInvokeOnArena(const ClientContextPtr& context, const RequestMessage& req, ResponseMessage** rsp);
+
+  /// @brief Unary asynchronous call whose pb response message is created on the pb arena of `context`.
+  /// @return The response message, owned by the pb arena of `context` and valid as long as the arena is.
+  /// @note The function name of `context` must have been set, as the generated proxies do for the other calls.
+  template <class RequestMessage, class ResponseMessage>
+  Future<ResponseMessage*> AsyncUnaryInvokeOnArena(const ClientContextPtr& context, const RequestMessage& req);
+
   /// @brief One way call, used by the upper-level user for input with the user protocol body.
   template <class RequestProtocol>
   Status OnewayInvoke(const ClientContextPtr& context, const RequestProtocol& req);
@@ -93,8 +108,12 @@ class RpcServiceProxy : public ServiceProxy {
   template <class RequestMessage, class ResponseMessage>
   void UnaryInvokeImp(const ClientContextPtr& context, const RequestMessage& req, ResponseMessage* rsp);
 
-  template <class RequestMessage, class ResponseMessage>
-  Future<ResponseMessage> AsyncUnaryInvokeImp(const ClientContextPtr& context, const RequestMessage& req);
+  // `ResponseHolder` is either `ResponseMessage` itself, or a pointer to it which is created on the pb arena of context.
+  template <class RequestMessage, class ResponseMessage, class ResponseHolder = ResponseMessage>
+  Future<ResponseHolder> AsyncUnaryInvokeImp(const ClientContextPtr& context, const RequestMessage& req);
+
+  template <class RequestMessage, class ResponseMessage, class ResponseHolder = ResponseMessage>
+  Future<ResponseHolder> DoAsyncUnaryInvoke(const ClientContextPtr& context, const RequestMessage& req);
 
   // Select the default EncodeType and EncodeDataType base on the message type.
   // Note: The default matching can only be done for general types, and if it is a unknown user-defined type, the
@@ -254,10 +273,34 @@ void RpcServiceProxy::UnaryInvokeImp(const ClientContextPtr& context, const Requ
 
 template <class RequestMessage, class ResponseMessage>
 Future<ResponseMessage> RpcServiceProxy::AsyncUnaryInvoke(const ClientContextPtr& context, const RequestMessage& req) {
+  return DoAsyncUnaryInvoke<RequestMessage, ResponseMessage>(context, req);
+}
+
+template <class RequestMessage, class ResponseMessage>
+Status RpcServiceProxy::UnaryInvokeOnArena(const ClientContextPtr& context, const RequestMessage& req,
+                                           ResponseMessage** rsp) {
+  static_assert(std::is_base_of_v<google::protobuf::MessageLite, ResponseMessage>,
+                "Only pb response message can be created on pb arena");
+
+  *rsp = google::protobuf::Arena::CreateMessage<ResponseMessage>(context->GetPbArena());
+  return UnaryInvoke<RequestMessage, ResponseMessage>(context, req, *rsp);
+}
+
+template <class RequestMessage, class ResponseMessage>
+Future<ResponseMessage*> RpcServiceProxy::AsyncUnaryInvokeOnArena(const ClientContextPtr& context,
+                                                                  const RequestMessage& req) {
+  static_assert(std::is_base_of_v<google::protobuf::MessageLite, ResponseMessage>,
+                "Only pb response message can be created on pb arena");
+
+  return DoAsyncUnaryInvoke<RequestMessage, ResponseMessage, ResponseMessage*>(context, req);
+}
+
+template <class RequestMessage, class ResponseMessage, class ResponseHolder>
+Future<ResponseHolder> RpcServiceProxy::DoAsyncUnaryInvoke(const ClientContextPtr& context, const RequestMessage& req) {
   TRPC_ASSERT(context->GetRequest() != nullptr);
 
   if (TRPC_UNLIKELY(!(SetMessageEncodeType<RequestMessage, ResponseMessage>)(context))) {
-    return MakeExceptionFuture<ResponseMessage>(CommonException(
+    return MakeExceptionFuture<ResponseHolder>(CommonException(
         context->GetStatus().ErrorMessage().c_str(), static_cast<int>(context->GetStatus().GetFrameworkRetCode())));
   }
 
@@ -270,7 +313,7 @@ Future<ResponseMessage> RpcServiceProxy::AsyncUnaryInvoke(const ClientContextPtr
     context->SetRequestData(nullptr);
     // Logic for execute post-RPC invoke filters is processed in AsyncUnaryTransportInvoke.
     // To reduce the number of layers of Future Then calls for performance optimization .
-    return AsyncUnaryInvokeImp<RequestMessage, ResponseMessage>(context, req);
+    return AsyncUnaryInvokeImp<RequestMessage, ResponseMessage, ResponseHolder>(context, req);
   }
 
   RunFilters(FilterPoint::CLIENT_POST_RPC_INVOKE, context);
@@ -280,12 +323,12 @@ Future<ResponseMessage> RpcServiceProxy::AsyncUnaryInvoke(const ClientContextPtr
 
   const Status& result = context->GetStatus();
 
-  return MakeExceptionFuture<ResponseMessage>(CommonException(result.ErrorMessage().c_str()));
+  return MakeExceptionFuture<ResponseHolder>(CommonException(result.ErrorMessage().c_str()));
 }
 
-template <class RequestMessage, class ResponseMessage>
-Future<ResponseMessage> RpcServiceProxy::AsyncUnaryInvokeImp(const ClientContextPtr& context,
-                                                             const RequestMessage& req) {
+template <class RequestMessage, class ResponseMessage, class ResponseHolder>
+Future<ResponseHolder> RpcServiceProxy::AsyncUnaryInvokeImp(const ClientContextPtr& context,
+                                                            const RequestMessage& req) {
   ProtocolPtr& req_protocol = context->GetRequest();
   if (!codec_->FillRequest(context, req_protocol, reinterpret_cast<void*>(const_cast<RequestMessage*>(&req)))) {
     std::string error("service name:");
@@ -304,7 +347,7 @@ Future<ResponseMessage> RpcServiceProxy::AsyncUnaryInvokeImp(const ClientContext
 
     context->SetEndTimestampUs(trpc::time::GetMicroSeconds());
 
-    return MakeExceptionFuture<ResponseMessage>(
+    return MakeExceptionFuture<ResponseHolder>(
         CommonException(context->GetStatus().ErrorMessage().c_str(), TrpcRetCode::TRPC_CLIENT_ENCODE_ERR));
   }
 
@@ -313,13 +356,20 @@ Future<ResponseMessage> RpcServiceProxy::AsyncUnaryInvokeImp(const ClientContext
         if (rsp_protocol.IsFailed()) {
           RunFilters(FilterPoint::CLIENT_POST_RPC_INVOKE, context);
 
-          return MakeExceptionFuture<ResponseMessage>(rsp_protocol.GetException());
+          return MakeExceptionFuture<ResponseHolder>(rsp_protocol.GetException());
         }
 
         context->SetResponse(rsp_protocol.GetValue0());
 
-        ResponseMessage rsp_obj;
-        void* raw_rsp = static_cast<void*>(&rsp_obj);
+        ResponseHolder rsp_obj;
+        ResponseMessage* rsp = nullptr;
+        if constexpr (std::is_pointer_v<ResponseHolder>) {
+          rsp_obj = google::protobuf::Arena::CreateMessage<ResponseMessage>(context->GetPbArena());
+          rsp = rsp_obj;
+        } else {
+          rsp = &rsp_obj;
+        }
+        void* raw_rsp = static_cast<void*>(rsp);
 
         if (!codec_->FillResponse(context, context->GetResponse(), raw_rsp)) {
           std::string error("service name:");
@@ -338,19 +388,19 @@ Future<ResponseMessage> RpcServiceProxy::AsyncUnaryInvokeImp(const ClientContext
 
           context->SetEndTimestampUs(trpc::time::GetMicroSeconds());
 
-          return MakeExceptionFuture<ResponseMessage>(UnaryRpcError(context->GetStatus()));
+          return MakeExceptionFuture<ResponseHolder>(UnaryRpcError(context->GetStatus()));
         }
 
         // Set the response data (for use by the CLIENT_POST_RPC_INVOKE filter for instrumentation) when the call is
         // successful.
-        context->SetResponseData(&rsp_obj);
+        context->SetResponseData(rsp);
 
         RunFilters(FilterPoint::CLIENT_POST_RPC_INVOKE, context);
 
         context->SetResponseData(nullptr);
         context->SetEndTimestampUs(trpc::time::GetMicroSeconds());
 
-        return MakeReadyFuture<ResponseMessage>(std::move(rsp_obj));
+        return MakeReadyFuture<ResponseHolder>(std::move(rsp_obj));
       });
 }
 
@@ -382,6 +382,68 @@ TEST_F(RpcServiceProxyTestFixture, AsyncUnaryInvokeFillResponseError) {
   future::BlockingGet(std::move(fut));
 }
 
+// response message is created on the pb arena of context
+TEST_F(RpcServiceProxyTestFixture, UnaryInvokeOnArena) {
+  EXPECT_CALL(*codec_, FillRequest(::testing::_, ::testing::_, ::testing::_))
+      .Times(1)
+      .WillOnce(::testing::Return(true));
+  EXPECT_CALL(*codec_, FillResponse(::testing::_, ::testing::_, ::testing::_))
+      .Times(1)
+      .WillOnce([](const ClientContextPtr&, const ProtocolPtr&, void* body) {
+        static_cast<test::helloworld::HelloReply*>(body)->set_msg("arena");
+        return true;
+      });
+
+  ProtocolPtr rsp_data = codec_->CreateResponsePtr();
+  EXPECT_CALL(*mock_rpc_service_proxy_, UnaryTransportInvoke(::testing::_, ::testing::_, ::testing::_))
+      .Times(1)
+      .WillOnce(::testing::SetArgReferee<2>(rsp_data));
+
+  auto client_context = GetClientContext();
+  test::helloworld::HelloRequest hello_req;
+  test::helloworld::HelloReply* hello_rsp = nullptr;
+  Status status =
+      mock_rpc_service_proxy_->UnaryInvokeOnArena<test::helloworld::HelloRequest, test::helloworld::HelloReply>(
+          client_context, hello_req, &hello_rsp);
+
+  EXPECT_TRUE(status.OK());
+  ASSERT_NE(hello_rsp, nullptr);
+  EXPECT_EQ(hello_rsp->GetArena(), client_context->GetPbArena());
+  EXPECT_EQ(hello_rsp->msg(), "arena");
+}
+
+TEST_F(RpcServiceProxyTestFixture, AsyncUnaryInvokeOnArena) {
+  EXPECT_CALL(*codec_, FillRequest(::testing::_, ::testing::_, ::testing::_))
+      .Times(1)
+      .WillOnce(::testing::Return(true));
+  EXPECT_CALL(*codec_, FillResponse(::testing::_, ::testing::_, ::testing::_))
+      .Times(1)
+      .WillOnce([](const ClientContextPtr&, const ProtocolPtr&, void* body) {
+        static_cast<test::helloworld::HelloReply*>(body)->set_msg("arena");
+        return true;
+      });
+  EXPECT_CALL(*mock_rpc_service_proxy_, AsyncUnaryTransportInvoke(::testing::_, ::testing::_))
+      .Times(1)
+      .WillOnce(::testing::Return(::testing::ByMove(MakeReadyFuture<ProtocolPtr>(codec_->CreateResponsePtr()))));
+
+  // The arena set by user, e.g. one reused by the calls of a fiber, is used instead of creating one.
+  google::protobuf::Arena arena;
+  auto client_context = GetClientContext();
+  client_context->SetPbArena(&arena);
+
+  test::helloworld::HelloRequest hello_req;
+  auto fut = mock_rpc_service_proxy_
+                 ->AsyncUnaryInvokeOnArena<test::helloworld::HelloRequest, test::helloworld::HelloReply>(
+                     client_context, hello_req)
+                 .Then([&arena](test::helloworld::HelloReply* hello_rsp) {
+                   EXPECT_EQ(hello_rsp->GetArena(), &arena);
+                   EXPECT_EQ(hello_rsp->msg(), "arena");
+                   return MakeReadyFuture<>();
+                 });
+  future::BlockingGet(std::move(fut));
+  EXPECT_GT(arena.SpaceUsed(), 0);
+}
+
 TEST_F(RpcServiceProxyTestFixture, AsyncStreamInvoke1) {
   auto client_context = GetClientContext();
   auto stream = dynamic_pointer_cast<testing::MockStreamReaderWriterProvider>(
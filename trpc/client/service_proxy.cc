@@ -362,8 +362,9 @@ void ServiceProxy::SetServiceProxyOptionInner(const std::shared_ptr<ServiceProxy
 }
 
 void ServiceProxy::PrepareStatistics(const std::string& service_name) {
-  if (!backup_retries_ || !backup_retries_succ_) {
+  if (!backup_calls_ || !backup_retries_ || !backup_retries_succ_) {
     auto data = FrameStats::GetInstance()->GetBackupRequestStats().GetData(service_name);
+    backup_calls_ = std::move(data.calls);
     backup_retries_ = std::move(data.retries);
     backup_retries_succ_ = std::move(data.retries_success);
   }
@@ -470,6 +471,7 @@ TransInfo ServiceProxy::ProxyOptionToTransInfo() {
   trans_info.is_complex_conn = option_->is_conn_complex;
   trans_info.support_pipeline = option_->support_pipeline;
   trans_info.fiber_pipeline_connector_queue_size = option_->fiber_pipeline_connector_queue_size;
+  trans_info.fiber_max_inflight_calls_per_conn = option_->fiber_max_inflight_calls_per_conn;
   trans_info.protocol = option_->codec_name;
   trans_info.fiber_connpool_shards = option_->fiber_connpool_shards;
   trans_info.endpoint_hash_bucket_size = option_->endpoint_hash_bucket_size;
@@ -556,6 +558,7 @@ TransInfo ServiceProxy::ProxyOptionToTransInfo() {
     // Init SSL options
     ssl::ClientSslOptions ssl_options;
     TRPC_ASSERT(ssl::InitClientSslOptions(option_->ssl_config, &ssl_options));
+    ssl::SetDefaultAlpnProtocols(option_->codec_name, false, &ssl_options.alpn_protocols);
 
     // Init SSL context
     ssl::SslContextPtr ssl_ctx = MakeRefCounted<ssl::SslContext>();
@@ -576,6 +579,7 @@ void ServiceProxy::Stop() {
     transport_->Stop();
   }
 
+  backup_calls_.reset();
   backup_retries_.reset();
   backup_retries_succ_.reset();
 }
@@ -596,7 +600,9 @@ void ServiceProxy::AddServiceFilter(const MessageClientFilterPtr& filter) {
   }
   auto new_filter = filter->Create(param);
   if (new_filter != nullptr) {
-    new_filter->Init();
+    if (new_filter->Init() != 0) {
+      TRPC_FMT_ERROR("Init of {} client filter of service {} failed!", new_filter->Name(), option_->name);
+    }
     filter_controller_.AddMessageClientFilter(new_filter);
   } else {
     filter_controller_.AddMessageClientFilter(filter);
@@ -669,6 +675,9 @@ int ServiceProxy::RunFilters(const FilterPoint& point, const ClientContextPtr& c
 void ServiceProxy::ProxyStatistics(const ClientContextPtr& ctx) {
   auto* retry_info = ctx->GetBackupRequestRetryInfo();
   if (retry_info) {
+    if (backup_calls_) {
+      backup_calls_->Add(1);
+    }
     if (retry_info->resend_count > 0 && backup_retries_) {
       backup_retries_->Add(retry_info->resend_count);
     }
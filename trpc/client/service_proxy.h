@@ -199,6 +199,9 @@ class ServiceProxy {
 
   ThreadModel* thread_model_{nullptr};
 
+  // Count of calls with backup request enabled at the service level.
+  std::shared_ptr<tvar::Counter<uint64_t>> backup_calls_{nullptr};
+
   // Total count of backup requests retries at the service level.
   std::shared_ptr<tvar::Counter<uint64_t>> backup_retries_{nullptr};
 
@@ -47,6 +47,9 @@ void SetOutputByValidInput(const RedisClientConf& input, RedisClientConf& output
 
   auto db = GetValidInput<std::uint32_t>(input.db, 0);
   SetOutputByValidInput<std::uint32_t>(db, output.db);
+
+  auto cluster = GetValidInput<bool>(input.cluster, false);
+  SetOutputByValidInput<bool>(cluster, output.cluster);
 }
 
 void SetOutputByValidInput(const ClientSslConfig& input, ClientSslConfig& output) {
@@ -214,6 +217,10 @@ void SetSpecifiedOption(const ServiceProxyOption* option_ptr, const std::shared_
       GetValidInput<uint32_t>(option_ptr->fiber_pipeline_connector_queue_size, 16 * 1024);
   SetOutputByValidInput<uint32_t>(fiber_pipeline_connector_queue_size, option->fiber_pipeline_connector_queue_size);
 
+  auto fiber_max_inflight_calls_per_conn =
+      GetValidInput<uint32_t>(option_ptr->fiber_max_inflight_calls_per_conn, 1024);
+  SetOutputByValidInput<uint32_t>(fiber_max_inflight_calls_per_conn, option->fiber_max_inflight_calls_per_conn);
+
   auto fiber_connpool_shards = GetValidInput<uint32_t>(option_ptr->fiber_connpool_shards, 4);
   SetOutputByValidInput<uint32_t>(fiber_connpool_shards, option->fiber_connpool_shards);
 }
@@ -31,6 +31,10 @@
 #include "trpc/codec/grpc/grpc_client_codec.h"
 #include "trpc/codec/grpc/grpc_server_codec.h"
 
+// codec http2
+#include "trpc/codec/http2/http2_client_codec.h"
+#include "trpc/codec/http2/http2_server_codec.h"
+
 namespace trpc::codec {
 
 bool Init() {
@@ -64,6 +68,12 @@ bool Init() {
   ret = InitCodecPlugins<GrpcServerCodec>();
   TRPC_ASSERT(ret);
 
+  // http2
+  ret = InitCodecPlugins<Http2ServerCodec>();
+  TRPC_ASSERT(ret);
+  ret = InitCodecPlugins<Http2ClientCodec>();
+  TRPC_ASSERT(ret);
+
   // redis
   ret = InitCodecPlugins<RedisClientCodec>();
   TRPC_ASSERT(ret);
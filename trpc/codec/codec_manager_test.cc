@@ -30,6 +30,9 @@ TEST(CodecManagerTest, Init) {
 
   EXPECT_TRUE(ClientCodecFactory::GetInstance()->Get("grpc"));
   EXPECT_TRUE(ServerCodecFactory::GetInstance()->Get("grpc"));
+
+  EXPECT_TRUE(ClientCodecFactory::GetInstance()->Get("http2"));
+  EXPECT_TRUE(ServerCodecFactory::GetInstance()->Get("http2"));
 }
 
 TEST(CodecManagerTest, Destroy) {
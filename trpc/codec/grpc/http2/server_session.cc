@@ -107,6 +107,26 @@ bool ServerSession::HandleClientMagic(NoncontiguousBuffer* in) {
   return true;
 }
 
+bool ServerSession::Upgrade(RequestPtr& request, std::string_view settings_payload) {
+  int upgrade_ok = nghttp2_session_upgrade2(session_, reinterpret_cast<const uint8_t*>(settings_payload.data()),
+                                            settings_payload.size(), request->IsHead(), nullptr);
+  if (upgrade_ok != 0) {
+    TRPC_LOG_ERROR("nghttp2_session_upgrade2 failed, error: " << nghttp2_strerror(upgrade_ok));
+    return false;
+  }
+
+  // Stream 1 is half-closed (remote) now, the whole request has been received over HTTP/1.1.
+  request->SetStreamId(1);
+  request->SetHeaderRecv(true);
+  auto stream = CreateStream();
+  stream->SetStreamId(1);
+  stream->SetSession(this);
+  stream->SetRequest(request);
+  AddStream(std::move(stream));
+  OnEof(request);
+  return true;
+}
+
 int ServerSession::SubmitResponse(const ResponsePtr& response) {
   auto stream_id = response->GetStreamId();
   auto stream = FindStream(stream_id);
@@ -15,6 +15,7 @@
 
 #include <deque>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "trpc/codec/grpc/http2/http2.h"
@@ -38,6 +39,13 @@ class ServerSession : public Session {
   // @brief Submits a HTTP2 response.
   int SubmitResponse(const ResponsePtr& response) override;
 
+  // @brief Upgrades the session from HTTP/1.1 to h2c (RFC 7540, 3.2), the request which asked for upgrading becomes
+  // the request of stream 1, and it's handled as a complete request.
+  // @param request is the request of stream 1.
+  // @param settings_payload is the SETTINGS frame payload decoded from "HTTP2-Settings" header.
+  // @return true: success; false: error.
+  bool Upgrade(RequestPtr& request, std::string_view settings_payload);
+
   // @brief Handles HTTP2 header.
   void OnHeader(RequestPtr& request);
 
@@ -14,6 +14,8 @@
 #include "trpc/codec/grpc/http2/session.h"
 
 #include <memory>
+#include <string>
+#include <string_view>
 #include <utility>
 
 #include "gtest/gtest.h"
@@ -337,4 +339,41 @@ TEST_F(Http2SessionImplTest, SubmitResponseOk) { TestSubmitResponseOrInStreamWay
 
 TEST_F(Http2SessionImplTest, SubmitResponseInStreamWayOk) { TestSubmitResponseOrInStreamWayOk(true); }
 
+TEST_F(Http2SessionImplTest, UpgradeOk) {
+  auto request = http2::CreateRequest();
+  request->SetMethod("GET");
+  request->SetPath("/index.html");
+  request->SetScheme("http");
+  request->SetAuthority("xx.example.com");
+  // SETTINGS_MAX_CONCURRENT_STREAMS = 100.
+  std::string settings_payload{"\x00\x03\x00\x00\x00\x64", 6};
+  ASSERT_TRUE(server_session_->Upgrade(request, settings_payload));
+
+  // The request of stream 1 is handled as a complete request.
+  ASSERT_EQ(request_recv_queue_.size(), 1);
+  ASSERT_EQ(request_recv_queue_.front()->GetStreamId(), 1);
+  ASSERT_NE(server_session_->FindStream(1), nullptr);
+
+  // Stream 1 is used already.
+  ASSERT_FALSE(server_session_->Upgrade(request, settings_payload));
+
+  // Client preface follows the upgrading.
+  ASSERT_TRUE(Http2Handshake());
+
+  auto response = CreateHttp2Response();
+  response->SetStreamId(1);
+  ASSERT_EQ(server_session_->SubmitResponse(response), 0);
+  NoncontiguousBuffer send_buffer;
+  ASSERT_EQ(server_session_->SignalWrite(&send_buffer), 0);
+  ASSERT_FALSE(send_buffer.Empty());
+}
+
+TEST_F(Http2SessionImplTest, UpgradeWithInvalidSettings) {
+  auto request = http2::CreateRequest();
+  request->SetMethod("GET");
+  request->SetPath("/index.html");
+  ASSERT_FALSE(server_session_->Upgrade(request, std::string_view{"\x00\x03\x00", 3}));
+  ASSERT_TRUE(request_recv_queue_.empty());
+}
+
 }  // namespace trpc::testing
@@ -21,6 +21,7 @@
 
 #include "picohttpparser.h"
 
+#include "trpc/util/http/http_parser.h"
 #include "trpc/util/http/response.h"
 #include "trpc/util/http/stream/http_client_stream_response.h"
 
@@ -50,7 +51,7 @@ std::optional<size_t> ParseContentLength(const char* value, size_t len) {
 }
 
 // Parses the http response headers.
-// If parsing is successful, it returns the length of the successfully parsed bytes.
+// If parsing is successful, it returns the length of the successfully parsed bytes, which are cut from |in|.
 // If the response is incomplete, it returns -2 (kParserNeedMore).
 // If parsing fails, it returns -1 (kParserError).
 int ParseHeader(const ConnectionPtr& conn, InflightHttpResponsePtr& inflight_response, NoncontiguousBuffer& in) {
@@ -58,61 +59,37 @@ int ParseHeader(const ConnectionPtr& conn, InflightHttpResponsePtr& inflight_res
     return kParserNeedMore;
   }
 
-  int minor_version = 0;
-  int status = 200;
-  const char* msg = nullptr;
-  size_t msg_len;
-  struct phr_header headers[http::kMaxHeaderNum];
-  size_t num_headers = http::kMaxHeaderNum;
-
   size_t max_packet_size =
       conn->GetMaxPacketSize() > 0 ? conn->GetMaxPacketSize() : (std::numeric_limits<size_t>::max() - 1);
-  auto buf = FlattenSlowUntil(in, http::kEndOfHeaderMarker, max_packet_size + 1);
-  if (buf.size() > max_packet_size) {
-    return kParserError;
-  }
-
-  int nparse =
-      phr_parse_response(buf.c_str(), buf.size(), &minor_version, &status, &msg, &msg_len, headers, &num_headers, 0);
 
-  // phr_parse_request return -1 when failed, -2 when a request is incomplete
+  // The headers refer to the received bytes rather than being copied.
+  http::HttpResponse rsp;
+  int nparse = http::ParseHead(in, max_packet_size, &rsp);
+  // ParseHead return -1 when failed, -2 when a response is incomplete
   if (nparse < 0) {
     return nparse;
   }
 
-  http::HttpResponse rsp;
-
   // HTTP headers.
   std::optional<size_t> content_length;
-  bool conn_reusable = minor_version > 0;
-  bool is_chunked = false;
-  for (size_t i = 0; i < num_headers; i++) {
-    const auto& header = headers[i];
-    if (!is_chunked && header.name_len == http::kHeaderTransferEncodingLen &&
-        strncasecmp(header.name, http::kHeaderTransferEncoding, http::kHeaderTransferEncodingLen) == 0) {
-      is_chunked = true;
-    } else if (!content_length && header.name_len == http::kHeaderContentLengthLen &&
-               strncasecmp(header.name, http::kHeaderContentLength, http::kHeaderContentLengthLen) == 0) {
-      content_length = ParseContentLength(header.value, header.value_len);
-      if (!content_length) {  // invalid Content-Length value
-        return kParserError;
-      }
-    } else if (header.name_len == http::kHeaderConnectionLen &&
-               strncasecmp(header.name, http::kHeaderConnection, http::kHeaderConnectionLen) == 0) {
-      conn_reusable = header.value_len != http::kConnectionCloseLen ||
-                      strncasecmp(header.value, http::kConnectionClose, http::kConnectionCloseLen) != 0;
+  bool conn_reusable = rsp.GetVersionMinor() > 0;
+  bool is_chunked = rsp.HasHeader(http::kHeaderTransferEncoding);
+  if (rsp.HasHeader(http::kHeaderContentLength)) {
+    std::string_view value = rsp.GetHeaderView(http::kHeaderContentLength);
+    content_length = ParseContentLength(value.data(), value.size());
+    if (!content_length) {  // invalid Content-Length value
+      return kParserError;
     }
-
-    rsp.AddHeader(std::string{header.name, header.name_len}, std::string{header.value, header.value_len});
+  }
+  if (rsp.HasHeader(http::kHeaderConnection)) {
+    std::string_view value = rsp.GetHeaderView(http::kHeaderConnection);
+    conn_reusable = value.size() != http::kConnectionCloseLen ||
+                    strncasecmp(value.data(), http::kConnectionClose, http::kConnectionCloseLen) != 0;
   }
   if (content_length && is_chunked) {  // chunked encoding must not have Content-Length
     return kParserError;
   }
 
-  // Status line.
-  rsp.SetVersion(minor_version == 0 ? http::kVersion10 : http::kVersion11);
-  rsp.SetStatus(http::HttpResponse::StatusCode(status));
-  rsp.SetReasonPhrase(std::string{msg, msg_len});
   rsp.SetConnectionReusable(conn_reusable);
 
   inflight_response->response = std::move(rsp);
@@ -218,7 +195,6 @@ int ParseHttpResponse(const ConnectionPtr& conn, NoncontiguousBuffer& in, std::d
     } else if (nparse == kParserNeedMore) {
       return PacketChecker::PACKET_LESS;
     }
-    in.Skip(nparse);
   }
 
   // Body is not required when request method is HEAD or PATCH.
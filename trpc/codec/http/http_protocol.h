@@ -107,6 +107,10 @@ class HttpResponseProtocol : public Protocol {
   /// @brief Get size of message
   uint32_t GetMessageSize() const override;
 
+  /// @brief Reports whether the response is sent over HTTP/2, it's framed by the HTTP/2 session of the connection
+  /// instead of being serialized as HTTP/1.x then.
+  virtual bool IsHttp2() const { return false; }
+
  public:
   http::Response response;
 };
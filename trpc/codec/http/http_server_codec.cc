@@ -192,13 +192,13 @@ bool TrpcOverHttpServerCodec::ZeroCopyDecode(const ServerContextPtr& ctx, std::a
     }
 
     // Content-Type.
-    const auto& content_type = http_req->GetHeader(http::kHeaderContentType);
+    std::string_view content_type = http_req->GetHeaderView(http::kHeaderContentType);
     if (!content_type.empty()) {
       // Try to parse string like: content-type:text/html; charset=utf-8
       std::map<std::string_view, uint32_t>::const_iterator it;
       uint32_t req_encode_type{0};
       auto pos = content_type.find(';');
-      bool ok = (pos == std::string::npos)
+      bool ok = (pos == std::string_view::npos)
                     ? ContentTypeToSerializationType(content_type, &req_encode_type)
                     : ContentTypeToSerializationType(content_type.substr(0, pos), &req_encode_type);
       if (ok) {
@@ -209,13 +209,13 @@ bool TrpcOverHttpServerCodec::ZeroCopyDecode(const ServerContextPtr& ctx, std::a
     }
 
     //  Content-Encoding.
-    const std::string& content_encoding = http_req->GetHeader(http::kHeaderContentEncoding);
+    std::string_view content_encoding = http_req->GetHeaderView(http::kHeaderContentEncoding);
     if (!content_encoding.empty() && content_encoding != "identity") {
       // Set compressor::kMaxType if compress method not found.
       compressor::CompressType compress_type = http::StringToCompressType(content_encoding);
       ctx->SetReqCompressType(compress_type);
     }
-    std::vector<std::string_view> accept_encoding_list = Split(http_req->GetHeader(http::kHeaderAcceptEncoding), ",");
+    std::vector<std::string_view> accept_encoding_list = Split(http_req->GetHeaderView(http::kHeaderAcceptEncoding), ",");
     for (const auto& accept_encoding : accept_encoding_list) {
       std::string_view formatted_accept_encoding = Trim(accept_encoding);
       compressor::CompressType compress_type = http::StringToCompressType(formatted_accept_encoding);
@@ -19,6 +19,7 @@
 
 #include "trpc/transport/server/fiber/fiber_server_connection_handler_factory.h"
 #include "trpc/transport/server/fiber/fiber_server_transport_impl.h"
+#include "trpc/util/http/http_parser.h"
 #include "trpc/util/http/util.h"
 #include "trpc/util/log/logging.h"
 
@@ -41,7 +42,7 @@ constexpr int kParserNeedMore = -2;
 constexpr int kParserError = -1;
 
 /// @brief Parses the http request headers.
-/// @return If parsing is successful, it returns the length of the successfully parsed bytes.
+/// @return If parsing is successful, it returns the length of the successfully parsed bytes, which are cut from |in|.
 ///         If the request is incomplete, it returns -2 (kParserNeedMore).
 ///         If parsing fails, it returns -1 (kParserError).
 int ParseHeader(const ConnectionPtr& conn, InternalInflightHttpRequestPtr& inflight_request, NoncontiguousBuffer& in) {
@@ -51,56 +52,32 @@ int ParseHeader(const ConnectionPtr& conn, InternalInflightHttpRequestPtr& infli
 
   size_t max_packet_size =
       conn->GetMaxPacketSize() > 0 ? conn->GetMaxPacketSize() : (std::numeric_limits<size_t>::max() - 1);
-  auto buf = FlattenSlowUntil(in, http::kEndOfHeaderMarker, max_packet_size + 1);
-  if (buf.size() > max_packet_size) {  // the length of headers exceed the maximum allowed size
-    return kParserError;
-  }
-
-  // 1: parse the headers
-  const char* method = nullptr;
-  size_t method_len = 0;
-  const char* path = nullptr;
-  size_t path_len = 0;
-  int minor_version = 0;
-  phr_header headers[http::kMaxHeaderNum];
-  size_t num_headers = http::kMaxHeaderNum;
 
-  int parsed_bytes = phr_parse_request(buf.c_str(), buf.size(), &method, &method_len, &path, &path_len, &minor_version,
-                                       headers, &num_headers, 0);
-  // phr_parse_request return -1 when failed, -2 when a request is incomplete
+  // 1: parse the headers, they refer to the received bytes rather than being copied
+  auto req = std::make_shared<http::Request>(0, inflight_request->is_blocking);
+  int parsed_bytes = http::ParseHead(in, max_packet_size, req.get());
+  // ParseHead return -1 when failed, -2 when a request is incomplete
   if (parsed_bytes < 0) {
     return parsed_bytes;
   }
 
-  // 2: convert phr_parse_request result to HttpRequest
+  // 2: check the framing headers of the request
   size_t queue_capacity = max_packet_size - parsed_bytes;
-  auto req = std::make_shared<http::Request>(queue_capacity, inflight_request->is_blocking);
+  req->GetStream().SetCapacity(queue_capacity);
   std::optional<size_t> content_length;
-  bool is_chunked = false;
-
-  for (size_t i = 0; i < num_headers; i++) {
-    const auto& header = headers[i];
-    if (!is_chunked && header.name_len == http::kHeaderTransferEncodingLen &&
-        strncasecmp(header.name, http::kHeaderTransferEncoding, http::kHeaderTransferEncodingLen) == 0) {
-      is_chunked = true;
-    } else if (!content_length && header.name_len == http::kHeaderContentLengthLen &&
-               strncasecmp(header.name, http::kHeaderContentLength, http::kHeaderContentLengthLen) == 0) {
-      content_length = http::ParseContentLength(header.value, header.value_len);
-      if (!content_length ||  // invalid Content-Length value
-          (!inflight_request->is_blocking && content_length.value() > queue_capacity)) {  // rpc request too large
-        return kParserError;
-      }
+  bool is_chunked = req->HasHeader(http::kHeaderTransferEncoding);
+  if (req->HasHeader(http::kHeaderContentLength)) {
+    std::string_view value = req->GetHeaderView(http::kHeaderContentLength);
+    content_length = http::ParseContentLength(value.data(), value.size());
+    if (!content_length ||  // invalid Content-Length value
+        (!inflight_request->is_blocking && content_length.value() > queue_capacity)) {  // rpc request too large
+      return kParserError;
     }
-
-    req->AddHeader(std::string{header.name, header.name_len}, std::string{header.value, header.value_len});
   }
   if (content_length && is_chunked) {  // chunked encoding must not have Content-Length
     return kParserError;
   }
 
-  req->SetMethodType(http::StringToType(std::string_view{method, method_len}));
-  req->SetUrl(std::string{path, path_len});
-  req->SetVersion(minor_version == 0 ? http::kVersion10 : http::kVersion11);
   req->SetContentLength(content_length);
 
   // 3: setup inflight_request
@@ -235,7 +212,6 @@ int ParseHttpRequest(const ConnectionPtr& conn, NoncontiguousBuffer& in, bool is
       } else if (parsed_bytes == kParserNeedMore) {
         break;
       }
-      in.Skip(parsed_bytes);
     }
 
     // parse body
@@ -119,6 +119,30 @@ TEST_F(HttpServerProtoCheckerTest, DefaultSingleNonChunkedFullPacket2) {
   ASSERT_EQ("helloworld", FlattenSlow(req->GetNonContiguousBufferContent()));
 }
 
+TEST_F(HttpServerProtoCheckerTest, HeaderSpanningBlocks) {
+  // the header is received in pieces, the packet is complete after the last one
+  std::string s = "POST /form.html HTTP/1.1\r\nContent-Length:5\r\ncontent-type:text/html\r\n\r\nhello";
+  for (size_t pos : {10, 50, 69}) {
+    SetUp();
+    in_.Append(CreateBufferSlow(s.substr(0, pos)));
+    ASSERT_EQ(kPacketLess, HttpZeroCopyCheckRequest(conn_, in_, out_));
+    ASSERT_EQ(pos, in_.ByteSize());
+
+    in_.Append(CreateBufferSlow(s.substr(pos)));
+    ASSERT_EQ(kPacketFull, HttpZeroCopyCheckRequest(conn_, in_, out_));
+    ASSERT_EQ(1, out_.size());
+    ASSERT_EQ(0, in_.ByteSize());
+
+    const auto& req = std::any_cast<const http::RequestPtr&>(out_.front());
+    ASSERT_TRUE(req->IsPost());
+    ASSERT_EQ("/form.html", req->GetUrl());
+    ASSERT_EQ("text/html", req->GetHeader("Content-Type"));
+    ASSERT_EQ("5", req->GetHeaderView("Content-Length"));
+    ASSERT_TRUE(req->GetStream().AppendToRequest(5).OK());
+    ASSERT_EQ("hello", FlattenSlow(req->GetNonContiguousBufferContent()));
+  }
+}
+
 TEST_F(HttpServerProtoCheckerTest, DefaultMultiNonChunkedFullPacket1) {
   // the headers and bodies of multiple packets are complete
   std::string s = "GET /form.html HTTP/1.1\r\nContent-Length:5\r\n\r\nhello";
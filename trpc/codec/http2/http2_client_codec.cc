@@ -0,0 +1,91 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#include "trpc/codec/http2/http2_client_codec.h"
+
+#include <limits>
+#include <string>
+#include <utility>
+
+#include "trpc/util/http/util.h"
+#include "trpc/util/log/logging.h"
+
+namespace trpc {
+
+bool Http2ClientCodec::ZeroCopyEncode(const ClientContextPtr& ctx, const ProtocolPtr& in, NoncontiguousBuffer& out) {
+  auto* http2_req_msg = static_cast<Http2RequestProtocol*>(in.get());
+  http2_req_msg->SetRequestId(ctx->GetRequestId());
+  http::Request& req = *http2_req_msg->request;
+
+  http2::RequestPtr http2_request = http2::CreateRequest();
+  http2_request->SetMethod(req.GetMethod());
+  http2_request->SetPath(req.GetUrl().empty() ? "/" : req.GetUrl());
+  const auto* option = ctx->GetServiceProxyOption();
+  http2_request->SetScheme(option && option->ssl_config.enable ? "https" : "http");
+  // Use Host header or IP:Port as ":authority" (e.g. 127.0.0.1:8080).
+  std::string authority = req.GetHeader("Host");
+  if (authority.empty()) {
+    authority.append(ctx->GetIp()).append(":").append(std::to_string(ctx->GetPort()));
+  }
+  http2_request->SetAuthority(std::move(authority));
+
+  req.RangeHeader([&http2_request](std::string_view name, std::string_view value) {
+    // ":authority" replaces "Host", "content-length" is recomputed from the body below.
+    if (!internal::IsHttp2ConnectionSpecificHeader(name) &&
+        !http::StringEqualsIgnoreCase(name, std::string_view{"host"}) &&
+        !http::StringEqualsIgnoreCase(name, std::string_view{http::kHeaderContentLength})) {
+      http2_request->AddHeader(internal::ToHttp2HeaderName(name), std::string{value});
+    }
+    return true;
+  });
+
+  NoncontiguousBuffer content;
+  std::move(*req.GetMutableContentProvider()).SerializeToString(content);
+  if (content.ByteSize() > 0) {
+    http2_request->AddHeader("content-length", std::to_string(content.ByteSize()));
+  }
+  http2_request->SetNonContiguousBufferContent(std::move(content));
+  // Sets the request identifier to match the response.
+  http2_request->SetContentSequenceId(ctx->GetRequestId());
+  http2_req_msg->http2_request = std::move(http2_request);
+
+  // Stream ID is allocated by the HTTP/2 session while the request is submitted in `EncodeStreamMessage` of the stream
+  // connection handler, a non-zero stream ID makes the transport go there (same as gRPC).
+  ctx->SetStreamId(std::numeric_limits<uint32_t>::max());
+  return true;
+}
+
+bool Http2ClientCodec::ZeroCopyDecode(const ClientContextPtr& ctx, std::any&& in, ProtocolPtr& out) {
+  auto http2_response = std::any_cast<http2::ResponsePtr&&>(std::move(in));
+  auto* http2_rsp_msg = static_cast<Http2ResponseProtocol*>(out.get());
+  http2_rsp_msg->SetRequestId(http2_response->GetContentSequenceId());
+
+  http::Response& rsp = http2_rsp_msg->response;
+  rsp.SetVersion("2.0");
+  rsp.SetStatus(http2_response->GetStatus());
+  *rsp.GetMutableHeader() = std::move(*http2_response->GetMutableHeader());
+  *rsp.GetMutableTrailer() = std::move(*http2_response->GetMutableTrailer());
+  rsp.SetNonContiguousBufferContent(std::move(*http2_response->GetMutableNonContiguousBufferContent()));
+  return true;
+}
+
+ProtocolPtr Http2ClientCodec::CreateRequestPtr() {
+  return std::make_shared<Http2RequestProtocol>(std::make_shared<http::Request>());
+}
+
+ProtocolPtr Http2ClientCodec::CreateResponsePtr() { return std::make_shared<Http2ResponseProtocol>(); }
+
+uint32_t Http2ClientCodec::GetSequenceId(const ProtocolPtr& rsp) const {
+  return static_cast<Http2ResponseProtocol*>(rsp.get())->request_id;
+}
+
+}  // namespace trpc
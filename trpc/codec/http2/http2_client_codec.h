@@ -0,0 +1,74 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#pragma once
+
+#include <any>
+#include <deque>
+#include <string>
+
+#include "trpc/codec/http/http_client_codec.h"
+#include "trpc/codec/http2/http2_protocol.h"
+
+namespace trpc {
+
+/// @brief HTTP/2 codec (client-side) which lets `HttpServiceProxy` talk HTTP/2 (h2c with prior knowledge, or h2 over
+/// TLS), many requests are multiplexed on one connection.
+///
+/// Framing is done by the HTTP/2 session held by the stream handler of the connection (shared with gRPC). This codec
+/// only converts between the `http::Request`/`http::Response` seen by users and the HTTP/2 messages of the session.
+class Http2ClientCodec : public HttpClientCodec {
+ public:
+  ~Http2ClientCodec() override = default;
+
+  /// @brief Returns name of HTTP/2 codec.
+  std::string Name() const override { return kHttp2CodecName; }
+
+  /// @brief Responses are checked out by the HTTP/2 session of the connection instead.
+  int ZeroCopyCheck(const ConnectionPtr& conn, NoncontiguousBuffer& in, std::deque<std::any>& out) override {
+    return PacketChecker::PACKET_LESS;
+  }
+
+  /// @brief Decodes a HTTP response protocol message object from a complete HTTP/2 response.
+  ///
+  /// @param ctx is client context for decoding.
+  /// @param in is a complete HTTP/2 response checked out by the HTTP/2 session.
+  /// @param out is HTTP/2 response protocol message object.
+  /// @return Returns true on success, false otherwise.
+  bool ZeroCopyDecode(const ClientContextPtr& ctx, std::any&& in, ProtocolPtr& out) override;
+
+  /// @brief Builds the HTTP/2 request to be submitted to the HTTP/2 session from the HTTP request, nothing is written
+  /// into |out|.
+  ///
+  /// @param ctx is client context for encoding.
+  /// @param in  is HTTP/2 request protocol message object.
+  /// @param out is unused, the request is framed by the HTTP/2 session of the connection.
+  /// @return Returns true on success, false otherwise.
+  bool ZeroCopyEncode(const ClientContextPtr& ctx, const ProtocolPtr& in, NoncontiguousBuffer& out) override;
+
+  /// @brief Creates a HTTP/2 request protocol object.
+  ProtocolPtr CreateRequestPtr() override;
+
+  /// @brief Creates a HTTP/2 response protocol object.
+  ProtocolPtr CreateResponsePtr() override;
+
+  /// @brief Returns the request id which the response matches, responses may arrive out of order.
+  uint32_t GetSequenceId(const ProtocolPtr& rsp) const override;
+
+  /// @brief Reports whether the connection is shared by concurrent requests.
+  bool IsComplex() const override { return true; }
+
+  /// @brief Reports whether it is streaming protocol.
+  bool IsStreamingProtocol() const override { return true; }
+};
+
+}  // namespace trpc
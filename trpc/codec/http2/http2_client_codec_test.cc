@@ -0,0 +1,108 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/codec/http2/http2_client_codec.h"
+
+#include <limits>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+#include "trpc/client/client_context.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc::testing {
+
+class Http2ClientCodecTest : public ::testing::Test {
+ protected:
+  Http2ClientCodec codec_;
+};
+
+TEST_F(Http2ClientCodecTest, Name) {
+  ASSERT_EQ("http2", codec_.Name());
+  ASSERT_TRUE(codec_.IsComplex());
+  ASSERT_TRUE(codec_.IsStreamingProtocol());
+}
+
+TEST_F(Http2ClientCodecTest, Encode) {
+  ClientContextPtr ctx = MakeRefCounted<ClientContext>();
+  ctx->SetRequestId(7);
+  ctx->SetAddr("127.0.0.1", 8080);
+
+  ProtocolPtr req_protocol = codec_.CreateRequestPtr();
+  auto* req_msg = static_cast<Http2RequestProtocol*>(req_protocol.get());
+  http::Request& req = *req_msg->request;
+  req.SetMethod("POST");
+  req.SetUrl("/hello?name=trpc");
+  req.SetHeader("Content-Type", "application/json");
+  req.SetHeader("Content-Length", "100");
+  req.SetHeader("Connection", "keep-alive");
+  req.SetContent("{}");
+
+  NoncontiguousBuffer out;
+  ASSERT_TRUE(codec_.ZeroCopyEncode(ctx, req_protocol, out));
+  ASSERT_EQ(0, out.ByteSize());
+  ASSERT_EQ(std::numeric_limits<uint32_t>::max(), ctx->GetStreamId());
+
+  const http2::RequestPtr& http2_request = req_msg->http2_request;
+  ASSERT_NE(nullptr, http2_request);
+  ASSERT_EQ("POST", http2_request->GetMethod());
+  ASSERT_EQ("http", http2_request->GetScheme());
+  ASSERT_EQ("/hello?name=trpc", http2_request->GetPath());
+  ASSERT_EQ("127.0.0.1:8080", http2_request->GetAuthority());
+  ASSERT_EQ("application/json", http2_request->GetHeader("content-type"));
+  ASSERT_EQ("2", http2_request->GetHeader("content-length"));
+  ASSERT_FALSE(http2_request->HasHeader("connection"));
+  ASSERT_EQ(7, http2_request->GetContentSequenceId());
+  ASSERT_EQ("{}", FlattenSlow(*http2_request->GetMutableNonContiguousBufferContent()));
+}
+
+TEST_F(Http2ClientCodecTest, EncodeWithHost) {
+  ClientContextPtr ctx = MakeRefCounted<ClientContext>();
+  ctx->SetAddr("127.0.0.1", 8080);
+
+  ProtocolPtr req_protocol = codec_.CreateRequestPtr();
+  auto* req_msg = static_cast<Http2RequestProtocol*>(req_protocol.get());
+  req_msg->request->SetMethod("GET");
+  req_msg->request->SetHeader("Host", "www.example.com");
+
+  NoncontiguousBuffer out;
+  ASSERT_TRUE(codec_.ZeroCopyEncode(ctx, req_protocol, out));
+  ASSERT_EQ("/", req_msg->http2_request->GetPath());
+  ASSERT_EQ("www.example.com", req_msg->http2_request->GetAuthority());
+  ASSERT_FALSE(req_msg->http2_request->HasHeader("host"));
+  ASSERT_FALSE(req_msg->http2_request->HasHeader("content-length"));
+}
+
+TEST_F(Http2ClientCodecTest, Decode) {
+  auto http2_response = http2::CreateResponse();
+  http2_response->SetStatus(http::ResponseStatus::kNotFound);
+  http2_response->AddHeader("content-type", "text/plain");
+  http2_response->GetMutableTrailer()->Add("x-trailer", "end");
+  http2_response->SetContentSequenceId(9);
+  http2_response->SetNonContiguousBufferContent(CreateBufferSlow("not found"));
+
+  ClientContextPtr ctx = MakeRefCounted<ClientContext>();
+  ProtocolPtr rsp_protocol = codec_.CreateResponsePtr();
+  ASSERT_TRUE(codec_.ZeroCopyDecode(ctx, std::move(http2_response), rsp_protocol));
+  ASSERT_EQ(9, codec_.GetSequenceId(rsp_protocol));
+
+  const http::Response& rsp = static_cast<Http2ResponseProtocol*>(rsp_protocol.get())->response;
+  ASSERT_EQ("2.0", rsp.GetVersion());
+  ASSERT_EQ(http::ResponseStatus::kNotFound, rsp.GetStatus());
+  ASSERT_EQ("text/plain", rsp.GetHeader("Content-Type"));
+  ASSERT_EQ("end", rsp.GetTrailer().Get("x-trailer"));
+  ASSERT_EQ("not found", rsp.GetContent());
+}
+
+}  // namespace trpc::testing
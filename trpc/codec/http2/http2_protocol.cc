@@ -0,0 +1,124 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#include "trpc/codec/http2/http2_protocol.h"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <vector>
+
+#include "trpc/codec/grpc/http2/http2.h"
+#include "trpc/util/http/base64.h"
+#include "trpc/util/http/common.h"
+#include "trpc/util/http/util.h"
+#include "trpc/util/string/string_util.h"
+
+namespace trpc::internal {
+
+namespace {
+
+constexpr std::string_view kHttp2ClientPreface = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+
+// Reports whether the comma-separated header field value contains |token|, e.g. "Upgrade: h2c".
+bool HasHeaderToken(std::string_view value, std::string_view token) {
+  while (!value.empty()) {
+    std::size_t pos = std::min(value.find(','), value.size());
+    if (http::StringEqualsIgnoreCase(util::TrimStringView(value.substr(0, pos)), token)) {
+      return true;
+    }
+    value.remove_prefix(std::min(pos + 1, value.size()));
+  }
+  return false;
+}
+
+// Decodes "HTTP2-Settings" header field value, which is in base64url without padding (RFC 7540, 3.2.1).
+bool DecodeHttp2Settings(std::string_view value, std::string* settings_payload) {
+  std::string base64;
+  base64.reserve(value.size() + 3);
+  for (char c : value) {
+    if (c == '-') {
+      base64.push_back('+');
+    } else if (c == '_') {
+      base64.push_back('/');
+    } else if (std::isalnum(static_cast<unsigned char>(c))) {
+      base64.push_back(c);
+    } else {
+      return false;
+    }
+  }
+  base64.append((4 - base64.size() % 4) % 4, '=');
+  *settings_payload = http::Base64Decode(base64.begin(), base64.end());
+  // Each setting is 6 bytes.
+  return (base64.empty() || !settings_payload->empty()) && settings_payload->size() % 6 == 0;
+}
+
+}  // namespace
+
+bool IsHttp2ConnectionSpecificHeader(std::string_view name) {
+  static constexpr std::string_view kConnectionSpecificHeaders[] = {
+      "connection", "keep-alive", "proxy-connection", "transfer-encoding", "upgrade",
+  };
+  return std::any_of(std::begin(kConnectionSpecificHeaders), std::end(kConnectionSpecificHeaders),
+                     [name](std::string_view header) { return http::StringEqualsIgnoreCase(name, header); });
+}
+
+std::string ToHttp2HeaderName(std::string_view name) {
+  std::string http2_name{name};
+  std::transform(http2_name.begin(), http2_name.end(), http2_name.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return http2_name;
+}
+
+int CheckHttp2Preface(const NoncontiguousBuffer& in) {
+  std::string head = FlattenSlow(in, kHttp2ClientPreface.size());
+  if (kHttp2ClientPreface.compare(0, head.size(), head) != 0) {
+    return -1;
+  }
+  return head.size() == kHttp2ClientPreface.size() ? 1 : 0;
+}
+
+bool GetH2cUpgradeSettings(const http::Request& request, std::string* settings_payload) {
+  if (!HasHeaderToken(request.GetHeaderView("Upgrade"), "h2c")) {
+    return false;
+  }
+  std::string_view content_length = request.GetHeaderView(http::kHeaderContentLength);
+  if (request.HasHeader(http::kHeaderTransferEncoding) || (!content_length.empty() && content_length != "0")) {
+    return false;
+  }
+  // Exactly one "HTTP2-Settings" header field is required.
+  std::vector<std::string_view> settings = request.GetHeaderValues("HTTP2-Settings");
+  if (settings.size() != 1) {
+    return false;
+  }
+  return DecodeHttp2Settings(util::TrimStringView(settings.front()), settings_payload);
+}
+
+http2::RequestPtr ToHttp2Request(const http::Request& request) {
+  http2::RequestPtr http2_request = http2::CreateRequest();
+  http2_request->SetStreamId(1);
+  http2_request->SetMethod(request.GetMethod());
+  http2_request->SetScheme("http");
+  http2_request->SetAuthority(request.GetHeader("Host"));
+  const std::string& url = request.GetUrl();
+  http2::SplitPath(url.begin(), url.end(), http2_request->GetMutableUriRef());
+  request.RangeHeader([&http2_request](std::string_view name, std::string_view value) {
+    if (!IsHttp2ConnectionSpecificHeader(name) &&
+        !http::StringEqualsIgnoreCase(name, std::string_view{"http2-settings"})) {
+      http2_request->AddHeader(ToHttp2HeaderName(name), std::string{value});
+    }
+    return true;
+  });
+  return http2_request;
+}
+
+}  // namespace trpc::internal
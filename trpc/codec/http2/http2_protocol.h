@@ -0,0 +1,101 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "trpc/codec/grpc/http2/request.h"
+#include "trpc/codec/grpc/http2/response.h"
+#include "trpc/codec/http/http_protocol.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc {
+
+/// @brief The codec protocol name for HTTP/2 (h2c with prior knowledge, or h2 negotiated by ALPN over TLS).
+constexpr char kHttp2CodecName[] = "http2";
+
+/// @brief HTTP/2 request protocol message.
+/// It carries the same `http::Request` as HTTP/1.1 does, so that `HttpServiceProxy` works with both of them. The HTTP/2
+/// request which is submitted to the HTTP/2 session is built from it while encoding.
+class Http2RequestProtocol : public HttpRequestProtocol {
+ public:
+  // Used by server side.
+  Http2RequestProtocol() = default;
+  // Used by client side.
+  explicit Http2RequestProtocol(http::RequestPtr&& request) : HttpRequestProtocol(std::move(request)) {}
+  ~Http2RequestProtocol() override = default;
+
+ public:
+  http2::RequestPtr http2_request{nullptr};
+};
+
+/// @brief HTTP/2 response protocol message.
+/// It carries the same `http::Response` as HTTP/1.1 does, so that `HttpService` handlers work with both of them. The
+/// HTTP/2 response which is submitted to the HTTP/2 session is built from it while encoding.
+class Http2ResponseProtocol : public HttpResponseProtocol {
+ public:
+  ~Http2ResponseProtocol() override = default;
+
+  /// @brief Reports whether the response is sent over HTTP/2, it's not when the client falls back to HTTP/1.1.
+  bool IsHttp2() const override { return !http1_fallback; }
+
+  /// @brief Get/Set the unique id of request/response protocol.
+  bool GetRequestId(uint32_t& req_id) const override {
+    req_id = request_id;
+    return true;
+  }
+  bool SetRequestId(uint32_t req_id) override {
+    request_id = req_id;
+    return true;
+  }
+
+ public:
+  uint32_t request_id{0};
+  http2::ResponsePtr http2_response{nullptr};
+  // The request is received over HTTP/1.1 by the "http2" service, e.g. the client didn't negotiate "h2" by ALPN.
+  bool http1_fallback{false};
+};
+
+namespace internal {
+
+/// @brief Reports whether the header field must not be forwarded in HTTP/2, such as "Connection", "Keep-Alive",
+/// "Transfer-Encoding" (RFC 9113, 8.2.2).
+bool IsHttp2ConnectionSpecificHeader(std::string_view name);
+
+/// @brief Converts a HTTP/1.x style header field name into a HTTP/2 one, which must be in lowercase.
+std::string ToHttp2HeaderName(std::string_view name);
+
+/// @brief Checks whether the received bytes start with the HTTP/2 client connection preface (RFC 9113, 3.4).
+/// @return Returns 1 if they do, 0 if more bytes are needed to tell, -1 if they don't.
+int CheckHttp2Preface(const NoncontiguousBuffer& in);
+
+/// @brief Gets the settings of a HTTP/1.1 request which asks for upgrading to h2c (RFC 7540, 3.2).
+/// Requests with content are not upgraded, as the content must be received before switching protocols.
+///
+/// @param request is the HTTP/1.1 request.
+/// @param settings_payload is the SETTINGS frame payload decoded from "HTTP2-Settings" header.
+/// @return Returns true if the request can be upgraded, false otherwise.
+bool GetH2cUpgradeSettings(const http::Request& request, std::string* settings_payload);
+
+/// @brief Converts the HTTP/1.1 request which is upgraded to h2c into the HTTP/2 request of stream 1.
+http2::RequestPtr ToHttp2Request(const http::Request& request);
+
+/// @brief The response sent to a HTTP/1.1 request which is upgraded to h2c.
+constexpr std::string_view kH2cSwitchingProtocolsResponse =
+    "HTTP/1.1 101 Switching Protocols\r\nConnection: Upgrade\r\nUpgrade: h2c\r\n\r\n";
+
+}  // namespace internal
+
+}  // namespace trpc
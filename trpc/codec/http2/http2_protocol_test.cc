@@ -0,0 +1,105 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/codec/http2/http2_protocol.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+TEST(Http2ProtocolTest, RequestId) {
+  Http2ResponseProtocol rsp;
+  uint32_t request_id = 0;
+  ASSERT_TRUE(rsp.SetRequestId(100));
+  ASSERT_TRUE(rsp.GetRequestId(request_id));
+  ASSERT_EQ(100, request_id);
+}
+
+TEST(Http2ProtocolTest, IsHttp2ConnectionSpecificHeader) {
+  ASSERT_TRUE(internal::IsHttp2ConnectionSpecificHeader("Connection"));
+  ASSERT_TRUE(internal::IsHttp2ConnectionSpecificHeader("keep-alive"));
+  ASSERT_TRUE(internal::IsHttp2ConnectionSpecificHeader("Transfer-Encoding"));
+  ASSERT_TRUE(internal::IsHttp2ConnectionSpecificHeader("Upgrade"));
+  ASSERT_FALSE(internal::IsHttp2ConnectionSpecificHeader("Content-Type"));
+  ASSERT_FALSE(internal::IsHttp2ConnectionSpecificHeader("x-user-defined"));
+}
+
+TEST(Http2ProtocolTest, ToHttp2HeaderName) {
+  ASSERT_EQ("content-type", internal::ToHttp2HeaderName("Content-Type"));
+  ASSERT_EQ("x-user-defined", internal::ToHttp2HeaderName("x-user-defined"));
+}
+
+TEST(Http2ProtocolTest, IsHttp2) {
+  Http2ResponseProtocol rsp;
+  ASSERT_TRUE(rsp.IsHttp2());
+  rsp.http1_fallback = true;
+  ASSERT_FALSE(rsp.IsHttp2());
+  ASSERT_FALSE(HttpResponseProtocol{}.IsHttp2());
+}
+
+TEST(Http2ProtocolTest, CheckHttp2Preface) {
+  ASSERT_EQ(1, internal::CheckHttp2Preface(CreateBufferSlow("PRI * HTTP/2.0\r\n\r\nSM\r\n\r\nframes")));
+  ASSERT_EQ(0, internal::CheckHttp2Preface(CreateBufferSlow("PRI * HTTP/2")));
+  ASSERT_EQ(0, internal::CheckHttp2Preface(NoncontiguousBuffer{}));
+  ASSERT_EQ(-1, internal::CheckHttp2Preface(CreateBufferSlow("GET / HTTP/1.1\r\n")));
+}
+
+TEST(Http2ProtocolTest, GetH2cUpgradeSettings) {
+  http::Request request;
+  request.SetMethod("GET");
+  request.SetUrl("/hello?name=trpc");
+  request.AddHeader("Host", "www.example.com");
+  request.AddHeader("Connection", "Upgrade, HTTP2-Settings");
+  request.AddHeader("Upgrade", "foo, H2C");
+  // SETTINGS_MAX_CONCURRENT_STREAMS = 100, SETTINGS_INITIAL_WINDOW_SIZE = 65535.
+  request.AddHeader("HTTP2-Settings", "AAMAAABkAAQAAP__");
+  request.AddHeader("x-user-defined", "value");
+
+  std::string settings;
+  ASSERT_TRUE(internal::GetH2cUpgradeSettings(request, &settings));
+  ASSERT_EQ(std::string("\x00\x03\x00\x00\x00\x64\x00\x04\x00\x00\xff\xff", 12), settings);
+
+  http2::RequestPtr http2_request = internal::ToHttp2Request(request);
+  ASSERT_EQ(1, http2_request->GetStreamId());
+  ASSERT_EQ("GET", http2_request->GetMethod());
+  ASSERT_EQ("www.example.com", http2_request->GetAuthority());
+  ASSERT_EQ("/hello", http2_request->GetPath());
+  ASSERT_EQ("name=trpc", http2_request->GetUriRef().RawQuery());
+  ASSERT_EQ("value", http2_request->GetHeader("x-user-defined"));
+  ASSERT_FALSE(http2_request->HasHeader("Connection"));
+  ASSERT_FALSE(http2_request->HasHeader("Upgrade"));
+  ASSERT_FALSE(http2_request->HasHeader("HTTP2-Settings"));
+
+  // Requests with content are served over HTTP/1.1.
+  request.SetHeader("Content-Length", "10");
+  ASSERT_FALSE(internal::GetH2cUpgradeSettings(request, &settings));
+  request.SetHeader("Content-Length", "0");
+  ASSERT_TRUE(internal::GetH2cUpgradeSettings(request, &settings));
+
+  // Invalid settings.
+  request.SetHeader("HTTP2-Settings", "AAMAAAB");
+  ASSERT_FALSE(internal::GetH2cUpgradeSettings(request, &settings));
+  request.SetHeader("HTTP2-Settings", "AAMAAABk+AQA");
+  ASSERT_FALSE(internal::GetH2cUpgradeSettings(request, &settings));
+
+  // Not an upgrade to h2c.
+  request.SetHeader("HTTP2-Settings", "");
+  ASSERT_TRUE(internal::GetH2cUpgradeSettings(request, &settings));
+  ASSERT_TRUE(settings.empty());
+  request.SetHeader("Upgrade", "websocket");
+  ASSERT_FALSE(internal::GetH2cUpgradeSettings(request, &settings));
+}
+
+}  // namespace trpc::testing
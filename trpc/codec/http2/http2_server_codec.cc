@@ -0,0 +1,101 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#include "trpc/codec/http2/http2_server_codec.h"
+
+#include <string>
+#include <utility>
+
+#include "trpc/codec/grpc/grpc_stream_frame.h"
+#include "trpc/util/http/util.h"
+#include "trpc/util/log/logging.h"
+
+namespace trpc {
+
+bool Http2ServerCodec::ZeroCopyDecode(const ServerContextPtr& ctx, std::any&& in, ProtocolPtr& out) {
+  // The client fell back to HTTP/1.1, the request is checked as `HttpServerCodec` does.
+  if (auto* http_req = std::any_cast<http::RequestPtr>(&in)) {
+    static_cast<Http2ResponseProtocol*>(ctx->GetResponseMsg().get())->http1_fallback = true;
+    static_cast<Http2RequestProtocol*>(out.get())->request = std::move(*http_req);
+    return true;
+  }
+
+  auto packet = std::any_cast<stream::GrpcRequestPacket&&>(std::move(in));
+  if (TRPC_UNLIKELY(!packet.req)) {
+    TRPC_LOG_ERROR("HTTP/2 stream frame is not expected by HTTP service");
+    return false;
+  }
+
+  http2::RequestPtr http2_request = std::move(packet.req);
+  // Pseudo-header fields are mapped onto the request line, so that routes work as they do in HTTP/1.1.
+  const http2::UriRef& uri_ref = http2_request->GetUriRef();
+  std::string url = uri_ref.RawPath().empty() ? uri_ref.Path() : uri_ref.RawPath();
+  if (!uri_ref.RawQuery().empty()) {
+    url.append("?").append(uri_ref.RawQuery());
+  }
+  http2_request->SetUrl(std::move(url));
+  http2_request->SetVersion("2.0");
+  if (!http2_request->GetAuthority().empty()) {
+    http2_request->SetHeaderIfNotPresent("Host", http2_request->GetAuthority());
+  }
+  // The whole content has been received by the HTTP/2 session.
+  http2_request->SetMaxBodySize(http2_request->ContentLength());
+
+  ctx->SetStreamId(http2_request->GetStreamId());
+  auto* http2_rsp_msg = static_cast<Http2ResponseProtocol*>(ctx->GetResponseMsg().get());
+  http2_rsp_msg->response.SetVersion("2.0");
+
+  auto* http2_req_msg = static_cast<Http2RequestProtocol*>(out.get());
+  http2_req_msg->http2_request = http2_request;
+  http2_req_msg->request = std::move(http2_request);
+  return true;
+}
+
+bool Http2ServerCodec::ZeroCopyEncode(const ServerContextPtr& ctx, ProtocolPtr& in, NoncontiguousBuffer& out) {
+  auto* http2_rsp_msg = static_cast<Http2ResponseProtocol*>(in.get());
+  // HTTP/1.1 response has been serialized by `HttpService`.
+  if (http2_rsp_msg->http1_fallback) {
+    return true;
+  }
+  http::Response& rsp = http2_rsp_msg->response;
+
+  http2::ResponsePtr http2_response = http2::CreateResponse();
+  http2_response->SetStreamId(ctx->GetStreamId());
+  http2_response->SetStatus(rsp.GetStatus());
+  rsp.RangeHeader([&http2_response](std::string_view name, std::string_view value) {
+    // "Date" is always added by the HTTP/2 session.
+    if (!internal::IsHttp2ConnectionSpecificHeader(name) &&
+        !http::StringEqualsIgnoreCase(name, std::string_view{"date"})) {
+      http2_response->AddHeader(internal::ToHttp2HeaderName(name), std::string{value});
+    }
+    return true;
+  });
+  for (const auto& [name, value] : rsp.GetTrailer().Pairs()) {
+    http2_response->GetMutableTrailer()->Add(internal::ToHttp2HeaderName(name), std::string{value});
+  }
+
+  if (!rsp.IsHeaderOnly()) {
+    NoncontiguousBuffer content;
+    std::move(*rsp.GetMutableContentProvider()).SerializeToString(content);
+    http2_response->SetHeaderIfNotPresent("content-length", std::to_string(content.ByteSize()));
+    http2_response->SetNonContiguousBufferContent(std::move(content));
+  }
+
+  http2_rsp_msg->http2_response = std::move(http2_response);
+  return true;
+}
+
+ProtocolPtr Http2ServerCodec::CreateRequestObject() { return std::make_shared<Http2RequestProtocol>(); }
+
+ProtocolPtr Http2ServerCodec::CreateResponseObject() { return std::make_shared<Http2ResponseProtocol>(); }
+
+}  // namespace trpc
@@ -0,0 +1,71 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#pragma once
+
+#include <any>
+#include <deque>
+#include <string>
+
+#include "trpc/codec/http/http_server_codec.h"
+#include "trpc/codec/http2/http2_protocol.h"
+
+namespace trpc {
+
+/// @brief HTTP/2 codec (server-side) which serves `HttpService` over HTTP/2.
+///
+/// Framing is done by the HTTP/2 session held by the stream handler of the connection (shared with gRPC), so that many
+/// requests are multiplexed on one connection. This codec only converts between the HTTP/2 messages of the session and
+/// the `http::Request`/`http::Response` seen by HTTP handlers.
+class Http2ServerCodec : public HttpServerCodec {
+ public:
+  ~Http2ServerCodec() override = default;
+
+  /// @brief Returns name of HTTP/2 codec.
+  std::string Name() const override { return kHttp2CodecName; }
+
+  /// @brief Requests are checked out by the HTTP/2 session of the connection instead.
+  int ZeroCopyCheck(const ConnectionPtr& conn, NoncontiguousBuffer& in, std::deque<std::any>& out) override {
+    return PacketChecker::PACKET_LESS;
+  }
+
+  /// @brief Decodes a HTTP request protocol message object from a complete HTTP/2 request.
+  ///
+  /// @param ctx is server context for decoding.
+  /// @param in is a complete HTTP/2 request checked out by the HTTP/2 session.
+  /// @param out is HTTP/2 request protocol message object.
+  /// @return Returns true on success, false otherwise.
+  bool ZeroCopyDecode(const ServerContextPtr& ctx, std::any&& in, ProtocolPtr& out) override;
+
+  /// @brief Builds the HTTP/2 response to be submitted to the HTTP/2 session from the HTTP response, nothing is written
+  /// into |out|.
+  ///
+  /// @param ctx is server context for encoding.
+  /// @param in  is HTTP/2 response protocol message object.
+  /// @param out is unused, the response is framed by the HTTP/2 session of the connection.
+  /// @return Returns true on success, false otherwise.
+  bool ZeroCopyEncode(const ServerContextPtr& ctx, ProtocolPtr& in, NoncontiguousBuffer& out) override;
+
+  /// @brief Creates a HTTP/2 request protocol object.
+  ProtocolPtr CreateRequestObject() override;
+
+  /// @brief Creates a HTTP/2 response protocol object.
+  ProtocolPtr CreateResponseObject() override;
+
+  /// @brief Extracts metadata of protocol message, HTTP/2 requests are always unary.
+  bool Pick(const std::any& message, std::any& data) const override { return true; }
+
+  /// @brief Reports whether it is streaming protocol.
+  bool IsStreamingProtocol() const override { return true; }
+};
+
+}  // namespace trpc
@@ -0,0 +1,154 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/codec/http2/http2_server_codec.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+#include "trpc/codec/grpc/grpc_stream_frame.h"
+#include "trpc/codec/grpc/http2/http2.h"
+#include "trpc/server/server_context.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc::testing {
+
+class Http2ServerCodecTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    codec_ = std::make_unique<Http2ServerCodec>();
+    context_ = MakeRefCounted<ServerContext>();
+    context_->SetRequestMsg(codec_->CreateRequestObject());
+    context_->SetResponseMsg(codec_->CreateResponseObject());
+  }
+
+ protected:
+  std::unique_ptr<Http2ServerCodec> codec_{nullptr};
+  ServerContextPtr context_;
+};
+
+TEST_F(Http2ServerCodecTest, Name) {
+  ASSERT_EQ("http2", codec_->Name());
+  ASSERT_TRUE(codec_->IsStreamingProtocol());
+}
+
+TEST_F(Http2ServerCodecTest, Decode) {
+  auto http2_request = http2::CreateRequest();
+  http2_request->SetStreamId(3);
+  http2_request->SetMethod("POST");
+  http2_request->SetScheme("http");
+  http2_request->SetPath("/hello?name=trpc");
+  http2_request->SetAuthority("127.0.0.1:8080");
+  http2_request->AddHeader("content-type", "application/json");
+  http2_request->SetContent("{}");
+
+  std::any in = stream::GrpcRequestPacket{std::move(http2_request), nullptr};
+  ASSERT_TRUE(codec_->ZeroCopyDecode(context_, std::move(in), context_->GetRequestMsg()));
+  ASSERT_EQ(3, context_->GetStreamId());
+
+  auto* req_msg = static_cast<Http2RequestProtocol*>(context_->GetRequestMsg().get());
+  const http::RequestPtr& req = req_msg->request;
+  ASSERT_EQ(req_msg->http2_request.get(), req.get());
+  ASSERT_EQ(http::MethodType::POST, req->GetMethodType());
+  ASSERT_EQ("/hello?name=trpc", req->GetUrl());
+  ASSERT_EQ("/hello", req->GetRouteUrl());
+  ASSERT_EQ("2.0", req->GetVersion());
+  ASSERT_EQ("127.0.0.1:8080", req->GetHeader("Host"));
+  ASSERT_EQ("application/json", req->GetHeader("Content-Type"));
+  ASSERT_EQ("{}", req->GetContent());
+}
+
+TEST_F(Http2ServerCodecTest, DecodeQuery) {
+  auto http2_request = http2::CreateRequest();
+  http2_request->SetStreamId(1);
+  http2_request->SetMethod("GET");
+  std::string path{"/hello%20world?name=trpc&lang=c%2B%2B"};
+  http2::SplitPath(path.begin(), path.end(), http2_request->GetMutableUriRef());
+
+  std::any in = stream::GrpcRequestPacket{std::move(http2_request), nullptr};
+  ASSERT_TRUE(codec_->ZeroCopyDecode(context_, std::move(in), context_->GetRequestMsg()));
+
+  const http::RequestPtr& req = static_cast<Http2RequestProtocol*>(context_->GetRequestMsg().get())->request;
+  ASSERT_EQ("/hello%20world?name=trpc&lang=c%2B%2B", req->GetUrl());
+  ASSERT_TRUE(req->InitQueryParameters());
+  ASSERT_EQ("trpc", req->GetQueryParameters().Get("name"));
+  ASSERT_EQ("c++", req->GetQueryParameters().Get("lang"));
+}
+
+TEST_F(Http2ServerCodecTest, DecodeHttp1Fallback) {
+  auto http_request = std::make_shared<http::Request>();
+  http_request->SetMethod("GET");
+  http_request->SetUrl("/hello");
+  http_request->SetVersion("1.1");
+
+  std::any in = http_request;
+  ASSERT_TRUE(codec_->ZeroCopyDecode(context_, std::move(in), context_->GetRequestMsg()));
+  ASSERT_EQ(0, context_->GetStreamId());
+
+  auto* req_msg = static_cast<Http2RequestProtocol*>(context_->GetRequestMsg().get());
+  ASSERT_EQ(http_request.get(), req_msg->request.get());
+  ASSERT_EQ(nullptr, req_msg->http2_request);
+
+  auto* rsp_msg = static_cast<Http2ResponseProtocol*>(context_->GetResponseMsg().get());
+  ASSERT_FALSE(rsp_msg->IsHttp2());
+  NoncontiguousBuffer out;
+  ASSERT_TRUE(codec_->ZeroCopyEncode(context_, context_->GetResponseMsg(), out));
+  ASSERT_EQ(0, out.ByteSize());
+  ASSERT_EQ(nullptr, rsp_msg->http2_response);
+}
+
+TEST_F(Http2ServerCodecTest, DecodeStreamFrame) {
+  std::any in = stream::GrpcRequestPacket{nullptr, nullptr};
+  ASSERT_FALSE(codec_->ZeroCopyDecode(context_, std::move(in), context_->GetRequestMsg()));
+}
+
+TEST_F(Http2ServerCodecTest, Encode) {
+  context_->SetStreamId(5);
+  auto* rsp_msg = static_cast<Http2ResponseProtocol*>(context_->GetResponseMsg().get());
+  http::Response& rsp = rsp_msg->response;
+  rsp.SetStatus(http::ResponseStatus::kCreated);
+  rsp.SetHeader("Content-Type", "text/plain");
+  rsp.SetHeader("Connection", "keep-alive");
+  rsp.SetHeader("Date", "Thu, 01 Jan 1970 00:00:00 GMT");
+  rsp.SetContent("hello world");
+
+  NoncontiguousBuffer out;
+  ASSERT_TRUE(codec_->ZeroCopyEncode(context_, context_->GetResponseMsg(), out));
+  ASSERT_EQ(0, out.ByteSize());
+
+  const http2::ResponsePtr& http2_response = rsp_msg->http2_response;
+  ASSERT_NE(nullptr, http2_response);
+  ASSERT_EQ(5, http2_response->GetStreamId());
+  ASSERT_EQ(http::ResponseStatus::kCreated, http2_response->GetStatus());
+  ASSERT_EQ("text/plain", http2_response->GetHeader("content-type"));
+  ASSERT_EQ("11", http2_response->GetHeader("content-length"));
+  ASSERT_FALSE(http2_response->HasHeader("connection"));
+  ASSERT_FALSE(http2_response->HasHeader("date"));
+  ASSERT_EQ("hello world", FlattenSlow(*http2_response->GetMutableNonContiguousBufferContent()));
+}
+
+TEST_F(Http2ServerCodecTest, EncodeHeaderOnly) {
+  auto* rsp_msg = static_cast<Http2ResponseProtocol*>(context_->GetResponseMsg().get());
+  rsp_msg->response.SetHeaderOnly(true);
+  rsp_msg->response.SetHeader("Content-Length", "11");
+
+  NoncontiguousBuffer out;
+  ASSERT_TRUE(codec_->ZeroCopyEncode(context_, context_->GetResponseMsg(), out));
+  ASSERT_EQ("11", rsp_msg->http2_response->GetHeader("content-length"));
+  ASSERT_EQ(0, rsp_msg->http2_response->GetMutableNonContiguousBufferContent()->ByteSize());
+}
+
+}  // namespace trpc::testing
@@ -14,11 +14,14 @@
 #include "trpc/codec/redis/redis_client_codec.h"
 
 #include <sstream>
+#include <utility>
+#include <vector>
 
 #include "trpc/client/redis/reply.h"
 #include "trpc/client/redis/request.h"
 #include "trpc/codec/redis/redis_proto_checker.h"
 #include "trpc/codec/redis/redis_protocol.h"
+#include "trpc/serialization/serialization_type.h"
 #include "trpc/util/log/logging.h"
 
 namespace trpc {
@@ -30,6 +33,16 @@ int32_t RedisClientCodec::ZeroCopyCheck(const ConnectionPtr& conn, Noncontiguous
 bool RedisClientCodec::FillRequest(const ClientContextPtr& context, const ProtocolPtr& in, void* body) {
   auto* redis_req_protocol = static_cast<RedisRequestProtocol*>(in.get());
 
+  if (context->GetReqEncodeDataType() == serialization::kRedisPipelineType) {
+    auto* redis_raw_reqs = static_cast<std::vector<redis::Request>*>(body);
+    if (redis_raw_reqs->empty()) {
+      TRPC_LOG_ERROR("Redis pipeline has no request");
+      return false;
+    }
+    redis_req_protocol->redis_reqs = std::move(*redis_raw_reqs);
+    return true;
+  }
+
   redis::Request* redis_raw_req = static_cast<redis::Request*>(body);
 
   redis_req_protocol->redis_req = std::move(*redis_raw_req);
@@ -59,6 +72,24 @@ bool RedisClientCodec::ZeroCopyDecode(const ClientContextPtr& context, std::any&
 
 bool RedisClientCodec::FillResponse(const ClientContextPtr& context, const ProtocolPtr& in, void* out) {
   auto* redis_rsp_protocol = static_cast<RedisResponseProtocol*>(in.get());
+
+  if (context->GetReqEncodeDataType() == serialization::kRedisPipelineType) {
+    // Replies of a pipeline are parsed into one array reply in request order, see `RedisZeroCopyCheckResponse`
+    auto* redis_raw_rsps = static_cast<std::vector<redis::Reply>*>(out);
+    redis::Reply& redis_rsp = redis_rsp_protocol->redis_rsp;
+    redis_raw_rsps->clear();
+    if (context->GetPipelineCount() > 1) {
+      if (!redis_rsp.IsArray() || redis_rsp.GetArray().size() != context->GetPipelineCount()) {
+        TRPC_FMT_ERROR("Redis pipeline expects {} replies", context->GetPipelineCount());
+        return false;
+      }
+      *redis_raw_rsps = std::move(std::get<std::vector<redis::Reply>>(redis_rsp.u_));
+    } else {
+      redis_raw_rsps->emplace_back(std::move(redis_rsp));
+    }
+    return true;
+  }
+
   redis::Reply* redis_raw_rsp = static_cast<redis::Reply*>(out);
 
   *redis_raw_rsp = std::move(redis_rsp_protocol->redis_rsp);
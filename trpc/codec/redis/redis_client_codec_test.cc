@@ -19,6 +19,7 @@
 #include "trpc/client/redis/reply.h"
 #include "trpc/client/redis/request.h"
 #include "trpc/codec/redis/redis_protocol.h"
+#include "trpc/serialization/serialization_type.h"
 
 namespace trpc {
 
@@ -113,6 +114,41 @@ TEST_F(RedisClientCodecTest, Check) {
   EXPECT_EQ(0, static_cast<int32_t>(result));
 }
 
+TEST_F(RedisClientCodecTest, Pipeline) {
+  ClientContextPtr ctx = MakeRefCounted<ClientContext>();
+  ctx->SetReqEncodeDataType(serialization::kRedisPipelineType);
+  ctx->SetPipelineCount(2);
+
+  std::vector<redis::Request> reqs(2);
+  reqs[0].params_ = {"GET", "trpc"};
+  reqs[1].params_ = {"GET", "redis"};
+  ProtocolPtr req_protocol = codec_.CreateRequestPtr();
+  EXPECT_TRUE(codec_.FillRequest(ctx, req_protocol, reinterpret_cast<void*>(&reqs)));
+  EXPECT_EQ(2, static_cast<RedisRequestProtocol*>(req_protocol.get())->redis_reqs.size());
+
+  std::vector<redis::Request> empty_reqs;
+  EXPECT_FALSE(codec_.FillRequest(ctx, codec_.CreateRequestPtr(), reinterpret_cast<void*>(&empty_reqs)));
+
+  std::vector<redis::Reply> replies;
+  replies.emplace_back(redis::StringReplyMarker{}, "trpc");
+  replies.emplace_back(redis::NilReplyMarker{});
+  ProtocolPtr rsp_protocol = codec_.CreateResponsePtr();
+  EXPECT_TRUE(codec_.ZeroCopyDecode(ctx, redis::Reply(redis::ArrayReplyMarker{}, std::move(replies)), rsp_protocol));
+  std::vector<redis::Reply> reps;
+  EXPECT_TRUE(codec_.FillResponse(ctx, rsp_protocol, reinterpret_cast<void*>(&reps)));
+  ASSERT_EQ(2, reps.size());
+  EXPECT_EQ("trpc", reps[0].GetString());
+  EXPECT_TRUE(reps[1].IsNil());
+
+  // A single request of a pipeline is answered by a single reply.
+  ctx->SetPipelineCount(1);
+  rsp_protocol = codec_.CreateResponsePtr();
+  EXPECT_TRUE(codec_.ZeroCopyDecode(ctx, redis::Reply(redis::StringReplyMarker{}, "trpc"), rsp_protocol));
+  EXPECT_TRUE(codec_.FillResponse(ctx, rsp_protocol, reinterpret_cast<void*>(&reps)));
+  ASSERT_EQ(1, reps.size());
+  EXPECT_EQ("trpc", reps[0].GetString());
+}
+
 }  // namespace testing
 
 }  // namespace trpc
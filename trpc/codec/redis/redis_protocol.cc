@@ -19,34 +19,49 @@
 namespace trpc {
 
 bool RedisRequestProtocol::ZeroCopyEncode(NoncontiguousBuffer& buff) {
+  NoncontiguousBufferBuilder builder;
+  // All requests of a pipeline go out in one buffer, so they are written to the connection at once
+  if (!redis_reqs.empty()) {
+    for (const auto& req : redis_reqs) {
+      if (!req.do_RESP_) {
+        builder.Append(req.params_.front().c_str(), req.params_.front().size());
+      } else {
+        AppendRespRequest(req, builder);
+      }
+    }
+    buff = builder.DestructiveGet();
+    return true;
+  }
   // Redis command has already been encoded once and can be directly copied and used when redis_req->do_RESP_ == false
   if (!redis_req.do_RESP_) {
     auto itr = redis_req.params_.begin();
     size_t cmd_size = itr->size();
-    NoncontiguousBufferBuilder builder;
     builder.Append(itr->c_str(), cmd_size);
     buff = builder.DestructiveGet();
     return true;
   }
-  NoncontiguousBufferBuilder builder;
   return EncodeImpl(builder, buff);
 }
 
 bool RedisRequestProtocol::EncodeImpl(NoncontiguousBufferBuilder& builder, NoncontiguousBuffer& buff) const {
+  AppendRespRequest(redis_req, builder);
+  buff = builder.DestructiveGet();
+  return true;
+}
+
+void RedisRequestProtocol::AppendRespRequest(const redis::Request& req, NoncontiguousBufferBuilder& builder) {
   size_t buff_size = 0;
   char tmp_buff[16] = {0};
-  snprintf(tmp_buff, sizeof(tmp_buff), "*%u\r\n", static_cast<uint32_t>(redis_req.params_.size()));
+  snprintf(tmp_buff, sizeof(tmp_buff), "*%u\r\n", static_cast<uint32_t>(req.params_.size()));
   buff_size = strlen(tmp_buff);
   builder.Append(tmp_buff, buff_size);
-  for (auto& r : redis_req.params_) {
+  for (auto& r : req.params_) {
     snprintf(tmp_buff, sizeof(tmp_buff), "$%u\r\n", static_cast<uint32_t>(r.size()));
     buff_size = strlen(tmp_buff);
     builder.Append(tmp_buff, buff_size);
     builder.Append(r.c_str(), r.size());
     builder.Append("\r\n", 2);
   }
-  buff = builder.DestructiveGet();
-  return true;
 }
 
 }  // namespace trpc
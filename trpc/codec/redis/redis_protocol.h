@@ -15,6 +15,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "trpc/client/redis/reply.h"
 #include "trpc/client/redis/request.h"
@@ -45,9 +46,15 @@ class RedisRequestProtocol : public trpc::Protocol {
   /// @private For internal use purpose only.
   bool EncodeImpl(NoncontiguousBufferBuilder& builder, NoncontiguousBuffer& buff) const;
 
+ private:
+  static void AppendRespRequest(const redis::Request& req, NoncontiguousBufferBuilder& builder);
+
  public:
   // Header of redis request protocol
   redis::Request redis_req;
+
+  // Requests of a pipeline call, encoded back to back into one buffer when not empty, `redis_req` is unused then
+  std::vector<redis::Request> redis_reqs;
 };
 
 /// @brief Redis response protocol message is mainly used to package the redis::Reply to make the code consistent
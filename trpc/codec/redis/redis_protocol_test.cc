@@ -86,6 +86,21 @@ TEST_F(RedisProtocolTest, RequestTest) {
   ASSERT_STREQ(out_one_str.c_str(), "SET");
 }
 
+TEST_F(RedisProtocolTest, PipelineRequestTest) {
+  RedisRequestProtocol redis_req_protocol = RedisRequestProtocol();
+  redis_req_protocol.redis_reqs.resize(2);
+  redis_req_protocol.redis_reqs[0].params_ = {"SET", "trpc", "redis"};
+  redis_req_protocol.redis_reqs[1].do_RESP_ = false;
+  redis_req_protocol.redis_reqs[1].params_ = {"*2\r\n$3\r\nGET\r\n$4\r\ntrpc\r\n"};
+
+  NoncontiguousBuffer buff;
+  ASSERT_TRUE(redis_req_protocol.ZeroCopyEncode(buff));
+  ASSERT_EQ(
+      "*3\r\n$3\r\nSET\r\n$4\r\ntrpc\r\n$5\r\nredis\r\n"
+      "*2\r\n$3\r\nGET\r\n$4\r\ntrpc\r\n",
+      FlattenSlow(buff));
+}
+
 TEST_F(RedisProtocolTest, ResponseTest) {
   RedisResponseProtocol redis_rsp_protocol = RedisResponseProtocol();
   redis_rsp_protocol.redis_rsp = rsp_;
@@ -143,7 +143,7 @@ bool TrpcRequestProtocol::ZeroCopyEncode(NoncontiguousBuffer& buff) {
   fixed_header.data_frame_size =
       TrpcFixedHeader::TRPC_PROTO_PREFIX_SPACE + pb_header_size + req_body.ByteSize() + req_attachment.ByteSize();
 
-  NoncontiguousBufferBuilder builder;
+  NoncontiguousBufferBuilder builder(TrpcFixedHeader::TRPC_PROTO_PREFIX_SPACE + pb_header_size);
   auto* unaligned_header = builder.Reserve(TrpcFixedHeader::TRPC_PROTO_PREFIX_SPACE);
   if (!fixed_header.Encode(unaligned_header)) {
     TRPC_LOG_ERROR("Encode fixed_header error.");
@@ -218,7 +218,7 @@ bool TrpcResponseProtocol::ZeroCopyEncode(NoncontiguousBuffer& buff) {
   fixed_header.data_frame_size = buff_size;
   fixed_header.pb_header_size = rsp_header_size;
 
-  NoncontiguousBufferBuilder builder;
+  NoncontiguousBufferBuilder builder(TrpcFixedHeader::TRPC_PROTO_PREFIX_SPACE + rsp_header_size);
   auto* unaligned_header = builder.Reserve(TrpcFixedHeader::TRPC_PROTO_PREFIX_SPACE);
   if (TRPC_UNLIKELY(!fixed_header.Encode(unaligned_header))) {
     TRPC_LOG_ERROR("Encode fixed_header error.");
@@ -350,7 +350,7 @@ bool TrpcStreamInitFrameProtocol::ZeroCopyEncode(NoncontiguousBuffer& buffer) {
     return false;
   }
   fixed_header.data_frame_size = ByteSizeLong();
-  NoncontiguousBufferBuilder builder;
+  NoncontiguousBufferBuilder builder(fixed_header.data_frame_size);
   if (!EncodeStreamFrame(fixed_header, stream_init_metadata, &builder)) {
     return false;
   }
@@ -380,7 +380,7 @@ bool TrpcStreamDataFrameProtocol::ZeroCopyEncode(NoncontiguousBuffer& buffer) {
     return false;
   }
   fixed_header.data_frame_size = ByteSizeLong();
-  NoncontiguousBufferBuilder builder;
+  NoncontiguousBufferBuilder builder(fixed_header.ByteSizeLong());
   auto* header_buffer = builder.Reserve(fixed_header.ByteSizeLong());
   if (TRPC_UNLIKELY(!fixed_header.Encode(header_buffer))) {
     TRPC_LOG_ERROR("encode fixed header of stream frame failed");
@@ -414,7 +414,7 @@ bool TrpcStreamFeedbackFrameProtocol::ZeroCopyEncode(NoncontiguousBuffer& buffer
     return false;
   }
   fixed_header.data_frame_size = ByteSizeLong();
-  NoncontiguousBufferBuilder builder;
+  NoncontiguousBufferBuilder builder(fixed_header.data_frame_size);
   if (!EncodeStreamFrame(fixed_header, stream_feedback_metadata, &builder)) {
     return false;
   }
@@ -445,7 +445,7 @@ bool TrpcStreamCloseFrameProtocol::ZeroCopyEncode(NoncontiguousBuffer& buffer) {
     return false;
   }
   fixed_header.data_frame_size = ByteSizeLong();
-  NoncontiguousBufferBuilder builder;
+  NoncontiguousBufferBuilder builder(fixed_header.data_frame_size);
   if (!EncodeStreamFrame(fixed_header, stream_close_metadata, &builder)) {
     return false;
   }
@@ -66,6 +66,10 @@ struct ServiceProxyConfig {
   /// if memory usage high, reduce it
   uint32_t fiber_pipeline_connector_queue_size = 16 * 1024;
 
+  /// The expected max number of in-flight calls per connection of fiber complex/pipeline connectors, which sizes
+  /// their call tables (16 bytes per call), calls beyond it are kept in a slower overflow map
+  uint32_t fiber_max_inflight_calls_per_conn = 1024;
+
   /// The timeout(ms) of check connection establishment
   /// If set 0, not check
   uint32_t connect_timeout{kDefaultConnectTimeout};
@@ -35,6 +35,7 @@ struct convert<trpc::ServiceProxyConfig> {
     node["is_conn_complex"] = proxy_config.is_conn_complex;
     node["support_pipeline"] = proxy_config.support_pipeline;
     node["fiber_pipeline_connector_queue_size"] = proxy_config.fiber_pipeline_connector_queue_size;
+    node["fiber_max_inflight_calls_per_conn"] = proxy_config.fiber_max_inflight_calls_per_conn;
     node["connect_timeout"] = proxy_config.connect_timeout;
     node["timeout"] = proxy_config.timeout;
     node["request_timeout_check_interval"] = proxy_config.request_timeout_check_interval;
@@ -64,6 +65,10 @@ struct convert<trpc::ServiceProxyConfig> {
     if (iter != filter_configs.end()) {
       node["filter_config"][iter->first] = std::any_cast<trpc::RetryHedgingLimitConfig>(iter->second);
     }
+    iter = filter_configs.find(trpc::kAdaptiveBackupRequestFilter);
+    if (iter != filter_configs.end()) {
+      node["filter_config"][iter->first] = std::any_cast<trpc::AdaptiveBackupRequestConfig>(iter->second);
+    }
 
     node["ssl"] = proxy_config.ssl_config;
 
@@ -89,6 +94,10 @@ struct convert<trpc::ServiceProxyConfig> {
       auto queue_size = node["fiber_pipeline_connector_queue_size"].as<uint32_t>();
       proxy_config.fiber_pipeline_connector_queue_size = queue_size > 0 ? queue_size : 16 * 1024;
     }
+    if (node["fiber_max_inflight_calls_per_conn"]) {
+      auto max_inflight_calls = node["fiber_max_inflight_calls_per_conn"].as<uint32_t>();
+      proxy_config.fiber_max_inflight_calls_per_conn = max_inflight_calls > 0 ? max_inflight_calls : 1024;
+    }
     if (node["connect_timeout"]) proxy_config.connect_timeout = node["connect_timeout"].as<uint32_t>();
     if (node["timeout"]) proxy_config.timeout = node["timeout"].as<uint32_t>();
     if (node["request_timeout_check_interval"]) {
@@ -132,6 +141,11 @@ struct convert<trpc::ServiceProxyConfig> {
             node["filter_config"][trpc::kRetryHedgingLimitFilter].as<trpc::RetryHedgingLimitConfig>();
         proxy_config.service_filter_configs[trpc::kRetryHedgingLimitFilter] = retry_hedging_config;
       }
+      if (node["filter_config"][trpc::kAdaptiveBackupRequestFilter]) {
+        auto adaptive_backup_request_config =
+            node["filter_config"][trpc::kAdaptiveBackupRequestFilter].as<trpc::AdaptiveBackupRequestConfig>();
+        proxy_config.service_filter_configs[trpc::kAdaptiveBackupRequestFilter] = adaptive_backup_request_config;
+      }
     }
 
     if (node["redis"]) {
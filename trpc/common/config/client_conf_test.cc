@@ -55,6 +55,7 @@ TEST(ClientConfigTest, All) {
 
   proxy_config.redis_conf.password = "my_redis";
   proxy_config.redis_conf.enable = true;
+  proxy_config.redis_conf.cluster = true;
 
   RetryHedgingLimitConfig retry_hedging_config;
   retry_hedging_config.max_tokens = 10;
@@ -107,6 +108,7 @@ TEST(ClientConfigTest, All) {
   ASSERT_EQ(proxy_config.redis_conf.enable, tmp_proxy_config.redis_conf.enable);
   ASSERT_EQ(proxy_config.redis_conf.user_name, tmp_proxy_config.redis_conf.user_name);
   ASSERT_EQ(proxy_config.redis_conf.password, tmp_proxy_config.redis_conf.password);
+  ASSERT_EQ(proxy_config.redis_conf.cluster, tmp_proxy_config.redis_conf.cluster);
 
   auto tmp_retry_hedging_config = std::any_cast<RetryHedgingLimitConfig>(
       tmp_proxy_config.service_filter_configs[kRetryHedgingLimitFilter]);
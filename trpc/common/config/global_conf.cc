@@ -59,6 +59,9 @@ void FiberThreadModelInstanceConfig::Display() const {
   TRPC_LOG_DEBUG("fiber_worker_disallow_cpu_migration:" << fiber_worker_disallow_cpu_migration);
   TRPC_LOG_DEBUG("work_stealing_ratio:" << work_stealing_ratio);
   TRPC_LOG_DEBUG("reactor_num_per_scheduling_group:" << reactor_num_per_scheduling_group);
+  TRPC_LOG_DEBUG("reactor_poller_type:" << reactor_poller_type);
+  TRPC_LOG_DEBUG("reactor_io_uring_entries:" << reactor_io_uring_entries);
+  TRPC_LOG_DEBUG("reactor_io_uring_flags:" << reactor_io_uring_flags);
   TRPC_LOG_DEBUG("cross_numa_work_stealing_ratio:" << cross_numa_work_stealing_ratio);
   TRPC_LOG_DEBUG("fiber_run_queue_size:" << fiber_run_queue_size);
   TRPC_LOG_DEBUG("fiber_stack_size:" << fiber_stack_size);
@@ -103,6 +106,26 @@ void BufferPoolConfig::Display() const {
   TRPC_LOG_DEBUG("================================");
 }
 
+void UdpIoConfig::Display() const {
+  TRPC_LOG_DEBUG("================================");
+
+  TRPC_LOG_DEBUG("recv_batch_size:" << recv_batch_size);
+  TRPC_LOG_DEBUG("send_batch_size:" << send_batch_size);
+  TRPC_LOG_DEBUG("enable_gso:" << enable_gso);
+  TRPC_LOG_DEBUG("enable_gro:" << enable_gro);
+
+  TRPC_LOG_DEBUG("================================");
+}
+
+void ZeroCopySendConfig::Display() const {
+  TRPC_LOG_DEBUG("================================");
+
+  TRPC_LOG_DEBUG("enable:" << enable);
+  TRPC_LOG_DEBUG("min_bytes:" << min_bytes);
+
+  TRPC_LOG_DEBUG("================================");
+}
+
 void TvarConfig::Display() const {
   TRPC_LOG_DEBUG("================================");
 
@@ -153,6 +176,10 @@ void GlobalConfig::Display() const {
 
   buffer_pool_config.Display();
 
+  udp_io_config.Display();
+
+  zero_copy_send_config.Display();
+
   TRPC_LOG_DEBUG("=============global==============");
 }
 
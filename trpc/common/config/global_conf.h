@@ -71,6 +71,19 @@ struct FiberThreadModelInstanceConfig {
   /// @brief The size of fiber reactor task queue
   uint32_t reactor_task_queue_size{65536};
 
+  /// @brief Io multiplexing implementation of fiber reactor
+  /// epoll: default
+  /// io_uring_poll: readiness notification by io_uring multishot poll requests, sockets are still read and written by
+  ///                readv/writev; need to compile with `trpc_include_async_io` and kernel 5.13+, otherwise falls back
+  ///                to epoll
+  std::string reactor_poller_type{"epoll"};
+
+  /// @brief Io_uring queue size of fiber reactor, used when `reactor_poller_type` is io_uring_poll
+  uint32_t reactor_io_uring_entries{1024};
+
+  /// @brief Io_uring initilize flag of fiber reactor, used when `reactor_poller_type` is io_uring_poll
+  uint32_t reactor_io_uring_flags{0};
+
   /// @brief The size of fiber running queue
   uint32_t fiber_run_queue_size{131072};
 
@@ -200,6 +213,34 @@ struct BufferPoolConfig {
   void Display() const;
 };
 
+/// @brief Related configuration of udp batch io within the framework
+struct UdpIoConfig {
+  /// @brief The maximum number of datagrams received by one `recvmmsg` call, in range [1, 64]
+  uint32_t recv_batch_size{16};
+
+  /// @brief The maximum number of datagrams sent by one `sendmmsg` call, in range [1, 64]
+  uint32_t send_batch_size{16};
+
+  /// @brief Whether to coalesce datagrams of the same size to the same peer with UDP GSO (Linux 4.18+)
+  bool enable_gso{true};
+
+  /// @brief Whether to receive coalesced datagrams with UDP GRO (Linux 5.0+)
+  bool enable_gro{true};
+
+  void Display() const;
+};
+
+/// @brief Related configuration of zero-copy send (MSG_ZEROCOPY) on tcp connections within the framework
+struct ZeroCopySendConfig {
+  /// @brief Whether to send large writes with MSG_ZEROCOPY (Linux 4.14+)
+  bool enable{false};
+
+  /// @brief Writes smaller than this are copied as usual
+  uint32_t min_bytes{64 * 1024};
+
+  void Display() const;
+};
+
 /// @brief Configurations for tvar.
 /// @note p999 and p9999 will be recorded by default, still open three percentages to users.
 struct TvarConfig {
@@ -295,6 +336,12 @@ struct GlobalConfig {
   /// @brief Related configuration of buffer pool within the framework
   BufferPoolConfig buffer_pool_config;
 
+  /// @brief Related configuration of udp batch io within the framework
+  UdpIoConfig udp_io_config;
+
+  /// @brief Related configuration of zero-copy send within the framework
+  ZeroCopySendConfig zero_copy_send_config;
+
   /// @brief Tvar config
   TvarConfig tvar_config;
 
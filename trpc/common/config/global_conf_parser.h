@@ -38,6 +38,9 @@ struct convert<trpc::FiberThreadModelInstanceConfig> {
     node["work_stealing_ratio"] = config.work_stealing_ratio;
     node["reactor_num_per_scheduling_group"] = config.reactor_num_per_scheduling_group;
     node["reactor_task_queue_size"] = config.reactor_task_queue_size;
+    node["reactor_poller_type"] = config.reactor_poller_type;
+    node["reactor_io_uring_entries"] = config.reactor_io_uring_entries;
+    node["reactor_io_uring_flags"] = config.reactor_io_uring_flags;
     node["cross_numa_work_stealing_ratio"] = config.cross_numa_work_stealing_ratio;
     node["fiber_run_queue_size"] = config.fiber_run_queue_size;
     node["fiber_stack_size"] = config.fiber_stack_size;
@@ -86,6 +89,18 @@ struct convert<trpc::FiberThreadModelInstanceConfig> {
       config.reactor_task_queue_size = node["reactor_task_queue_size"].as<uint32_t>();
     }
 
+    if (node["reactor_poller_type"]) {
+      config.reactor_poller_type = node["reactor_poller_type"].as<std::string>();
+    }
+
+    if (node["reactor_io_uring_entries"]) {
+      config.reactor_io_uring_entries = node["reactor_io_uring_entries"].as<uint32_t>();
+    }
+
+    if (node["reactor_io_uring_flags"]) {
+      config.reactor_io_uring_flags = node["reactor_io_uring_flags"].as<uint32_t>();
+    }
+
     if (node["cross_numa_work_stealing_ratio"]) {
       config.cross_numa_work_stealing_ratio = node["cross_numa_work_stealing_ratio"].as<uint32_t>();
     }
@@ -263,6 +278,54 @@ struct convert<trpc::HeartbeatConfig> {
   }
 };
 
+template <>
+struct convert<trpc::UdpIoConfig> {
+  static YAML::Node encode(const trpc::UdpIoConfig& config) {
+    YAML::Node node;
+    node["recv_batch_size"] = config.recv_batch_size;
+    node["send_batch_size"] = config.send_batch_size;
+    node["enable_gso"] = config.enable_gso;
+    node["enable_gro"] = config.enable_gro;
+    return node;
+  }
+
+  static bool decode(const YAML::Node& node, trpc::UdpIoConfig& config) {
+    if (node["recv_batch_size"]) {
+      config.recv_batch_size = node["recv_batch_size"].as<uint32_t>();
+    }
+    if (node["send_batch_size"]) {
+      config.send_batch_size = node["send_batch_size"].as<uint32_t>();
+    }
+    if (node["enable_gso"]) {
+      config.enable_gso = node["enable_gso"].as<bool>();
+    }
+    if (node["enable_gro"]) {
+      config.enable_gro = node["enable_gro"].as<bool>();
+    }
+    return true;
+  }
+};
+
+template <>
+struct convert<trpc::ZeroCopySendConfig> {
+  static YAML::Node encode(const trpc::ZeroCopySendConfig& config) {
+    YAML::Node node;
+    node["enable"] = config.enable;
+    node["min_bytes"] = config.min_bytes;
+    return node;
+  }
+
+  static bool decode(const YAML::Node& node, trpc::ZeroCopySendConfig& config) {
+    if (node["enable"]) {
+      config.enable = node["enable"].as<bool>();
+    }
+    if (node["min_bytes"]) {
+      config.min_bytes = node["min_bytes"].as<uint32_t>();
+    }
+    return true;
+  }
+};
+
 template <>
 struct convert<trpc::BufferPoolConfig> {
   static YAML::Node encode(const trpc::BufferPoolConfig& config) {
@@ -414,6 +477,8 @@ struct convert<trpc::GlobalConfig> {
     node["threadmodel"] = global_config.threadmodel_config;
     node["heartbeat"] = global_config.heartbeat_config;
     node["buffer_pool"] = global_config.buffer_pool_config;
+    node["udp_io"] = global_config.udp_io_config;
+    node["zero_copy_send"] = global_config.zero_copy_send_config;
     node["tvar"] = global_config.tvar_config;
     node["rpcz"] = global_config.rpcz_config;
 
@@ -488,6 +553,14 @@ struct convert<trpc::GlobalConfig> {
       global_config.buffer_pool_config = node["buffer_pool"].as<trpc::BufferPoolConfig>();
     }
 
+    if (node["udp_io"]) {
+      global_config.udp_io_config = node["udp_io"].as<trpc::UdpIoConfig>();
+    }
+
+    if (node["zero_copy_send"]) {
+      global_config.zero_copy_send_config = node["zero_copy_send"].as<trpc::ZeroCopySendConfig>();
+    }
+
     if (node["tvar"]) {
       global_config.tvar_config = node["tvar"].as<trpc::TvarConfig>();
     }
@@ -23,6 +23,8 @@ void LoadBalanceConfig::Display() const {
   TRPC_FMT_DEBUG("hash_nodes:{}", hash_nodes);
   TRPC_FMT_DEBUG("hash_args size:{}", hash_args.size());
   TRPC_FMT_DEBUG("hash_func:{}", hash_func);
+  TRPC_FMT_DEBUG("ewma_decay_time_ms:{}", ewma_decay_time_ms);
+  TRPC_FMT_DEBUG("failure_penalty_ms:{}", failure_penalty_ms);
 
   TRPC_FMT_DEBUG("--------------------------------------");
 }
@@ -28,6 +28,10 @@ struct LoadBalanceConfig {
   std::vector<uint32_t> hash_args{0};
   /// @brief hash function when load balance algorithm is hash
   std::string hash_func{"murmur3"};
+  /// @brief decay time of the peak EWMA latency of each endpoint when load balance algorithm is p2c, in milliseconds
+  uint32_t ewma_decay_time_ms{10000};
+  /// @brief latency charged to failed invocations when load balance algorithm is p2c, in milliseconds
+  uint32_t failure_penalty_ms{1000};
 
   /// @brief Print out the logger configuration.
   void Display() const;
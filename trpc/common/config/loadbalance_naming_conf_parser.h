@@ -25,6 +25,8 @@ struct convert<trpc::naming::LoadBalanceConfig> {
     node["hash_nodes"] = config.hash_nodes;
     node["hash_args"] = config.hash_args;
     node["hash_func"] = config.hash_func;
+    node["ewma_decay_time_ms"] = config.ewma_decay_time_ms;
+    node["failure_penalty_ms"] = config.failure_penalty_ms;
     return node;
   }
 
@@ -38,6 +40,12 @@ struct convert<trpc::naming::LoadBalanceConfig> {
     if (node["hash_func"]) {
       config.hash_func = node["hash_func"].as<std::string>();
     }
+    if (node["ewma_decay_time_ms"]) {
+      config.ewma_decay_time_ms = node["ewma_decay_time_ms"].as<uint32_t>();
+    }
+    if (node["failure_penalty_ms"]) {
+      config.failure_penalty_ms = node["failure_penalty_ms"].as<uint32_t>();
+    }
     return true;
   }
 };
@@ -21,6 +21,7 @@ void RedisClientConf::Display() const {
   TRPC_LOG_DEBUG("redis_password:" << password);
   TRPC_LOG_DEBUG("redis user name:" << user_name);
   TRPC_LOG_DEBUG("redis_db:" << db);
+  TRPC_LOG_DEBUG("redis_cluster:" << cluster);
 }
 
 }  // namespace trpc
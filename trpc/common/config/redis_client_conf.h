@@ -35,6 +35,9 @@ struct RedisClientConf {
   /// @brief Whether enable auth
   bool enable{false};
 
+  /// @brief Whether the backend is a redis cluster, commands are routed to the owning node of their keys then
+  bool cluster{false};
+
   void Display() const;
 };
 
@@ -26,6 +26,7 @@ struct convert<trpc::RedisClientConf> {
     node["password"] = redis_conf.password;
     node["user_name"] = redis_conf.user_name;
     node["db"] = redis_conf.db;
+    node["cluster"] = redis_conf.cluster;
     return node;
   }
 
@@ -39,6 +40,9 @@ struct convert<trpc::RedisClientConf> {
     if (node["db"]) {
       redis_conf.db = node["db"].as<uint32_t>();
     }
+    if (node["cluster"]) {
+      redis_conf.cluster = node["cluster"].as<bool>();
+    }
     return true;
   }
 };
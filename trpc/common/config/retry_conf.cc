@@ -22,4 +22,11 @@ void RetryHedgingLimitConfig::Display() const {
   TRPC_LOG_DEBUG("token_ratio:" << token_ratio);
 }
 
+void AdaptiveBackupRequestConfig::Display() const {
+  TRPC_LOG_DEBUG("percentile:" << percentile);
+  TRPC_LOG_DEBUG("max_backup_ratio:" << max_backup_ratio);
+  TRPC_LOG_DEBUG("window_ms:" << window_ms);
+  TRPC_LOG_DEBUG("min_samples:" << min_samples);
+}
+
 }  // namespace trpc
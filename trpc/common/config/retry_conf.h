@@ -20,6 +20,7 @@ namespace trpc {
 constexpr char kRetryHedgingLimitFilter[] = "retry_hedging_limit";
 constexpr int kDefaultRetryHedgingTokensNum = 100;
 constexpr int kDefaultRetryHedgingTokenRatio = 10;
+constexpr char kAdaptiveBackupRequestFilter[] = "adaptive_backup_request";
 
 /// @brief Thresholds related to the retry hedging and rate limiting strategy.
 struct RetryHedgingLimitConfig {
@@ -32,4 +33,18 @@ struct RetryHedgingLimitConfig {
   void Display() const;
 };
 
+/// @brief Configuration of the adaptive backup request, whose resend time follows the latency of the callee.
+struct AdaptiveBackupRequestConfig {
+  /// The percentile of the recent latency used as the resend time, in (0, 100).
+  double percentile{95};
+  /// The maximum ratio of backup requests to calls, the budget of extra requests, in [0, 1].
+  double max_backup_ratio{0.05};
+  /// The latency is tracked over the last two windows of this length, in milliseconds.
+  uint32_t window_ms{1000};
+  /// The minimum number of latency samples in the last two windows, backup requests are not issued below it.
+  uint32_t min_samples{100};
+
+  void Display() const;
+};
+
 }  // namespace trpc
@@ -39,4 +39,32 @@ struct convert<trpc::RetryHedgingLimitConfig> {
   }
 };
 
+template <>
+struct convert<trpc::AdaptiveBackupRequestConfig> {
+  static YAML::Node encode(const trpc::AdaptiveBackupRequestConfig& config) {
+    YAML::Node node;
+    node["percentile"] = config.percentile;
+    node["max_backup_ratio"] = config.max_backup_ratio;
+    node["window_ms"] = config.window_ms;
+    node["min_samples"] = config.min_samples;
+    return node;
+  }
+
+  static bool decode(const YAML::Node& node, trpc::AdaptiveBackupRequestConfig& config) {  // NOLINT
+    if (node["percentile"]) {
+      config.percentile = node["percentile"].as<double>();
+    }
+    if (node["max_backup_ratio"]) {
+      config.max_backup_ratio = node["max_backup_ratio"].as<double>();
+    }
+    if (node["window_ms"]) {
+      config.window_ms = node["window_ms"].as<uint32_t>();
+    }
+    if (node["min_samples"]) {
+      config.min_samples = node["min_samples"].as<uint32_t>();
+    }
+    return true;
+  }
+};
+
 }  // namespace YAML
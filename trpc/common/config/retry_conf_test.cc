@@ -31,4 +31,20 @@ TEST(RetryHedgingLimitConfig, Parse) {
   ASSERT_EQ(2, node["token_ratio"].as<int>());
 }
 
+TEST(AdaptiveBackupRequestConfig, Parse) {
+  YAML::Node node;
+  node["percentile"] = 99;
+  node["max_backup_ratio"] = 0.1;
+  node["window_ms"] = 500;
+  node["min_samples"] = 10;
+
+  trpc::AdaptiveBackupRequestConfig config;
+  ASSERT_TRUE(YAML::convert<trpc::AdaptiveBackupRequestConfig>::decode(node, config));
+  node = YAML::convert<trpc::AdaptiveBackupRequestConfig>::encode(config);
+  ASSERT_EQ(99, node["percentile"].as<double>());
+  ASSERT_EQ(0.1, node["max_backup_ratio"].as<double>());
+  ASSERT_EQ(500, node["window_ms"].as<uint32_t>());
+  ASSERT_EQ(10, node["min_samples"].as<uint32_t>());
+}
+
 }  // namespace trpc::testing
@@ -32,6 +32,15 @@ std::string SslConfig::ToString() const {
     oss << *iter;
     if (iter != protocols.end() -1) oss << ", ";
   }
+  oss << std::endl << "ssl_alpn_protocols:" << std::endl;
+  for (auto iter = alpn_protocols.begin(); iter != alpn_protocols.end(); iter++) {
+    oss << *iter;
+    if (iter != alpn_protocols.end() - 1) oss << ", ";
+  }
+  oss << std::endl << "ssl_session_resumption:" << session_resumption << std::endl;
+  oss << "ssl_session_cache_size:" << session_cache_size << std::endl;
+  oss << "ssl_session_timeout:" << session_timeout << std::endl;
+  oss << "ssl_ktls:" << ktls;
   return oss.str();
 }
 
@@ -47,6 +56,7 @@ void ServerSslConfig::Display() const {
   TRPC_LOG_DEBUG("--------------------------------");
   TRPC_LOG_DEBUG(SslConfig::ToString());
   TRPC_LOG_DEBUG("mutual_auth" << mutual_auth);
+  TRPC_LOG_DEBUG("ssl_session_ticket_key_rotation_interval:" << session_ticket_key_rotation_interval);
   TRPC_LOG_DEBUG("--------------------------------");
 }
 
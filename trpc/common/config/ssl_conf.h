@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -42,6 +43,22 @@ struct SslConfig {
   /// Protocols of SSL/TLS, e.g, ["SSLv3", "TSLv1", ... , "TLSv1.2"]
   std::vector<std::string> protocols;
 
+  /// Application protocols negotiated by ALPN in preference order, e.g, ["h2", "http/1.1"].
+  /// Defaults to ["h2"] for grpc/http2 protocol when it is empty.
+  std::vector<std::string> alpn_protocols;
+
+  /// Resume previous sessions by session cache and session tickets to skip the full handshake.
+  bool session_resumption{true};
+
+  /// Maximum number of sessions cached, the client caches the latest session of each peer.
+  uint32_t session_cache_size{20480};
+
+  /// Lifetime of sessions(and session tickets) in seconds.
+  uint32_t session_timeout{300};
+
+  /// Offload encryption of records to kernel(kTLS) after handshaking, falls back to user-space TLS if unsupported.
+  bool ktls{false};
+
   /// @brief Display content of struct
   std::string ToString() const;
 };
@@ -66,6 +83,12 @@ struct SslConfig {
 ///               - TLSv1.1
 ///               - TLSv1.2
 ///               - TLSv1.3
+///           alpn_protocols:
+///               - h2
+///           session_resumption: { true, false }
+///           session_cache_size: 20480
+///           session_timeout: 300
+///           ktls: { true, false }
 /// ...
 ///
 struct ClientSslConfig : public SslConfig {
@@ -100,12 +123,22 @@ struct ClientSslConfig : public SslConfig {
 ///               - TLSv1.1
 ///               - TLSv1.2
 ///               - TLSv1.3
+///           alpn_protocols:
+///               - h2
+///           session_resumption: { true, false }
+///           session_cache_size: 20480
+///           session_timeout: 300
+///           session_ticket_key_rotation_interval: 3600
+///           ktls: { true, false }
 /// ...
 ///
 struct ServerSslConfig : public SslConfig {
   /// If true, enable mutual SSL/TLS authentication.
   bool mutual_auth{false};
 
+  /// Interval in seconds to rotate the key encrypting session tickets.
+  uint32_t session_ticket_key_rotation_interval{3600};
+
   /// @brief Display content of struct.
   void Display() const;
 };
@@ -32,6 +32,11 @@ struct convert<trpc::SslConfig> {
     node["ciphers"] = ssl_config.ciphers;
     node["dh_param_path"] = ssl_config.dh_param_path;
     node["protocols"] = ssl_config.protocols;
+    node["alpn_protocols"] = ssl_config.alpn_protocols;
+    node["session_resumption"] = ssl_config.session_resumption;
+    node["session_cache_size"] = ssl_config.session_cache_size;
+    node["session_timeout"] = ssl_config.session_timeout;
+    node["ktls"] = ssl_config.ktls;
   }
 
   static bool decode(const YAML::Node& node, trpc::SslConfig& ssl_config) {
@@ -46,6 +51,15 @@ struct convert<trpc::SslConfig> {
         ssl_config.protocols.push_back(node["protocols"][i].as<std::string>());
       }
     }
+    if (node["alpn_protocols"]) {
+      for (size_t i = 0; i < node["alpn_protocols"].size(); ++i) {
+        ssl_config.alpn_protocols.push_back(node["alpn_protocols"][i].as<std::string>());
+      }
+    }
+    if (node["session_resumption"]) ssl_config.session_resumption = node["session_resumption"].as<bool>();
+    if (node["session_cache_size"]) ssl_config.session_cache_size = node["session_cache_size"].as<uint32_t>();
+    if (node["session_timeout"]) ssl_config.session_timeout = node["session_timeout"].as<uint32_t>();
+    if (node["ktls"]) ssl_config.ktls = node["ktls"].as<bool>();
     return true;
   }
 };
@@ -56,12 +70,16 @@ struct convert<trpc::ServerSslConfig> {
     YAML::Node node;
     convert<trpc::SslConfig>::encode(ssl_config, node);
     node["mutual_auth"] = ssl_config.mutual_auth;
+    node["session_ticket_key_rotation_interval"] = ssl_config.session_ticket_key_rotation_interval;
     return node;
   }
 
   static bool decode(const YAML::Node& node, trpc::ServerSslConfig& ssl_config) {
     convert<trpc::SslConfig>::decode(node, ssl_config);
     if (node["mutual_auth"]) ssl_config.mutual_auth = node["mutual_auth"].as<bool>();
+    if (node["session_ticket_key_rotation_interval"]) {
+      ssl_config.session_ticket_key_rotation_interval = node["session_ticket_key_rotation_interval"].as<uint32_t>();
+    }
     return true;
   }
 };
@@ -35,6 +35,10 @@ class ServerSslConfigTest : public ::testing::Test {
     ssl_config_.protocols.emplace_back("TLSv1");
     ssl_config_.protocols.emplace_back("TLSv1.1");
     ssl_config_.protocols.emplace_back("TLSv1.2");
+    ssl_config_.alpn_protocols.emplace_back("h2");
+    ssl_config_.session_timeout = 600;
+    ssl_config_.session_ticket_key_rotation_interval = 1800;
+    ssl_config_.ktls = true;
   }
 
   void TearDown() override {}
@@ -57,6 +61,11 @@ TEST_F(ServerSslConfigTest, EncodeAndDecode) {
   ASSERT_EQ(ssl_config_.ciphers, decoded_ssl_config.ciphers);
   ASSERT_EQ(ssl_config_.dh_param_path, decoded_ssl_config.dh_param_path);
   ASSERT_EQ(ssl_config_.protocols.size(), decoded_ssl_config.protocols.size());
+  ASSERT_EQ(ssl_config_.alpn_protocols, decoded_ssl_config.alpn_protocols);
+  ASSERT_EQ(ssl_config_.session_resumption, decoded_ssl_config.session_resumption);
+  ASSERT_EQ(ssl_config_.session_timeout, decoded_ssl_config.session_timeout);
+  ASSERT_EQ(ssl_config_.session_ticket_key_rotation_interval, decoded_ssl_config.session_ticket_key_rotation_interval);
+  ASSERT_EQ(ssl_config_.ktls, decoded_ssl_config.ktls);
 
   decoded_ssl_config.Display();
 }
@@ -76,7 +85,11 @@ class ClientSslConfigTest : public ::testing::Test {
     ssl_config_.protocols.emplace_back("TLSv1");
     ssl_config_.protocols.emplace_back("TLSv1.1");
     ssl_config_.protocols.emplace_back("TLSv1.2");
+    ssl_config_.alpn_protocols.emplace_back("h2");
+    ssl_config_.alpn_protocols.emplace_back("http/1.1");
     ssl_config_.insecure = false;
+    ssl_config_.session_resumption = false;
+    ssl_config_.session_cache_size = 1024;
   }
 
   void TearDown() override {}
@@ -99,6 +112,9 @@ TEST_F(ClientSslConfigTest, EncodeAndDecode) {
   ASSERT_EQ(ssl_config_.ciphers, decoded_ssl_config.ciphers);
   ASSERT_EQ(ssl_config_.dh_param_path, decoded_ssl_config.dh_param_path);
   ASSERT_EQ(ssl_config_.protocols.size(), decoded_ssl_config.protocols.size());
+  ASSERT_EQ(ssl_config_.alpn_protocols, decoded_ssl_config.alpn_protocols);
+  ASSERT_EQ(ssl_config_.session_resumption, decoded_ssl_config.session_resumption);
+  ASSERT_EQ(ssl_config_.session_cache_size, decoded_ssl_config.session_cache_size);
 
   decoded_ssl_config.Display();
 }
@@ -26,6 +26,12 @@ TEST(TrpcConfig, TestInit) {
 
   const auto& global = trpc_config->GetGlobalConfig();
   ASSERT_EQ(global.threadmodel_config.fiber_model.size(), 1);
+  ASSERT_EQ(global.udp_io_config.recv_batch_size, 32);
+  ASSERT_EQ(global.udp_io_config.send_batch_size, 16);
+  ASSERT_FALSE(global.udp_io_config.enable_gso);
+  ASSERT_TRUE(global.udp_io_config.enable_gro);
+  ASSERT_TRUE(global.zero_copy_send_config.enable);
+  ASSERT_EQ(global.zero_copy_send_config.min_bytes, 64 * 1024);
 
   const auto& server = trpc_config->GetServerConfig();
   ASSERT_EQ(server.app, "Test");
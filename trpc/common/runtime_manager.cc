@@ -143,6 +143,10 @@ int InitFrameworkRuntime() {
     memory_pool::SetMemBlockSize(buffer_pool_config.block_size);
     memory_pool::SetMemPoolThreshold(buffer_pool_config.mem_pool_threshold);
 
+    runtime::InitUdpBatchIoConfig();
+
+    runtime::InitZeroCopySendConfig();
+
     internal::TimeKeeper::Instance()->Start();
 
     if (IsInFiberRuntime()) {
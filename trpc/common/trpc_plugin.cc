@@ -40,6 +40,7 @@
 #include "trpc/runtime/common/periphery_task_scheduler.h"
 #include "trpc/runtime/common/runtime_info_report/runtime_info_reporter.h"
 #include "trpc/runtime/common/stats/frame_stats.h"
+#include "trpc/runtime/iomodel/reactor/common/zero_copy_send.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_reactor.h"
 #include "trpc/runtime/merge_runtime.h"
 #include "trpc/runtime/runtime.h"
@@ -102,6 +103,12 @@ int TrpcPlugin::RegisterPlugins() {
 
   FrameStats::GetInstance()->Start();
 
+  if (GetZeroCopySendOptions().enable) {
+    // Closes the sockets of closed connections once their zero-copy writes complete.
+    zero_copy_reap_task_id_ = PeripheryTaskScheduler::GetInstance()->SubmitInnerPeriodicalTask(
+        [] { ReapLingeringZeroCopySockets(); }, kZeroCopyReapIntervalMs, "ReapLingeringZeroCopySockets");
+  }
+
   runtime::StartReportRuntimeInfo();
 
 #ifdef TRPC_BUILD_INCLUDE_RPCZ
@@ -237,6 +244,12 @@ int TrpcPlugin::UnregisterPlugins() {
 
   overload_control::Stop();
 
+  if (zero_copy_reap_task_id_ != 0) {
+    PeripheryTaskScheduler::GetInstance()->StopInnerTask(zero_copy_reap_task_id_);
+    PeripheryTaskScheduler::GetInstance()->JoinInnerTask(zero_copy_reap_task_id_);
+    zero_copy_reap_task_id_ = 0;
+  }
+
   PeripheryTaskScheduler::GetInstance()->Stop();
   PeripheryTaskScheduler::GetInstance()->Join();
 
@@ -244,6 +257,9 @@ int TrpcPlugin::UnregisterPlugins() {
 
   DestroyRuntime_();
 
+  // All connections are closed now, reset the sockets still waiting for zero-copy writes.
+  ReapLingeringZeroCopySockets(true);
+
   is_all_destroyed_ = true;
 
   return 0;
@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -195,6 +196,8 @@ class TrpcPlugin {
   void DestroyRuntime_();
 
  private:
+  static constexpr std::uint64_t kZeroCopyReapIntervalMs = 10;
+
   std::mutex mutex_;
 
   std::unordered_map<std::string, PluginInfo> plugins_;
@@ -207,6 +210,9 @@ class TrpcPlugin {
 
   // `RegisterPlugins`/`RegisterPlugins` is invoked by framework
   bool is_invoke_by_framework_{false};
+
+  // Periodical task closing the sockets which linger for zero-copy writes, 0 if not submitted
+  std::uint64_t zero_copy_reap_task_id_{0};
 };
 
 }  // namespace trpc
@@ -35,6 +35,8 @@ constexpr CompressType kZlib = TrpcCompressType::TRPC_ZLIB_COMPRESS;
 constexpr CompressType kSnappyBlock = TrpcCompressType::TRPC_SNAPPY_BLOCK_COMPRESS;
 /// @brief lz4 frame.
 constexpr CompressType kLz4Frame = TrpcCompressType::TRPC_LZ4_FRAME_COMPRESS;
+/// @brief Type 7 is zstd frame, it has no counterpart in `TrpcCompressType` yet, so peers must agree on it.
+constexpr CompressType kZstd{7};
 /// @brief It is not a compression algorithm, it is the number of compression algorithms.
 constexpr CompressType kMaxType{255};
 
@@ -13,13 +13,18 @@
 
 #include "trpc/compressor/trpc_compressor.h"
 
+#include <string>
 #include <utility>
+#include <vector>
 
+#include "trpc/common/config/trpc_config.h"
 #include "trpc/compressor/compressor_factory.h"
 #include "trpc/compressor/gzip/gzip_compressor.h"
 #include "trpc/compressor/lz4/lz4_compressor.h"
 #include "trpc/compressor/snappy/snappy_compressor.h"
 #include "trpc/compressor/zlib/zlib_compressor.h"
+#include "trpc/compressor/zstd/zstd_compressor.h"
+#include "trpc/compressor/zstd/zstd_compressor_conf.h"
 #include "trpc/util/likely.h"
 #include "trpc/util/log/logging.h"
 
@@ -40,6 +45,14 @@ bool Init() {
   // lz4 frame
   TRPC_ASSERT(factory->Register(MakeRefCounted<Lz4FrameCompressor>()));
 
+  // zstd, with the optional pre-trained dictionaries
+  ZstdCompressorConf zstd_conf;
+  TrpcConfig::GetInstance()->GetPluginConfig<ZstdCompressorConf>("compressor", "zstd", zstd_conf);
+  std::vector<std::string> zstd_dictionaries;
+  // A dictionary missing only disables itself, zstd still works with the others or without any.
+  LoadZstdDictionaries(zstd_conf, zstd_dictionaries);
+  TRPC_ASSERT(factory->Register(MakeRefCounted<ZstdCompressor>(zstd_dictionaries)));
+
   return true;
 }
 
@@ -0,0 +1,225 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#include "trpc/compressor/zstd/zstd_compressor.h"
+
+#include <algorithm>
+
+#include "zstd.h"
+
+#include "trpc/util/log/logging.h"
+
+namespace trpc::compressor {
+
+namespace {
+
+// Same as `ZSTD_FRAMEHEADERSIZE_MAX`, which is only exposed by the static linking only API of zstd.
+constexpr std::size_t kFrameHeaderSizeMax = 18;
+
+struct CCtxDeleter {
+  void operator()(ZSTD_CCtx* cctx) const { ZSTD_freeCCtx(cctx); }
+};
+
+struct DCtxDeleter {
+  void operator()(ZSTD_DCtx* dctx) const { ZSTD_freeDCtx(dctx); }
+};
+
+// Contexts hold sizable internal buffers, creating them per call costs far more than the compression of small
+// messages, so they are cached per thread. Compression never yields, a context is never shared by two fibers.
+ZSTD_CCtx* GetThreadLocalCCtx() {
+  thread_local std::unique_ptr<ZSTD_CCtx, CCtxDeleter> cctx(ZSTD_createCCtx());
+  return cctx.get();
+}
+
+ZSTD_DCtx* GetThreadLocalDCtx() {
+  thread_local std::unique_ptr<ZSTD_DCtx, DCtxDeleter> dctx(ZSTD_createDCtx());
+  return dctx.get();
+}
+
+// Runs a single step of streaming compression, writing into the free space of `builder` directly.
+std::size_t CompressStep(ZSTD_CCtx* cctx, ZSTD_inBuffer* input, ZSTD_EndDirective mode,
+                         NoncontiguousBufferBuilder& builder) {
+  ZSTD_outBuffer output{builder.data(), builder.SizeAvailable(), 0};
+  std::size_t ret = ZSTD_compressStream2(cctx, &output, input, mode);
+  if (ZSTD_isError(ret)) {
+    TRPC_FMT_ERROR("zstd compress error: {}", ZSTD_getErrorName(ret));
+    return ret;
+  }
+  builder.MarkWritten(output.pos);
+  return ret;
+}
+
+// Same as `CompressStep`, for decompression. `produced` is set to the number of bytes decompressed.
+std::size_t DecompressStep(ZSTD_DCtx* dctx, ZSTD_inBuffer* input, NoncontiguousBufferBuilder& builder,
+                           std::size_t* produced) {
+  ZSTD_outBuffer output{builder.data(), builder.SizeAvailable(), 0};
+  std::size_t ret = ZSTD_decompressStream(dctx, &output, input);
+  if (ZSTD_isError(ret)) {
+    TRPC_FMT_ERROR("zstd decompress error: {}", ZSTD_getErrorName(ret));
+    return ret;
+  }
+  builder.MarkWritten(output.pos);
+  *produced = output.pos;
+  return ret;
+}
+
+// Gets the dictionary id recorded in the frame header, 0 means no dictionary is needed (or it is not recorded).
+unsigned GetFrameDictID(const NoncontiguousBuffer& in) {
+  auto first = in.FirstContiguous();
+  if (first.size() >= kFrameHeaderSizeMax || first.size() == in.ByteSize()) {
+    return ZSTD_getDictID_fromFrame(first.data(), first.size());
+  }
+  char header[kFrameHeaderSizeMax];
+  std::size_t size = std::min(kFrameHeaderSizeMax, in.ByteSize());
+  FlattenToSlow(in, header, size);
+  return ZSTD_getDictID_fromFrame(header, size);
+}
+
+}  // namespace
+
+void ZstdCompressor::CDictDeleter::operator()(ZSTD_CDict_s* cdict) const { ZSTD_freeCDict(cdict); }
+
+void ZstdCompressor::DDictDeleter::operator()(ZSTD_DDict_s* ddict) const { ZSTD_freeDDict(ddict); }
+
+ZstdCompressor::ZstdCompressor(const std::vector<std::string>& dictionaries) {
+  for (const auto& dictionary : dictionaries) {
+    unsigned dict_id = ZSTD_getDictID_fromDict(dictionary.data(), dictionary.size());
+    if (dict_id == 0) {
+      // Frames compressed with a raw content dictionary can not be told apart from the ones compressed without.
+      TRPC_FMT_ERROR("zstd dictionary without dictionary id is not supported, size: {}", dictionary.size());
+      continue;
+    }
+    if (GetDDict(dict_id) != nullptr) {
+      TRPC_FMT_WARN("Duplicated zstd dictionary id: {}, ignored", dict_id);
+      continue;
+    }
+    std::unique_ptr<ZSTD_DDict_s, DDictDeleter> ddict(ZSTD_createDDict(dictionary.data(), dictionary.size()));
+    if (!ddict) {
+      TRPC_FMT_ERROR("Failed to load zstd dictionary, id: {}", dict_id);
+      continue;
+    }
+    ddicts_.emplace_back(dict_id, std::move(ddict));
+
+    if (!cdicts_[0]) {
+      for (LevelType level = kFastest; level <= kBest; ++level) {
+        cdicts_[level].reset(ZSTD_createCDict(dictionary.data(), dictionary.size(), ToZstdLevel(level)));
+      }
+    }
+  }
+}
+
+ZstdCompressor::~ZstdCompressor() = default;
+
+int ZstdCompressor::ToZstdLevel(LevelType level) {
+  switch (level) {
+    case kFastest:
+      return 1;
+    case kBest:
+      return 19;
+    default:
+      return ZSTD_CLEVEL_DEFAULT;
+  }
+}
+
+const ZSTD_DDict_s* ZstdCompressor::GetDDict(unsigned dict_id) const {
+  for (const auto& [id, ddict] : ddicts_) {
+    if (id == dict_id) {
+      return ddict.get();
+    }
+  }
+  return nullptr;
+}
+
+bool ZstdCompressor::DoCompress(const NoncontiguousBuffer& in, NoncontiguousBuffer& out, LevelType level) {
+  ZSTD_CCtx* cctx = GetThreadLocalCCtx();
+  ZSTD_CCtx_reset(cctx, ZSTD_reset_session_and_parameters);
+  ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, ToZstdLevel(level));
+  // The content size is recorded in the frame header, which lets the peer size its output in one go.
+  ZSTD_CCtx_setPledgedSrcSize(cctx, in.ByteSize());
+  if (level <= kBest && cdicts_[level]) {
+    ZSTD_CCtx_refCDict(cctx, cdicts_[level].get());
+  }
+
+  NoncontiguousBufferBuilder builder;
+  for (auto iter = in.begin(); iter != in.end(); ++iter) {
+    ZSTD_inBuffer input{iter->data(), iter->size(), 0};
+    while (input.pos < input.size) {
+      if (ZSTD_isError(CompressStep(cctx, &input, ZSTD_e_continue, builder))) {
+        return false;
+      }
+    }
+  }
+
+  ZSTD_inBuffer input{nullptr, 0, 0};
+  std::size_t remaining = 0;
+  do {
+    remaining = CompressStep(cctx, &input, ZSTD_e_end, builder);
+    if (ZSTD_isError(remaining)) {
+      return false;
+    }
+  } while (remaining != 0);
+
+  out = builder.DestructiveGet();
+  return true;
+}
+
+bool ZstdCompressor::DoDecompress(const NoncontiguousBuffer& in, NoncontiguousBuffer& out) {
+  // Not even a frame header.
+  if (in.Empty()) {
+    return false;
+  }
+
+  ZSTD_DCtx* dctx = GetThreadLocalDCtx();
+  ZSTD_DCtx_reset(dctx, ZSTD_reset_session_and_parameters);
+  if (!ddicts_.empty()) {
+    unsigned dict_id = GetFrameDictID(in);
+    if (dict_id != 0) {
+      const ZSTD_DDict* ddict = GetDDict(dict_id);
+      if (!ddict) {
+        TRPC_FMT_ERROR("zstd dictionary not found, id: {}", dict_id);
+        return false;
+      }
+      ZSTD_DCtx_refDDict(dctx, ddict);
+    }
+  }
+
+  NoncontiguousBufferBuilder builder;
+  std::size_t ret = 0;
+  std::size_t produced = 0;
+  for (auto iter = in.begin(); iter != in.end(); ++iter) {
+    ZSTD_inBuffer input{iter->data(), iter->size(), 0};
+    while (input.pos < input.size) {
+      ret = DecompressStep(dctx, &input, builder, &produced);
+      if (ZSTD_isError(ret)) {
+        return false;
+      }
+    }
+  }
+
+  // Input is all consumed, flush what is still held by the context until the frame is complete.
+  ZSTD_inBuffer input{nullptr, 0, 0};
+  while (ret != 0) {
+    ret = DecompressStep(dctx, &input, builder, &produced);
+    if (ZSTD_isError(ret)) {
+      return false;
+    }
+    if (ret != 0 && produced == 0) {
+      TRPC_FMT_ERROR("zstd decompress error: truncated input");
+      return false;
+    }
+  }
+
+  out = builder.DestructiveGet();
+  return true;
+}
+
+}  // namespace trpc::compressor
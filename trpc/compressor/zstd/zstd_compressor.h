@@ -0,0 +1,71 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "trpc/compressor/compressor.h"
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace trpc::compressor {
+
+/// @brief Implementation of zstd compress/decompress, in zstd frame format.
+/// @note Data is streamed block by block of the `NoncontiguousBuffer`, neither input nor output is flattened.
+///       Compression/decompression contexts are cached per thread and reused across calls.
+class ZstdCompressor : public Compressor {
+ public:
+  ZstdCompressor() = default;
+
+  /// @brief Constructs a compressor with pre-trained dictionaries (as produced by `zstd --train`).
+  /// @param dictionaries Content of the dictionaries. The first one is used for compression, all of them are available
+  ///                     for decompression and selected by the dictionary id recorded in the frame header.
+  ///                     Raw content dictionaries (without dictionary id) are rejected.
+  explicit ZstdCompressor(const std::vector<std::string>& dictionaries);
+
+  ~ZstdCompressor() override;
+
+  CompressType Type() const override { return kZstd; }
+
+  /// @brief Maps `LevelType` to zstd compression level.
+  static int ToZstdLevel(LevelType level);
+
+ protected:
+  bool DoCompress(const NoncontiguousBuffer& in, NoncontiguousBuffer& out, LevelType level) override;
+
+  bool DoDecompress(const NoncontiguousBuffer& in, NoncontiguousBuffer& out) override;
+
+ private:
+  struct CDictDeleter {
+    void operator()(ZSTD_CDict_s* cdict) const;
+  };
+
+  struct DDictDeleter {
+    void operator()(ZSTD_DDict_s* ddict) const;
+  };
+
+  const ZSTD_DDict_s* GetDDict(unsigned dict_id) const;
+
+ private:
+  // Digested compression dictionary of each level, all built from the first dictionary.
+  std::unique_ptr<ZSTD_CDict_s, CDictDeleter> cdicts_[kBest + 1];
+
+  // Digested decompression dictionaries, keyed by dictionary id.
+  std::vector<std::pair<unsigned, std::unique_ptr<ZSTD_DDict_s, DDictDeleter>>> ddicts_;
+};
+
+}  // namespace trpc::compressor
@@ -0,0 +1,41 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#include "trpc/compressor/zstd/zstd_compressor_conf.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "trpc/util/log/logging.h"
+
+namespace trpc::compressor {
+
+bool LoadZstdDictionaries(const ZstdCompressorConf& conf, std::vector<std::string>& dictionaries) {
+  dictionaries.clear();
+  dictionaries.reserve(conf.dictionaries.size());
+  bool all_loaded = true;
+  for (const auto& path : conf.dictionaries) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+      // Frames compressed with it can't be decompressed, while others still work with the remaining dictionaries.
+      TRPC_FMT_ERROR("Failed to open zstd dictionary: {}, disabled", path);
+      all_loaded = false;
+      continue;
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    dictionaries.push_back(content.str());
+  }
+  return all_loaded;
+}
+
+}  // namespace trpc::compressor
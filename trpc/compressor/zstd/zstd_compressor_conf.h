@@ -0,0 +1,54 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "yaml-cpp/yaml.h"
+
+namespace trpc::compressor {
+
+/// @brief Configuration of zstd compressor, under `plugins` -> `compressor` -> `zstd`.
+struct ZstdCompressorConf {
+  /// Paths of the pre-trained dictionary files. The first one is used for compression, all of them are available for
+  /// decompression.
+  std::vector<std::string> dictionaries;
+};
+
+/// @brief Reads the content of the dictionary files configured. Files which can not be read are skipped with an error
+///        logged, the remaining ones are still loaded.
+/// @return false if any of the files can not be read.
+bool LoadZstdDictionaries(const ZstdCompressorConf& conf, std::vector<std::string>& dictionaries);
+
+}  // namespace trpc::compressor
+
+namespace YAML {
+
+template <>
+struct convert<trpc::compressor::ZstdCompressorConf> {
+  static YAML::Node encode(const trpc::compressor::ZstdCompressorConf& conf) {
+    YAML::Node node;
+    node["dictionaries"] = conf.dictionaries;
+    return node;
+  }
+
+  static bool decode(const YAML::Node& node, trpc::compressor::ZstdCompressorConf& conf) {
+    if (node["dictionaries"]) {
+      conf.dictionaries = node["dictionaries"].as<std::vector<std::string>>();
+    }
+    return true;
+  }
+};
+
+}  // namespace YAML
@@ -0,0 +1,60 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#include "trpc/compressor/zstd/zstd_compressor_conf.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::compressor::testing {
+
+TEST(ZstdCompressorConf, Load) {
+  std::string path = "./zstd_compressor_conf_test.dict";
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << std::string("dict\0content", 12);
+  }
+
+  YAML::Node node = YAML::Load("dictionaries: [" + path + "]");
+  ZstdCompressorConf conf = node.as<ZstdCompressorConf>();
+  ASSERT_EQ(conf.dictionaries.size(), 1);
+  ASSERT_EQ(conf.dictionaries[0], path);
+  ASSERT_EQ(YAML::convert<ZstdCompressorConf>::encode(conf)["dictionaries"][0].as<std::string>(), path);
+
+  std::vector<std::string> dictionaries;
+  ASSERT_TRUE(LoadZstdDictionaries(conf, dictionaries));
+  ASSERT_EQ(dictionaries.size(), 1);
+  ASSERT_EQ(dictionaries[0], std::string("dict\0content", 12));
+
+  // The missing one is skipped, the others are still loaded.
+  conf.dictionaries.insert(conf.dictionaries.begin(), "./not_exist.dict");
+  ASSERT_FALSE(LoadZstdDictionaries(conf, dictionaries));
+  ASSERT_EQ(dictionaries.size(), 1);
+  ASSERT_EQ(dictionaries[0], std::string("dict\0content", 12));
+
+  std::remove(path.c_str());
+}
+
+TEST(ZstdCompressorConf, Empty) {
+  ZstdCompressorConf conf = YAML::Load("{}").as<ZstdCompressorConf>();
+  ASSERT_TRUE(conf.dictionaries.empty());
+
+  std::vector<std::string> dictionaries{"stale"};
+  ASSERT_TRUE(LoadZstdDictionaries(conf, dictionaries));
+  ASSERT_TRUE(dictionaries.empty());
+}
+
+}  // namespace trpc::compressor::testing
@@ -0,0 +1,189 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#include "trpc/compressor/zstd/zstd_compressor.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "zdict.h"
+#include "zstd.h"
+
+#include "trpc/compressor/testing/compressor_testing.h"
+#include "trpc/util/buffer/buffer.h"
+
+namespace trpc::compressor::testing {
+
+namespace {
+
+// Splits `str` into a buffer made of blocks of `block_size` bytes at most.
+NoncontiguousBuffer CreateFragmentedBuffer(const std::string& str, std::size_t block_size) {
+  NoncontiguousBuffer buffer;
+  for (std::size_t pos = 0; pos < str.size(); pos += block_size) {
+    buffer.Append(CreateBufferSlow(str.substr(pos, block_size)));
+  }
+  return buffer;
+}
+
+std::string GenSample(int i) {
+  return "{\"user_id\":" + std::to_string(i) + ",\"name\":\"user_" + std::to_string(i * 7) +
+         "\",\"status\":\"active\",\"tags\":[\"trpc\",\"zstd\",\"dictionary\"],\"score\":" +
+         std::to_string(i % 100) + "}";
+}
+
+std::string TrainDictionary() {
+  std::string samples;
+  std::vector<std::size_t> sizes;
+  for (int i = 0; i < 2000; ++i) {
+    auto sample = GenSample(i);
+    samples += sample;
+    sizes.push_back(sample.size());
+  }
+  std::string dictionary(4096, '\0');
+  std::size_t size = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), samples.data(), sizes.data(),
+                                           static_cast<unsigned>(sizes.size()));
+  EXPECT_FALSE(ZDICT_isError(size));
+  dictionary.resize(size);
+  return dictionary;
+}
+
+}  // namespace
+
+TEST(ZstdCompressor, Type) {
+  ZstdCompressor zstd_compressor;
+  ASSERT_EQ(zstd_compressor.Type(), kZstd);
+}
+
+TEST(ZstdCompressor, ToZstdLevel) {
+  ASSERT_EQ(ZstdCompressor::ToZstdLevel(kFastest), 1);
+  ASSERT_EQ(ZstdCompressor::ToZstdLevel(kDefault), ZSTD_CLEVEL_DEFAULT);
+  ASSERT_EQ(ZstdCompressor::ToZstdLevel(kBest), 19);
+}
+
+TEST(ZstdCompressor, CompressStr) {
+  ZstdCompressor compressor;
+
+  for (const auto& in : {std::string(), std::string("ab"), GenRandomStr(10 * 1024 * 1024)}) {
+    for (LevelType level : {kFastest, kDefault, kBest}) {
+      if (level == kBest && in.size() > 1024) {
+        continue;  // too slow
+      }
+      NoncontiguousBuffer compress_in = CreateBufferSlow(in);
+      NoncontiguousBuffer compress_out;
+      ASSERT_TRUE(compressor.Compress(compress_in, compress_out, level));
+
+      // Interoperable with the one-shot api of zstd.
+      auto compressed = FlattenSlow(compress_out);
+      std::string decompressed(in.size(), '\0');
+      std::size_t size = ZSTD_decompress(decompressed.data(), decompressed.size(), compressed.data(), compressed.size());
+      ASSERT_FALSE(ZSTD_isError(size));
+      ASSERT_EQ(size, in.size());
+      EXPECT_EQ(decompressed, in);
+
+      NoncontiguousBuffer decompress_out;
+      ASSERT_TRUE(compressor.Decompress(compress_out, decompress_out));
+      EXPECT_EQ(FlattenSlow(decompress_out), in);
+    }
+  }
+}
+
+TEST(ZstdCompressor, Fragmented) {
+  ZstdCompressor compressor;
+  std::string in;
+  for (int i = 0; i < 10000; ++i) {
+    in += GenSample(i);
+  }
+
+  NoncontiguousBuffer compress_out;
+  ASSERT_TRUE(compressor.Compress(CreateFragmentedBuffer(in, 333), compress_out));
+
+  // Even the frame header is split across blocks.
+  auto compressed = FlattenSlow(compress_out);
+  NoncontiguousBuffer decompress_out;
+  ASSERT_TRUE(compressor.Decompress(CreateFragmentedBuffer(compressed, 1), decompress_out));
+  EXPECT_EQ(FlattenSlow(decompress_out), in);
+}
+
+TEST(ZstdCompressor, DecompressZstdFrame) {
+  ZstdCompressor compressor;
+  auto in = GenRandomStr(1024 * 1024);
+  std::string compressed(ZSTD_compressBound(in.size()), '\0');
+  std::size_t size = ZSTD_compress(compressed.data(), compressed.size(), in.data(), in.size(), 3);
+  ASSERT_FALSE(ZSTD_isError(size));
+  compressed.resize(size);
+
+  NoncontiguousBuffer decompress_out;
+  ASSERT_TRUE(compressor.Decompress(CreateBufferSlow(compressed), decompress_out));
+  EXPECT_EQ(FlattenSlow(decompress_out), in);
+}
+
+TEST(ZstdCompressor, DecompressBadInput) {
+  ZstdCompressor compressor;
+  NoncontiguousBuffer compress_out;
+  ASSERT_TRUE(compressor.Compress(CreateBufferSlow(GenRandomStr(1024)), compress_out));
+  auto compressed = FlattenSlow(compress_out);
+
+  NoncontiguousBuffer decompress_out;
+  ASSERT_FALSE(compressor.Decompress(CreateBufferSlow(compressed.substr(0, compressed.size() / 2)), decompress_out));
+  ASSERT_FALSE(compressor.Decompress(CreateBufferSlow("not a zstd frame"), decompress_out));
+  ASSERT_FALSE(compressor.Decompress(NoncontiguousBuffer(), decompress_out));
+}
+
+TEST(ZstdCompressor, Dictionary) {
+  auto dictionary = TrainDictionary();
+  ZstdCompressor compressor({dictionary});
+  ZstdCompressor no_dict_compressor;
+
+  auto in = GenSample(123456);
+  NoncontiguousBuffer compress_out;
+  ASSERT_TRUE(compressor.Compress(CreateBufferSlow(in), compress_out));
+  NoncontiguousBuffer no_dict_compress_out;
+  ASSERT_TRUE(no_dict_compressor.Compress(CreateBufferSlow(in), no_dict_compress_out));
+  // Small messages benefit from the dictionary a lot.
+  EXPECT_LT(compress_out.ByteSize(), no_dict_compress_out.ByteSize());
+
+  NoncontiguousBuffer decompress_out;
+  ASSERT_TRUE(compressor.Decompress(compress_out, decompress_out));
+  EXPECT_EQ(FlattenSlow(decompress_out), in);
+
+  // Frames without dictionary are still accepted.
+  ASSERT_TRUE(compressor.Decompress(no_dict_compress_out, decompress_out));
+  EXPECT_EQ(FlattenSlow(decompress_out), in);
+
+  // The dictionary is required.
+  ASSERT_FALSE(no_dict_compressor.Decompress(compress_out, decompress_out));
+
+  // Interoperable with the one-shot api of zstd.
+  auto compressed = FlattenSlow(compress_out);
+  std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx*)> dctx(ZSTD_createDCtx(), &ZSTD_freeDCtx);
+  std::string decompressed(in.size(), '\0');
+  std::size_t size = ZSTD_decompress_usingDict(dctx.get(), decompressed.data(), decompressed.size(), compressed.data(),
+                                               compressed.size(), dictionary.data(), dictionary.size());
+  ASSERT_FALSE(ZSTD_isError(size));
+  EXPECT_EQ(decompressed, in);
+}
+
+TEST(ZstdCompressor, RawContentDictionaryIgnored) {
+  ZstdCompressor compressor({std::string("raw content dictionary")});
+
+  auto in = GenSample(1);
+  NoncontiguousBuffer compress_out;
+  ASSERT_TRUE(compressor.Compress(CreateBufferSlow(in), compress_out));
+
+  NoncontiguousBuffer decompress_out;
+  ASSERT_TRUE(ZstdCompressor().Decompress(compress_out, decompress_out));
+  EXPECT_EQ(FlattenSlow(decompress_out), in);
+}
+
+}  // namespace trpc::compressor::testing
@@ -65,6 +65,7 @@ Fiber::Fiber(const Attributes& attr, Function<void()>&& start) {
   desc->start_proc = std::move(start);
   desc->scheduling_group_local = attr.scheduling_group_local;
   desc->is_fiber_reactor = attr.is_fiber_reactor;
+  desc->priority = attr.priority;
 
   // If `join()` is called, we'll sleep on this.
   desc->exit_barrier = object_pool::MakeLwShared<fiber::detail::ExitBarrier>();
@@ -119,6 +120,7 @@ bool StartFiberDetached(Fiber::Attributes&& attrs, Function<void()>&& start_proc
   desc->start_proc = std::move(start_proc);
   TRPC_CHECK(!desc->exit_barrier);
   desc->scheduling_group_local = attrs.scheduling_group_local;
+  desc->priority = attrs.priority;
 
   if (attrs.launch_policy == fiber::Launch::Post) {
     return sg->StartFiber(desc);
@@ -17,6 +17,7 @@
 #include <utility>
 #include <vector>
 
+#include "trpc/runtime/threadmodel/common/task_priority.h"
 #include "trpc/util/chrono/chrono.h"
 #include "trpc/util/function.h"
 #include "trpc/util/object_pool/object_pool_ptr.h"
@@ -81,6 +82,10 @@ class Fiber {
     /// @brief If Set, it is a reactor fiber
     /// @note  Only used inside the framework
     bool is_fiber_reactor = false;
+
+    /// @brief Priority of the fiber within its scheduling group. Ready fibers of a higher priority run first, those of
+    ///        a lower priority are delayed under load but never starved.
+    runtime::TaskPriority priority = runtime::TaskPriority::kNormal;
   };
 
   /// @brief Create an empty (invalid) fiber.
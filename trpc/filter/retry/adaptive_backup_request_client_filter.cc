@@ -0,0 +1,129 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/filter/retry/adaptive_backup_request_client_filter.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "trpc/codec/trpc/trpc.pb.h"
+#include "trpc/util/log/logging.h"
+#include "trpc/util/time.h"
+
+namespace trpc {
+
+namespace {
+
+// Replaces the invalid fields of `config` with their defaults, returns false if there is any.
+bool CheckConfig(AdaptiveBackupRequestConfig& config) {
+  const AdaptiveBackupRequestConfig defaults;
+  bool valid = true;
+  if (!(config.percentile > 0 && config.percentile < 100)) {
+    TRPC_FMT_ERROR("{} filter: percentile {} is not in (0, 100), use {} instead.", kAdaptiveBackupRequestFilter,
+                   config.percentile, defaults.percentile);
+    config.percentile = defaults.percentile;
+    valid = false;
+  }
+  if (!(config.max_backup_ratio >= 0 && config.max_backup_ratio <= 1)) {
+    TRPC_FMT_ERROR("{} filter: max_backup_ratio {} is not in [0, 1], use {} instead.", kAdaptiveBackupRequestFilter,
+                   config.max_backup_ratio, defaults.max_backup_ratio);
+    config.max_backup_ratio = defaults.max_backup_ratio;
+    valid = false;
+  }
+  if (config.window_ms == 0) {
+    TRPC_FMT_ERROR("{} filter: window_ms must be positive, use {} instead.", kAdaptiveBackupRequestFilter,
+                   defaults.window_ms);
+    config.window_ms = defaults.window_ms;
+    valid = false;
+  }
+  return valid;
+}
+
+// The calls failed with these framework error codes were never sent, their latency tells nothing about the callee.
+bool IsUnsent(int framework_retcode) {
+  return framework_retcode == TrpcRetCode::TRPC_CLIENT_ENCODE_ERR ||
+         framework_retcode == TrpcRetCode::TRPC_CLIENT_ROUTER_ERR ||
+         framework_retcode == TrpcRetCode::TRPC_CLIENT_LIMITED_ERR ||
+         framework_retcode == TrpcRetCode::TRPC_CLIENT_OVERLOAD_ERR;
+}
+
+}  // namespace
+
+AdaptiveBackupRequestClientFilter::AdaptiveBackupRequestClientFilter(const AdaptiveBackupRequestConfig* config)
+    : config_(config != nullptr ? *config : AdaptiveBackupRequestConfig()),
+      config_valid_(CheckConfig(config_)),
+      latency_(config_.percentile, config_.window_ms * 1000ULL, config_.min_samples),
+      tokens_per_call_(static_cast<int64_t>(config_.max_backup_ratio * kTokenUnit)),
+      tokens_(kMaxBackupBurst * kTokenUnit) {}
+
+int AdaptiveBackupRequestClientFilter::Init() { return config_valid_ ? 0 : -1; }
+
+std::vector<FilterPoint> AdaptiveBackupRequestClientFilter::GetFilterPoint() {
+  std::vector<FilterPoint> points = {FilterPoint::CLIENT_PRE_RPC_INVOKE, FilterPoint::CLIENT_POST_RPC_INVOKE};
+  return points;
+}
+
+uint32_t AdaptiveBackupRequestClientFilter::GetDelay() const {
+  uint64_t delay_us = latency_.Get();
+  return static_cast<uint32_t>((delay_us + 999) / 1000);
+}
+
+void AdaptiveBackupRequestClientFilter::operator()(FilterStatus& status, FilterPoint point,
+                                                   const ClientContextPtr& context) {
+  switch (point) {
+    case FilterPoint::CLIENT_PRE_RPC_INVOKE: {
+      if (context->IsBackupRequest() || tokens_.load(std::memory_order_relaxed) < kTokenUnit) {
+        break;
+      }
+      uint32_t delay = GetDelay();
+      // A resend time no less than the timeout makes no backup request.
+      if (delay > 0 && delay < context->GetTimeout()) {
+        context->SetBackupRequestDelay(delay);
+      }
+      break;
+    }
+    case FilterPoint::CLIENT_POST_RPC_INVOKE: {
+      int64_t earned = tokens_per_call_;
+      if (auto* retry_info = context->GetBackupRequestRetryInfo(); retry_info != nullptr) {
+        earned -= retry_info->resend_count * kTokenUnit;
+      }
+      int64_t tokens = tokens_.fetch_add(earned, std::memory_order_relaxed) + earned;
+      if (earned > 0 && tokens > kMaxBackupBurst * kTokenUnit) {
+        tokens_.fetch_sub(earned, std::memory_order_relaxed);
+      }
+
+      if (IsUnsent(context->GetStatus().GetFrameworkRetCode())) {
+        break;
+      }
+      uint64_t now_us = trpc::time::GetMicroSeconds();
+      uint64_t begin_us = context->GetBeginTimestampUs();
+      if (begin_us > 0 && now_us > begin_us) {
+        latency_.Record(now_us - begin_us, now_us);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+MessageClientFilterPtr AdaptiveBackupRequestClientFilter::Create(const std::any& param) {
+  AdaptiveBackupRequestConfig config;
+  if (param.has_value()) {
+    config = std::any_cast<AdaptiveBackupRequestConfig>(param);
+  }
+
+  return std::make_shared<AdaptiveBackupRequestClientFilter>(&config);
+}
+
+}  // namespace trpc
@@ -0,0 +1,76 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "trpc/client/client_context.h"
+#include "trpc/common/config/retry_conf.h"
+#include "trpc/filter/client_filter_base.h"
+#include "trpc/filter/retry/latency_percentile.h"
+
+namespace trpc {
+
+/// @brief The service-level filter which enables backup request on the calls with a resend time following the latency
+///        of the callee, instead of a fixed one set by the user.
+///        1. The latency of every call sent is recorded, the resend time is the configured percentile (p95 by default)
+///        of the latency in the last two windows, rounded up to milliseconds. No backup request is issued until there
+///        are enough samples.
+///        2. The backup requests are limited by a budget: each call earns `max_backup_ratio` token and each backup
+///        request sent costs one, backup request is only enabled when there is at least one token, so that the extra
+///        requests stay below `max_backup_ratio` of the calls. At most `kMaxBackupBurst` tokens are saved.
+/// @note Calls on which the user has enabled backup request are left as they are, though their backup requests are
+///       charged as well. The backup request rate and success count are exported by `BackupRequestStats`.
+class AdaptiveBackupRequestClientFilter : public MessageClientFilter {
+ public:
+  /// The maximum number of backup requests which can be sent in a row.
+  static constexpr int64_t kMaxBackupBurst = 10;
+
+  explicit AdaptiveBackupRequestClientFilter(const AdaptiveBackupRequestConfig* config);
+
+  /// @brief Returns -1 if the config has invalid fields, which are logged and replaced with their defaults.
+  int Init() override;
+
+  std::string Name() override { return kAdaptiveBackupRequestFilter; }
+
+  std::vector<FilterPoint> GetFilterPoint() override;
+
+  void operator()(FilterStatus& status, FilterPoint point, const ClientContextPtr& context) override;
+
+  MessageClientFilterPtr Create(const std::any& param) override;
+
+  /// @brief Get the current resend time, in milliseconds, 0 if backup request is not enabled by the filter yet.
+  uint32_t GetDelay() const;
+
+ private:
+  // Tokens are counted in thousandths.
+  static constexpr int64_t kTokenUnit = 1000;
+
+  AdaptiveBackupRequestConfig config_;
+
+  // Whether the config given was valid as it was.
+  bool config_valid_{true};
+
+  LatencyPercentile latency_;
+
+  // Tokens earned per call.
+  int64_t tokens_per_call_{0};
+
+  std::atomic<int64_t> tokens_{0};
+};
+
+}  // namespace trpc
@@ -0,0 +1,175 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/filter/retry/adaptive_backup_request_client_filter.h"
+
+#include <chrono>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "trpc/codec/trpc/trpc.pb.h"
+#include "trpc/util/time.h"
+
+namespace trpc::testing {
+
+class AdaptiveBackupRequestClientFilterTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    AdaptiveBackupRequestConfig config;
+    config.window_ms = 1;
+    config.min_samples = 10;
+    filter_ = std::make_shared<AdaptiveBackupRequestClientFilter>(&config);
+  }
+
+  // Runs a call which takes `latency_ms` and sends `resend_count` backup requests if backup request is enabled on it,
+  // returns whether backup request was enabled.
+  bool Call(uint32_t latency_ms, uint32_t resend_count = 0, int framework_retcode = 0) {
+    auto context = MakeRefCounted<ClientContext>();
+    context->SetTimeout(1000);
+    FilterStatus status = FilterStatus::CONTINUE;
+    filter_->operator()(status, FilterPoint::CLIENT_PRE_RPC_INVOKE, context);
+    bool backup = context->IsBackupRequest();
+
+    context->SetBeginTimestampUs(trpc::time::GetMicroSeconds() - latency_ms * 1000);
+    if (backup) {
+      context->GetBackupRequestRetryInfo()->resend_count = resend_count;
+    }
+    context->SetStatus(Status(framework_retcode, 0, ""));
+    filter_->operator()(status, FilterPoint::CLIENT_POST_RPC_INVOKE, context);
+    return backup;
+  }
+
+  // Records enough samples of `latency_ms` and makes the window rotate.
+  void Warmup(uint32_t latency_ms) {
+    for (int i = 0; i < 20; ++i) {
+      Call(latency_ms);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    Call(latency_ms);
+  }
+
+ protected:
+  std::shared_ptr<AdaptiveBackupRequestClientFilter> filter_;
+};
+
+TEST_F(AdaptiveBackupRequestClientFilterTest, GetFilterPoint) {
+  std::vector<FilterPoint> points = filter_->GetFilterPoint();
+  ASSERT_EQ(points.size(), 2);
+  ASSERT_EQ(points[0], FilterPoint::CLIENT_PRE_RPC_INVOKE);
+  ASSERT_EQ(points[1], FilterPoint::CLIENT_POST_RPC_INVOKE);
+}
+
+TEST_F(AdaptiveBackupRequestClientFilterTest, Create) {
+  std::any param;
+  ASSERT_TRUE(filter_->Create(param) != nullptr);
+
+  AdaptiveBackupRequestConfig config;
+  ASSERT_TRUE(filter_->Create(config) != nullptr);
+}
+
+TEST_F(AdaptiveBackupRequestClientFilterTest, InvalidConfig) {
+  ASSERT_EQ(filter_->Init(), 0);
+
+  AdaptiveBackupRequestConfig config;
+  config.percentile = 100;
+  config.max_backup_ratio = -1;
+  config.window_ms = 0;
+  config.min_samples = 10;
+  // The invalid fields fall back to the defaults, and the filter still works.
+  auto filter = std::make_shared<AdaptiveBackupRequestClientFilter>(&config);
+  ASSERT_EQ(filter->Init(), -1);
+  ASSERT_EQ(filter->GetDelay(), 0);
+
+  auto context = MakeRefCounted<ClientContext>();
+  context->SetTimeout(1000);
+  FilterStatus status = FilterStatus::CONTINUE;
+  filter->operator()(status, FilterPoint::CLIENT_PRE_RPC_INVOKE, context);
+  ASSERT_FALSE(context->IsBackupRequest());
+}
+
+TEST_F(AdaptiveBackupRequestClientFilterTest, FollowLatency) {
+  // Not enough samples yet.
+  ASSERT_FALSE(Call(10));
+  ASSERT_EQ(filter_->GetDelay(), 0);
+
+  Warmup(10);
+  uint32_t delay = filter_->GetDelay();
+  ASSERT_GE(delay, 10);
+  ASSERT_LE(delay, 12);
+
+  auto context = MakeRefCounted<ClientContext>();
+  context->SetTimeout(1000);
+  FilterStatus status = FilterStatus::CONTINUE;
+  filter_->operator()(status, FilterPoint::CLIENT_PRE_RPC_INVOKE, context);
+  ASSERT_TRUE(context->IsBackupRequest());
+  ASSERT_EQ(context->GetBackupRequestRetryInfo()->delay, delay);
+
+  // The resend time follows the latency of the callee.
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  Warmup(100);
+  Warmup(100);
+  ASSERT_GE(filter_->GetDelay(), 100);
+  ASSERT_LE(filter_->GetDelay(), 120);
+}
+
+TEST_F(AdaptiveBackupRequestClientFilterTest, KeepUserSetting) {
+  Warmup(10);
+
+  auto context = MakeRefCounted<ClientContext>();
+  context->SetTimeout(1000);
+  context->SetBackupRequestDelay(3);
+  FilterStatus status = FilterStatus::CONTINUE;
+  filter_->operator()(status, FilterPoint::CLIENT_PRE_RPC_INVOKE, context);
+  ASSERT_EQ(context->GetBackupRequestRetryInfo()->delay, 3);
+
+  // No backup request if the resend time is no less than the timeout.
+  context = MakeRefCounted<ClientContext>();
+  context->SetTimeout(5);
+  filter_->operator()(status, FilterPoint::CLIENT_PRE_RPC_INVOKE, context);
+  ASSERT_FALSE(context->IsBackupRequest());
+}
+
+TEST_F(AdaptiveBackupRequestClientFilterTest, Budget) {
+  Warmup(10);
+
+  // Used up the burst, some tokens are earned by the calls meanwhile.
+  int backups = 0;
+  while (Call(10, 1)) {
+    ++backups;
+  }
+  ASSERT_GE(backups, AdaptiveBackupRequestClientFilter::kMaxBackupBurst);
+
+  // 5% of the calls, one backup request is allowed every 20 calls.
+  backups = 0;
+  for (int i = 0; i < 200; ++i) {
+    if (Call(10, 1)) {
+      ++backups;
+    }
+  }
+  ASSERT_GE(backups, 9);
+  ASSERT_LE(backups, 11);
+}
+
+TEST_F(AdaptiveBackupRequestClientFilterTest, IgnoreUnsent) {
+  for (int i = 0; i < 20; ++i) {
+    Call(10);
+    Call(1000, 0, TrpcRetCode::TRPC_CLIENT_LIMITED_ERR);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  Call(10);
+  ASSERT_GE(filter_->GetDelay(), 10);
+  ASSERT_LE(filter_->GetDelay(), 12);
+}
+
+}  // namespace trpc::testing
@@ -0,0 +1,95 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/filter/retry/latency_percentile.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace trpc {
+
+LatencyPercentile::LatencyPercentile(double percentile, uint64_t window_us, uint32_t min_samples)
+    : percentile_(percentile), window_us_(std::max<uint64_t>(window_us, 1)), min_samples_(std::max(min_samples, 1U)) {
+  for (auto& window : windows_) {
+    for (auto& bucket : window.buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+std::size_t LatencyPercentile::GetBucketIndex(uint64_t latency_us) {
+  constexpr uint64_t kLinearMax = 1 << kSubBucketBits;
+  if (latency_us < kLinearMax) {
+    return latency_us;
+  }
+  std::size_t msb = 63 - __builtin_clzll(latency_us);
+  std::size_t index = ((msb - kSubBucketBits + 1) << kSubBucketBits) +
+                      ((latency_us >> (msb - kSubBucketBits)) & (kLinearMax - 1));
+  return std::min(index, kBucketNum - 1);
+}
+
+uint64_t LatencyPercentile::GetBucketUpperBound(std::size_t index) {
+  constexpr uint64_t kLinearMax = 1 << kSubBucketBits;
+  if (index < kLinearMax) {
+    return index + 1;
+  }
+  std::size_t shift = (index >> kSubBucketBits) - 1;
+  uint64_t lower = (kLinearMax + (index & (kLinearMax - 1))) << shift;
+  return lower + (uint64_t{1} << shift);
+}
+
+void LatencyPercentile::Record(uint64_t latency_us, uint64_t now_us) {
+  uint64_t begin_us = window_begin_us_.load(std::memory_order_relaxed);
+  if (now_us >= begin_us + window_us_ &&
+      window_begin_us_.compare_exchange_strong(begin_us, now_us, std::memory_order_relaxed)) {
+    Rotate();
+  }
+
+  uint32_t current = current_.load(std::memory_order_relaxed);
+  windows_[current].buckets[GetBucketIndex(latency_us)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void LatencyPercentile::Rotate() {
+  uint32_t current = current_.load(std::memory_order_relaxed);
+  Window& last = windows_[current];
+  Window& previous = windows_[current ^ 1];
+
+  uint32_t counts[kBucketNum];
+  uint64_t total = 0;
+  for (std::size_t i = 0; i != kBucketNum; ++i) {
+    counts[i] = last.buckets[i].load(std::memory_order_relaxed) + previous.buckets[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+
+  uint64_t value_us = 0;
+  if (total >= min_samples_) {
+    auto rank = static_cast<uint64_t>(std::ceil(total * percentile_ / 100));
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i != kBucketNum; ++i) {
+      seen += counts[i];
+      if (seen >= rank) {
+        value_us = GetBucketUpperBound(i);
+        break;
+      }
+    }
+  }
+  value_us_.store(value_us, std::memory_order_relaxed);
+
+  // The previous window becomes the current one, the samples of the last window are kept for the next rotation.
+  for (std::size_t i = 0; i != kBucketNum; ++i) {
+    previous.buckets[i].store(0, std::memory_order_relaxed);
+  }
+  current_.store(current ^ 1, std::memory_order_relaxed);
+}
+
+}  // namespace trpc
@@ -0,0 +1,69 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace trpc {
+
+/// @brief Tracks a percentile of the latency recorded in the last two windows.
+/// @note Latency is counted in a log-linear histogram with 8 buckets per power of two, so the result is the upper
+///       bound of its bucket, never more than 12.5% higher than the exact one. The percentile is computed once per
+///       window by the recording thread which rotates the window, reading it is a single atomic load. Windows are
+///       rotated by recording, so a window lasts until the first sample after its end.
+class LatencyPercentile {
+ public:
+  /// @param percentile The percentile to track, in (0, 100).
+  /// @param window_us Length of the window, in microseconds.
+  /// @param min_samples The minimum number of samples in the last two windows to compute the percentile.
+  LatencyPercentile(double percentile, uint64_t window_us, uint32_t min_samples);
+
+  /// @brief Record a latency sample.
+  /// @param latency_us The latency, in microseconds.
+  /// @param now_us The current steady time, in microseconds.
+  void Record(uint64_t latency_us, uint64_t now_us);
+
+  /// @brief Get the percentile as of the last window rotation, in microseconds.
+  /// @return 0 if there were fewer than `min_samples` samples.
+  uint64_t Get() const { return value_us_.load(std::memory_order_relaxed); }
+
+ private:
+  // 3 bits of mantissa, latency up to 2^32 microseconds.
+  static constexpr std::size_t kSubBucketBits = 3;
+  static constexpr std::size_t kBucketNum = (32 - kSubBucketBits + 1) << kSubBucketBits;
+
+  struct Window {
+    std::atomic<uint32_t> buckets[kBucketNum];
+  };
+
+  static std::size_t GetBucketIndex(uint64_t latency_us);
+
+  static uint64_t GetBucketUpperBound(std::size_t index);
+
+  void Rotate();
+
+ private:
+  const double percentile_;
+  const uint64_t window_us_;
+  const uint32_t min_samples_;
+
+  Window windows_[2];
+  std::atomic<uint32_t> current_{0};
+  std::atomic<uint64_t> window_begin_us_{0};
+  std::atomic<uint64_t> value_us_{0};
+};
+
+}  // namespace trpc
@@ -0,0 +1,70 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/filter/retry/latency_percentile.h"
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+TEST(LatencyPercentileTest, Percentile) {
+  LatencyPercentile latency(95, 1000, 100);
+
+  uint64_t now_us = 1000;
+  for (uint64_t i = 1; i <= 1000; ++i) {
+    latency.Record(i * 100, now_us);
+  }
+  ASSERT_EQ(latency.Get(), 0);
+
+  // Computed on rotation, within the precision of the buckets.
+  now_us += 1000;
+  latency.Record(1, now_us);
+  ASSERT_GE(latency.Get(), 95000);
+  ASSERT_LE(latency.Get(), 95000 * 1.125);
+}
+
+TEST(LatencyPercentileTest, MinSamples) {
+  LatencyPercentile latency(50, 1000, 100);
+
+  uint64_t now_us = 1000;
+  for (int i = 0; i < 99; ++i) {
+    latency.Record(10, now_us);
+  }
+  now_us += 1000;
+  latency.Record(10, now_us);
+  ASSERT_EQ(latency.Get(), 0);
+
+  // The last two windows are counted.
+  now_us += 1000;
+  latency.Record(10, now_us);
+  ASSERT_EQ(latency.Get(), 11);
+}
+
+TEST(LatencyPercentileTest, SlidingWindow) {
+  LatencyPercentile latency(50, 1000, 1);
+
+  uint64_t now_us = 1000;
+  latency.Record(3, now_us);
+  now_us += 1000;
+  latency.Record(100000, now_us);
+  ASSERT_EQ(latency.Get(), 4);
+
+  // Samples older than two windows are dropped.
+  now_us += 1000;
+  latency.Record(100000, now_us);
+  now_us += 1000;
+  latency.Record(100000, now_us);
+  ASSERT_GE(latency.Get(), 100000);
+}
+
+}  // namespace trpc::testing
@@ -18,6 +18,7 @@
 #include "trpc/client/make_client_context.h"
 #include "trpc/common/config/trpc_config.h"
 #include "trpc/filter/filter_manager.h"
+#include "trpc/filter/retry/adaptive_backup_request_client_filter.h"
 #ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
 #include "trpc/metrics/prometheus/prometheus_client_filter.h"
 #include "trpc/metrics/prometheus/prometheus_server_filter.h"
@@ -105,6 +106,9 @@ bool InitializeServerFilter() {
 
 bool InitializeClientFilter() {
   // 1. Registers the default client filter which provided by the framework.
+  // It takes effect only on the services which configure it as service-level filter.
+  FilterManager::GetInstance()->AddMessageClientFilter(std::make_shared<AdaptiveBackupRequestClientFilter>(nullptr));
+
 #ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
   FilterManager::GetInstance()->AddMessageClientFilter(std::make_shared<PrometheusClientFilter>());
 #endif
@@ -13,11 +13,17 @@
 
 #pragma once
 
+#include <atomic>
+#include <cassert>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <memory>
 #include <mutex>
+#include <new>
+#include <optional>
 #include <thread>
 #include <tuple>
 #include <utility>
@@ -55,15 +61,10 @@ Future<T...> MakeExceptionFuture(const Exception& e) {
   return Future<T...>(e);
 }
 
-/// @brief Declaration of Continuation for variable parameters.
+/// @brief Declaration of FutureImpl.
 /// @private
 template <typename... T>
-class Continuation;
-
-/// @brief Declaration of Continuation for single parameter.
-/// @private
-template <typename T>
-class Continuation<T>;
+class FutureImpl;
 
 /// @brief Executor for continuation theory,
 /// @note Corresponding promise must be set inside thread having reactor.
@@ -84,32 +85,45 @@ static inline Executor* GetExecutor() {
                                          : static_cast<Executor*>(&kDefaultInlineExecutor);
 }
 
+/// @brief Continuations no larger than this are constructed inside the future state rather than on heap.
+/// @private
+constexpr std::size_t kInlineContinuationSize = 64;
+
+/// @brief Derived by continuations, which are run once future got result, to handle result of future.
+/// @private
+class ContinuationBase;
+
 /// @brief Inherited by FutureState to stand for state of FutureImpl.
 /// @private
 struct FutureStateBase {
+  // Bits of `status`. State of future goes from empty to either of result or callback set, and then to both set.
+  // Who sets the latter bit is responsible for scheduling callback, so callback is scheduled only once without lock.
+  static constexpr uint8_t kHasResult = 1;
+  static constexpr uint8_t kHasCallback = 2;
+
   // Future is ready or not.
-  bool ready = false;
+  std::atomic<bool> ready = false;
 
   // Future is failed or not.
-  bool failed = false;
-
-  // Future is either ready or failed when true.
-  bool has_result = false;
+  std::atomic<bool> failed = false;
 
-  // Is callback set through Then to this Future.
-  bool has_callback = false;
+  // Whether result and callback have been set, see `kHasResult` and `kHasCallback`.
+  std::atomic<uint8_t> status = 0;
 
-  // Is callback already been scheduled, to control only once may callback be called.
-  std::atomic_flag schedule_flag = ATOMIC_FLAG_INIT;
+  // Is callback constructed inside `callback_storage`.
+  bool callback_inline = false;
 
   // Since FutureImpl may hold by Future and Promise, use ref to determin when to free FutureImpl.
   std::atomic<int> ref_count = 1;
 
-  // Synchronize ready/failed/has_result/has_callback between maybe two threads holding current state.
-  std::mutex mtx;
-
   // Store exception when Futuren failed.
   Exception exception;
+
+  // Callback set through Then to this Future.
+  ContinuationBase* callback = nullptr;
+
+  // Storage of small callback, saves a heap allocation per Then.
+  alignas(std::max_align_t) unsigned char callback_storage[kInlineContinuationSize];
 };
 
 /// @brief Variable parameters version of FutureState.
@@ -121,8 +135,6 @@ struct FutureState : public FutureStateBase {
   explicit FutureState(std::tuple<T...>&& val) : value(std::move(val)) {}
 
   std::tuple<T...> value;
-
-  Continuation<T...>* callback = nullptr;
 };
 
 /// @brief Single parameter version of FutureState.
@@ -138,10 +150,12 @@ struct FutureState<T> : public FutureStateBase {
   explicit FutureState(T&& val) : value(std::move(val)) {}
 
   T value;
-
-  Continuation<T>* callback = nullptr;
 };
 
+/// @brief Derived by multiple parameters and single parameter version of FutureImpl.
+/// @private
+class FutureImplBase;
+
 /// @brief Derived by Continuation.
 /// @private
 class ContinuationBase {
@@ -150,32 +164,24 @@ class ContinuationBase {
   virtual ~ContinuationBase() = default;
 
   /// @brief Need to implemented by subclass to determined the way future result handled.
-  virtual void Run() = 0;
+  /// @param future Future which got result, value or exception is moved out of it rather than copied into continuation.
+  virtual void Run(FutureImplBase* future) = 0;
 
   /// @brief Bind executor to current continuation.
   inline void SetExecutor(Executor* executor) { executor_ = executor; }
 
-  /// @brief Bind exception to current continuation.
-  inline void SetException(Exception&& e) {
-    failed_ = true;
-    e_ = std::move(e);
-  }
-
-  /// @brief Try to submit current continuation task to certain executor.
+  /// @brief Try to submit task running current continuation to certain executor.
   ///        Fall back to current thread if submit failed.
   /// @note Task only exeuted once.
-  inline void Schedule(ContinuationBase* task) {
+  template <typename Func>
+  inline void Schedule(const Func& task) {
     // Use default executor if no one set by uses.
     auto executor = executor_ ? executor_ : GetExecutor();
-    bool ret = executor->SubmitTask([task]() mutable {
-      task->Run();
-      delete task;
-    });
+    bool ret = executor->SubmitTask(task);
 
     // Fall back to current thread.
     if (!ret) {
-      task->Run();
-      delete task;
+      task();
     }
   }
 
@@ -186,61 +192,14 @@ class ContinuationBase {
  protected:
   // Store executor set bu users, default to null.
   Executor* executor_ = nullptr;
-
-  // Corresponding future is ready or not.
-  bool ready_ = false;
-
-  // Corresponding future is failed or not.
-  bool failed_ = false;
-
-  // Store exception if future failed.
-  Exception e_;
-};
-
-/// @brief Multiple parameters version of Continuation.
-/// @private
-template <typename... T>
-class Continuation : public ContinuationBase {
- public:
-  ~Continuation() override = default;
-
-  // Set the value callback will reference to when current future is ready.
-  void SetValue(std::tuple<T...>&& value) noexcept {
-    ready_ = true;
-    value_ = std::move(value);
-  }
-
- protected:
-  // Value type with tuple.
-  std::tuple<T...> value_;
-};
-
-/// @brief Single parameter version of Continuation.
-/// @private
-template <typename T>
-class Continuation<T> : public ContinuationBase {
- public:
-  ~Continuation() override = default;
-
-  // Set the value callback will reference to when current future is ready.
-  void SetValue(T&& value) noexcept {
-    ready_ = true;
-    value_ = std::move(value);
-  }
-
- protected:
-  // Value type with Future template parameter, better performance.
-  T value_;
 };
 
 /// @brief Firstly, current future is of multiple parameters.
 ///        Secondly, user call Then with callback parametered with value and return next Future.
 /// @private
 template <typename Func, typename PromiseType, typename... T>
-class ContinuationWithValue : public Continuation<T...> {
+class ContinuationWithValue : public ContinuationBase {
  public:
-  using BaseClass = Continuation<T...>;
-
   /// @brief Constructor.
   ContinuationWithValue(Func&& func, PromiseType&& promise)
       : func_(std::forward<Func>(func)), promise_(std::forward<PromiseType>(promise)) {}
@@ -249,14 +208,15 @@ class ContinuationWithValue : public Continuation<T...> {
   ~ContinuationWithValue() override = default;
 
   /// @brief Callback will not run if current future failed, only pass exception to next Future/Promise.
-  void Run() override {
-    if (BaseClass::failed_) {
-      promise_.SetException(BaseClass::e_);
+  void Run(FutureImplBase* base) override {
+    auto* future = static_cast<FutureImpl<T...>*>(base);
+    if (!future->IsReady()) {
+      promise_.SetException(future->GetException());
       return;
     }
 
     // Have to make tuple before pass value to callback.
-    auto r = std::apply<Func, std::tuple<T...>>(std::move(func_), std::move(BaseClass::value_));
+    auto r = std::apply<Func, std::tuple<T...>>(std::move(func_), future->GetValue());
     ContinuationBase::ChainFuture(std::move(r), std::move(promise_));
   }
 
@@ -272,10 +232,8 @@ class ContinuationWithValue : public Continuation<T...> {
 ///        Secondly, user call Then with callback parametered with value and return next future.
 /// @private
 template <typename Func, typename PromiseType, typename T>
-class ContinuationWithValue<Func, PromiseType, T> : public Continuation<T> {
+class ContinuationWithValue<Func, PromiseType, T> : public ContinuationBase {
  public:
-  using BaseClass = Continuation<T>;
-
   /// @brief Constructor.
   ContinuationWithValue(Func&& func, PromiseType&& promise)
       : func_(std::forward<Func>(func)), promise_(std::forward<PromiseType>(promise)) {}
@@ -284,14 +242,15 @@ class ContinuationWithValue<Func, PromiseType, T> : public Continuation<T> {
   ~ContinuationWithValue() override = default;
 
   /// @brief Callback will not run if current future failed, only pass exception to next Future/Promise.
-  void Run() override {
-    if (BaseClass::failed_) {
-      promise_.SetException(BaseClass::e_);
+  void Run(FutureImplBase* base) override {
+    auto* future = static_cast<FutureImpl<T>*>(base);
+    if (!future->IsReady()) {
+      promise_.SetException(future->GetException());
       return;
     }
 
     // Just pass value to callback.
-    auto r = std::invoke<Func, T>(std::move(func_), std::move(BaseClass::value_));
+    auto r = std::invoke<Func, T>(std::move(func_), future->GetValue());
     ContinuationBase::ChainFuture(std::move(r), std::move(promise_));
   }
 
@@ -307,10 +266,8 @@ class ContinuationWithValue<Func, PromiseType, T> : public Continuation<T> {
 ///        Secondly, user call Then with callback parametered with value and return void.
 /// @private
 template <typename Func, typename... T>
-class TerminalWithValue : public Continuation<T...> {
+class TerminalWithValue : public ContinuationBase {
  public:
-  using BaseClass = Continuation<T...>;
-
   /// @brief Constructor.
   explicit TerminalWithValue(Func&& func) : func_(std::forward<Func>(func)) {}
 
@@ -318,13 +275,14 @@ class TerminalWithValue : public Continuation<T...> {
   ~TerminalWithValue() override = default;
 
   /// @brief Callback will not run if current future failed.
-  void Run() override {
-    if (BaseClass::failed_) {
+  void Run(FutureImplBase* base) override {
+    auto* future = static_cast<FutureImpl<T...>*>(base);
+    if (!future->IsReady()) {
       return;
     }
 
     // Have to make tuple before pass value to callback.
-    std::apply<Func, std::tuple<T...>>(std::move(func_), std::move(BaseClass::value_));
+    std::apply<Func, std::tuple<T...>>(std::move(func_), future->GetValue());
   }
 
  private:
@@ -336,22 +294,21 @@ class TerminalWithValue : public Continuation<T...> {
 ///        Secondly, user call Then with callback parametered with value and return void.
 /// @private
 template <typename Func, typename T>
-class TerminalWithValue<Func, T> : public Continuation<T> {
+class TerminalWithValue<Func, T> : public ContinuationBase {
  public:
-  using BaseClass = Continuation<T>;
-
   explicit TerminalWithValue(Func&& func) : func_(std::forward<Func>(func)) {}
 
   ~TerminalWithValue() override = default;
 
   /// @brief Callback will not run if current future failed.
-  void Run() override {
-    if (BaseClass::failed_) {
+  void Run(FutureImplBase* base) override {
+    auto* future = static_cast<FutureImpl<T>*>(base);
+    if (!future->IsReady()) {
       return;
     }
 
     // Just pass value to callback.
-    std::invoke<Func, T>(std::move(func_), std::move(BaseClass::value_));
+    std::invoke<Func, T>(std::move(func_), future->GetValue());
   }
 
  private:
@@ -363,27 +320,17 @@ class TerminalWithValue<Func, T> : public Continuation<T> {
 ///        Regardless of how many parameters current future have.
 /// @private
 template <typename Func, typename PromiseType, typename... T>
-class ContinuationWithFuture : public Continuation<T...> {
+class ContinuationWithFuture : public ContinuationBase {
  public:
-  using BaseClass = Continuation<T...>;
-
   ContinuationWithFuture(Func&& func, PromiseType&& promise)
       : func_(std::forward<Func>(func)), promise_(std::forward<PromiseType>(promise)) {}
 
   ~ContinuationWithFuture() override = default;
 
   /// @brief Callback will be run no matter what state is current future.
-  void Run() override {
-    Promise<T...> promise;
-
-    if (BaseClass::failed_) {
-      promise.SetException(BaseClass::e_);
-    } else {
-      promise.SetValue(std::move(BaseClass::value_));
-    }
-
-    // Use intermediate Future/Promise to chain current future with next future.
-    auto r = func_(std::move(promise.GetFuture()));
+  void Run(FutureImplBase* base) override {
+    // Use intermediate Future to chain current future with next future.
+    auto r = func_(static_cast<FutureImpl<T...>*>(base)->MoveToFuture());
     ContinuationBase::ChainFuture(std::move(r), std::move(promise_));
   }
 
@@ -399,26 +346,16 @@ class ContinuationWithFuture : public Continuation<T...> {
 ///        Regardless of how many parameters current future have.
 /// @private
 template <typename Func, typename... T>
-class TerminalWithFuture : public Continuation<T...> {
+class TerminalWithFuture : public ContinuationBase {
  public:
-  using BaseClass = Continuation<T...>;
-
   explicit TerminalWithFuture(Func&& func) : func_(std::forward<Func>(func)) {}
 
   ~TerminalWithFuture() override = default;
 
   /// @brief Callback will be run no matter what state is current future.
-  void Run() override {
-    Promise<T...> promise;
-
-    if (BaseClass::failed_) {
-      promise.SetException(BaseClass::e_);
-    } else {
-      promise.SetValue(std::move(BaseClass::value_));
-    }
-
+  void Run(FutureImplBase* base) override {
     // Fill callback with intermediate future.
-    func_(std::move(promise.GetFuture()));
+    func_(static_cast<FutureImpl<T...>*>(base)->MoveToFuture());
   }
 
  private:
@@ -438,13 +375,15 @@ class FutureImplBase {
   void Init(FutureStateBase* state_base) { state_base_ = state_base; }
 
   /// @brief Called before get value of future.
-  inline bool IsReady() const noexcept { return state_base_->ready; }
+  inline bool IsReady() const noexcept { return state_base_->ready.load(std::memory_order_acquire); }
 
   /// @brief Called before get exception of future.
-  inline bool IsFailed() const noexcept { return state_base_->failed; }
+  inline bool IsFailed() const noexcept { return state_base_->failed.load(std::memory_order_acquire); }
 
   /// @brief Either future is ready or failed.
-  inline bool HasResult() const noexcept { return state_base_->has_result; }
+  inline bool HasResult() const noexcept {
+    return state_base_->status.load(std::memory_order_acquire) & FutureStateBase::kHasResult;
+  }
 
   /// @brief Wait for future ready or failed, return if timeout expired. It't deprecated.
   /// @note Do not call this inside framework threads or users threads, as it blocks everything.
@@ -452,13 +391,7 @@ class FutureImplBase {
     int64_t timeout_us = timeout * 1000;
     auto start = std::chrono::system_clock::now();
 
-    while (true) {
-      {
-        std::lock_guard<std::mutex> lock(state_base_->mtx);
-        if (state_base_->has_result) {
-          break;
-        }
-      }
+    while (!HasResult()) {
       std::this_thread::sleep_for(std::chrono::microseconds(100));
       auto now = std::chrono::system_clock::now();
       auto diff = std::chrono::duration_cast<std::chrono::microseconds>(now - start);
@@ -472,7 +405,7 @@ class FutureImplBase {
 
   /// @brief Should be called only once, as state changed after first call.
   Exception GetException() noexcept {
-    state_base_->failed = false;
+    state_base_->failed.store(false, std::memory_order_relaxed);
     return state_base_->exception;
   }
 
@@ -480,6 +413,45 @@ class FutureImplBase {
   /// @brief Normally called by get pair future of promise, to avoid wild pointer.
   inline void Attach() noexcept { state_base_->ref_count.fetch_add(1, std::memory_order_relaxed); }
 
+  /// @brief Construct callback, inside the state if small enough.
+  /// @return Whether result has been set already, callback should be scheduled by caller if so.
+  template <typename ContinuationType, typename... Args>
+  bool EmplaceCallback(Executor* executor, Args&&... args) {
+    ContinuationBase* callback = nullptr;
+    if constexpr (sizeof(ContinuationType) <= kInlineContinuationSize &&
+                  alignof(ContinuationType) <= alignof(std::max_align_t)) {
+      callback = new (state_base_->callback_storage) ContinuationType(std::forward<Args>(args)...);
+      state_base_->callback_inline = true;
+    } else {
+      callback = new ContinuationType(std::forward<Args>(args)...);
+    }
+    if (executor) callback->SetExecutor(executor);
+    state_base_->callback = callback;
+
+    return SetStatus(FutureStateBase::kHasCallback);
+  }
+
+  /// @brief Publish result set to future.
+  /// @return Whether callback has been set already, callback should be scheduled by caller if so.
+  bool PublishResult() noexcept { return SetStatus(FutureStateBase::kHasResult); }
+
+  /// @brief Destroy callback, either finished or never scheduled.
+  void DestroyCallback() noexcept {
+    ContinuationBase* callback = std::exchange(state_base_->callback, nullptr);
+    if (state_base_->callback_inline) {
+      callback->~ContinuationBase();
+    } else {
+      delete callback;
+    }
+  }
+
+ private:
+  // Only the one who completes both result and callback gets true, at most once.
+  bool SetStatus(uint8_t flag) noexcept {
+    uint8_t prev = state_base_->status.fetch_or(flag, std::memory_order_acq_rel);
+    return prev != 0 && (prev & flag) == 0;
+  }
+
  private:
   FutureStateBase* state_base_ = nullptr;
 };
@@ -498,16 +470,20 @@ class FutureImpl : public FutureImplBase {
   explicit FutureImpl(std::tuple<T...>&& value) noexcept : state_(std::move(value)) {
     FutureImplBase::Init(&state_);
     state_.ready = true;
-    state_.has_result = true;
+    state_.status = FutureStateBase::kHasResult;
   }
 
-  ~FutureImpl() noexcept = default;
+  ~FutureImpl() noexcept {
+    if (state_.callback) {
+      DestroyCallback();
+    }
+  }
 
   /// @brief Make sure future is ready before calling.
   /// @note After calling, future is not ready any more.
   std::tuple<T...>&& GetValue() noexcept {
     assert(state_.ready);
-    state_.ready = false;
+    state_.ready.store(false, std::memory_order_relaxed);
     return std::move(state_.value);
   }
 
@@ -518,6 +494,14 @@ class FutureImpl : public FutureImplBase {
     return state_.value;
   }
 
+  /// @brief Move result out into a standalone future, which is not allocated if ready.
+  Future<T...> MoveToFuture() noexcept {
+    if (!IsReady()) {
+      return Future<T...>(GetException());
+    }
+    return std::apply([](T&&... v) { return Future<T...>(MakeReadyFutureHelper(), std::move(v)...); }, GetValue());
+  }
+
   /// @brief Callback registered through Then with parameters type by Value, and returned result typed by Future.
   /// @tparam FutureType Next Future type.
   /// @tparam PromiseType Pair with FutureType.
@@ -528,15 +512,10 @@ class FutureImpl : public FutureImplBase {
   template <typename FutureType, typename PromiseType = typename FutureType::PromiseType,
             typename Func = Function<FutureType(T&&...)>>
   void SetCallback(PromiseType&& promise, Func&& func, Executor* executor) {
-    state_.callback = new ContinuationWithValue<Func, PromiseType, T...>(std::forward<Func>(func),
-                                                                         std::forward<PromiseType>(promise));
-    if (executor) state_.callback->SetExecutor(executor);
-    state_.has_callback = true;
-
-    std::lock_guard<std::mutex> lock(state_.mtx);
-    // Got immediately executed.
-    if (HasResult()) {
-      TrySchedule();
+    // Got immediately executed if result is set already.
+    if (EmplaceCallback<ContinuationWithValue<Func, PromiseType, T...>>(executor, std::forward<Func>(func),
+                                                                         std::forward<PromiseType>(promise))) {
+      ScheduleCallback();
     }
   }
 
@@ -547,14 +526,8 @@ class FutureImpl : public FutureImplBase {
   /// @param executor User specified executor, default to null.
   template <typename NotFutureType, typename Func = Function<NotFutureType(T&&...)>>
   void SetTerminalCallback(Func&& func, Executor* executor) {
-    state_.callback = new TerminalWithValue<Func, T...>(std::forward<Func>(func));
-    if (executor) state_.callback->SetExecutor(executor);
-    state_.has_callback = true;
-
-    std::lock_guard<std::mutex> lock(state_.mtx);
-    // Got immediately executed.
-    if (HasResult()) {
-      TrySchedule();
+    if (EmplaceCallback<TerminalWithValue<Func, T...>>(executor, std::forward<Func>(func))) {
+      ScheduleCallback();
     }
   }
 
@@ -568,15 +541,9 @@ class FutureImpl : public FutureImplBase {
   template <typename FutureType, typename PromiseType = typename FutureType::PromiseType,
             typename Func = Function<FutureType(Future<T...>&&)>>
   void SetCallbackWrapped(PromiseType&& promise, Func&& func, Executor* executor) {
-    state_.callback = new ContinuationWithFuture<Func, PromiseType, T...>(std::forward<Func>(func),
-                                                                          std::forward<PromiseType>(promise));
-    if (executor) state_.callback->SetExecutor(executor);
-    state_.has_callback = true;
-
-    std::lock_guard<std::mutex> lock(state_.mtx);
-    // Got immediately executed.
-    if (HasResult()) {
-      TrySchedule();
+    if (EmplaceCallback<ContinuationWithFuture<Func, PromiseType, T...>>(executor, std::forward<Func>(func),
+                                                                          std::forward<PromiseType>(promise))) {
+      ScheduleCallback();
     }
   }
 
@@ -587,69 +554,48 @@ class FutureImpl : public FutureImplBase {
   /// @param executor User specified executor, default to null.
   template <typename NotFutureType, typename Func = Function<NotFutureType(Future<T...>&&)>>
   void SetTerminalCallbackWrapped(Func&& func, Executor* executor) {
-    state_.callback = new TerminalWithFuture<Func, T...>(std::forward<Func>(func));
-    if (executor) state_.callback->SetExecutor(executor);
-    state_.has_callback = true;
-
-    std::lock_guard<std::mutex> lock(state_.mtx);
-    // Got immediately executed.
-    if (HasResult()) {
-      TrySchedule();
+    if (EmplaceCallback<TerminalWithFuture<Func, T...>>(executor, std::forward<Func>(func))) {
+      ScheduleCallback();
     }
   }
 
   /// @brief Ready value set through promise.
   void SetValue(std::tuple<T...>&& value) {
     state_.value = std::move(value);
-    state_.ready = true;
-    // Result state may be looped by another thread.
-    {
-      std::lock_guard<std::mutex> lock(state_.mtx);
-      state_.has_result = true;
+    state_.ready.store(true, std::memory_order_release);
+    if (PublishResult()) {
+      ScheduleCallback();
     }
-    TrySchedule();
   }
 
   /// @brief Exceptional value set through promise.
   void SetException(const Exception& e) {
     state_.exception = e;
-    state_.failed = true;
-    // Result state may be looped by another thread.
-    {
-      std::lock_guard<std::mutex> lock(state_.mtx);
-      state_.has_result = true;
+    state_.failed.store(true, std::memory_order_release);
+    if (PublishResult()) {
+      ScheduleCallback();
     }
-    TrySchedule();
   }
 
   /// @brief Support non const parameter.
   void SetException(Exception&& e) {
     state_.exception = std::move(e);
-    state_.failed = true;
-    {
-      std::lock_guard<std::mutex> lock(state_.mtx);
-      state_.has_result = true;
+    state_.failed.store(true, std::memory_order_release);
+    if (PublishResult()) {
+      ScheduleCallback();
     }
-    TrySchedule();
   }
 
  private:
-  /// @brief Future may or may not registered callback yet, check to inspire callback.
-  /// @note Callback can only inspired once.
-  void TrySchedule() {
-    if (state_.has_callback) {
-      if (IsReady()) {
-        if (state_.schedule_flag.test_and_set() == false) {
-          state_.callback->SetValue(GetValue());
-          state_.callback->Schedule(state_.callback);
-        }
-      } else if (IsFailed()) {
-        if (state_.schedule_flag.test_and_set() == false) {
-          state_.callback->SetException(GetException());
-          state_.callback->Schedule(state_.callback);
-        }
-      }
-    }
+  /// @brief Schedule callback once both result and callback are set.
+  /// @note Callback lives in and reads result from current state, so state is kept alive until callback finished.
+  void ScheduleCallback() {
+    Attach();
+    state_.callback->Schedule([this]() {
+      state_.callback->Run(this);
+      DestroyCallback();
+      Detach();
+    });
   }
 
   /// @brief Protected from wild pointer.
@@ -679,15 +625,19 @@ class FutureImpl<T> : public FutureImplBase {
   explicit FutureImpl(T&& value) noexcept : state_(std::move(value)) {
     FutureImplBase::Init(&state_);
     state_.ready = true;
-    state_.has_result = true;
+    state_.status = FutureStateBase::kHasResult;
   }
 
-  ~FutureImpl() noexcept = default;
+  ~FutureImpl() noexcept {
+    if (state_.callback) {
+      DestroyCallback();
+    }
+  }
 
   /// @brief Same as multiple version.
   T&& GetValue() noexcept {
     assert(state_.ready);
-    state_.ready = false;
+    state_.ready.store(false, std::memory_order_relaxed);
     return std::move(state_.value);
   }
 
@@ -697,31 +647,29 @@ class FutureImpl<T> : public FutureImplBase {
     return state_.value;
   }
 
+  /// @brief Same as multiple version.
+  Future<T> MoveToFuture() noexcept {
+    if (!IsReady()) {
+      return Future<T>(GetException());
+    }
+    return Future<T>(MakeReadyFutureHelper(), GetValue());
+  }
+
   /// @brief Same as multiple version.
   template <typename FutureType, typename PromiseType = typename FutureType::PromiseType,
             typename Func = Function<FutureType(T&&)>>
   void SetCallback(PromiseType&& promise, Func&& func, Executor* executor) {
-    state_.callback =
-        new ContinuationWithValue<Func, PromiseType, T>(std::forward<Func>(func), std::forward<PromiseType>(promise));
-    if (executor) state_.callback->SetExecutor(executor);
-    state_.has_callback = true;
-
-    std::lock_guard<std::mutex> lock(state_.mtx);
-    if (HasResult()) {
-      TrySchedule();
+    if (EmplaceCallback<ContinuationWithValue<Func, PromiseType, T>>(executor, std::forward<Func>(func),
+                                                                      std::forward<PromiseType>(promise))) {
+      ScheduleCallback();
     }
   }
 
   /// @brief Same as multiple version.
   template <typename FutureType, typename Func = Function<FutureType(T&&)>>
   void SetTerminalCallback(Func&& func, Executor* executor) {
-    state_.callback = new TerminalWithValue<Func, T>(std::forward<Func>(func));
-    if (executor) state_.callback->SetExecutor(executor);
-    state_.has_callback = true;
-
-    std::lock_guard<std::mutex> lock(state_.mtx);
-    if (HasResult()) {
-      TrySchedule();
+    if (EmplaceCallback<TerminalWithValue<Func, T>>(executor, std::forward<Func>(func))) {
+      ScheduleCallback();
     }
   }
 
@@ -729,79 +677,56 @@ class FutureImpl<T> : public FutureImplBase {
   template <typename FutureType, typename PromiseType = typename FutureType::PromiseType,
             typename Func = Function<FutureType(Future<T>&&)>>
   void SetCallbackWrapped(PromiseType&& promise, Func&& func, Executor* executor) {
-    state_.callback =
-        new ContinuationWithFuture<Func, PromiseType, T>(std::forward<Func>(func), std::forward<PromiseType>(promise));
-    if (executor) state_.callback->SetExecutor(executor);
-    state_.has_callback = true;
-
-    std::lock_guard<std::mutex> lock(state_.mtx);
-    if (HasResult()) {
-      TrySchedule();
+    if (EmplaceCallback<ContinuationWithFuture<Func, PromiseType, T>>(executor, std::forward<Func>(func),
+                                                                       std::forward<PromiseType>(promise))) {
+      ScheduleCallback();
     }
   }
 
   /// @brief Same as multiple version.
   template <typename FutureType, typename Func = Function<FutureType(Future<T>&&)>>
   void SetTerminalCallbackWrapped(Func&& func, Executor* executor) {
-    state_.callback = new TerminalWithFuture<Func, T>(std::forward<Func>(func));
-    if (executor) state_.callback->SetExecutor(executor);
-    state_.has_callback = true;
-
-    std::lock_guard<std::mutex> lock(state_.mtx);
-    if (HasResult()) {
-      TrySchedule();
+    if (EmplaceCallback<TerminalWithFuture<Func, T>>(executor, std::forward<Func>(func))) {
+      ScheduleCallback();
     }
   }
 
   /// @brief Same as multiple version.
   void SetValue(T&& value) {
     state_.value = std::move(value);
-    state_.ready = true;
-    {
-      std::lock_guard<std::mutex> lock(state_.mtx);
-      state_.has_result = true;
+    state_.ready.store(true, std::memory_order_release);
+    if (PublishResult()) {
+      ScheduleCallback();
     }
-    TrySchedule();
   }
 
   /// @brief Same as multiple version.
   void SetException(const Exception& e) {
     state_.exception = e;
-    state_.failed = true;
-    {
-      std::lock_guard<std::mutex> lock(state_.mtx);
-      state_.has_result = true;
+    state_.failed.store(true, std::memory_order_release);
+    if (PublishResult()) {
+      ScheduleCallback();
     }
-    TrySchedule();
   }
 
   /// @brief Same as multiple version.
   void SetException(Exception&& e) {
     state_.exception = std::move(e);
-    state_.failed = true;
-    {
-      std::lock_guard<std::mutex> lock(state_.mtx);
-      state_.has_result = true;
+    state_.failed.store(true, std::memory_order_release);
+    if (PublishResult()) {
+      ScheduleCallback();
     }
-    TrySchedule();
   }
 
  private:
   /// @brief Same as multiple version.
-  void TrySchedule() {
-    if (state_.has_callback) {
-      if (IsReady()) {
-        if (state_.schedule_flag.test_and_set() == false) {
-          state_.callback->SetValue(GetValue());
-          state_.callback->Schedule(state_.callback);
-        }
-      } else if (IsFailed()) {
-        if (state_.schedule_flag.test_and_set() == false) {
-          state_.callback->SetException(GetException());
-          state_.callback->Schedule(state_.callback);
-        }
-      }
-    }
+  void ScheduleCallback() {
+    Attach();
+    state_.callback->Schedule([this]() {
+      state_.callback->Run(this);
+      DestroyCallback();
+      Detach();
+    });
   }
 
   /// @brief Same as multiple version.
@@ -868,9 +793,7 @@ class Future {
   }
 
   /// @brief Used by MakeReadyFuture.
-  explicit Future(MakeReadyFutureHelper no_sense, T&&... v) noexcept {
-    future_ = new FutureImpl<T...>(std::make_tuple<T...>(std::move(v)...));
-  }
+  explicit Future(MakeReadyFutureHelper no_sense, T&&... v) noexcept : ready_value_(std::in_place, std::move(v)...) {}
 
   /// @brief Used by MakeExceptionFuture.
   explicit Future(const Exception& e) noexcept {
@@ -878,17 +801,19 @@ class Future {
     future_->SetException(e);
   }
 
-  Future(Future&& o) noexcept : future_(std::exchange(o.future_, nullptr)) {}
+  Future(Future&& o) noexcept
+      : future_(std::exchange(o.future_, nullptr)), ready_value_(std::exchange(o.ready_value_, std::nullopt)) {}
 
   Future& operator=(Future&& o) noexcept {
     Detach();
     future_ = std::exchange(o.future_, nullptr);
+    ready_value_ = std::exchange(o.ready_value_, std::nullopt);
     return *this;
   }
 
-  bool IsReady() const noexcept { return future_->IsReady(); }
+  bool IsReady() const noexcept { return ready_value_.has_value() || (future_ && future_->IsReady()); }
 
-  bool IsFailed() const noexcept { return future_->IsFailed(); }
+  bool IsFailed() const noexcept { return future_ && future_->IsFailed(); }
 
   /// @brief Deprecated due to bad function name, use IsReady instead.
   [[deprecated("Use IsReady instead")]] bool is_ready() const noexcept { return IsReady(); }
@@ -941,17 +866,26 @@ class Future {
   /// @note No recommend to use it due to the function has poor performance.
   /// @param timeout milliseconds that to be waited.
   /// @return false when timeout, true when result ready or exception occured.
-  bool Wait(const uint32_t timeout = UINT32_MAX) noexcept { return future_->Wait(timeout); }
+  bool Wait(const uint32_t timeout = UINT32_MAX) noexcept { return !future_ || future_->Wait(timeout); }
 
   /// @brief Get value from a ready future, after call this function, this future is not ready anymore.
-  std::tuple<T...> GetValue() noexcept { return future_->GetValue(); }
+  std::tuple<T...> GetValue() noexcept {
+    if (ready_value_) {
+      std::tuple<T...> value = std::move(*ready_value_);
+      ready_value_.reset();
+      return value;
+    }
+    return future_->GetValue();
+  }
 
   /// @brief Get the const reference of value from a ready future, after call this function,
   ///        this future is still ready.
-  const std::tuple<T...>& GetConstValue() const noexcept { return future_->GetConstValue(); }
+  const std::tuple<T...>& GetConstValue() const noexcept {
+    return ready_value_ ? *ready_value_ : future_->GetConstValue();
+  }
 
   /// @brief Get exception from a failed future, after call this function, this future is not failed anymore.
-  Exception GetException() noexcept { return future_->GetException(); }
+  Exception GetException() noexcept { return future_ ? future_->GetException() : Exception(); }
 
  private:
   void Detach() {
@@ -961,6 +895,15 @@ class Future {
     }
   }
 
+  /// @brief Get shared state to set callback to, move the value kept inline into a new one if not created yet.
+  FutureImpl<T...>* GetOrCreateImpl() {
+    if (ready_value_) {
+      future_ = new FutureImpl<T...>(std::move(*ready_value_));
+      ready_value_.reset();
+    }
+    return future_;
+  }
+
   /// @brief Add a callback to future. When this future is ready, this callback will run with
   ///        future value as parameters. If this future is failed, this callback will be ignored.
   template <typename Func, typename R = typename std::invoke_result<Func, T&&...>::type>
@@ -968,7 +911,7 @@ class Future {
   InnerThen(Func&& func, Executor* executor = nullptr) {
     typename R::PromiseType promise;  // transport a empty promise to callback
     auto future = promise.GetFuture();
-    future_->template SetCallback<R>(std::move(promise), std::forward<Func>(func), executor);
+    GetOrCreateImpl()->template SetCallback<R>(std::move(promise), std::forward<Func>(func), executor);
     return future;
   }
 
@@ -978,7 +921,7 @@ class Future {
   template <typename Func, typename R = typename std::invoke_result<Func, T&&...>::type>
   typename std::enable_if<std::is_void<R>::value, R>::type
   InnerThen(Func&& func, Executor* executor = nullptr) {
-    future_->template SetTerminalCallback<Type>(std::forward<Func>(func), executor);
+    GetOrCreateImpl()->template SetTerminalCallback<Type>(std::forward<Func>(func), executor);
   }
 
   /// @brief Add a callback to future. When this future is ready or failed, this callback will run
@@ -989,7 +932,7 @@ class Future {
   InnerThenWrapped(Func&& func, Executor* executor = nullptr) {
     typename R::PromiseType promise;
     auto future = promise.GetFuture();
-    future_->template SetCallbackWrapped<R>(std::move(promise), std::forward<Func>(func), executor);
+    GetOrCreateImpl()->template SetCallbackWrapped<R>(std::move(promise), std::forward<Func>(func), executor);
     return future;
   }
 
@@ -999,13 +942,14 @@ class Future {
   template <typename Func, typename R = typename std::invoke_result<Func, Future<T...>&&>::type>
   typename std::enable_if<std::is_void<R>::value, R>::type
   InnerThenWrapped(Func&& func, Executor* executor = nullptr) {
-    future_->template SetTerminalCallbackWrapped<Type>(std::forward<Func>(func), executor);
+    GetOrCreateImpl()->template SetTerminalCallbackWrapped<Type>(std::forward<Func>(func), executor);
   }
 
  private:
   FutureImpl<T...>* future_ = nullptr;
 
-  friend class ContinuationBase;
+  // Value of future made ready on creation, kept inline to save allocating shared state.
+  std::optional<std::tuple<T...>> ready_value_;
 };
 
 /// @brief Future's specialized version with single parameter.
@@ -1034,7 +978,7 @@ class Future<T> {
   }
 
   /// @brief Used by MakeReadyFuture.
-  explicit Future(MakeReadyFutureHelper no_sense, T&& v) noexcept { future_ = new FutureImpl<T>(std::move(v)); }
+  explicit Future(MakeReadyFutureHelper no_sense, T&& v) noexcept : ready_value_(std::in_place, std::move(v)) {}
 
   /// @brief Used by MakeExceptionFuture.
   explicit Future(const Exception& e) noexcept {
@@ -1042,17 +986,19 @@ class Future<T> {
     future_->SetException(e);
   }
 
-  Future(Future&& o) noexcept : future_(std::exchange(o.future_, nullptr)) {}
+  Future(Future&& o) noexcept
+      : future_(std::exchange(o.future_, nullptr)), ready_value_(std::exchange(o.ready_value_, std::nullopt)) {}
 
   Future& operator=(Future&& o) noexcept {
     Detach();
     future_ = std::exchange(o.future_, nullptr);
+    ready_value_ = std::exchange(o.ready_value_, std::nullopt);
     return *this;
   }
 
-  bool IsReady() const noexcept { return future_->IsReady(); }
+  bool IsReady() const noexcept { return ready_value_.has_value() || (future_ && future_->IsReady()); }
 
-  bool IsFailed() const noexcept { return future_->IsFailed(); }
+  bool IsFailed() const noexcept { return future_ && future_->IsFailed(); }
 
   /// @brief Deprecated due to bad function name, use IsReady instead.
   [[deprecated("Use IsReady instead")]] bool is_ready() const noexcept { return IsReady(); }
@@ -1104,21 +1050,28 @@ class Future<T> {
 
   /// @brief Wait result the future to return.
   /// @note No recommend to use it due to poor performance.
-  bool Wait(const uint32_t timeout = UINT32_MAX) noexcept { return future_->Wait(timeout); }
+  bool Wait(const uint32_t timeout = UINT32_MAX) noexcept { return !future_ || future_->Wait(timeout); }
 
   /// @brief Get value from a ready future, after call this function, this future is not ready anymore.
-  std::tuple<T> GetValue() noexcept { return std::make_tuple<T>(future_->GetValue()); }
+  std::tuple<T> GetValue() noexcept { return std::make_tuple<T>(GetValue0()); }
 
   /// @brief Get the const reference of value from a ready future, after call this function,
   ///        this future is still ready.
-  const T& GetConstValue() const noexcept { return future_->GetConstValue(); }
+  const T& GetConstValue() const noexcept { return ready_value_ ? *ready_value_ : future_->GetConstValue(); }
 
   /// @brief High performace method to get value from a ready future, after call this function,
   ///        this future is not ready anymore.
-  T GetValue0() noexcept { return future_->GetValue(); }
+  T GetValue0() noexcept {
+    if (ready_value_) {
+      T value = std::move(*ready_value_);
+      ready_value_.reset();
+      return value;
+    }
+    return future_->GetValue();
+  }
 
   /// @brief Get exception from a failed future, after call this function, this future is not failed anymore.
-  Exception GetException() noexcept { return future_->GetException(); }
+  Exception GetException() noexcept { return future_ ? future_->GetException() : Exception(); }
 
  private:
   void Detach() {
@@ -1128,6 +1081,15 @@ class Future<T> {
     }
   }
 
+  /// @brief Same as multiple version.
+  FutureImpl<T>* GetOrCreateImpl() {
+    if (ready_value_) {
+      future_ = new FutureImpl<T>(std::move(*ready_value_));
+      ready_value_.reset();
+    }
+    return future_;
+  }
+
   /// @brief Add a callback to future.
   ///        When this future is ready, this callback will run with future value as
   ///        parameters. If this future is failed, this callback will be ignored.
@@ -1136,7 +1098,7 @@ class Future<T> {
   InnerThen(Func&& func, Executor* executor = nullptr) {
     typename R::PromiseType promise;  // transport a empty promise to callback
     auto future = promise.GetFuture();
-    future_->template SetCallback<R>(std::move(promise), std::forward<Func>(func), executor);
+    GetOrCreateImpl()->template SetCallback<R>(std::move(promise), std::forward<Func>(func), executor);
     return future;
   }
 
@@ -1147,7 +1109,7 @@ class Future<T> {
   template <typename Func, typename R = typename std::invoke_result<Func, T &&>::type>
   typename std::enable_if<std::is_void<R>::value, R>::type
   InnerThen(Func&& func, Executor* executor = nullptr) {
-    future_->template SetTerminalCallback<Type>(std::forward<Func>(func), executor);
+    GetOrCreateImpl()->template SetTerminalCallback<Type>(std::forward<Func>(func), executor);
   }
 
   /// @brief Add a callback to future.
@@ -1159,7 +1121,7 @@ class Future<T> {
   InnerThenWrapped(Func&& func, Executor* executor = nullptr) {
     typename R::PromiseType promise;
     auto future = promise.GetFuture();
-    future_->template SetCallbackWrapped<R>(std::move(promise), std::forward<Func>(func), executor);
+    GetOrCreateImpl()->template SetCallbackWrapped<R>(std::move(promise), std::forward<Func>(func), executor);
     return future;
   }
 
@@ -1171,13 +1133,14 @@ class Future<T> {
   typename std::enable_if<std::is_void<R>::value, R>::type
   InnerThenWrapped(Func&& func, Executor* executor = nullptr) {
     // PromiseType promise;
-    future_->template SetTerminalCallbackWrapped<Type>(std::forward<Func>(func), executor);
+    GetOrCreateImpl()->template SetTerminalCallbackWrapped<Type>(std::forward<Func>(func), executor);
   }
 
  private:
   FutureImpl<T>* future_ = nullptr;
 
-  friend class ContinuationBase;
+  // Same as multiple version.
+  std::optional<T> ready_value_;
 };
 
 /// @brief Variable parameter version of Promise.
@@ -1342,7 +1305,7 @@ template <typename PromiseType, typename FutureType>
 void ContinuationBase::ChainFuture(FutureType&& fut, PromiseType&& promise) {
   // Combine current promise with value or exception, make state clearly.
   if (fut.IsReady()) {
-    promise.SetValue(fut.future_->GetValue());
+    promise.SetValue(fut.GetValue());
   } else if (fut.IsFailed()) {
     promise.SetException(fut.GetException());
   } else {
@@ -1351,11 +1314,10 @@ void ContinuationBase::ChainFuture(FutureType&& fut, PromiseType&& promise) {
     // Use superior callback's return to register a new callback for setting state of superior then's promise.
     fut.Then([pr = std::forward<PromiseType>(promise)](ResultFutureType&& result) mutable {
       if (result.IsReady()) {
-        pr.SetValue(result.future_->GetValue());
+        pr.SetValue(result.GetValue());
       } else {
         pr.SetException(result.GetException());
       }
-      return MakeReadyFuture<>();
     });
   }
 }
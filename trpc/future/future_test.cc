@@ -13,6 +13,8 @@
 
 #include "trpc/future/future.h"
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <string>
 #include <thread>
@@ -707,4 +709,61 @@ TEST(Future, ContinuationOnCurrent2) {
   }).join();
 }
 
+// Test result and callback set concurrently, callback runs exactly once.
+TEST(Future, ConcurrentSetValueAndThen) {
+  int loop_times = 10000;
+  std::atomic<int> exec_count = 0;
+  for (int i = 0; i < loop_times; i++) {
+    Promise<int> pr;
+    auto fut = pr.GetFuture();
+    Latch latch(1);
+    std::thread t([&pr]() { pr.SetValue(1); });
+    fut.Then([&exec_count, &latch](int&& val) {
+      EXPECT_EQ(val, 1);
+      exec_count++;
+      latch.count_down();
+    });
+    t.join();
+    latch.wait();
+  }
+
+  ASSERT_EQ(exec_count, loop_times);
+}
+
+// Test callback too large to be stored inside future state.
+TEST(Future, ThenWithLargeCallback) {
+  std::array<char, 256> large;
+  large.fill('a');
+  Promise<std::string> pr;
+  auto fut = pr.GetFuture().Then([large](std::string&& str) {
+    return MakeReadyFuture<std::string>(str + std::string(large.begin(), large.end()));
+  });
+
+  pr.SetValue(std::string("b"));
+  ASSERT_TRUE(fut.IsReady());
+  EXPECT_EQ(fut.GetValue0(), "b" + std::string(256, 'a'));
+}
+
+// Test ready future moved around before its value is taken.
+TEST(Future, MoveReadyFuture) {
+  auto fut = MakeReadyFuture<std::string>("hello");
+  Future<std::string> moved(std::move(fut));
+  ASSERT_TRUE(moved.IsReady());
+  EXPECT_FALSE(moved.IsFailed());
+  EXPECT_EQ(moved.GetConstValue(), "hello");
+
+  fut = std::move(moved);
+  EXPECT_EQ(fut.GetValue0(), "hello");
+  EXPECT_FALSE(fut.IsReady());
+
+  auto multi = MakeReadyFuture<int, std::string>(1, "world");
+  bool success = false;
+  multi.Then([&success](int&& integer, std::string&& str) {
+    EXPECT_EQ(integer, 1);
+    EXPECT_EQ(str, "world");
+    success = true;
+  });
+  EXPECT_TRUE(success);
+}
+
 }  // namespace trpc
@@ -0,0 +1,343 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#if !defined(__cpp_impl_coroutine)
+#error "trpc/future/task.h requires C++20 coroutines, please compile with -std=c++20 or later."
+#endif
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "trpc/future/exception.h"
+#include "trpc/future/executor.h"
+#include "trpc/future/future.h"
+#include "trpc/runtime/iomodel/reactor/reactor.h"
+
+namespace trpc {
+
+/// @brief Stackless coroutine returning value of type T, the cost of an in-flight one is its coroutine frame rather
+///        than a fiber stack.
+/// @note Task is lazy, it runs only when it is co_awaited by another coroutine or started by `StartTask`. Inside a
+///       task, `co_await` on a `Future` (e.g. returned by `AsyncTimer::After` or `Async*Invoke` of service proxies)
+///       gives the resolved future back, which is either ready or failed, and the task is resumed on:
+///       1. the executor bound by `StartTask` if any, otherwise
+///       2. the reactor of the thread which suspended the task if any, otherwise
+///       3. the thread which resolved the future.
+/// @example
+///   Task<std::string> SayHello(std::shared_ptr<GreeterServiceProxy> proxy, ClientContextPtr ctx) {
+///     HelloRequest request;
+///     auto fut = co_await proxy->AsyncSayHello(ctx, request);
+///     if (fut.IsFailed()) {
+///       co_return fut.GetException().what();
+///     }
+///     co_return fut.GetValue0().msg();
+///   }
+///
+///   StartTask(SayHello(proxy, ctx)).Then([](std::string&& msg) { ... });
+template <typename T = void>
+class Task;
+
+/// @private
+namespace detail {
+
+/// @brief Resume coroutine on executor, or on reactor if no executor, or on current thread if neither or submitting
+///        failed.
+/// @private
+inline void ResumeCoroutine(std::coroutine_handle<> handle, Executor* executor, Reactor* reactor) {
+  if (executor) {
+    if (executor->SubmitTask([handle]() { handle.resume(); })) {
+      return;
+    }
+  } else if (reactor) {
+    if (reactor->SubmitTask([handle]() { handle.resume(); })) {
+      return;
+    }
+  }
+
+  handle.resume();
+}
+
+/// @brief Common part of promise of Task.
+/// @private
+class TaskPromiseBase {
+ public:
+  /// @brief Resume the coroutine awaiting current task once current task finished.
+  struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+      std::coroutine_handle<> continuation = handle.promise().continuation_;
+      return continuation ? continuation : std::noop_coroutine();
+    }
+
+    void await_resume() noexcept {}
+  };
+
+  std::suspend_always initial_suspend() noexcept { return {}; }
+
+  FinalAwaiter final_suspend() noexcept { return {}; }
+
+  void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+
+  void SetContinuation(std::coroutine_handle<> continuation) noexcept { continuation_ = continuation; }
+
+  void SetExecutor(Executor* executor) noexcept { executor_ = executor; }
+
+  Executor* GetExecutor() const noexcept { return executor_; }
+
+ protected:
+  // Rethrow exception escaped from coroutine body to the one awaiting it.
+  void RethrowIfFailed() {
+    if (exception_) {
+      std::rethrow_exception(exception_);
+    }
+  }
+
+ private:
+  // Coroutine awaiting current task.
+  std::coroutine_handle<> continuation_;
+
+  // Executor which the coroutine is resumed on after suspended by awaiting future.
+  Executor* executor_ = nullptr;
+
+  // Exception escaped from coroutine body.
+  std::exception_ptr exception_;
+};
+
+/// @brief Promise of Task returning value.
+/// @private
+template <typename T>
+class TaskPromise : public TaskPromiseBase {
+ public:
+  Task<T> get_return_object() noexcept;
+
+  template <typename U>
+  void return_value(U&& value) {
+    value_.emplace(std::forward<U>(value));
+  }
+
+  T GetResult() {
+    RethrowIfFailed();
+    return std::move(*value_);
+  }
+
+ private:
+  std::optional<T> value_;
+};
+
+/// @brief Promise of Task returning void.
+/// @private
+template <>
+class TaskPromise<void> : public TaskPromiseBase {
+ public:
+  Task<void> get_return_object() noexcept;
+
+  void return_void() noexcept {}
+
+  void GetResult() { RethrowIfFailed(); }
+};
+
+/// @brief Executor bound to the coroutine, null if it is not a task.
+/// @private
+template <typename Promise>
+Executor* GetBoundExecutor(std::coroutine_handle<Promise> handle) noexcept {
+  if constexpr (std::is_base_of_v<TaskPromiseBase, Promise>) {
+    return handle.promise().GetExecutor();
+  } else {
+    return nullptr;
+  }
+}
+
+/// @brief Awaiter starting task and suspending the awaiting coroutine until the task finished.
+/// @private
+template <typename T>
+class TaskAwaiter {
+ public:
+  explicit TaskAwaiter(std::coroutine_handle<TaskPromise<T>> handle) noexcept : handle_(handle) {}
+
+  bool await_ready() const noexcept { return false; }
+
+  template <typename Promise>
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> awaiting) noexcept {
+    // Task inherits executor of the awaiting one, unless bound explicitly.
+    if (!handle_.promise().GetExecutor()) {
+      handle_.promise().SetExecutor(GetBoundExecutor(awaiting));
+    }
+    handle_.promise().SetContinuation(awaiting);
+    return handle_;
+  }
+
+  T await_resume() { return handle_.promise().GetResult(); }
+
+ private:
+  std::coroutine_handle<TaskPromise<T>> handle_;
+};
+
+/// @brief Awaiter suspending the coroutine until future is resolved.
+/// @private
+template <typename... T>
+class FutureAwaiter {
+ public:
+  explicit FutureAwaiter(Future<T...>&& future) noexcept : future_(std::move(future)) {}
+
+  bool await_ready() const noexcept { return future_.IsReady() || future_.IsFailed(); }
+
+  template <typename Promise>
+  void await_suspend(std::coroutine_handle<Promise> handle) {
+    Executor* executor = GetBoundExecutor(handle);
+    Reactor* reactor = Reactor::GetCurrentTlsReactor();
+    // Take the future out, as awaiter may be destroyed once coroutine resumed.
+    Future<T...> future = std::move(future_);
+    std::move(future).Then(&kDefaultInlineExecutor,
+                           [this, handle, executor, reactor](Future<T...>&& result) {
+                             future_ = std::move(result);
+                             ResumeCoroutine(handle, executor, reactor);
+                           });
+  }
+
+  Future<T...> await_resume() noexcept { return std::move(future_); }
+
+ private:
+  Future<T...> future_;
+};
+
+/// @brief Coroutine running a task to completion without being awaited, and resolving promise with its result.
+/// @private
+struct DetachedCoroutine {
+  struct promise_type {
+    DetachedCoroutine get_return_object() noexcept { return {}; }
+
+    std::suspend_never initial_suspend() noexcept { return {}; }
+
+    std::suspend_never final_suspend() noexcept { return {}; }
+
+    void return_void() noexcept {}
+
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+/// @brief Future type resolved by Task<T>.
+/// @private
+template <typename T>
+struct TaskFuture {
+  using Type = Future<T>;
+};
+
+/// @private
+template <>
+struct TaskFuture<void> {
+  using Type = Future<>;
+};
+
+template <typename T>
+DetachedCoroutine RunTask(Task<T> task, typename TaskFuture<T>::Type::PromiseType promise) {
+  try {
+    if constexpr (std::is_void_v<T>) {
+      co_await std::move(task);
+      promise.SetValue();
+    } else {
+      promise.SetValue(co_await std::move(task));
+    }
+  } catch (const std::exception& e) {
+    promise.SetException(CommonException(e.what()));
+  } catch (...) {
+    promise.SetException(CommonException("unknown exception"));
+  }
+}
+
+}  // namespace detail
+
+template <typename T>
+class Task {
+ public:
+  /// @private
+  using promise_type = detail::TaskPromise<T>;
+
+  Task(Task&& o) noexcept : handle_(std::exchange(o.handle_, nullptr)) {}
+
+  Task& operator=(Task&& o) noexcept {
+    if (this != &o) {
+      Destroy();
+      handle_ = std::exchange(o.handle_, nullptr);
+    }
+    return *this;
+  }
+
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+
+  ~Task() { Destroy(); }
+
+  /// @brief Bind the executor which current task is resumed on, tasks awaited by current task inherit it.
+  void SetExecutor(Executor* executor) noexcept { handle_.promise().SetExecutor(executor); }
+
+  /// @brief Start current task and suspend the awaiting coroutine until it finished.
+  detail::TaskAwaiter<T> operator co_await() && noexcept { return detail::TaskAwaiter<T>(handle_); }
+
+ private:
+  friend class detail::TaskPromise<T>;
+
+  explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+  void Destroy() noexcept {
+    if (handle_) {
+      handle_.destroy();
+      handle_ = nullptr;
+    }
+  }
+
+ private:
+  std::coroutine_handle<promise_type> handle_;
+};
+
+template <typename T>
+Task<T> detail::TaskPromise<T>::get_return_object() noexcept {
+  return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> detail::TaskPromise<void>::get_return_object() noexcept {
+  return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+/// @brief Make future awaitable, `co_await` on it gives back the resolved future, which is either ready or failed.
+template <typename... T>
+detail::FutureAwaiter<T...> operator co_await(Future<T...>&& future) noexcept {
+  return detail::FutureAwaiter<T...>(std::move(future));
+}
+
+/// @brief Start task in current thread, and get a future resolved by its result.
+/// @note C++ exception escaped from task fails the future with `CommonException`.
+template <typename T>
+typename detail::TaskFuture<T>::Type StartTask(Task<T>&& task) {
+  typename detail::TaskFuture<T>::Type::PromiseType promise;
+  auto future = promise.GetFuture();
+  detail::RunTask(std::move(task), std::move(promise));
+  return future;
+}
+
+/// @brief Start task in current thread and resume it on `executor` whenever it is suspended by awaiting future.
+/// @note Executor's life time should be longer than task.
+template <typename T>
+typename detail::TaskFuture<T>::Type StartTask(Executor* executor, Task<T>&& task) {
+  task.SetExecutor(executor);
+  return StartTask(std::move(task));
+}
+
+}  // namespace trpc
@@ -0,0 +1,154 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/future/task.h"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "trpc/common/config/trpc_config.h"
+#include "trpc/future/async_timer.h"
+#include "trpc/future/future_utility.h"
+#include "trpc/runtime/merge_runtime.h"
+#include "trpc/runtime/runtime.h"
+#include "trpc/util/thread/latch.h"
+
+namespace trpc::testing {
+
+namespace {
+
+Task<int> Add(int a, int b) { co_return a + b; }
+
+Task<int> AddTwice(int a, int b) {
+  int x = co_await Add(a, b);
+  int y = co_await Add(x, b);
+  co_return y;
+}
+
+Task<std::string> AwaitFuture(Future<std::string>&& fut) {
+  auto result = co_await std::move(fut);
+  if (result.IsFailed()) {
+    co_return result.GetException().what();
+  }
+  co_return result.GetValue0();
+}
+
+Task<void> Throw() {
+  throw std::runtime_error("task exception");
+  co_return;
+}
+
+/// @brief Execute task in a new thread, and count tasks submitted.
+class ThreadExecutor : public Executor {
+ public:
+  bool SubmitTask(Task&& task) override {
+    ++count;
+    std::thread(std::move(task)).detach();
+    return true;
+  }
+
+  std::atomic<int> count = 0;
+};
+
+}  // namespace
+
+TEST(TaskTest, NestedTask) {
+  auto fut = StartTask(AddTwice(1, 2));
+  ASSERT_TRUE(fut.IsReady());
+  EXPECT_EQ(fut.GetValue0(), 5);
+}
+
+TEST(TaskTest, AwaitReadyFuture) {
+  auto fut = StartTask(AwaitFuture(MakeReadyFuture<std::string>("hello")));
+  ASSERT_TRUE(fut.IsReady());
+  EXPECT_EQ(fut.GetValue0(), "hello");
+
+  fut = StartTask(AwaitFuture(MakeExceptionFuture<std::string>(CommonException("failed"))));
+  ASSERT_TRUE(fut.IsReady());
+  EXPECT_EQ(fut.GetValue0(), "failed");
+}
+
+TEST(TaskTest, AwaitFutureResolvedByOtherThread) {
+  Promise<std::string> pr;
+  auto fut = StartTask(AwaitFuture(pr.GetFuture()));
+  EXPECT_FALSE(fut.IsReady());
+
+  std::thread t([&pr]() { pr.SetValue(std::string("world")); });
+  auto result = future::BlockingGet(std::move(fut));
+  t.join();
+
+  ASSERT_TRUE(result.IsReady());
+  EXPECT_EQ(result.GetValue0(), "world");
+}
+
+TEST(TaskTest, ResumeOnExecutor) {
+  ThreadExecutor executor;
+  Promise<std::string> pr;
+  auto task = [](Future<std::string>&& fut) -> Task<std::thread::id> {
+    // Nested task inherits the executor.
+    co_await AwaitFuture(std::move(fut));
+    co_return std::this_thread::get_id();
+  };
+  auto fut = StartTask(&executor, task(pr.GetFuture()));
+
+  pr.SetValue(std::string("executor"));
+  auto result = future::BlockingGet(std::move(fut));
+
+  ASSERT_TRUE(result.IsReady());
+  EXPECT_NE(result.GetValue0(), std::this_thread::get_id());
+  EXPECT_EQ(executor.count, 1);
+}
+
+TEST(TaskTest, Exception) {
+  auto fut = StartTask(Throw());
+  ASSERT_TRUE(fut.IsFailed());
+  EXPECT_STREQ(fut.GetException().what(), "task exception");
+}
+
+TEST(TaskTest, ResumeOnReactor) {
+  ASSERT_EQ(TrpcConfig::GetInstance()->Init("trpc/runtime/threadmodel/testing/merge.yaml"), 0);
+  merge::StartRuntime();
+
+  auto task = [](Reactor* reactor) -> Task<bool> {
+    AsyncTimer timer;
+    auto timer_fut = co_await timer.After(10);
+    if (!timer_fut.IsReady() || Reactor::GetCurrentTlsReactor() != reactor) {
+      co_return false;
+    }
+
+    // Future resolved by thread other than reactor.
+    Promise<> pr;
+    auto fut = pr.GetFuture();
+    std::thread([pr = std::move(pr)]() mutable { pr.SetValue(); }).detach();
+    auto result = co_await std::move(fut);
+    co_return result.IsReady() && Reactor::GetCurrentTlsReactor() == reactor;
+  };
+
+  Latch latch(1);
+  Reactor* reactor = runtime::GetReactor(0);
+  reactor->SubmitTask([&]() {
+    StartTask(task(reactor)).Then([&latch](bool&& ok) {
+      EXPECT_TRUE(ok);
+      latch.count_down();
+    });
+  });
+  latch.wait();
+
+  merge::TerminateRuntime();
+}
+
+}  // namespace trpc::testing
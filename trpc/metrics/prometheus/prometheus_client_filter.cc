@@ -16,6 +16,7 @@
 
 #include "trpc/common/config/trpc_config.h"
 #include "trpc/metrics/metrics_factory.h"
+#include "trpc/util/likely.h"
 #include "trpc/util/time.h"
 
 namespace trpc {
@@ -29,6 +30,7 @@ int PrometheusClientFilter::Init() {
     TRPC_LOG_ERROR("PrometheusClientFilter init failed: plugin prometheus has not been registered");
     return -1;
   }
+  prometheus_metrics_ = trpc::dynamic_pointer_cast<PrometheusMetrics>(metrics_);
   return 0;
 }
 
@@ -43,17 +45,51 @@ void PrometheusClientFilter::operator()(FilterStatus& status, FilterPoint point,
   }
 
   if (point == FilterPoint::CLIENT_POST_RPC_INVOKE) {
-    ModuleMetricsInfo info;
-    info.source = kMetricsCallerSource;
-    SetStatInfo(context, info.infos);
-    info.cost_time = (trpc::time::GetMicroSeconds() - context->GetSendTimestampUs()) / 1000;
+    uint32_t cost_time = (trpc::time::GetMicroSeconds() - context->GetSendTimestampUs()) / 1000;
+    if (prometheus_metrics_) {
+      const auto& bound_metrics = GetBoundMetrics(context);
+      bound_metrics.counter->Increment();
+      bound_metrics.histogram->Observe(cost_time);
+    } else {
+      ModuleMetricsInfo info;
+      info.source = kMetricsCallerSource;
+      SetStatInfo(context, info.infos);
+      info.cost_time = cost_time;
 
-    metrics_->ModuleReport(info);
+      metrics_->ModuleReport(info);
+    }
   }
 
   status = FilterStatus::CONTINUE;
 }
 
+const PrometheusMetrics::BoundModuleMetrics& PrometheusClientFilter::GetBoundMetrics(const ClientContextPtr& ctx) {
+  // The environment labels are the same for all calls reported by this filter, so they are not part of the key.
+  thread_local std::string key;
+  key.clear();
+  trpc::prometheus::detail::AppendLabelKey(ctx->GetCallerName(), key);
+  trpc::prometheus::detail::AppendLabelKey(ctx->GetCalleeName(), key);
+  trpc::prometheus::detail::AppendLabelKey(ctx->GetFuncName(), key);
+  trpc::prometheus::detail::AppendLabelKey(ctx->GetIp(), key);
+  const auto& metadata = ctx->GetTargetMetadata();
+  for (const char* name : {naming::kNodeContainerName, naming::kNodeSetName}) {
+    auto iter = metadata.find(name);
+    trpc::prometheus::detail::AppendLabelKey(iter != metadata.end() ? iter->second : std::string_view(), key);
+  }
+  trpc::prometheus::detail::AppendLabelKey(ctx->GetStatus().GetFrameworkRetCode(), key);
+  trpc::prometheus::detail::AppendLabelKey(ctx->GetStatus().GetFuncRetCode(), key);
+
+  auto& bound_metrics = *bound_metrics_.Get();
+  auto iter = bound_metrics.find(key);
+  if (TRPC_LIKELY(iter != bound_metrics.end())) {
+    return iter->second;
+  }
+
+  std::map<std::string, std::string> infos;
+  SetStatInfo(ctx, infos);
+  return bound_metrics.emplace(key, prometheus_metrics_->BindModuleMetrics(kMetricsCallerSource, infos)).first->second;
+}
+
 void PrometheusClientFilter::SetStatInfo(const ClientContextPtr& ctx, std::map<std::string, std::string>& infos) {
   // set caller info
   trpc::prometheus::detail::SetCallerServiceInfo(ctx->GetCallerName(), infos);
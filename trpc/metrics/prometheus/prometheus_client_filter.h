@@ -17,12 +17,15 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "trpc/client/client_context.h"
 #include "trpc/filter/filter.h"
 #include "trpc/metrics/metrics.h"
 #include "trpc/metrics/prometheus/prometheus_common.h"
+#include "trpc/metrics/prometheus/prometheus_metrics.h"
+#include "trpc/util/thread/thread_local.h"
 
 namespace trpc {
 
@@ -39,6 +42,9 @@ class PrometheusClientFilter : public MessageClientFilter {
  private:
   void SetStatInfo(const ClientContextPtr& ctx, std::map<std::string, std::string>& infos);
 
+  // Gets the metrics bound to the label set of the call, binding them on the first call of the label set per thread.
+  const PrometheusMetrics::BoundModuleMetrics& GetBoundMetrics(const ClientContextPtr& ctx);
+
  private:
   struct InnerMetricsInfo {
     std::string env_namespace;
@@ -48,6 +54,12 @@ class PrometheusClientFilter : public MessageClientFilter {
   // prometheus metrics instance
   MetricsPtr metrics_;
 
+  // `metrics_` as the prometheus plugin, null if it is of another type, in which case `ModuleReport` is used.
+  PrometheusMetricsPtr prometheus_metrics_;
+
+  // The bound metrics of each thread, keyed by the label values of the call joined by `AppendLabelKey`.
+  ThreadLocal<std::unordered_map<std::string, PrometheusMetrics::BoundModuleMetrics>> bound_metrics_;
+
   InnerMetricsInfo inner_metrics_info_;
 };
 
@@ -15,6 +15,7 @@
 #include "trpc/metrics/prometheus/prometheus_common.h"
 
 #include <algorithm>
+#include <charconv>
 #include <string_view>
 
 namespace trpc::prometheus {
@@ -93,6 +94,18 @@ void SetCalleeServiceInfo(const std::string& service_name, std::map<std::string,
   }
 }
 
+void AppendLabelKey(std::string_view value, std::string& key) {
+  key.append(value.data(), value.size());
+  // Label values never contain '\0', so the values are separated unambiguously.
+  key.push_back('\0');
+}
+
+void AppendLabelKey(int value, std::string& key) {
+  char buffer[16];
+  auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  AppendLabelKey(std::string_view(buffer, result.ptr - buffer), key);
+}
+
 }  // namespace detail
 
 }  // namespace trpc::prometheus
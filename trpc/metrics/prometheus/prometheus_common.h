@@ -17,6 +17,7 @@
 #include <cstddef>
 #include <map>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace trpc::prometheus {
@@ -78,6 +79,13 @@ void SetCallerServiceInfo(const std::string& service_name, std::map<std::string,
 /// @param [out] infos used to store information
 void SetCalleeServiceInfo(const std::string& service_name, std::map<std::string, std::string>& infos);
 
+/// @brief Appends a label value to the key identifying the label set of a call, used by the filters to look up the
+///        bound metrics of the label set without building it.
+/// @param value label value
+/// @param [out] key the key being built
+void AppendLabelKey(std::string_view value, std::string& key);
+void AppendLabelKey(int value, std::string& key);
+
 }  // namespace detail
 
 }  // namespace trpc::prometheus
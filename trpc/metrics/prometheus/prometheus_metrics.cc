@@ -76,6 +76,7 @@ void PrometheusMetrics::Start() noexcept {
       gateway->RegisterCollectable(trpc::prometheus::GetRegistry());
       push_gateway_task_id_ = PeripheryTaskScheduler::GetInstance()->SubmitInnerPeriodicalTask(
           [gateway = std::move(gateway)]() {
+            trpc::prometheus::FlushBoundMetrics();
             int ret = gateway->Push();
             if (ret != kPushToGatewaySucc) {
               TRPC_FMT_ERROR("Failed to push metrics to the gateway");
@@ -112,6 +113,34 @@ int PrometheusMetrics::ModuleReport(const ModuleMetricsInfo& info) {
   return 0;
 }
 
+PrometheusMetrics::BoundModuleMetrics PrometheusMetrics::BindModuleMetrics(
+    int source, const std::map<std::string, std::string>& infos) {
+  BoundModuleMetrics metrics;
+  if (source == kMetricsCallerSource) {
+    metrics.counter = trpc::prometheus::GetBoundCounter(rpc_client_counter_family_, infos);
+    metrics.histogram =
+        trpc::prometheus::GetBoundHistogram(rpc_client_histogram_family_, infos, prometheus_conf_.histogram_module_cfg);
+  } else {
+    metrics.counter = trpc::prometheus::GetBoundCounter(rpc_server_counter_family_, infos);
+    metrics.histogram =
+        trpc::prometheus::GetBoundHistogram(rpc_server_histogram_family_, infos, prometheus_conf_.histogram_module_cfg);
+  }
+  return metrics;
+}
+
+trpc::prometheus::BoundCounter* PrometheusMetrics::BindSumData(const std::map<std::string, std::string>& labels) {
+  return trpc::prometheus::GetBoundCounter(prometheus_counter_family_, labels);
+}
+
+trpc::prometheus::BoundHistogram* PrometheusMetrics::BindHistogramData(const std::map<std::string, std::string>& labels,
+                                                                       const HistogramBucket& bucket) {
+  if (bucket.size() == 0) {
+    TRPC_LOG_ERROR("bucket size must > 0");
+    return nullptr;
+  }
+  return trpc::prometheus::GetBoundHistogram(prometheus_histogram_family_, labels, bucket);
+}
+
 int PrometheusMetrics::SetDataReport(const std::map<std::string, std::string>& labels, double value) {
   auto& gauge = prometheus_gauge_family_->Add(labels);
   gauge.Set(value);
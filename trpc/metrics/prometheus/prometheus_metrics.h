@@ -29,6 +29,7 @@
 #include "trpc/metrics/prometheus/prometheus_conf.h"
 #include "trpc/util/log/logging.h"
 #include "trpc/util/prometheus.h"
+#include "trpc/util/prometheus_bound_metrics.h"
 
 namespace trpc {
 
@@ -73,6 +74,26 @@ class PrometheusMetrics : public Metrics {
   int HistogramDataReport(const std::map<std::string, std::string>& labels, const HistogramBucket& bucket,
                           double value);
 
+  /// @brief The RPC metrics reported by `ModuleReport`, bound to a label set.
+  struct BoundModuleMetrics {
+    trpc::prometheus::BoundCounter* counter{nullptr};
+    trpc::prometheus::BoundHistogram* histogram{nullptr};
+  };
+
+  /// @brief Binds the RPC metrics of `source` (kMetricsCallerSource or kMetricsCalleeSource) with the label set
+  ///        `infos`, so that calls are reported without resolving the labels every time.
+  /// @note Takes locks, the result stays valid for the lifetime of the process and is expected to be cached.
+  BoundModuleMetrics BindModuleMetrics(int source, const std::map<std::string, std::string>& infos);
+
+  /// @brief Binds metrics data with SUM type to `labels`.
+  /// @note This interface is for internal use only and should not be used by users. May be modified in the future.
+  trpc::prometheus::BoundCounter* BindSumData(const std::map<std::string, std::string>& labels);
+
+  /// @brief Binds metrics data with HISTOGRAM type to `labels`, returns nullptr if `bucket` is empty.
+  /// @note This interface is for internal use only and should not be used by users. May be modified in the future.
+  trpc::prometheus::BoundHistogram* BindHistogramData(const std::map<std::string, std::string>& labels,
+                                                      const HistogramBucket& bucket);
+
  private:
   template <typename T>
   int SingleAttrReportTemplate(T&& info) {
@@ -89,6 +89,22 @@ int ReportHistogramMetricsInfo(const std::map<std::string, std::string>& labels,
   return ReportHistogramTemplate(labels, std::move(bucket), value);
 }
 
+BoundCounter* BindSumMetrics(const std::map<std::string, std::string>& labels) {
+  trpc::PrometheusMetricsPtr metrics = GetPlugin();
+  if (!metrics) {
+    return nullptr;
+  }
+  return metrics->BindSumData(labels);
+}
+
+BoundHistogram* BindHistogramMetrics(const std::map<std::string, std::string>& labels, const HistogramBucket& bucket) {
+  trpc::PrometheusMetricsPtr metrics = GetPlugin();
+  if (!metrics) {
+    return nullptr;
+  }
+  return metrics->BindHistogramData(labels, bucket);
+}
+
 }  // namespace trpc::prometheus
 
 #endif
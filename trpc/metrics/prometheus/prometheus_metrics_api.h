@@ -18,6 +18,7 @@
 #include "trpc/metrics/prometheus/prometheus_common.h"
 #include "trpc/metrics/trpc_metrics.h"
 #include "trpc/util/prometheus.h"
+#include "trpc/util/prometheus_bound_metrics.h"
 
 /// @brief Prometheus metrics interfaces for user programing
 namespace trpc::prometheus {
@@ -58,6 +59,19 @@ int ReportHistogramMetricsInfo(const std::map<std::string, std::string>& labels,
 int ReportHistogramMetricsInfo(const std::map<std::string, std::string>& labels, HistogramBucket&& bucket,
                                double value);
 
+/// @brief Binds metrics data with SUM type to `labels` once, for reporting on hot paths. Updates through the handle
+///        are aggregated per thread and merged when metrics are collected.
+/// @param labels prometheus metrics labels
+/// @return the handle living as long as the process, or nullptr if the prometheus plugin is not registered
+BoundCounter* BindSumMetrics(const std::map<std::string, std::string>& labels);
+
+/// @brief Binds metrics data with HISTOGRAM type to `labels` once, see `BindSumMetrics`.
+/// @param labels prometheus metrics labels
+/// @param bucket the bucket used to gather histogram statistics
+/// @return the handle living as long as the process, or nullptr if the prometheus plugin is not registered or the
+///         bucket is empty
+BoundHistogram* BindHistogramMetrics(const std::map<std::string, std::string>& labels, const HistogramBucket& bucket);
+
 }  // namespace trpc::prometheus
 
 #endif
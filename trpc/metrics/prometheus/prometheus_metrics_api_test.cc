@@ -46,6 +46,7 @@ TEST_F(PrometheusMetricsAPITest, Interfaces) {
   // 1. testing report when prometheus plugin is not registered
   std::map<std::string, std::string> labels = GetTestLabels("inter_value");
   ASSERT_NE(0, trpc::prometheus::ReportSetMetricsInfo(labels, 10));
+  ASSERT_EQ(nullptr, trpc::prometheus::BindSumMetrics(labels));
 
   // register the prometheus plugin
   MetricsFactory::GetInstance()->Register(prometheus_metrics_);
@@ -79,6 +80,22 @@ TEST_F(PrometheusMetricsAPITest, Interfaces) {
   trpc::HistogramBucket bucket = {0.1, 0.5, 1};
   ASSERT_EQ(0, trpc::prometheus::ReportHistogramMetricsInfo(labels, bucket, 10));
   ASSERT_EQ(0, trpc::prometheus::ReportHistogramMetricsInfo(labels, std::move(bucket), 10));
+
+  // 7. testing bind SUM metrics data
+  labels = GetTestLabels("inter_bound_sum_value");
+  trpc::prometheus::BoundCounter* counter = trpc::prometheus::BindSumMetrics(labels);
+  ASSERT_NE(nullptr, counter);
+  ASSERT_EQ(counter, trpc::prometheus::BindSumMetrics(labels));
+  counter->Increment(10);
+
+  // 8. testing bind HISTOGRAM metrics data
+  labels = GetTestLabels("inter_bound_histogram_value");
+  // bind failed because bucket filed is empty
+  ASSERT_EQ(nullptr, trpc::prometheus::BindHistogramMetrics(labels, {}));
+  trpc::prometheus::BoundHistogram* histogram = trpc::prometheus::BindHistogramMetrics(labels, {0.1, 0.5, 1});
+  ASSERT_NE(nullptr, histogram);
+  histogram->Observe(10);
+  trpc::prometheus::FlushBoundMetrics();
 }
 
 }  // namespace trpc::testing
@@ -58,6 +58,25 @@ TEST_F(PrometheusMetricsTest, ModuleReport) {
   ASSERT_EQ(0, prometheus_metrics_->ModuleReport(std::move(callee_info)));
 }
 
+TEST_F(PrometheusMetricsTest, BindModuleMetrics) {
+  std::map<std::string, std::string> infos = {{"module_key", "bound_module_value"}};
+  auto caller_metrics = prometheus_metrics_->BindModuleMetrics(trpc::kMetricsCallerSource, infos);
+  ASSERT_NE(nullptr, caller_metrics.counter);
+  ASSERT_NE(nullptr, caller_metrics.histogram);
+  auto callee_metrics = prometheus_metrics_->BindModuleMetrics(trpc::kMetricsCalleeSource, infos);
+  ASSERT_NE(caller_metrics.counter, callee_metrics.counter);
+  ASSERT_NE(caller_metrics.histogram, callee_metrics.histogram);
+
+  // The same label set is bound to the same metrics.
+  auto rebound_metrics = prometheus_metrics_->BindModuleMetrics(trpc::kMetricsCallerSource, infos);
+  ASSERT_EQ(caller_metrics.counter, rebound_metrics.counter);
+  ASSERT_EQ(caller_metrics.histogram, rebound_metrics.histogram);
+
+  caller_metrics.counter->Increment();
+  caller_metrics.histogram->Observe(10);
+  ASSERT_FALSE(trpc::prometheus::Collect().empty());
+}
+
 trpc::SingleAttrMetricsInfo GetTestSingleInfo(trpc::MetricsPolicy type, std::string value) {
   trpc::SingleAttrMetricsInfo info;
   info.name = "single_key";
@@ -16,6 +16,7 @@
 
 #include "trpc/common/config/trpc_config.h"
 #include "trpc/metrics/metrics_factory.h"
+#include "trpc/util/likely.h"
 #include "trpc/util/time.h"
 
 namespace trpc {
@@ -36,6 +37,7 @@ int PrometheusServerFilter::Init() {
     TRPC_LOG_ERROR("PrometheusServerFilter init failed: plugin prometheus has not been registered");
     return -1;
   }
+  prometheus_metrics_ = trpc::dynamic_pointer_cast<PrometheusMetrics>(metrics_);
   return 0;
 }
 
@@ -50,17 +52,46 @@ void PrometheusServerFilter::operator()(FilterStatus& status, FilterPoint point,
   }
 
   if (point == FilterPoint::SERVER_PRE_SEND_MSG) {
-    ModuleMetricsInfo info;
-    info.source = kMetricsCalleeSource;
-    SetStatInfo(context, info.infos);
-    info.cost_time = trpc::time::GetMilliSeconds() - context->GetRecvTimestamp();
+    uint32_t cost_time = trpc::time::GetMilliSeconds() - context->GetRecvTimestamp();
+    if (prometheus_metrics_) {
+      const auto& bound_metrics = GetBoundMetrics(context);
+      bound_metrics.counter->Increment();
+      bound_metrics.histogram->Observe(cost_time);
+    } else {
+      ModuleMetricsInfo info;
+      info.source = kMetricsCalleeSource;
+      SetStatInfo(context, info.infos);
+      info.cost_time = cost_time;
 
-    metrics_->ModuleReport(info);
+      metrics_->ModuleReport(info);
+    }
   }
 
   status = FilterStatus::CONTINUE;
 }
 
+const PrometheusMetrics::BoundModuleMetrics& PrometheusServerFilter::GetBoundMetrics(const ServerContextPtr& ctx) {
+  // The labels of this server are the same for all calls reported by this filter, so they are not part of the key.
+  thread_local std::string key;
+  key.clear();
+  trpc::prometheus::detail::AppendLabelKey(ctx->GetCallerName(), key);
+  trpc::prometheus::detail::AppendLabelKey(ctx->GetIp(), key);
+  trpc::prometheus::detail::AppendLabelKey(ctx->GetCalleeName(), key);
+  trpc::prometheus::detail::AppendLabelKey(ctx->GetFuncName(), key);
+  trpc::prometheus::detail::AppendLabelKey(ctx->GetStatus().GetFrameworkRetCode(), key);
+  trpc::prometheus::detail::AppendLabelKey(ctx->GetStatus().GetFuncRetCode(), key);
+
+  auto& bound_metrics = *bound_metrics_.Get();
+  auto iter = bound_metrics.find(key);
+  if (TRPC_LIKELY(iter != bound_metrics.end())) {
+    return iter->second;
+  }
+
+  std::map<std::string, std::string> infos;
+  SetStatInfo(ctx, infos);
+  return bound_metrics.emplace(key, prometheus_metrics_->BindModuleMetrics(kMetricsCalleeSource, infos)).first->second;
+}
+
 void PrometheusServerFilter::SetStatInfo(const ServerContextPtr& ctx, std::map<std::string, std::string>& infos) {
   // set caller info
   trpc::prometheus::detail::SetCallerServiceInfo(ctx->GetCallerName(), infos);
@@ -16,12 +16,15 @@
 #ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "trpc/filter/filter.h"
 #include "trpc/metrics/metrics.h"
 #include "trpc/metrics/prometheus/prometheus_common.h"
+#include "trpc/metrics/prometheus/prometheus_metrics.h"
 #include "trpc/server/server_context.h"
+#include "trpc/util/thread/thread_local.h"
 
 namespace trpc {
 
@@ -38,6 +41,9 @@ class PrometheusServerFilter : public MessageServerFilter {
  private:
   void SetStatInfo(const ServerContextPtr& ctx, std::map<std::string, std::string>& infos);
 
+  // Gets the metrics bound to the label set of the call, binding them on the first call of the label set per thread.
+  const PrometheusMetrics::BoundModuleMetrics& GetBoundMetrics(const ServerContextPtr& ctx);
+
  private:
   struct InnerMetricsInfo {
     std::string p_app;
@@ -53,6 +59,12 @@ class PrometheusServerFilter : public MessageServerFilter {
   // prometheus metrics instance
   MetricsPtr metrics_;
 
+  // `metrics_` as the prometheus plugin, null if it is of another type, in which case `ModuleReport` is used.
+  PrometheusMetricsPtr prometheus_metrics_;
+
+  // The bound metrics of each thread, keyed by the label values of the call joined by `AppendLabelKey`.
+  ThreadLocal<std::unordered_map<std::string, PrometheusMetrics::BoundModuleMetrics>> bound_metrics_;
+
   InnerMetricsInfo inner_metrics_info_;
 };
 
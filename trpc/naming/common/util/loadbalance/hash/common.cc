@@ -13,6 +13,7 @@
 
 #include "trpc/naming/common/util/loadbalance/hash/common.h"
 
+#include <charconv>
 #include <string>
 #include <vector>
 
@@ -22,40 +23,45 @@
 namespace trpc {
 std::string GenerateKeysAsString(const SelectorInfo* info, std::vector<uint32_t>& indexs) {
   std::string key;
+  AppendKeys(info, indexs, &key);
+  return key;
+}
+
+void AppendKeys(const SelectorInfo* info, const std::vector<uint32_t>& indexs, std::string* key) {
   for (int index : indexs) {
     switch (index) {
       case 0:
         if (info->context != nullptr) {
-          key += info->context->GetCallerName();
+          key->append(info->context->GetCallerName());
         }
         break;
       case 1:
         if (info->context != nullptr) {
-          key += info->context->GetIp();
+          key->append(info->context->GetIp());
         }
         break;
       case 2:
         if (info->context != nullptr) {
-          key += std::to_string(info->context->GetPort());
+          char buf[8];
+          key->append(buf, std::to_chars(buf, buf + sizeof(buf), info->context->GetPort()).ptr);
         }
         break;
       case 3:
-        key += info->name;
+        key->append(info->name);
         break;
 
       case 4:
         if (info->context != nullptr) {
-          key += info->context->GetCalleeName();
+          key->append(info->context->GetCalleeName());
         }
         break;
       case 5:
-        key += info->load_balance_name;
+        key->append(info->load_balance_name);
         break;
       default:
         break;
     }
   }
-  return key;
 }
 
 bool CheckLoadBalanceSelectorConfig(naming::LoadBalanceConfig& loadbalance_config_) {
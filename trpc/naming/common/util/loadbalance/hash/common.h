@@ -24,6 +24,10 @@ namespace trpc {
 
 std::string GenerateKeysAsString(const SelectorInfo* info, std::vector<uint32_t>& indexs);
 
+/// @brief Append the content selected by `indexs` to `key`, the same content as `GenerateKeysAsString` returns. Lets
+/// callers reuse the buffer of `key` across calls.
+void AppendKeys(const SelectorInfo* info, const std::vector<uint32_t>& indexs, std::string* key);
+
 bool CheckLoadBalanceSelectorConfig(naming::LoadBalanceConfig& loadbalance_config_);
 
 bool CheckLoadbalanceInfoDiff(const std::vector<TrpcEndpointInfo>& orig_endpoints,
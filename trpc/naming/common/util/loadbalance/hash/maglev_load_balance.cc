@@ -0,0 +1,186 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/naming/common/util/loadbalance/hash/maglev_load_balance.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "trpc/common/config/trpc_config.h"
+#include "trpc/naming/common/util/loadbalance/hash/common.h"
+#include "trpc/naming/load_balance_factory.h"
+#include "trpc/util/hazptr/hazptr.h"
+#include "trpc/util/log/logging.h"
+
+namespace trpc {
+
+namespace {
+
+// Primes for the size of lookup table, the table keeps at least `kMinSlotsPerEndpoint` slots per endpoint if possible.
+constexpr uint32_t kTableSizes[] = {65537, 131071, 262147, 524287, 1048573};
+constexpr uint32_t kMinSlotsPerEndpoint = 100;
+
+std::string GetEndpointKey(const TrpcEndpointInfo& endpoint) {
+  return endpoint.host + ":" + std::to_string(endpoint.port);
+}
+
+}  // namespace
+
+MaglevLoadBalance::~MaglevLoadBalance() {
+  for (auto& callee : callees_holder_) {
+    Table* table = callee->table.exchange(nullptr, std::memory_order_acq_rel);
+    if (table) {
+      table->Retire();
+    }
+  }
+}
+
+int MaglevLoadBalance::Init() noexcept {
+  if (!trpc::TrpcConfig::GetInstance()->GetPluginConfig("loadbalance", kMaglevLoadBalance, loadbalance_config_)) {
+    TRPC_FMT_DEBUG("get loadbalance config failed, use default value");
+  }
+
+  bool res = CheckLoadBalanceSelectorConfig(loadbalance_config_);
+  hash_func_ = kHashFuncTable.at(loadbalance_config_.hash_func);
+  return res ? 0 : -1;
+}
+
+uint32_t MaglevLoadBalance::GetTableSize(std::size_t endpoints_num) {
+  for (uint32_t size : kTableSizes) {
+    if (size >= endpoints_num * kMinSlotsPerEndpoint) {
+      return size;
+    }
+  }
+  return kTableSizes[std::size(kTableSizes) - 1];
+}
+
+std::unique_ptr<MaglevLoadBalance::Table> MaglevLoadBalance::BuildTable(
+    const std::vector<TrpcEndpointInfo>& endpoints) {
+  auto table = std::make_unique<Table>();
+  table->endpoints = endpoints;
+  if (endpoints.empty()) {
+    return table;
+  }
+
+  const uint32_t size = GetTableSize(endpoints.size());
+  const std::size_t num = endpoints.size();
+
+  // Endpoints take turns in the order of their addresses, so the table is irrelevant to the order of update.
+  std::vector<std::string> keys(num);
+  for (std::size_t i = 0; i != num; ++i) {
+    keys[i] = GetEndpointKey(endpoints[i]);
+  }
+  std::vector<uint32_t> order(num);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+
+  // Each endpoint walks through its own permutation of slots: offset + j * skip (mod size).
+  std::vector<uint64_t> offsets(num);
+  std::vector<uint64_t> skips(num);
+  std::vector<uint64_t> nexts(num, 0);
+  for (std::size_t i = 0; i != num; ++i) {
+    offsets[i] = MurmurHash3(keys[i]) % size;
+    skips[i] = CityHash(keys[i]) % (size - 1) + 1;
+  }
+
+  constexpr uint32_t kEmpty = std::numeric_limits<uint32_t>::max();
+  table->lookup.assign(size, kEmpty);
+  uint32_t filled = 0;
+  while (true) {
+    for (uint32_t i : order) {
+      uint64_t slot = (offsets[i] + nexts[i] * skips[i]) % size;
+      while (table->lookup[slot] != kEmpty) {
+        slot = (offsets[i] + ++nexts[i] * skips[i]) % size;
+      }
+      table->lookup[slot] = i;
+      ++nexts[i];
+      if (++filled == size) {
+        return table;
+      }
+    }
+  }
+}
+
+int MaglevLoadBalance::Update(const LoadBalanceInfo* info) {
+  if (nullptr == info || nullptr == info->info || nullptr == info->endpoints) {
+    TRPC_LOG_ERROR("Endpoint info of name is empty");
+    return -1;
+  }
+
+  const std::string& name = info->info->name;
+
+  std::scoped_lock _(update_mutex_);
+  Callee* callee = nullptr;
+  if (!callees_.Get(name, callee)) {
+    callees_holder_.push_back(std::make_unique<Callee>());
+    callee = callees_holder_.back().get();
+    callees_.Insert(name, callee);
+  }
+
+  // Only updaters replace the table and they are serialized, no hazard pointer is needed here.
+  Table* old_table = callee->table.load(std::memory_order_acquire);
+  if (old_table && !CheckLoadbalanceInfoDiff(old_table->endpoints, info->endpoints)) {
+    return 0;
+  }
+
+  auto new_table = BuildTable(*info->endpoints);
+  old_table = callee->table.exchange(new_table.release(), std::memory_order_acq_rel);
+  if (old_table) {
+    old_table->Retire();
+  }
+
+  return 0;
+}
+
+uint64_t MaglevLoadBalance::GetHash(const SelectorInfo* info) const {
+  if (info->context != nullptr && !info->context->GetHashKey().empty()) {
+    return std::stoull(info->context->GetHashKey());
+  }
+
+  // Reuse the buffer to build the key without allocation.
+  thread_local std::string key;
+  key.clear();
+  AppendKeys(info, loadbalance_config_.hash_args, &key);
+  return Hash(key, hash_func_);
+}
+
+int MaglevLoadBalance::Next(LoadBalanceResult& result) {
+  if (nullptr == result.info) {
+    return -1;
+  }
+
+  Callee* callee = nullptr;
+  if (!callees_.Get(result.info->name, callee)) {
+    TRPC_LOG_ERROR("Router info of name " << result.info->name << " no found");
+    return -1;
+  }
+
+  Hazptr hazptr;
+  Table* table = hazptr.Keep(&callee->table);
+  if (table == nullptr || table->lookup.empty()) {
+    TRPC_LOG_ERROR("Router info of name is empty");
+    return -1;
+  }
+
+  uint64_t hash = GetHash(result.info);
+  result.result = table->endpoints[table->lookup[hash % table->lookup.size()]];
+
+  return 0;
+}
+
+}  // namespace trpc
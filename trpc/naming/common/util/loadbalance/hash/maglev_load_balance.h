@@ -0,0 +1,94 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "trpc/common/config/loadbalance_naming_conf.h"
+#include "trpc/common/config/loadbalance_naming_conf_parser.h"
+#include "trpc/naming/common/util/hash/hash_func.h"
+#include "trpc/naming/load_balance.h"
+#include "trpc/util/concurrency/lightly_concurrent_hashmap.h"
+#include "trpc/util/hazptr/hazptr_object.h"
+
+namespace trpc {
+
+constexpr char kMaglevLoadBalance[] = "maglev";
+
+/// @brief Maglev consistent hash load balancing plugin.
+///
+/// A lookup table mapping hash values to endpoints is built once per endpoint update, selection is a single table
+/// access under a hazard pointer, without any lock. The table is filled by the permutation of each endpoint derived
+/// from its address, so that an endpoint joining or leaving only remaps the keys it gains or owned.
+///
+/// It shares `hash_args` and `hash_func` configurations with consistent hash load balancing plugin, `hash_nodes` is
+/// not used.
+class MaglevLoadBalance : public LoadBalance {
+ public:
+  MaglevLoadBalance() = default;
+  ~MaglevLoadBalance() override;
+
+  /// @brief Get the name of the load balancing plugin
+  std::string Name() const override { return kMaglevLoadBalance; }
+
+  /// @brief Initialization
+  /// @return Returns 0 on success, -1 on failure
+  int Init() noexcept override;
+
+  /// @brief Update the routing node information used by the load balancing
+  int Update(const LoadBalanceInfo* info) override;
+
+  /// @brief Return a callee node
+  int Next(LoadBalanceResult& result) override;
+
+  /// @brief Choose the size of lookup table for `endpoints_num` endpoints, it's a prime much larger than
+  /// `endpoints_num` to keep the keys evenly spread.
+  static uint32_t GetTableSize(std::size_t endpoints_num);
+
+ private:
+  struct Table : HazptrObject<Table> {
+    // Endpoints in the order of update.
+    std::vector<TrpcEndpointInfo> endpoints;
+    // Index into `endpoints` of each slot.
+    std::vector<uint32_t> lookup;
+  };
+
+  struct Callee {
+    std::atomic<Table*> table{nullptr};
+  };
+
+  static std::unique_ptr<Table> BuildTable(const std::vector<TrpcEndpointInfo>& endpoints);
+
+  uint64_t GetHash(const SelectorInfo* info) const;
+
+ private:
+  naming::LoadBalanceConfig loadbalance_config_;
+
+  HashFuncName hash_func_{HashFuncName::kMurmur3};
+
+  concurrency::LightlyConcurrentHashMap<std::string, Callee*> callees_;
+
+  // Serializes updates, and owns the entries of `callees_`.
+  std::mutex update_mutex_;
+  std::vector<std::unique_ptr<Callee>> callees_holder_;
+};
+
+using MaglevLoadBalancePtr = RefPtr<MaglevLoadBalance>;
+
+}  // namespace trpc
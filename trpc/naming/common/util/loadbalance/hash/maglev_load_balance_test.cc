@@ -0,0 +1,174 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/naming/common/util/loadbalance/hash/maglev_load_balance.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/client/client_context.h"
+#include "trpc/codec/trpc/trpc_client_codec.h"
+
+namespace trpc::testing {
+
+namespace {
+
+constexpr char kServiceName[] = "trpc.test.helloworld.Greeter";
+constexpr int kKeyNum = 10000;
+
+std::vector<TrpcEndpointInfo> MakeEndpoints(int num) {
+  std::vector<TrpcEndpointInfo> endpoints;
+  for (int i = 0; i < num; ++i) {
+    TrpcEndpointInfo endpoint;
+    endpoint.host = "127.0.0.1";
+    endpoint.port = 10000 + i;
+    endpoint.id = i;
+    endpoints.push_back(endpoint);
+  }
+  return endpoints;
+}
+
+}  // namespace
+
+class MaglevLoadBalanceTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    load_balance_ = MakeRefCounted<MaglevLoadBalance>();
+    ASSERT_EQ(0, load_balance_->Init());
+
+    for (int i = 0; i < kKeyNum; ++i) {
+      auto context = MakeRefCounted<ClientContext>();
+      context->SetHashKey(std::to_string(i * 2654435761ULL));
+      contexts_.push_back(context);
+    }
+  }
+
+  void Update(const std::vector<TrpcEndpointInfo>& endpoints) {
+    SelectorInfo selector_info;
+    selector_info.name = kServiceName;
+    LoadBalanceInfo info{&selector_info, &endpoints};
+    ASSERT_EQ(0, load_balance_->Update(&info));
+  }
+
+  // Returns the port selected for each key.
+  std::vector<int> SelectAll() {
+    std::vector<int> ports;
+    for (const auto& context : contexts_) {
+      SelectorInfo selector_info;
+      selector_info.name = kServiceName;
+      selector_info.context = context;
+      LoadBalanceResult result;
+      result.info = &selector_info;
+      EXPECT_EQ(0, load_balance_->Next(result));
+      ports.push_back(std::any_cast<TrpcEndpointInfo>(result.result).port);
+    }
+    return ports;
+  }
+
+ protected:
+  MaglevLoadBalancePtr load_balance_;
+  std::vector<ClientContextPtr> contexts_;
+};
+
+TEST_F(MaglevLoadBalanceTest, GetTableSize) {
+  ASSERT_EQ(65537, MaglevLoadBalance::GetTableSize(1));
+  ASSERT_EQ(65537, MaglevLoadBalance::GetTableSize(655));
+  ASSERT_EQ(131071, MaglevLoadBalance::GetTableSize(656));
+  ASSERT_EQ(1048573, MaglevLoadBalance::GetTableSize(100000));
+}
+
+TEST_F(MaglevLoadBalanceTest, EvenlySpread) {
+  Update(MakeEndpoints(10));
+
+  std::unordered_map<int, int> counts;
+  for (int port : SelectAll()) {
+    ++counts[port];
+  }
+  ASSERT_EQ(10, counts.size());
+  for (const auto& [port, count] : counts) {
+    EXPECT_NEAR(kKeyNum / 10, count, kKeyNum / 10 * 0.2) << port;
+  }
+}
+
+TEST_F(MaglevLoadBalanceTest, IrrelevantToUpdateOrder) {
+  auto endpoints = MakeEndpoints(10);
+  Update(endpoints);
+  auto ports = SelectAll();
+
+  std::shuffle(endpoints.begin(), endpoints.end(), std::mt19937(1));
+  Update(endpoints);
+  ASSERT_EQ(ports, SelectAll());
+}
+
+TEST_F(MaglevLoadBalanceTest, MinimalDisruption) {
+  auto endpoints = MakeEndpoints(10);
+  Update(endpoints);
+  auto before = SelectAll();
+
+  // Removes an endpoint, only the keys it owned and a few others are remapped.
+  int removed_port = endpoints[3].port;
+  endpoints.erase(endpoints.begin() + 3);
+  Update(endpoints);
+  auto after = SelectAll();
+
+  int moved = 0;
+  for (int i = 0; i < kKeyNum; ++i) {
+    ASSERT_NE(removed_port, after[i]);
+    if (before[i] != removed_port && before[i] != after[i]) {
+      ++moved;
+    }
+  }
+  EXPECT_LT(moved, kKeyNum * 0.02);
+
+  // Adds it back, the keys go back to where they were.
+  endpoints = MakeEndpoints(10);
+  Update(endpoints);
+  ASSERT_EQ(before, SelectAll());
+}
+
+TEST_F(MaglevLoadBalanceTest, HashArgs) {
+  Update(MakeEndpoints(10));
+
+  auto context = MakeRefCounted<ClientContext>(std::make_shared<TrpcClientCodec>());
+  context->SetCallerName("trpc.test.helloworld.Client");
+  SelectorInfo selector_info;
+  selector_info.name = kServiceName;
+  selector_info.context = context;
+
+  LoadBalanceResult result;
+  result.info = &selector_info;
+  ASSERT_EQ(0, load_balance_->Next(result));
+  int port = std::any_cast<TrpcEndpointInfo>(result.result).port;
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(0, load_balance_->Next(result));
+    ASSERT_EQ(port, std::any_cast<TrpcEndpointInfo>(result.result).port);
+  }
+}
+
+TEST_F(MaglevLoadBalanceTest, NoEndpoint) {
+  SelectorInfo selector_info;
+  selector_info.name = kServiceName;
+  LoadBalanceResult result;
+  result.info = &selector_info;
+  ASSERT_EQ(-1, load_balance_->Next(result));
+
+  Update({});
+  ASSERT_EQ(-1, load_balance_->Next(result));
+}
+
+}  // namespace trpc::testing
@@ -0,0 +1,236 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/naming/common/util/loadbalance/p2c/p2c_load_balance.h"
+
+#include <cmath>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "trpc/codec/trpc/trpc.pb.h"
+#include "trpc/common/config/trpc_config.h"
+#include "trpc/naming/common/util/loadbalance/hash/common.h"
+#include "trpc/naming/load_balance_factory.h"
+#include "trpc/util/algorithm/random.h"
+#include "trpc/util/hazptr/hazptr.h"
+#include "trpc/util/log/logging.h"
+#include "trpc/util/time.h"
+
+namespace trpc {
+
+namespace {
+
+// Invocations failed with these framework error codes were never sent to the endpoint.
+bool IsUnsent(int framework_retcode) {
+  return framework_retcode == TrpcRetCode::TRPC_CLIENT_ENCODE_ERR ||
+         framework_retcode == TrpcRetCode::TRPC_CLIENT_ROUTER_ERR ||
+         framework_retcode == TrpcRetCode::TRPC_CLIENT_LIMITED_ERR ||
+         framework_retcode == TrpcRetCode::TRPC_CLIENT_OVERLOAD_ERR;
+}
+
+}  // namespace
+
+P2cLoadBalance::~P2cLoadBalance() {
+  for (auto& callee : callees_holder_) {
+    Table* table = callee->table.exchange(nullptr, std::memory_order_acq_rel);
+    if (table) {
+      table->Retire();
+    }
+  }
+}
+
+int P2cLoadBalance::Init() noexcept {
+  if (!trpc::TrpcConfig::GetInstance()->GetPluginConfig("loadbalance", kP2cLoadBalance, loadbalance_config_)) {
+    TRPC_FMT_DEBUG("get loadbalance config failed, use default value");
+  }
+
+  bool res = true;
+  if (loadbalance_config_.ewma_decay_time_ms < 1) {
+    res = false;
+    TRPC_FMT_DEBUG("ewma decay time is invalid, use default config");
+    // set to default value
+    loadbalance_config_.ewma_decay_time_ms = 10000;
+  }
+  decay_time_us_ = loadbalance_config_.ewma_decay_time_ms * 1000.0;
+  failure_penalty_us_ = loadbalance_config_.failure_penalty_ms * 1000.0;
+  return res ? 0 : -1;
+}
+
+uint64_t P2cLoadBalance::GetAddressKey(std::string_view host, int port) {
+  return std::hash<std::string_view>{}(host) ^ (static_cast<uint64_t>(port) * 0x9E3779B97F4A7C15ULL);
+}
+
+int P2cLoadBalance::Update(const LoadBalanceInfo* info) {
+  if (nullptr == info || nullptr == info->info || nullptr == info->endpoints) {
+    TRPC_LOG_ERROR("Endpoint info of name is empty");
+    return -1;
+  }
+
+  const std::string& name = info->info->name;
+
+  std::scoped_lock _(update_mutex_);
+  Callee* callee = nullptr;
+  if (!callees_.Get(name, callee)) {
+    callees_holder_.push_back(std::make_unique<Callee>());
+    callee = callees_holder_.back().get();
+    callees_.Insert(name, callee);
+  }
+
+  // Only updaters replace the table and they are serialized, no hazard pointer is needed here.
+  Table* old_table = callee->table.load(std::memory_order_acquire);
+  if (old_table && !CheckLoadbalanceInfoDiff(old_table->endpoints, info->endpoints)) {
+    return 0;
+  }
+
+  auto new_table = std::make_unique<Table>();
+  new_table->endpoints = *info->endpoints;
+  new_table->stats.reserve(new_table->endpoints.size());
+  for (uint32_t i = 0; i < new_table->endpoints.size(); ++i) {
+    const auto& endpoint = new_table->endpoints[i];
+    uint64_t key = GetAddressKey(endpoint.host, endpoint.port);
+
+    // Endpoints still present keep their statistics.
+    std::shared_ptr<EndpointStat> stat;
+    if (old_table) {
+      auto iter = old_table->index.find(key);
+      if (iter != old_table->index.end()) {
+        const auto& old_endpoint = old_table->endpoints[iter->second];
+        if (old_endpoint.host == endpoint.host && old_endpoint.port == endpoint.port) {
+          stat = old_table->stats[iter->second];
+        }
+      }
+    }
+    new_table->stats.push_back(stat ? std::move(stat) : std::make_shared<EndpointStat>());
+    new_table->index.emplace(key, i);
+  }
+
+  old_table = callee->table.exchange(new_table.release(), std::memory_order_acq_rel);
+  if (old_table) {
+    old_table->Retire();
+  }
+
+  return 0;
+}
+
+double P2cLoadBalance::GetCost(const EndpointStat& stat, uint64_t now_us) const {
+  int64_t pending = std::max<int64_t>(stat.pending.load(std::memory_order_relaxed), 0);
+  double ewma_us = stat.ewma_us.load(std::memory_order_relaxed);
+  if (ewma_us == 0) {
+    // Never observed, don't flood it before the first response comes back.
+    return pending == 0 ? 0 : failure_penalty_us_ + pending;
+  }
+
+  uint64_t stamp_us = stat.stamp_us.load(std::memory_order_relaxed);
+  if (now_us > stamp_us) {
+    ewma_us *= std::exp(-static_cast<double>(now_us - stamp_us) / decay_time_us_);
+  }
+  return ewma_us * (pending + 1);
+}
+
+void P2cLoadBalance::Observe(EndpointStat* stat, double latency_us, uint64_t now_us) const {
+  double ewma_us = stat->ewma_us.load(std::memory_order_relaxed);
+  uint64_t stamp_us = stat->stamp_us.load(std::memory_order_relaxed);
+  if (latency_us > ewma_us) {
+    ewma_us = latency_us;
+  } else {
+    double w = now_us > stamp_us ? std::exp(-static_cast<double>(now_us - stamp_us) / decay_time_us_) : 1.0;
+    ewma_us = ewma_us * w + latency_us * (1 - w);
+  }
+  // Concurrent observations may overwrite each other, which is acceptable for statistics.
+  stat->ewma_us.store(std::max(ewma_us, 1.0), std::memory_order_relaxed);
+  stat->stamp_us.store(now_us, std::memory_order_relaxed);
+}
+
+int P2cLoadBalance::Next(LoadBalanceResult& result) {
+  if (nullptr == result.info) {
+    return -1;
+  }
+
+  Callee* callee = nullptr;
+  if (!callees_.Get(result.info->name, callee)) {
+    TRPC_LOG_ERROR("Router info of name " << result.info->name << " no found");
+    return -1;
+  }
+
+  Hazptr hazptr;
+  Table* table = hazptr.Keep(&callee->table);
+  std::size_t num = table ? table->endpoints.size() : 0;
+  if (num == 0) {
+    TRPC_LOG_ERROR("Router info of name is empty");
+    return -1;
+  }
+
+  std::size_t selected = 0;
+  if (num > 1) {
+    std::size_t first = Random<std::size_t>() % num;
+    std::size_t second = Random<std::size_t>() % (num - 1);
+    if (second >= first) {
+      ++second;
+    }
+    uint64_t now_us = trpc::time::GetMicroSeconds();
+    selected = GetCost(*table->stats[first], now_us) <= GetCost(*table->stats[second], now_us) ? first : second;
+  }
+
+  // Outstanding requests are only counted if the invocation result can be matched with the pick.
+  const ClientContextPtr& context = result.info->context;
+  if (context) {
+    const auto& stat = table->stats[selected];
+    stat->pending.fetch_add(1, std::memory_order_relaxed);
+    Pick* pick = context->GetFilterData<Pick>(GetPluginID());
+    if (pick == nullptr) {
+      context->SetFilterData(GetPluginID(), Pick(stat));
+    } else {
+      // Selected again for the same invocation without being reported.
+      if (*pick) {
+        (*pick)->pending.fetch_sub(1, std::memory_order_relaxed);
+      }
+      *pick = stat;
+    }
+  }
+  result.result = table->endpoints[selected];
+
+  return 0;
+}
+
+int P2cLoadBalance::ReportInvokeResult(const InvokeResult* result) {
+  if (nullptr == result || !result->context) {
+    return -1;
+  }
+
+  Pick* pick = result->context->GetFilterData<Pick>(GetPluginID());
+  if (pick == nullptr || *pick == nullptr) {
+    // Not selected by this load balancer, or already reported.
+    return 0;
+  }
+  Pick stat = std::move(*pick);
+  *pick = nullptr;
+  stat->pending.fetch_sub(1, std::memory_order_relaxed);
+
+  if (IsUnsent(result->framework_result)) {
+    return 0;
+  }
+
+  uint64_t now_us = trpc::time::GetMicroSeconds();
+  uint64_t send_us = result->context->GetSendTimestampUs();
+  double latency_us = send_us && now_us > send_us ? now_us - send_us : result->cost_time * 1000.0;
+  if (result->framework_result != 0) {
+    latency_us = std::max(latency_us, failure_penalty_us_);
+  }
+  Observe(stat.get(), latency_us, now_us);
+
+  return 0;
+}
+
+}  // namespace trpc
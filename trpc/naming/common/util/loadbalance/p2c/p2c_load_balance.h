@@ -0,0 +1,114 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "trpc/common/config/loadbalance_naming_conf.h"
+#include "trpc/common/config/loadbalance_naming_conf_parser.h"
+#include "trpc/naming/load_balance.h"
+#include "trpc/util/concurrency/lightly_concurrent_hashmap.h"
+#include "trpc/util/hazptr/hazptr_object.h"
+
+namespace trpc {
+
+constexpr char kP2cLoadBalance[] = "p2c";
+
+/// @brief Power of two choices load balancing plugin.
+///
+/// Picks two endpoints at random and selects the one with the lower cost, the cost of an endpoint is its peak EWMA
+/// latency multiplied by its outstanding requests plus one. The latency jumps to any higher observation immediately
+/// and decays to lower ones by `ewma_decay_time_ms`, it also decays towards zero while the endpoint is not invoked, so
+/// that an endpoint avoided for being slow gets probed again. Failed invocations are charged `failure_penalty_ms`.
+///
+/// Outstanding requests are counted from `Next` to `ReportInvokeResult`. The endpoint picked by `Next` is recorded in
+/// the client context, so only the invocations this load balancer selected release an outstanding request.
+class P2cLoadBalance : public LoadBalance {
+ public:
+  P2cLoadBalance() = default;
+  ~P2cLoadBalance() override;
+
+  /// @brief Get the name of the load balancing plugin
+  std::string Name() const override { return kP2cLoadBalance; }
+
+  /// @brief Initialization
+  /// @return Returns 0 on success, -1 on failure
+  int Init() noexcept override;
+
+  /// @brief Update the routing node information used by the load balancing
+  int Update(const LoadBalanceInfo* info) override;
+
+  /// @brief Return a callee node
+  int Next(LoadBalanceResult& result) override;
+
+  /// @brief Invocation results are needed to track latency and outstanding requests
+  bool NeedInvokeResult() const override { return true; }
+
+  /// @brief Update the latency and outstanding requests of the node selected for the invocation
+  int ReportInvokeResult(const InvokeResult* result) override;
+
+ private:
+  // Statistics of an endpoint, kept across updates as long as the endpoint exists.
+  struct EndpointStat {
+    // Number of outstanding requests.
+    std::atomic<int64_t> pending{0};
+    // Peak EWMA latency in microseconds, 0 if never observed.
+    std::atomic<double> ewma_us{0};
+    // When `ewma_us` was last updated, in microseconds.
+    std::atomic<uint64_t> stamp_us{0};
+  };
+
+  struct Table : HazptrObject<Table> {
+    std::vector<TrpcEndpointInfo> endpoints;
+    std::vector<std::shared_ptr<EndpointStat>> stats;
+    // Index into `endpoints` by address.
+    std::unordered_map<uint64_t, uint32_t> index;
+  };
+
+  struct Callee {
+    std::atomic<Table*> table{nullptr};
+  };
+
+  // The endpoint picked for an invocation, recorded in the client context by `Next`.
+  using Pick = std::shared_ptr<EndpointStat>;
+
+  static uint64_t GetAddressKey(std::string_view host, int port);
+
+  double GetCost(const EndpointStat& stat, uint64_t now_us) const;
+
+  void Observe(EndpointStat* stat, double latency_us, uint64_t now_us) const;
+
+ private:
+  naming::LoadBalanceConfig loadbalance_config_;
+
+  double decay_time_us_{0};
+  double failure_penalty_us_{0};
+
+  concurrency::LightlyConcurrentHashMap<std::string, Callee*> callees_;
+
+  // Serializes updates, and owns the entries of `callees_`.
+  std::mutex update_mutex_;
+  std::vector<std::unique_ptr<Callee>> callees_holder_;
+};
+
+using P2cLoadBalancePtr = RefPtr<P2cLoadBalance>;
+
+}  // namespace trpc
@@ -0,0 +1,197 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/naming/common/util/loadbalance/p2c/p2c_load_balance.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/client/client_context.h"
+#include "trpc/codec/trpc/trpc.pb.h"
+#include "trpc/codec/trpc/trpc_client_codec.h"
+
+namespace trpc::testing {
+
+namespace {
+
+constexpr char kServiceName[] = "trpc.test.helloworld.Greeter";
+
+std::vector<TrpcEndpointInfo> MakeEndpoints(int num) {
+  std::vector<TrpcEndpointInfo> endpoints;
+  for (int i = 0; i < num; ++i) {
+    TrpcEndpointInfo endpoint;
+    endpoint.host = "127.0.0.1";
+    endpoint.port = 10000 + i;
+    endpoint.id = i;
+    endpoints.push_back(endpoint);
+  }
+  return endpoints;
+}
+
+}  // namespace
+
+class P2cLoadBalanceTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    load_balance_ = MakeRefCounted<P2cLoadBalance>();
+    ASSERT_EQ(0, load_balance_->Init());
+    Update(MakeEndpoints(2));
+  }
+
+  void Update(const std::vector<TrpcEndpointInfo>& endpoints) {
+    SelectorInfo selector_info;
+    selector_info.name = kServiceName;
+    LoadBalanceInfo info{&selector_info, &endpoints};
+    ASSERT_EQ(0, load_balance_->Update(&info));
+  }
+
+  // Selects an endpoint for a new invocation, returns the port of the endpoint and the context of the invocation.
+  std::pair<int, ClientContextPtr> Pick() {
+    SelectorInfo selector_info;
+    selector_info.name = kServiceName;
+    selector_info.context = MakeRefCounted<ClientContext>(std::make_shared<TrpcClientCodec>());
+    LoadBalanceResult result;
+    result.info = &selector_info;
+    EXPECT_EQ(0, load_balance_->Next(result));
+    return {std::any_cast<TrpcEndpointInfo>(result.result).port, selector_info.context};
+  }
+
+  int Next() { return Pick().first; }
+
+  void Report(const ClientContextPtr& context, uint64_t cost_time_ms, int framework_result = 0) {
+    InvokeResult result;
+    result.name = kServiceName;
+    result.framework_result = framework_result;
+    result.interface_result = 0;
+    result.cost_time = cost_time_ms;
+    result.context = context;
+    ASSERT_EQ(0, load_balance_->ReportInvokeResult(&result));
+  }
+
+  // Observes the latency of both endpoints, never observed endpoints without outstanding requests are picked first.
+  void Observe(uint64_t cost_time_ms_10000, uint64_t cost_time_ms_10001, int framework_result_10000 = 0) {
+    auto first = Pick();
+    auto second = Pick();
+    ASSERT_NE(first.first, second.first);
+    for (auto& [port, context] : {first, second}) {
+      if (port == 10000) {
+        Report(context, cost_time_ms_10000, framework_result_10000);
+      } else {
+        Report(context, cost_time_ms_10001);
+      }
+    }
+  }
+
+ protected:
+  P2cLoadBalancePtr load_balance_;
+};
+
+TEST_F(P2cLoadBalanceTest, PreferLowerLatency) {
+  Observe(1, 100);
+
+  // Outstanding requests grow on the faster endpoint, it is still cheaper until about 100 of them.
+  for (int i = 0; i < 50; ++i) {
+    ASSERT_EQ(10000, Next());
+  }
+}
+
+TEST_F(P2cLoadBalanceTest, PreferFewerOutstandingRequests) {
+  // Never observed, the endpoint with an outstanding request costs more.
+  auto first = Pick();
+  auto second = Pick();
+  ASSERT_NE(first.first, second.first);
+
+  Report(first.second, 1);
+  Report(second.second, 1);
+  Next();
+  Next();
+  // Then the endpoint selected by `third` has two outstanding requests, and the other one has one.
+  int third = Next();
+  int fourth = Next();
+  ASSERT_NE(third, fourth);
+}
+
+TEST_F(P2cLoadBalanceTest, FailurePenalty) {
+  Observe(1, 10, TrpcRetCode::TRPC_CLIENT_NETWORK_ERR);
+
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(10001, Next());
+  }
+}
+
+TEST_F(P2cLoadBalanceTest, UnsentReleasesPendingOnly) {
+  auto first = Pick();
+  auto second = Pick();
+  ASSERT_NE(first.first, second.first);
+  Report(first.second, 100000, TrpcRetCode::TRPC_CLIENT_ROUTER_ERR);
+  Report(second.second, 1);
+
+  // Nothing observed and nothing outstanding on the first one, while the second one is observed.
+  ASSERT_EQ(first.first, Next());
+}
+
+TEST_F(P2cLoadBalanceTest, ReportPicksOnly) {
+  Observe(1, 100);
+
+  // Invocations not selected by the load balancer are ignored.
+  auto context = MakeRefCounted<ClientContext>(std::make_shared<TrpcClientCodec>());
+  context->SetAddr("127.0.0.1", 10000);
+  Report(context, 100000, TrpcRetCode::TRPC_CLIENT_NETWORK_ERR);
+
+  // A pick is reported once, so the outstanding request is released once.
+  auto pick = Pick();
+  ASSERT_EQ(10000, pick.first);
+  Report(pick.second, 1);
+  Report(pick.second, 1);
+
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(10000, Next());
+  }
+}
+
+TEST_F(P2cLoadBalanceTest, KeepStatisticsOnUpdate) {
+  Observe(1, 100);
+
+  auto endpoints = MakeEndpoints(2);
+  std::swap(endpoints[0], endpoints[1]);
+  Update(endpoints);
+
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(10000, Next());
+  }
+
+  // Removed endpoints are never selected, their picks can still be reported.
+  auto pick = Pick();
+  Update(MakeEndpoints(1));
+  ASSERT_EQ(10000, Next());
+  Report(pick.second, 1);
+}
+
+TEST_F(P2cLoadBalanceTest, UnknownCallee) {
+  SelectorInfo selector_info;
+  selector_info.name = "unknown";
+  LoadBalanceResult result;
+  result.info = &selector_info;
+  ASSERT_EQ(-1, load_balance_->Next(result));
+
+  InvokeResult invoke_result;
+  invoke_result.name = "unknown";
+  invoke_result.context = MakeRefCounted<ClientContext>(std::make_shared<TrpcClientCodec>());
+  ASSERT_EQ(0, load_balance_->ReportInvokeResult(&invoke_result));
+}
+
+}  // namespace trpc::testing
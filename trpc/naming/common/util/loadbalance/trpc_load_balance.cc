@@ -14,7 +14,9 @@
 #include "trpc/naming/common/util/loadbalance/trpc_load_balance.h"
 
 #include "trpc/naming/common/util/loadbalance/hash/consistenthash_load_balance.h"
+#include "trpc/naming/common/util/loadbalance/hash/maglev_load_balance.h"
 #include "trpc/naming/common/util/loadbalance/hash/modulohash_load_balance.h"
+#include "trpc/naming/common/util/loadbalance/p2c/p2c_load_balance.h"
 #include "trpc/naming/common/util/loadbalance/polling/polling_load_balance.h"
 #include "trpc/naming/common/util/loadbalance/weighted_round_robin/weighted_round_robin_load_balancer.h"
 #include "trpc/naming/load_balance_factory.h"
@@ -56,6 +58,28 @@ bool Init() {
     }
   }
 
+  LoadBalancePtr maglev_load_balance = trpc::LoadBalanceFactory::GetInstance()->Get(kMaglevLoadBalance);
+  if (maglev_load_balance == nullptr) {
+    maglev_load_balance = MakeRefCounted<MaglevLoadBalance>();
+    int ret = maglev_load_balance->Init();
+    if (!ret) {
+      LoadBalanceFactory::GetInstance()->Register(maglev_load_balance);
+    } else {
+      res = false;
+    }
+  }
+
+  LoadBalancePtr p2c_load_balance = trpc::LoadBalanceFactory::GetInstance()->Get(kP2cLoadBalance);
+  if (p2c_load_balance == nullptr) {
+    p2c_load_balance = MakeRefCounted<P2cLoadBalance>();
+    int ret = p2c_load_balance->Init();
+    if (!ret) {
+      LoadBalanceFactory::GetInstance()->Register(p2c_load_balance);
+    } else {
+      res = false;
+    }
+  }
+
   LoadBalancePtr modulohash_load_balance = trpc::LoadBalanceFactory::GetInstance()->Get(kModuloHashLoadBalance);
   if (modulohash_load_balance == nullptr) {
     modulohash_load_balance = MakeRefCounted<ModuloHashLoadBalance>();
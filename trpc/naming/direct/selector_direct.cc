@@ -51,6 +51,7 @@ int SelectorDirect::Select(const SelectorInfo* info, TrpcEndpointInfo* endpoint)
     return -1;
   }
 
+  RecordLoadBalanceToReport(GetPluginID(), lb, info->context);
   *endpoint = std::move(std::any_cast<TrpcEndpointInfo>(load_balance_result.result));
   return 0;
 }
@@ -66,6 +67,7 @@ Future<TrpcEndpointInfo> SelectorDirect::AsyncSelect(const SelectorInfo* info) {
     return MakeExceptionFuture<TrpcEndpointInfo>(CommonException(error_str.c_str()));
   }
 
+  RecordLoadBalanceToReport(GetPluginID(), lb, info->context);
   TrpcEndpointInfo endpoint = std::move(std::any_cast<TrpcEndpointInfo>(load_balance_result.result));
   return MakeReadyFuture<TrpcEndpointInfo>(std::move(endpoint));
 }
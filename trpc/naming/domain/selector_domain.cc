@@ -142,6 +142,7 @@ int SelectorDomain::Select(const SelectorInfo* info, TrpcEndpointInfo* endpoint)
     return -1;
   }
 
+  RecordLoadBalanceToReport(GetPluginID(), lb, info->context);
   *endpoint = std::any_cast<TrpcEndpointInfo>(load_balance_result.result);
   return 0;
 }
@@ -162,6 +163,7 @@ Future<TrpcEndpointInfo> SelectorDomain::AsyncSelect(const SelectorInfo* info) {
     return MakeExceptionFuture<TrpcEndpointInfo>(CommonException(error_str.c_str()));
   }
 
+  RecordLoadBalanceToReport(GetPluginID(), lb, info->context);
   TrpcEndpointInfo endpoint = std::any_cast<TrpcEndpointInfo>(load_balance_result.result);
   return MakeReadyFuture<TrpcEndpointInfo>(std::move(endpoint));
 }
@@ -52,8 +52,35 @@ class LoadBalance : public Plugin {
   /// @return int 0: selection succeeded
   ///             -1: selection failed
   virtual int Next(LoadBalanceResult& result) = 0;
+
+  /// @brief Whether the load balancing algorithm needs the results of the invocations it selected the endpoint for,
+  ///        e.g. to count outstanding requests. The selectors provided by the framework record such a load balancer in
+  ///        the context on selection, and only those invocations are reported to it
+  virtual bool NeedInvokeResult() const { return false; }
+
+  /// @brief Feed the result of an invocation whose endpoint was selected by `Next` to the load balancing algorithm,
+  ///        called only if `NeedInvokeResult` returns true
+  /// @param result The invocation result
+  /// @return int 0: report succeeded
+  ///             -1: report failed
+  virtual int ReportInvokeResult(const InvokeResult* result) { return 0; }
 };
 
 using LoadBalancePtr = RefPtr<LoadBalance>;
 
+/// @brief Record in `context` that the result of its invocation is to be fed to `load_balance`, which selected the
+///        endpoint. Nothing is recorded unless `load_balance` needs invocation results
+/// @param key Key of the record in the filter data of `context`, the selectors use their plugin id
+inline void RecordLoadBalanceToReport(uint32_t key, LoadBalance* load_balance, const ClientContextPtr& context) {
+  if (context && load_balance->NeedInvokeResult()) {
+    context->SetFilterData(key, load_balance);
+  }
+}
+
+/// @brief Get the load balancer recorded by `RecordLoadBalanceToReport`, nullptr if none
+inline LoadBalance* GetLoadBalanceToReport(uint32_t key, const ClientContextPtr& context) {
+  LoadBalance** load_balance = context->GetFilterData<LoadBalance*>(key);
+  return load_balance ? *load_balance : nullptr;
+}
+
 }  // namespace trpc
@@ -17,6 +17,7 @@
 
 #include "trpc/codec/trpc/trpc.pb.h"
 #include "trpc/naming/common/constants.h"
+#include "trpc/naming/load_balance.h"
 #include "trpc/util/log/logging.h"
 #include "trpc/util/string/string_util.h"
 #include "trpc/util/time.h"
@@ -193,6 +194,14 @@ int SelectorWorkFlow::ReportInvokeResult(const ClientContextPtr& context) {
     return 0;
   }
 
+  // Load balancers needing invocation results get every invocation they selected the endpoint for, unsent ones too
+  LoadBalance* load_balance = selector_ ? GetLoadBalanceToReport(selector_->GetPluginID(), context) : nullptr;
+  if (load_balance) {
+    InvokeResult invoke_result;
+    FillInvokeResult(context, invoke_result);
+    load_balance->ReportInvokeResult(&invoke_result);
+  }
+
   if (need_report_) {
     // Determine if a circuit breaker needs to be reported based on the framework return code
     if (ShouldReport(context->GetStatus().GetFrameworkRetCode())) {
@@ -21,6 +21,7 @@
 
 #include "trpc/client/client_context.h"
 #include "trpc/codec/trpc/trpc_client_codec.h"
+#include "trpc/naming/load_balance.h"
 #include "trpc/naming/selector.h"
 #include "trpc/naming/selector_factory.h"
 
@@ -105,6 +106,30 @@ class MockSelector : public Selector {
   Option option_;
 };
 
+/// @brief Mock load balancing plugin counting the reported invocation results
+class MockLoadBalance : public LoadBalance {
+ public:
+  explicit MockLoadBalance(bool need_invoke_result) : need_invoke_result_(need_invoke_result) {}
+
+  std::string Name() const override { return "mock_load_balance"; }
+
+  int Update(const LoadBalanceInfo* info) override { return 0; }
+
+  int Next(LoadBalanceResult& result) override { return 0; }
+
+  bool NeedInvokeResult() const override { return need_invoke_result_; }
+
+  int ReportInvokeResult(const InvokeResult* result) override {
+    ++report_count;
+    return 0;
+  }
+
+  int report_count{0};
+
+ private:
+  bool need_invoke_result_;
+};
+
 }  // namespace
 
 class SelectorWorkFlowTest : public ::testing::Test {
@@ -170,4 +195,51 @@ TEST_F(SelectorWorkFlowTest, SelectTarget) {
   SelectorFactory::GetInstance()->Clear();
 }
 
+TEST_F(SelectorWorkFlowTest, ReportToLoadBalance) {
+  ServiceProxyOption option;
+  option.name = "foo.test";
+  option.target = "foo.test";
+  option.selector_name = "mock_selector";
+
+  auto need_result = MakeRefCounted<MockLoadBalance>(true);
+  auto no_result = MakeRefCounted<MockLoadBalance>(false);
+  LoadBalance* selected_by = nullptr;
+  Selector* selector_ptr = nullptr;
+  MockSelector::Option mock_selector_option{
+    select : [&](const SelectorInfo* info, TrpcEndpointInfo* endpoint) -> int {
+      if (selected_by) {
+        RecordLoadBalanceToReport(selector_ptr->GetPluginID(), selected_by, info->context);
+      }
+      endpoint->host = "127.0.0.1";
+      endpoint->port = 12345;
+      return 0;
+    }
+  };
+  auto selector = MakeRefCounted<MockSelector>(mock_selector_option);
+  selector_ptr = selector.get();
+  SelectorFactory::GetInstance()->Register(selector);
+  // Reporting to the selector is disabled, load balancers needing results are fed regardless.
+  SelectorWorkFlow work_flow{"mock_selector", false, false};
+  auto trpc_codec = std::make_shared<TrpcClientCodec>();
+
+  auto invoke = [&](LoadBalance* load_balance) {
+    selected_by = load_balance;
+    auto context = trpc::MakeRefCounted<ClientContext>(trpc_codec);
+    context->SetServiceProxyOption(&option);
+    ASSERT_TRUE(work_flow.SelectTarget(context));
+    work_flow.ReportInvokeResult(context);
+  };
+
+  invoke(need_result.get());
+  ASSERT_EQ(need_result->report_count, 1);
+
+  // Not selected by a load balancer needing results, nothing is reported.
+  invoke(no_result.get());
+  invoke(nullptr);
+  ASSERT_EQ(need_result->report_count, 1);
+  ASSERT_EQ(no_result->report_count, 0);
+
+  SelectorFactory::GetInstance()->Clear();
+}
+
 }  // namespace trpc::testing
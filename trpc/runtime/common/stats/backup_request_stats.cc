@@ -28,6 +28,9 @@ BackupRequestStats::Data BackupRequestStats::GetData(const std::string& service_
   std::string path{"trpc/client/"};
   path.append(service_name);
 
+  std::string calls_path = path + "/backup_request_calls";
+  data.calls = std::make_shared<tvar::Counter<uint64_t>>(calls_path);
+
   std::string retries_path = path + "/backup_request";
   data.retries = std::make_shared<tvar::Counter<uint64_t>>(retries_path);
 
@@ -39,17 +42,17 @@ BackupRequestStats::Data BackupRequestStats::GetData(const std::string& service_
   return data;
 }
 
-void BackupRequestStats::CheckReportData(const std::shared_ptr<tvar::Counter<uint64_t>>& retries,
-                                         const std::shared_ptr<tvar::Counter<uint64_t>>& retries_success,
+void BackupRequestStats::CheckReportData(const Data& data,
                                          std::unordered_map<std::string, uint64_t>& report_values) {
-  auto abs_path = retries->GetAbsPath();
-  auto value = retries->GetValue();
+  auto abs_path = data.retries->GetAbsPath();
+  auto value = data.retries->GetValue();
   // If the backup request is not triggered, do not report.
   if (value == 0) {
     return;
   }
   report_values.emplace(std::move(abs_path), value);
-  report_values.emplace(retries_success->GetAbsPath(), retries_success->GetValue());
+  report_values.emplace(data.retries_success->GetAbsPath(), data.retries_success->GetValue());
+  report_values.emplace(data.calls->GetAbsPath(), data.calls->GetValue());
 }
 
 void BackupRequestStats::AsyncReportToMetrics(const std::string& metrics_name) {
@@ -63,11 +66,11 @@ void BackupRequestStats::AsyncReportToMetrics(const std::string& metrics_name) {
   }
 
   std::unordered_map<std::string, uint64_t> report_values;
-  report_values.reserve(service_data_.size() * 2);
+  report_values.reserve(service_data_.size() * 3);
   {
     std::unique_lock<std::mutex> lc(service_mutex_);
     for (auto& kv : service_data_) {
-      CheckReportData(kv.second.retries, kv.second.retries_success, report_values);
+      CheckReportData(kv.second, report_values);
     }
   }
 
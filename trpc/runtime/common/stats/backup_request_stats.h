@@ -31,6 +31,8 @@ class BackupRequestStats {
 
   /// @brief Statistical data of backup request
   struct Data {
+    /// count of calls with backup-request enabled, the denominator of the backup-request rate
+    std::shared_ptr<tvar::Counter<uint64_t>> calls;
     /// retry count of backup-request
     std::shared_ptr<tvar::Counter<uint64_t>> retries;
     /// success count caused by retry request of backup-request
@@ -46,9 +48,7 @@ class BackupRequestStats {
 
  private:
   // Check and get report data
-  void CheckReportData(const std::shared_ptr<tvar::Counter<uint64_t>>& retries,
-                       const std::shared_ptr<tvar::Counter<uint64_t>>& retries_success,
-                       std::unordered_map<std::string, uint64_t>& report_values);
+  void CheckReportData(const Data& data, std::unordered_map<std::string, uint64_t>& report_values);
 
  private:
   // key is service name, value is statistical data
@@ -26,11 +26,14 @@ TEST_F(FrameStatTest, BackupRequestStatsTest) {
   ASSERT_TRUE(data1.retries);
   ASSERT_EQ(data1.retries->GetAbsPath(), "/trpc/client/service1/backup_request");
   ASSERT_EQ(data1.retries->GetValue(), 0);
+  ASSERT_TRUE(data1.calls);
+  ASSERT_EQ(data1.calls->GetAbsPath(), "/trpc/client/service1/backup_request_calls");
 
   // Get the same tvar when use the same service name
   auto data2 = backup_request_stats.GetData("service1");
   ASSERT_EQ(data2.retries_success.get(), data1.retries_success.get());
   ASSERT_EQ(data2.retries.get(), data1.retries.get());
+  ASSERT_EQ(data2.calls.get(), data1.calls.get());
 
   // Get different tvar when use different service name
   auto data3 = backup_request_stats.GetData("service2");
@@ -50,21 +53,30 @@ TEST_F(FrameStatTest, CheckReportData) {
   backup_request_stats.AsyncReportToMetrics(metrics_name);
   ASSERT_TRUE(report_data.empty());
 
+  // Don't report calls without any backup request triggered
+  data1.calls->Update(10);
+  report_data.clear();
+  backup_request_stats.AsyncReportToMetrics(metrics_name);
+  ASSERT_TRUE(report_data.empty());
+
   // Report with data
   data1.retries->Update(3);
   report_data.clear();
   backup_request_stats.AsyncReportToMetrics(metrics_name);
-  ASSERT_EQ(report_data.size(), 2);
+  ASSERT_EQ(report_data.size(), 3);
   ASSERT_EQ(report_data[data1.retries->GetAbsPath()], 3);
+  ASSERT_EQ(report_data[data1.calls->GetAbsPath()], 10);
 
   // Report incremental data
   data1.retries->Update(2);
   data1.retries_success->Update(1);
+  data1.calls->Update(20);
   report_data.clear();
   backup_request_stats.AsyncReportToMetrics(metrics_name);
-  ASSERT_EQ(report_data.size(), 2);
+  ASSERT_EQ(report_data.size(), 3);
   ASSERT_EQ(report_data[data1.retries->GetAbsPath()], 2);
   ASSERT_EQ(report_data[data1.retries_success->GetAbsPath()], 1);
+  ASSERT_EQ(report_data[data1.calls->GetAbsPath()], 20);
 }
 
 }  // namespace trpc::testing
@@ -26,6 +26,14 @@ void FrameStats::Start() {
   // Get metrics plugins
   TrpcConfig::GetInstance()->GetPluginNodes("metrics", metrics_);
 
+  if (!memory_pool_stats_) {
+    memory_pool_stats_ = std::make_unique<MemoryPoolStats>();
+  }
+
+  if (!ssl_session_stats_) {
+    ssl_session_stats_ = std::make_unique<SslSessionStats>();
+  }
+
   // start periodical task
   if (task_id_ == 0) {
     last_server_stats_time_ = trpc::time::GetMilliSeconds();
@@ -41,6 +49,9 @@ void FrameStats::Stop() {
     PeripheryTaskScheduler::GetInstance()->JoinInnerTask(task_id_);
     task_id_ = 0;
   }
+
+  memory_pool_stats_.reset();
+  ssl_session_stats_.reset();
 }
 
 void FrameStats::Run() {
@@ -20,7 +20,9 @@
 #include <vector>
 
 #include "trpc/runtime/common/stats/backup_request_stats.h"
+#include "trpc/runtime/common/stats/memory_pool_stats.h"
 #include "trpc/runtime/common/stats/server_stats.h"
+#include "trpc/runtime/common/stats/ssl_session_stats.h"
 
 namespace trpc {
 
@@ -66,6 +68,12 @@ class FrameStats {
   // The last time when statistical data of backup request was reported
   uint64_t last_backup_request_time_{0};
 
+  // tvar of memory pool usage, exposed while the statistical task is running
+  std::unique_ptr<MemoryPoolStats> memory_pool_stats_;
+
+  // tvar of TLS session resumption, exposed while the statistical task is running
+  std::unique_ptr<SslSessionStats> ssl_session_stats_;
+
   // task id of the statistical task
   uint64_t task_id_{0};
 
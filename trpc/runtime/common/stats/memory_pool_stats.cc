@@ -0,0 +1,35 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/common/stats/memory_pool_stats.h"
+
+#include <string>
+
+#include "trpc/util/buffer/memory_pool/size_class_memory_pool.h"
+
+namespace trpc {
+
+MemoryPoolStats::MemoryPoolStats() {
+  using memory_pool::size_class::GetStatistics;
+
+  for (std::size_t i = 0; i != memory_pool::kSizeClassNum; ++i) {
+    std::string prefix =
+        "trpc/memory_pool/size_class_" + std::to_string(memory_pool::size_class::GetSizeClassBlockSize(i));
+    alive_blocks_.emplace_back(std::make_unique<tvar::PassiveStatus<std::size_t>>(
+        prefix + "/alive_blocks", [i] { return GetStatistics(i).alive_blocks; }));
+    global_cached_blocks_.emplace_back(std::make_unique<tvar::PassiveStatus<std::size_t>>(
+        prefix + "/global_cached_blocks", [i] { return GetStatistics(i).global_cached_blocks; }));
+  }
+}
+
+}  // namespace trpc
@@ -0,0 +1,41 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "trpc/tvar/basic_ops/passive_status.h"
+
+namespace trpc {
+
+/// @brief Exposes the usage of each size class of the memory pool through tvar, under
+///        `trpc/memory_pool/size_class_<block size>/`.
+class MemoryPoolStats {
+ public:
+  MemoryPoolStats();
+
+  MemoryPoolStats(const MemoryPoolStats&) = delete;
+  MemoryPoolStats& operator=(const MemoryPoolStats&) = delete;
+
+ private:
+  // Number of blocks allocated from the system and not yet freed to it.
+  std::vector<std::unique_ptr<tvar::PassiveStatus<std::size_t>>> alive_blocks_;
+
+  // Number of free blocks cached in the global free lists.
+  std::vector<std::unique_ptr<tvar::PassiveStatus<std::size_t>>> global_cached_blocks_;
+};
+
+}  // namespace trpc
@@ -0,0 +1,38 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#include "trpc/runtime/common/stats/ssl_session_stats.h"
+
+#ifdef TRPC_BUILD_INCLUDE_SSL
+#include "trpc/transport/common/ssl/ssl.h"
+#endif
+
+namespace trpc {
+
+#ifdef TRPC_BUILD_INCLUDE_SSL
+SslSessionStats::SslSessionStats() {
+  using ssl::GetSessionResumptionStatistics;
+
+  server_session_hits_ = std::make_unique<tvar::PassiveStatus<uint64_t>>(
+      "trpc/ssl/server/session_hits", [] { return GetSessionResumptionStatistics().server_hits; });
+  server_session_misses_ = std::make_unique<tvar::PassiveStatus<uint64_t>>(
+      "trpc/ssl/server/session_misses", [] { return GetSessionResumptionStatistics().server_misses; });
+  client_session_hits_ = std::make_unique<tvar::PassiveStatus<uint64_t>>(
+      "trpc/ssl/client/session_hits", [] { return GetSessionResumptionStatistics().client_hits; });
+  client_session_misses_ = std::make_unique<tvar::PassiveStatus<uint64_t>>(
+      "trpc/ssl/client/session_misses", [] { return GetSessionResumptionStatistics().client_misses; });
+}
+#else
+SslSessionStats::SslSessionStats() {}
+#endif
+
+}  // namespace trpc
@@ -0,0 +1,38 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "trpc/tvar/basic_ops/passive_status.h"
+
+namespace trpc {
+
+/// @brief Exposes hits and misses of TLS session resumption through tvar, under `trpc/ssl/server/` and
+///        `trpc/ssl/client/`. A handshake resuming a previous session is a hit, a full handshake is a miss.
+class SslSessionStats {
+ public:
+  SslSessionStats();
+
+  SslSessionStats(const SslSessionStats&) = delete;
+  SslSessionStats& operator=(const SslSessionStats&) = delete;
+
+ private:
+  std::unique_ptr<tvar::PassiveStatus<uint64_t>> server_session_hits_;
+  std::unique_ptr<tvar::PassiveStatus<uint64_t>> server_session_misses_;
+  std::unique_ptr<tvar::PassiveStatus<uint64_t>> client_session_hits_;
+  std::unique_ptr<tvar::PassiveStatus<uint64_t>> client_session_misses_;
+};
+
+}  // namespace trpc
@@ -39,6 +39,17 @@ class DefaultIoHandler : public IoHandler {
     return ret;
   }
 
+  int WritevZeroCopy(const iovec* iov, int iovcnt) override {
+    msghdr msg = {};
+    msg.msg_iov = const_cast<iovec*>(iov);
+    msg.msg_iovlen = iovcnt;
+    int ret = ::sendmsg(fd_, &msg, MSG_ZEROCOPY);
+#ifdef TRPC_DISABLE_TCP_CORK
+    detail::FlushTcpCorkedData(fd_);
+#endif
+    return ret;
+  }
+
   Connection* GetConnection() const override { return conn_; }
 
  private:
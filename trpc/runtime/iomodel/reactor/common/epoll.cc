@@ -30,28 +30,28 @@ Epoll::~Epoll() {
   }
 }
 
-void Epoll::Add(int fd, uint64_t data, uint32_t event) {
-  Ctrl(fd, data, event, EPOLL_CTL_ADD);
+bool Epoll::Add(int fd, uint64_t data, uint32_t event) {
+  return Ctrl(fd, data, event, EPOLL_CTL_ADD);
 }
 
-void Epoll::Mod(int fd, uint64_t data, uint32_t event) {
-  Ctrl(fd, data, event, EPOLL_CTL_MOD);
+bool Epoll::Mod(int fd, uint64_t data, uint32_t event) {
+  return Ctrl(fd, data, event, EPOLL_CTL_MOD);
 }
 
-void Epoll::Del(int fd, uint64_t data, uint32_t event) {
-  Ctrl(fd, data, event, EPOLL_CTL_DEL);
+bool Epoll::Del(int fd, uint64_t data, uint32_t event) {
+  return Ctrl(fd, data, event, EPOLL_CTL_DEL);
 }
 
 int Epoll::Wait(int millsecond) {
   return epoll_wait(epoll_fd_, events_.get(), max_events_ + 1, millsecond);
 }
 
-void Epoll::Ctrl(int fd, uint64_t data, uint32_t events, int op) {
+bool Epoll::Ctrl(int fd, uint64_t data, uint32_t events, int op) {
   struct epoll_event ev;
   ev.data.u64 = data;
   ev.events = events | EPOLLET;  // Default ET
 
-  epoll_ctl(epoll_fd_, op, fd, &ev);
+  return epoll_ctl(epoll_fd_, op, fd, &ev) == 0;
 }
 
 }  // namespace trpc
@@ -29,13 +29,16 @@ class Epoll {
   ~Epoll();
 
   /// @brief  Add fd and its events and data to epoll
-  void Add(int fd, uint64_t data, uint32_t event);
+  /// @return true: success, false: epoll_ctl failed
+  bool Add(int fd, uint64_t data, uint32_t event);
 
   /// @brief Modify fd and its events and data to epoll
-  void Mod(int fd, uint64_t data, uint32_t event);
+  /// @return true: success, false: epoll_ctl failed
+  bool Mod(int fd, uint64_t data, uint32_t event);
 
   /// @brief Remove fd and its events and data from epoll
-  void Del(int fd, uint64_t data, uint32_t event);
+  /// @return true: success, false: epoll_ctl failed
+  bool Del(int fd, uint64_t data, uint32_t event);
 
   /// @brief Execute epoll_wait to wait for events
   int Wait(int millsecond);
@@ -47,7 +50,7 @@ class Epoll {
   }
 
  private:
-  void Ctrl(int fd, uint64_t data, uint32_t events, int op);
+  bool Ctrl(int fd, uint64_t data, uint32_t events, int op);
 
  private:
   int epoll_fd_;
@@ -34,25 +34,30 @@ void EPollPoller::Dispatch(int timeout_ms) {
   }
 }
 
-void EPollPoller::UpdateEvent(EventHandler* event_handler) {
+bool EPollPoller::UpdateEvent(EventHandler* event_handler) {
   uint16_t state = event_handler->GetState();
   if (state == EventHandler::EventHandlerState::kCreate) {
     uint32_t events = EventTypeToEvent(event_handler->GetSetEvents());
 
-    epoll_.Add(event_handler->GetFd(), event_handler->GetEventData(), events);
+    if (!epoll_.Add(event_handler->GetFd(), event_handler->GetEventData(), events)) {
+      return false;
+    }
 
     event_handler->SetState(EventHandler::EventHandlerState::kMod);
   } else {
     if (event_handler->HasSetEvent()) {
       uint32_t events = EventTypeToEvent(event_handler->GetSetEvents());
 
-      epoll_.Mod(event_handler->GetFd(), event_handler->GetEventData(), events);
-    } else {
-      epoll_.Del(event_handler->GetFd(), event_handler->GetEventData(), 0);
-
-      event_handler->SetState(EventHandler::EventHandlerState::kCreate);
+      return epoll_.Mod(event_handler->GetFd(), event_handler->GetEventData(), events);
     }
+
+    event_handler->SetState(EventHandler::EventHandlerState::kCreate);
+
+    // The fd may have been closed already, which has removed it from epoll as well.
+    return epoll_.Del(event_handler->GetFd(), event_handler->GetEventData(), 0);
   }
+
+  return true;
 }
 
 uint32_t EPollPoller::EventTypeToEvent(uint8_t event_type) {
@@ -88,6 +93,10 @@ uint8_t EPollPoller::EventToEventType(uint32_t events) {
     recv_events |= EventHandler::EventType::kCloseEvent;
   }
 
+  if (events & (EPOLLRDHUP | EPOLLHUP)) {
+    recv_events |= EventHandler::EventType::kHangUpEvent;
+  }
+
   return recv_events;
 }
 
@@ -25,7 +25,7 @@ class EPollPoller final : public Poller {
 
   void Dispatch(int timeout_ms) override;
 
-  void UpdateEvent(EventHandler* event_handler) override;
+  bool UpdateEvent(EventHandler* event_handler) override;
 
  private:
   // Convert specific epoll event types to defined generic event types
@@ -16,6 +16,7 @@
 #include <sys/socket.h>
 #include <sys/uio.h>
 
+#include <cerrno>
 #include <cstdint>
 
 namespace trpc {
@@ -46,6 +47,14 @@ class IoHandler {
   /// @brief write data to the connection
   virtual int Writev(const iovec* iov, int iovcnt) = 0;
 
+  /// @brief write data to the connection with MSG_ZEROCOPY, the kernel references the memory of `iov` until it reports
+  ///        the completion on the error queue of the socket
+  /// @note Fails with errno EOPNOTSUPP if the handler can't send without copy, eg: ssl
+  virtual int WritevZeroCopy(const iovec* iov, int iovcnt) {
+    errno = EOPNOTSUPP;
+    return -1;
+  }
+
   /// @brief Destroy IO handler.
   virtual void Destroy() {}
 };
@@ -0,0 +1,323 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/iomodel/reactor/common/io_uring_poll_poller.h"
+
+#ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
+
+#include <poll.h>
+
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#include "liburing.h"
+
+#include "trpc/util/likely.h"
+#include "trpc/util/log/logging.h"
+
+#ifndef IORING_POLL_ADD_MULTI
+#define IORING_POLL_ADD_MULTI (1U << 0)
+#endif
+
+namespace trpc {
+
+namespace {
+
+// user_data of `IORING_OP_POLL_REMOVE` requests, their completions carry nothing of interest.
+constexpr uint64_t kPollRemoveUserData = ~0ULL;
+
+// Times to flush the submission queue for room before giving up.
+constexpr int kMaxSubmitAttempts = 8;
+
+uint64_t EncodeUserData(int fd, uint32_t generation) {
+  return (static_cast<uint64_t>(generation) << 32) | static_cast<uint32_t>(fd);
+}
+
+void DestroyIoUring(struct io_uring* ring) {
+  if (ring) {
+    io_uring_queue_exit(ring);
+    delete ring;
+  }
+}
+
+}  // namespace
+
+IoUringPollPoller::IoUringPollPoller(const Options& options) : options_(options), ring_(nullptr, &DestroyIoUring) {}
+
+IoUringPollPoller::~IoUringPollPoller() = default;
+
+bool IoUringPollPoller::Init() {
+  auto ring = std::make_unique<struct io_uring>();
+  int ret = io_uring_queue_init(options_.entries, ring.get(), options_.flags);
+  if (ret != 0) {
+    TRPC_FMT_ERROR("io_uring_queue_init failed, ret: {}, msg: {}", ret, strerror(-ret));
+    return false;
+  }
+
+  // Waiting with timeout must not consume sqe, otherwise the wait itself may fail for lack of room.
+  if (!(ring->features & IORING_FEAT_EXT_ARG)) {
+    TRPC_FMT_ERROR("io_uring poller requires IORING_FEAT_EXT_ARG, kernel 5.13+ is required");
+    io_uring_queue_exit(ring.get());
+    return false;
+  }
+
+  ring_.reset(ring.release());
+  cqes_.resize(options_.entries * 2);
+  ready_events_.reserve(options_.entries * 2);
+  dispatching_events_.reserve(options_.entries * 2);
+
+  return true;
+}
+
+void IoUringPollPoller::Dispatch(int timeout_ms) {
+  TRPC_ASSERT(ring_);
+
+  RearmPending();
+
+  // Flush the registrations queued since the previous round in one syscall. If it fails (e.g. -EBUSY), they stay in
+  // the submission queue and are flushed again next round, after the completion queue has been drained below.
+  int ret = io_uring_submit(ring_.get());
+  if (TRPC_UNLIKELY(ret < 0)) {
+    TRPC_FMT_ERROR_EVERY_SECOND("io_uring_submit failed, ret: {}, msg: {}", ret, strerror(-ret));
+  }
+
+  struct __kernel_timespec ts;
+  ts.tv_sec = timeout_ms / 1000;
+  ts.tv_nsec = (timeout_ms % 1000) * 1000000L;
+
+  struct io_uring_cqe* cqe = nullptr;
+  ret = io_uring_wait_cqe_timeout(ring_.get(), &cqe, &ts);
+  if (TRPC_UNLIKELY(ret < 0 && ret != -ETIME && ret != -EINTR)) {
+    // Completions already posted (if any) are still drained below.
+    TRPC_FMT_ERROR_EVERY_SECOND("io_uring_wait_cqe_timeout failed, ret: {}, msg: {}", ret, strerror(-ret));
+  }
+
+  DrainCompletions();
+  RearmPending();
+
+  if (wait_callback_) wait_callback_(static_cast<int>(ready_events_.size()));
+
+  dispatching_events_.swap(ready_events_);
+  for (auto& ready : dispatching_events_) {
+    Slot& slot = slots_[ready.fd];
+    if (slot.handler == nullptr || slot.generation != ready.generation) {
+      continue;
+    }
+    slot.handler->SetRecvEvents(ready.events);
+    slot.handler->HandleEvent();
+  }
+
+  dispatching_events_.clear();
+}
+
+unsigned IoUringPollPoller::DrainCompletions() {
+  unsigned count = io_uring_peek_batch_cqe(ring_.get(), cqes_.data(), cqes_.size());
+  for (unsigned i = 0; i < count; ++i) {
+    HandleCompletion(cqes_[i]);
+  }
+  io_uring_cq_advance(ring_.get(), count);
+  return count;
+}
+
+void IoUringPollPoller::RearmPending() {
+  std::size_t kept = 0;
+  for (auto& pending : pending_rearms_) {
+    Slot& slot = slots_[pending.fd];
+    if (slot.handler == nullptr || slot.generation != pending.generation) {
+      continue;
+    }
+    if (!PrepPollAdd(pending.fd, slot)) {
+      // Try again next round.
+      pending_rearms_[kept++] = pending;
+    }
+  }
+  pending_rearms_.resize(kept);
+}
+
+void IoUringPollPoller::HandleCompletion(io_uring_cqe* cqe) {
+  uint64_t user_data = cqe->user_data;
+  if (user_data == kPollRemoveUserData) {
+    return;
+  }
+
+  int fd = static_cast<int>(user_data & 0xFFFFFFFF);
+  uint32_t generation = static_cast<uint32_t>(user_data >> 32);
+  if (TRPC_UNLIKELY(fd < 0 || static_cast<size_t>(fd) >= slots_.size())) {
+    return;
+  }
+
+  Slot& slot = slots_[fd];
+  if (slot.handler == nullptr || slot.generation != generation) {
+    // The poll request has been replaced or removed, this is its cancellation or a late event.
+    return;
+  }
+
+  uint8_t events = 0;
+  if (cqe->res < 0) {
+    if (cqe->res == -ECANCELED) {
+      return;
+    }
+    TRPC_FMT_ERROR("io_uring poll failed, fd: {}, ret: {}, msg: {}", fd, cqe->res, strerror(-cqe->res));
+    events = EventHandler::EventType::kCloseEvent | EventHandler::EventType::kHangUpEvent;
+  } else {
+    events = PollMaskToEventType(static_cast<uint32_t>(cqe->res));
+    if (!(cqe->flags & IORING_CQE_F_MORE)) {
+      // The kernel has terminated the multishot request (e.g. completion queue overflowed), arm it again once the
+      // completion queue has been advanced.
+      pending_rearms_.push_back(PendingRearm{fd, generation});
+    }
+  }
+
+  ready_events_.push_back(ReadyEvent{fd, generation, events});
+}
+
+bool IoUringPollPoller::UpdateEvent(EventHandler* event_handler) {
+  TRPC_ASSERT(ring_);
+
+  int fd = event_handler->GetFd();
+  TRPC_ASSERT(fd >= 0);
+
+  if (static_cast<size_t>(fd) >= slots_.size()) {
+    slots_.resize(fd + 1);
+  }
+
+  Slot& slot = slots_[fd];
+  uint16_t state = event_handler->GetState();
+  if (state == EventHandler::EventHandlerState::kCreate) {
+    slot.handler = event_handler;
+    slot.generation++;
+    slot.poll_mask = EventTypeToPollMask(event_handler->GetSetEvents());
+    if (!PrepPollAdd(fd, slot)) {
+      slot.handler = nullptr;
+      slot.poll_mask = 0;
+      return false;
+    }
+
+    event_handler->SetState(EventHandler::EventHandlerState::kMod);
+    return true;
+  }
+
+  // Even if the old request can not be removed, bumping the generation keeps its events from reaching the handler.
+  bool succ = PrepPollRemove(fd, slot);
+  slot.generation++;
+
+  if (event_handler->HasSetEvent()) {
+    slot.handler = event_handler;
+    slot.poll_mask = EventTypeToPollMask(event_handler->GetSetEvents());
+    if (!PrepPollAdd(fd, slot)) {
+      slot.handler = nullptr;
+      slot.poll_mask = 0;
+      return false;
+    }
+  } else {
+    slot.handler = nullptr;
+    slot.poll_mask = 0;
+
+    event_handler->SetState(EventHandler::EventHandlerState::kCreate);
+  }
+
+  return succ;
+}
+
+io_uring_sqe* IoUringPollPoller::GetSqe() {
+  io_uring_sqe* sqe = io_uring_get_sqe(ring_.get());
+  for (int attempts = 0; TRPC_UNLIKELY(sqe == nullptr); ++attempts) {
+    if (attempts == kMaxSubmitAttempts) {
+      TRPC_FMT_ERROR_EVERY_SECOND("io_uring submission queue is still full after {} flushes", attempts);
+      return nullptr;
+    }
+
+    // Submission queue is full, flush it to the kernel to make room.
+    int ret = io_uring_submit(ring_.get());
+    if (ret == -EBUSY || ret == -EAGAIN) {
+      // The completion queue is full (or the kernel is short of memory), completions must be reaped before more
+      // requests are accepted. They are delivered by the next `Dispatch`.
+      if (DrainCompletions() == 0 && ret == -EAGAIN) {
+        std::this_thread::yield();
+      }
+    } else if (ret < 0 && ret != -EINTR) {
+      TRPC_FMT_ERROR_EVERY_SECOND("io_uring_submit failed, ret: {}, msg: {}", ret, strerror(-ret));
+      return nullptr;
+    }
+    sqe = io_uring_get_sqe(ring_.get());
+  }
+  return sqe;
+}
+
+bool IoUringPollPoller::PrepPollAdd(int fd, const Slot& slot) {
+  io_uring_sqe* sqe = GetSqe();
+  if (TRPC_UNLIKELY(sqe == nullptr)) {
+    return false;
+  }
+  io_uring_prep_rw(IORING_OP_POLL_ADD, sqe, fd, nullptr, IORING_POLL_ADD_MULTI, 0);
+  sqe->poll32_events = slot.poll_mask;
+  sqe->user_data = EncodeUserData(fd, slot.generation);
+  return true;
+}
+
+bool IoUringPollPoller::PrepPollRemove(int fd, const Slot& slot) {
+  io_uring_sqe* sqe = GetSqe();
+  if (TRPC_UNLIKELY(sqe == nullptr)) {
+    return false;
+  }
+  // `addr` carries the user_data of the poll request to be removed.
+  io_uring_prep_rw(IORING_OP_POLL_REMOVE, sqe, -1, nullptr, 0, 0);
+  sqe->addr = EncodeUserData(fd, slot.generation);
+  sqe->user_data = kPollRemoveUserData;
+  return true;
+}
+
+uint32_t IoUringPollPoller::EventTypeToPollMask(uint8_t event_type) {
+  uint32_t mask = 0;
+
+  if (event_type & EventHandler::EventType::kReadEvent) {
+    mask |= POLLIN;
+  }
+
+  if (event_type & EventHandler::EventType::kWriteEvent) {
+    mask |= POLLOUT;
+  }
+
+  if (event_type & EventHandler::EventType::kCloseEvent) {
+    mask |= POLLRDHUP;
+  }
+
+  return mask;
+}
+
+uint8_t IoUringPollPoller::PollMaskToEventType(uint32_t mask) {
+  uint8_t recv_events = 0;
+
+  if (mask & POLLIN) {
+    recv_events |= EventHandler::EventType::kReadEvent;
+  }
+
+  if (mask & POLLOUT) {
+    recv_events |= EventHandler::EventType::kWriteEvent;
+  }
+
+  if (mask & (POLLRDHUP | POLLERR | POLLHUP)) {
+    recv_events |= EventHandler::EventType::kCloseEvent;
+  }
+
+  if (mask & (POLLRDHUP | POLLHUP)) {
+    recv_events |= EventHandler::EventType::kHangUpEvent;
+  }
+
+  return recv_events;
+}
+
+}  // namespace trpc
+
+#endif  // ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
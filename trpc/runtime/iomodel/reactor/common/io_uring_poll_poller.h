@@ -0,0 +1,122 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "trpc/runtime/iomodel/reactor/poller.h"
+
+struct io_uring;
+struct io_uring_cqe;
+struct io_uring_sqe;
+
+namespace trpc {
+
+/// @brief Readiness notification (the same model as `EPollPoller`) implemented with io_uring poll requests.
+/// @note  Each registered fd is armed with a multishot `IORING_OP_POLL_ADD`, so a readiness event does not need to be
+///        re-registered after it fires. Data is still read and written by the event handlers themselves, this poller
+///        only replaces `epoll_wait`/`epoll_ctl`: registration changes are queued and submitted together with the
+///        next wait, and completions are drained in batches.
+///        The poller is not thread safe, `Dispatch` and `UpdateEvent` must be called from the same thread (or fiber),
+///        which is the reactor driving it.
+///        If the submission queue can not be flushed (e.g. `-EBUSY` while the completion queue is full), posted
+///        completions are drained to make room and the submission is retried a few times, `UpdateEvent` fails after
+///        that rather than aborting the process.
+///        Requires kernel 5.13+ (multishot poll and `IORING_FEAT_EXT_ARG`), `Init` returns false otherwise.
+class IoUringPollPoller final : public Poller {
+ public:
+  struct Options {
+    // parameter for io_uring_queue_init
+    uint32_t entries{1024};
+    uint32_t flags{0};
+  };
+
+  explicit IoUringPollPoller(const Options& options);
+
+  ~IoUringPollPoller() override;
+
+  /// @brief Create the ring and check kernel features
+  /// @return true: success, false: io_uring is unavailable, the caller should fall back to `EPollPoller`
+  bool Init();
+
+  void Dispatch(int timeout_ms) override;
+
+  bool UpdateEvent(EventHandler* event_handler) override;
+
+ private:
+  // Registration state of each fd, indexed by fd.
+  // `generation` is bumped whenever the poll request of the fd is replaced, completions carrying an older generation
+  // are stale and dropped, so that a handler is never touched after it has been removed.
+  struct Slot {
+    EventHandler* handler{nullptr};
+    uint32_t generation{0};
+    uint32_t poll_mask{0};
+  };
+
+  // Handlers are looked up again by `fd` and `generation` when the event is delivered, as it may have been removed
+  // in the meantime, e.g. by the handler of an earlier event.
+  struct ReadyEvent {
+    int fd;
+    uint32_t generation;
+    uint8_t events;
+  };
+
+  // Multishot poll request terminated by the kernel, to be armed again.
+  struct PendingRearm {
+    int fd;
+    uint32_t generation;
+  };
+
+  // Return nullptr if no sqe can be got even after flushing the submission queue.
+  io_uring_sqe* GetSqe();
+  bool PrepPollAdd(int fd, const Slot& slot);
+  bool PrepPollRemove(int fd, const Slot& slot);
+  // Move the posted completions into `ready_events_` (and `pending_rearms_`), return the number of them.
+  unsigned DrainCompletions();
+  void HandleCompletion(io_uring_cqe* cqe);
+  void RearmPending();
+
+  // Convert defined generic event types to poll mask
+  uint32_t EventTypeToPollMask(uint8_t event_type);
+
+  // Convert poll mask to defined generic event types
+  uint8_t PollMaskToEventType(uint32_t mask);
+
+ private:
+  Options options_;
+
+  std::unique_ptr<struct io_uring, void (*)(struct io_uring*)> ring_;
+
+  std::vector<Slot> slots_;
+
+  // Completions peeked in one round of `Dispatch`
+  std::vector<io_uring_cqe*> cqes_;
+
+  // Handlers resolved from completions, invoked after the completion queue has been advanced
+  std::vector<ReadyEvent> ready_events_;
+
+  // Events being delivered by `Dispatch`, swapped with `ready_events_` so that completions drained meanwhile (see
+  // `GetSqe`) are kept for the next round
+  std::vector<ReadyEvent> dispatching_events_;
+
+  std::vector<PendingRearm> pending_rearms_;
+};
+
+}  // namespace trpc
+
+#endif  // ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
@@ -0,0 +1,154 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
+
+#include "trpc/runtime/iomodel/reactor/common/io_uring_poll_poller.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+class PipeEventHandler : public EventHandler {
+ public:
+  explicit PipeEventHandler(int fd) { SetFd(fd); }
+
+  int read_count{0};
+  int close_count{0};
+
+ protected:
+  int HandleReadEvent() override {
+    char buf[16];
+    while (::read(GetFd(), buf, sizeof(buf)) > 0) {
+    }
+    ++read_count;
+    return 0;
+  }
+
+  void HandleCloseEvent() override { ++close_count; }
+};
+
+class IoUringPollPollerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_EQ(::pipe2(fds_, O_NONBLOCK), 0);
+    poller_ = std::make_unique<IoUringPollPoller>(IoUringPollPoller::Options{});
+    initialized_ = poller_->Init();
+  }
+
+  void TearDown() override {
+    ::close(fds_[0]);
+    ::close(fds_[1]);
+  }
+
+ protected:
+  int fds_[2];
+  bool initialized_{false};
+  std::unique_ptr<IoUringPollPoller> poller_;
+};
+
+TEST_F(IoUringPollPollerTest, MultishotReadEvent) {
+  if (!initialized_) {
+    GTEST_SKIP() << "io_uring poller is not supported by current kernel";
+  }
+
+  PipeEventHandler handler(fds_[0]);
+  handler.SetSetEvents(EventHandler::EventType::kReadEvent);
+  poller_->UpdateEvent(&handler);
+
+  poller_->Dispatch(1);
+  ASSERT_EQ(handler.read_count, 0);
+
+  // The poll request stays armed after firing.
+  for (int i = 1; i <= 3; ++i) {
+    ASSERT_EQ(::write(fds_[1], "x", 1), 1);
+    poller_->Dispatch(100);
+    ASSERT_EQ(handler.read_count, i);
+  }
+
+  // Removed handlers never see events again.
+  handler.SetSetEvents(0);
+  poller_->UpdateEvent(&handler);
+  ASSERT_EQ(handler.GetState(), EventHandler::EventHandlerState::kCreate);
+
+  ASSERT_EQ(::write(fds_[1], "x", 1), 1);
+  poller_->Dispatch(10);
+  ASSERT_EQ(handler.read_count, 3);
+}
+
+TEST_F(IoUringPollPollerTest, CloseEvent) {
+  if (!initialized_) {
+    GTEST_SKIP() << "io_uring poller is not supported by current kernel";
+  }
+
+  PipeEventHandler handler(fds_[0]);
+  handler.SetSetEvents(EventHandler::EventType::kReadEvent | EventHandler::EventType::kCloseEvent);
+  poller_->UpdateEvent(&handler);
+
+  ::close(fds_[1]);
+  fds_[1] = ::dup(fds_[0]);  // keep `TearDown` closing a valid fd
+  poller_->Dispatch(100);
+  ASSERT_GE(handler.close_count, 1);
+
+  handler.SetSetEvents(0);
+  poller_->UpdateEvent(&handler);
+}
+
+TEST_F(IoUringPollPollerTest, RingFull) {
+  if (!initialized_) {
+    GTEST_SKIP() << "io_uring poller is not supported by current kernel";
+  }
+
+  // A tiny ring with more readable fds than fit in either queue: registering them overflows the completion queue, so
+  // that flushing the submission queue has to drain completions (-EBUSY) instead of failing.
+  IoUringPollPoller::Options options;
+  options.entries = 2;
+  poller_ = std::make_unique<IoUringPollPoller>(options);
+  ASSERT_TRUE(poller_->Init());
+
+  constexpr int kPipeNum = 32;
+  std::vector<std::array<int, 2>> pipes(kPipeNum);
+  std::vector<std::unique_ptr<PipeEventHandler>> handlers;
+  for (auto& fds : pipes) {
+    ASSERT_EQ(::pipe2(fds.data(), O_NONBLOCK), 0);
+    ASSERT_EQ(::write(fds[1], "x", 1), 1);
+    handlers.push_back(std::make_unique<PipeEventHandler>(fds[0]));
+    handlers.back()->SetSetEvents(EventHandler::EventType::kReadEvent);
+    ASSERT_TRUE(poller_->UpdateEvent(handlers.back().get()));
+  }
+
+  for (int i = 0; i < 100; ++i) {
+    poller_->Dispatch(10);
+  }
+  for (auto& handler : handlers) {
+    ASSERT_GE(handler->read_count, 1);
+    handler->SetSetEvents(0);
+    ASSERT_TRUE(poller_->UpdateEvent(handler.get()));
+  }
+
+  for (auto& fds : pipes) {
+    ::close(fds[0]);
+    ::close(fds[1]);
+  }
+}
+
+}  // namespace trpc::testing
+
+#endif  // ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
@@ -22,6 +22,7 @@
 #include <netdb.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <netinet/udp.h>
 #include <stdio.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
@@ -33,6 +34,14 @@
 
 #include "trpc/util/log/logging.h"
 
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+
 namespace trpc {
 
 Socket Socket::CreateTcpSocket(bool ipv6) {
@@ -210,6 +219,12 @@ int Socket::RecvMsg(msghdr* message, int flag, NetworkAddress* peer_addr) {
   return ret;
 }
 
+int Socket::SendMMsg(struct mmsghdr* msgs, unsigned int vlen, int flag) { return ::sendmmsg(fd_, msgs, vlen, flag); }
+
+int Socket::RecvMMsg(struct mmsghdr* msgs, unsigned int vlen, int flag) {
+  return ::recvmmsg(fd_, msgs, vlen, flag, nullptr);
+}
+
 bool Socket::SetBlock(bool block) {
   int val = 0;
 
@@ -319,6 +334,27 @@ bool Socket::SetKeepAlive() {
   return true;
 }
 
+bool Socket::SetUdpGro() {
+  int flag = 1;
+  if (SetSockOpt(UDP_GRO, static_cast<const void*>(&flag), static_cast<socklen_t>(sizeof(flag)), IPPROTO_UDP) == -1) {
+    TRPC_LOG_DEBUG("setsockopt UDP_GRO failed, fd: " << fd_ << ", errno: " << errno << ", error msg: "
+                                                     << strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+bool Socket::SetZeroCopy() {
+  int flag = 1;
+  if (SetSockOpt(SO_ZEROCOPY, static_cast<const void*>(&flag), static_cast<socklen_t>(sizeof(flag)), SOL_SOCKET) ==
+      -1) {
+    TRPC_LOG_DEBUG("setsockopt SO_ZEROCOPY failed, fd: " << fd_ << ", errno: " << errno << ", error msg: "
+                                                         << strerror(errno));
+    return false;
+  }
+  return true;
+}
+
 void Socket::SetSendBufferSize(int sz) {
   int flag = 1;
   if (SetSockOpt(SO_SNDBUF, static_cast<const void*>(&sz), static_cast<socklen_t>(sizeof(flag)),
@@ -358,4 +394,14 @@ int Socket::GetRecvBufferSize() {
   return sz;
 }
 
+int Socket::GetReadableSize() {
+  int sz = 0;
+  if (ioctl(fd_, FIONREAD, &sz) == -1) {
+    TRPC_LOG_DEBUG("ioctl FIONREAD failed, fd: " << fd_ << ", errno: " << errno << ", error msg: " << strerror(errno));
+    return 0;
+  }
+
+  return sz;
+}
+
 }  // namespace trpc
@@ -102,6 +102,12 @@ class Socket {
   /// @brief Recv msg
   int RecvMsg(msghdr* message, int flag, NetworkAddress* peer_addr);
 
+  /// @brief Send multiple udp messages with one syscall
+  int SendMMsg(struct mmsghdr* msgs, unsigned int vlen, int flag = 0);
+
+  /// @brief Recv multiple udp messages with one syscall
+  int RecvMMsg(struct mmsghdr* msgs, unsigned int vlen, int flag = 0);
+
   /// @brief Set SO_REUSEADD
   bool SetReuseAddr();
 
@@ -126,9 +132,21 @@ class Socket {
   /// @brief Set SO_KEEPALIVE
   bool SetKeepAlive();
 
+  /// @brief Set UDP_GRO, which lets the kernel coalesce received datagrams of the same flow
+  /// @note Returns false without logging errors if the kernel does not support it (before 5.0)
+  bool SetUdpGro();
+
+  /// @brief Set SO_ZEROCOPY, which allows sending with MSG_ZEROCOPY
+  /// @note Returns false without logging errors if the kernel or the socket does not support it (before 4.14)
+  bool SetZeroCopy();
+
   /// @brief Get receive buffer size
   int GetRecvBufferSize();
 
+  /// @brief Get the number of bytes pending in the receive buffer (FIONREAD)
+  /// @return The number of bytes can be read, 0 on error
+  int GetReadableSize();
+
   /// @brief Set receive buffer size
   void SetRecvBufferSize(int sz);
 
@@ -0,0 +1,361 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/iomodel/reactor/common/udp_batch_io.h"
+
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <string>
+#include <utility>
+
+#include "trpc/util/buffer/memory_pool/memory_pool.h"
+#include "trpc/util/likely.h"
+#include "trpc/util/log/logging.h"
+
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+namespace trpc {
+
+namespace {
+
+// Receiving capacity of each message, which fits the largest datagram as well as the largest GRO message.
+constexpr std::size_t kMaxRecvSize = 65535;
+
+// The maximum number of datagrams in one GSO message (UDP_MAX_SEGMENTS of the kernel before 5.15).
+constexpr std::size_t kMaxGsoSegments = 64;
+
+// Segments must not exceed the path MTU, datagrams larger than what fits an ethernet frame carrying an ipv6 header
+// are never coalesced.
+constexpr std::size_t kMaxGsoSegmentSize = 1452;
+
+// The maximum payload of one GSO message, below what fits an ip packet.
+constexpr std::size_t kMaxGsoBytes = 65000;
+
+UdpBatchIoOptions udp_batch_io_options;
+
+// Set once the kernel or the nic has rejected a GSO message.
+std::atomic<bool> gso_unsupported{false};
+
+struct RecvSlot {
+  // Most datagrams fit the block of the fixed size, the rest go on to the larger one.
+  RefPtr<memory_pool::MemBlock> head;
+  RefPtr<memory_pool::MemBlock> tail;
+  sockaddr_storage addr;
+  iovec iov[2];
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+};
+
+struct RecvBatch {
+  RecvSlot slots[kMaxUdpBatchSize];
+  mmsghdr msgs[kMaxUdpBatchSize];
+};
+
+RecvBatch& GetRecvBatch() {
+  // Holds no block between calls, see `ReleaseRecvSlot`.
+  thread_local RecvBatch batch;
+  return batch;
+}
+
+// Allocates the blocks of `slot` and resets its message.
+void PrepareRecvSlot(RecvSlot& slot, mmsghdr& msg) {
+  slot.head = MakeBlockRef(memory_pool::Allocate());
+  std::size_t head_size = std::min(GetBlockMaxAvailableSize(slot.head.Get()), kMaxRecvSize);
+  slot.iov[0].iov_base = slot.head->data;
+  slot.iov[0].iov_len = head_size;
+  std::size_t iov_num = 1;
+
+  if (head_size < kMaxRecvSize) {
+    std::size_t tail_size = kMaxRecvSize - head_size;
+    slot.tail = MakeBlockRef(memory_pool::Allocate(tail_size));
+    slot.iov[1].iov_base = slot.tail->data;
+    slot.iov[1].iov_len = std::min(GetBlockMaxAvailableSize(slot.tail.Get()), tail_size);
+    iov_num = 2;
+  }
+
+  msg.msg_hdr.msg_name = &slot.addr;
+  msg.msg_hdr.msg_namelen = sizeof(slot.addr);
+  msg.msg_hdr.msg_iov = slot.iov;
+  msg.msg_hdr.msg_iovlen = iov_num;
+  msg.msg_hdr.msg_control = slot.control;
+  msg.msg_hdr.msg_controllen = sizeof(slot.control);
+  msg.msg_hdr.msg_flags = 0;
+  msg.msg_len = 0;
+}
+
+void AppendBlock(RefPtr<memory_pool::MemBlock>&& data, std::size_t size, NoncontiguousBuffer& buffer) {
+  auto block = object_pool::MakeLwUnique<BufferBlock>();
+  block->Reset(0, size, std::move(data));
+  buffer.Append(std::move(block));
+}
+
+// Frees the blocks left in `slot` (all of them if nothing was received into it) back to the memory pool, which caches
+// them for the next batch, instead of keeping up to 64K per slot in every io thread.
+void ReleaseRecvSlot(RecvSlot& slot) {
+  slot.head = nullptr;
+  slot.tail = nullptr;
+}
+
+// Hands over the blocks holding the `size` bytes received into `slot`.
+NoncontiguousBuffer TakeRecvSlot(RecvSlot& slot, std::size_t size) {
+  NoncontiguousBuffer payload;
+  std::size_t head_size = std::min(size, slot.iov[0].iov_len);
+  AppendBlock(std::move(slot.head), head_size, payload);
+  if (size > head_size) {
+    AppendBlock(std::move(slot.tail), size - head_size, payload);
+  }
+  return payload;
+}
+
+// Gets the segment size of a message coalesced by GRO, 0 if it is a plain datagram.
+std::size_t GetGroSegmentSize(msghdr& msg) {
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+      int segment_size = 0;
+      memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(segment_size));
+      return segment_size > 0 ? segment_size : 0;
+    }
+  }
+  return 0;
+}
+
+struct SendBatch {
+  SendBatch() { flattened.reserve(kMaxUdpBatchSize); }
+
+  mmsghdr msgs[kMaxUdpBatchSize];
+  // Number of datagrams carried by each message, more than one for GSO messages.
+  std::size_t counts[kMaxUdpBatchSize];
+  // Segment size of each GSO message.
+  std::size_t segment_sizes[kMaxUdpBatchSize];
+  alignas(cmsghdr) char controls[kMaxUdpBatchSize][CMSG_SPACE(sizeof(uint16_t))];
+  std::vector<iovec> iovs;
+  // Payloads too fragmented to be described by `iovec`s, reserved so that the strings are never moved.
+  std::vector<std::string> flattened;
+};
+
+SendBatch& GetSendBatch() {
+  thread_local SendBatch batch;
+  return batch;
+}
+
+std::size_t GetIovNum(const NoncontiguousBuffer& payload) {
+  return TRPC_UNLIKELY(payload.size() > IOV_MAX) ? 1 : payload.size();
+}
+
+void FillIov(const NoncontiguousBuffer& payload, SendBatch& batch, std::size_t& iov_used) {
+  if (TRPC_UNLIKELY(payload.size() > IOV_MAX)) {  // highly fragmented
+    TRPC_LOG_WARN("msg is highly fragmented and cannot be handled by `iovec`s. Flattening.");
+    auto& flatten = batch.flattened.emplace_back(FlattenSlow(payload));
+    batch.iovs[iov_used++] = iovec{flatten.data(), flatten.size()};
+    return;
+  }
+  for (auto&& block : payload) {
+    batch.iovs[iov_used++] = iovec{block.data(), block.size()};
+  }
+}
+
+bool IsSameAddress(const NetworkAddress& l, const NetworkAddress& r) {
+  const sockaddr* la = l.SockAddr();
+  const sockaddr* ra = r.SockAddr();
+  if (la->sa_family != ra->sa_family) {
+    return false;
+  }
+  if (la->sa_family == AF_INET) {
+    auto* l4 = reinterpret_cast<const sockaddr_in*>(la);
+    auto* r4 = reinterpret_cast<const sockaddr_in*>(ra);
+    return l4->sin_port == r4->sin_port && l4->sin_addr.s_addr == r4->sin_addr.s_addr;
+  }
+  auto* l6 = reinterpret_cast<const sockaddr_in6*>(la);
+  auto* r6 = reinterpret_cast<const sockaddr_in6*>(ra);
+  return l6->sin6_port == r6->sin6_port && l6->sin6_scope_id == r6->sin6_scope_id &&
+         memcmp(&l6->sin6_addr, &r6->sin6_addr, sizeof(l6->sin6_addr)) == 0;
+}
+
+void SetUdpSegment(mmsghdr& msg, char* control, std::size_t control_size, std::size_t segment_size) {
+  msg.msg_hdr.msg_control = control;
+  msg.msg_hdr.msg_controllen = control_size;
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg.msg_hdr);
+  cmsg->cmsg_level = SOL_UDP;
+  cmsg->cmsg_type = UDP_SEGMENT;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+  uint16_t size = static_cast<uint16_t>(segment_size);
+  memcpy(CMSG_DATA(cmsg), &size, sizeof(size));
+}
+
+// Sends `datagrams` with one `sendmmsg` call, `first_is_gso` tells whether the first message is a GSO one.
+int SendBatchOnce(Socket& socket, const OutgoingDatagram* datagrams, std::size_t num, bool gso, bool* first_is_gso) {
+  SendBatch& batch = GetSendBatch();
+  batch.flattened.clear();
+
+  // Sized ahead so that the pointers taken below stay valid.
+  std::size_t iov_total = 0;
+  for (std::size_t i = 0; i != num; ++i) {
+    iov_total += GetIovNum(*datagrams[i].payload);
+  }
+  if (batch.iovs.size() < iov_total) {
+    batch.iovs.resize(iov_total);
+  }
+
+  std::size_t msg_num = 0;
+  std::size_t iov_used = 0;
+  // Payload size of the current GSO message, and whether more datagrams may still join it.
+  std::size_t gso_bytes = 0;
+  bool gso_open = false;
+  for (std::size_t i = 0; i != num; ++i) {
+    const OutgoingDatagram& datagram = datagrams[i];
+    std::size_t size = datagram.payload->ByteSize();
+    std::size_t iov_num = GetIovNum(*datagram.payload);
+
+    if (gso_open) {
+      mmsghdr& last = batch.msgs[msg_num - 1];
+      std::size_t segment_size = batch.segment_sizes[msg_num - 1];
+      if (size > 0 && size <= segment_size && batch.counts[msg_num - 1] < kMaxGsoSegments &&
+          gso_bytes + size <= kMaxGsoBytes && last.msg_hdr.msg_iovlen + iov_num <= IOV_MAX &&
+          IsSameAddress(*datagrams[i - 1].to, *datagram.to)) {
+        FillIov(*datagram.payload, batch, iov_used);
+        last.msg_hdr.msg_iovlen += iov_num;
+        ++batch.counts[msg_num - 1];
+        gso_bytes += size;
+        // Only the last segment may be shorter.
+        gso_open = size == segment_size;
+        continue;
+      }
+    }
+
+    mmsghdr& msg = batch.msgs[msg_num];
+    msg.msg_hdr.msg_name = const_cast<sockaddr*>(datagram.to->SockAddr());
+    msg.msg_hdr.msg_namelen = datagram.to->Socklen();
+    msg.msg_hdr.msg_iov = &batch.iovs[iov_used];
+    msg.msg_hdr.msg_iovlen = iov_num;
+    msg.msg_hdr.msg_control = nullptr;
+    msg.msg_hdr.msg_controllen = 0;
+    msg.msg_hdr.msg_flags = 0;
+    msg.msg_len = 0;
+    FillIov(*datagram.payload, batch, iov_used);
+    batch.counts[msg_num] = 1;
+    batch.segment_sizes[msg_num] = size;
+    ++msg_num;
+
+    gso_bytes = size;
+    gso_open = gso && size > 0 && size <= kMaxGsoSegmentSize;
+  }
+
+  for (std::size_t i = 0; i != msg_num; ++i) {
+    if (batch.counts[i] > 1) {
+      SetUdpSegment(batch.msgs[i], batch.controls[i], sizeof(batch.controls[i]), batch.segment_sizes[i]);
+    }
+  }
+
+  int rc = socket.SendMMsg(batch.msgs, msg_num);
+  if (rc < 0) {
+    *first_is_gso = batch.counts[0] > 1;
+    return rc;
+  }
+
+  int sent = 0;
+  for (int i = 0; i != rc; ++i) {
+    sent += batch.counts[i];
+  }
+  return sent;
+}
+
+}  // namespace
+
+void SetUdpBatchIoOptions(const UdpBatchIoOptions& options) {
+  udp_batch_io_options = options;
+  udp_batch_io_options.recv_batch_size = std::clamp<std::size_t>(options.recv_batch_size, 1, kMaxUdpBatchSize);
+  udp_batch_io_options.send_batch_size = std::clamp<std::size_t>(options.send_batch_size, 1, kMaxUdpBatchSize);
+}
+
+const UdpBatchIoOptions& GetUdpBatchIoOptions() { return udp_batch_io_options; }
+
+void InitUdpBatchIo(Socket& socket) {
+  if (udp_batch_io_options.enable_gro) {
+    socket.SetUdpGro();
+  }
+}
+
+int RecvDatagrams(Socket& socket, std::size_t max_num, std::vector<ReceivedDatagram>& datagrams) {
+  RecvBatch& batch = GetRecvBatch();
+  std::size_t num = std::clamp<std::size_t>(max_num, 1, kMaxUdpBatchSize);
+  for (std::size_t i = 0; i != num; ++i) {
+    PrepareRecvSlot(batch.slots[i], batch.msgs[i]);
+  }
+
+  int rc = socket.RecvMMsg(batch.msgs, num, MSG_DONTWAIT);
+  for (int i = 0; i < rc; ++i) {
+    msghdr& msg = batch.msgs[i].msg_hdr;
+    std::size_t size = batch.msgs[i].msg_len;
+    if (TRPC_UNLIKELY(msg.msg_flags & MSG_TRUNC)) {
+      TRPC_FMT_ERROR("Datagram truncated, fd: {}, size: {}", socket.GetFd(), size);
+      continue;
+    }
+    if (size == 0) {
+      continue;
+    }
+
+    NetworkAddress peer(reinterpret_cast<const sockaddr*>(&batch.slots[i].addr));
+    NoncontiguousBuffer payload = TakeRecvSlot(batch.slots[i], size);
+    std::size_t segment_size = GetGroSegmentSize(msg);
+    if (segment_size > 0) {
+      while (payload.ByteSize() > segment_size) {
+        datagrams.push_back(ReceivedDatagram{peer, payload.Cut(segment_size)});
+      }
+    }
+    datagrams.push_back(ReceivedDatagram{std::move(peer), std::move(payload)});
+  }
+
+  int saved_errno = errno;
+  for (std::size_t i = 0; i != num; ++i) {
+    ReleaseRecvSlot(batch.slots[i]);
+  }
+  errno = saved_errno;
+  return rc;
+}
+
+int SendDatagrams(Socket& socket, const OutgoingDatagram* datagrams, std::size_t num) {
+  num = std::min(num, kMaxUdpBatchSize);
+  if (num == 0) {
+    return 0;
+  }
+
+  bool gso = udp_batch_io_options.enable_gso && !gso_unsupported.load(std::memory_order_relaxed);
+  bool first_is_gso = false;
+  int rc = SendBatchOnce(socket, datagrams, num, gso, &first_is_gso);
+  if (rc < 0 && first_is_gso && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+    // E.g. EIO if the nic cannot checksum, EINVAL if the segment exceeds the path MTU.
+    TRPC_FMT_WARN("UDP GSO rejected, disabled from now on, fd: {}, errno: {}, msg: {}", socket.GetFd(), errno,
+                  strerror(errno));
+    gso_unsupported.store(true, std::memory_order_relaxed);
+    rc = SendBatchOnce(socket, datagrams, num, false, &first_is_gso);
+  }
+  return rc;
+}
+
+}  // namespace trpc
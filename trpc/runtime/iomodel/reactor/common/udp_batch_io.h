@@ -0,0 +1,86 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "trpc/runtime/iomodel/reactor/common/network_address.h"
+#include "trpc/runtime/iomodel/reactor/common/socket.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc {
+
+/// @brief The maximum number of messages of one `recvmmsg`/`sendmmsg` call.
+constexpr std::size_t kMaxUdpBatchSize = 64;
+
+/// @brief Options of batched udp io, shared by all udp transceivers of the process.
+struct UdpBatchIoOptions {
+  /// @brief The maximum number of datagrams received by one `recvmmsg` call, 1 receives one datagram per syscall.
+  /// @note Each call takes 64K from the memory pool per datagram (1M with the default 16) and frees what's left unused
+  ///       back to the pool before returning, nothing is held by the io threads between calls.
+  std::size_t recv_batch_size{16};
+
+  /// @brief The maximum number of datagrams sent by one `sendmmsg` call, 1 sends one datagram per syscall.
+  std::size_t send_batch_size{16};
+
+  /// @brief Whether to send consecutive datagrams of the same size to the same peer as one UDP_SEGMENT (GSO) message.
+  /// @note Disabled automatically once the kernel or the nic rejects it.
+  bool enable_gso{true};
+
+  /// @brief Whether to let the kernel coalesce received datagrams of the same flow (UDP_GRO), they are split again
+  ///        before being handed over.
+  bool enable_gro{true};
+};
+
+/// @brief Sets the options of batched udp io, which should be done before any udp transceiver is created.
+void SetUdpBatchIoOptions(const UdpBatchIoOptions& options);
+
+/// @brief Gets the options of batched udp io.
+const UdpBatchIoOptions& GetUdpBatchIoOptions();
+
+/// @brief Prepares `socket` for batched io, enables UDP_GRO on it if configured and supported.
+void InitUdpBatchIo(Socket& socket);
+
+/// @brief A datagram received by `RecvDatagrams`.
+struct ReceivedDatagram {
+  NetworkAddress peer;
+  NoncontiguousBuffer payload;
+};
+
+/// @brief Receives datagrams with one `recvmmsg` call. The datagrams land in blocks of the buffer memory pool and are
+///        handed over without copy.
+/// @param socket Non-blocking udp socket
+/// @param max_num The maximum number of messages to receive, capped at 64
+/// @param [out] datagrams Received datagrams are appended to it, the segments coalesced by GRO are split into
+///                        datagrams. Empty datagrams are dropped.
+/// @return The number of messages received, or -1 with errno set (EAGAIN if there is nothing to receive)
+int RecvDatagrams(Socket& socket, std::size_t max_num, std::vector<ReceivedDatagram>& datagrams);
+
+/// @brief A datagram to be sent by `SendDatagrams`.
+struct OutgoingDatagram {
+  const NetworkAddress* to;
+  const NoncontiguousBuffer* payload;
+};
+
+/// @brief Sends datagrams with one `sendmmsg` call, consecutive datagrams to the same peer are sent as one GSO message
+///        if enabled.
+/// @param socket Non-blocking udp socket
+/// @param datagrams Datagrams to send, the payloads are sent without copy
+/// @param num The number of datagrams, at most 64 of them are sent by one call
+/// @return The number of datagrams sent from the front of `datagrams`, or -1 with errno set if the first one failed
+int SendDatagrams(Socket& socket, const OutgoingDatagram* datagrams, std::size_t num);
+
+}  // namespace trpc
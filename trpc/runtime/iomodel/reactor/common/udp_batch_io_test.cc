@@ -0,0 +1,137 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/iomodel/reactor/common/udp_batch_io.h"
+
+#include <poll.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+#include "trpc/util/net_util.h"
+
+namespace trpc::testing {
+
+class UdpBatchIoTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    addr_ = NetworkAddress(trpc::util::GenRandomAvailablePort(), true, NetworkAddress::IpType::kIpV4);
+    receiver_ = Socket::CreateUdpSocket();
+    receiver_.SetReuseAddr();
+    ASSERT_TRUE(receiver_.Bind(addr_));
+    receiver_.SetBlock(false);
+    InitUdpBatchIo(receiver_);
+
+    sender_ = Socket::CreateUdpSocket();
+    sender_.SetBlock(false);
+  }
+
+  void TearDown() override {
+    receiver_.Close();
+    sender_.Close();
+  }
+
+  // Sends all of `payloads` to the receiver.
+  void Send(const std::vector<std::string>& payloads) {
+    std::vector<NoncontiguousBuffer> buffers;
+    for (const auto& payload : payloads) {
+      buffers.push_back(CreateBufferSlow(payload));
+    }
+    std::vector<OutgoingDatagram> datagrams;
+    for (const auto& buffer : buffers) {
+      datagrams.push_back(OutgoingDatagram{&addr_, &buffer});
+    }
+
+    std::size_t sent = 0;
+    while (sent != datagrams.size()) {
+      int rc = SendDatagrams(sender_, datagrams.data() + sent, datagrams.size() - sent);
+      ASSERT_GT(rc, 0);
+      sent += rc;
+    }
+  }
+
+  // Receives until `num` datagrams are received.
+  std::vector<std::string> Receive(std::size_t num, std::size_t batch_size = 16) {
+    std::vector<std::string> payloads;
+    std::vector<ReceivedDatagram> datagrams;
+    while (payloads.size() < num) {
+      pollfd pfd{receiver_.GetFd(), POLLIN, 0};
+      if (::poll(&pfd, 1, 1000) != 1) {
+        break;
+      }
+      datagrams.clear();
+      int rc = RecvDatagrams(receiver_, batch_size, datagrams);
+      EXPECT_LE(rc, static_cast<int>(batch_size));
+      for (auto& datagram : datagrams) {
+        EXPECT_EQ("127.0.0.1", datagram.peer.Ip());
+        payloads.push_back(FlattenSlow(datagram.payload));
+      }
+    }
+    return payloads;
+  }
+
+ protected:
+  NetworkAddress addr_;
+  Socket receiver_;
+  Socket sender_;
+};
+
+TEST_F(UdpBatchIoTest, NothingToReceive) {
+  std::vector<ReceivedDatagram> datagrams;
+  ASSERT_EQ(-1, RecvDatagrams(receiver_, 16, datagrams));
+  ASSERT_EQ(EAGAIN, errno);
+  ASSERT_TRUE(datagrams.empty());
+}
+
+TEST_F(UdpBatchIoTest, SendAndReceive) {
+  std::vector<std::string> payloads;
+  for (int i = 0; i != 20; ++i) {
+    payloads.push_back("datagram-" + std::to_string(i));
+  }
+  // Larger than a block of the memory pool, and the largest one.
+  payloads.push_back(std::string(10000, 'x'));
+  payloads.push_back(std::string(65507, 'y'));
+
+  Send(payloads);
+  ASSERT_EQ(payloads, Receive(payloads.size(), 4));
+}
+
+TEST_F(UdpBatchIoTest, SegmentsOfSameSize) {
+  // Coalesced into GSO messages (if supported) on sending, and maybe into GRO messages on receiving, which are split
+  // into the original datagrams again.
+  std::vector<std::string> payloads;
+  for (int i = 0; i != 100; ++i) {
+    payloads.push_back(std::string(1000, 'a' + i % 26));
+  }
+  payloads.push_back(std::string(500, 'z'));
+  payloads.push_back(std::string(1000, 'z'));
+
+  Send(payloads);
+  ASSERT_EQ(payloads, Receive(payloads.size()));
+}
+
+TEST_F(UdpBatchIoTest, Options) {
+  UdpBatchIoOptions options = GetUdpBatchIoOptions();
+  UdpBatchIoOptions changed = options;
+  changed.recv_batch_size = 0;
+  changed.send_batch_size = 1000;
+  SetUdpBatchIoOptions(changed);
+  ASSERT_EQ(1, GetUdpBatchIoOptions().recv_batch_size);
+  ASSERT_EQ(64, GetUdpBatchIoOptions().send_batch_size);
+  SetUdpBatchIoOptions(options);
+}
+
+}  // namespace trpc::testing
@@ -0,0 +1,241 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#include "trpc/runtime/iomodel/reactor/common/zero_copy_send.h"
+
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+
+#include <chrono>
+#include <utility>
+#include <vector>
+
+#include "trpc/util/chrono/chrono.h"
+#include "trpc/util/internal/never_destroyed.h"
+#include "trpc/util/likely.h"
+#include "trpc/util/log/logging.h"
+
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#endif
+
+#ifndef SO_EE_CODE_ZEROCOPY_COPIED
+#define SO_EE_CODE_ZEROCOPY_COPIED 1
+#endif
+
+namespace trpc {
+
+namespace {
+
+// Bound of the window of writes not completed yet, which is far beyond what the send buffer of a socket holds.
+constexpr uint32_t kMaxPendingSends = 1 << 20;
+
+// Sockets whose zero-copy writes don't complete in this long are reset, which purges their send queues.
+constexpr std::chrono::seconds kLingerTimeout{30};
+
+ZeroCopySendOptions zero_copy_send_options;
+
+struct LingeringSocket {
+  Socket socket;
+  std::unique_ptr<ZeroCopySendTracker> tracker;
+  std::chrono::steady_clock::time_point deadline;
+};
+
+struct LingeringSockets {
+  std::mutex mutex;
+  std::vector<LingeringSocket> sockets;
+};
+
+// Never destroyed, the blocks held must not be freed after the memory pool is gone at exit.
+LingeringSockets* GetLingeringSockets() {
+  static internal::NeverDestroyed<LingeringSockets> lingering_sockets;
+  return lingering_sockets.Get();
+}
+
+}  // namespace
+
+void SetZeroCopySendOptions(const ZeroCopySendOptions& options) { zero_copy_send_options = options; }
+
+const ZeroCopySendOptions& GetZeroCopySendOptions() { return zero_copy_send_options; }
+
+std::unique_ptr<ZeroCopySendTracker> ZeroCopySendTracker::Create(Socket& socket) {
+  if (!zero_copy_send_options.enable || !socket.SetZeroCopy()) {
+    return nullptr;
+  }
+  return std::make_unique<ZeroCopySendTracker>();
+}
+
+uint32_t ZeroCopySendTracker::OnSent() {
+  std::scoped_lock _(mutex_);
+  uint32_t id = next_seq_++;
+  if (PendingSend* pending = GetPendingSend(id); TRPC_LIKELY(pending != nullptr)) {
+    pending->sent = true;
+    PopCompletedSends();
+  }
+  return id;
+}
+
+void ZeroCopySendTracker::Hold(uint32_t id, NoncontiguousBuffer&& buffer) {
+  std::scoped_lock _(mutex_);
+  // Out of the window means it has completed and been dropped.
+  if (uint32_t index = id - first_seq_; index < pending_.size() && !pending_[index].completed) {
+    pending_[index].buffer = std::move(buffer);
+  }
+}
+
+bool ZeroCopySendTracker::ReapCompletions(Socket& socket) {
+  std::size_t completions = 0;
+  bool error_found = false;
+  while (true) {
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+    msghdr msg = {};
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    if (socket.RecvMsg(&msg, MSG_ERRQUEUE, nullptr) < 0) {
+      break;
+    }
+
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (!(cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) &&
+          !(cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR)) {
+        continue;
+      }
+
+      sock_extended_err err;
+      memcpy(&err, CMSG_DATA(cmsg), sizeof(err));
+      if (err.ee_origin != SO_EE_ORIGIN_ZEROCOPY || err.ee_errno != 0) {
+        error_found = true;
+        continue;
+      }
+
+      if (err.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) {
+        // Pinning pages buys nothing if the kernel copies them anyway, eg: on loopback or nic without scatter-gather.
+        if (enabled_.exchange(false, std::memory_order_relaxed)) {
+          TRPC_LOG_DEBUG("zero-copy send is copied by kernel, disable it on fd: " << socket.GetFd());
+        }
+      }
+
+      // Writes numbered [ee_info, ee_data] have completed.
+      std::scoped_lock _(mutex_);
+      for (uint32_t seq = err.ee_info;; ++seq) {
+        if (PendingSend* pending = GetPendingSend(seq); pending != nullptr) {
+          pending->completed = true;
+          pending->buffer.Clear();
+        }
+        ++completions;
+        if (seq == err.ee_data) {
+          break;
+        }
+      }
+      PopCompletedSends();
+    }
+  }
+
+  if (error_found || completions == 0) {
+    return false;
+  }
+
+  int error = 0;
+  socklen_t len = sizeof(error);
+  return socket.GetSockOpt(SO_ERROR, &error, &len) == 0 && error == 0;
+}
+
+std::size_t ZeroCopySendTracker::PendingSends() const {
+  std::scoped_lock _(mutex_);
+  std::size_t count = 0;
+  for (auto&& pending : pending_) {
+    count += pending.sent && !pending.completed;
+  }
+  return count;
+}
+
+ZeroCopySendTracker::PendingSend* ZeroCopySendTracker::GetPendingSend(uint32_t seq) {
+  uint32_t index = seq - first_seq_;
+  if (TRPC_UNLIKELY(index >= kMaxPendingSends)) {
+    TRPC_FMT_ERROR_EVERY_SECOND("Unexpected zero-copy send number: {}, first pending: {}", seq, first_seq_);
+    return nullptr;
+  }
+  if (index >= pending_.size()) {
+    pending_.resize(index + 1);
+  }
+  return &pending_[index];
+}
+
+void ZeroCopySendTracker::PopCompletedSends() {
+  while (!pending_.empty() && pending_.front().sent && pending_.front().completed) {
+    pending_.pop_front();
+    ++first_seq_;
+  }
+}
+
+void CloseAfterZeroCopySends(Socket& socket, std::unique_ptr<ZeroCopySendTracker> tracker) {
+  if (tracker) {
+    tracker->ReapCompletions(socket);
+  }
+  if (!tracker || tracker->PendingSends() == 0) {
+    socket.Close();
+    return;
+  }
+
+  TRPC_LOG_DEBUG("zero-copy writes pending on closing fd: " << socket.GetFd() << ", close it once they complete");
+  LingeringSockets* lingering = GetLingeringSockets();
+  {
+    std::scoped_lock _(lingering->mutex);
+    lingering->sockets.push_back(LingeringSocket{socket, std::move(tracker), ReadSteadyClock() + kLingerTimeout});
+  }
+  socket = Socket();
+}
+
+std::size_t ReapLingeringZeroCopySockets(bool abort_all) {
+  LingeringSockets* lingering = GetLingeringSockets();
+  std::scoped_lock _(lingering->mutex);
+  auto now = ReadSteadyClock();
+  auto& sockets = lingering->sockets;
+  for (std::size_t i = 0; i < sockets.size();) {
+    auto& [socket, tracker, deadline] = sockets[i];
+    tracker->ReapCompletions(socket);
+    if (tracker->PendingSends() != 0) {
+      if (!abort_all && now < deadline) {
+        ++i;
+        continue;
+      }
+      TRPC_LOG_WARN("zero-copy writes not completed on closing fd: " << socket.GetFd() << ", reset it");
+      // Resetting purges the send queue, the kernel no longer sends the blocks held then.
+      socket.SetNoCloseWait();
+    }
+    socket.Close();
+    sockets[i] = std::move(sockets.back());
+    sockets.pop_back();
+  }
+  return sockets.size();
+}
+
+int WritevMaybeZeroCopy(IoHandler* io, ZeroCopySendTracker* tracker, const iovec* iov, int iovcnt, std::size_t bytes,
+                        std::optional<uint32_t>* zero_copy_id) {
+  zero_copy_id->reset();
+  if (tracker != nullptr && tracker->ShouldUse(bytes)) {
+    int rc = io->WritevZeroCopy(iov, iovcnt);
+    if (rc > 0) {
+      *zero_copy_id = tracker->OnSent();
+      return rc;
+    }
+    // The handler can't send without copy (eg: ssl), or the socket is out of memory to pin the pages, copy instead.
+    if (rc == 0 || (errno != EOPNOTSUPP && errno != ENOBUFS)) {
+      return rc;
+    }
+  }
+  return io->Writev(iov, iovcnt);
+}
+
+}  // namespace trpc
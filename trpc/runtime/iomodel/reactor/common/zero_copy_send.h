@@ -0,0 +1,123 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#pragma once
+
+#include <sys/uio.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include "trpc/runtime/iomodel/reactor/common/io_handler.h"
+#include "trpc/runtime/iomodel/reactor/common/socket.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc {
+
+/// @brief Options of zero-copy send (`MSG_ZEROCOPY`) on tcp connections, shared by all connections of the process.
+struct ZeroCopySendOptions {
+  /// @brief Whether to send large writes with `MSG_ZEROCOPY`, requires Linux 4.14+.
+  bool enable{false};
+
+  /// @brief Writes smaller than this are copied as usual, pinning pages and reading completions costs more than copying
+  ///        small writes.
+  std::size_t min_bytes{64 * 1024};
+};
+
+/// @brief Sets the options of zero-copy send, which should be done before any connection is created.
+void SetZeroCopySendOptions(const ZeroCopySendOptions& options);
+
+/// @brief Gets the options of zero-copy send.
+const ZeroCopySendOptions& GetZeroCopySendOptions();
+
+/// @brief Keeps the buffers written with `MSG_ZEROCOPY` alive until the kernel reports on the error queue of the
+///        socket that it no longer references them.
+/// @note Thread-safe, sends and completions may be handled by different threads.
+class ZeroCopySendTracker {
+ public:
+  /// @brief Enables `SO_ZEROCOPY` on `socket` if zero-copy send is configured.
+  /// @return The tracker of the socket, or nullptr if zero-copy send is disabled or not supported by the socket
+  static std::unique_ptr<ZeroCopySendTracker> Create(Socket& socket);
+
+  /// @brief Whether a write of `bytes` bytes should be sent with zero-copy.
+  /// @note Turns false for good once the kernel reports it had to copy the data anyway, eg: on loopback.
+  bool ShouldUse(std::size_t bytes) const {
+    return bytes >= GetZeroCopySendOptions().min_bytes && enabled_.load(std::memory_order_relaxed);
+  }
+
+  /// @brief Records a successful zero-copy write, must be called right after each of them in the order of the writes.
+  /// @return Id of the write, with which the blocks written are handed over to `Hold`
+  uint32_t OnSent();
+
+  /// @brief Keeps the blocks of `buffer` alive until the write `id` completes.
+  void Hold(uint32_t id, NoncontiguousBuffer&& buffer);
+
+  /// @brief Reads the completion notifications from the error queue of `socket` and releases the completed buffers.
+  /// @return true if only completions were found and there's no error pending on the socket, the error event they
+  ///         raised can be ignored then
+  bool ReapCompletions(Socket& socket);
+
+  /// @brief Gets the number of zero-copy writes not completed yet.
+  std::size_t PendingSends() const;
+
+ private:
+  struct PendingSend {
+    NoncontiguousBuffer buffer;
+    bool sent{false};
+    bool completed{false};
+  };
+
+  // Returns the entry of the write numbered `seq` by the kernel, nullptr if it's out of the window.
+  PendingSend* GetPendingSend(uint32_t seq);
+
+  // Drops the writes completed from the front of the window.
+  void PopCompletedSends();
+
+ private:
+  mutable std::mutex mutex_;
+  // Number the kernel assigned to `pending_.front()`, writes are numbered from 0 on each socket.
+  uint32_t first_seq_{0};
+  // Number the kernel assigns to the next write.
+  uint32_t next_seq_{0};
+  // Completions may be read before `OnSent` is called for the write, so entries are indexed by the number. Entries
+  // completed and sent are dropped from the front, `Hold` on them releases the blocks right away.
+  std::deque<PendingSend> pending_;
+  std::atomic<bool> enabled_{true};
+};
+
+/// @brief Closes the socket of a closing connection once the zero-copy writes tracked by `tracker` complete, so that the
+///        kernel never sends blocks which have been freed and reused. If writes are still pending, `socket` and `tracker`
+///        linger until `ReapLingeringZeroCopySockets` finds them completed.
+/// @note `socket` is left invalid, it must have been removed from the reactor already. `tracker` may be nullptr.
+void CloseAfterZeroCopySends(Socket& socket, std::unique_ptr<ZeroCopySendTracker> tracker);
+
+/// @brief Closes the lingering sockets whose zero-copy writes have all completed, and resets those lingering for too
+///        long, eg: the peer stopped receiving. Called periodically by the framework.
+/// @param abort_all Resets all the lingering sockets, on shutdown after all connections are closed
+/// @return The number of sockets still lingering
+std::size_t ReapLingeringZeroCopySockets(bool abort_all = false);
+
+/// @brief Writes `iov` through `io`, with zero-copy if `tracker` allows it. Falls back to a normal write if zero-copy is
+///        not available for this write.
+/// @param bytes Total size of `iov`
+/// @param [out] zero_copy_id Id of the write if the data was sent with zero-copy, the caller must hand the blocks
+///                           written over to `tracker` with `Hold` then
+/// @return The same as `IoHandler::Writev`
+int WritevMaybeZeroCopy(IoHandler* io, ZeroCopySendTracker* tracker, const iovec* iov, int iovcnt, std::size_t bytes,
+                        std::optional<uint32_t>* zero_copy_id);
+
+}  // namespace trpc
@@ -0,0 +1,291 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#include "trpc/runtime/iomodel/reactor/common/zero_copy_send.h"
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc::testing {
+
+class FdIoHandler : public IoHandler {
+ public:
+  FdIoHandler(int fd, bool zero_copy) : fd_(fd), zero_copy_(zero_copy) {}
+
+  Connection* GetConnection() const override { return nullptr; }
+
+  HandshakeStatus Handshake(bool is_read_event) override { return HandshakeStatus::kSucc; }
+
+  int Read(void* buff, uint32_t length) override { return ::recv(fd_, buff, length, 0); }
+
+  int Writev(const iovec* iov, int iovcnt) override {
+    ++writev_count;
+    return ::writev(fd_, iov, iovcnt);
+  }
+
+  int WritevZeroCopy(const iovec* iov, int iovcnt) override {
+    if (!zero_copy_) {
+      return IoHandler::WritevZeroCopy(iov, iovcnt);
+    }
+    msghdr msg = {};
+    msg.msg_iov = const_cast<iovec*>(iov);
+    msg.msg_iovlen = iovcnt;
+    return ::sendmsg(fd_, &msg, MSG_ZEROCOPY);
+  }
+
+  int writev_count{0};
+
+ private:
+  int fd_;
+  bool zero_copy_;
+};
+
+class ZeroCopySendTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    options_ = GetZeroCopySendOptions();
+    ZeroCopySendOptions options;
+    options.enable = true;
+    options.min_bytes = 64 * 1024;
+    SetZeroCopySendOptions(options);
+
+    Socket listener = Socket::CreateTcpSocket(false);
+    listener.SetReuseAddr();
+    // Large enough for the writes of the tests to complete before being read.
+    listener.SetRecvBufferSize(1024 * 1024);
+    // Bound to a port picked by the kernel, which can't be taken by any other socket meanwhile.
+    ASSERT_TRUE(listener.Bind(NetworkAddress("127.0.0.1", 0, NetworkAddress::IpType::kIpV4)));
+    ASSERT_TRUE(listener.Listen());
+    sockaddr_in bound_addr = {};
+    socklen_t bound_addr_len = sizeof(bound_addr);
+    ASSERT_EQ(::getsockname(listener.GetFd(), reinterpret_cast<sockaddr*>(&bound_addr), &bound_addr_len), 0);
+    NetworkAddress addr(reinterpret_cast<sockaddr*>(&bound_addr));
+
+    client_ = Socket::CreateTcpSocket(false);
+    client_.SetSendBufferSize(1024 * 1024);
+    ASSERT_EQ(client_.Connect(addr), 0);
+    NetworkAddress peer_addr;
+    server_ = Socket(listener.Accept(&peer_addr), AF_INET);
+    ASSERT_TRUE(server_.IsValid());
+    server_.SetBlock(true);
+    listener.Close();
+  }
+
+  void TearDown() override {
+    client_.Close();
+    server_.Close();
+    SetZeroCopySendOptions(options_);
+  }
+
+  NoncontiguousBuffer MakeBuffer(std::size_t size) {
+    NoncontiguousBufferBuilder builder;
+    builder.Append(std::string(size, 'x'));
+    return builder.DestructiveGet();
+  }
+
+  std::size_t ToIovecs(const NoncontiguousBuffer& buffer, std::vector<iovec>& iov) {
+    for (auto&& block : buffer) {
+      iov.push_back(iovec{const_cast<char*>(block.data()), block.size()});
+    }
+    return buffer.ByteSize();
+  }
+
+  void ReadAll(std::size_t size) {
+    std::vector<char> buff(size);
+    std::size_t read = 0;
+    while (read < size) {
+      int n = server_.Recv(buff.data() + read, size - read);
+      ASSERT_GT(n, 0);
+      read += n;
+    }
+  }
+
+  // Writes with zero-copy until the send queue is full, the writes not received by the server are in flight then.
+  void FillSendQueue(ZeroCopySendTracker* tracker) {
+    client_.SetBlock(false);
+    FdIoHandler io(client_.GetFd(), true);
+    while (true) {
+      NoncontiguousBuffer buffer = MakeBuffer(128 * 1024);
+      std::vector<iovec> iov;
+      std::size_t size = ToIovecs(buffer, iov);
+      std::optional<uint32_t> zero_copy_id;
+      int n = WritevMaybeZeroCopy(&io, tracker, iov.data(), iov.size(), size, &zero_copy_id);
+      if (n <= 0) {
+        ASSERT_EQ(errno, EAGAIN);
+        break;
+      }
+      if (zero_copy_id) {
+        tracker->Hold(*zero_copy_id, buffer.Cut(n));
+      }
+    }
+  }
+
+  bool WaitForErrorQueue() {
+    pollfd pfd = {.fd = client_.GetFd(), .events = 0, .revents = 0};
+    return ::poll(&pfd, 1, 1000) == 1 && (pfd.revents & POLLERR);
+  }
+
+ protected:
+  ZeroCopySendOptions options_;
+  Socket client_;
+  Socket server_;
+};
+
+TEST_F(ZeroCopySendTest, Disabled) {
+  SetZeroCopySendOptions(ZeroCopySendOptions{});
+  ASSERT_EQ(ZeroCopySendTracker::Create(client_), nullptr);
+}
+
+TEST_F(ZeroCopySendTest, SendAndReap) {
+  auto tracker = ZeroCopySendTracker::Create(client_);
+  if (!tracker) {
+    GTEST_SKIP() << "SO_ZEROCOPY is not supported by current kernel";
+  }
+  ASSERT_FALSE(tracker->ShouldUse(1024));
+  ASSERT_TRUE(tracker->ShouldUse(128 * 1024));
+
+  FdIoHandler io(client_.GetFd(), true);
+  NoncontiguousBuffer buffer = MakeBuffer(128 * 1024);
+  std::vector<iovec> iov;
+  std::size_t size = ToIovecs(buffer, iov);
+
+  std::optional<uint32_t> zero_copy_id;
+  ASSERT_EQ(WritevMaybeZeroCopy(&io, tracker.get(), iov.data(), iov.size(), size, &zero_copy_id), size);
+  ASSERT_TRUE(zero_copy_id);
+  ASSERT_EQ(*zero_copy_id, 0);
+  ASSERT_EQ(io.writev_count, 0);
+  tracker->Hold(*zero_copy_id, std::move(buffer));
+  ASSERT_EQ(tracker->PendingSends(), 1);
+
+  ReadAll(size);
+  ASSERT_TRUE(WaitForErrorQueue());
+  ASSERT_TRUE(tracker->ReapCompletions(client_));
+  ASSERT_EQ(tracker->PendingSends(), 0);
+
+  // Nothing left in the error queue.
+  ASSERT_FALSE(tracker->ReapCompletions(client_));
+
+  // The kernel copies on loopback, zero-copy is not used any more then.
+  ASSERT_FALSE(tracker->ShouldUse(128 * 1024));
+}
+
+TEST_F(ZeroCopySendTest, CompletedBeforeHold) {
+  auto tracker = ZeroCopySendTracker::Create(client_);
+  if (!tracker) {
+    GTEST_SKIP() << "SO_ZEROCOPY is not supported by current kernel";
+  }
+
+  FdIoHandler io(client_.GetFd(), true);
+  NoncontiguousBuffer buffer = MakeBuffer(64 * 1024);
+  std::vector<iovec> iov;
+  std::size_t size = ToIovecs(buffer, iov);
+
+  std::optional<uint32_t> zero_copy_id;
+  ASSERT_EQ(WritevMaybeZeroCopy(&io, tracker.get(), iov.data(), iov.size(), size, &zero_copy_id), size);
+  ASSERT_TRUE(zero_copy_id);
+
+  ReadAll(size);
+  ASSERT_TRUE(WaitForErrorQueue());
+  ASSERT_TRUE(tracker->ReapCompletions(client_));
+
+  // The blocks are released right away.
+  tracker->Hold(*zero_copy_id, std::move(buffer));
+  ASSERT_EQ(tracker->PendingSends(), 0);
+}
+
+TEST_F(ZeroCopySendTest, FallbackToCopy) {
+  auto tracker = ZeroCopySendTracker::Create(client_);
+  if (!tracker) {
+    GTEST_SKIP() << "SO_ZEROCOPY is not supported by current kernel";
+  }
+
+  NoncontiguousBuffer buffer = MakeBuffer(128 * 1024);
+  std::vector<iovec> iov;
+  std::size_t size = ToIovecs(buffer, iov);
+  std::optional<uint32_t> zero_copy_id;
+
+  // Small writes are copied.
+  FdIoHandler io(client_.GetFd(), true);
+  ASSERT_EQ(WritevMaybeZeroCopy(&io, tracker.get(), iov.data(), 1, iov[0].iov_len, &zero_copy_id), iov[0].iov_len);
+  ASSERT_FALSE(zero_copy_id);
+  ASSERT_EQ(io.writev_count, 1);
+  ReadAll(iov[0].iov_len);
+
+  // So are writes through handlers not supporting zero-copy.
+  FdIoHandler copy_io(client_.GetFd(), false);
+  ASSERT_EQ(WritevMaybeZeroCopy(&copy_io, tracker.get(), iov.data(), iov.size(), size, &zero_copy_id), size);
+  ASSERT_FALSE(zero_copy_id);
+  ASSERT_EQ(copy_io.writev_count, 1);
+  ReadAll(size);
+
+  ASSERT_EQ(tracker->PendingSends(), 0);
+}
+
+TEST_F(ZeroCopySendTest, PeerClosesWithSendsInFlight) {
+  auto tracker = ZeroCopySendTracker::Create(client_);
+  if (!tracker) {
+    GTEST_SKIP() << "SO_ZEROCOPY is not supported by current kernel";
+  }
+
+  FillSendQueue(tracker.get());
+  ASSERT_GT(tracker->PendingSends(), 0);
+
+  // The connection goes while the kernel still holds the blocks written, so does the socket.
+  CloseAfterZeroCopySends(client_, std::move(tracker));
+  ASSERT_FALSE(client_.IsValid());
+  ASSERT_EQ(ReapLingeringZeroCopySockets(), 1);
+
+  // The peer closes without reading, the connection is reset and the send queue is purged.
+  server_.Close();
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  while (ReapLingeringZeroCopySockets() != 0 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(ReapLingeringZeroCopySockets(), 0);
+}
+
+TEST_F(ZeroCopySendTest, AbortLingeringSockets) {
+  auto tracker = ZeroCopySendTracker::Create(client_);
+  if (!tracker) {
+    GTEST_SKIP() << "SO_ZEROCOPY is not supported by current kernel";
+  }
+
+  FillSendQueue(tracker.get());
+  ASSERT_GT(tracker->PendingSends(), 0);
+
+  CloseAfterZeroCopySends(client_, std::move(tracker));
+  ASSERT_EQ(ReapLingeringZeroCopySockets(), 1);
+
+  // The peer is alive but never reads, the socket is reset on shutdown.
+  ASSERT_EQ(ReapLingeringZeroCopySockets(true), 0);
+}
+
+TEST_F(ZeroCopySendTest, CloseWithoutSendsInFlight) {
+  CloseAfterZeroCopySends(client_, ZeroCopySendTracker::Create(client_));
+  ASSERT_FALSE(client_.IsValid());
+  ASSERT_EQ(ReapLingeringZeroCopySockets(), 0);
+}
+
+}  // namespace trpc::testing
@@ -114,8 +114,8 @@ void ReactorImpl::Run() {
   SetCurrentTlsReactor(nullptr);
 }
 
-void ReactorImpl::Update(EventHandler* event_handler) {
-  poller_.UpdateEvent(event_handler);
+bool ReactorImpl::Update(EventHandler* event_handler) {
+  return poller_.UpdateEvent(event_handler);
 }
 
 bool ReactorImpl::SubmitTask(Task&& task, Priority priority) {
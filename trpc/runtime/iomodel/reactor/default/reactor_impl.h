@@ -64,7 +64,7 @@ class alignas(hardware_destructive_interference_size) ReactorImpl final : public
 
   void Destroy() override;
 
-  void Update(EventHandler* event_handler) override;
+  bool Update(EventHandler* event_handler) override;
 
   bool SubmitTask(Task&& task, Priority priority) override;
 
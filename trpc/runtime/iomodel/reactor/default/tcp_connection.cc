@@ -21,6 +21,7 @@
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include "trpc/runtime/iomodel/reactor/common/io_handler.h"
@@ -33,6 +34,8 @@ TcpConnection::TcpConnection(Reactor* reactor, const Socket& socket) : reactor_(
   TRPC_ASSERT(reactor_);
   TRPC_ASSERT(socket_.IsValid());
 
+  zero_copy_send_tracker_ = ZeroCopySendTracker::Create(socket_);
+
   SetFd(socket_.GetFd());
 }
 
@@ -154,7 +157,8 @@ void TcpConnection::DisableReadWrite() {
 
   Deref();
 
-  socket_.Close();
+  // The kernel may still be sending blocks written with zero-copy, which the tracker holds until completed.
+  CloseAfterZeroCopySends(socket_, std::move(zero_copy_send_tracker_));
 }
 
 void TcpConnection::DisableRead() {
@@ -268,7 +272,9 @@ int TcpConnection::HandleWriteEvent() {
       }
     }
 
-    int n = GetIoHandler()->Writev(iov, iov_index);
+    std::optional<uint32_t> zero_copy_id;
+    int n = WritevMaybeZeroCopy(GetIoHandler(), zero_copy_send_tracker_.get(), iov, iov_index, total_size,
+                                &zero_copy_id);
     if (n < 0) {
       if (errno != EAGAIN) {
         if (errno == EINTR) {
@@ -290,6 +296,8 @@ int TcpConnection::HandleWriteEvent() {
         flag = false;
       }
 
+      // The blocks written with zero-copy are still referenced by the kernel, they're moved here instead of being freed.
+      NoncontiguousBuffer zero_copy_written;
       while (n > 0) {
         IoMessage& temp = io_msgs_.front();
         auto& buff = temp.buffer;
@@ -299,12 +307,22 @@ int TcpConnection::HandleWriteEvent() {
 
           MessageWriteDone(temp);
 
+          if (zero_copy_id) {
+            zero_copy_written.Append(std::move(buff));
+          }
           io_msgs_.pop_front();
         } else {
-          buff.Skip(n);
+          if (zero_copy_id) {
+            zero_copy_written.Append(buff.Cut(n));
+          } else {
+            buff.Skip(n);
+          }
           break;
         }
       }
+      if (zero_copy_id) {
+        zero_copy_send_tracker_->Hold(*zero_copy_id, std::move(zero_copy_written));
+      }
 
       total_size = 0;
     }
@@ -330,6 +348,13 @@ void TcpConnection::HandleCloseEvent() {
     return;
   }
 
+  // Completions of zero-copy sends are reported as error events, reap them before the connection goes. Only an error
+  // alone which is nothing but completions leaves the connection open.
+  bool reaped = zero_copy_send_tracker_ && zero_copy_send_tracker_->ReapCompletions(socket_);
+  if (reaped && !(GetRecvEvents() & EventHandler::EventType::kHangUpEvent)) {
+    return;
+  }
+
   TRPC_LOG_DEBUG("TcpConnection::HandleCloseEvent fd:" << socket_.GetFd() << ", ip:" << GetPeerIp()
                                                        << ", port:" << GetPeerPort() << ", is_client:" << IsClient()
                                                        << ", epoll event error and connection close.");
@@ -480,8 +505,12 @@ int TcpConnection::ReadIoData(NoncontiguousBuffer& buff) {
       buff.Append(read_buffer_.builder.Seal(n));
 
       if ((size_t)n < writable_size) {
+        // Do not keep a large block while waiting for more.
+        read_buffer_.builder.Shrink();
         break;
       }
+      // The block has been filled up, size the next read to what is pending in the socket.
+      read_buffer_.builder.Reserve(socket_.GetReadableSize());
     } else if (n == 0) {
       ret = -1;
       TRPC_LOG_DEBUG("TcpConnection::HandleReadEvent fd:" << socket_.GetFd() << ", ip:" << GetPeerIp()
@@ -499,6 +528,8 @@ int TcpConnection::ReadIoData(NoncontiguousBuffer& buff) {
                                                       << ", port:" << GetPeerPort() << ", is_client:" << IsClient()
                                                       << ", errno:" << errno << ", read failed and connection close.");
         HandleClose(true);
+      } else {
+        read_buffer_.builder.Shrink();
       }
       break;
     }
@@ -14,10 +14,12 @@
 #pragma once
 
 #include <deque>
+#include <memory>
 
 #include "trpc/runtime/iomodel/reactor/common/connection.h"
 #include "trpc/runtime/iomodel/reactor/common/io_message.h"
 #include "trpc/runtime/iomodel/reactor/common/socket.h"
+#include "trpc/runtime/iomodel/reactor/common/zero_copy_send.h"
 #include "trpc/runtime/iomodel/reactor/reactor.h"
 #include "trpc/util/align.h"
 #include "trpc/util/buffer/noncontiguous_buffer.h"
@@ -95,6 +97,9 @@ class TcpConnection final : public Connection {
   // When the connection is established,
   // notify the upper layer that the data cached in the queue can be written
   bool notify_cache_msg_in_queue_{false};
+
+  // Blocks written with zero-copy, nullptr if zero-copy send is not enabled
+  std::unique_ptr<ZeroCopySendTracker> zero_copy_send_tracker_;
 };
 
 }  // namespace trpc
@@ -16,6 +16,7 @@
 #include <errno.h>
 #include <string.h>
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -34,6 +35,7 @@ UdpTransceiver::UdpTransceiver(Reactor* reactor, const Socket& socket, bool is_c
     socket_.SetReusePort();
   }
   socket_.SetBlock(false);
+  InitUdpBatchIo(socket_);
   SetFd(socket_.GetFd());
 }
 
@@ -108,56 +110,76 @@ void UdpTransceiver::DisableReadWrite() {
 
 int UdpTransceiver::HandleReadEvent() {
   read_buffer_.Clear();
+  const std::size_t batch_size = GetUdpBatchIoOptions().recv_batch_size;
   while (true) {
-    int n = ReadIoData(read_buffer_);
-    if (n > 0) {
+    received_datagrams_.clear();
+    int n = RecvDatagrams(socket_, batch_size, received_datagrams_);
+    if (n < 0) {
+      if (errno != EAGAIN) {
+        TRPC_LOG_ERROR("UdpTransceiver::HandleReadEvent read datagram error, fd:"
+                       << socket_.GetFd() << ", conn_id:" << this->GetConnId() << ", is_client:" << IsClient()
+                       << ", errno:" << errno);
+      }
+      break;
+    }
+
+    RefPtr ref(ref_ptr, this);
+    for (auto& datagram : received_datagrams_) {
+      SetPeerIp(datagram.peer.Ip());
+      SetPeerPort(datagram.peer.Port());
+      read_buffer_.Append(std::move(datagram.payload));
+
       std::deque<std::any> data;
-      RefPtr ref(ref_ptr, this);
       int ret = GetConnectionHandler()->CheckMessage(ref, read_buffer_, data);
       if (ret == kPacketFull) {
         GetConnectionHandler()->HandleMessage(ref, data);
       } else if (ret == kPacketError) {
         // only discard the packet received, no need to close the socket
-        break;
+        read_buffer_.Clear();
       }
-    } else {
+    }
+
+    // The socket has been drained, a datagram arriving later triggers another read event.
+    if (static_cast<std::size_t>(n) < batch_size) {
       break;
     }
   }
+  received_datagrams_.clear();
 
   return 0;
 }
 
 int UdpTransceiver::HandleWriteEvent() {
-  int send_finish = 0;
-
-  for (const auto& msg : io_msgs_) {
-    BufferPtr buff = trpc::MakeRefCounted<Buffer>(msg.buffer.ByteSize());
-    FlattenToSlow(msg.buffer, buff->GetWritePtr(), buff->WritableSize());
-    buff->AddWriteLen(buff->WritableSize());
+  const std::size_t batch_size = GetUdpBatchIoOptions().send_batch_size;
+  while (!io_msgs_.empty()) {
+    std::size_t num = std::min(batch_size, io_msgs_.size());
+    sending_addrs_.clear();
+    sending_datagrams_.clear();
+    for (std::size_t i = 0; i != num; ++i) {
+      sending_addrs_.emplace_back(io_msgs_[i].ip, io_msgs_[i].port, NetworkAddress::IpType::kUnknown);
+    }
+    for (std::size_t i = 0; i != num; ++i) {
+      sending_datagrams_.push_back(OutgoingDatagram{&sending_addrs_[i], &io_msgs_[i].buffer});
+    }
 
-    NetworkAddress peer_addr(msg.ip, msg.port, NetworkAddress::IpType::kUnknown);
-    int n = socket_.SendTo(buff->GetReadPtr(), buff->ReadableSize(), 0, peer_addr);
+    int n = SendDatagrams(socket_, sending_datagrams_.data(), num);
     if (n < 0) {
-      TRPC_FMT_ERROR("Send error, reason = {}, peer addr = {}", strerror(errno), peer_addr.ToString());
+      TRPC_FMT_ERROR("Send error, reason = {}, peer addr = {}", strerror(errno), sending_addrs_[0].ToString());
       // only need to retry sending the packet in this case to avoid continuous increase of the queue
-      if (errno == EWOULDBLOCK || errno == EAGAIN) {
-        break;
-      }
       break;
     }
 
-    send_finish++;
-  }
-
-  while (send_finish > 0) {
-    IoMessage& temp = io_msgs_.front();
+    for (int i = 0; i != n; ++i) {
+      // Popped before being reported, in case more messages are sent from within the callback.
+      IoMessage msg = std::move(io_msgs_.front());
+      io_msgs_.pop_front();
 
-    MessageWriteDone(temp);
-
-    io_msgs_.pop_front();
+      MessageWriteDone(msg);
+    }
 
-    --send_finish;
+    if (static_cast<std::size_t>(n) < num) {
+      break;
+    }
   }
 
   return 0;
@@ -191,25 +213,4 @@ void UdpTransceiver::HandleClose(bool destroy) {
 
 void UdpTransceiver::MessageWriteDone(IoMessage& msg) { GetConnectionHandler()->MessageWriteDone(msg); }
 
-int UdpTransceiver::ReadIoData(NoncontiguousBuffer& buff) {
-  NetworkAddress peer_addr;
-  int n = socket_.RecvFrom(static_cast<void*>(recv_buffer_), kUdpBuffSize, 0, &peer_addr);
-  if (n > 0) {
-    buff.Append(CreateBufferSlow(recv_buffer_, n));
-
-    SetPeerIp(peer_addr.Ip());
-    SetPeerPort(peer_addr.Port());
-    return n;
-  } else if (n < 0) {
-    if (errno == EAGAIN) {
-      return n;
-    }
-    TRPC_LOG_ERROR("UdpTransceiver::ReadIoData read datagram error, fd:"
-                   << socket_.GetFd() << ", conn_id:" << this->GetConnId() << ", is_client:" << IsClient()
-                   << ", errno:" << errno);
-    // It can continue to read even if failed to read a udp packet
-  }
-  return n;
-}
-
 }  // namespace trpc
@@ -15,10 +15,12 @@
 
 #include <deque>
 #include <memory>
+#include <vector>
 
 #include "trpc/runtime/iomodel/reactor/common/connection.h"
 #include "trpc/runtime/iomodel/reactor/common/io_message.h"
 #include "trpc/runtime/iomodel/reactor/common/socket.h"
+#include "trpc/runtime/iomodel/reactor/common/udp_batch_io.h"
 #include "trpc/runtime/iomodel/reactor/reactor.h"
 #include "trpc/util/align.h"
 #include "trpc/util/buffer/noncontiguous_buffer.h"
@@ -56,9 +58,6 @@ class UdpTransceiver final : public Connection {
   // Call when a business request or response is successfully written to the network
   void MessageWriteDone(IoMessage& msg);
 
-  // Serves as the default implement for reading IO data when the user does not have a custom IO read function
-  int ReadIoData(NoncontiguousBuffer& buff);
-
   void HandleClose(bool destroy);
 
  private:
@@ -79,10 +78,12 @@ class UdpTransceiver final : public Connection {
   // Io message send queue
   std::deque<IoMessage> io_msgs_;
 
-  // Size of udp buff
-  static constexpr uint32_t kUdpBuffSize = 64 * 1024;
-  // Store the data read from the RecvFrom call
-  char recv_buffer_[kUdpBuffSize] = {0};
+  // Datagrams received by the current read, kept to reuse the memory
+  std::vector<ReceivedDatagram> received_datagrams_;
+
+  // Destinations and datagrams of the current send, kept to reuse the memory
+  std::vector<NetworkAddress> sending_addrs_;
+  std::vector<OutgoingDatagram> sending_datagrams_;
 };
 
 }  // namespace trpc
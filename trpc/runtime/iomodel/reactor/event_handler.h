@@ -28,6 +28,9 @@ class alignas(8) EventHandler : public trpc::RefCounted<EventHandler> {
     kReadEvent = 0x01,
     kWriteEvent = 0x02,
     kCloseEvent = 0x04,
+    // Received along with `kCloseEvent` if the peer hung up, which tells it from an error alone, eg: messages queued
+    // on the error queue of the socket. Only set in received events.
+    kHangUpEvent = 0x08,
     kMaxEvent = 0xff,
   };
 
@@ -86,7 +86,9 @@ bool FiberAcceptor::Listen() {
 
   EnableEvent(EventHandler::EventType::kReadEvent);
 
-  AttachReactor();
+  if (!AttachReactor()) {
+    return false;
+  }
 
   SetInitializationState(InitializationState::kInitializedSuccess);
 
@@ -60,12 +60,20 @@ void FiberConnection::EnableEvent(int event_type) {
   restart_write_count_ = (event_type & EventType::kWriteEvent) ? 1 : 0;
 }
 
-void FiberConnection::AttachReactor() {
+bool FiberConnection::AttachReactor() {
   Ref();
 
   SetEnabled(true);
 
-  GetReactor()->Update(this);
+  if (TRPC_UNLIKELY(!GetReactor()->Update(this))) {
+    TRPC_FMT_ERROR("FiberConnection::AttachReactor failed, fd: {}, ip: {}, port: {}, is_client: {}", GetFd(),
+                   GetPeerIp(), GetPeerPort(), IsClient());
+    SetEnabled(false);
+    Deref();
+    return false;
+  }
+
+  return true;
 }
 
 void FiberConnection::DisableRead() {
@@ -165,6 +173,11 @@ void FiberConnection::HandleCloseEvent() {
     return;
   }
 
+  // Messages on the error queue are consumed first, an error alone carrying nothing else doesn't close the connection.
+  if (OnErrorQueueEvent() && !(GetRecvEvents() & EventType::kHangUpEvent)) {
+    return;
+  }
+
   if (read_mostly_.seldomly_used->error_seen.exchange(true, std::memory_order_relaxed)) {
     TRPC_FMT_ERROR_EVERY_SECOND(
         "FiberConnection::HandleCloseEvent ip {}, port: {}, is_client {}, Unexpected: Multiple `EPOLLERR` received.",
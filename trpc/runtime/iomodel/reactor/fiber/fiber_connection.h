@@ -30,7 +30,8 @@ class alignas(hardware_destructive_interference_size) FiberConnection : public C
   void EnableEvent(int event_type);
 
   /// @brief Register this connection to the reactor
-  void AttachReactor();
+  /// @return true: success, false: the reactor failed to register it, the connection is left detached
+  bool AttachReactor();
 
   /// @brief Get reactor
   Reactor* GetReactor() const { return read_mostly_.reactor; }
@@ -68,6 +69,11 @@ class alignas(hardware_destructive_interference_size) FiberConnection : public C
   ///        you should call `Kill()` in this method
   virtual void OnError(int err) = 0;
 
+  /// @brief Called on error event before it's treated as an error, in the reactor thread.
+  /// @return true if the error queue only carried messages which aren't errors, eg: zero-copy send completions. The
+  ///         event is still treated as an error if the peer hung up.
+  virtual bool OnErrorQueueEvent() { return false; }
+
   /// @brief Stop the connection
   virtual void Stop() {}
 
@@ -16,6 +16,8 @@
 #include "trpc/coroutine/fiber_latch.h"
 #include "trpc/coroutine/fiber_local.h"
 #include "trpc/runtime/fiber_runtime.h"
+#include "trpc/runtime/iomodel/reactor/common/epoll_poller.h"
+#include "trpc/runtime/iomodel/reactor/common/io_uring_poll_poller.h"
 #include "trpc/util/log/logging.h"
 #include "trpc/util/random.h"
 
@@ -30,9 +32,41 @@ std::vector<std::vector<FiberReactorWorker>> fiber_reactor_workers;
 uint32_t reactor_num_per_scheduling_group = 1;
 bool reactor_keep_running = false;
 uint32_t reactor_task_queue_size = 65536;
+std::string reactor_poller_type = "epoll";
+uint32_t reactor_io_uring_entries = 1024;
+uint32_t reactor_io_uring_flags = 0;
+
+namespace {
+
+std::unique_ptr<Poller> CreatePoller(const FiberReactor::Options& options, bool& confined) {
+  confined = false;
+#ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
+  if (options.poller_type == "io_uring_poll") {
+    IoUringPollPoller::Options poller_options;
+    poller_options.entries = options.io_uring_entries;
+    poller_options.flags = options.io_uring_flags;
+
+    auto poller = std::make_unique<IoUringPollPoller>(poller_options);
+    if (poller->Init()) {
+      confined = true;
+      return poller;
+    }
+    TRPC_FMT_WARN("FiberReactor {} failed to init io_uring poll poller, fall back to epoll", options.id);
+  }
+#else
+  if (options.poller_type == "io_uring_poll") {
+    TRPC_FMT_WARN_ONCE("io_uring poll poller is not built in, compile with `trpc_include_async_io`, fall back to epoll");
+  }
+#endif
+
+  return std::make_unique<EPollPoller>();
+}
+
+}  // namespace
 
 FiberReactor::FiberReactor(const Options& options)
     : options_(options),
+      poller_(CreatePoller(options, poller_confined_)),
       task_notifier_(this) {
 }
 
@@ -53,6 +87,8 @@ void FiberReactor::Destroy() {
 void FiberReactor::Run() {
   SetCurrentTlsReactor(nullptr);
 
+  running_fiber_.store(fiber::detail::GetCurrentFiberEntity(), std::memory_order_release);
+
   while (!stopped_.load(std::memory_order_relaxed)) {
     Dispatch();
 
@@ -70,8 +106,21 @@ void FiberReactor::Run() {
   HandleTask();
 }
 
-void FiberReactor::Update(EventHandler* event_handler) {
-  poller_.UpdateEvent(event_handler);
+bool FiberReactor::Update(EventHandler* event_handler) {
+  const void* current = fiber::detail::GetCurrentFiberEntity();
+  if (poller_confined_ && (current == nullptr || running_fiber_.load(std::memory_order_acquire) != current)) {
+    // Only the initial registration (`AttachReactor`) comes from outside the reactor, later changes are made by
+    // reactor tasks. Tasks run in order, so the handler is registered before any change or removal of it.
+    return SubmitTask(
+        [this, event_handler] {
+          if (!poller_->UpdateEvent(event_handler)) {
+            TRPC_FMT_ERROR("FiberReactor {} failed to update events of fd {}", options_.id, event_handler->GetFd());
+          }
+        },
+        Priority::kNormal);
+  }
+
+  return poller_->UpdateEvent(event_handler);
 }
 
 bool FiberReactor::SubmitTask(Task&& task, [[maybe_unused]] Priority priority) {
@@ -95,7 +144,7 @@ bool FiberReactor::CheckTaskQueueSize() {
 }
 
 void FiberReactor::Dispatch() {
-  poller_.Dispatch(Poller::kPollerTimeout);
+  poller_->Dispatch(Poller::kPollerTimeout);
 }
 
 void FiberReactor::HandleTask() {
@@ -163,6 +212,15 @@ void SetReactorTaskQueueSize(uint32_t size) {
   reactor_task_queue_size = size;
 }
 
+void SetReactorPollerType(const std::string& poller_type) {
+  reactor_poller_type = poller_type;
+}
+
+void SetReactorIoUringOptions(uint32_t entries, uint32_t flags) {
+  reactor_io_uring_entries = entries;
+  reactor_io_uring_flags = flags;
+}
+
 uint32_t HashFd(int fd) {
   auto xorshift = [](std::uint64_t n, std::uint64_t i) { return n ^ (n >> i); };
   uint64_t p = 0x5555555555555555;
@@ -186,6 +244,9 @@ void StartAllReactor() {
       FiberReactor::Options options;
       options.id = (static_cast<uint32_t>(sgi) << 16) | rti;
       options.max_task_queue_size = reactor_task_queue_size;
+      options.poller_type = reactor_poller_type;
+      options.io_uring_entries = reactor_io_uring_entries;
+      options.io_uring_flags = reactor_io_uring_flags;
 
       rtw.reactor = std::make_unique<FiberReactor>(options);
       TRPC_ASSERT(rtw.reactor->Initialize());
@@ -16,10 +16,11 @@
 #include <atomic>
 #include <list>
 #include <memory>
+#include <string>
 #include <string_view>
 
 #include "trpc/runtime/iomodel/reactor/common/eventfd_notifier.h"
-#include "trpc/runtime/iomodel/reactor/common/epoll_poller.h"
+#include "trpc/runtime/iomodel/reactor/poller.h"
 #include "trpc/runtime/iomodel/reactor/reactor.h"
 #include "trpc/util/align.h"
 #include "trpc/util/queue/bounded_mpsc_queue.h"
@@ -33,6 +34,15 @@ class alignas(hardware_destructive_interference_size) FiberReactor final : publi
     uint32_t id;
 
     uint32_t max_task_queue_size{65536};
+
+    // Io multiplexing implementation, "epoll" or "io_uring_poll"
+    // "io_uring_poll" takes effect only when built with `trpc_include_async_io`, and falls back to "epoll"
+    // if the kernel does not support it
+    std::string poller_type{"epoll"};
+
+    // parameter for io_uring_queue_init, used by "io_uring_poll" poller
+    uint32_t io_uring_entries{1024};
+    uint32_t io_uring_flags{0};
   };
 
   explicit FiberReactor(const Options& options);
@@ -51,7 +61,7 @@ class alignas(hardware_destructive_interference_size) FiberReactor final : publi
 
   void Destroy() override;
 
-  void Update(EventHandler* event_handler) override;
+  bool Update(EventHandler* event_handler) override;
 
   bool SubmitTask(Task&& task, Priority priority) override;
 
@@ -72,7 +82,14 @@ class alignas(hardware_destructive_interference_size) FiberReactor final : publi
 
   uint64_t poller_timeout_;
 
-  EPollPoller poller_;
+  // Whether `poller_` may only be touched by the reactor fiber, see `Update`
+  // Declared before `poller_`, it is set while `poller_` is being created
+  bool poller_confined_{false};
+
+  std::unique_ptr<Poller> poller_;
+
+  // The fiber running `Run`, set once it starts
+  std::atomic<const void*> running_fiber_{nullptr};
 
   EventFdNotifier task_notifier_;
 
@@ -116,6 +133,12 @@ bool IsReactorKeepRunning();
 /// @brief Set fiber reactor task queue size
 void SetReactorTaskQueueSize(uint32_t size);
 
+/// @brief Set the io multiplexing implementation of fiber reactors, "epoll"(default) or "io_uring_poll"
+void SetReactorPollerType(const std::string& poller_type);
+
+/// @brief Set the io_uring queue size and flags, used when the poller type is "io_uring_poll"
+void SetReactorIoUringOptions(uint32_t entries, uint32_t flags);
+
 }  // namespace fiber
 
 /// @brief Initilize and start running all fiber reactors
@@ -27,6 +27,9 @@ FiberTcpConnection::FiberTcpConnection(Reactor* reactor, const Socket& socket)
     : FiberConnection(reactor), socket_(socket) {
   TRPC_ASSERT(socket_.IsValid());
 
+  zero_copy_send_tracker_ = ZeroCopySendTracker::Create(socket_);
+  writing_buffers_.SetZeroCopySendTracker(zero_copy_send_tracker_.get());
+
   SetFd(socket_.GetFd());
 }
 
@@ -231,14 +234,23 @@ FiberTcpConnection::ReadStatus FiberTcpConnection::ReadData() {
       read_buffer_.buffer.Append(read_buffer_.builder.Seal(n));
 
       if (size_t read = n; read < writable_size) {
+        // Do not keep a large block while waiting for more.
+        read_buffer_.builder.Shrink();
         return ReadStatus::kDrained;
-      } else if (recv_buffer_size != 0 && (total_read += read) >= recv_buffer_size) {
-        return ReadStatus::kPartialRead;
+      } else {
+        // The block has been filled up, size the next read to what is pending in the socket.
+        read_buffer_.builder.Reserve(socket_.GetReadableSize());
+        if (recv_buffer_size != 0 && (total_read += read) >= recv_buffer_size) {
+          return ReadStatus::kPartialRead;
+        }
       }
     } else if (n == 0) {
       return ReadStatus::kRemoteClose;
+    } else if (errno != EAGAIN) {
+      return ReadStatus::kError;
     } else {
-      return errno != EAGAIN ? ReadStatus::kError : ReadStatus::kDrained;
+      read_buffer_.builder.Shrink();
+      return ReadStatus::kDrained;
     }
   }
 }
@@ -358,6 +370,10 @@ void FiberTcpConnection::OnError(int err) {
   Kill(CleanupReason::kError);
 }
 
+bool FiberTcpConnection::OnErrorQueueEvent() {
+  return zero_copy_send_tracker_ && zero_copy_send_tracker_->ReapCompletions(socket_);
+}
+
 void FiberTcpConnection::OnCleanup(CleanupReason reason) {
   TRPC_ASSERT(reason != CleanupReason::kNone);
 
@@ -383,7 +399,9 @@ void FiberTcpConnection::OnCleanup(CleanupReason reason) {
     conn_unavailable_ = true;
     // Requirements: destroy IO-handler before close socket.
     GetIoHandler()->Destroy();
-    socket_.Close();
+    // The kernel may still be sending blocks written with zero-copy, which the tracker holds until completed.
+    writing_buffers_.SetZeroCopySendTracker(nullptr);
+    CloseAfterZeroCopySends(socket_, std::move(zero_copy_send_tracker_));
   }
 }
 
@@ -14,6 +14,7 @@
 #include <memory>
 
 #include "trpc/runtime/iomodel/reactor/common/io_handler.h"
+#include "trpc/runtime/iomodel/reactor/common/zero_copy_send.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_connection.h"
 #include "trpc/runtime/iomodel/reactor/fiber/writing_buffer_list.h"
 
@@ -55,6 +56,7 @@ class FiberTcpConnection final : public FiberConnection {
   EventAction OnReadable() override;
   EventAction OnWritable() override;
   void OnError(int err) override;
+  bool OnErrorQueueEvent() override;
   void OnCleanup(CleanupReason reason) override;
   IoHandler::HandshakeStatus DoHandshake(bool from_on_readable);
   FiberTcpConnection::FlushStatus FlushWritingBuffer(std::size_t max_bytes);
@@ -82,6 +84,9 @@ class FiberTcpConnection final : public FiberConnection {
 
   // Send buffer list
   alignas(hardware_destructive_interference_size) WritingBufferList writing_buffers_;
+
+  // Blocks written with zero-copy, nullptr if zero-copy send is not enabled
+  std::unique_ptr<ZeroCopySendTracker> zero_copy_send_tracker_;
 };
 
 }  // namespace trpc
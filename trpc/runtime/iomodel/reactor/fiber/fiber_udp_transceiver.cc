@@ -12,6 +12,7 @@
 
 #include <limits>
 #include <utility>
+#include <vector>
 
 namespace trpc {
 
@@ -23,6 +24,7 @@ FiberUdpTransceiver::FiberUdpTransceiver(Reactor* reactor, const Socket& socket,
     socket_.SetReusePort();
   }
   socket_.SetBlock(false);
+  InitUdpBatchIo(socket_);
   SetFd(socket_.GetFd());
 }
 
@@ -122,47 +124,54 @@ void FiberUdpTransceiver::Join() {
 FiberConnection::EventAction FiberUdpTransceiver::OnReadable() {
   read_buffer_.Clear();
 
-  while (true) {
-    thread_local char recv_buffer[kUdpBuffSize] = {0};
-
-    NetworkAddress peer_addr;
-    int read = socket_.RecvFrom(static_cast<void*>(recv_buffer), kUdpBuffSize, 0, &peer_addr);
+  const std::size_t batch_size = GetUdpBatchIoOptions().recv_batch_size;
+  bool stop_reading = false;
+  while (!stop_reading) {
+    received_datagrams_.clear();
+    int read = RecvDatagrams(socket_, batch_size, received_datagrams_);
     if (read < 0) {
-      if (errno == EAGAIN) {
-        break;
-      } else {
+      if (errno != EAGAIN) {
         TRPC_LOG_ERROR("FiberUdpTransceiver::OnReadable read datagram error, fd:"
                        << socket_.GetFd() << ", conn_id:" << this->GetConnId() << ", is_client:" << IsClient()
                        << ", ip:" << GetPeerIp() << ", port:" << GetPeerPort() << ", errno:" << errno);
-        // only discard the packet received, no need to close the socket
-        return EventAction::kReady;
       }
+      break;
     }
 
-    SetPeerIp(peer_addr.Ip());
-    SetPeerPort(peer_addr.Port());
-    TRPC_ASSERT(static_cast<uint32_t>(read) <= kUdpBuffSize);
-    read_buffer_.Append(CreateBufferSlow(recv_buffer, read));
-
     RefPtr ref(ref_ptr, this);
-    std::deque<std::any> data;
-    int checker_ret = GetConnectionHandler()->CheckMessage(ref, read_buffer_, data);
-    if (checker_ret == kPacketFull) {
-      bool handle_ret = GetConnectionHandler()->HandleMessage(ref, data);
-      if (!handle_ret) {
-        TRPC_LOG_ERROR("FiberUdpTransceiver::OnReadable MessageHandle error, fd:"
+    // Datagrams already taken out of the socket are all handled, even if one of them fails.
+    for (auto& datagram : received_datagrams_) {
+      SetPeerIp(datagram.peer.Ip());
+      SetPeerPort(datagram.peer.Port());
+      read_buffer_.Append(std::move(datagram.payload));
+
+      std::deque<std::any> data;
+      int checker_ret = GetConnectionHandler()->CheckMessage(ref, read_buffer_, data);
+      if (checker_ret == kPacketFull) {
+        bool handle_ret = GetConnectionHandler()->HandleMessage(ref, data);
+        if (!handle_ret) {
+          TRPC_LOG_ERROR("FiberUdpTransceiver::OnReadable MessageHandle error, fd:"
+                         << socket_.GetFd() << ", conn_id:" << this->GetConnId() << ", is_client:" << IsClient()
+                         << ", ip:" << GetPeerIp() << ", port:" << GetPeerPort());
+          stop_reading = true;
+        }
+      } else if (checker_ret == kPacketError) {
+        TRPC_LOG_ERROR("FiberUdpTransceiver::OnReadable check error, fd:"
                        << socket_.GetFd() << ", conn_id:" << this->GetConnId() << ", is_client:" << IsClient()
                        << ", ip:" << GetPeerIp() << ", port:" << GetPeerPort());
-        break;
+        // only discard the packet received, no need to close the socket
+        read_buffer_.Clear();
+        stop_reading = true;
       }
-    } else if (checker_ret == kPacketError) {
-      TRPC_LOG_ERROR("FiberUdpTransceiver::OnReadable check error, fd:"
-                     << socket_.GetFd() << ", conn_id:" << this->GetConnId() << ", is_client:" << IsClient()
-                     << ", ip:" << GetPeerIp() << ", port:" << GetPeerPort());
-      // only discard the packet received, no need to close the socket
-      return EventAction::kReady;
+    }
+
+    // The socket has been drained.
+    if (static_cast<std::size_t>(read) < batch_size) {
+      break;
     }
   }
+  received_datagrams_.clear();
+
   return EventAction::kReady;
 }
 
@@ -12,8 +12,10 @@
 
 #include <deque>
 #include <memory>
+#include <vector>
 
 #include "trpc/runtime/iomodel/reactor/common/network_address.h"
+#include "trpc/runtime/iomodel/reactor/common/udp_batch_io.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_connection.h"
 #include "trpc/runtime/iomodel/reactor/fiber/writing_datagram_list.h"
 
@@ -58,15 +60,15 @@ class FiberUdpTransceiver final : public FiberConnection {
   // bytes. So the maximum length of a udp packet is 2^16 - 1 - 8 - 20 = 65507 bytes.)
   static constexpr uint32_t kMaxUdpBodySize = 65507;
 
-  // Size of udp buff
-  static constexpr uint32_t kUdpBuffSize = 64 * 1024;
-
   // The maximum number of udp packets that can be sent with each call to Send()
   std::size_t max_writes_percall_ = 64;
 
   // Recv buffer
   NoncontiguousBuffer read_buffer_;
 
+  // Datagrams received by the current read, kept to reuse the memory
+  std::vector<ReceivedDatagram> received_datagrams_;
+
   WritingDatagramList write_list_;
 
   // Listening address
@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <climits>
 #include <limits>
+#include <optional>
 #include <utility>
 
 #include "trpc/util/chrono/chrono.h"
@@ -108,12 +109,16 @@ ssize_t WritingBufferList::FlushTo(IoHandler* io, ConnectionHandler* conn_handle
     flushing -= diff;
   }
 
-  ssize_t rc = io->Writev(iov, nv);
+  std::optional<uint32_t> zero_copy_id;
+  ssize_t rc = WritevMaybeZeroCopy(io, zero_copy_tracker_, iov, nv, flushing, &zero_copy_id);
   if (rc < 0 || (rc == 0 && flushing > 0)) {
     return rc;  // Nothing is really flushed then.
   }
   TRPC_ASSERT(static_cast<std::size_t>(rc) <= flushing);
 
+  // The blocks written with zero-copy are still referenced by the kernel, they're moved here instead of being freed.
+  NoncontiguousBuffer zero_copy_written;
+
   // We did write something out. Remove those buffers and update the result accordingly.
   auto flushed = static_cast<std::size_t>(rc);
   bool drained = false;
@@ -131,6 +136,9 @@ ssize_t WritingBufferList::FlushTo(IoHandler* io, ConnectionHandler* conn_handle
       object_pool::LwUniquePtr<Node> destroying;
       destroying.Reset(current);  // To be freed.
       flushed -= b;
+      if (zero_copy_id) {
+        zero_copy_written.Append(std::move(current->buffer));
+      }
 
       conn_handler->MessageWriteDone(current->io_msg);
       conn_handler->SetCurrentContextExt(current->io_msg.context_ext);
@@ -166,13 +174,21 @@ ssize_t WritingBufferList::FlushTo(IoHandler* io, ConnectionHandler* conn_handle
         current = next;
       }
     } else {
-      current->buffer.Skip(flushed);
+      if (zero_copy_id) {
+        zero_copy_written.Append(current->buffer.Cut(flushed));
+      } else {
+        current->buffer.Skip(flushed);
+      }
       // We didn't drain the list, set `head_` to where we left off.
       head_.store(current, std::memory_order_release);
       break;
     }
   }
 
+  if (zero_copy_id) {
+    zero_copy_tracker_->Hold(*zero_copy_id, std::move(zero_copy_written));
+  }
+
   *emptied = drained;
   *short_write = (static_cast<std::size_t>(rc) != flushing);
   return rc;
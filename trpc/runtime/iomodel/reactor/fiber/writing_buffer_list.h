@@ -17,6 +17,7 @@
 #include "trpc/runtime/iomodel/reactor/common/connection_handler.h"
 #include "trpc/runtime/iomodel/reactor/common/io_handler.h"
 #include "trpc/runtime/iomodel/reactor/common/io_message.h"
+#include "trpc/runtime/iomodel/reactor/common/zero_copy_send.h"
 #include "trpc/util/align.h"
 #include "trpc/util/buffer/noncontiguous_buffer.h"
 
@@ -59,6 +60,10 @@ class alignas(hardware_destructive_interference_size) WritingBufferList {
 
   size_t Size() { return size_; }
 
+  /// @brief Send large writes with zero-copy, the blocks written are handed over to `tracker` until the kernel is done
+  ///        with them
+  void SetZeroCopySendTracker(ZeroCopySendTracker* tracker) { zero_copy_tracker_ = tracker; }
+
  private:
   struct Node {
     std::atomic<Node*> next;
@@ -75,6 +80,8 @@ class alignas(hardware_destructive_interference_size) WritingBufferList {
   alignas(hardware_destructive_interference_size) std::atomic<Node*> tail_{nullptr};
   std::atomic<size_t> size_{0};
 
+  ZeroCopySendTracker* zero_copy_tracker_{nullptr};
+
   FiberMutex mutex_;
   FiberConditionVariable writable_cv_;
   std::atomic<bool> stop_token_{false};
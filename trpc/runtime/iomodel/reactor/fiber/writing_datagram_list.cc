@@ -11,10 +11,11 @@
 #include "trpc/runtime/iomodel/reactor/fiber/writing_datagram_list.h"
 
 #include <algorithm>
-#include <climits>
-#include <string>
+#include <cerrno>
 #include <utility>
 
+#include "trpc/util/container/small_vector.h"
+
 namespace trpc {
 
 ssize_t WritingDatagramList::FlushTo(Socket& socket, ConnectionHandler* conn_handler, bool* emptied) {
@@ -24,46 +25,44 @@ ssize_t WritingDatagramList::FlushTo(Socket& socket, ConnectionHandler* conn_han
     return 0;
   }
 
-  // Pop the packet from the queue first to reduce the granularity of the lock
-  auto [to, temp_io_msg] = std::move(list_.front());
-  list_.pop_front();
+  // Pop a batch of packets from the queue first to reduce the granularity of the lock, the batch is bounded so that
+  // it's kept on the stack.
+  std::size_t num = std::min(GetUdpBatchIoOptions().send_batch_size, list_.size());
+  container::SmallVector<std::tuple<NetworkAddress, IoMessage>, kMaxUdpBatchSize> sending;
+  for (std::size_t i = 0; i != num; ++i) {
+    sending.emplace_back(std::move(list_.front()));
+    list_.pop_front();
+  }
   lk.unlock();
 
-  thread_local iovec iov[IOV_MAX];
-  std::size_t nv = 0;
-  // Used for highly fragmented situations
-  std::string flatten;
+  OutgoingDatagram datagrams[kMaxUdpBatchSize];
+  for (std::size_t i = 0; i != num; ++i) {
+    auto& [to, io_msg] = sending[i];
+    datagrams[i] = OutgoingDatagram{&to, &io_msg.buffer};
+  }
 
-  if (TRPC_UNLIKELY(temp_io_msg.buffer.size() > IOV_MAX)) {  // highly fragmented
-    TRPC_LOG_WARN("msg is highly fragmented and cannot be handled by `iovec`s. Flattening.");
-    flatten = FlattenSlow(temp_io_msg.buffer);
-    auto&& v = iov[0];
-    nv = 1;
-    v.iov_base = const_cast<char*>(flatten.data());
-    v.iov_len = flatten.size();
-  } else {
-    for (auto bi = temp_io_msg.buffer.begin(); bi != temp_io_msg.buffer.end(); ++bi) {
-      auto&& b = *bi;
-      auto&& e = iov[nv++];
-      e.iov_base = const_cast<char*>(b.data());
-      e.iov_len = b.size();
+  int sent = SendDatagrams(socket, datagrams, num);
+  // The packet failed with an error other than a full system buffer is discarded, so that it's not retried forever.
+  std::size_t requeue_from = sent >= 0 ? sent : (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR ? 0 : 1);
+  if (requeue_from < num) {
+    // Put the packets not sent back to the head of the queue, in their original order.
+    lk.lock();
+    for (std::size_t i = num; i != requeue_from; --i) {
+      list_.emplace_front(std::move(sending[i - 1]));
     }
+    lk.unlock();
   }
-
-  msghdr msg = {.msg_name = const_cast<void*>(reinterpret_cast<const void*>(to.SockAddr())),
-                .msg_namelen = to.Socklen(),
-                .msg_iov = iov,
-                .msg_iovlen = nv,
-                .msg_control = nullptr,
-                .msg_controllen = 0,
-                .msg_flags = 0};
-  auto rc = socket.SendMsg(&msg);
-  if (rc <= 0) {
-    return rc;
+  if (sent <= 0) {
+    return sent;
   }
 
-  conn_handler->MessageWriteDone(temp_io_msg);
-  return rc;
+  ssize_t bytes = 0;
+  for (int i = 0; i != sent; ++i) {
+    auto& io_msg = std::get<1>(sending[i]);
+    bytes += io_msg.buffer.ByteSize();
+    conn_handler->MessageWriteDone(io_msg);
+  }
+  return bytes;
 }
 
 bool WritingDatagramList::Append(NetworkAddress to, IoMessage&& io_msg) {
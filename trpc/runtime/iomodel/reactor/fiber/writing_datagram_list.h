@@ -17,6 +17,7 @@
 #include "trpc/runtime/iomodel/reactor/common/io_message.h"
 #include "trpc/runtime/iomodel/reactor/common/network_address.h"
 #include "trpc/runtime/iomodel/reactor/common/socket.h"
+#include "trpc/runtime/iomodel/reactor/common/udp_batch_io.h"
 #include "trpc/util/buffer/noncontiguous_buffer.h"
 
 namespace trpc {
@@ -24,11 +25,11 @@ namespace trpc {
 /// @brief A writing datagram list using with lock which is thread-safe
 class WritingDatagramList {
  public:
-  /// @brief Send udp packet
+  /// @brief Send a batch of udp packets, at most `send_batch_size` of `UdpBatchIoOptions`, in one call
   /// @param socket the socket to send data
   /// @param conn_handler connection handler
   /// @param emptied whether the data has all been sent
-  /// @return ssize_t the size of the data that has been sent
+  /// @return ssize_t the size of the data that has been sent, packets not sent are kept at the head of the list
   ssize_t FlushTo(Socket& socket, ConnectionHandler* conn_handler, bool* emptied);
 
   /// @brief Append the udp packet to be sent to the tail of the list
@@ -59,18 +59,15 @@ TEST(WritingDatagramList, Normal) {
 
   bool emptied;
   MockConnHanlder mock_handler;
+  // Both packets are sent in one batch.
   ssize_t send_size = wdl.FlushTo(send_socket, &mock_handler, &emptied);
-  ASSERT_EQ(1111, send_size);
+  ASSERT_EQ(1111 + 2222, send_size);
   ASSERT_FALSE(emptied);
   constexpr uint32_t kUdpBuffSize = 64 * 1024;
   char recv_buffer[kUdpBuffSize];
   NetworkAddress peer_addr;
   int recv_size = recv_socket.RecvFrom(recv_buffer, kUdpBuffSize, 0, &peer_addr);
   ASSERT_EQ(1111, recv_size);
-
-  send_size = wdl.FlushTo(send_socket, &mock_handler, &emptied);
-  ASSERT_EQ(2222, send_size);
-  ASSERT_FALSE(emptied);
   recv_size = recv_socket.RecvFrom(recv_buffer, kUdpBuffSize, 0, &peer_addr);
   ASSERT_EQ(2222, recv_size);
 
@@ -94,4 +91,40 @@ TEST(WritingDatagramList, Normal) {
   ASSERT_TRUE(emptied);
 }
 
+TEST(WritingDatagramList, BatchSize) {
+  UdpBatchIoOptions options = GetUdpBatchIoOptions();
+  UdpBatchIoOptions batch_options = options;
+  batch_options.send_batch_size = 2;
+  SetUdpBatchIoOptions(batch_options);
+
+  uint16_t recv_port = trpc::util::GenRandomAvailablePort();
+  Socket recv_socket = Socket::CreateUdpSocket(false);
+  Socket send_socket = Socket::CreateUdpSocket(false);
+  NetworkAddress recv_addr("127.0.0.1", recv_port, NetworkAddress::IpType::kIpV4);
+  recv_socket.Bind(recv_addr);
+
+  WritingDatagramList wdl;
+  for (std::size_t i = 1; i <= 3; ++i) {
+    IoMessage io_msg;
+    io_msg.buffer = CreateBufferSlow(std::string(i * 100, 'x'));
+    ASSERT_TRUE(wdl.Append(recv_addr, std::move(io_msg)));
+  }
+
+  bool emptied = false;
+  MockConnHanlder mock_handler;
+  ASSERT_EQ(100 + 200, wdl.FlushTo(send_socket, &mock_handler, &emptied));
+  ASSERT_EQ(300, wdl.FlushTo(send_socket, &mock_handler, &emptied));
+  ASSERT_EQ(0, wdl.FlushTo(send_socket, &mock_handler, &emptied));
+  ASSERT_TRUE(emptied);
+
+  // Packets arrive in the order they were appended.
+  char recv_buffer[1024];
+  NetworkAddress peer_addr;
+  for (int i = 1; i <= 3; ++i) {
+    ASSERT_EQ(i * 100, recv_socket.RecvFrom(recv_buffer, sizeof(recv_buffer), 0, &peer_addr));
+  }
+
+  SetUdpBatchIoOptions(options);
+}
+
 }  // namespace trpc::testing
@@ -38,7 +38,8 @@ class Poller {
 
   /// @brief Update the event status of eventhandler
   /// @param event_handler The concrete subclass pointer of EventHandler
-  virtual void UpdateEvent(EventHandler* event_handler) = 0;
+  /// @return true: success, false: the change could not be applied to the poller
+  virtual bool UpdateEvent(EventHandler* event_handler) = 0;
 
   /// @brief Set the callback function to be executed immediately
   ///        after `Dispatch` waits for completion
@@ -79,7 +79,8 @@ class Reactor {
   virtual void Destroy() = 0;
 
   /// @brief Add/Delete/Modify the EventHandler in epoll
-  virtual void Update(EventHandler* event_handler) = 0;
+  /// @return bool true: success (or queued to the reactor), false: failed
+  virtual bool Update(EventHandler* event_handler) = 0;
 
   /// @brief Submit task to the reactor(thread safe), the difference with SubmitTask2
   ///        is that this interface always puts task in the queue
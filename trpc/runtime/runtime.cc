@@ -17,6 +17,8 @@
 #include "trpc/coroutine/fiber.h"
 #include "trpc/runtime/common/periphery_task_scheduler.h"
 #include "trpc/runtime/fiber_runtime.h"
+#include "trpc/runtime/iomodel/reactor/common/udp_batch_io.h"
+#include "trpc/runtime/iomodel/reactor/common/zero_copy_send.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_reactor.h"
 #include "trpc/runtime/merge_runtime.h"
 #include "trpc/runtime/separate_runtime.h"
@@ -84,6 +86,10 @@ bool StartRuntime() {
   memory_pool::SetMemBlockSize(buffer_pool_config.block_size);
   memory_pool::SetMemPoolThreshold(buffer_pool_config.mem_pool_threshold);
 
+  InitUdpBatchIoConfig();
+
+  InitZeroCopySendConfig();
+
   internal::TimeKeeper::Instance()->Start();
 
   if (IsInFiberRuntime()) {
@@ -176,6 +182,26 @@ void InitFiberReactorConfig() {
   }
 
   fiber::SetReactorTaskQueueSize(conf.reactor_task_queue_size);
+  fiber::SetReactorPollerType(conf.reactor_poller_type);
+  fiber::SetReactorIoUringOptions(conf.reactor_io_uring_entries, conf.reactor_io_uring_flags);
+}
+
+void InitUdpBatchIoConfig() {
+  const UdpIoConfig& udp_io_config = TrpcConfig::GetInstance()->GetGlobalConfig().udp_io_config;
+  UdpBatchIoOptions udp_batch_io_options;
+  udp_batch_io_options.recv_batch_size = udp_io_config.recv_batch_size;
+  udp_batch_io_options.send_batch_size = udp_io_config.send_batch_size;
+  udp_batch_io_options.enable_gso = udp_io_config.enable_gso;
+  udp_batch_io_options.enable_gro = udp_io_config.enable_gro;
+  SetUdpBatchIoOptions(udp_batch_io_options);
+}
+
+void InitZeroCopySendConfig() {
+  const ZeroCopySendConfig& zero_copy_send_config = TrpcConfig::GetInstance()->GetGlobalConfig().zero_copy_send_config;
+  ZeroCopySendOptions zero_copy_send_options;
+  zero_copy_send_options.enable = zero_copy_send_config.enable;
+  zero_copy_send_options.min_bytes = zero_copy_send_config.min_bytes;
+  SetZeroCopySendOptions(zero_copy_send_options);
 }
 
 }  // namespace trpc::runtime
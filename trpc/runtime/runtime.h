@@ -57,4 +57,12 @@ void TerminateRuntime();
 /// @private
 void InitFiberReactorConfig();
 
+/// @brief framework use. Init udp batch io config
+/// @private
+void InitUdpBatchIoConfig();
+
+/// @brief framework use. Init zero-copy send config
+/// @private
+void InitZeroCopySendConfig();
+
 }  // namespace trpc::runtime
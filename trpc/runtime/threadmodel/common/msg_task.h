@@ -15,6 +15,7 @@
 
 #include <cstdint>
 
+#include "trpc/runtime/threadmodel/common/task_priority.h"
 #include "trpc/runtime/threadmodel/common/task_type.h"
 #include "trpc/util/function.h"
 #include "trpc/util/object_pool/object_pool.h"
@@ -38,6 +39,9 @@ struct MsgTask {
   /// thread model for processing is selected.
   int32_t dst_thread_key = -1;
 
+  /// scheduling priority of the task, only honored by the fiber thread model.
+  runtime::TaskPriority priority = runtime::TaskPriority::kNormal;
+
   /// related parameters for task processing
   void* param = nullptr;
 
@@ -0,0 +1,36 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace trpc::runtime {
+
+/// @brief Scheduling priority of a task. Tasks of a higher priority are picked up first when several are ready, tasks
+///        of a lower priority are delayed but never starved.
+/// @note Only honored by the fiber threading model so far, others treat all tasks alike.
+enum class TaskPriority : uint8_t {
+  /// @brief Latency-critical work, e.g. health checks, admin requests.
+  kHigh = 0,
+  /// @brief Default priority.
+  kNormal = 1,
+  /// @brief Bulk work which may be delayed under load.
+  kLow = 2,
+};
+
+/// @brief Number of task priorities, usable as the size of an array indexed by `TaskPriority`.
+constexpr std::size_t kTaskPriorityNum = 3;
+
+}  // namespace trpc::runtime
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "trpc/runtime/threadmodel/fiber/detail/runnable_entity.h"
+#include "trpc/runtime/threadmodel/common/task_priority.h"
 #include "trpc/util/align.h"
 #include "trpc/util/function.h"
 #include "trpc/util/object_pool/object_pool_ptr.h"
@@ -40,6 +41,7 @@ struct alignas(hardware_destructive_interference_size) FiberDesc
   std::uint64_t last_ready_tsc;
   bool scheduling_group_local;
   bool is_fiber_reactor = false;
+  runtime::TaskPriority priority = runtime::TaskPriority::kNormal;
 
   FiberDesc();
 };
@@ -268,6 +268,7 @@ FiberEntity* InstantiateFiberEntity(SchedulingGroup* sg, FiberDesc* desc) noexce
   fiber->last_ready_tsc = desc->last_ready_tsc;
   fiber->scheduling_group_local = desc->scheduling_group_local;
   fiber->is_fiber_reactor = desc->is_fiber_reactor;
+  fiber->priority = desc->priority;
 
 #ifdef TRPC_INTERNAL_USE_ASAN
   fiber->asan_stack_bottom = stack;
@@ -152,6 +152,10 @@ struct alignas(hardware_destructive_interference_size) FiberEntity
   // is reactor fiber
   bool is_fiber_reactor = false;
 
+  // Which ready queue of the scheduling group the fiber is put in whenever it
+  // becomes ready.
+  runtime::TaskPriority priority = runtime::TaskPriority::kNormal;
+
   // Set if there is a pending `ResumeOn`. Cleared once `ResumeOn` completes.
   Function<void()> resume_proc = nullptr;
 
@@ -0,0 +1,69 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "trpc/runtime/threadmodel/common/task_priority.h"
+
+namespace trpc::fiber::detail {
+
+/// @brief Decides in which order a worker tries the per-priority ready queues of its scheduling group.
+///        Higher priority queues are tried first, except that every `kNormalTurn`-th pick starts from the normal
+///        queue and every `kLowTurn`-th pick starts from the low queue. So a backlog of higher priority fibers delays
+///        lower priority ones, but never starves them.
+/// @note Not thread-safe, each worker keeps its own picker.
+class PriorityPicker {
+ public:
+  static constexpr std::uint32_t kNormalTurn = 8;
+  static constexpr std::uint32_t kLowTurn = 64;
+
+  /// @brief Call `pop(priority)` on the queues in the order of this pick until one of them returns non-null.
+  /// @return What `pop` returned last, null if all the queues are empty.
+  template <class F>
+  auto Pick(F&& pop) noexcept {
+    auto first = GetFirst();
+    auto rc = pop(first);
+    for (std::size_t i = 0; !rc && i != runtime::kTaskPriorityNum; ++i) {
+      auto priority = static_cast<runtime::TaskPriority>(i);
+      if (priority != first) {
+        rc = pop(priority);
+      }
+    }
+    // Only successful picks take turns, polling empty queues does not.
+    if (rc) {
+      ++picks_;
+    }
+    return rc;
+  }
+
+  /// @brief Get the priority whose queue is tried first on the next pick.
+  runtime::TaskPriority GetFirst() const noexcept {
+    // Both turns are powers of two, so they stay in step when `picks_` wraps around.
+    auto next = picks_ + 1;
+    if (next % kLowTurn == 0) {
+      return runtime::TaskPriority::kLow;
+    }
+    if (next % kNormalTurn == 0) {
+      return runtime::TaskPriority::kNormal;
+    }
+    return runtime::TaskPriority::kHigh;
+  }
+
+ private:
+  std::uint32_t picks_ = 0;
+};
+
+}  // namespace trpc::fiber::detail
@@ -0,0 +1,102 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/threadmodel/fiber/detail/scheduling/priority_picker.h"
+
+#include <array>
+#include <deque>
+
+#include "gtest/gtest.h"
+
+namespace trpc::fiber::detail {
+
+namespace {
+
+using runtime::TaskPriority;
+
+struct Queues {
+  std::array<std::deque<int>, runtime::kTaskPriorityNum> queues;
+
+  void Fill(TaskPriority priority, std::size_t n) {
+    queues[static_cast<std::size_t>(priority)].resize(n, static_cast<int>(priority));
+  }
+
+  // Returns the priority popped plus one, or 0 if the queue is empty.
+  int Pop(TaskPriority priority) {
+    auto&& q = queues[static_cast<std::size_t>(priority)];
+    if (q.empty()) {
+      return 0;
+    }
+    int rc = q.front() + 1;
+    q.pop_front();
+    return rc;
+  }
+};
+
+}  // namespace
+
+TEST(PriorityPicker, HigherPriorityFirst) {
+  PriorityPicker picker;
+  Queues queues;
+  queues.Fill(TaskPriority::kLow, 1);
+  queues.Fill(TaskPriority::kNormal, 1);
+  queues.Fill(TaskPriority::kHigh, 1);
+
+  auto pop = [&](TaskPriority p) { return queues.Pop(p); };
+  EXPECT_EQ(static_cast<int>(TaskPriority::kHigh) + 1, picker.Pick(pop));
+  EXPECT_EQ(static_cast<int>(TaskPriority::kNormal) + 1, picker.Pick(pop));
+  EXPECT_EQ(static_cast<int>(TaskPriority::kLow) + 1, picker.Pick(pop));
+  EXPECT_EQ(0, picker.Pick(pop));
+}
+
+TEST(PriorityPicker, NoStarvation) {
+  constexpr std::size_t kRounds = 100;
+  constexpr std::size_t kPicks = kRounds * PriorityPicker::kLowTurn;
+
+  PriorityPicker picker;
+  Queues queues;
+  queues.Fill(TaskPriority::kLow, kPicks);
+  queues.Fill(TaskPriority::kNormal, kPicks);
+  queues.Fill(TaskPriority::kHigh, kPicks);
+
+  std::array<std::size_t, runtime::kTaskPriorityNum> picked{};
+  for (std::size_t i = 0; i != kPicks; ++i) {
+    int rc = picker.Pick([&](TaskPriority p) { return queues.Pop(p); });
+    ASSERT_NE(0, rc);
+    ++picked[rc - 1];
+  }
+
+  constexpr auto kNormalPerRound = PriorityPicker::kLowTurn / PriorityPicker::kNormalTurn - 1;
+  EXPECT_EQ(kRounds, picked[static_cast<std::size_t>(TaskPriority::kLow)]);
+  EXPECT_EQ(kRounds * kNormalPerRound, picked[static_cast<std::size_t>(TaskPriority::kNormal)]);
+  EXPECT_EQ(kPicks - kRounds * (kNormalPerRound + 1), picked[static_cast<std::size_t>(TaskPriority::kHigh)]);
+}
+
+TEST(PriorityPicker, EmptyQueuesDoNotTakeTurns) {
+  PriorityPicker picker;
+  Queues queues;
+  auto pop = [&](TaskPriority p) { return queues.Pop(p); };
+
+  for (std::size_t i = 0; i != PriorityPicker::kLowTurn * 2; ++i) {
+    ASSERT_EQ(0, picker.Pick(pop));
+  }
+  EXPECT_EQ(TaskPriority::kHigh, picker.GetFirst());
+
+  queues.Fill(TaskPriority::kLow, PriorityPicker::kNormalTurn);
+  for (std::size_t i = 0; i != PriorityPicker::kNormalTurn - 1; ++i) {
+    ASSERT_EQ(static_cast<int>(TaskPriority::kLow) + 1, picker.Pick(pop));
+  }
+  EXPECT_EQ(TaskPriority::kNormal, picker.GetFirst());
+}
+
+}  // namespace trpc::fiber::detail
@@ -13,6 +13,7 @@
 
 #include "trpc/runtime/threadmodel/fiber/detail/scheduling/scheduling.h"
 
+#include <algorithm>
 #include <unordered_map>
 
 #include "trpc/runtime/threadmodel/fiber/detail/scheduling/v1/scheduling_impl.h"
@@ -41,6 +42,10 @@ uint32_t GetFiberRunQueueSize() {
   return trpc_fiber_run_queue_size;
 }
 
+uint32_t GetFiberPriorityRunQueueSize() {
+  return std::max<uint32_t>(trpc_fiber_run_queue_size / 8, 2);
+}
+
 void InitSchedulingImp() {
   SchedulingCreateFunction func_v1 = []() -> std::unique_ptr<Scheduling> {
     return std::make_unique<v1::SchedulingImpl>();
@@ -117,6 +117,9 @@ class alignas(hardware_destructive_interference_size) Scheduling {
 void SetFiberRunQueueSize(uint32_t queue_size);
 // Get the size of the fiber's run queue.
 uint32_t GetFiberRunQueueSize();
+// Get the size of the fiber's run queues of high and low priority. Such fibers are expected to be the minority, so the
+// queues only hold a fraction of the normal one, fibers overflowing them are spilled into the normal one.
+uint32_t GetFiberPriorityRunQueueSize();
 
 using SchedulingCreateFunction = Function<std::unique_ptr<Scheduling>()>;
 
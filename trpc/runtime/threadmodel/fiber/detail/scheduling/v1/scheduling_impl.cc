@@ -15,6 +15,7 @@
 #include <sys/syscall.h>
 #include <sys/wait.h>
 
+#include <algorithm>
 #include <climits>
 #include <memory>
 #include <string>
@@ -62,13 +63,17 @@ void SchedulingImpl::WaitSlot::PersistentWake() noexcept {
 
 FiberEntity* const kSchedulingGroupShuttingDown = reinterpret_cast<FiberEntity*>(0x1);
 thread_local std::size_t SchedulingImpl::worker_index_ = kUninitializedWorkerIndex;
+thread_local PriorityPicker SchedulingImpl::picker_;
 
 bool SchedulingImpl::Init(SchedulingGroup* scheduling_group,
                           std::size_t scheduling_group_size) noexcept {
   scheduling_group_ = scheduling_group;
   group_size_ = scheduling_group_size;
 
-  TRPC_ASSERT(run_queue_.Init(GetFiberRunQueueSize()));
+  for (std::size_t i = 0; i != runtime::kTaskPriorityNum; ++i) {
+    bool normal = static_cast<runtime::TaskPriority>(i) == runtime::TaskPriority::kNormal;
+    TRPC_ASSERT(run_queues_[i].Init(normal ? GetFiberRunQueueSize() : GetFiberPriorityRunQueueSize()));
+  }
 
   wait_slots_ = std::make_unique<WaitSlot[]>(group_size_);
 
@@ -142,7 +147,7 @@ void SchedulingImpl::Schedule() noexcept {
 
     fiber->Resume();
 
-    // HeartBeat(run_queue_.UnsafeSize());
+    // HeartBeat(GetFiberQueueSize());
   }
 }
 
@@ -151,7 +156,7 @@ void SchedulingImpl::Leave() noexcept {
 }
 
 FiberEntity* SchedulingImpl::AcquireFiber() noexcept {
-  if (auto rc = GetOrInstantiateFiber(run_queue_.Pop())) {
+  if (auto rc = GetOrInstantiateFiber(PopRunnableEntity())) {
     {
       // Acquiring the lock here guarantees us anyone who is working on this fiber
       // (with the lock held) has done its job before we returning it to the
@@ -196,7 +201,7 @@ FiberEntity* SchedulingImpl::SpinningAcquireFiber() noexcept {
 
   if (need_spin) {
     static constexpr auto kMaximumCyclesToSpin = 10'000;
-    // Wait for some time between touching `run_queue_` to reduce contention.
+    // Wait for some time between touching `run_queues_` to reduce contention.
     static constexpr auto kCyclesBetweenRetry = 1000;
     auto start = ReadTsc(), end = start + kMaximumCyclesToSpin;
 
@@ -291,7 +296,13 @@ FiberEntity* SchedulingImpl::WaitForFiber() noexcept {
 }
 
 FiberEntity* SchedulingImpl::RemoteAcquireFiber() noexcept {
-  if (auto rc = GetOrInstantiateFiber(run_queue_.Steal())) {
+  // Foreign workers only take our spare work, so they always honor priorities strictly.
+  RunnableEntity* entity = nullptr;
+  for (std::size_t i = 0; !entity && i != runtime::kTaskPriorityNum; ++i) {
+    entity = run_queues_[i].Steal();
+  }
+
+  if (auto rc = GetOrInstantiateFiber(entity)) {
     std::scoped_lock _(rc->scheduler_lock);
 
     TRPC_CHECK(rc->state == FiberState::Ready);
@@ -319,9 +330,13 @@ FiberEntity* SchedulingImpl::GetOrInstantiateFiber(RunnableEntity* entity) noexc
   return static_cast<FiberEntity*>(entity);
 }
 
+RunnableEntity* SchedulingImpl::PopRunnableEntity() noexcept {
+  return picker_.Pick([this](runtime::TaskPriority priority) { return GetRunQueue(priority).Pop(); });
+}
+
 bool SchedulingImpl::StartFiber(FiberDesc* desc) noexcept {
   desc->last_ready_tsc = ReadTsc();
-  return QueueRunnableEntity(desc, desc->scheduling_group_local);
+  return QueueRunnableEntity(desc, desc->priority, desc->scheduling_group_local);
 }
 
 void SchedulingImpl::StartFibers(FiberDesc** start, FiberDesc** end) noexcept {
@@ -334,12 +349,29 @@ void SchedulingImpl::StartFibers(FiberDesc** start, FiberDesc** end) noexcept {
     (*iter)->last_ready_tsc = tsc;
   }
 
-  auto s1 = reinterpret_cast<RunnableEntity**>(start),
-       s2 = reinterpret_cast<RunnableEntity**>(end);
-  if (TRPC_UNLIKELY(!run_queue_.BatchPush(s1, s2, false))) {
+  // Push each run of fibers of the same priority in batch.
+  for (auto iter = start; iter != end;) {
+    auto priority = (*iter)->priority;
+    auto run_end = std::find_if(iter, end, [&](FiberDesc* desc) { return desc->priority != priority; });
+    QueueRunnableEntities(reinterpret_cast<RunnableEntity**>(iter), reinterpret_cast<RunnableEntity**>(run_end),
+                          priority);
+    iter = run_end;
+  }
+
+  WakeUpWorkers(end - start);
+}
+
+void SchedulingImpl::QueueRunnableEntities(RunnableEntity** start, RunnableEntity** end,
+                                           runtime::TaskPriority priority) noexcept {
+  if (TRPC_UNLIKELY(!GetRunQueue(priority).BatchPush(start, end, false))) {
+    if (priority != runtime::TaskPriority::kNormal) {
+      QueueRunnableEntities(start, end, runtime::TaskPriority::kNormal);
+      return;
+    }
+
     auto since = ReadSteadyClock();
 
-    while (!run_queue_.BatchPush(s1, s2, false)) {
+    while (!GetRunQueue(priority).BatchPush(start, end, false)) {
       TRPC_FMT_INFO_EVERY_SECOND(
           "Run queue overflow. Too many ready fibers to run. If you're still "
           "not overloaded, consider increasing `trpc_fiber_run_queue_size`.");
@@ -350,19 +382,21 @@ void SchedulingImpl::StartFibers(FiberDesc** start, FiberDesc** end) noexcept {
       std::this_thread::sleep_for(100us);
     }
   }
-
-  WakeUpWorkers(end - start);
 }
 
-bool SchedulingImpl::QueueRunnableEntity(RunnableEntity* entity,
+bool SchedulingImpl::QueueRunnableEntity(RunnableEntity* entity, runtime::TaskPriority priority,
                                          bool sg_local, bool wait) noexcept {
   TRPC_DCHECK(!stopped_.load(std::memory_order_relaxed), "The scheduling group has been stopped.");
 
   // Push the fiber into run queue and (optionally) wake up a worker.
-  if (TRPC_UNLIKELY(!run_queue_.Push(entity, sg_local))) {
+  if (TRPC_UNLIKELY(!GetRunQueue(priority).Push(entity, sg_local))) {
+    if (priority != runtime::TaskPriority::kNormal) {
+      return QueueRunnableEntity(entity, runtime::TaskPriority::kNormal, sg_local, wait);
+    }
+
     auto since = ReadSteadyClock();
 
-    while (!run_queue_.Push(entity, sg_local)) {
+    while (!GetRunQueue(priority).Push(entity, sg_local)) {
       TRPC_FMT_INFO_EVERY_SECOND(
           "Run queue overflow. Too many ready fibers to run. If you're still "
           "not overloaded, consider increasing `trpc_fiber_run_queue_size`.");
@@ -406,7 +440,7 @@ void SchedulingImpl::Suspend(FiberEntity* self, std::unique_lock<Spinlock>&& sch
   // starts to run again, `std::unique_lock<...>::owns_lock` does not
   // necessarily be updated in time (before the fiber checks it), which can lead
   // to subtle bugs.
-  if (auto rc = GetOrInstantiateFiber(run_queue_.Pop())) {
+  if (auto rc = GetOrInstantiateFiber(PopRunnableEntity())) {
     TRPC_ASSERT(self != rc);
     {
       std::scoped_lock _(rc->scheduler_lock);
@@ -461,11 +495,11 @@ void SchedulingImpl::PostResume(FiberEntity* fiber) noexcept {
     fiber->last_ready_tsc = ReadTsc();
   }
 
-  QueueRunnableEntity(fiber, fiber->scheduling_group_local, true);
+  QueueRunnableEntity(fiber, fiber->priority, fiber->scheduling_group_local, true);
 }
 
 void SchedulingImpl::Yield(FiberEntity* self) noexcept {
-  if (auto rc = GetOrInstantiateFiber(run_queue_.Pop())) {
+  if (auto rc = GetOrInstantiateFiber(PopRunnableEntity())) {
     {
       std::scoped_lock _(rc->scheduler_lock);
 
@@ -623,7 +657,11 @@ bool SchedulingImpl::WakeUpOneDeepSleepingWorker() noexcept {
 }
 
 std::size_t SchedulingImpl::GetFiberQueueSize() noexcept {
-  return run_queue_.UnsafeSize();
+  std::size_t total_size = 0;
+  for (auto&& run_queue : run_queues_) {
+    total_size += run_queue.UnsafeSize();
+  }
+  return total_size;
 }
 
 }  // namespace trpc::fiber::detail::v1
@@ -16,10 +16,13 @@
 #include <limits>
 #include <memory>
 #include <mutex>
+#include <queue>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "trpc/runtime/threadmodel/common/task_priority.h"
+#include "trpc/runtime/threadmodel/fiber/detail/scheduling/priority_picker.h"
 #include "trpc/runtime/threadmodel/fiber/detail/scheduling/v1/run_queue.h"
 #include "trpc/runtime/threadmodel/fiber/detail/scheduling/scheduling.h"
 #include "trpc/runtime/threadmodel/fiber/detail/scheduling_group.h"
@@ -80,7 +83,13 @@ class alignas(hardware_destructive_interference_size) SchedulingImpl final : pub
   bool WakeUpOneSpinningWorker() noexcept;
   bool WakeUpOneDeepSleepingWorker() noexcept;
   FiberEntity* GetOrInstantiateFiber(RunnableEntity* entity) noexcept;
-  bool QueueRunnableEntity(RunnableEntity* entity, bool sg_local, bool wait = false) noexcept;
+  RunnableEntity* PopRunnableEntity() noexcept;
+  bool QueueRunnableEntity(RunnableEntity* entity, runtime::TaskPriority priority, bool sg_local,
+                           bool wait = false) noexcept;
+  void QueueRunnableEntities(RunnableEntity** start, RunnableEntity** end, runtime::TaskPriority priority) noexcept;
+  RunQueue& GetRunQueue(runtime::TaskPriority priority) noexcept {
+    return run_queues_[static_cast<std::size_t>(priority)];
+  }
   bool Push(RunnableEntity* entity, bool sg_local, bool wait) noexcept;
   void PostResume(FiberEntity* fiber) noexcept;
 
@@ -115,6 +124,9 @@ class alignas(hardware_destructive_interference_size) SchedulingImpl final : pub
   static constexpr auto kUninitializedWorkerIndex = std::numeric_limits<std::size_t>::max();
   static thread_local std::size_t worker_index_;
 
+  // Decides which of `run_queues_` the worker tries first.
+  static thread_local PriorityPicker picker_;
+
   SchedulingGroup* scheduling_group_;
   std::size_t group_size_;
 
@@ -123,8 +135,8 @@ class alignas(hardware_destructive_interference_size) SchedulingImpl final : pub
   // Exposes internal state.
   // DelayedInit<tvar::PassiveStatus<std::string>> spinning_workers_var_, sleeping_workers_var_;
 
-  // Ready fibers are put here.
-  RunQueue run_queue_;
+  // Ready fibers are put here, one queue per priority.
+  RunQueue run_queues_[runtime::kTaskPriorityNum];
 
   // Fiber workers sleep on this.
   std::unique_ptr<WaitSlot[]> wait_slots_{nullptr};
@@ -42,6 +42,7 @@ namespace trpc::fiber::detail::v2 {
 FiberEntity* kSchedulingGroupShuttingDown = reinterpret_cast<FiberEntity*>(0x1);
 
 thread_local std::size_t SchedulingImpl::worker_index_ = kUninitializedWorkerIndex;
+thread_local PriorityPicker SchedulingImpl::picker_;
 
 bool SchedulingImpl::Init(SchedulingGroup* scheduling_group, std::size_t scheduling_group_size) noexcept {
   TRPC_CHECK_LE(scheduling_group_size, std::size_t(64),
@@ -55,6 +56,8 @@ bool SchedulingImpl::Init(SchedulingGroup* scheduling_group, std::size_t schedul
   // reactor queue is set to group_size.
   TRPC_ASSERT(fiber_reactor_queue_.Init(group_size_));
   TRPC_ASSERT(global_queue_.Init(GetFiberRunQueueSize()));
+  TRPC_ASSERT(high_priority_queue_.Init(GetFiberPriorityRunQueueSize()));
+  TRPC_ASSERT(low_priority_queue_.Init(GetFiberPriorityRunQueueSize()));
 
   local_queues_ = std::make_unique<LocalQueue[]>(group_size_);
   for (size_t i = 0; i < group_size_; ++i) {
@@ -111,7 +114,7 @@ void SchedulingImpl::Schedule() noexcept {
           SetFiberRunning(fiber_entity);
           fiber_entity->Resume();
 
-          fiber_entity = GetOrInstantiateFiber(local_queues_[worker_index_].Pop());
+          fiber_entity = GetOrInstantiateFiber(PopRunnableEntity());
         }
 
         --num_actives_;
@@ -145,10 +148,10 @@ FiberEntity* SchedulingImpl::WaitForFiber() noexcept {
   notifier_->PrepareWait(waiters_[worker_index_]);
 
   // if (global_queue_.Size() > 0) {
-  if (global_queue_.UnsafeSize() > 0) {
+  if (global_queue_.UnsafeSize() > 0 || num_prioritized_.load(std::memory_order_relaxed) > 0) {
     notifier_->CancelWait(waiters_[worker_index_]);
 
-    fiber_entity = GetOrInstantiateFiber(global_queue_.Pop());
+    fiber_entity = GetOrInstantiateFiber(PopRunnableEntity());
     if (fiber_entity) {
       if (num_thieves_.fetch_sub(1) == 1) {
         notifier_->Notify(false);
@@ -201,10 +204,7 @@ FiberEntity* SchedulingImpl::ExploreTask() noexcept {
 
   for (;;) {
     if (worker_index_ == vtm_[worker_index_]) {
-      fiber_entity = GetOrInstantiateFiber(local_queues_[worker_index_].Pop());
-      if (!fiber_entity) {
-        fiber_entity = GetOrInstantiateFiber(global_queue_.Pop());
-      }
+      fiber_entity = GetOrInstantiateFiber(PopRunnableEntity());
     } else {
       fiber_entity = GetOrInstantiateFiber(local_queues_[vtm_[worker_index_]].Steal());
     }
@@ -225,6 +225,31 @@ FiberEntity* SchedulingImpl::ExploreTask() noexcept {
 
 // End of source codes that are from taskflow.
 
+RunnableEntity* SchedulingImpl::PopRunnableEntity() noexcept {
+  if (num_prioritized_.load(std::memory_order_relaxed) == 0) {
+    return PopNormalRunnableEntity();
+  }
+  return picker_.Pick([this](runtime::TaskPriority priority) -> RunnableEntity* {
+    if (priority != runtime::TaskPriority::kNormal) {
+      auto rc = GetPriorityQueue(priority).Pop();
+      if (rc) {
+        num_prioritized_.fetch_sub(1, std::memory_order_relaxed);
+      }
+      return rc;
+    }
+    return PopNormalRunnableEntity();
+  });
+}
+
+RunnableEntity* SchedulingImpl::PopNormalRunnableEntity() noexcept {
+  // Fibers of normal priority are looked for in the global queue as well, otherwise a backlog of fibers of other
+  // priorities would keep the worker from ever getting to them.
+  if (auto rc = local_queues_[worker_index_].Pop()) {
+    return rc;
+  }
+  return global_queue_.Pop();
+}
+
 FiberEntity* SchedulingImpl::AcquireReactorFiber() noexcept {
   if (auto rc = GetOrInstantiateFiber(fiber_reactor_queue_.Pop())) {
     return rc;
@@ -268,22 +293,26 @@ void SchedulingImpl::StartFibers(FiberDesc** start, FiberDesc** end) noexcept {
   }
 
   bool is_fiber_reactor = (*start)->is_fiber_reactor;
-  auto s1 = reinterpret_cast<RunnableEntity**>(start), s2 = reinterpret_cast<RunnableEntity**>(end);
-  for (auto iter = s1; iter != s2; ++iter) {
-    QueueRunnableEntity(*iter, is_fiber_reactor);
+  for (auto iter = start; iter != end; ++iter) {
+    QueueRunnableEntity(*iter, is_fiber_reactor, (*iter)->priority);
   }
 }
 
 bool SchedulingImpl::StartFiber(FiberDesc* fiber) noexcept {
   fiber->last_ready_tsc = ReadTsc();
-  return QueueRunnableEntity(fiber, fiber->is_fiber_reactor);
+  return QueueRunnableEntity(fiber, fiber->is_fiber_reactor, fiber->priority);
 }
 
-bool SchedulingImpl::QueueRunnableEntity(RunnableEntity* entity, bool is_fiber_reactor) noexcept {
+bool SchedulingImpl::QueueRunnableEntity(RunnableEntity* entity, bool is_fiber_reactor,
+                                         runtime::TaskPriority priority) noexcept {
   TRPC_DCHECK(!stopped_.load(std::memory_order_relaxed), "The scheduling group has been stopped.");
 
   bool ret = true;
   if (!is_fiber_reactor) {
+    if (priority != runtime::TaskPriority::kNormal && PushToPriorityQueue(entity, priority)) {
+      return true;
+    }
+
     if (scheduling_group_ == SchedulingGroup::Current() && worker_index_ < group_size_) {
       ret = PushToLocalQueue(entity);
     } else {
@@ -320,6 +349,18 @@ bool SchedulingImpl::PushToGlobalQueue(detail::v1::RunQueue& global_queue, Runna
   return true;
 }
 
+bool SchedulingImpl::PushToPriorityQueue(RunnableEntity* fiber, runtime::TaskPriority priority) noexcept {
+  // Counted before being pushed, so that the counter never drops below zero when it's popped at once.
+  num_prioritized_.fetch_add(1, std::memory_order_relaxed);
+  // Fall back to the queues of normal priority rather than waiting if the queue is full.
+  if (TRPC_UNLIKELY(!GetPriorityQueue(priority).Push(fiber))) {
+    num_prioritized_.fetch_sub(1, std::memory_order_relaxed);
+    return false;
+  }
+  notifier_->Notify(false);
+  return true;
+}
+
 bool SchedulingImpl::PushToLocalQueue(RunnableEntity* fiber) noexcept {
   if (!local_queues_[worker_index_].Push(fiber)) {
     bool ret = PushToGlobalQueue(global_queue_, fiber);
@@ -334,7 +375,7 @@ bool SchedulingImpl::PushToLocalQueue(RunnableEntity* fiber) noexcept {
 FiberEntity* SchedulingImpl::GetFiberEntity() noexcept {
   TRPC_CHECK(scheduling_group_ == SchedulingGroup::Current(), "scheduling group are inconsistent");
 
-  auto* fiber_entity = local_queues_[worker_index_].Pop();
+  auto* fiber_entity = PopRunnableEntity();
   if (fiber_entity) {
     return GetOrInstantiateFiber(fiber_entity);
   }
@@ -407,6 +448,10 @@ void SchedulingImpl::Resume(FiberEntity* fiber, std::unique_lock<Spinlock>&& sch
   }
 
   if (!fiber->is_fiber_reactor) {
+    if (fiber->priority != runtime::TaskPriority::kNormal && PushToPriorityQueue(fiber, fiber->priority)) {
+      return;
+    }
+
     if (pre_state == FiberState::Yield) {
       PushToGlobalQueue(global_queue_, fiber, true);
       notifier_->Notify(false);
@@ -460,6 +505,7 @@ void SchedulingImpl::SwitchTo(FiberEntity* self, FiberEntity* to) noexcept {
 std::size_t SchedulingImpl::GetFiberQueueSize() noexcept {
   // std::size_t total_size = global_queue_.Size();
   std::size_t total_size = global_queue_.UnsafeSize();
+  total_size += high_priority_queue_.UnsafeSize() + low_priority_queue_.UnsafeSize();
   for (std::size_t i = 0; i < group_size_; ++i) {
     total_size += local_queues_[i].Size();
   }
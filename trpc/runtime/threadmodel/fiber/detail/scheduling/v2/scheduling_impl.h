@@ -24,7 +24,9 @@
 #include <utility>
 #include <vector>
 
+#include "trpc/runtime/threadmodel/common/task_priority.h"
 #include "trpc/runtime/threadmodel/fiber/detail/fiber_entity.h"
+#include "trpc/runtime/threadmodel/fiber/detail/scheduling/priority_picker.h"
 #include "trpc/runtime/threadmodel/fiber/detail/scheduling/scheduling.h"
 #include "trpc/runtime/threadmodel/fiber/detail/scheduling/v1/run_queue.h"
 #include "trpc/runtime/threadmodel/fiber/detail/scheduling/v2/local_queue.h"
@@ -51,6 +53,8 @@ namespace trpc::fiber::detail::v2 {
 ///        no network events, it may block the thread. To solve this problem, we treat the reactor fiber as an special
 ///        type fiber and put it into the separate queue to avoid frequent detection of reactor tasks in the running
 ///        queue, which would cause the worker thread to be unable to sleep and result in 100% CPU usage.
+///        5. Fibers of high and low priority are put into separate queues shared by all workers, workers pick them
+///        before (or after) the fibers of normal priority in their local queue, see `PriorityPicker`.
 class alignas(hardware_destructive_interference_size) SchedulingImpl final : public trpc::fiber::detail::Scheduling {
  public:
   bool Init(SchedulingGroup* scheduling_group, std::size_t scheduling_group_size) noexcept override;
@@ -84,7 +88,14 @@ class alignas(hardware_destructive_interference_size) SchedulingImpl final : pub
   FiberEntity* ExploreTask() noexcept;
   bool PushToLocalQueue(RunnableEntity* fiber) noexcept;
   bool PushToGlobalQueue(detail::v1::RunQueue& global_queue, RunnableEntity* fiber, bool wait = false) noexcept;
-  bool QueueRunnableEntity(RunnableEntity* entity, bool is_fiber_reactor) noexcept;
+  bool PushToPriorityQueue(RunnableEntity* fiber, runtime::TaskPriority priority) noexcept;
+  bool QueueRunnableEntity(RunnableEntity* entity, bool is_fiber_reactor, runtime::TaskPriority priority) noexcept;
+  RunnableEntity* PopRunnableEntity() noexcept;
+  RunnableEntity* PopNormalRunnableEntity() noexcept;
+  v1::RunQueue& GetPriorityQueue(runtime::TaskPriority priority) noexcept {
+    TRPC_DCHECK(priority != runtime::TaskPriority::kNormal);
+    return priority == runtime::TaskPriority::kHigh ? high_priority_queue_ : low_priority_queue_;
+  }
   FiberEntity* AcquireReactorFiber() noexcept;
   FiberEntity* GetFiberEntity() noexcept;
   void Resume(FiberEntity* fiber, std::unique_lock<Spinlock>&& scheduler_lock) noexcept;
@@ -95,6 +106,9 @@ class alignas(hardware_destructive_interference_size) SchedulingImpl final : pub
   static constexpr auto kUninitializedWorkerIndex = std::numeric_limits<std::size_t>::max();
   static thread_local std::size_t worker_index_;
 
+  // Decides in which order the worker tries the queues of different priorities.
+  static thread_local PriorityPicker picker_;
+
   trpc::fiber::detail::SchedulingGroup* scheduling_group_;
   std::size_t group_size_;
 
@@ -110,6 +124,14 @@ class alignas(hardware_destructive_interference_size) SchedulingImpl final : pub
   // local queue of each fiber worker thread
   std::unique_ptr<LocalQueue[]> local_queues_;
 
+  // queues used to store fiber tasks of high and low priority, fiber tasks of normal priority are stored in
+  // `global_queue_` and `local_queues_`.
+  v1::RunQueue high_priority_queue_;
+  v1::RunQueue low_priority_queue_;
+  // number of fibers in `high_priority_queue_` and `low_priority_queue_`, so that workers skip `PriorityPicker` (and
+  // polling the empty queues) as long as all the fibers are of normal priority.
+  std::atomic<std::size_t> num_prioritized_{0};
+
   std::atomic<std::size_t> num_actives_{0};
   std::atomic<std::size_t> num_thieves_{0};
   std::vector<std::size_t> vtm_;
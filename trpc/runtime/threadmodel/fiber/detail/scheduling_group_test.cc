@@ -12,13 +12,16 @@
 
 #include <algorithm>
 #include <fstream>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 
 #include "trpc/coroutine/testing/fiber_runtime.h"
 #include "trpc/runtime/threadmodel/fiber/detail/fiber_entity.h"
+#include "trpc/runtime/threadmodel/fiber/detail/scheduling/priority_picker.h"
 #include "trpc/runtime/threadmodel/fiber/detail/testing.h"
 #include "trpc/runtime/threadmodel/fiber/detail/timer_worker.h"
 #include "trpc/runtime/threadmodel/fiber/detail/waitable.h"
@@ -439,4 +442,60 @@ TEST(SchedulingGroup, FiberYieldOnScheduling) {
   }
 }
 
+void TestPriority(std::string_view scheduling_name) {
+  constexpr std::size_t N = PriorityPicker::kLowTurn;
+  constexpr runtime::TaskPriority kPriorities[] = {runtime::TaskPriority::kLow, runtime::TaskPriority::kNormal,
+                                                   runtime::TaskPriority::kHigh};
+
+  // A single worker runs the fibers one by one, so the order they run in is the order they're picked in.
+  auto scheduling_group = std::make_unique<SchedulingGroup>(std::vector<unsigned>{}, 1, scheduling_name);
+  TimerWorker dummy(scheduling_group.get());
+  scheduling_group->SetTimerWorker(&dummy);
+
+  std::mutex lock;
+  std::vector<runtime::TaskPriority> order;
+  std::atomic<std::size_t> executed{0};
+
+  // Queue all the fibers before the worker starts, least important ones first.
+  for (auto priority : kPriorities) {
+    for (std::size_t i = 0; i != N; ++i) {
+      auto desc = NewFiberDesc();
+      desc->start_proc = [&, priority] {
+        {
+          std::scoped_lock _(lock);
+          order.push_back(priority);
+        }
+        ++executed;
+      };
+      desc->scheduling_group_local = false;
+      desc->priority = priority;
+      ASSERT_TRUE(scheduling_group->StartFiber(desc));
+    }
+  }
+  ASSERT_EQ(N * std::size(kPriorities), scheduling_group->GetFiberQueueSize());
+
+  std::thread worker(WorkerTest, scheduling_group.get(), 0);
+  while (executed != N * std::size(kPriorities)) {
+    std::this_thread::sleep_for(1ms);
+  }
+  scheduling_group->Stop();
+  worker.join();
+
+  // The most important ones run first, the least important ones run last.
+  ASSERT_EQ(N * std::size(kPriorities), order.size());
+  ASSERT_EQ(runtime::TaskPriority::kHigh, order.front());
+  ASSERT_EQ(runtime::TaskPriority::kLow, order.back());
+
+  // But less important ones are not starved until all the more important ones finish.
+  auto last_high = std::find(order.rbegin(), order.rend(), runtime::TaskPriority::kHigh).base() - 1;
+  ASSERT_LT(std::find(order.begin(), order.end(), runtime::TaskPriority::kNormal), last_high);
+  ASSERT_LT(std::find(order.begin(), order.end(), runtime::TaskPriority::kLow), last_high);
+}
+
+TEST(SchedulingGroup, PriorityOnScheduling) {
+  for (auto& name : kSchedulingNames) {
+    TestPriority(name);
+  }
+}
+
 }  // namespace trpc::fiber::detail
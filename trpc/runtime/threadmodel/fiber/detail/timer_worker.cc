@@ -11,12 +11,16 @@
 #include "trpc/runtime/threadmodel/fiber/detail/timer_worker.h"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <limits>
 #include <utility>
 #include <vector>
 
 #include "trpc/runtime/threadmodel/fiber/detail/scheduling_group.h"
+#include "trpc/runtime/threadmodel/fiber/detail/timing_wheel.h"
+#include "trpc/tvar/basic_ops/passive_status.h"
+#include "trpc/tvar/compound_ops/internal_latency.h"
 #include "trpc/util/chrono/chrono.h"
 #include "trpc/util/thread/spinlock.h"
 #include "trpc/util/thread/thread_helper.h"
@@ -46,6 +50,30 @@ namespace trpc::fiber::detail {
 
 namespace {
 
+// Timers due in the same tick are collected by one pass of the wheel.
+constexpr auto kTimerTick = 1ms;
+
+struct TimerVar {
+  static TimerVar* GetInstance() {
+    static TimerVar instance;
+    return &instance;
+  }
+
+  TimerVar(const TimerVar&) = delete;
+  TimerVar& operator=(const TimerVar&) = delete;
+
+  // Delay from the expiration of a timer to the time it is fired, in nanoseconds.
+  tvar::internal::InternalLatency<> fire_latency{"trpc/fiber/latency/timer_fire"};
+
+  // Number of pending timers in all timer workers, cancelled ones not yet dropped included.
+  std::atomic<std::int64_t> pending_timers{0};
+  tvar::PassiveStatus<std::int64_t> pending_timers_status{
+      "trpc/fiber/timer/pending", [this] { return pending_timers.load(std::memory_order_relaxed); }};
+
+ private:
+  TimerVar() = default;
+};
+
 // Load time point from `expected`, but if it's infinite, return a large timeout
 // instead (otherwise overflow can occur in libstdc++, which results in no wait
 // at all.).
@@ -92,6 +120,18 @@ struct TimerWorker::ThreadLocalQueue {
   ~ThreadLocalQueue() { std::scoped_lock _(lock); }
 };
 
+struct TimerWorker::Wheel : TimingWheel<Entry, &Entry::chain> {
+  using TimingWheel::TimingWheel;
+
+  ~Wheel() {
+    EntryList entries;
+    Clear(&entries);
+    while (auto* e = entries.pop_front()) {
+      e->DecrCount();
+    }
+  }
+};
+
 thread_local bool tls_queue_initialized = false;
 
 TimerWorker::TimerWorker(SchedulingGroup* sg, bool disable_process_name)
@@ -99,9 +139,12 @@ TimerWorker::TimerWorker(SchedulingGroup* sg, bool disable_process_name)
     : sg_(sg),
       disable_process_name_(disable_process_name),
       latch(sg_->GroupSize() + 1),
-      producers_(sg_->GroupSize() + 1) {}
+      producers_(sg_->GroupSize() + 1),
+      timers_(std::make_unique<Wheel>(ReadSteadyClock(), kTimerTick)) {}
 
-TimerWorker::~TimerWorker() = default;
+TimerWorker::~TimerWorker() {
+  TimerVar::GetInstance()->pending_timers.fetch_sub(reported_timers_, std::memory_order_relaxed);
+}
 
 TimerWorker* TimerWorker::GetTimerOwner(std::uint64_t timer_id) {
   return reinterpret_cast<Entry*>(timer_id)->owner;
@@ -229,13 +272,20 @@ void TimerWorker::WorkerProc() {
     // And fire those who has expired.
     FireTimers();
 
-    if (!timers_.empty()) {
+    if (auto expires_at = timers_->GetNextExpiresAt();
+        expires_at != std::chrono::steady_clock::time_point::max()) {
       // Do not reset `next_expires_at_` directly here, we need to compare our
       // earliest timer with thread-local queues (which is handled by this
       // `WakeWorkerIfNeeded`).
-      WakeWorkerIfNeeded(timers_.top()->expires_at);
+      WakeWorkerIfNeeded(expires_at);
     }
 
+    // Report occupancy once per round, rather than once per timer.
+    TimerVar::GetInstance()->pending_timers.fetch_add(
+        static_cast<std::int64_t>(timers_->size()) - static_cast<std::int64_t>(reported_timers_),
+        std::memory_order_relaxed);
+    reported_timers_ = timers_->size();
+
     // Sleep until next time fires.
     std::unique_lock lk(lock_);
     auto expected = next_expires_at_.load(std::memory_order_relaxed);
@@ -286,23 +336,25 @@ void TimerWorker::ReapThreadLocalQueues() {
         e->DecrCount();
         continue;
       }
-      auto ep = object_pool::LwSharedPtr(object_pool::lw_shared_adopt_ptr, e);
-      timers_.push(std::move(ep));
+      // Our reference is held by the wheel from now on.
+      timers_->Add(e);
     }
   }
 }
 
 void TimerWorker::FireTimers() {
   auto now = ReadSteadyClock();
-  while (!timers_.empty()) {
-    auto&& e = timers_.top();
+  Wheel::EntryList expired;
+  // Cancelled timers are dropped lazily here, cancelling a timer never touches the wheel.
+  timers_->PopExpired(now, &expired);
+
+  while (auto* raw = expired.pop_front()) {
+    auto e = EntryPtr(object_pool::lw_shared_adopt_ptr, raw);
     if (e->cancelled.load(std::memory_order_relaxed)) {
-      timers_.pop();
       continue;
     }
-    if (e->expires_at > now) {
-      break;
-    }
+
+    TimerVar::GetInstance()->fire_latency.Update((now - e->expires_at) / 1ns);
 
     // This IS slow, but if you have many timers to actually *fire*, you're in
     // trouble anyway.
@@ -320,19 +372,17 @@ void TimerWorker::FireTimers() {
       if (cb) {
         // CAUTION: Do NOT create a new `Entry` otherwise timer ID we returned
         // in `AddTimer` will be invalidated.
-        auto cp = std::move(e);  // FIXME: This `std::move` has no effect.
-        std::unique_lock cplk(cp->lock);
-        if (!cp->cancelled) {
-          cp->expires_at = cp->expires_at + cp->interval;
-          cp->cb = std::move(cb);  // Move user's callback back.
-          cplk.unlock();
-          timers_.push(std::move(cp));
+        std::unique_lock lk(e->lock);
+        if (!e->cancelled) {
+          e->expires_at = e->expires_at + e->interval;
+          e->cb = std::move(cb);  // Move user's callback back.
+          lk.unlock();
+          timers_->Add(e.Leak());
         }
       } else {
         TRPC_CHECK(e->cancelled.load(std::memory_order_relaxed));
       }
     }
-    timers_.pop();
   }
 }
 
@@ -374,10 +424,4 @@ inline TimerWorker::ThreadLocalQueue* TimerWorker::GetThreadLocalQueue() {
   return &q;
 }
 
-bool TimerWorker::EntryPtrComp::operator()(const EntryPtr& p1,
-                                           const EntryPtr& p2) const {
-  // `std::priority_queue` orders elements in descending order.
-  return p1->expires_at > p2->expires_at;
-}
-
 }  // namespace trpc::fiber::detail
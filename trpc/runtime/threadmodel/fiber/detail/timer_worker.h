@@ -13,8 +13,8 @@
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
 #include <vector>
 
@@ -81,6 +81,7 @@ class alignas(hardware_destructive_interference_size) TimerWorker {
   struct Entry;
   using EntryPtr = object_pool::LwSharedPtr<Entry>;
   struct ThreadLocalQueue;
+  struct Wheel;
 
   void WorkerProc();
 
@@ -96,9 +97,6 @@ class alignas(hardware_destructive_interference_size) TimerWorker {
   static ThreadLocalQueue* GetThreadLocalQueue();
 
  private:
-  struct EntryPtrComp {
-    bool operator()(const EntryPtr& p1, const EntryPtr& p2) const;
-  };
   friend struct PoolTraits<Entry>;
 
   SchedulingGroup* sg_;
@@ -116,7 +114,15 @@ class alignas(hardware_destructive_interference_size) TimerWorker {
   // `time_point::time_since_epoch()` here.
   std::atomic<std::chrono::steady_clock::duration> next_expires_at_{
       std::chrono::steady_clock::duration::max()};
-  std::priority_queue<EntryPtr, std::vector<EntryPtr>, EntryPtrComp> timers_;
+  // Timers collected from thread-local queues, only accessed by our own worker thread.
+  //
+  // There is one wheel per scheduling group rather than one per fiber worker. Fiber workers sleep in the scheduler
+  // until a fiber is ready, so a wheel of their own would either fire late or wake every worker at each of its
+  // deadlines, and timers are cancelled from whichever thread the RPC completes on. Adding a timer already only
+  // touches the producer's own thread-local queue.
+  std::unique_ptr<Wheel> timers_;
+  // Number of timers in `timers_` last reported to the occupancy tvar.
+  std::size_t reported_timers_{0};
 
   std::thread worker_;
 
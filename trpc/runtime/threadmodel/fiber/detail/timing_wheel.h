@@ -0,0 +1,216 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "trpc/util/check.h"
+#include "trpc/util/doubly_linked_list.h"
+
+namespace trpc::fiber::detail {
+
+// Hierarchical timing wheel of intrusive entries, `T` must provide `expires_at` (a `steady_clock::time_point`).
+//
+// Time is divided into ticks since `origin`. Each level has 64 slots, a slot of level `l` spans `64^l` ticks, so 6
+// levels cover `2^36` ticks (~2 years with 1ms tick). An entry is placed into the level of the highest 6-bit group
+// where its tick differs from the current tick, and moves down level by level as the current tick reaches its slot.
+// Adding an entry is O(1). Removal is left to the owner (e.g. by flagging the entry and dropping it when it pops out),
+// as the wheel is owned by a single thread.
+//
+// Entries due in the current tick are kept in a separate list and fire at their exact `expires_at`, so the wheel
+// never fires an entry early and adds no more latency than the caller's sleep precision.
+//
+// Not thread-safe.
+template <class T, DoublyLinkedListEntry T::*kChain>
+class TimingWheel {
+ public:
+  using EntryList = DoublyLinkedList<T, kChain>;
+
+  TimingWheel(std::chrono::steady_clock::time_point origin, std::chrono::nanoseconds tick)
+      : origin_(origin), tick_(tick) {
+    TRPC_CHECK(tick_ > std::chrono::nanoseconds::zero());
+  }
+
+  ~TimingWheel() { TRPC_CHECK(size_ == 0, "Entries must be drained out by `Clear` before destruction."); }
+
+  // Add `entry` which is not in any list.
+  void Add(T* entry) {
+    ++size_;
+    Place(entry);
+  }
+
+  // Move entries expires at or before `now` to `expired`.
+  void PopExpired(std::chrono::steady_clock::time_point now, EntryList* expired) {
+    Advance(GetTick(now));
+
+    for (auto iter = current_.begin(); iter != current_.end();) {
+      T* entry = &*iter;
+      ++iter;
+      if (entry->expires_at <= now) {
+        current_.erase(entry);
+        expired->push_back(entry);
+        --size_;
+      }
+    }
+  }
+
+  // Time point when the next entry may expire, `time_point::max()` if the wheel is empty.
+  // Entries of a later tick are reported as the time their slot is to be processed, which is no later than they
+  // expire, the caller should check again then.
+  std::chrono::steady_clock::time_point GetNextExpiresAt() const {
+    if (!current_.empty()) {
+      auto earliest = std::chrono::steady_clock::time_point::max();
+      for (auto&& e : current_) {
+        earliest = std::min(earliest, e.expires_at);
+      }
+      return earliest;
+    }
+
+    auto tick = GetNextEventTick();
+    if (tick == kInfiniteTick) {
+      return std::chrono::steady_clock::time_point::max();
+    }
+    return origin_ + static_cast<std::int64_t>(tick) * tick_;
+  }
+
+  // Move all entries to `all`, the wheel is empty afterwards.
+  void Clear(EntryList* all) {
+    all->splice(std::move(current_));
+    all->splice(std::move(overflow_));
+    for (std::size_t level = 0; level != kLevels; ++level) {
+      for (auto&& slot : slots_[level]) {
+        all->splice(std::move(slot));
+      }
+      bitmaps_[level] = 0;
+    }
+    size_ = 0;
+  }
+
+  // Number of entries in the wheel.
+  std::size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+ private:
+  static constexpr std::size_t kSlotBits = 6;
+  static constexpr std::size_t kSlots = 1 << kSlotBits;
+  static constexpr std::uint64_t kSlotMask = kSlots - 1;
+  static constexpr std::size_t kLevels = 6;
+  static constexpr std::uint64_t kInfiniteTick = std::numeric_limits<std::uint64_t>::max();
+
+  std::uint64_t GetTick(std::chrono::steady_clock::time_point tp) const {
+    if (tp <= origin_) {
+      return 0;
+    }
+    return static_cast<std::uint64_t>((tp - origin_) / tick_);
+  }
+
+  void Place(T* entry) {
+    auto tick = GetTick(entry->expires_at);
+    if (tick <= current_tick_) {
+      current_.push_back(entry);
+      return;
+    }
+
+    auto level = (63 - __builtin_clzll(tick ^ current_tick_)) / kSlotBits;
+    if (level >= kLevels) {
+      overflow_.push_back(entry);
+      return;
+    }
+    auto slot = (tick >> (level * kSlotBits)) & kSlotMask;
+    slots_[level][slot].push_back(entry);
+    bitmaps_[level] |= std::uint64_t(1) << slot;
+  }
+
+  // The earliest tick later than the current one at which a non-empty slot is to be processed.
+  std::uint64_t GetNextEventTick() const {
+    std::uint64_t result = kInfiniteTick;
+    for (std::size_t level = 0; level != kLevels; ++level) {
+      auto shift = level * kSlotBits;
+      auto current_slot = (current_tick_ >> shift) & kSlotMask;
+      // Slots of a level are always ahead of the current one of that level, see `Place`.
+      auto ahead = bitmaps_[level] & ~((std::uint64_t(2) << current_slot) - 1);
+      if (ahead) {
+        auto upper = (current_tick_ >> (shift + kSlotBits)) << (shift + kSlotBits);
+        result = std::min(result, upper | (static_cast<std::uint64_t>(__builtin_ctzll(ahead)) << shift));
+      }
+    }
+    if (!overflow_.empty()) {
+      constexpr auto kSpanBits = kLevels * kSlotBits;
+      result = std::min(result, ((current_tick_ >> kSpanBits) + 1) << kSpanBits);
+    }
+    return result;
+  }
+
+  void Advance(std::uint64_t target) {
+    while (current_tick_ < target) {
+      // Jump over ticks with nothing to do, a long idle period costs no more than a busy tick.
+      auto next = GetNextEventTick();
+      if (next > target) {
+        current_tick_ = target;
+        return;
+      }
+      current_tick_ = next;
+
+      if ((current_tick_ & ((std::uint64_t(1) << (kLevels * kSlotBits)) - 1)) == 0) {
+        Replace(&overflow_);
+      }
+      for (std::size_t level = kLevels - 1; level != 0; --level) {
+        auto shift = level * kSlotBits;
+        if ((current_tick_ & ((std::uint64_t(1) << shift) - 1)) != 0) {
+          continue;
+        }
+        auto slot = (current_tick_ >> shift) & kSlotMask;
+        if (bitmaps_[level] & (std::uint64_t(1) << slot)) {
+          bitmaps_[level] &= ~(std::uint64_t(1) << slot);
+          Replace(&slots_[level][slot]);
+        }
+      }
+      auto slot = current_tick_ & kSlotMask;
+      if (bitmaps_[0] & (std::uint64_t(1) << slot)) {
+        bitmaps_[0] &= ~(std::uint64_t(1) << slot);
+        current_.splice(std::move(slots_[0][slot]));
+      }
+    }
+  }
+
+  // Place the entries of `list` again, as the current tick has moved.
+  void Replace(EntryList* list) {
+    EntryList entries;
+    entries.swap(*list);
+    while (auto* entry = entries.pop_front()) {
+      Place(entry);
+    }
+  }
+
+ private:
+  std::chrono::steady_clock::time_point origin_;
+  std::chrono::nanoseconds tick_;
+  std::uint64_t current_tick_{0};
+  std::size_t size_{0};
+
+  // Entries due in the current tick or before.
+  EntryList current_;
+  // Entries beyond the span of the top level, placed again whenever the top level wraps around.
+  EntryList overflow_;
+  EntryList slots_[kLevels][kSlots];
+  // Non-empty slots of each level.
+  std::uint64_t bitmaps_[kLevels]{};
+};
+
+}  // namespace trpc::fiber::detail
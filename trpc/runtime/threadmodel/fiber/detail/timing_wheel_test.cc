@@ -0,0 +1,140 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/threadmodel/fiber/detail/timing_wheel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace std::literals;
+
+namespace trpc::fiber::detail {
+
+namespace {
+
+struct Timer {
+  explicit Timer(std::chrono::steady_clock::time_point expires_at) : expires_at(expires_at) {}
+
+  DoublyLinkedListEntry chain;
+  std::chrono::steady_clock::time_point expires_at;
+};
+
+using Wheel = TimingWheel<Timer, &Timer::chain>;
+
+const auto kOrigin = std::chrono::steady_clock::time_point(100s);
+
+std::vector<Timer*> PopExpired(Wheel* wheel, std::chrono::steady_clock::time_point now) {
+  Wheel::EntryList expired;
+  wheel->PopExpired(now, &expired);
+  std::vector<Timer*> result;
+  while (auto* e = expired.pop_front()) {
+    result.push_back(e);
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(TimingWheel, FireInOrder) {
+  Wheel wheel(kOrigin, 1ms);
+  Timer t1(kOrigin + 5ms);
+  Timer t2(kOrigin + 5ms + 500us);
+  Timer t3(kOrigin + 3s);
+  Timer past(std::chrono::steady_clock::time_point::min());
+  wheel.Add(&t3);
+  wheel.Add(&t2);
+  wheel.Add(&t1);
+  wheel.Add(&past);
+  ASSERT_EQ(wheel.size(), 4);
+
+  ASSERT_EQ(wheel.GetNextExpiresAt(), past.expires_at);
+  ASSERT_EQ(PopExpired(&wheel, kOrigin), std::vector<Timer*>{&past});
+
+  ASSERT_EQ(wheel.GetNextExpiresAt(), kOrigin + 5ms);
+  ASSERT_TRUE(PopExpired(&wheel, kOrigin + 4ms).empty());
+
+  // Entries in the current tick fire at their exact time.
+  ASSERT_EQ(PopExpired(&wheel, kOrigin + 5ms + 100us), std::vector<Timer*>{&t1});
+  ASSERT_EQ(wheel.GetNextExpiresAt(), t2.expires_at);
+  ASSERT_EQ(PopExpired(&wheel, kOrigin + 5ms + 500us), std::vector<Timer*>{&t2});
+
+  // Reported no later than it expires, the slot of a higher level is to be processed before it.
+  ASSERT_LE(wheel.GetNextExpiresAt(), kOrigin + 3s);
+  ASSERT_TRUE(PopExpired(&wheel, kOrigin + 3s - 1us).empty());
+  ASSERT_EQ(PopExpired(&wheel, kOrigin + 10s), std::vector<Timer*>{&t3});
+
+  ASSERT_TRUE(wheel.empty());
+  ASSERT_EQ(wheel.GetNextExpiresAt(), std::chrono::steady_clock::time_point::max());
+}
+
+TEST(TimingWheel, FarAway) {
+  Wheel wheel(kOrigin, 1ms);
+  Timer never(std::chrono::steady_clock::time_point::max());
+  Timer later(kOrigin + 24h * 365 * 3);
+  wheel.Add(&never);
+  wheel.Add(&later);
+
+  ASSERT_TRUE(PopExpired(&wheel, kOrigin + 24h * 365 * 3 - 1ms).empty());
+  ASSERT_EQ(PopExpired(&wheel, kOrigin + 24h * 365 * 3), std::vector<Timer*>{&later});
+  ASSERT_EQ(wheel.size(), 1);
+
+  Wheel::EntryList all;
+  wheel.Clear(&all);
+  ASSERT_EQ(all.pop_front(), &never);
+  ASSERT_TRUE(wheel.empty());
+}
+
+TEST(TimingWheel, Random) {
+  constexpr auto kTimers = 20000;
+  std::mt19937_64 rng(0);
+  Wheel wheel(kOrigin, 1ms);
+  std::deque<Timer> timers;
+
+  auto now = kOrigin;
+  std::size_t fired = 0;
+  // Every timer must fire on the first poll after it expires, neither earlier nor later.
+  auto poll = [&](std::chrono::steady_clock::time_point prev, std::chrono::steady_clock::time_point now) {
+    for (auto* e : PopExpired(&wheel, now)) {
+      ASSERT_LE(e->expires_at, now);
+      ASSERT_GT(e->expires_at, prev);
+      ++fired;
+    }
+    ASSERT_GT(wheel.GetNextExpiresAt(), now);
+  };
+
+  for (int i = 0; i != kTimers; ++i) {
+    // Mixed timeouts from sub-tick to hours, added while time goes on.
+    auto timeout = std::chrono::nanoseconds(1 + rng() % (1ULL << (10 + rng() % 33)));
+    timers.emplace_back(now + timeout);
+    wheel.Add(&timers.back());
+
+    auto prev = now;
+    now += std::chrono::nanoseconds(rng() % 2'000'000);
+    poll(prev, now);
+  }
+
+  while (!wheel.empty()) {
+    auto prev = now;
+    now = wheel.GetNextExpiresAt();
+    poll(prev, now);
+  }
+
+  ASSERT_EQ(fired, kTimers);
+}
+
+}  // namespace trpc::fiber::detail
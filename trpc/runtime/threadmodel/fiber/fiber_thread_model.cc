@@ -210,6 +210,7 @@ bool FiberThreadModel::SubmitHandleTask(MsgTask* handle_task) noexcept {
   desc->start_proc = std::move(handle_task->handler);
   TRPC_CHECK(!desc->exit_barrier);
   desc->scheduling_group_local = false;
+  desc->priority = handle_task->priority;
 
   return sg->StartFiber(desc);
 }
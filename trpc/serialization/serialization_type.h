@@ -66,6 +66,9 @@ const DataType kHttpType = 7;
 /// @brief Data sturct: thrift
 const DataType kThrift = 8;
 
+/// @brief Data struct: redis pipeline, std::vector<Request>/std::vector<Reply>
+const DataType kRedisPipelineType = 9;
+
 /// @brief Max value of data struct
 const DataType kMaxDataType = 255;
 
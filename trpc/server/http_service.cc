@@ -46,6 +46,13 @@ void HttpService::HandleTransportMessage(STransportReqMsg* recv, STransportRspMs
     } else {
       HandleError(context, req, rsp, status);
     }
+  } else if (IsHttp2(context)) {  // stream handler over HTTP/2
+    // HTTP/2 streaming is not supported by HTTP stream handlers yet.
+    rsp.GenerateExceptionReply(http::ResponseStatus::kNotImplemented, req->GetVersion(),
+                               "stream handler over HTTP/2 not implemented");
+    NoncontiguousBuffer buffer;
+    SerializeResponse(context, std::move(rsp), buffer);
+    context->SendResponse(std::move(buffer));
   } else {  // stream handler
     rsp.EnableStream(context.get());
     Handle(uri_path, handler, context, req, rsp, send);
@@ -91,7 +98,7 @@ void HttpService::Handle(const std::string& path, http::HandlerBase* handler, Se
     *send = trpc::object_pool::New<STransportRspMsg>();
     (*send)->context = context;
     reject_rsp.GenerateExceptionReply(http::ResponseStatus::kForbidden, req->GetVersion(), "request reject");
-    std::move(reject_rsp).SerializeToString((*send)->buffer);
+    SerializeResponse(context, std::move(reject_rsp), (*send)->buffer);
     return;
   }
 
@@ -114,7 +121,7 @@ void HttpService::Handle(const std::string& path, http::HandlerBase* handler, Se
     static const std::string request_timeout_ex = http::JsonException(http::RequestTimeout()).ToJson();
     timeout_rsp.GenerateExceptionReply(http::ResponseStatus::kGatewayTimeout, req->GetVersion(), request_timeout_ex);
     NoncontiguousBuffer buffer;
-    std::move(timeout_rsp).SerializeToString(buffer);
+    SerializeResponse(context, std::move(timeout_rsp), buffer);
     context->SendResponse(std::move(buffer));
     context->CloseConnection();
     return;
@@ -138,9 +145,9 @@ void HttpService::Handle(const std::string& path, http::HandlerBase* handler, Se
           http::JsonException(http::RequestTimeout("Request Handle Timeout")).ToJson();
       timeout_rsp.GenerateExceptionReply(http::ResponseStatus::kGatewayTimeout, req->GetVersion(),
                                          request_handle_timeout_ex);
-      std::move(timeout_rsp).SerializeToString((*send)->buffer);
+      SerializeResponse(context, std::move(timeout_rsp), (*send)->buffer);
     } else {
-      std::move(rsp).SerializeToString((*send)->buffer);
+      SerializeResponse(context, std::move(rsp), (*send)->buffer);
     }
   }
 }
@@ -158,13 +165,33 @@ void HttpService::HandleError(ServerContextPtr& context, http::RequestPtr& req,
   }
   TRPC_LOG_DEBUG("HTTP read error, ip: " << context->GetIp() << ", status: " << status.ToString());
   NoncontiguousBuffer buffer;
-  std::move(rsp).SerializeToString(buffer);
+  SerializeResponse(context, std::move(rsp), buffer);
   context->SendResponse(std::move(buffer));
   context->SetRequestData(nullptr);
   context->SetResponseData(nullptr);
   context->CloseConnection();
 }
 
+bool HttpService::IsHttp2(const ServerContextPtr& context) {
+  return static_cast<HttpResponseProtocol*>(context->GetResponseMsg().get())->IsHttp2();  // NOLINT: safe unchecked cast
+}
+
+void HttpService::SerializeResponse(const ServerContextPtr& context, http::Response&& rsp,
+                                    NoncontiguousBuffer& buffer) {
+  auto* rsp_msg = static_cast<HttpResponseProtocol*>(context->GetResponseMsg().get());  // NOLINT: safe unchecked cast
+  if (!rsp_msg->IsHttp2()) {
+    std::move(rsp).SerializeToString(buffer);
+    return;
+  }
+
+  // HTTP/2 frames are generated by the stream handler of the connection, so the response is converted by the codec
+  // and `buffer` is left empty.
+  if (&rsp_msg->response != &rsp) {
+    rsp_msg->response = std::move(rsp);
+  }
+  context->GetServerCodec()->ZeroCopyEncode(context, context->GetResponseMsg(), buffer);
+}
+
 void HttpService::CheckTimeout(const ServerContextPtr& context) {
   uint64_t now_ms = static_cast<int64_t>(trpc::time::GetMilliSeconds());
   uint64_t timeout = std::min(GetServiceAdapterOption().queue_timeout, context->GetTimeout());
@@ -63,6 +63,12 @@ class HttpService : public Service {
 
   static void HandleError(ServerContextPtr& context, http::RequestPtr& req, http::Response& rsp, const Status& status);
 
+  // Whether the request is received over HTTP/2.
+  static bool IsHttp2(const ServerContextPtr& context);
+
+  // Serializes HTTP/1.x response into `buffer`, or converts it into HTTP/2 response which is sent by stream handler.
+  static void SerializeResponse(const ServerContextPtr& context, http::Response&& rsp, NoncontiguousBuffer& buffer);
+
   void CheckTimeout(const ServerContextPtr& context);
 
  protected:
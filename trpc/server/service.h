@@ -23,6 +23,7 @@
 #include "trpc/filter/server_filter_controller.h"
 #include "trpc/runtime/iomodel/reactor/common/connection.h"
 #include "trpc/runtime/iomodel/reactor/default/acceptor.h"
+#include "trpc/runtime/threadmodel/common/task_priority.h"
 #include "trpc/server/non_rpc/non_rpc_service_method.h"
 #include "trpc/server/rpc/rpc_service_method.h"
 #include "trpc/server/service_adapter_option.h"
@@ -37,6 +38,10 @@ class ThreadModel;
 ///        generally used in merge and separate threading models
 using HandleRequestDispatcherFunction = std::function<int32_t(const STransportReqMsg* req)>;
 
+/// @brief The function for mapping request to the scheduling priority of its handle-task
+///        generally used in fiber threading model
+using HandleRequestPriorityFunction = std::function<runtime::TaskPriority(const STransportReqMsg* req)>;
+
 /// @brief The function for user-defined processing request after request timeout
 using ServiceTimeoutHandleFunction = std::function<void(const ServerContextPtr& context)>;
 
@@ -129,6 +134,13 @@ class Service {
   /// @brief Get the function for dispatching request to specified handle-thread.
   HandleRequestDispatcherFunction& GetHandleRequestDispatcherFunction() { return dispatcher_func_; }
 
+  /// @brief Set the function for mapping request to the scheduling priority of its handle-task.
+  ///        If not set, `GetRequestPriorityFromTransInfo` is used.
+  void SetHandleRequestPriorityFunction(const HandleRequestPriorityFunction& function) { priority_func_ = function; }
+
+  /// @brief Get the function for mapping request to the scheduling priority of its handle-task.
+  HandleRequestPriorityFunction& GetHandleRequestPriorityFunction() { return priority_func_; }
+
   /// @brief Set the function for user-defined processing request after request timeout.
   void SetServiceTimeoutHandleFunction(const ServiceTimeoutHandleFunction& timeout_function) {
     service_timeout_handle_function_ = timeout_function;
@@ -244,6 +256,10 @@ class Service {
   // merge/separate threadmodel use
   HandleRequestDispatcherFunction dispatcher_func_{nullptr};
 
+  // the function for mapping request to the scheduling priority of its handle-task
+  // fiber threadmodel use
+  HandleRequestPriorityFunction priority_func_{nullptr};
+
   // the function for user-defined processing request after request timeout
   ServiceTimeoutHandleFunction service_timeout_handle_function_{nullptr};
 
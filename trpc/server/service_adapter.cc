@@ -79,6 +79,30 @@ FilterStatus RunIoFilters(FilterPoint filter_point, const std::any& msg) noexcep
 
 }  // namespace
 
+runtime::TaskPriority GetRequestPriorityFromTransInfo(const STransportReqMsg* req) {
+  // Same key as the one overload control carries request priority in.
+  static constexpr char kTransInfoKeyPriority[] = "trpc-priority";
+
+  const auto& trans_info = req->context->GetPbReqTransInfo();
+  if (trans_info.empty()) {
+    return runtime::TaskPriority::kNormal;
+  }
+
+  auto it = trans_info.find(kTransInfoKeyPriority);
+  if (it == trans_info.end() || it->second.size() != 1) {
+    return runtime::TaskPriority::kNormal;
+  }
+
+  auto priority = static_cast<uint8_t>(it->second[0]);
+  if (priority >= kHighRequestPriorityThreshold) {
+    return runtime::TaskPriority::kHigh;
+  }
+  if (priority < kLowRequestPriorityThreshold) {
+    return runtime::TaskPriority::kLow;
+  }
+  return runtime::TaskPriority::kNormal;
+}
+
 ServiceAdapter::ServiceAdapter(ServiceAdapterOption&& option) : option_(std::move(option)) {
   TRPC_ASSERT(Initialize());
 }
@@ -406,6 +430,9 @@ bool ServiceAdapter::HandleFiberMessage(const ConnectionPtr& conn, std::deque<st
       task->dst_thread_key = dispatcher(req_msg);
     }
 
+    HandleRequestPriorityFunction& priority_func = service->GetHandleRequestPriorityFunction();
+    task->priority = priority_func ? priority_func(req_msg) : GetRequestPriorityFromTransInfo(req_msg);
+
     bool result = thread_model_->SubmitHandleTask(task);
     if (!result) {
       auto& context = req_msg->context;
@@ -436,6 +463,7 @@ void ServiceAdapter::SetSSLConfigToBindInfo(trpc::BindInfo& bind_info) {
     // Init SSL options
     ssl::ServerSslOptions ssl_options;
     TRPC_ASSERT(ssl::InitServerSslOptions(option_.ssl_config, &ssl_options));
+    ssl::SetDefaultAlpnProtocols(option_.protocol, true, &ssl_options.alpn_protocols);
 
     // Init SSL context
     ssl::SslContextPtr ssl_ctx = MakeRefCounted<ssl::SslContext>();
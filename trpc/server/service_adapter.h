@@ -30,6 +30,17 @@ namespace trpc {
 
 class ThreadModel;
 
+/// @brief Requests whose "trpc-priority" transinfo is no less than it are handled in high priority.
+constexpr uint8_t kHighRequestPriorityThreshold = 192;
+
+/// @brief Requests whose "trpc-priority" transinfo is less than it are handled in low priority.
+constexpr uint8_t kLowRequestPriorityThreshold = 64;
+
+/// @brief The default function for mapping request to the scheduling priority of its handle-task.
+///        It maps the one-byte "trpc-priority" transinfo (0~255, the higher the more important) used by overload
+///        control, requests without it are handled in normal priority.
+runtime::TaskPriority GetRequestPriorityFromTransInfo(const STransportReqMsg* req);
+
 /// @brief An adaptation class that connects the lower layer transport and
 ///        the upper layer service processing
 class ServiceAdapter {
@@ -23,11 +23,12 @@ namespace trpc::stream {
 
 namespace {
 
-StreamHandlerPtr CreateAndInitStreamHandler(Connection* conn, bool fiber_mode) {
+// `protocol` is "grpc" or "http2", both of which share the same HTTP/2 stream handler.
+StreamHandlerPtr CreateAndInitStreamHandler(Connection* conn, bool fiber_mode, const std::string& protocol) {
   StreamOptions options;
   options.fiber_mode = fiber_mode;
   options.connection_id = conn->GetConnId();
-  StreamHandlerPtr stream_handler = ClientStreamHandlerFactory::GetInstance()->Create("grpc", std::move(options));
+  StreamHandlerPtr stream_handler = ClientStreamHandlerFactory::GetInstance()->Create(protocol, std::move(options));
   return stream_handler;
 }
 
@@ -70,7 +71,7 @@ void FiberGrpcClientStreamConnectionHandler::Init() {
   client_codec_ = ClientCodecFactory::GetInstance()->Get("grpc");
   TRPC_ASSERT(client_codec_ && "grpc client codec not registered");
 
-  stream_handler_ = CreateAndInitStreamHandler(GetConnection(), true);
+  stream_handler_ = CreateAndInitStreamHandler(GetConnection(), true, GetTransInfo()->protocol);
 }
 
 StreamHandlerPtr FiberGrpcClientStreamConnectionHandler::GetOrCreateStreamHandler() {
@@ -149,7 +150,7 @@ int FutureGrpcClientStreamConnPoolConnectionHandler::DoHandshake() {
 void FutureGrpcClientStreamConnPoolConnectionHandler::Init() {
   TRPC_ASSERT(GetConnection() && "GetConnection() get nullptr");
   TRPC_ASSERT(GetConnection()->GetIoHandler() && "IoHandler get nullptr");
-  stream_handler_ = CreateAndInitStreamHandler(GetConnection(), false);
+  stream_handler_ = CreateAndInitStreamHandler(GetConnection(), false, options_.group_options->trans_info->protocol);
 }
 
 bool FutureGrpcClientStreamConnPoolConnectionHandler::EncodeStreamMessage(IoMessage* message) {
@@ -190,7 +191,7 @@ int FutureGrpcClientStreamConnComplexConnectionHandler::DoHandshake() {
 void FutureGrpcClientStreamConnComplexConnectionHandler::Init() {
   TRPC_ASSERT(GetConnection() && "GetConnection() get nullptr");
   TRPC_ASSERT(GetConnection()->GetIoHandler() && "IoHandler get nullptr");
-  stream_handler_ = CreateAndInitStreamHandler(GetConnection(), false);
+  stream_handler_ = CreateAndInitStreamHandler(GetConnection(), false, options_.group_options->trans_info->protocol);
 }
 
 bool FutureGrpcClientStreamConnComplexConnectionHandler::EncodeStreamMessage(IoMessage* message) {
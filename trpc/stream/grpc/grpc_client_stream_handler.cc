@@ -19,6 +19,7 @@
 #include "trpc/codec/grpc/grpc_protocol.h"
 #include "trpc/codec/grpc/http2/client_session.h"
 #include "trpc/codec/grpc/http2/response.h"
+#include "trpc/codec/http2/http2_protocol.h"
 
 namespace trpc::stream {
 
@@ -80,10 +81,14 @@ int GrpcClientStreamHandler::EncodeHttp2Request(const http2::RequestPtr& request
 }
 
 namespace {
-http2::RequestPtr GetHttp2Request(const std::any& msg) {
+http2::RequestPtr GetHttp2Request(const std::any& msg, bool http_mode) {
   http2::RequestPtr http2_request{nullptr};
   try {
     const auto& context = std::any_cast<const ClientContextPtr&>(msg);
+    // HTTP/2 session is shared by gRPC and HTTP service proxies, but a connection serves only one of them.
+    if (http_mode) {
+      return static_cast<Http2RequestProtocol*>(context->GetRequest().get())->http2_request;
+    }
     auto grpc_unary_request = static_cast<GrpcUnaryRequestProtocol*>(context->GetRequest().get());
     http2_request = grpc_unary_request->GetHttp2Request();
   } catch (std::bad_any_cast& e) {
@@ -94,7 +99,7 @@ http2::RequestPtr GetHttp2Request(const std::any& msg) {
 }  // namespace
 
 int GrpcDefaultClientStreamHandler::EncodeTransportMessage(IoMessage* msg) {
-  http2::RequestPtr http2_request = GetHttp2Request(msg->msg);
+  http2::RequestPtr http2_request = GetHttp2Request(msg->msg, http_mode_);
   if (TRPC_UNLIKELY(!http2_request)) {
     return -1;
   }
@@ -107,7 +112,7 @@ int GrpcDefaultClientStreamHandler::EncodeTransportMessage(IoMessage* msg) {
 }
 
 int GrpcFiberClientStreamHandler::EncodeTransportMessage(IoMessage* msg) {
-  http2::RequestPtr http2_request = GetHttp2Request(msg->msg);
+  http2::RequestPtr http2_request = GetHttp2Request(msg->msg, http_mode_);
   if (TRPC_UNLIKELY(!http2_request)) {
     return -1;
   }
@@ -50,6 +50,10 @@ class GrpcClientStreamHandler : public StreamHandler {
   void SetSession(std::unique_ptr<http2::Session>&& session) { session_ = std::move(session); }
   http2::Session* GetSession() { return session_.get(); }
 
+  // @brief Serves HTTP service proxies ("http2" protocol) instead of gRPC ones, whose request messages are
+  // `Http2RequestProtocol`.
+  void SetHttpMode(bool http_mode) { http_mode_ = http_mode; }
+
  protected:
   // @brief Submit the HTTP/2 request `request` and write the sendable data to `buffer`.
   int EncodeHttp2Request(const http2::RequestPtr& request, NoncontiguousBuffer* buffer);
@@ -61,6 +65,9 @@ class GrpcClientStreamHandler : public StreamHandler {
 
   std::unique_ptr<http2::Session> session_{nullptr};
 
+  // Whether it serves HTTP service proxies rather than gRPC ones.
+  bool http_mode_{false};
+
  private:
   // Store the stream ID corresponding to the unary call, so that when checking the response, it can be distinguished
   // between stream and unary packets. For unary packets, after checking, remove the ID from `unary_stream_ids`
@@ -18,7 +18,6 @@
 namespace trpc {
 
 IoHandler::HandshakeStatus GrpcIoHandler::Handshake(bool is_read_event) {
-  // NOTE: After adding SSL features, you need to complete the SSL handshake first before the Preface stage.
   Connection* conn = GetConnection();
   TRPC_ASSERT(conn != nullptr && "Connection can't be nullptr");
 
@@ -28,4 +27,26 @@ IoHandler::HandshakeStatus GrpcIoHandler::Handshake(bool is_read_event) {
   return conn_handler->DoHandshake() == 0 ? HandshakeStatus::kSucc : HandshakeStatus::kFailed;
 }
 
+#ifdef TRPC_BUILD_INCLUDE_SSL
+IoHandler::HandshakeStatus GrpcSslIoHandler::Handshake(bool is_read_event) {
+  HandshakeStatus status = ssl::SslIoHandler::Handshake(is_read_event);
+  if (status != HandshakeStatus::kSucc || preface_done_) {
+    return status;
+  }
+
+  Connection* conn = GetConnection();
+  TRPC_ASSERT(conn != nullptr && "Connection can't be nullptr");
+
+  ConnectionHandler* conn_handler = conn->GetConnectionHandler();
+  TRPC_ASSERT(conn_handler != nullptr && "ConnectionHandler can't be nullptr");
+
+  // The preface is written through this io handler, so it goes over TLS.
+  if (conn_handler->DoHandshake() != 0) {
+    return HandshakeStatus::kFailed;
+  }
+  preface_done_ = true;
+  return HandshakeStatus::kSucc;
+}
+#endif
+
 }  // namespace trpc
@@ -15,6 +15,9 @@
 
 #include "trpc/runtime/iomodel/reactor/common/connection.h"
 #include "trpc/runtime/iomodel/reactor/common/default_io_handler.h"
+#ifdef TRPC_BUILD_INCLUDE_SSL
+#include "trpc/transport/common/ssl_io_handler.h"
+#endif
 
 namespace trpc {
 
@@ -27,4 +30,18 @@ class GrpcIoHandler : public DefaultIoHandler {
   HandshakeStatus Handshake(bool is_read_event) override;
 };
 
+#ifdef TRPC_BUILD_INCLUDE_SSL
+/// @brief IO handler of gRPC (and HTTP/2) over TLS, the HTTP2 preface is exchanged after the TLS handshake.
+class GrpcSslIoHandler : public ssl::SslIoHandler {
+ public:
+  GrpcSslIoHandler(Connection* conn, ssl::SslPtr&& ssl) : ssl::SslIoHandler(conn, std::move(ssl)) {}
+
+  /// @brief Handshaking for TLS, then for HTTP2 preface.
+  HandshakeStatus Handshake(bool is_read_event) override;
+
+ private:
+  bool preface_done_{false};
+};
+#endif
+
 }  // namespace trpc
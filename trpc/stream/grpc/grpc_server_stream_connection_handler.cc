@@ -13,12 +13,23 @@
 
 #include "trpc/stream/grpc/grpc_server_stream_connection_handler.h"
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <utility>
+
 #include "trpc/codec/grpc/grpc_protocol.h"
+#include "trpc/codec/http/http_proto_checker.h"
+#include "trpc/codec/http2/http2_protocol.h"
 #include "trpc/codec/server_codec_factory.h"
 #include "trpc/coroutine/fiber.h"
+#include "trpc/stream/grpc/grpc_server_stream_handler.h"
 #include "trpc/stream/grpc/util.h"
 #include "trpc/stream/server_stream_handler_factory.h"
 #include "trpc/stream/util.h"
+#include "trpc/transport/common/ssl_io_handler.h"
+#include "trpc/util/http/http_parser.h"
 
 namespace trpc::stream {
 
@@ -47,9 +58,37 @@ void GrpcServerStreamConnectionHandler::Init(const BindInfo* bind_info, Connecti
 
   stream_handler_ = ServerStreamHandlerFactory::GetInstance()->Create(bind_info->protocol, std::move(stream_options));
   TRPC_CHECK(stream_handler_, "stream handler is nullptr");
+
+  http1_fallback_ = bind_info->protocol == kHttp2CodecName;
+#ifdef TRPC_BUILD_INCLUDE_SSL
+  tls_ = bind_info->ssl_ctx != nullptr;
+#endif
 }
 
 int GrpcServerStreamConnectionHandler::DoHandshake(Connection* conn) {
+  if (!http1_fallback_) {
+    return InitHttp2(conn);
+  }
+
+  wire_protocol_ = WireProtocol::kUndecided;
+#ifdef TRPC_BUILD_INCLUDE_SSL
+  if (tls_) {
+    // The TLS handshake is done, the protocol negotiated by ALPN wins.
+    std::string alpn = static_cast<ssl::SslIoHandler*>(conn->GetIoHandler())->GetSsl()->GetAlpnSelected();
+    if (alpn == "h2") {
+      wire_protocol_ = WireProtocol::kHttp2;
+      return InitHttp2(conn);
+    } else if (!alpn.empty()) {
+      wire_protocol_ = WireProtocol::kHttp1;
+    }
+  }
+#endif
+  // The connection is available now, the HTTP/2 session will use it directly if it's started later.
+  stream_handler_->GetMutableStreamOptions()->send = [conn](IoMessage&& msg) { return conn->Send(std::move(msg)); };
+  return 0;
+}
+
+int GrpcServerStreamConnectionHandler::InitHttp2(Connection* conn) {
   // Before the handshake, Connection's Send is not available, so a separate method is encapsulated here to write
   // data to the connection: WriteBufferToConnUntilDone.
   stream_handler_->GetMutableStreamOptions()->send = [this, conn](IoMessage&& msg) {
@@ -69,6 +108,13 @@ int GrpcServerStreamConnectionHandler::DoHandshake(Connection* conn) {
 
 int GrpcServerStreamConnectionHandler::CheckMessage(const ConnectionPtr& conn, NoncontiguousBuffer& in,
                                                     std::deque<std::any>& out) {
+  if (TRPC_UNLIKELY(wire_protocol_ != WireProtocol::kHttp2)) {
+    if (wire_protocol_ == WireProtocol::kHttp1) {
+      return HttpZeroCopyCheckRequest(conn, in, out);
+    }
+    return CheckUndecidedMessage(conn, in, out);
+  }
+
   TRPC_FMT_TRACE("check grpc request, conn_id: {}, buffer size(pre): {}", conn->GetConnId(), in.ByteSize());
   if (TRPC_LIKELY(stream_handler_->ParseMessage(&in, &out) != 0)) {
     return PacketChecker::PACKET_ERR;
@@ -76,6 +122,66 @@ int GrpcServerStreamConnectionHandler::CheckMessage(const ConnectionPtr& conn, N
   return !out.empty() ? PacketChecker::PACKET_FULL : PacketChecker::PACKET_LESS;
 }
 
+int GrpcServerStreamConnectionHandler::CheckUndecidedMessage(const ConnectionPtr& conn, NoncontiguousBuffer& in,
+                                                             std::deque<std::any>& out) {
+  // HTTP/2 with prior knowledge.
+  int preface_ok = ::trpc::internal::CheckHttp2Preface(in);
+  if (preface_ok == 0) {
+    return PacketChecker::PACKET_LESS;
+  } else if (preface_ok > 0) {
+    wire_protocol_ = WireProtocol::kHttp2;
+    if (!stream_handler_->Init()) {
+      return PacketChecker::PACKET_ERR;
+    }
+    return CheckMessage(conn, in, out);
+  }
+
+  // Peeks at the head of the HTTP/1.1 request, it's left in |in| unless the request is upgraded to h2c.
+  NoncontiguousBuffer probe = in;
+  http::Request request;
+  size_t max_head_size =
+      conn->GetMaxPacketSize() > 0 ? conn->GetMaxPacketSize() : (std::numeric_limits<size_t>::max() - 1);
+  int parsed_bytes = http::ParseHead(probe, max_head_size, &request);
+  if (parsed_bytes == -2) {
+    return PacketChecker::PACKET_LESS;
+  } else if (parsed_bytes < 0) {
+    return PacketChecker::PACKET_ERR;
+  }
+
+  std::string settings_payload;
+  if (tls_ || !::trpc::internal::GetH2cUpgradeSettings(request, &settings_payload)) {
+    wire_protocol_ = WireProtocol::kHttp1;
+    return HttpZeroCopyCheckRequest(conn, in, out);
+  }
+
+  // Upgrades to h2c: "101 Switching Protocols" is followed by the server connection preface, then the response of
+  // stream 1 (RFC 7540, 3.2).
+  TRPC_FMT_TRACE("upgrade to h2c, conn_id: {}", conn->GetConnId());
+  in = std::move(probe);
+  wire_protocol_ = WireProtocol::kHttp2;
+  IoMessage io_msg;
+  io_msg.buffer = CreateBufferSlow(::trpc::internal::kH2cSwitchingProtocolsResponse.data(),
+                                   ::trpc::internal::kH2cSwitchingProtocolsResponse.size());
+  if (conn->Send(std::move(io_msg)) != 0 || !stream_handler_->Init()) {
+    return PacketChecker::PACKET_ERR;
+  }
+  http2::RequestPtr http2_request = ::trpc::internal::ToHttp2Request(request);
+  // It's the only stream handler of "http2" service.
+  auto* grpc_stream_handler = static_cast<GrpcServerStreamHandler*>(stream_handler_.Get());
+  if (grpc_stream_handler->UpgradeFromHttp1(http2_request, settings_payload, &out) != 0) {
+    return PacketChecker::PACKET_ERR;
+  }
+  // The client connection preface may have been received along with the request.
+  if (!in.Empty()) {
+    std::deque<std::any> http2_out;
+    if (CheckMessage(conn, in, http2_out) == PacketChecker::PACKET_ERR) {
+      return PacketChecker::PACKET_ERR;
+    }
+    std::move(http2_out.begin(), http2_out.end(), std::back_inserter(out));
+  }
+  return PacketChecker::PACKET_FULL;
+}
+
 bool GrpcServerStreamConnectionHandler::EncodeStreamMessage(IoMessage* msg) {
   int encode_ok = stream_handler_->EncodeTransportMessage(msg);
   if (encode_ok != 0) {
@@ -99,6 +205,10 @@ void GrpcServerStreamConnectionHandler::Join() {
 
 int GrpcServerStreamConnectionHandler::HandleStreamMessage(const BindInfo* bind_info, const ConnectionPtr& conn,
                                                            std::any& msg) {
+  // HTTP/1.1 requests are never streamed.
+  if (wire_protocol_ == WireProtocol::kHttp1) {
+    return kStreamNonStreamMsg;
+  }
   uint64_t recv_timestamp_us = trpc::time::GetMicroSeconds();
   // Pick the metadata of protocol message (frame header).
   std::any data = GrpcProtocolMessageMetadata{};
@@ -32,10 +32,27 @@ class GrpcServerStreamConnectionHandler {
   int CheckMessage(const ConnectionPtr& conn, NoncontiguousBuffer& in, std::deque<std::any>& out);
   bool EncodeStreamMessage(IoMessage* msg);
 
+ private:
+  // The wire protocol of the connection. The "http2" service falls back to HTTP/1.1 for the clients which don't speak
+  // HTTP/2, it's decided by ALPN over TLS, or by the first bytes received otherwise.
+  enum class WireProtocol { kUndecided, kHttp2, kHttp1 };
+
+  // Starts the HTTP/2 session once the connection is available.
+  int InitHttp2(Connection* conn);
+
+  // Checks the first bytes received by a cleartext "http2" service: HTTP/2 preface, HTTP/1.1 request asking for
+  // upgrading to h2c, or other HTTP/1.1 requests.
+  int CheckUndecidedMessage(const ConnectionPtr& conn, NoncontiguousBuffer& in, std::deque<std::any>& out);
+
  private:
   bool fiber_mode_{false};
   ServerCodecPtr server_codec_{nullptr};
   StreamHandlerPtr stream_handler_{nullptr};
+  // Whether HTTP/1.1 is served as well, only "http2" service does.
+  bool http1_fallback_{false};
+  // Whether the connection is over TLS, where h2c upgrade is not allowed.
+  bool tls_{false};
+  WireProtocol wire_protocol_{WireProtocol::kHttp2};
 };
 
 }  // namespace internal
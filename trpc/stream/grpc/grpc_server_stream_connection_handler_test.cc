@@ -23,6 +23,7 @@
 #include "trpc/stream/testing/mock_connection.h"
 #include "trpc/stream/testing/mock_stream_handler.h"
 #include "trpc/transport/server/server_transport_def.h"
+#include "trpc/util/http/request.h"
 
 namespace trpc::testing {
 
@@ -244,4 +245,50 @@ TEST_F(ServerGrpcStreamConnectionHandlerTest, EncodeStreamMessageOk) {
   ASSERT_FALSE(conn_handler_->EncodeStreamMessage(&msg));
 }
 
+TEST_F(ServerGrpcStreamConnectionHandlerTest, Http2PriorKnowledge) {
+  bind_info_->protocol = "http2";
+  ServerStreamHandlerFactory::GetInstance()->Register(
+      "http2", [&](StreamOptions&& options) -> StreamHandlerPtr { return stream_handler_; });
+  EXPECT_CALL(*stream_handler_, GetMutableStreamOptions()).WillRepeatedly(::testing::Return(&stream_options_));
+  conn_handler_->Init();
+  // The HTTP/2 session is not started until the client connection preface is received.
+  EXPECT_CALL(*stream_handler_, Init()).Times(0);
+  ASSERT_EQ(0, conn_handler_->DoHandshake());
+
+  ConnectionPtr conn = MakeRefCounted<Connection>();
+  NoncontiguousBuffer in = CreateBufferSlow("PRI * HTTP/2.0\r\n");
+  std::deque<std::any> out;
+  ASSERT_EQ(conn_handler_->CheckMessage(conn, in, out), PacketChecker::PACKET_LESS);
+
+  std::deque<std::any> parse_out;
+  parse_out.push_back(1);
+  EXPECT_CALL(*stream_handler_, Init()).WillOnce(::testing::Return(true));
+  EXPECT_CALL(*stream_handler_, ParseMessage(::testing::_, ::testing::_))
+      .WillOnce(::testing::DoAll(::testing::SetArgPointee<1>(parse_out), ::testing::Return(0)));
+  in.Append(CreateBufferSlow("\r\nSM\r\n\r\n"));
+  ASSERT_EQ(conn_handler_->CheckMessage(conn, in, out), PacketChecker::PACKET_FULL);
+}
+
+TEST_F(ServerGrpcStreamConnectionHandlerTest, Http1Fallback) {
+  bind_info_->protocol = "http2";
+  ServerStreamHandlerFactory::GetInstance()->Register(
+      "http2", [&](StreamOptions&& options) -> StreamHandlerPtr { return stream_handler_; });
+  EXPECT_CALL(*stream_handler_, GetMutableStreamOptions()).WillRepeatedly(::testing::Return(&stream_options_));
+  EXPECT_CALL(*stream_handler_, Init()).Times(0);
+  EXPECT_CALL(*stream_handler_, ParseMessage(::testing::_, ::testing::_)).Times(0);
+  conn_handler_->Init();
+  ASSERT_EQ(0, conn_handler_->DoHandshake());
+
+  ConnectionPtr conn = MakeRefCounted<Connection>();
+  NoncontiguousBuffer in = CreateBufferSlow("GET /hello HTTP/1.1\r\nHost: 127.0.0.1\r\n");
+  std::deque<std::any> out;
+  ASSERT_EQ(conn_handler_->CheckMessage(conn, in, out), PacketChecker::PACKET_LESS);
+
+  in.Append(CreateBufferSlow("\r\nGET /world HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n"));
+  ASSERT_EQ(conn_handler_->CheckMessage(conn, in, out), PacketChecker::PACKET_FULL);
+  ASSERT_EQ(2, out.size());
+  ASSERT_EQ("/hello", std::any_cast<http::RequestPtr>(out[0])->GetUrl());
+  ASSERT_EQ("/world", std::any_cast<http::RequestPtr>(out[1])->GetUrl());
+}
+
 }  // namespace trpc::testing
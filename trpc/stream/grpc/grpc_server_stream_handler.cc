@@ -16,6 +16,7 @@
 #include "trpc/codec/grpc/grpc_protocol.h"
 #include "trpc/codec/grpc/grpc_stream_frame.h"
 #include "trpc/codec/grpc/http2/server_session.h"
+#include "trpc/codec/http2/http2_protocol.h"
 #include "trpc/coroutine/fiber.h"
 #include "trpc/server/method.h"
 #include "trpc/server/server_context.h"
@@ -121,6 +122,16 @@ int GrpcServerStreamHandler::ParseMessage(NoncontiguousBuffer* in, std::deque<st
   return 0;
 }
 
+int GrpcServerStreamHandler::UpgradeFromHttp1(http2::RequestPtr& request, std::string_view settings_payload,
+                                              std::deque<std::any>* out) {
+  if (TRPC_UNLIKELY(!static_cast<http2::ServerSession*>(session_.get())->Upgrade(request, settings_payload))) {
+    TRPC_LOG_ERROR("upgrade to h2c failed(server)");
+    return -1;
+  }
+  out->swap(out_);
+  return 0;
+}
+
 int GrpcServerStreamHandler::EncodeHttp2Response(const http2::ResponsePtr& response, NoncontiguousBuffer* buffer) {
   int submit_ok = session_->SubmitResponse(response);
   if (submit_ok != 0) {
@@ -138,10 +149,14 @@ int GrpcServerStreamHandler::EncodeHttp2Response(const http2::ResponsePtr& respo
 }
 
 namespace {
-http2::ResponsePtr GetHttp2Response(const std::any& msg) {
+http2::ResponsePtr GetHttp2Response(const std::any& msg, bool http_mode) {
   http2::ResponsePtr http2_response{nullptr};
   try {
     const auto& context = std::any_cast<const ServerContextPtr&>(msg);
+    // HTTP/2 session is shared by gRPC and HTTP services, but a connection serves only one of them.
+    if (http_mode) {
+      return static_cast<Http2ResponseProtocol*>(context->GetResponseMsg().get())->http2_response;
+    }
     auto grpc_unary_response = static_cast<GrpcUnaryResponseProtocol*>(context->GetResponseMsg().get());
     http2_response = grpc_unary_response->GetHttp2Response();
   } catch (std::bad_any_cast& e) {
@@ -152,7 +167,7 @@ http2::ResponsePtr GetHttp2Response(const std::any& msg) {
 }  // namespace
 
 int DefaultGrpcServerStreamHandler::EncodeTransportMessage(IoMessage* msg) {
-  http2::ResponsePtr http2_response = GetHttp2Response(msg->msg);
+  http2::ResponsePtr http2_response = GetHttp2Response(msg->msg, http_mode_);
   if (TRPC_UNLIKELY(!http2_response)) {
     return -1;
   }
@@ -170,7 +185,7 @@ bool FiberGrpcServerStreamHandler::Init() {
 }
 
 int FiberGrpcServerStreamHandler::EncodeTransportMessage(IoMessage* msg) {
-  http2::ResponsePtr http2_response = GetHttp2Response(msg->msg);
+  http2::ResponsePtr http2_response = GetHttp2Response(msg->msg, http_mode_);
   if (TRPC_UNLIKELY(!http2_response)) {
     return -1;
   }
@@ -192,6 +207,12 @@ int FiberGrpcServerStreamHandler::ParseMessage(NoncontiguousBuffer* in, std::deq
   return GrpcServerStreamHandler::ParseMessage(in, out);
 }
 
+int FiberGrpcServerStreamHandler::UpgradeFromHttp1(http2::RequestPtr& request, std::string_view settings_payload,
+                                                   std::deque<std::any>* out) {
+  std::unique_lock lock(session_mutex_);
+  return GrpcServerStreamHandler::UpgradeFromHttp1(request, settings_payload, out);
+}
+
 int FiberGrpcServerStreamHandler::RemoveStream(uint32_t stream_id) {
   std::unique_lock lk(stream_mutex_);
   // The connection is closed and the map is no longer updated.
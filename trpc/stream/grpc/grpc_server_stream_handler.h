@@ -13,6 +13,9 @@
 
 #pragma once
 
+#include <string_view>
+
+#include "trpc/codec/grpc/http2/request.h"
 #include "trpc/codec/grpc/http2/response.h"
 #include "trpc/codec/grpc/http2/session.h"
 #include "trpc/codec/server_codec_factory.h"
@@ -49,6 +52,18 @@ class GrpcServerStreamHandler : public StreamHandler {
   void SetSession(std::unique_ptr<http2::Session>&& session) { session_ = std::move(session); }
   http2::Session* GetSession() { return session_.get(); }
 
+  // @brief Serves HTTP services ("http2" protocol) instead of gRPC services, whose response messages are
+  // `Http2ResponseProtocol`.
+  void SetHttpMode(bool http_mode) { http_mode_ = http_mode; }
+
+  // @brief Upgrades the HTTP2 session from HTTP/1.1 (h2c), it must be called after `Init`.
+  // @param request is the request which asked for upgrading, it becomes the request of stream 1.
+  // @param settings_payload is the SETTINGS frame payload decoded from "HTTP2-Settings" header.
+  // @param out is the checked out request of stream 1.
+  // @return Returns 0 on success, -1 indicates an error.
+  virtual int UpgradeFromHttp1(http2::RequestPtr& request, std::string_view settings_payload,
+                               std::deque<std::any>* out);
+
  protected:
   // @brief Submit the HTTP/2 response and write the available data to the buffer.
   int EncodeHttp2Response(const http2::ResponsePtr& response, NoncontiguousBuffer* buffer);
@@ -59,6 +74,8 @@ class GrpcServerStreamHandler : public StreamHandler {
   StreamOptions options_;
   // HTTP/2 session that manages HTTP/2 streams and protocol encoding/decoding.
   std::unique_ptr<http2::Session> session_{nullptr};
+  // Whether it serves HTTP services rather than gRPC services.
+  bool http_mode_{false};
 
  private:
   // Save the variables of the checked package in the session callback. In CheckMessage, the checked package will be
@@ -107,6 +124,9 @@ class FiberGrpcServerStreamHandler : public GrpcServerStreamHandler {
 
   int ParseMessage(NoncontiguousBuffer* in, std::deque<std::any>* out) override;
 
+  int UpgradeFromHttp1(http2::RequestPtr& request, std::string_view settings_payload,
+                       std::deque<std::any>* out) override;
+
   int EncodeTransportMessage(IoMessage* msg) override;
 
  private:
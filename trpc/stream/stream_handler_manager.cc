@@ -56,25 +56,35 @@ bool InitStreamHandler() {
     return stream_handler;
   });
 
-  // gRPC.
-  ServerStreamHandlerFactory::GetInstance()->Register("grpc", [](StreamOptions&& options) {
-    StreamHandlerPtr stream_handler;
-    if (options.fiber_mode) {
-      stream_handler = MakeRefCounted<FiberGrpcServerStreamHandler>(std::move(options));
-    } else {
-      stream_handler = MakeRefCounted<DefaultGrpcServerStreamHandler>(std::move(options));
-    }
-    return stream_handler;
-  });
-  ClientStreamHandlerFactory::GetInstance()->Register("grpc", [](StreamOptions&& options) {
-    StreamHandlerPtr stream_handler;
-    if (options.fiber_mode) {
-      stream_handler = MakeRefCounted<GrpcFiberClientStreamHandler>(std::move(options));
-    } else {
-      stream_handler = MakeRefCounted<GrpcDefaultClientStreamHandler>(std::move(options));
-    }
-    return stream_handler;
-  });
+  // gRPC, HTTP/2 shares the same stream handler with gRPC.
+  auto create_grpc_server_stream_handler = [](bool http_mode) {
+    return [http_mode](StreamOptions&& options) {
+      RefPtr<GrpcServerStreamHandler> stream_handler;
+      if (options.fiber_mode) {
+        stream_handler = MakeRefCounted<FiberGrpcServerStreamHandler>(std::move(options));
+      } else {
+        stream_handler = MakeRefCounted<DefaultGrpcServerStreamHandler>(std::move(options));
+      }
+      stream_handler->SetHttpMode(http_mode);
+      return StreamHandlerPtr(std::move(stream_handler));
+    };
+  };
+  auto create_grpc_client_stream_handler = [](bool http_mode) {
+    return [http_mode](StreamOptions&& options) {
+      RefPtr<GrpcClientStreamHandler> stream_handler;
+      if (options.fiber_mode) {
+        stream_handler = MakeRefCounted<GrpcFiberClientStreamHandler>(std::move(options));
+      } else {
+        stream_handler = MakeRefCounted<GrpcDefaultClientStreamHandler>(std::move(options));
+      }
+      stream_handler->SetHttpMode(http_mode);
+      return StreamHandlerPtr(std::move(stream_handler));
+    };
+  };
+  ServerStreamHandlerFactory::GetInstance()->Register("grpc", create_grpc_server_stream_handler(false));
+  ClientStreamHandlerFactory::GetInstance()->Register("grpc", create_grpc_client_stream_handler(false));
+  ServerStreamHandlerFactory::GetInstance()->Register("http2", create_grpc_server_stream_handler(true));
+  ClientStreamHandlerFactory::GetInstance()->Register("http2", create_grpc_client_stream_handler(true));
 
   return true;
 }
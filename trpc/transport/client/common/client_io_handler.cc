@@ -54,4 +54,11 @@ int ClientIoHandler::Writev(const iovec* iov, int iovcnt) {
   return ::writev(conn_->GetFd(), iov, iovcnt);
 }
 
+int ClientIoHandler::WritevZeroCopy(const iovec* iov, int iovcnt) {
+  msghdr msg = {};
+  msg.msg_iov = const_cast<iovec*>(iov);
+  msg.msg_iovlen = iovcnt;
+  return ::sendmsg(conn_->GetFd(), &msg, MSG_ZEROCOPY);
+}
+
 }  // namespace trpc
@@ -35,6 +35,8 @@ class ClientIoHandler : public IoHandler {
 
   int Writev(const iovec* iov, int iovcnt) override;
 
+  int WritevZeroCopy(const iovec* iov, int iovcnt) override;
+
  private:
   Connection* conn_{nullptr};
 
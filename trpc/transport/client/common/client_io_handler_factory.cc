@@ -13,6 +13,8 @@
 
 #include "trpc/transport/client/common/client_io_handler_factory.h"
 
+#include <string>
+
 #include "trpc/runtime/iomodel/reactor/common/default_io_handler.h"
 #include "trpc/transport/client/common/client_io_handler.h"
 #ifdef TRPC_BUILD_INCLUDE_SSL
@@ -28,8 +30,9 @@ namespace trpc {
 namespace ssl {
 IoHandler* CreateIoHandler(const SslContextPtr& ssl_ctx, const ClientSslOptions& ssl_options, Connection* conn) {
   if (!ssl_ctx) return nullptr;
-  // Creates SSL as client
-  ssl::SslPtr ssl = CreateClientSsl(ssl_ctx, ssl_options, conn->GetFd());
+  // Creates SSL as client, resumes the session of the same peer if any
+  std::string peer_endpoint = conn->GetPeerIp() + ":" + std::to_string(conn->GetPeerPort());
+  ssl::SslPtr ssl = CreateClientSsl(ssl_ctx, ssl_options, conn->GetFd(), peer_endpoint);
   if (ssl != nullptr) {
     return new SslIoHandler(conn, std::move(ssl));
   }
@@ -0,0 +1,70 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+#include "trpc/transport/client/fiber/common/call_context.h"
+#include "trpc/transport/client/fiber/common/call_slot_table.h"
+#include "trpc/util/ref_ptr.h"
+
+namespace trpc {
+
+/// @brief Map for request id/context
+class CallMap : public RefCounted<CallMap> {
+ public:
+  /// @param size The expected max number of calls in flight, see `CallSlotTable`.
+  explicit CallMap(std::size_t size = kCallSlotTableSize) : ctxs_(size) {}
+
+  ~CallMap() {
+    ctxs_.ForEach([](auto&& k, auto&& v) { Free(v); });
+  }
+
+  /// @return The context allocated and locked, nullptr if a call with `correlation_id` is already in flight.
+  std::pair<CallContext*, std::unique_lock<Spinlock>> AllocateContext(uint32_t correlation_id) {
+    auto ptr = object_pool::MakeLwUnique<CallContext>();
+    auto result = std::pair(ptr.Get(), std::unique_lock(ptr->lock));
+    if (!ctxs_.Insert(correlation_id, ptr.Get())) {
+      result.second.unlock();
+      return {nullptr, std::unique_lock<Spinlock>()};
+    }
+    ptr.Leak();
+    return result;
+  }
+
+  object_pool::LwUniquePtr<CallContext> TryReclaimContext(uint32_t correlation_id) {
+    object_pool::LwUniquePtr<CallContext> ptr;
+    ptr.Reset(ctxs_.Remove(correlation_id));
+    return ptr;
+  }
+
+  template <class F>
+  void ForEach(F&& f) {
+    ctxs_.ForEach([&](auto&& k, auto&& v) { f(k, v); });
+  }
+
+ private:
+  static void Free(CallContext* ctx) {
+    object_pool::LwUniquePtr<CallContext> ptr;
+    ptr.Reset(ctx);
+  }
+
+ private:
+  CallSlotTable<CallContext> ctxs_;
+};
+
+}  // namespace trpc
@@ -0,0 +1,193 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "trpc/util/align.h"
+#include "trpc/util/likely.h"
+
+namespace trpc {
+
+/// @brief Default number of slots of `CallSlotTable`, rounded up to the power of 2.
+constexpr std::size_t kCallSlotTableSize = 1024;
+
+/// @brief Number of consecutive slots probed for a correlation id, starting from its home slot.
+constexpr std::size_t kCallSlotTableProbes = 16;
+
+/// @brief Number of shards of the overflow map of `CallSlotTable`.
+constexpr std::size_t kCallSlotTableOverflowShards = 32;
+
+/// @brief Lock-free table of in-flight calls keyed by correlation id, holding pointers to `T`.
+/// @note  Correlation ids are generated sequentially, so the ids in flight on a connection are (nearly) consecutive and
+///        each of them gets its own slot by indexing with the low bits of the id directly. A slot is claimed and
+///        released by CAS on a single word holding the id, the slot state and a generation, which is bumped every time
+///        the slot is released, so a reclaimer never takes a value inserted after it has read the slot.
+///        Ids whose probe window is full (more calls in flight than slots) go to an overflow map, sharded by id so
+///        that a burst beyond the table size doesn't serialize all the calls of the connection on one lock.
+///        The table never owns the values, the caller is responsible for the values left in it.
+template <class T>
+class CallSlotTable {
+ public:
+  explicit CallSlotTable(std::size_t size = kCallSlotTableSize) {
+    std::size_t capacity = kCallSlotTableProbes;
+    while (capacity < size) {
+      capacity <<= 1;
+    }
+    mask_ = capacity - 1;
+    slots_ = std::make_unique<Slot[]>(capacity);
+  }
+
+  /// @brief Insert `value` with `correlation_id`.
+  /// @return false if `correlation_id` is already in the table (e.g. the id has wrapped around while an old call with
+  ///         the same id is still in flight), nothing is inserted in this case.
+  bool Insert(std::uint32_t correlation_id, T* value) {
+    // An id only ever lives in its own probe window or in its overflow shard, so checking both is enough to reject a
+    // duplicate. Concurrent inserts of the same id are not expected, ids come from a sequential generator.
+    for (std::size_t i = 0; i != kCallSlotTableProbes; ++i) {
+      std::uint64_t word = slots_[(correlation_id + i) & mask_].word.load(std::memory_order_acquire);
+      if (GetState(word) != kFree && GetId(word) == correlation_id) {
+        return false;
+      }
+    }
+    if (TRPC_UNLIKELY(overflow_size_.load(std::memory_order_acquire) != 0)) {
+      OverflowShard& shard = GetOverflowShard(correlation_id);
+      std::scoped_lock _(shard.lock);
+      if (shard.map.count(correlation_id) != 0) {
+        return false;
+      }
+    }
+
+    for (std::size_t i = 0; i != kCallSlotTableProbes; ++i) {
+      Slot& slot = slots_[(correlation_id + i) & mask_];
+      std::uint64_t word = slot.word.load(std::memory_order_relaxed);
+      if (GetState(word) != kFree) {
+        continue;
+      }
+      // Reserve the slot before filling in the value, and publish both by the release store.
+      std::uint64_t reserved = MakeWord(GetGeneration(word), kReserved, correlation_id);
+      if (slot.word.compare_exchange_strong(word, reserved, std::memory_order_acquire, std::memory_order_relaxed)) {
+        slot.value.store(value, std::memory_order_relaxed);
+        slot.word.store(MakeWord(GetGeneration(word), kOccupied, correlation_id), std::memory_order_release);
+        return true;
+      }
+    }
+
+    OverflowShard& shard = GetOverflowShard(correlation_id);
+    std::scoped_lock _(shard.lock);
+    if (!shard.map.emplace(correlation_id, value).second) {
+      return false;
+    }
+    overflow_size_.fetch_add(1, std::memory_order_release);
+    return true;
+  }
+
+  /// @brief Remove the value of `correlation_id` from the table.
+  /// @return The value removed, nullptr if `correlation_id` is not found (e.g. the call has timed out).
+  T* Remove(std::uint32_t correlation_id) {
+    for (std::size_t i = 0; i != kCallSlotTableProbes; ++i) {
+      Slot& slot = slots_[(correlation_id + i) & mask_];
+      std::uint64_t word = slot.word.load(std::memory_order_acquire);
+      if (GetState(word) != kOccupied || GetId(word) != correlation_id) {
+        continue;
+      }
+      // The value read is stable as long as the CAS below succeeds, the slot can't be refilled without bumping the
+      // generation.
+      T* value = slot.value.load(std::memory_order_relaxed);
+      std::uint64_t released = MakeWord(GetGeneration(word) + 1, kFree, 0);
+      if (slot.word.compare_exchange_strong(word, released, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+        return value;
+      }
+      // Removed by someone else concurrently.
+      return nullptr;
+    }
+
+    if (TRPC_LIKELY(overflow_size_.load(std::memory_order_acquire) == 0)) {
+      return nullptr;
+    }
+
+    OverflowShard& shard = GetOverflowShard(correlation_id);
+    std::scoped_lock _(shard.lock);
+    if (auto iter = shard.map.find(correlation_id); iter != shard.map.end()) {
+      T* value = iter->second;
+      shard.map.erase(iter);
+      overflow_size_.fetch_sub(1, std::memory_order_relaxed);
+      return value;
+    }
+    return nullptr;
+  }
+
+  /// @brief Traverse the values in the table.
+  /// @note  Values inserted or removed concurrently may or may not be visited, and a visited value may be removed by
+  ///        others at any time, so `f` should only take the ids for processing afterwards.
+  template <class F>
+  void ForEach(F&& f) {
+    for (std::size_t i = 0; i <= mask_; ++i) {
+      Slot& slot = slots_[i];
+      std::uint64_t word = slot.word.load(std::memory_order_acquire);
+      if (GetState(word) == kOccupied) {
+        f(GetId(word), slot.value.load(std::memory_order_relaxed));
+      }
+    }
+
+    if (overflow_size_.load(std::memory_order_acquire) != 0) {
+      for (std::size_t i = 0; i != kCallSlotTableOverflowShards; ++i) {
+        std::scoped_lock _(overflow_[i].lock);
+        for (auto&& [k, v] : overflow_[i].map) {
+          f(k, v);
+        }
+      }
+    }
+  }
+
+ private:
+  // Layout of `Slot::word`: | generation (30 bits) | state (2 bits) | correlation id (32 bits) |
+  enum State : std::uint64_t { kFree = 0, kReserved = 1, kOccupied = 2 };
+
+  static constexpr std::uint64_t MakeWord(std::uint64_t generation, State state, std::uint32_t id) {
+    return (generation << 34) | (static_cast<std::uint64_t>(state) << 32) | id;
+  }
+  static constexpr std::uint64_t GetGeneration(std::uint64_t word) { return word >> 34; }
+  static constexpr State GetState(std::uint64_t word) { return static_cast<State>((word >> 32) & 0x3); }
+  static constexpr std::uint32_t GetId(std::uint64_t word) { return static_cast<std::uint32_t>(word); }
+
+  struct Slot {
+    std::atomic<std::uint64_t> word{0};
+    std::atomic<T*> value{nullptr};
+  };
+
+  struct alignas(hardware_destructive_interference_size) OverflowShard {
+    std::mutex lock;
+    std::unordered_map<std::uint32_t, T*> map;
+  };
+
+  OverflowShard& GetOverflowShard(std::uint32_t correlation_id) {
+    return overflow_[correlation_id % kCallSlotTableOverflowShards];
+  }
+
+  std::size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+
+  // Calls not fitting into the probe window, rarely used.
+  std::atomic<std::size_t> overflow_size_{0};
+  std::unique_ptr<OverflowShard[]> overflow_ = std::make_unique<OverflowShard[]>(kCallSlotTableOverflowShards);
+};
+
+}  // namespace trpc
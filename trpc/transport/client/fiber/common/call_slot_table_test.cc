@@ -0,0 +1,151 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/transport/client/fiber/common/call_slot_table.h"
+
+#include <atomic>
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+TEST(CallSlotTable, InsertAndRemove) {
+  CallSlotTable<int> table(64);
+  int values[3];
+
+  ASSERT_TRUE(table.Insert(1, &values[0]));
+  ASSERT_TRUE(table.Insert(2, &values[1]));
+  // Same home slot as 1.
+  ASSERT_TRUE(table.Insert(65, &values[2]));
+
+  ASSERT_EQ(table.Remove(3), nullptr);
+  ASSERT_EQ(table.Remove(65), &values[2]);
+  ASSERT_EQ(table.Remove(65), nullptr);
+  ASSERT_EQ(table.Remove(1), &values[0]);
+  ASSERT_EQ(table.Remove(2), &values[1]);
+  ASSERT_EQ(table.Remove(2), nullptr);
+}
+
+TEST(CallSlotTable, Overflow) {
+  CallSlotTable<int> table(kCallSlotTableProbes);
+  std::vector<int> values(kCallSlotTableProbes * 4);
+
+  for (std::uint32_t i = 0; i != values.size(); ++i) {
+    ASSERT_TRUE(table.Insert(i, &values[i]));
+  }
+
+  std::set<std::uint32_t> ids;
+  table.ForEach([&](std::uint32_t id, int* value) {
+    ASSERT_EQ(value, &values[id]);
+    ids.insert(id);
+  });
+  ASSERT_EQ(ids.size(), values.size());
+
+  for (std::uint32_t i = 0; i != values.size(); ++i) {
+    ASSERT_EQ(table.Remove(i), &values[i]);
+  }
+  table.ForEach([](std::uint32_t id, int* value) { FAIL(); });
+}
+
+TEST(CallSlotTable, DuplicateId) {
+  CallSlotTable<int> table(kCallSlotTableProbes);
+  std::vector<int> values(kCallSlotTableProbes * 2);
+
+  // The first half fills the slots, the second half goes to the overflow map.
+  for (std::uint32_t i = 0; i != values.size(); ++i) {
+    ASSERT_TRUE(table.Insert(i, &values[i]));
+  }
+  int duplicate;
+  ASSERT_FALSE(table.Insert(1, &duplicate));
+  ASSERT_FALSE(table.Insert(kCallSlotTableProbes + 1, &duplicate));
+
+  ASSERT_EQ(table.Remove(1), &values[1]);
+  ASSERT_EQ(table.Remove(kCallSlotTableProbes + 1), &values[kCallSlotTableProbes + 1]);
+  ASSERT_TRUE(table.Insert(1, &duplicate));
+  ASSERT_TRUE(table.Insert(kCallSlotTableProbes + 1, &duplicate));
+  ASSERT_EQ(table.Remove(1), &duplicate);
+  ASSERT_EQ(table.Remove(kCallSlotTableProbes + 1), &duplicate);
+}
+
+TEST(CallSlotTable, ConcurrentRemove) {
+  constexpr std::uint32_t kIds = 1000;
+  CallSlotTable<int> table;
+  int value;
+  std::atomic<int> removed{0};
+
+  // Each id is inserted once and removed by one of the racing threads exactly once, like a response racing with its
+  // timeout.
+  for (std::uint32_t i = 0; i != kIds; ++i) {
+    ASSERT_TRUE(table.Insert(i, &value));
+    std::vector<std::thread> threads;
+    for (int j = 0; j != 4; ++j) {
+      threads.emplace_back([&, i] {
+        if (table.Remove(i) != nullptr) {
+          removed.fetch_add(1);
+        }
+      });
+    }
+    for (auto&& t : threads) {
+      t.join();
+    }
+    if (i % 100 == 0) {
+      ASSERT_EQ(removed.load(), i + 1);
+    }
+  }
+  ASSERT_EQ(removed.load(), kIds);
+}
+
+TEST(CallSlotTable, ConcurrentInsertAndRemove) {
+  constexpr int kThreads = 8;
+  constexpr std::uint32_t kCallsPerThread = 100000;
+  constexpr std::uint32_t kInflight = 64;
+  CallSlotTable<std::uint32_t> table;
+  std::atomic<std::uint32_t> next_id{0};
+  std::atomic<bool> failed{false};
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kThreads; ++t) {
+    threads.emplace_back([&] {
+      // Ids come from a shared generator, the same as a service proxy issuing calls from many threads.
+      std::vector<std::uint32_t> ids(kInflight);
+      std::vector<std::uint32_t> values(kInflight);
+      for (std::uint32_t i = 0; i != kCallsPerThread; ++i) {
+        auto index = i % kInflight;
+        if (i >= kInflight && table.Remove(ids[index]) != &values[index]) {
+          failed = true;
+        }
+        ids[index] = next_id.fetch_add(1);
+        if (!table.Insert(ids[index], &values[index])) {
+          failed = true;
+        }
+      }
+      for (std::uint32_t i = 0; i != kInflight; ++i) {
+        if (table.Remove(ids[i]) != &values[i]) {
+          failed = true;
+        }
+      }
+    });
+  }
+  for (auto&& t : threads) {
+    t.join();
+  }
+
+  ASSERT_FALSE(failed.load());
+  table.ForEach([](std::uint32_t id, std::uint32_t* value) { FAIL(); });
+}
+
+}  // namespace trpc::testing
@@ -42,7 +42,7 @@ FiberTcpConnComplexConnector::FiberTcpConnComplexConnector(const Options& option
 FiberTcpConnComplexConnector::~FiberTcpConnComplexConnector() {}
 
 bool FiberTcpConnComplexConnector::Init() {
-  call_map_ = MakeRefCounted<CallMap>();
+  call_map_ = MakeRefCounted<CallMap>(options_.trans_info->fiber_max_inflight_calls_per_conn);
   return CreateFiberTcpConnection(options_.conn_id);
 }
 
@@ -270,6 +270,11 @@ bool FiberTcpConnComplexConnector::SaveCallContext(CTransportReqMsg* req_msg, CT
 
   uint32_t request_id = req_msg->context->GetRequestId();
   auto&& [ctx, lock] = call_map_->AllocateContext(request_id);
+  if (TRPC_UNLIKELY(ctx == nullptr)) {
+    TRPC_FMT_ERROR("request_id {} is already in flight on this connection", request_id);
+    cb(TrpcRetCode::TRPC_INVOKE_UNKNOWN_ERR, "duplicate request id.");
+    return false;
+  }
   (void)lock;
   ctx->req_msg = req_msg;
   ctx->rsp_msg = rsp_msg;
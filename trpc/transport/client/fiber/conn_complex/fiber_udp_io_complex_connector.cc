@@ -44,7 +44,7 @@ FiberUdpIoComplexConnector::~FiberUdpIoComplexConnector() {
 }
 
 bool FiberUdpIoComplexConnector::Init() {
-  call_map_ = MakeRefCounted<CallMap>();
+  call_map_ = MakeRefCounted<CallMap>(options_.trans_info->fiber_max_inflight_calls_per_conn);
   return CreateFiberUdpTransceiver(options_.conn_id);
 }
 
@@ -172,10 +172,15 @@ bool FiberUdpIoComplexConnector::MessageHandleFunction(const ConnectionPtr& conn
   return conn_reusable;
 }
 
-void FiberUdpIoComplexConnector::SaveCallContext(CTransportReqMsg* req_msg, CTransportRspMsg* rsp_msg,
+bool FiberUdpIoComplexConnector::SaveCallContext(CTransportReqMsg* req_msg, CTransportRspMsg* rsp_msg,
                                                  OnCompletionFunction&& cb) {
   uint32_t request_id = req_msg->context->GetRequestId();
   auto&& [ctx, lock] = call_map_->AllocateContext(request_id);
+  if (TRPC_UNLIKELY(ctx == nullptr)) {
+    TRPC_FMT_ERROR("request_id {} is already in flight on this connection", request_id);
+    cb(TrpcRetCode::TRPC_INVOKE_UNKNOWN_ERR, "duplicate request id.");
+    return false;
+  }
   (void)lock;
   ctx->req_msg = req_msg;
   ctx->rsp_msg = rsp_msg;
@@ -185,6 +190,8 @@ void FiberUdpIoComplexConnector::SaveCallContext(CTransportReqMsg* req_msg, CTra
 
   ctx->timeout_timer = CreateTimer(req_msg);
   EnableFiberTimer(ctx->timeout_timer);
+
+  return true;
 }
 
 uint64_t FiberUdpIoComplexConnector::CreateTimer(CTransportReqMsg* req_msg) {
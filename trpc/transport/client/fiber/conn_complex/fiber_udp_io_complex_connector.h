@@ -24,7 +24,7 @@
 
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_udp_transceiver.h"
 #include "trpc/transport/client/client_transport_message.h"
-#include "trpc/transport/client/fiber/common/sharded_call_map.h"
+#include "trpc/transport/client/fiber/common/call_map.h"
 #include "trpc/transport/client/trans_info.h"
 #include "trpc/util/align.h"
 #include "trpc/util/object_pool/object_pool_ptr.h"
@@ -54,7 +54,7 @@ class FiberUdpIoComplexConnector final : public RefCounted<FiberUdpIoComplexConn
 
   uint64_t GetConnId() { return options_.conn_id; }
 
-  void SaveCallContext(CTransportReqMsg* req_msg, CTransportRspMsg* rsp_msg, OnCompletionFunction&& cb);
+  bool SaveCallContext(CTransportReqMsg* req_msg, CTransportRspMsg* rsp_msg, OnCompletionFunction&& cb);
 
  private:
   bool MessageHandleFunction(const ConnectionPtr& conn, std::deque<std::any>& rsp_list);
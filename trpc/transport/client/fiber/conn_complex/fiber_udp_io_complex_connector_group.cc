@@ -70,17 +70,19 @@ int FiberUdpIoComplexConnectorGroup::SendRecv(CTransportReqMsg* req_msg, CTransp
   if (connector != nullptr) {
     FiberEvent e;
     // save request context
-    connector->SaveCallContext(req_msg, rsp_msg,
-                               [&e, &ret](uint32_t err_code, std::string&& err_msg) {
-                                 ret = err_code;
-                                 if (ret != 0) {
-                                   TRPC_LOG_WARN(err_msg);
-                                 }
-                                 e.Set();
-                               });
-    connector->SendReqMsg(req_msg);
-
-    e.Wait();
+    bool flag = connector->SaveCallContext(req_msg, rsp_msg,
+                                           [&e, &ret](uint32_t err_code, std::string&& err_msg) {
+                                             ret = err_code;
+                                             if (ret != 0) {
+                                               TRPC_LOG_WARN(err_msg);
+                                             }
+                                             e.Set();
+                                           });
+    if (flag) {
+      connector->SendReqMsg(req_msg);
+
+      e.Wait();
+    }
   }
 
   return ret;
@@ -93,7 +95,7 @@ Future<CTransportRspMsg> FiberUdpIoComplexConnectorGroup::AsyncSendRecv(CTranspo
     auto fut = promise.GetFuture();
     CTransportRspMsg* rsp_msg = trpc::object_pool::New<CTransportRspMsg>();
     // save request context
-    connector->SaveCallContext(
+    bool flag = connector->SaveCallContext(
         req_msg, rsp_msg, [promise = std::move(promise), rsp_msg](uint32_t err_code, std::string&& err_msg) mutable {
           if (err_code == 0) {
             promise.SetValue(std::move(*rsp_msg));
@@ -103,7 +105,9 @@ Future<CTransportRspMsg> FiberUdpIoComplexConnectorGroup::AsyncSendRecv(CTranspo
           }
           trpc::object_pool::Delete(rsp_msg);
         });
-    connector->SendReqMsg(req_msg);
+    if (flag) {
+      connector->SendReqMsg(req_msg);
+    }
 
     return fut;
   }
@@ -52,7 +52,7 @@ FiberTcpPipelineConnector::~FiberTcpPipelineConnector() {
 }
 
 bool FiberTcpPipelineConnector::Init() {
-  call_map_ = MakeRefCounted<CallMap>();
+  call_map_ = MakeRefCounted<CallMap>(options_.trans_info->fiber_max_inflight_calls_per_conn);
   return CreateFiberTcpConnection(options_.conn_id);
 }
 
@@ -318,6 +318,11 @@ bool FiberTcpPipelineConnector::SaveCallContext(CTransportReqMsg* req_msg, CTran
 
   uint32_t request_id = req_msg->context->GetRequestId();
   auto&& [ctx, lock] = call_map_->AllocateContext(request_id);
+  if (TRPC_UNLIKELY(ctx == nullptr)) {
+    TRPC_FMT_ERROR("request_id {} is already in flight on this connection", request_id);
+    cb(TrpcRetCode::TRPC_INVOKE_UNKNOWN_ERR, "duplicate request id.");
+    return false;
+  }
   (void)lock;
   ctx->req_msg = req_msg;
   ctx->rsp_msg = rsp_msg;
@@ -24,7 +24,7 @@
 
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_tcp_connection.h"
 #include "trpc/transport/client/client_transport_message.h"
-#include "trpc/transport/client/fiber/common/sharded_call_map.h"
+#include "trpc/transport/client/fiber/common/call_map.h"
 #include "trpc/transport/client/trans_info.h"
 #include "trpc/util/align.h"
 #include "trpc/util/lockfree_queue.h"
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <any>
+#include <optional>
 #include <string>
 
 #include "trpc/codec/protocol.h"
@@ -102,6 +103,10 @@ struct TransInfo {
   /// if memory usage high, reduce it
   uint32_t fiber_pipeline_connector_queue_size = 16 * 1024;
 
+  /// The expected max number of in-flight calls per connection of fiber complex/pipeline connectors, which sizes
+  /// their call tables (16 bytes per call), calls beyond it are kept in a slower overflow map
+  uint32_t fiber_max_inflight_calls_per_conn = 1024;
+
   /// The callback function when connection establish
   ConnectionEstablishFunction conn_establish_function = nullptr;
 
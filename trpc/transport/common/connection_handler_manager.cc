@@ -31,7 +31,7 @@ namespace trpc {
 bool InitConnectionHandler() {
   // Here we only register special ConnectionHandlers. If the codec cannot be found, the default ConnectionHandler
   // will be used as a fallback.
-  // 1. For all protocols other than trpc/grpc, the framework uses the default ConnectionHandler.
+  // 1. For all protocols other than trpc/grpc/http2, the framework uses the default ConnectionHandler.
   // 2. For business-customized protocols that do not require special ConnectionHandler processing, they all use the
   // default ConnectionHandler.
 
@@ -48,6 +48,12 @@ bool InitConnectionHandler() {
       });
   TRPC_ASSERT(register_ret && "Register grpc server connection handler failed at fiber mode");
 
+  register_ret = FiberServerConnectionHandlerFactory::GetInstance()->Register(
+      "http2", [](Connection* c, FiberBindAdapter* a, BindInfo* i) {
+        return std::make_unique<stream::FiberGrpcServerStreamConnectionHandler>(c, a, i);
+      });
+  TRPC_ASSERT(register_ret && "Register http2 server connection handler failed at fiber mode");
+
   // Registers fiber connection handler which used by client.
   register_ret = FiberClientConnectionHandlerFactory::GetInstance()->Register("trpc", [](Connection* c, TransInfo* t) {
     return std::make_unique<stream::FiberTrpcClientStreamConnectionHandler>(c, t);
@@ -59,6 +65,11 @@ bool InitConnectionHandler() {
   });
   TRPC_ASSERT(register_ret && "Register http client connection handler failed at fiber mode");
 
+  register_ret = FiberClientConnectionHandlerFactory::GetInstance()->Register("http2", [](Connection* c, TransInfo* t) {
+    return std::make_unique<stream::FiberGrpcClientStreamConnectionHandler>(c, t);
+  });
+  TRPC_ASSERT(register_ret && "Register http2 client connection handler failed at fiber mode");
+
   register_ret = FiberClientConnectionHandlerFactory::GetInstance()->Register("http", [](Connection* c, TransInfo* t) {
     return std::make_unique<stream::FiberHttpClientStreamConnectionHandler>(c, t);
   });
@@ -77,6 +88,12 @@ bool InitConnectionHandler() {
       });
   TRPC_ASSERT(register_ret && "Register trpc server connection handler failed at default mode");
 
+  register_ret = DefaultServerConnectionHandlerFactory::GetInstance()->Register(
+      "http2", [](Connection* c, BindAdapter* a, BindInfo* i) {
+        return std::make_unique<stream::DefaultGrpcServerStreamConnectionHandler>(c, a, i);
+      });
+  TRPC_ASSERT(register_ret && "Register http2 server connection handler failed at default mode");
+
   register_ret = DefaultServerConnectionHandlerFactory::GetInstance()->Register(
       "http", [](Connection* c, BindAdapter* a, BindInfo* i) {
         return std::make_unique<stream::DefaultHttpServerStreamConnectionHandler>(c, a, i);
@@ -97,6 +114,12 @@ bool InitConnectionHandler() {
       });
   TRPC_ASSERT(register_ret && "Register grpc client connection handler failed at default mode(use conn_complex)");
 
+  register_ret = FutureConnComplexConnectionHandlerFactory::GetIntance()->Register(
+      "http2", [](const FutureConnectorOptions& options, FutureConnComplexMessageTimeoutHandler& handler) {
+        return std::make_unique<stream::FutureGrpcClientStreamConnComplexConnectionHandler>(options, handler);
+      });
+  TRPC_ASSERT(register_ret && "Register http2 client connection handler failed at default mode(use conn_complex)");
+
   // 2. For conn_pool.
   // Note: For trpc streaming in conn_pool:
   // Using TRPC streaming under connection pooling doesn't seem as urgent as connection reuse.
@@ -108,6 +131,12 @@ bool InitConnectionHandler() {
       });
   TRPC_ASSERT(register_ret && "Register grpc client connection handler failed at default mode(use conn_pool)");
 
+  register_ret = FutureConnPoolConnectionHandlerFactory::GetIntance()->Register(
+      "http2", [](const FutureConnectorOptions& options, FutureConnPoolMessageTimeoutHandler& handler) {
+        return std::make_unique<stream::FutureGrpcClientStreamConnPoolConnectionHandler>(options, handler);
+      });
+  TRPC_ASSERT(register_ret && "Register http2 client connection handler failed at default mode(use conn_pool)");
+
   register_ret = FutureConnPoolConnectionHandlerFactory::GetIntance()->Register(
       "http", [](const FutureConnectorOptions& options, FutureConnPoolMessageTimeoutHandler& handler) {
         return std::make_unique<stream::HttpClientAsyncStreamConnectionHandler>(options, handler);
@@ -13,24 +13,63 @@
 
 #include "trpc/transport/common/io_handler_manager.h"
 
+#include <string>
+
 #include "trpc/stream/grpc/grpc_io_handler.h"
 #include "trpc/transport/client/common/client_io_handler_factory.h"
 #include "trpc/transport/client/common/redis_client_io_handler.h"
 #include "trpc/transport/server/common/server_io_handler_factory.h"
+#ifdef TRPC_BUILD_INCLUDE_SSL
+#include "trpc/transport/common/ssl_helper.h"
+#endif
 
 namespace trpc {
 
+namespace {
+
+std::unique_ptr<IoHandler> CreateGrpcServerIoHandler(Connection* conn, const BindInfo& bind_info) {
+#ifdef TRPC_BUILD_INCLUDE_SSL
+  if (bind_info.ssl_ctx && bind_info.ssl_options) {
+    ssl::SslPtr ssl = ssl::CreateServerSsl(bind_info.ssl_ctx, bind_info.ssl_options.value(), conn->GetFd());
+    TRPC_ASSERT(ssl != nullptr);
+    return std::make_unique<GrpcSslIoHandler>(conn, std::move(ssl));
+  }
+#endif
+  return std::make_unique<GrpcIoHandler>(conn);
+}
+
+std::unique_ptr<IoHandler> CreateGrpcClientIoHandler(Connection* conn, TransInfo* trans_info) {
+#ifdef TRPC_BUILD_INCLUDE_SSL
+  if (trans_info->ssl_ctx && trans_info->ssl_options) {
+    // !!! Note: nullptr would be returned here when error has occurred.
+    std::string peer_endpoint = conn->GetPeerIp() + ":" + std::to_string(conn->GetPeerPort());
+    ssl::SslPtr ssl =
+        ssl::CreateClientSsl(trans_info->ssl_ctx, *(trans_info->ssl_options), conn->GetFd(), peer_endpoint);
+    if (ssl == nullptr) {
+      return nullptr;
+    }
+    return std::make_unique<GrpcSslIoHandler>(conn, std::move(ssl));
+  }
+#endif
+  return std::make_unique<GrpcIoHandler>(conn);
+}
+
+}  // namespace
+
 bool InitIoHandler() {
-  bool registry_ret = ServerIoHandlerFactory::GetInstance()->Register(
-      "grpc", [](Connection* conn, const BindInfo& bind_info) {
-        return std::make_unique<GrpcIoHandler>(conn); });
+  // gRPC and HTTP/2 share the same io handler, which exchanges the HTTP2 preface during handshaking.
+  bool registry_ret = ServerIoHandlerFactory::GetInstance()->Register("grpc", CreateGrpcServerIoHandler);
   TRPC_ASSERT(registry_ret && "Registry grpc server io handler failed");
 
-  registry_ret = ClientIoHandlerFactory::GetInstance()->Register(
-      "grpc", [](Connection* conn, TransInfo* trans_info) {
-        return std::make_unique<GrpcIoHandler>(conn); });
+  registry_ret = ClientIoHandlerFactory::GetInstance()->Register("grpc", CreateGrpcClientIoHandler);
   TRPC_ASSERT(registry_ret && "Registry grpc client io handler failed");
 
+  registry_ret = ServerIoHandlerFactory::GetInstance()->Register("http2", CreateGrpcServerIoHandler);
+  TRPC_ASSERT(registry_ret && "Registry http2 server io handler failed");
+
+  registry_ret = ClientIoHandlerFactory::GetInstance()->Register("http2", CreateGrpcClientIoHandler);
+  TRPC_ASSERT(registry_ret && "Registry http2 client io handler failed");
+
   registry_ret = ClientIoHandlerFactory::GetInstance()->Register("redis", [](Connection* conn, TransInfo* trans_info) {
     return std::make_unique<RedisClientIoHandler>(conn, trans_info);
   });
@@ -13,8 +13,24 @@
 
 #include "trpc/transport/common/io_handler_manager.h"
 
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
 #include "gtest/gtest.h"
 
+#include "trpc/stream/grpc/grpc_io_handler.h"
+#include "trpc/transport/client/common/client_io_handler_factory.h"
+#include "trpc/transport/server/common/server_io_handler_factory.h"
+#ifdef TRPC_BUILD_INCLUDE_SSL
+#include "trpc/transport/common/ssl/core.h"
+#include "trpc/transport/common/ssl_helper.h"
+#endif
+
 namespace trpc::testing {
 
 TEST(IoHandlerManagerTest, All) {
@@ -23,4 +39,95 @@ TEST(IoHandlerManagerTest, All) {
   DestroyIoHandler();
 }
 
+TEST(IoHandlerManagerTest, CreateGrpcIoHandler) {
+  ASSERT_TRUE(InitIoHandler());
+
+  ConnectionPtr conn = MakeRefCounted<Connection>();
+  BindInfo bind_info;
+  TransInfo trans_info;
+  for (const std::string protocol : {"grpc", "http2"}) {
+    auto server_io_handler = ServerIoHandlerFactory::GetInstance()->Create(protocol, conn.Get(), bind_info);
+    ASSERT_NE(nullptr, dynamic_cast<GrpcIoHandler*>(server_io_handler.get()));
+    auto client_io_handler = ClientIoHandlerFactory::GetInstance()->Create(protocol, conn.Get(), &trans_info);
+    ASSERT_NE(nullptr, dynamic_cast<GrpcIoHandler*>(client_io_handler.get()));
+  }
+
+  DestroyIoHandler();
+}
+
+#ifdef TRPC_BUILD_INCLUDE_SSL
+TEST(IoHandlerManagerTest, CreateGrpcSslIoHandler) {
+  ASSERT_TRUE(ssl::InitOpenSsl());
+  ASSERT_TRUE(InitIoHandler());
+
+  for (const std::string protocol : {"grpc", "http2"}) {
+    // The SSL options are initialized as services and service proxies do.
+    ServerSslConfig server_ssl_config;
+    server_ssl_config.enable = true;
+    server_ssl_config.cert_path = "./trpc/transport/common/ssl/cert/server_cert.pem";
+    server_ssl_config.private_key_path = "./trpc/transport/common/ssl/cert/server_key.pem";
+    server_ssl_config.dh_param_path = "./trpc/transport/common/ssl/cert/server_dhparam.pem";
+    server_ssl_config.ciphers = "HIGH:!aNULL:!kRSA:!SRP:!PSK:!CAMELLIA:!RC4:!MD5:!DSS";
+    server_ssl_config.protocols = {"TLSv1.2"};
+    ssl::ServerSslOptions server_ssl_options;
+    ASSERT_TRUE(ssl::InitServerSslOptions(server_ssl_config, &server_ssl_options));
+    ssl::SetDefaultAlpnProtocols(protocol, true, &server_ssl_options.alpn_protocols);
+    BindInfo bind_info;
+    bind_info.ssl_ctx = MakeRefCounted<ssl::SslContext>();
+    ASSERT_TRUE(bind_info.ssl_ctx->Init(server_ssl_options));
+    bind_info.ssl_options = std::move(server_ssl_options);
+
+    ClientSslConfig client_ssl_config;
+    client_ssl_config.enable = true;
+    client_ssl_config.insecure = true;
+    client_ssl_config.ciphers = "HIGH:!aNULL:!kRSA:!SRP:!PSK:!CAMELLIA:!RC4:!MD5:!DSS";
+    client_ssl_config.protocols = {"TLSv1.2"};
+    ssl::ClientSslOptions client_ssl_options;
+    ASSERT_TRUE(ssl::InitClientSslOptions(client_ssl_config, &client_ssl_options));
+    ssl::SetDefaultAlpnProtocols(protocol, false, &client_ssl_options.alpn_protocols);
+    TransInfo trans_info;
+    trans_info.ssl_ctx = MakeRefCounted<ssl::SslContext>();
+    ASSERT_TRUE(trans_info.ssl_ctx->Init(client_ssl_options));
+    trans_info.ssl_options = std::move(client_ssl_options);
+
+    int fds[2];
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds));
+    ConnectionPtr server_conn = MakeRefCounted<Connection>();
+    server_conn->SetFd(fds[0]);
+    ConnectionPtr client_conn = MakeRefCounted<Connection>();
+    client_conn->SetFd(fds[1]);
+
+    auto server_io_handler = ServerIoHandlerFactory::GetInstance()->Create(protocol, server_conn.Get(), bind_info);
+    auto* server_ssl_io_handler = dynamic_cast<GrpcSslIoHandler*>(server_io_handler.get());
+    ASSERT_NE(nullptr, server_ssl_io_handler);
+    auto client_io_handler = ClientIoHandlerFactory::GetInstance()->Create(protocol, client_conn.Get(), &trans_info);
+    auto* client_ssl_io_handler = dynamic_cast<GrpcSslIoHandler*>(client_io_handler.get());
+    ASSERT_NE(nullptr, client_ssl_io_handler);
+
+    // Handshakes for TLS only, the HTTP2 preface is left to the connection handlers.
+    const ssl::SslPtr& server_ssl = server_ssl_io_handler->GetSsl();
+    const ssl::SslPtr& client_ssl = client_ssl_io_handler->GetSsl();
+    int server_rc = ssl::kWantRead;
+    int client_rc = ssl::kWantRead;
+    for (int i = 0; i < 100 && (server_rc != ssl::kOk || client_rc != ssl::kOk); ++i) {
+      if (client_rc != ssl::kOk) client_rc = client_ssl->DoHandshake();
+      if (server_rc != ssl::kOk) server_rc = server_ssl->DoHandshake();
+      if (client_rc == ssl::kError || server_rc == ssl::kError) break;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(ssl::kOk, server_rc);
+    ASSERT_EQ(ssl::kOk, client_rc);
+    // "h2" is negotiated by ALPN without being configured.
+    ASSERT_EQ("h2", server_ssl->GetAlpnSelected());
+    ASSERT_EQ("h2", client_ssl->GetAlpnSelected());
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+  }
+
+  DestroyIoHandler();
+  ssl::DestroyOpenSsl();
+}
+#endif
+
 }  // namespace trpc::testing
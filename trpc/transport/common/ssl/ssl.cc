@@ -19,6 +19,8 @@
 #include <openssl/bio.h>
 #include <openssl/conf.h>
 #include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
 #include <openssl/rand.h>
 #include <openssl/rsa.h>
 #include <openssl/x509.h>
@@ -26,8 +28,16 @@
 #ifndef OPENSSL_NO_ENGINE
 #include <openssl/engine.h>
 #endif
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#endif
 
 #include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
 
 #include "trpc/transport/common/ssl/core.h"
 #include "trpc/transport/common/ssl/errno.h"
@@ -75,6 +85,39 @@ void DestroySslMutexes() {
   delete[] ssl_mutexes;
   ssl_mutexes = nullptr;
 }
+
+// Selects the first protocol of server (in `arg`) which is also offered by client.
+int SslAlpnSelectCallbackFunction(SSL* ssl, const unsigned char** out, unsigned char* outlen, const unsigned char* in,
+                                  unsigned int inlen, void* arg) {
+  const auto* protocols = static_cast<const std::string*>(arg);
+  unsigned char* selected = nullptr;
+  if (SSL_select_next_proto(&selected, outlen, reinterpret_cast<const unsigned char*>(protocols->data()),
+                            protocols->size(), in, inlen) != OPENSSL_NPN_NEGOTIATED) {
+    return SSL_TLSEXT_ERR_NOACK;
+  }
+  *out = selected;
+  return SSL_TLSEXT_ERR_OK;
+}
+
+// Statistics of session resumption, see `GetSessionResumptionStatistics`.
+std::atomic<uint64_t> server_session_hits{0};
+std::atomic<uint64_t> server_session_misses{0};
+std::atomic<uint64_t> client_session_hits{0};
+std::atomic<uint64_t> client_session_misses{0};
+
+// Keys the HMAC of a session ticket with SHA-256.
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+bool InitSessionTicketMac(EVP_MAC_CTX* mac_ctx, unsigned char* key, size_t key_len) {
+  OSSL_PARAM params[] = {OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, key, key_len),
+                         OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, const_cast<char*>("SHA256"), 0),
+                         OSSL_PARAM_construct_end()};
+  return EVP_MAC_CTX_set_params(mac_ctx, params) == 1;
+}
+#else
+bool InitSessionTicketMac(HMAC_CTX* mac_ctx, unsigned char* key, size_t key_len) {
+  return HMAC_Init_ex(mac_ctx, key, key_len, EVP_sha256(), nullptr) == 1;
+}
+#endif
 }  // namespace
 
 namespace {
@@ -297,6 +340,15 @@ uint32_t ParseProtocols(const std::vector<std::string>& protocols) {
   return default_protocols;
 }
 
+SessionResumptionStatistics GetSessionResumptionStatistics() {
+  SessionResumptionStatistics statistics;
+  statistics.server_hits = server_session_hits.load(std::memory_order_relaxed);
+  statistics.server_misses = server_session_misses.load(std::memory_order_relaxed);
+  statistics.client_hits = client_session_hits.load(std::memory_order_relaxed);
+  statistics.client_misses = client_session_misses.load(std::memory_order_relaxed);
+  return statistics;
+}
+
 const std::string& GetDefaultCiphers() {
   static std::string ciphers = R"()"
                                R"(ECDHE-RSA-AES128-GCM-SHA256:ECDHE-ECDSA-AES128-GCM-SHA256)"
@@ -313,9 +365,16 @@ const std::string& GetDefaultCiphers() {
 
 SslContext::~SslContext() {
   if (ssl_ctx_) {
+    // SSL created by this context may outlive it, keeps their callbacks away from this context.
+    SSL_CTX_set_app_data(ssl_ctx_, nullptr);
     SSL_CTX_free(ssl_ctx_);
     ssl_ctx_ = nullptr;
   }
+
+  for (auto& [key, session] : client_sessions_) {
+    SSL_SESSION_free(session);
+  }
+  client_sessions_.clear();
 }
 
 bool SslContext::Init(const ServerSslOptions& ssl_options) {
@@ -334,6 +393,17 @@ bool SslContext::Init(const ServerSslOptions& ssl_options) {
     if (!SetDhParam(ssl_options.dh_param_path)) return false;
   }
 
+  // Set ALPN
+  if (!ssl_options.alpn_protocols.empty()) {
+    if (!SetAlpnProtocols(ssl_options.alpn_protocols, true)) return false;
+  }
+
+  // Set kTLS
+  if (ssl_options.ktls) SetKtls();
+
+  // Set session cache and session tickets
+  if (!SetServerSessionResumption(ssl_options)) return false;
+
   return this->SetSslVerifyPeerOptions(ssl_options.verify_peer_options.ca_cert_path,
                                        ssl_options.verify_peer_options.verify_depth, !ssl_options.enable_verify_peer);
 }
@@ -355,6 +425,17 @@ bool SslContext::Init(const ClientSslOptions& ssl_options) {
     if (!SetDhParam(ssl_options.dh_param_path)) return false;
   }
 
+  // Set ALPN
+  if (!ssl_options.alpn_protocols.empty()) {
+    if (!SetAlpnProtocols(ssl_options.alpn_protocols, false)) return false;
+  }
+
+  // Set kTLS
+  if (ssl_options.ktls) SetKtls();
+
+  // Set session cache
+  if (!SetClientSessionResumption(ssl_options)) return false;
+
   return this->SetSslVerifyPeerOptions(ssl_options.verify_peer_options.ca_cert_path,
                                        ssl_options.verify_peer_options.verify_depth, ssl_options.insecure);
 }
@@ -652,6 +733,220 @@ bool SslContext::SetSslVerifyPeerOptions(const std::string& cert_path, int verif
   return true;
 }
 
+bool SslContext::SetAlpnProtocols(const std::vector<std::string>& protocols, bool server_mode) {
+  alpn_protocols_.clear();
+  for (const auto& protocol : protocols) {
+    if (protocol.empty() || protocol.size() > 255) {
+      TRPC_LOG_ERROR("invalid ALPN protocol: " << protocol);
+      return false;
+    }
+    alpn_protocols_.push_back(static_cast<char>(protocol.size()));
+    alpn_protocols_.append(protocol);
+  }
+
+  if (server_mode) {
+    SSL_CTX_set_alpn_select_cb(ssl_ctx_, SslAlpnSelectCallbackFunction, &alpn_protocols_);
+    return true;
+  }
+
+  // Note: returns 0 on success, unlike most OpenSSL functions.
+  if (SSL_CTX_set_alpn_protos(ssl_ctx_, reinterpret_cast<const unsigned char*>(alpn_protocols_.data()),
+                              alpn_protocols_.size()) != 0) {
+    TRPC_LOG_ERROR("SSL_CTX_set_alpn_protos() failed");
+    return false;
+  }
+  return true;
+}
+
+bool SslContext::SetServerSessionResumption(const ServerSslOptions& ssl_options) {
+  if (!ssl_options.session_resumption) {
+    SSL_CTX_set_session_cache_mode(ssl_ctx_, SSL_SESS_CACHE_OFF);
+    SSL_CTX_set_options(ssl_ctx_, SSL_OP_NO_TICKET);
+    return true;
+  }
+
+  session_cache_size_ = ssl_options.session_cache_size;
+  session_timeout_ = ssl_options.session_timeout;
+  ticket_key_rotation_interval_ = std::max<uint32_t>(ssl_options.session_ticket_key_rotation_interval, 1);
+
+  // Sessions are only resumable within the context they were established, tells contexts apart by certificate.
+  std::string sid_ctx = std::to_string(std::hash<std::string>{}(ssl_options.default_cert.cert_path));
+  if (SSL_CTX_set_session_id_context(ssl_ctx_, reinterpret_cast<const unsigned char*>(sid_ctx.data()),
+                                     sid_ctx.size()) != 1) {
+    TRPC_LOG_ERROR("SSL_CTX_set_session_id_context() failed");
+    return false;
+  }
+
+  SSL_CTX_set_session_cache_mode(ssl_ctx_, SSL_SESS_CACHE_SERVER);
+  SSL_CTX_sess_set_cache_size(ssl_ctx_, session_cache_size_);
+  SSL_CTX_set_timeout(ssl_ctx_, session_timeout_);
+
+  // Session tickets are encrypted by keys of this context rather than a key fixed for the whole life of the process,
+  // see `GetEncryptTicketKey`.
+  SSL_CTX_set_app_data(ssl_ctx_, this);
+  SSL_CTX_clear_options(ssl_ctx_, SSL_OP_NO_TICKET);
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+  if (SSL_CTX_set_tlsext_ticket_key_evp_cb(ssl_ctx_, OnSessionTicketKey) != 1) {
+#else
+  if (SSL_CTX_set_tlsext_ticket_key_cb(ssl_ctx_, OnSessionTicketKey) != 1) {
+#endif
+    TRPC_LOG_ERROR("set session ticket key callback failed");
+    return false;
+  }
+
+  return true;
+}
+
+bool SslContext::SetClientSessionResumption(const ClientSslOptions& ssl_options) {
+  if (!ssl_options.session_resumption) {
+    SSL_CTX_set_session_cache_mode(ssl_ctx_, SSL_SESS_CACHE_OFF);
+    return true;
+  }
+
+  session_cache_size_ = ssl_options.session_cache_size;
+  session_timeout_ = ssl_options.session_timeout;
+
+  // The internal cache of OpenSSL can not tell peers apart, sessions are cached by peer in `client_sessions_` instead.
+  SSL_CTX_set_session_cache_mode(ssl_ctx_, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+  SSL_CTX_set_timeout(ssl_ctx_, session_timeout_);
+  SSL_CTX_set_app_data(ssl_ctx_, this);
+  SSL_CTX_sess_set_new_cb(ssl_ctx_, OnNewClientSession);
+
+  return true;
+}
+
+void SslContext::SetKtls() {
+#ifdef SSL_OP_ENABLE_KTLS
+  // OpenSSL installs the negotiated keys into kernel by `TCP_ULP tls` once the handshake completes, and goes on in
+  // user-space silently if the kernel or the cipher does not support it.
+  SSL_CTX_set_options(ssl_ctx_, SSL_OP_ENABLE_KTLS);
+  // Records read ahead into user-space can not be handed over to kernel.
+  SSL_CTX_set_read_ahead(ssl_ctx_, 0);
+#else
+  TRPC_LOG_WARN("kTLS is not supported by " << OPENSSL_VERSION_TEXT << ", fall back to user-space TLS");
+#endif
+}
+
+int SslContext::OnNewClientSession(SSL* ssl, SSL_SESSION* session) {
+  auto* context = static_cast<SslContext*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+  auto* ssl_wrapper = static_cast<Ssl*>(SSL_get_app_data(ssl));
+  if (!context || !ssl_wrapper || ssl_wrapper->session_cache_key_.empty()) return 0;
+
+  context->PutClientSession(ssl_wrapper->session_cache_key_, session);
+  // Returns 1 to take over the reference count of `session`.
+  return 1;
+}
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+int SslContext::OnSessionTicketKey(SSL* ssl, unsigned char* key_name, unsigned char* iv, EVP_CIPHER_CTX* cipher_ctx,
+                                   EVP_MAC_CTX* mac_ctx, int enc) {
+#else
+int SslContext::OnSessionTicketKey(SSL* ssl, unsigned char* key_name, unsigned char* iv, EVP_CIPHER_CTX* cipher_ctx,
+                                   HMAC_CTX* mac_ctx, int enc) {
+#endif
+  // Returns 0 to issue no ticket when encrypting, or to do a full handshake when decrypting.
+  auto* context = static_cast<SslContext*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+  if (!context) return 0;
+
+  SessionTicketKey key;
+  int ret = 1;
+  if (enc == 1) {
+    if (!context->GetEncryptTicketKey(&key)) return 0;
+    if (RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc())) != 1) return -1;
+    memcpy(key_name, key.name, sizeof(key.name));
+    if (EVP_EncryptInit_ex(cipher_ctx, EVP_aes_256_cbc(), nullptr, key.aes_key, iv) != 1) return -1;
+  } else {
+    bool renew = false;
+    if (!context->GetDecryptTicketKey(key_name, &key, &renew)) return 0;
+    if (EVP_DecryptInit_ex(cipher_ctx, EVP_aes_256_cbc(), nullptr, key.aes_key, iv) != 1) return -1;
+    // Returns 2 to have the ticket renewed by the key in use. Clients use a TLSv1.3 ticket only once, it is always
+    // renewed to keep later connections resumable.
+    ret = (renew || SSL_version(ssl) >= TLS1_3_VERSION) ? 2 : 1;
+  }
+
+  if (!InitSessionTicketMac(mac_ctx, key.hmac_key, sizeof(key.hmac_key))) return -1;
+
+  return ret;
+}
+
+bool SslContext::GetEncryptTicketKey(SessionTicketKey* key) {
+  int64_t now = std::time(nullptr);
+
+  std::scoped_lock _(ticket_keys_mutex_);
+  if (ticket_keys_.empty() || now - ticket_keys_.front().created_time >= ticket_key_rotation_interval_) {
+    SessionTicketKey new_key;
+    if (RAND_bytes(new_key.name, sizeof(new_key.name)) != 1 ||
+        RAND_bytes(new_key.aes_key, sizeof(new_key.aes_key)) != 1 ||
+        RAND_bytes(new_key.hmac_key, sizeof(new_key.hmac_key)) != 1) {
+      TRPC_LOG_ERROR("RAND_bytes() failed, can not generate session ticket key");
+      return false;
+    }
+    new_key.created_time = now;
+    ticket_keys_.push_front(new_key);
+
+    // A key retires when its successor is generated, tickets it issued expire within `session_timeout_` since then.
+    while (ticket_keys_.size() > 1 && now - ticket_keys_[ticket_keys_.size() - 2].created_time >= session_timeout_) {
+      ticket_keys_.pop_back();
+    }
+  }
+
+  *key = ticket_keys_.front();
+  return true;
+}
+
+bool SslContext::GetDecryptTicketKey(const unsigned char* name, SessionTicketKey* key, bool* renew) {
+  int64_t now = std::time(nullptr);
+
+  std::scoped_lock _(ticket_keys_mutex_);
+  for (size_t i = 0; i < ticket_keys_.size(); ++i) {
+    if (memcmp(ticket_keys_[i].name, name, sizeof(key->name)) == 0) {
+      *key = ticket_keys_[i];
+      *renew = i > 0 || now - key->created_time >= ticket_key_rotation_interval_;
+      return true;
+    }
+  }
+  return false;
+}
+
+SSL_SESSION* SslContext::GetClientSession(const std::string& key) {
+  std::scoped_lock _(client_sessions_mutex_);
+  auto it = client_sessions_.find(key);
+  if (it == client_sessions_.end()) return nullptr;
+
+  SSL_SESSION* session = it->second;
+  if (SSL_SESSION_get_time(session) + SSL_SESSION_get_timeout(session) <= std::time(nullptr) ||
+      !SSL_SESSION_is_resumable(session)) {
+    SSL_SESSION_free(session);
+    client_sessions_.erase(it);
+    return nullptr;
+  }
+
+  SSL_SESSION_up_ref(session);
+  return session;
+}
+
+void SslContext::PutClientSession(const std::string& key, SSL_SESSION* session) {
+  std::scoped_lock _(client_sessions_mutex_);
+  auto it = client_sessions_.find(key);
+  if (it != client_sessions_.end()) {
+    // Replaces the session of the same peer, which may be `session` itself.
+    SSL_SESSION_free(it->second);
+    it->second = session;
+    return;
+  }
+
+  if (client_sessions_.size() >= session_cache_size_) {
+    if (client_sessions_.empty()) {
+      SSL_SESSION_free(session);
+      return;
+    }
+    // Evicts an arbitrary peer, a later connection to it just does a full handshake.
+    SSL_SESSION_free(client_sessions_.begin()->second);
+    client_sessions_.erase(client_sessions_.begin());
+  }
+  client_sessions_.emplace(key, session);
+}
+
 SslPtr SslContext::NewSsl() {
   if (ssl_ctx_) {
     SSL* ssl = SSL_new(ssl_ctx_);
@@ -705,7 +1000,20 @@ int Ssl::DoHandshake() {
   int n = SSL_do_handshake(ssl_);
 
   // handshake successfully completed
-  if (n == 1) return kOk;
+  if (n == 1) {
+    bool reused = IsSessionReused();
+    if (SSL_is_server(ssl_)) {
+      (reused ? server_session_hits : server_session_misses).fetch_add(1, std::memory_order_relaxed);
+    } else {
+      (reused ? client_session_hits : client_session_misses).fetch_add(1, std::memory_order_relaxed);
+      if (reused) CacheRenewedSession();
+    }
+#ifdef BIO_get_ktls_send
+    ktls_send_ = BIO_get_ktls_send(SSL_get_wbio(ssl_));
+    ktls_recv_ = BIO_get_ktls_recv(SSL_get_rbio(ssl_));
+#endif
+    return kOk;
+  }
 
   int ssl_err = SSL_get_error(ssl_, n);
 
@@ -822,7 +1130,10 @@ ssize_t Ssl::Send(const char* buf, size_t size) {
   return kError;
 }
 
-ssize_t Ssl::Writev(const struct iovec* iov, int iovcnt) { return SendOnce(iov, iovcnt); }
+ssize_t Ssl::Writev(const struct iovec* iov, int iovcnt) {
+  if (ktls_send_) return WritevByKernel(iov, iovcnt);
+  return SendOnce(iov, iovcnt);
+}
 
 bool Ssl::SetFd(const int fd) {
   if (SSL_set_fd(ssl_, fd) == 1) return true;
@@ -884,6 +1195,63 @@ bool Ssl::SetTlsExtensionServerName(const std::string& server_name) {
   return false;
 }
 
+std::string Ssl::GetAlpnSelected() const {
+  const unsigned char* data = nullptr;
+  unsigned int len = 0;
+  SSL_get0_alpn_selected(ssl_, &data, &len);
+  if (data == nullptr || len == 0) return "";
+  return std::string(reinterpret_cast<const char*>(data), len);
+}
+
+void Ssl::SetSessionCacheKey(const std::string& key) {
+  auto* context = static_cast<SslContext*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl_)));
+  // Session resumption of client-side is disabled.
+  if (!context || key.empty() || SSL_is_server(ssl_)) return;
+
+  session_cache_key_ = key;
+  SSL_set_app_data(ssl_, this);
+
+  SSL_SESSION* session = context->GetClientSession(key);
+  if (session) {
+    if (SSL_set_session(ssl_, session) != 1) {
+      TRPC_LOG_DEBUG("SSL_set_session() failed, key: " << key);
+    }
+    SSL_SESSION_free(session);
+  }
+}
+
+void Ssl::CacheRenewedSession() {
+  auto* context = static_cast<SslContext*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl_)));
+  if (!context || session_cache_key_.empty()) return;
+
+  // Before TLSv1.3, `OnNewClientSession` is not called for the session renewed by a resumption handshake, and the
+  // session resumed has been marked not resumable by OpenSSL.
+  SSL_SESSION* session = SSL_get1_session(ssl_);
+  if (session && SSL_SESSION_is_resumable(session)) {
+    context->PutClientSession(session_cache_key_, session);
+  } else if (session) {
+    SSL_SESSION_free(session);
+  }
+}
+
+bool Ssl::IsSessionReused() const { return SSL_session_reused(ssl_) == 1; }
+
+ssize_t Ssl::WritevByKernel(const struct iovec* iov, int iovcnt) {
+  // Control records(e.g., alerts) are still sent by OpenSSL, only application data takes this way, so blocks of
+  // buffer are written by one syscall without being copied together first.
+  ssize_t n = 0;
+  do {
+    n = ::writev(GetFd(), iov, iovcnt);
+  } while (n < 0 && errno == EINTR);
+
+  if (n >= 0) return n;
+
+  if (errno == EAGAIN || errno == EWOULDBLOCK) return kWantWrite;
+
+  TRPC_LOG_DEBUG("writev() over kTLS failed, errno:" << errno);
+  return kError;
+}
+
 ssize_t Ssl::SendOnce(const struct iovec* iov, int iovcnt) {
   // Reference to https://code.woboq.org/userspace/glibc/sysdeps/posix/writev.c.html
   static constexpr std::size_t kMaxLocalSize = 128 * 1024;
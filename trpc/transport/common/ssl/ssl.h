@@ -18,10 +18,13 @@
 #include <sys/uio.h>
 
 #include <cassert>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "trpc/transport/common/ssl/core.h"
@@ -57,6 +60,18 @@ uint32_t ParseProtocols(const std::vector<std::string>& protocols);
 /// @brief  Return default ssl cipher
 const std::string& GetDefaultCiphers();
 
+/// @brief Statistics of TLS session resumption. A handshake resuming a previous session (by session cache or session
+/// ticket) is a hit, a full handshake is a miss.
+struct SessionResumptionStatistics {
+  uint64_t server_hits{0};
+  uint64_t server_misses{0};
+  uint64_t client_hits{0};
+  uint64_t client_misses{0};
+};
+
+/// @brief Gets statistics of TLS session resumption of all SSL contexts in current process.
+SessionResumptionStatistics GetSessionResumptionStatistics();
+
 /// @brief Options for certificate.
 struct CertificateOptions {
   // Path of certificate(format: PEM, e.g., /path/to/xx_cert.pem)
@@ -99,6 +114,28 @@ struct SslOptions {
   // Options about verifying peer.
   // Reserved, not currently used.
   VerifyPeerOptions verify_peer_options;
+
+  // Application protocols negotiated by ALPN in preference order, e.g., ["h2", "http/1.1"].
+  // ALPN is disabled if empty.
+  std::vector<std::string> alpn_protocols;
+
+  // Resume previous sessions to skip the full handshake, by session cache and session tickets.
+  // Default: true.
+  bool session_resumption{true};
+
+  // Maximum number of sessions cached. Server-side caches sessions by session id, client-side caches the latest
+  // session of each peer endpoint.
+  // Default: 20480.
+  uint32_t session_cache_size{20480};
+
+  // Lifetime of sessions(and session tickets) in seconds.
+  // Default: 300.
+  uint32_t session_timeout{300};
+
+  // Offload encryption of records to kernel(kTLS) once the handshake completes, plaintext is then written to socket
+  // directly. Falls back to user-space TLS if OpenSSL, kernel or the negotiated cipher does not support it.
+  // Default: false.
+  bool ktls{false};
 };
 
 /// @brief Options for client SSL.
@@ -127,6 +164,11 @@ struct ServerSslOptions : public SslOptions {
   // Verify client or not.
   // Reserved, not currently used.
   bool enable_verify_peer{false};
+
+  // Interval in seconds to rotate the key encrypting session tickets. Tickets encrypted by retired keys are still
+  // accepted (and renewed) within `session_timeout` after the rotation.
+  // Default: 3600.
+  uint32_t session_ticket_key_rotation_interval{3600};
 };
 
 /// @brief A wrapper of SSL structure which is needed to hold the data for a TLS/SSL connection. The new structure
@@ -186,11 +228,44 @@ class Ssl : public RefCounted<Ssl> {
   /// the value `server_name`.
   bool SetTlsExtensionServerName(const std::string& server_name);
 
+  /// @brief Gets the application protocol negotiated by ALPN after handshaking, e.g., "h2".
+  /// @return Returns empty string if ALPN is not negotiated.
+  std::string GetAlpnSelected() const;
+
+  /// @brief Works in client mode, offers the session cached under `key` (e.g., peer endpoint and SNI) to be resumed,
+  /// and caches the new session established by this connection under `key`.
+  /// @note Must be called before handshaking, no-op if session resumption is disabled.
+  void SetSessionCacheKey(const std::string& key);
+
+  /// @brief Returns true if the handshake resumed a previous session.
+  bool IsSessionReused() const;
+
+  /// @brief Returns true if records sent are encrypted by kernel(kTLS), valid after handshaking.
+  bool IsKtlsSendEnabled() const { return ktls_send_; }
+
+  /// @brief Returns true if records received are decrypted by kernel(kTLS), valid after handshaking.
+  bool IsKtlsRecvEnabled() const { return ktls_recv_; }
+
  private:
+  friend class SslContext;
+
   ssize_t SendOnce(const struct iovec* iov, int iovcnt);
 
+  // Caches the session renewed by resumption handshake of client-side.
+  void CacheRenewedSession();
+
+  // Writes plaintext to socket directly, records are encrypted by kernel.
+  ssize_t WritevByKernel(const struct iovec* iov, int iovcnt);
+
  private:
   SSL* ssl_{nullptr};
+
+  // Key of client-side session cache, empty if not cached.
+  std::string session_cache_key_;
+
+  // Whether kTLS is in use for each direction, set once the handshake completes.
+  bool ktls_send_{false};
+  bool ktls_recv_{false};
 };
 using SslPtr = RefPtr<Ssl>;
 
@@ -210,6 +285,8 @@ class SslContext : public RefCounted<SslContext> {
   bool Init(const ClientSslOptions& ssl_options);
 
  private:
+  friend class Ssl;
+
   // @brief Sets a SSL context.
   bool SetSslCtx(const uint32_t protocols);
 
@@ -233,10 +310,71 @@ class SslContext : public RefCounted<SslContext> {
   // @brief Sets SSL context with protocols.
   void SetSslCtxProtocols(const uint32_t protocols);
 
+  // @brief Sets application protocols of ALPN, client-side offers them, server-side selects one of them.
+  bool SetAlpnProtocols(const std::vector<std::string>& protocols, bool server_mode);
+
+  // @brief Sets session cache and session tickets of server-side.
+  bool SetServerSessionResumption(const ServerSslOptions& ssl_options);
+
+  // @brief Sets session cache of client-side.
+  bool SetClientSessionResumption(const ClientSslOptions& ssl_options);
+
+  // @brief Enables kTLS, which takes effect once the handshake completes.
+  void SetKtls();
+
+  // @brief Callback of OpenSSL, caches the new session established by client-side.
+  static int OnNewClientSession(SSL* ssl, SSL_SESSION* session);
+
+  // @brief Callback of OpenSSL, sets up keys to encrypt(enc = 1) or decrypt(enc = 0) a session ticket.
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+  static int OnSessionTicketKey(SSL* ssl, unsigned char* key_name, unsigned char* iv, EVP_CIPHER_CTX* cipher_ctx,
+                                EVP_MAC_CTX* mac_ctx, int enc);
+#else
+  static int OnSessionTicketKey(SSL* ssl, unsigned char* key_name, unsigned char* iv, EVP_CIPHER_CTX* cipher_ctx,
+                                HMAC_CTX* mac_ctx, int enc);
+#endif
+
+  // @brief Gets the cached session of `key` with its reference count increased, returns nullptr if not cached.
+  SSL_SESSION* GetClientSession(const std::string& key);
+
+  // @brief Caches `session` under `key`, takes over a reference count of `session`.
+  void PutClientSession(const std::string& key, SSL_SESSION* session);
+
+ private:
+  // Key encrypting session tickets.
+  struct SessionTicketKey {
+    unsigned char name[16];
+    unsigned char aes_key[32];
+    unsigned char hmac_key[32];
+    // Seconds since epoch when the key was generated.
+    int64_t created_time;
+  };
+
+  // Gets the key to encrypt new tickets, rotates it if expired.
+  bool GetEncryptTicketKey(SessionTicketKey* key);
+
+  // Gets the key named `name` to decrypt a ticket, `renew` is set if the key has been retired.
+  bool GetDecryptTicketKey(const unsigned char* name, SessionTicketKey* key, bool* renew);
+
  private:
   // `ssl_ctx_` stores parsed well certificate, key and cipher suite, protocols of SSL/TLS.
   // It was used to create a ssl connection.
   SSL_CTX* ssl_ctx_{nullptr};
+
+  // Application protocols of ALPN in wire format (length-prefixed), referenced by ALPN select callback of server.
+  std::string alpn_protocols_;
+
+  uint32_t session_cache_size_{0};
+  uint32_t session_timeout_{0};
+  uint32_t ticket_key_rotation_interval_{0};
+
+  // Server-side: keys encrypting session tickets, the newest (in use) first.
+  std::mutex ticket_keys_mutex_;
+  std::deque<SessionTicketKey> ticket_keys_;
+
+  // Client-side: the latest session of each peer, keyed by `Ssl::SetSessionCacheKey`.
+  std::mutex client_sessions_mutex_;
+  std::unordered_map<std::string, SSL_SESSION*> client_sessions_;
 };
 using SslContextPtr = RefPtr<SslContext>;
 
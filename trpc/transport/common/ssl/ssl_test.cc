@@ -16,10 +16,15 @@
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <unistd.h>
 #include <cassert>
+#include <chrono>
+#include <cstring>
+#include <iostream>
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -126,6 +131,291 @@ TEST_F(SslContextTest, InitAsClientSslContext) {
   ASSERT_TRUE(ssl != nullptr);
 }
 
+namespace {
+// Does handshaking between client and server over a pair of connected non-blocking sockets.
+bool DoHandshakeOverFds(const SslContextPtr& server_ctx, const SslContextPtr& client_ctx, int server_fd, int client_fd,
+                        SslPtr* server_ssl, SslPtr* client_ssl, const std::string& session_cache_key) {
+  *server_ssl = server_ctx->NewSsl();
+  *client_ssl = client_ctx->NewSsl();
+  (*server_ssl)->SetFd(server_fd);
+  (*server_ssl)->SetAcceptState();
+  (*client_ssl)->SetFd(client_fd);
+  (*client_ssl)->SetConnectState();
+  (*client_ssl)->SetSessionCacheKey(session_cache_key);
+
+  int server_rc = kWantRead;
+  int client_rc = kWantRead;
+  for (int i = 0; i < 100 && (server_rc != kOk || client_rc != kOk); ++i) {
+    if (client_rc != kOk) client_rc = (*client_ssl)->DoHandshake();
+    if (server_rc != kOk) server_rc = (*server_ssl)->DoHandshake();
+    if (client_rc == kError || server_rc == kError) break;
+    // Data sent over TCP may take a while to arrive.
+    if (client_rc == kWantRead || server_rc == kWantRead) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return server_rc == kOk && client_rc == kOk;
+}
+
+bool DoHandshakeOverSocketPair(const SslContextPtr& server_ctx, const SslContextPtr& client_ctx, SslPtr* server_ssl,
+                               SslPtr* client_ssl, const std::string& session_cache_key = "") {
+  int fds[2];
+  if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) != 0) return false;
+  return DoHandshakeOverFds(server_ctx, client_ctx, fds[0], fds[1], server_ssl, client_ssl, session_cache_key);
+}
+
+// kTLS works over TCP only.
+bool DoHandshakeOverLoopbackTcp(const SslContextPtr& server_ctx, const SslContextPtr& client_ctx, SslPtr* server_ssl,
+                                SslPtr* client_ssl) {
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t socklen = sizeof(addr);
+
+  int listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (listen_fd < 0) return false;
+  int client_fd = -1, server_fd = -1;
+  if (::bind(listen_fd, reinterpret_cast<struct sockaddr*>(&addr), socklen) == 0 && ::listen(listen_fd, 1) == 0 &&
+      ::getsockname(listen_fd, reinterpret_cast<struct sockaddr*>(&addr), &socklen) == 0) {
+    client_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (client_fd >= 0 && ::connect(client_fd, reinterpret_cast<struct sockaddr*>(&addr), socklen) == 0) {
+      server_fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK);
+    }
+  }
+  ::close(listen_fd);
+
+  if (server_fd < 0) {
+    if (client_fd >= 0) ::close(client_fd);
+    return false;
+  }
+  int nonblocking = 1;
+  ::ioctl(client_fd, FIONBIO, &nonblocking);
+
+  return DoHandshakeOverFds(server_ctx, client_ctx, server_fd, client_fd, server_ssl, client_ssl, "");
+}
+}  // namespace
+
+TEST_F(SslContextTest, AlpnNegotiated) {
+  server_ssl_options_.alpn_protocols = {"h2", "http/1.1"};
+  SslContextPtr server_ctx = MakeRefCounted<SslContext>();
+  ASSERT_TRUE(server_ctx->Init(server_ssl_options_));
+
+  client_ssl_options_.insecure = true;
+  client_ssl_options_.alpn_protocols = {"http/1.1", "h2"};
+  SslContextPtr client_ctx = MakeRefCounted<SslContext>();
+  ASSERT_TRUE(client_ctx->Init(client_ssl_options_));
+
+  SslPtr server_ssl, client_ssl;
+  ASSERT_TRUE(DoHandshakeOverSocketPair(server_ctx, client_ctx, &server_ssl, &client_ssl));
+  // Preference of server wins.
+  ASSERT_EQ("h2", server_ssl->GetAlpnSelected());
+  ASSERT_EQ("h2", client_ssl->GetAlpnSelected());
+
+  ::close(server_ssl->GetFd());
+  ::close(client_ssl->GetFd());
+}
+
+TEST_F(SslContextTest, AlpnNotMatched) {
+  server_ssl_options_.alpn_protocols = {"h2"};
+  SslContextPtr server_ctx = MakeRefCounted<SslContext>();
+  ASSERT_TRUE(server_ctx->Init(server_ssl_options_));
+
+  client_ssl_options_.insecure = true;
+  client_ssl_options_.alpn_protocols = {"http/1.1"};
+  SslContextPtr client_ctx = MakeRefCounted<SslContext>();
+  ASSERT_TRUE(client_ctx->Init(client_ssl_options_));
+
+  SslPtr server_ssl, client_ssl;
+  ASSERT_TRUE(DoHandshakeOverSocketPair(server_ctx, client_ctx, &server_ssl, &client_ssl));
+  ASSERT_TRUE(server_ssl->GetAlpnSelected().empty());
+  ASSERT_TRUE(client_ssl->GetAlpnSelected().empty());
+
+  ::close(server_ssl->GetFd());
+  ::close(client_ssl->GetFd());
+}
+
+TEST_F(SslContextTest, InvalidAlpnProtocol) {
+  server_ssl_options_.alpn_protocols = {""};
+  SslContextPtr ssl_ctx = MakeRefCounted<SslContext>();
+  ASSERT_FALSE(ssl_ctx->Init(server_ssl_options_));
+}
+
+namespace {
+// Does a handshake over a new connection, returns 1 if a previous session is resumed, 0 if not, -1 on failure.
+int ConnectAndCheckSessionReused(const SslContextPtr& server_ctx, const SslContextPtr& client_ctx,
+                                 const std::string& session_cache_key) {
+  SslPtr server_ssl, client_ssl;
+  bool ok = DoHandshakeOverSocketPair(server_ctx, client_ctx, &server_ssl, &client_ssl, session_cache_key);
+  if (ok) {
+    // TLSv1.3 session tickets arrive after handshaking, they are received along with application data.
+    char buf[8];
+    ok = server_ssl->Send("x", 1) == 1 && client_ssl->Recv(buf, sizeof(buf)) == 1;
+  }
+  if (server_ssl) ::close(server_ssl->GetFd());
+  if (client_ssl) ::close(client_ssl->GetFd());
+  if (!ok || server_ssl->IsSessionReused() != client_ssl->IsSessionReused()) return -1;
+  return client_ssl->IsSessionReused() ? 1 : 0;
+}
+}  // namespace
+
+TEST_F(SslContextTest, SessionResumed) {
+  SslContextPtr server_ctx = MakeRefCounted<SslContext>();
+  ASSERT_TRUE(server_ctx->Init(server_ssl_options_));
+
+  client_ssl_options_.insecure = true;
+  SslContextPtr client_ctx = MakeRefCounted<SslContext>();
+  ASSERT_TRUE(client_ctx->Init(client_ssl_options_));
+
+  SessionResumptionStatistics before = GetSessionResumptionStatistics();
+
+  ASSERT_EQ(0, ConnectAndCheckSessionReused(server_ctx, client_ctx, "127.0.0.1:443/www.xxops.com"));
+  ASSERT_EQ(1, ConnectAndCheckSessionReused(server_ctx, client_ctx, "127.0.0.1:443/www.xxops.com"));
+  ASSERT_EQ(1, ConnectAndCheckSessionReused(server_ctx, client_ctx, "127.0.0.1:443/www.xxops.com"));
+  // Sessions are cached by peer.
+  ASSERT_EQ(0, ConnectAndCheckSessionReused(server_ctx, client_ctx, "127.0.0.1:8443/www.xxops.com"));
+  // Not cached at all.
+  ASSERT_EQ(0, ConnectAndCheckSessionReused(server_ctx, client_ctx, ""));
+  ASSERT_EQ(0, ConnectAndCheckSessionReused(server_ctx, client_ctx, ""));
+
+  SessionResumptionStatistics after = GetSessionResumptionStatistics();
+  ASSERT_EQ(2, after.server_hits - before.server_hits);
+  ASSERT_EQ(4, after.server_misses - before.server_misses);
+  ASSERT_EQ(2, after.client_hits - before.client_hits);
+  ASSERT_EQ(4, after.client_misses - before.client_misses);
+}
+
+TEST_F(SslContextTest, SessionResumedOverTlsV13) {
+  server_ssl_options_.protocols = kSslTlsV12 | kSslTlsV13;
+  SslContextPtr server_ctx = MakeRefCounted<SslContext>();
+  ASSERT_TRUE(server_ctx->Init(server_ssl_options_));
+
+  client_ssl_options_.protocols = kSslTlsV12 | kSslTlsV13;
+  client_ssl_options_.insecure = true;
+  SslContextPtr client_ctx = MakeRefCounted<SslContext>();
+  ASSERT_TRUE(client_ctx->Init(client_ssl_options_));
+
+  ASSERT_EQ(0, ConnectAndCheckSessionReused(server_ctx, client_ctx, "127.0.0.1:443/www.xxops.com"));
+  // A TLSv1.3 ticket is used only once, each resumption gets a new one.
+  ASSERT_EQ(1, ConnectAndCheckSessionReused(server_ctx, client_ctx, "127.0.0.1:443/www.xxops.com"));
+  ASSERT_EQ(1, ConnectAndCheckSessionReused(server_ctx, client_ctx, "127.0.0.1:443/www.xxops.com"));
+}
+
+TEST_F(SslContextTest, SessionResumedAfterTicketKeyRotated) {
+  server_ssl_options_.session_ticket_key_rotation_interval = 1;
+  SslContextPtr server_ctx = MakeRefCounted<SslContext>();
+  ASSERT_TRUE(server_ctx->Init(server_ssl_options_));
+
+  client_ssl_options_.insecure = true;
+  SslContextPtr client_ctx = MakeRefCounted<SslContext>();
+  ASSERT_TRUE(client_ctx->Init(client_ssl_options_));
+
+  ASSERT_EQ(0, ConnectAndCheckSessionReused(server_ctx, client_ctx, "127.0.0.1:443/www.xxops.com"));
+  std::this_thread::sleep_for(std::chrono::seconds(2));
+  // The ticket encrypted by the retired key is still accepted, and renewed by the new key.
+  ASSERT_EQ(1, ConnectAndCheckSessionReused(server_ctx, client_ctx, "127.0.0.1:443/www.xxops.com"));
+  ASSERT_EQ(1, ConnectAndCheckSessionReused(server_ctx, client_ctx, "127.0.0.1:443/www.xxops.com"));
+}
+
+namespace {
+// Sends `blocks` by `Writev` of `sender`, returns what `receiver` receives.
+std::string SendAndReceive(const SslPtr& sender, const SslPtr& receiver, const std::vector<std::string>& blocks) {
+  std::vector<struct iovec> iov;
+  size_t size = 0;
+  for (const auto& block : blocks) {
+    iov.push_back({const_cast<char*>(block.data()), block.size()});
+    size += block.size();
+  }
+  if (sender->Writev(iov.data(), iov.size()) != static_cast<ssize_t>(size)) return "";
+
+  std::string received;
+  char buf[4096];
+  for (int i = 0; i < 1000 && received.size() < size; ++i) {
+    ssize_t n = receiver->Recv(buf, sizeof(buf));
+    if (n > 0) {
+      received.append(buf, n);
+    } else if (n == kWantRead) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    } else {
+      break;
+    }
+  }
+  return received;
+}
+}  // namespace
+
+TEST_F(SslContextTest, KtlsEquivalentToUserSpaceTls) {
+  std::vector<std::string> blocks{"x", MakeBytes(16384 + 7), "hello kTLS", MakeBytes(4096)};
+  std::string expected;
+  for (const auto& block : blocks) expected += block;
+
+  for (bool ktls : {false, true}) {
+    server_ssl_options_.ktls = ktls;
+    SslContextPtr server_ctx = MakeRefCounted<SslContext>();
+    ASSERT_TRUE(server_ctx->Init(server_ssl_options_));
+
+    client_ssl_options_.ktls = ktls;
+    client_ssl_options_.insecure = true;
+    SslContextPtr client_ctx = MakeRefCounted<SslContext>();
+    ASSERT_TRUE(client_ctx->Init(client_ssl_options_));
+
+    SslPtr server_ssl, client_ssl;
+    ASSERT_TRUE(DoHandshakeOverLoopbackTcp(server_ctx, client_ctx, &server_ssl, &client_ssl));
+    if (!ktls) {
+      ASSERT_FALSE(server_ssl->IsKtlsSendEnabled());
+      ASSERT_FALSE(client_ssl->IsKtlsSendEnabled());
+    } else {
+      // kTLS may not be supported here, in which case this leg checks the fallback to user-space TLS.
+      RecordProperty("ktls_send_enabled", server_ssl->IsKtlsSendEnabled() ? "true" : "false");
+    }
+
+    // Either side may send by kernel, the peer sees the same bytes.
+    ASSERT_EQ(expected, SendAndReceive(server_ssl, client_ssl, blocks));
+    ASSERT_EQ(expected, SendAndReceive(client_ssl, server_ssl, blocks));
+
+    ::close(server_ssl->GetFd());
+    ::close(client_ssl->GetFd());
+  }
+}
+
+TEST_F(SslContextTest, SessionNotResumedByOtherServerContext) {
+  SslContextPtr server_ctx = MakeRefCounted<SslContext>();
+  ASSERT_TRUE(server_ctx->Init(server_ssl_options_));
+  SslContextPtr other_server_ctx = MakeRefCounted<SslContext>();
+  ASSERT_TRUE(other_server_ctx->Init(server_ssl_options_));
+
+  client_ssl_options_.insecure = true;
+  SslContextPtr client_ctx = MakeRefCounted<SslContext>();
+  ASSERT_TRUE(client_ctx->Init(client_ssl_options_));
+
+  ASSERT_EQ(0, ConnectAndCheckSessionReused(server_ctx, client_ctx, "127.0.0.1:443/www.xxops.com"));
+  // Neither the session cache nor the ticket key of `server_ctx` is known by `other_server_ctx`.
+  ASSERT_EQ(0, ConnectAndCheckSessionReused(other_server_ctx, client_ctx, "127.0.0.1:443/www.xxops.com"));
+  ASSERT_EQ(1, ConnectAndCheckSessionReused(other_server_ctx, client_ctx, "127.0.0.1:443/www.xxops.com"));
+}
+
+TEST_F(SslContextTest, SessionResumptionDisabled) {
+  server_ssl_options_.session_resumption = false;
+  SslContextPtr server_ctx = MakeRefCounted<SslContext>();
+  ASSERT_TRUE(server_ctx->Init(server_ssl_options_));
+
+  client_ssl_options_.insecure = true;
+  SslContextPtr client_ctx = MakeRefCounted<SslContext>();
+  ASSERT_TRUE(client_ctx->Init(client_ssl_options_));
+
+  ASSERT_EQ(0, ConnectAndCheckSessionReused(server_ctx, client_ctx, "127.0.0.1:443/www.xxops.com"));
+  ASSERT_EQ(0, ConnectAndCheckSessionReused(server_ctx, client_ctx, "127.0.0.1:443/www.xxops.com"));
+
+  server_ssl_options_.session_resumption = true;
+  server_ctx = MakeRefCounted<SslContext>();
+  ASSERT_TRUE(server_ctx->Init(server_ssl_options_));
+
+  client_ssl_options_.session_resumption = false;
+  client_ctx = MakeRefCounted<SslContext>();
+  ASSERT_TRUE(client_ctx->Init(client_ssl_options_));
+
+  ASSERT_EQ(0, ConnectAndCheckSessionReused(server_ctx, client_ctx, "127.0.0.1:443/www.xxops.com"));
+  ASSERT_EQ(0, ConnectAndCheckSessionReused(server_ctx, client_ctx, "127.0.0.1:443/www.xxops.com"));
+}
+
 // ---- ~ Delimiter ~ ----
 
 class SslTest : public ::testing::Test {
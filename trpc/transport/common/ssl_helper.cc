@@ -55,6 +55,11 @@ bool InitClientSslOptions(const ClientSslConfig& ssl_config, ClientSslOptions* s
     ssl_options->verify_peer_options.ca_cert_path = ssl_config.ca_cert_path;
     // Convert protocols string to protocols value
     ssl_options->protocols = ParseProtocols(ssl_config.protocols);
+    ssl_options->alpn_protocols = ssl_config.alpn_protocols;
+    ssl_options->session_resumption = ssl_config.session_resumption;
+    ssl_options->session_cache_size = ssl_config.session_cache_size;
+    ssl_options->session_timeout = ssl_config.session_timeout;
+    ssl_options->ktls = ssl_config.ktls;
 
     // Sets default CA cert path.
     if (ssl_options->verify_peer_options.ca_cert_path.empty()) {
@@ -74,11 +79,18 @@ bool InitServerSslOptions(const ServerSslConfig& ssl_config, ServerSslOptions* s
     ssl_options->verify_peer_options.ca_cert_path = ssl_config.ca_cert_path;
     // Convert protocols string to protocols value
     ssl_options->protocols = ParseProtocols(ssl_config.protocols);
+    ssl_options->alpn_protocols = ssl_config.alpn_protocols;
+    ssl_options->session_resumption = ssl_config.session_resumption;
+    ssl_options->session_cache_size = ssl_config.session_cache_size;
+    ssl_options->session_timeout = ssl_config.session_timeout;
+    ssl_options->ktls = ssl_config.ktls;
+    ssl_options->session_ticket_key_rotation_interval = ssl_config.session_ticket_key_rotation_interval;
   }
   return true;
 }
 
-SslPtr CreateClientSsl(const SslContextPtr& ssl_ctx, const ClientSslOptions& ssl_options, int fd) {
+SslPtr CreateClientSsl(const SslContextPtr& ssl_ctx, const ClientSslOptions& ssl_options, int fd,
+                       const std::string& peer_endpoint) {
   // Create SSL
   SslPtr ssl = ssl_ctx->NewSsl();
   if (ssl == nullptr) return nullptr;
@@ -92,6 +104,11 @@ SslPtr CreateClientSsl(const SslContextPtr& ssl_ctx, const ClientSslOptions& ssl
   if (!ssl_options.sni_name.empty()) {
     if (!ssl->SetTlsExtensionServerName(ssl_options.sni_name)) return nullptr;
   }
+
+  // Resume the session of the same peer
+  if (!peer_endpoint.empty()) {
+    ssl->SetSessionCacheKey(peer_endpoint + "/" + ssl_options.sni_name);
+  }
   // Set ssl to work in client mode
   ssl->SetConnectState();
   return ssl;
@@ -111,6 +128,18 @@ SslPtr CreateServerSsl(const SslContextPtr& ssl_ctx, const ServerSslOptions& ssl
   return ssl;
 }
 
+void SetDefaultAlpnProtocols(std::string_view protocol, bool server_mode, std::vector<std::string>* alpn_protocols) {
+  if (!alpn_protocols->empty()) {
+    return;
+  }
+  if (protocol == "grpc" || protocol == "http2") {
+    alpn_protocols->emplace_back("h2");
+  }
+  if (server_mode && protocol == "http2") {
+    alpn_protocols->emplace_back("http/1.1");
+  }
+}
+
 #endif
 
 }  // namespace trpc::ssl
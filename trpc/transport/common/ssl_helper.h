@@ -13,6 +13,10 @@
 
 #pragma once
 
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include "trpc/common/config/ssl_conf.h"
 #include "trpc/transport/common/ssl/ssl.h"
 
@@ -34,11 +38,21 @@ bool InitClientSslOptions(const ClientSslConfig& ssl_config, ClientSslOptions* s
 bool InitServerSslOptions(const ServerSslConfig& ssl_config, ServerSslOptions* ssl_options);
 
 /// @brief create SSL for client-side
-SslPtr CreateClientSsl(const SslContextPtr& ssl_ctx, const ClientSslOptions& ssl_options, int fd);
+/// @param peer_endpoint Endpoint of the peer (e.g., "ip:port"), the session of the same peer is resumed if not empty.
+SslPtr CreateClientSsl(const SslContextPtr& ssl_ctx, const ClientSslOptions& ssl_options, int fd,
+                       const std::string& peer_endpoint = "");
 
 /// @brief Creates SSL for server-side
 SslPtr CreateServerSsl(const SslContextPtr& ssl_ctx, const ServerSslOptions& ssl_options, int fd);
 
+/// @brief Sets the default ALPN protocols of `protocol` if none is configured. HTTP/2 over TLS requires "h2" to be
+/// negotiated (RFC 9113, 3.2), "http2" server offers "http/1.1" as well, it falls back to HTTP/1.1 for the clients
+/// which don't speak HTTP/2.
+/// @param protocol is the codec name of the service, e.g. "grpc", "http2".
+/// @param server_mode is true for server-side, false for client-side.
+/// @param alpn_protocols is the ALPN protocols, in order of preference.
+void SetDefaultAlpnProtocols(std::string_view protocol, bool server_mode, std::vector<std::string>* alpn_protocols);
+
 #endif
 
 }  // namespace trpc::ssl
@@ -14,6 +14,9 @@
 #ifdef TRPC_BUILD_INCLUDE_SSL
 #include "trpc/transport/common/ssl_helper.h"
 
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "trpc/common/config/ssl_conf.h"
@@ -78,5 +81,27 @@ TEST_F(SslHelperTest, InitServerSsl) {
   EXPECT_TRUE(ssl != nullptr);
 }
 
+TEST(SetDefaultAlpnProtocolsTest, SetDefaultAlpnProtocols) {
+  std::vector<std::string> alpn_protocols;
+  ssl::SetDefaultAlpnProtocols("trpc", true, &alpn_protocols);
+  EXPECT_TRUE(alpn_protocols.empty());
+
+  ssl::SetDefaultAlpnProtocols("grpc", true, &alpn_protocols);
+  EXPECT_EQ(std::vector<std::string>({"h2"}), alpn_protocols);
+
+  alpn_protocols.clear();
+  ssl::SetDefaultAlpnProtocols("http2", false, &alpn_protocols);
+  EXPECT_EQ(std::vector<std::string>({"h2"}), alpn_protocols);
+
+  alpn_protocols.clear();
+  ssl::SetDefaultAlpnProtocols("http2", true, &alpn_protocols);
+  EXPECT_EQ(std::vector<std::string>({"h2", "http/1.1"}), alpn_protocols);
+
+  // Configured ones are kept.
+  alpn_protocols = {"http/1.1"};
+  ssl::SetDefaultAlpnProtocols("http2", true, &alpn_protocols);
+  EXPECT_EQ(std::vector<std::string>({"http/1.1"}), alpn_protocols);
+}
+
 }  // namespace trpc::testing
 #endif
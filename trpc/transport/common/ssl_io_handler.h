@@ -37,6 +37,9 @@ class SslIoHandler : public IoHandler {
 
   void Destroy() override;
 
+  /// @brief Gets the SSL session of the connection, e.g. to look up the protocol negotiated by ALPN.
+  const SslPtr& GetSsl() const { return ssl_; }
+
  private:
   Connection* conn_{nullptr};
   SslPtr ssl_{nullptr};
@@ -0,0 +1,39 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#include "trpc/transport/server/common/idle_connection_timing_wheel.h"
+
+#include <algorithm>
+
+#include "trpc/util/log/logging.h"
+
+namespace trpc {
+
+IdleConnectionTimingWheel::IdleConnectionTimingWheel(uint64_t idle_timeout_ms, uint64_t tick_ms, uint64_t now_ms)
+    : idle_timeout_ms_(idle_timeout_ms), tick_ms_(tick_ms), current_tick_(now_ms / tick_ms) {
+  TRPC_ASSERT(tick_ms > 0);
+  // One extra slot for rounding the deadline up and one for the slot being expired.
+  slots_.resize(idle_timeout_ms / tick_ms + 2);
+}
+
+void IdleConnectionTimingWheel::Add(uint64_t conn_id, uint64_t active_time_ms) {
+  // The connection is idle once strictly more than `idle_timeout_ms_` has passed since its last activity.
+  uint64_t deadline_tick = (active_time_ms + idle_timeout_ms_ + tick_ms_) / tick_ms_;
+  // A deadline beyond one round of the wheel (e.g. `Expire` has fallen behind) is visited early, which is harmless
+  // since the active time is checked again then.
+  deadline_tick = std::clamp(deadline_tick, current_tick_ + 1, current_tick_ + slots_.size() - 1);
+
+  slots_[deadline_tick % slots_.size()].push_back(conn_id);
+  ++size_;
+}
+
+}  // namespace trpc
@@ -0,0 +1,81 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace trpc {
+
+/// @brief Hashed timing wheel tracking the idle deadline of server connections.
+/// @note  Tracking is lazy: activity on a connection only updates its active time, the wheel does not have to be
+///        touched. When the slot of a connection is reached, its active time is checked again, the connection is
+///        either closed as idle or moved to the slot of its new deadline. So expiring costs time proportional to the
+///        connections whose deadline is due instead of to all the connections.
+///        It is not thread-safe.
+class IdleConnectionTimingWheel {
+ public:
+  /// @param idle_timeout_ms Idle timeout of connections, in milliseconds.
+  /// @param tick_ms Granularity of the wheel, which is how often `Expire` is expected to be called.
+  /// @param now_ms Current time, in milliseconds.
+  IdleConnectionTimingWheel(uint64_t idle_timeout_ms, uint64_t tick_ms, uint64_t now_ms);
+
+  /// @brief Start tracking the connection `conn_id` which is last active at `active_time_ms`.
+  void Add(uint64_t conn_id, uint64_t active_time_ms);
+
+  /// @brief Visit the connections whose deadline is due by `now_ms`.
+  /// @param check Called with the id of each due connection, returns the latest active time of the connection to keep
+  ///              tracking it, or `std::nullopt` once the connection is gone or has been closed as idle.
+  template <typename F>
+  void Expire(uint64_t now_ms, F&& check) {
+    uint64_t now_tick = now_ms / tick_ms_;
+    if (now_tick > current_tick_ + slots_.size()) {
+      // Every slot is visited at most once per call.
+      current_tick_ = now_tick - slots_.size();
+    }
+
+    while (current_tick_ < now_tick) {
+      ++current_tick_;
+      expiring_.swap(slots_[current_tick_ % slots_.size()]);
+      size_ -= expiring_.size();
+      for (uint64_t conn_id : expiring_) {
+        std::optional<uint64_t> active_time = check(conn_id);
+        if (active_time) {
+          Add(conn_id, *active_time);
+        }
+      }
+      expiring_.clear();
+    }
+  }
+
+  /// @brief Number of connections being tracked, connections gone but not yet visited included.
+  std::size_t Size() const { return size_; }
+
+ private:
+  uint64_t idle_timeout_ms_;
+
+  uint64_t tick_ms_;
+
+  uint64_t current_tick_;
+
+  std::size_t size_{0};
+
+  std::vector<std::vector<uint64_t>> slots_;
+
+  std::vector<uint64_t> expiring_;
+};
+
+}  // namespace trpc
@@ -0,0 +1,92 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#include "trpc/transport/server/common/idle_connection_timing_wheel.h"
+
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+class IdleConnectionTimingWheelTest : public ::testing::Test {
+ protected:
+  // Close the connections idle for more than 10s, as the bind adapters do.
+  std::vector<uint64_t> Expire(IdleConnectionTimingWheel& wheel, uint64_t now_ms) {
+    std::vector<uint64_t> idles;
+    wheel.Expire(now_ms, [&](uint64_t conn_id) -> std::optional<uint64_t> {
+      ++checked_;
+      auto it = active_times_.find(conn_id);
+      if (it == active_times_.end()) {
+        return std::nullopt;
+      }
+      if (it->second + 10000 < now_ms) {
+        idles.push_back(conn_id);
+        active_times_.erase(it);
+        return std::nullopt;
+      }
+      return it->second;
+    });
+    return idles;
+  }
+
+  std::unordered_map<uint64_t, uint64_t> active_times_;
+  std::size_t checked_{0};
+};
+
+TEST_F(IdleConnectionTimingWheelTest, ExpireIdle) {
+  IdleConnectionTimingWheel wheel(10000, 1000, 100000);
+  for (uint64_t id = 1; id <= 3; ++id) {
+    active_times_[id] = 100000;
+    wheel.Add(id, 100000);
+  }
+  ASSERT_EQ(wheel.Size(), 3);
+
+  // Nothing is due before the timeout, and no connection is visited.
+  for (uint64_t now = 101000; now <= 110000; now += 1000) {
+    ASSERT_TRUE(Expire(wheel, now).empty());
+  }
+  ASSERT_EQ(checked_, 0);
+
+  // Connection 2 is active meanwhile, connection 3 is gone.
+  active_times_[2] = 105000;
+  active_times_.erase(3);
+
+  ASSERT_EQ(Expire(wheel, 111000), std::vector<uint64_t>{1});
+  ASSERT_EQ(checked_, 3);
+  ASSERT_EQ(wheel.Size(), 1);
+
+  // Connection 2 has been moved to the slot of its new deadline.
+  ASSERT_TRUE(Expire(wheel, 115000).empty());
+  ASSERT_EQ(Expire(wheel, 116000), std::vector<uint64_t>{2});
+  ASSERT_EQ(wheel.Size(), 0);
+}
+
+TEST_F(IdleConnectionTimingWheelTest, FallBehind) {
+  IdleConnectionTimingWheel wheel(10000, 1000, 100000);
+  active_times_[1] = 100000;
+  wheel.Add(1, 100000);
+  active_times_[2] = 100500;
+  wheel.Add(2, 100500);
+
+  // `Expire` is not called for several rounds of the wheel.
+  active_times_[2] = 150000;
+  ASSERT_EQ(Expire(wheel, 155000), std::vector<uint64_t>{1});
+  ASSERT_EQ(wheel.Size(), 1);
+
+  ASSERT_TRUE(Expire(wheel, 160000).empty());
+  ASSERT_EQ(Expire(wheel, 161000), std::vector<uint64_t>{2});
+}
+
+}  // namespace trpc::testing
@@ -56,8 +56,6 @@ class ServerConnectionHandler : public ConnectionHandler {
 
   void CleanResource() override { bind_adapter_->CleanConnectionResource(connection_); }
 
-  void UpdateConnection() override { bind_adapter_->UpdateConnection(connection_); }
-
   void ConnectionEstablished() override {
     if (TRPC_UNLIKELY(bind_info_->conn_establish_function)) {
       bind_info_->conn_establish_function(connection_);
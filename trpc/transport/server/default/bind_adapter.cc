@@ -13,6 +13,7 @@
 
 #include "trpc/transport/server/default/bind_adapter.h"
 
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -28,17 +29,23 @@
 
 namespace trpc {
 
+namespace {
+
+// Granularity of the idle timing wheel, which is also the interval of `RemoveIdleConnection` being called.
+constexpr uint64_t kIdleWheelTickMs = 1000;
+
+}  // namespace
+
 BindAdapter::BindAdapter(Options options)
     : options_(std::move(options)),
-      conn_manager_(options_.reactor->Id(), options_.transport->GetBindInfo().max_conn_num) {
+      conn_manager_(options_.reactor->Id(), options_.transport->GetBindInfo().max_conn_num),
+      idle_wheel_(options_.transport->GetBindInfo().idle_time, kIdleWheelTickMs, trpc::time::GetMilliSeconds()) {
   TRPC_LOG_TRACE("BindAdapter reactor_id:" << options_.reactor->Id());
   TRPC_ASSERT(options_.reactor != nullptr);
   TRPC_ASSERT(options_.transport != nullptr);
 
   connection_idle_timeout_ = options_.transport->GetBindInfo().idle_time;
 
-  active_conn_ids_.resize(0);
-
   idle_connections_.reserve(options_.transport->GetBindInfo().max_conn_num);
 }
 
@@ -191,7 +198,7 @@ void BindAdapter::StartIdleConnCleanJob() {
   if (connection_idle_timeout_ > 0) {
     Latch l(1);
     bool ret = options_.reactor->SubmitTask2([this, &l]() {
-      timer_id_ = iotimer::Create(0, 1000, [this]() { this->RemoveIdleConnection(); });
+      timer_id_ = iotimer::Create(0, kIdleWheelTickMs, [this]() { this->RemoveIdleConnection(); });
       l.count_down();
     });
 
@@ -262,21 +269,13 @@ void BindAdapter::ThrottleConnection(uint64_t conn_id, bool set) {
 }
 
 void BindAdapter::AddConnection(const RefPtr<TcpConnection>& conn) {
-  std::list<uint64_t>::iterator it = active_conn_ids_.insert(active_conn_ids_.end(), conn->GetConnId());
-  conn->SetContext(it);
+  if (connection_idle_timeout_ > 0) {
+    idle_wheel_.Add(conn->GetConnId(), conn->GetConnActiveTime());
+  }
 
   TRPC_ASSERT(conn_manager_.AddConnection(conn));
 }
 
-void BindAdapter::UpdateConnection(Connection* conn) {
-  std::list<uint64_t>::iterator old_it = conn->GetContext();
-
-  active_conn_ids_.erase(old_it);
-
-  std::list<uint64_t>::iterator new_it = active_conn_ids_.insert(active_conn_ids_.end(), conn->GetConnId());
-  conn->SetContext(new_it);
-}
-
 void BindAdapter::DelConnection(TcpConnection* conn) {
   TRPC_LOG_TRACE("DelConnection conn_id:" << conn->GetConnId());
 
@@ -286,9 +285,6 @@ void BindAdapter::DelConnection(TcpConnection* conn) {
 void BindAdapter::CleanConnectionResource(Connection* conn) {
   TRPC_LOG_TRACE("CleanConnectionResource conn_id:" << conn->GetConnId());
 
-  std::list<uint64_t>::iterator old_it = conn->GetContext();
-  active_conn_ids_.erase(old_it);
-
   RefPtr<TcpConnection> conn_ptr = conn_manager_.DelConnection(conn->GetConnId());
 
   options_.transport->DecrAliveConnNum(1);
@@ -309,17 +305,21 @@ void BindAdapter::RemoveIdleConnection() {
   TRPC_LOG_TRACE("RemoveIdleConnection connection_idle_timeout_: " << connection_idle_timeout_);
   idle_connections_.clear();
 
+  // Only the connections whose deadline is due are visited, the active ones are moved to their new deadline.
   uint64_t now = trpc::time::GetMilliSeconds();
-  for (auto& item : active_conn_ids_) {
-    TcpConnection* conn = conn_manager_.GetConnection(item);
-    if (conn) {
-      if (now - conn->GetConnActiveTime() > connection_idle_timeout_) {
-        idle_connections_.push_back(item);
-      } else {
-        break;
-      }
+  idle_wheel_.Expire(now, [this, now](uint64_t conn_id) -> std::optional<uint64_t> {
+    TcpConnection* conn = conn_manager_.GetConnection(conn_id);
+    if (!conn) {
+      return std::nullopt;
     }
-  }
+
+    if (now - conn->GetConnActiveTime() > connection_idle_timeout_) {
+      idle_connections_.push_back(conn_id);
+      return std::nullopt;
+    }
+
+    return conn->GetConnActiveTime();
+  });
 
   if (idle_connections_.empty()) {
     return;
@@ -21,6 +21,7 @@
 #include "trpc/runtime/iomodel/reactor/default/acceptor.h"
 #include "trpc/runtime/iomodel/reactor/default/udp_transceiver.h"
 #include "trpc/runtime/iomodel/reactor/reactor.h"
+#include "trpc/transport/server/common/idle_connection_timing_wheel.h"
 #include "trpc/transport/server/default/connection_manager.h"
 #include "trpc/transport/server/default/server_transport_impl.h"
 #include "trpc/util/time.h"
@@ -66,8 +67,6 @@ class BindAdapter {
 
   void AddConnection(const RefPtr<TcpConnection>& conn);
 
-  void UpdateConnection(Connection* conn);
-
   void ThrottleConnection(uint64_t conn_id, bool set);
 
   void CleanConnectionResource(Connection* conn);
@@ -100,7 +99,7 @@ class BindAdapter {
 
   ConnectionManager conn_manager_;
 
-  std::list<uint64_t> active_conn_ids_;
+  IdleConnectionTimingWheel idle_wheel_;
 
   std::vector<uint64_t> idle_connections_;
 };
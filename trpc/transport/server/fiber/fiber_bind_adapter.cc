@@ -26,7 +26,9 @@ using namespace std::literals;
 namespace trpc {
 
 FiberBindAdapter::FiberBindAdapter(FiberServerTransportImpl* transport, size_t scheduling_group_index)
-    : transport_(transport), scheduling_group_index_(scheduling_group_index) {
+    : transport_(transport),
+      scheduling_group_index_(scheduling_group_index),
+      connection_manager_(transport->GetBindInfo().idle_time) {
   TRPC_ASSERT(transport_ != nullptr);
 
   const BindInfo& bind_info = transport_->GetBindInfo();
@@ -345,7 +347,7 @@ void FiberBindAdapter::RemoveIdleConnection() {
   }
 
   std::vector<RefPtr<FiberTcpConnection>> idle_connections;
-  connection_manager_.GetIdles(connection_idle_timeout_, idle_connections);
+  connection_manager_.GetIdles(idle_connections);
 
   if (idle_connections.empty()) {
     return;
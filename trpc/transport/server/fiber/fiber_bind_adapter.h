@@ -52,8 +52,6 @@ class FiberBindAdapter : public RefCounted<FiberBindAdapter> {
 
   void AddConnection(const RefPtr<FiberTcpConnection>& conn);
 
-  void UpdateConnection(Connection* conn) {}
-
   void CleanConnectionResource(Connection* conn);
 
   bool IsConnected(uint64_t connection_id);
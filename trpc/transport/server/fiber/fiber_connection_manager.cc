@@ -13,6 +13,8 @@
 
 #include "trpc/transport/server/fiber/fiber_connection_manager.h"
 
+#include <optional>
+
 #include "trpc/util/hash_util.h"
 #include "trpc/util/likely.h"
 #include "trpc/util/log/logging.h"
@@ -22,7 +24,12 @@ namespace trpc {
 
 constexpr static size_t kReserveSize = 1024 * 8 - 1;
 
-FiberConnectionManager::FiberConnectionManager() {
+// Granularity of the idle timing wheel, which is also the interval of `GetIdles` being called.
+constexpr static uint64_t kIdleWheelTickMs = 1000;
+
+FiberConnectionManager::FiberConnectionManager(uint32_t idle_timeout)
+    : idle_timeout_(idle_timeout),
+      idle_wheel_(idle_timeout, kIdleWheelTickMs, trpc::time::GetMilliSeconds()) {
   conn_shards_ = std::make_unique<ConnectionShard[]>(kShards);
   for (size_t i = 0; i != kShards; ++i) {
     auto&& shard = conn_shards_[i];
@@ -38,13 +45,20 @@ FiberConnectionManager::~FiberConnectionManager() {
 }
 
 void FiberConnectionManager::Add(uint64_t conn_id, const RefPtr<FiberTcpConnection>& conn) {
-  auto&& shard = conn_shards_[GetHashIndex(conn_id, kShards)];
+  {
+    auto&& shard = conn_shards_[GetHashIndex(conn_id, kShards)];
 
-  std::scoped_lock _(shard.lock);
-  auto&& [it, inserted] = shard.map.insert(std::make_pair(conn_id, conn));
-  (void)it;  // Suppresses compilation warnings.
+    std::scoped_lock _(shard.lock);
+    auto&& [it, inserted] = shard.map.insert(std::make_pair(conn_id, conn));
+    (void)it;  // Suppresses compilation warnings.
 
-  TRPC_ASSERT(inserted && "insert FiberConnectionManager with Duplicate conn_id");
+    TRPC_ASSERT(inserted && "insert FiberConnectionManager with Duplicate conn_id");
+  }
+
+  if (idle_timeout_ > 0) {
+    std::scoped_lock _(idle_wheel_lock_);
+    idle_wheel_.Add(conn_id, conn->GetConnActiveTime());
+  }
 }
 
 RefPtr<FiberTcpConnection> FiberConnectionManager::Del(uint64_t conn_id) {
@@ -73,24 +87,34 @@ RefPtr<FiberTcpConnection> FiberConnectionManager::Get(uint64_t conn_id) {
   return nullptr;
 }
 
-void FiberConnectionManager::GetIdles(uint32_t idle_timeout, std::vector<RefPtr<FiberTcpConnection>>& idle_conns) {
+void FiberConnectionManager::GetIdles(std::vector<RefPtr<FiberTcpConnection>>& idle_conns) {
   TRPC_ASSERT(conn_shards_ && "conn_shards_ is null");
+  if (idle_timeout_ == 0) {
+    return;
+  }
+
   uint64_t current_time = trpc::time::GetMilliSeconds();
 
-  for (size_t i = 0; i < kShards; ++i) {
-    auto&& shard = conn_shards_[i];
+  // Only the connections whose deadline is due are visited, the active ones are moved to their new deadline.
+  std::scoped_lock wheel_lock(idle_wheel_lock_);
+  idle_wheel_.Expire(current_time, [&](uint64_t conn_id) -> std::optional<uint64_t> {
+    auto&& shard = conn_shards_[GetHashIndex(conn_id, kShards)];
 
     std::scoped_lock _(shard.lock);
-    auto it = shard.map.begin();
-    while (it != shard.map.end()) {
-      if (it->second->GetConnActiveTime() + idle_timeout < current_time) {
-        idle_conns.emplace_back(std::move(it->second));
-        it = shard.map.erase(it);
-      } else {
-        ++it;
-      }
+    auto it = shard.map.find(conn_id);
+    if (it == shard.map.end()) {
+      return std::nullopt;
     }
-  }
+
+    uint64_t active_time = it->second->GetConnActiveTime();
+    if (active_time + idle_timeout_ < current_time) {
+      idle_conns.emplace_back(std::move(it->second));
+      shard.map.erase(it);
+      return std::nullopt;
+    }
+
+    return active_time;
+  });
 }
 
 void FiberConnectionManager::DisableAllConnRead() {
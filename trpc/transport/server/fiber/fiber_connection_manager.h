@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_tcp_connection.h"
+#include "trpc/transport/server/common/idle_connection_timing_wheel.h"
 #include "trpc/util/align.h"
 #include "trpc/util/ref_ptr.h"
 
@@ -26,7 +27,8 @@ namespace trpc {
 
 class FiberConnectionManager {
  public:
-  FiberConnectionManager();
+  /// @param idle_timeout Idle timeout of connections in milliseconds, 0 means connections never become idle.
+  explicit FiberConnectionManager(uint32_t idle_timeout = 0);
 
   ~FiberConnectionManager();
 
@@ -36,7 +38,9 @@ class FiberConnectionManager {
 
   RefPtr<FiberTcpConnection> Get(uint64_t conn_id);
 
-  void GetIdles(uint32_t idle_timeout, std::vector<RefPtr<FiberTcpConnection>>& idle_conns);
+  /// @brief Remove the connections idle for longer than the idle timeout and return them in `idle_conns`.
+  /// @note  It is expected to be called once per second.
+  void GetIdles(std::vector<RefPtr<FiberTcpConnection>>& idle_conns);
 
   void Stop();
 
@@ -53,6 +57,13 @@ class FiberConnectionManager {
   constexpr static size_t kShards = 128;
 
   std::unique_ptr<ConnectionShard[]> conn_shards_;
+
+  uint32_t idle_timeout_;
+
+  // Protects `idle_wheel_`, it is acquired before the lock of a shard if both are held.
+  std::mutex idle_wheel_lock_;
+
+  IdleConnectionTimingWheel idle_wheel_;
 };
 
 }  // namespace trpc
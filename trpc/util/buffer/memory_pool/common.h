@@ -14,6 +14,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 
 namespace trpc::memory_pool {
 
@@ -22,6 +23,15 @@ static constexpr std::size_t kDefaultMemPoolThreshold = 512 * 1024 * 1024;
 /// @brief Default memory block size is 4KB.
 static constexpr std::size_t kDefaultBlockSize = 4096;
 
+/// @brief Memory blocks can also be allocated by size class, block sizes of the classes are powers of 2, from 512B
+///        (1 << kMinSizeClassShift) to 64KB (1 << kMaxSizeClassShift), header of the block included.
+static constexpr std::size_t kMinSizeClassShift = 9;
+static constexpr std::size_t kMaxSizeClassShift = 16;
+/// @brief The number of size classes.
+static constexpr std::size_t kSizeClassNum = kMaxSizeClassShift - kMinSizeClassShift + 1;
+/// @brief Size class of the blocks allocated from the fixed block size memory pool(`GetMemBlockSize()`).
+static constexpr std::uint8_t kFixedSizeClass = 0xff;
+
 /// @brief Memory allocation function type.
 typedef void* (*AllocateMemFunc)(std::size_t alignment, std::size_t size);
 /// @brief Memory deallocation function type.
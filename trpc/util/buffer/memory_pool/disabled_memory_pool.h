@@ -17,6 +17,8 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "trpc/util/buffer/memory_pool/common.h"
+
 namespace trpc::memory_pool::disabled {
 
 /// @private
@@ -26,6 +28,7 @@ namespace detail {
 struct alignas(64) Block {
   std::atomic<std::uint32_t> ref_count{1};  ///< Reference counting, used for smart pointer implementations.
   char* data{nullptr};  ///< The memory address of the data, the actual address used to store business data.
+  std::uint8_t size_class{kFixedSizeClass};  ///< Size class of the block, see `kFixedSizeClass`.
 };
 
 }  // namespace detail
@@ -17,6 +17,8 @@
 #include <cstdint>
 #include <memory>
 
+#include "trpc/util/buffer/memory_pool/common.h"
+
 namespace trpc::memory_pool::global {
 
 /// @private
@@ -29,6 +31,7 @@ struct alignas(64) Block {
   std::atomic<std::uint32_t> ref_count{1};  ///< Reference count, used for smart pointer usage.
   bool need_free_to_system{true};           ///< Whether need to free memory to the system
   char* data{nullptr};                      ///< Data memory address, the actual address used to store business data.
+  std::uint8_t size_class{kFixedSizeClass};  ///< Size class of the block, see `kFixedSizeClass`.
 };
 
 }  // namespace detail
@@ -13,12 +13,45 @@
 
 #include "trpc/util/buffer/memory_pool/memory_pool.h"
 
+#include <new>
+
 #include "trpc/util/buffer/memory_pool/common.h"
+#include "trpc/util/likely.h"
 
 namespace trpc {
 
 namespace memory_pool {
 
+namespace {
+
+#if defined(TRPC_DISABLED_MEM_POOL)
+// Size class blocks are neither cached when the memory pool is disabled.
+MemBlock* AllocateSizeClassBlock(std::size_t index) {
+  std::size_t block_size = size_class::GetSizeClassBlockSize(index);
+  char* addr = static_cast<char*>(GetAllocateMemFunc()(alignof(MemBlock), block_size));
+  if (TRPC_UNLIKELY(!addr)) {
+    return nullptr;
+  }
+  MemBlock* block = new (addr) MemBlock();
+  block->data = addr + sizeof(MemBlock);
+  block->size_class = static_cast<std::uint8_t>(index);
+  return block;
+}
+
+void DeallocateSizeClassBlock(MemBlock* block) {
+  block->~MemBlock();
+  GetDeallocateMemFunc()(block);
+}
+#else
+MemBlock* AllocateSizeClassBlock(std::size_t index) {
+  return size_class::detail::SizeClassMemPool<MemBlock>::Allocate(index);
+}
+
+void DeallocateSizeClassBlock(MemBlock* block) { size_class::detail::SizeClassMemPool<MemBlock>::Deallocate(block); }
+#endif
+
+}  // namespace
+
 MemBlock* Allocate() {
 #if defined(TRPC_DISABLED_MEM_POOL)
   return disabled::Allocate();
@@ -29,7 +62,23 @@ MemBlock* Allocate() {
 #endif
 }
 
+MemBlock* Allocate(std::size_t size) {
+  std::size_t block_size = size + sizeof(MemBlock);
+  std::size_t index = size_class::GetSizeClassIndex(block_size);
+  std::size_t class_block_size = size_class::GetSizeClassBlockSize(index);
+  // The fixed size block is preferred when it fits as well, or when nothing fits.
+  if (class_block_size == GetMemBlockSize() || (class_block_size < block_size && GetMemBlockSize() > class_block_size)) {
+    return Allocate();
+  }
+  return AllocateSizeClassBlock(index);
+}
+
 void Deallocate(MemBlock* block) {
+  if (TRPC_UNLIKELY(block->size_class != kFixedSizeClass)) {
+    DeallocateSizeClassBlock(block);
+    return;
+  }
+
 #if defined(TRPC_DISABLED_MEM_POOL)
   disabled::Deallocate(block);
 #elif defined(TRPC_SHARED_NOTHING_MEM_POOL)
@@ -63,6 +112,13 @@ void PrintMemStatistics() noexcept {
 
 std::size_t GetBlockMaxAvailableSize() { return memory_pool::GetMemBlockSize() - sizeof(memory_pool::MemBlock); }
 
+std::size_t GetBlockMaxAvailableSize(const memory_pool::MemBlock* block) {
+  if (TRPC_LIKELY(block->size_class == memory_pool::kFixedSizeClass)) {
+    return GetBlockMaxAvailableSize();
+  }
+  return memory_pool::size_class::GetSizeClassBlockSize(block->size_class) - sizeof(memory_pool::MemBlock);
+}
+
 RefPtr<memory_pool::MemBlock> MakeBlockRef(memory_pool::MemBlock* ptr) {
   return RefPtr<memory_pool::MemBlock>(adopt_ptr, ptr);
 }
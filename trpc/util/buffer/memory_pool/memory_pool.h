@@ -22,6 +22,7 @@
 #include "trpc/util/buffer/memory_pool/disabled_memory_pool.h"
 #include "trpc/util/buffer/memory_pool/global_memory_pool.h"
 #include "trpc/util/buffer/memory_pool/shared_nothing_memory_pool.h"
+#include "trpc/util/buffer/memory_pool/size_class_memory_pool.h"
 #include "trpc/util/check.h"
 #include "trpc/util/ref_ptr.h"
 
@@ -51,6 +52,13 @@ using MemStatistics = global::Statistics;
 /// @return MemBlock pointer
 MemBlock* Allocate();
 
+/// @brief Allocate a MemBlock object whose data area fits `size` bytes, from the size class that fits it best.
+/// @param size Expected number of bytes to store, the data area of the block is smaller than `size` only if `size`
+///             exceeds the largest size class (and the fixed block size).
+/// @return MemBlock pointer, use `GetBlockMaxAvailableSize(block)` to get its data area size.
+/// @note Falls back to `Allocate()` if the best fit is the fixed block size.
+MemBlock* Allocate(std::size_t size);
+
 /// @brief Freeing a memory block.
 /// @param block MemBlock pointer
 void Deallocate(MemBlock* block);
@@ -73,6 +81,11 @@ RefPtr<memory_pool::MemBlock> MakeBlockRef(memory_pool::MemBlock* ptr);
 ///         in data.
 std::size_t GetBlockMaxAvailableSize();
 
+/// @brief Get the available data area size of `block`, which may be allocated by size class.
+/// @param block MemBlock pointer
+/// @return The maximum amount of data that can be stored in `block`.
+std::size_t GetBlockMaxAvailableSize(const memory_pool::MemBlock* block);
+
 /// @private
 template <>
 struct RefTraits<memory_pool::MemBlock> {
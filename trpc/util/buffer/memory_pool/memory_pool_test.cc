@@ -34,6 +34,28 @@ TEST(MemoryPool, AllocateAndDeallocateTest) {
 
 TEST(MemoryPool, GetBlockMaxAvailableSizeTest) { ASSERT_TRUE(GetBlockMaxAvailableSize() > 0); }
 
+TEST(MemoryPool, AllocateBySizeTest) {
+  // Small data gets a block of size class rather than a whole fixed size block.
+  MemBlock* small = Allocate(100);
+  ASSERT_TRUE(small != nullptr);
+  ASSERT_NE(small->size_class, kFixedSizeClass);
+  ASSERT_GE(GetBlockMaxAvailableSize(small), 100);
+  ASSERT_LT(GetBlockMaxAvailableSize(small), GetBlockMaxAvailableSize());
+  Deallocate(small);
+
+  MemBlock* large = Allocate(32 * 1024);
+  ASSERT_TRUE(large != nullptr);
+  ASSERT_GE(GetBlockMaxAvailableSize(large), 32 * 1024);
+  Deallocate(large);
+
+  // Best fit is the fixed block size.
+  MemBlock* fixed = Allocate(GetBlockMaxAvailableSize());
+  ASSERT_TRUE(fixed != nullptr);
+  ASSERT_EQ(fixed->size_class, kFixedSizeClass);
+  ASSERT_EQ(GetBlockMaxAvailableSize(fixed), GetBlockMaxAvailableSize());
+  Deallocate(fixed);
+}
+
 TEST(MemoryPool, MakeBlockRefTest) {
   MemBlock* block = Allocate();
   RefPtr<MemBlock> ref_block = MakeBlockRef(block);
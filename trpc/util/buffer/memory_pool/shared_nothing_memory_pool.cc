@@ -137,7 +137,7 @@ SharedNothingMemPoolImp::~SharedNothingMemPoolImp() {
       free_chunk_count++;
       del_func(block_chunk.chunk_addr);
       // After releasing memory, the size of the memory pool becomes smaller.
-      s_current_pool_size.fetch_sub(chunk_mem_size_, std::memory_order::memory_order_relaxed);
+      s_current_pool_size.fetch_sub(chunk_mem_size_, std::memory_order_relaxed);
     } else {
       TRPC_FMT_ERROR("Memory leak, chunk_id = {}, chunk_addr = {}", chunk_id, block_chunk.chunk_addr);
     }
@@ -151,7 +151,7 @@ SharedNothingMemPoolImp::~SharedNothingMemPoolImp() {
 }
 
 bool SharedNothingMemPoolImp::NewBlockChunk() {
-  auto current_pool_size = s_current_pool_size.load(std::memory_order::memory_order_relaxed);
+  auto current_pool_size = s_current_pool_size.load(std::memory_order_relaxed);
   if (TRPC_UNLIKELY(current_pool_size >= GetMemPoolThreshold())) {
     TRPC_FMT_INFO_EVERY_SECOND("Block Allocate {}, beyond {} limited.", current_pool_size, GetMemPoolThreshold());
     return false;
@@ -186,7 +186,7 @@ bool SharedNothingMemPoolImp::NewBlockChunk() {
 
   // Increase the allocation count statistics
   ++GetTlsStatistics().block_chunks_alloc_num;
-  s_current_pool_size.fetch_add(chunk_mem_size_, std::memory_order::memory_order_relaxed);
+  s_current_pool_size.fetch_add(chunk_mem_size_, std::memory_order_relaxed);
 
   return true;
 }
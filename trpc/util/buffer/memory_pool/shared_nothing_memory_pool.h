@@ -42,6 +42,7 @@ struct alignas(64) Block {
   std::atomic<std::uint32_t> ref_count{1};  ///< Reference counting, used for smart pointer implementations.
   bool need_free_to_system{true};           ///< Whether it needs to be returned to the system after each use.
   char* data{nullptr};                      ///< The  actual address used to store business data.
+  std::uint8_t size_class{kFixedSizeClass};  ///< Size class of the block, see `kFixedSizeClass`.
 };
 
 /// @brief Free block list
@@ -0,0 +1,66 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/util/buffer/memory_pool/size_class_memory_pool.h"
+
+#include "trpc/util/algorithm/power_of_two.h"
+
+namespace trpc::memory_pool::size_class {
+
+namespace {
+
+struct alignas(64) ClassCounters {
+  std::atomic<std::size_t> alive_blocks{0};
+  std::atomic<std::ptrdiff_t> global_cached_blocks{0};
+};
+
+ClassCounters class_counters[kSizeClassNum];
+
+}  // namespace
+
+std::size_t GetSizeClassIndex(std::size_t block_size) noexcept {
+  if (block_size <= GetSizeClassBlockSize(0)) {
+    return 0;
+  }
+  if (block_size >= GetSizeClassBlockSize(kSizeClassNum - 1)) {
+    return kSizeClassNum - 1;
+  }
+  return __builtin_ctzll(RoundUpPowerOf2(block_size)) - kMinSizeClassShift;
+}
+
+Statistics GetStatistics(std::size_t index) noexcept {
+  TRPC_CHECK_LT(index, kSizeClassNum);
+  Statistics stat;
+  stat.block_size = GetSizeClassBlockSize(index);
+  stat.alive_blocks = class_counters[index].alive_blocks.load(std::memory_order_relaxed);
+  stat.global_cached_blocks = class_counters[index].global_cached_blocks.load(std::memory_order_relaxed);
+  return stat;
+}
+
+namespace detail {
+
+void OnAllocateFromSystem(std::size_t index) noexcept {
+  class_counters[index].alive_blocks.fetch_add(1, std::memory_order_relaxed);
+}
+
+void OnFreeToSystem(std::size_t index) noexcept {
+  class_counters[index].alive_blocks.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void OnGlobalCachedChanged(std::size_t index, std::ptrdiff_t delta) noexcept {
+  class_counters[index].global_cached_blocks.fetch_add(delta, std::memory_order_relaxed);
+}
+
+}  // namespace detail
+
+}  // namespace trpc::memory_pool::size_class
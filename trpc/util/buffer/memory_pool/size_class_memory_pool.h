@@ -0,0 +1,207 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "trpc/util/buffer/memory_pool/common.h"
+#include "trpc/util/check.h"
+#include "trpc/util/internal/never_destroyed.h"
+#include "trpc/util/likely.h"
+
+namespace trpc::memory_pool::size_class {
+
+/// @brief Usage of a size class, sampled on the slow path only so that it costs nothing on the hot path.
+struct Statistics {
+  std::size_t block_size{0};            ///< Block size of the size class, header included.
+  std::size_t alive_blocks{0};          ///< Number of blocks allocated from the system and not yet freed to it.
+  std::size_t global_cached_blocks{0};  ///< Number of free blocks cached in the global free lists.
+};
+
+/// @brief Get the index of the smallest size class whose block is no smaller than `block_size`.
+/// @param block_size Required block size, header included.
+/// @return Index of the size class, `block_size` larger than the largest class gets the largest class.
+std::size_t GetSizeClassIndex(std::size_t block_size) noexcept;
+
+/// @brief Get the block size of the size class `index`, header included.
+constexpr std::size_t GetSizeClassBlockSize(std::size_t index) noexcept {
+  return std::size_t{1} << (kMinSizeClassShift + index);
+}
+
+/// @brief Get the usage of the size class `index`.
+Statistics GetStatistics(std::size_t index) noexcept;
+
+/// @private
+namespace detail {
+
+void OnAllocateFromSystem(std::size_t index) noexcept;
+void OnFreeToSystem(std::size_t index) noexcept;
+void OnGlobalCachedChanged(std::size_t index, std::ptrdiff_t delta) noexcept;
+
+/// @brief The byte budget of the free blocks cached by each thread for each size class.
+static constexpr std::size_t kLocalCacheBytes = 128 * 1024;
+/// @brief The minimum number of free blocks cached by each thread for each size class.
+static constexpr std::size_t kMinLocalCacheNum = 4;
+
+/// @brief Size class memory pool built on top of `Block` of the selected fixed block size memory pool.
+///        Each thread keeps a free list per size class, a full free list is handed over to the global free lists of
+///        that class as a whole, so the global lock is taken once per batch rather than once per block.
+/// @private For internal use purpose only.
+template <typename Block>
+class SizeClassMemPool {
+ public:
+  /// @brief Allocate a block of size class `index`.
+  static Block* Allocate(std::size_t index) noexcept {
+    FreeList& local = GetLocalCache()->lists[index];
+    if (TRPC_LIKELY(local.head != nullptr)) {
+      return Pop(local);
+    }
+
+    if (GetGlobalCache()[index].Pop(local, index)) {
+      return Pop(local);
+    }
+
+    return AllocateFromSystem(index);
+  }
+
+  /// @brief Free a block allocated by `Allocate`.
+  static void Deallocate(Block* block) noexcept {
+    std::size_t index = block->size_class;
+    TRPC_DCHECK_LT(index, kSizeClassNum);
+
+    FreeList& local = GetLocalCache()->lists[index];
+    if (TRPC_UNLIKELY(local.length >= GetLocalCacheNum(index))) {
+      GetGlobalCache()[index].Push(local, index);
+    }
+
+    block->next = local.head;
+    local.head = block;
+    ++local.length;
+  }
+
+ private:
+  struct FreeList {
+    Block* head{nullptr};
+    std::size_t length{0};
+  };
+
+  class GlobalFreeLists {
+   public:
+    // Take over `list` as a whole, `list` is left empty.
+    void Push(FreeList& list, std::size_t index) noexcept {
+      {
+        std::scoped_lock _(mutex_);
+        // Beyond the share of memory pool threshold of each class, memory is returned to the system instead.
+        if ((cached_num_ + list.length) * GetSizeClassBlockSize(index) <= GetMemPoolThreshold() / kSizeClassNum) {
+          cached_num_ += list.length;
+          OnGlobalCachedChanged(index, list.length);
+          lists_.push_back(list);
+          list = FreeList{};
+          return;
+        }
+      }
+      FreeToSystem(list, index);
+    }
+
+    // Hand a cached free list over to `list`, which must be empty.
+    bool Pop(FreeList& list, std::size_t index) noexcept {
+      std::scoped_lock _(mutex_);
+      if (lists_.empty()) {
+        return false;
+      }
+      list = lists_.back();
+      lists_.pop_back();
+      cached_num_ -= list.length;
+      OnGlobalCachedChanged(index, -static_cast<std::ptrdiff_t>(list.length));
+      return true;
+    }
+
+   private:
+    std::mutex mutex_;
+    std::vector<FreeList> lists_;
+    std::size_t cached_num_{0};
+  };
+
+  struct LocalCache {
+    FreeList lists[kSizeClassNum];
+
+    ~LocalCache() {
+      for (std::size_t i = 0; i != kSizeClassNum; ++i) {
+        if (lists[i].length > 0) {
+          GetGlobalCache()[i].Push(lists[i], i);
+        }
+      }
+    }
+  };
+
+  static std::size_t GetLocalCacheNum(std::size_t index) noexcept {
+    return std::max(kMinLocalCacheNum, kLocalCacheBytes / GetSizeClassBlockSize(index));
+  }
+
+  static Block* Pop(FreeList& list) noexcept {
+    Block* block = list.head;
+    list.head = block->next;
+    --list.length;
+    block->next = nullptr;
+    return block;
+  }
+
+  static Block* AllocateFromSystem(std::size_t index) noexcept {
+    std::size_t block_size = GetSizeClassBlockSize(index);
+    char* addr = static_cast<char*>(GetAllocateMemFunc()(alignof(Block), block_size));
+    if (TRPC_UNLIKELY(!addr)) {
+      return nullptr;
+    }
+    Block* block = new (addr) Block();
+    block->data = addr + sizeof(Block);
+    block->size_class = static_cast<std::uint8_t>(index);
+    OnAllocateFromSystem(index);
+    return block;
+  }
+
+  static void FreeToSystem(FreeList& list, std::size_t index) noexcept {
+    while (list.head != nullptr) {
+      Block* block = Pop(list);
+      block->~Block();
+      GetDeallocateMemFunc()(block);
+      OnFreeToSystem(index);
+    }
+  }
+
+  struct GlobalCache {
+    GlobalFreeLists lists[kSizeClassNum];
+  };
+
+  static GlobalFreeLists* GetGlobalCache() noexcept {
+    // Never destroyed, thread local caches may be flushed into it during process exit.
+    static internal::NeverDestroyed<GlobalCache> global_cache;
+    return global_cache->lists;
+  }
+
+  static LocalCache* GetLocalCache() noexcept {
+    thread_local LocalCache local_cache;
+    return &local_cache;
+  }
+};
+
+}  // namespace detail
+
+}  // namespace trpc::memory_pool::size_class
@@ -0,0 +1,89 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/util/buffer/memory_pool/size_class_memory_pool.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/util/buffer/memory_pool/global_memory_pool.h"
+
+namespace trpc::memory_pool::size_class::testing {
+
+using Block = global::detail::Block;
+using Pool = detail::SizeClassMemPool<Block>;
+
+TEST(SizeClassMemoryPool, GetSizeClassIndex) {
+  ASSERT_EQ(GetSizeClassIndex(1), 0);
+  ASSERT_EQ(GetSizeClassIndex(512), 0);
+  ASSERT_EQ(GetSizeClassIndex(513), 1);
+  ASSERT_EQ(GetSizeClassIndex(4096), 3);
+  ASSERT_EQ(GetSizeClassIndex(65536), kSizeClassNum - 1);
+  ASSERT_EQ(GetSizeClassIndex(1024 * 1024), kSizeClassNum - 1);
+
+  for (std::size_t i = 0; i != kSizeClassNum; ++i) {
+    ASSERT_EQ(GetSizeClassIndex(GetSizeClassBlockSize(i)), i);
+  }
+}
+
+TEST(SizeClassMemoryPool, AllocateAndDeallocate) {
+  for (std::size_t i = 0; i != kSizeClassNum; ++i) {
+    Block* block = Pool::Allocate(i);
+    ASSERT_NE(block, nullptr);
+    ASSERT_EQ(block->size_class, i);
+    ASSERT_EQ(block->data, reinterpret_cast<char*>(block) + sizeof(Block));
+    // The whole data area is writable.
+    memset(block->data, 0, GetSizeClassBlockSize(i) - sizeof(Block));
+    ASSERT_GE(GetStatistics(i).alive_blocks, 1);
+    Pool::Deallocate(block);
+
+    // Freed block is reused by the same thread.
+    ASSERT_EQ(Pool::Allocate(i), block);
+    Pool::Deallocate(block);
+  }
+}
+
+TEST(SizeClassMemoryPool, CrossThread) {
+  constexpr std::size_t kIndex = 2;
+  constexpr std::size_t kBlockNum = 1000;
+
+  std::vector<Block*> blocks;
+  std::thread allocator([&] {
+    for (std::size_t i = 0; i != kBlockNum; ++i) {
+      blocks.push_back(Pool::Allocate(kIndex));
+    }
+  });
+  allocator.join();
+
+  // Blocks freed by another thread are handed over via the global free lists when the thread exits.
+  std::thread deallocator([&] {
+    for (auto* block : blocks) {
+      Pool::Deallocate(block);
+    }
+  });
+  deallocator.join();
+  ASSERT_GT(GetStatistics(kIndex).global_cached_blocks, 0);
+
+  std::size_t alive = GetStatistics(kIndex).alive_blocks;
+  std::thread reuser([&] {
+    for (std::size_t i = 0; i != kBlockNum / 2; ++i) {
+      Pool::Deallocate(Pool::Allocate(kIndex));
+    }
+  });
+  reuser.join();
+  ASSERT_EQ(GetStatistics(kIndex).alive_blocks, alive);
+}
+
+}  // namespace trpc::memory_pool::size_class::testing
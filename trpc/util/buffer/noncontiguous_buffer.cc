@@ -136,9 +136,10 @@ void FlattenToSlowSlow(const NoncontiguousBuffer& nb, void* buffer, std::size_t
 
 BufferBuilder::BufferBuilder() { AllocateBuffer(); }
 
-void BufferBuilder::AllocateBuffer() {
+void BufferBuilder::AllocateBuffer(std::size_t expected_size) {
   used_ = 0;
-  current_ = MakeBlockRef(memory_pool::Allocate());
+  current_ = MakeBlockRef(expected_size ? memory_pool::Allocate(expected_size) : memory_pool::Allocate());
+  capacity_ = GetBlockMaxAvailableSize(current_.Get());
 }
 
 NoncontiguousBoyerMooreSearcher::NoncontiguousBoyerMooreSearcher(std::string_view pattern)
@@ -231,12 +232,29 @@ void NoncontiguousBuffer::ClearSlow() noexcept {
   }
 }
 
-void NoncontiguousBufferBuilder::InitializeNextBlock() {
+void NoncontiguousBufferBuilder::InitializeNextBlock(std::size_t min_bytes) {
   if (current_) {
     TRPC_CHECK(SizeAvailable());
     return;
   }
-  current_ = MakeBlockRef(memory_pool::Allocate());
+
+  std::size_t written = nb_.ByteSize();
+  if (expected_size_ > written) {
+    // Size the block to what remains of the expected size.
+    current_ = MakeBlockRef(memory_pool::Allocate(std::max(expected_size_ - written, min_bytes)));
+  } else if (expected_size_) {
+    // The expected size has been reached, the block is most likely left unused (e.g. the body is appended without
+    // copy), so the smallest one is taken. The hint is dropped as it turns out to be inaccurate if more is written.
+    current_ = MakeBlockRef(memory_pool::Allocate(min_bytes));
+    expected_size_ = 0;
+  } else {
+    current_ = MakeBlockRef(memory_pool::Allocate());
+  }
+  capacity_ = GetBlockMaxAvailableSize(current_.Get());
+  if (TRPC_UNLIKELY(capacity_ < min_bytes)) {
+    current_ = MakeBlockRef(memory_pool::Allocate(min_bytes));
+    capacity_ = GetBlockMaxAvailableSize(current_.Get());
+  }
 
   used_ = 0;
 }
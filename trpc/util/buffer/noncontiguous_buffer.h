@@ -259,13 +259,31 @@ class BufferBuilder {
     auto rc = object_pool::MakeLwUnique<BufferBlock>();
     rc->Reset(used_, bytes, current_);
     used_ += bytes;
-    if (used_ == GetBlockMaxAvailableSize()) {
+    if (used_ == capacity_) {
       // If `current_` has been fully utilized, allocate a new BufferBlock
       AllocateBuffer();
     }
     return rc;
   }
 
+  /// @brief Make the next write able to take `expected_size` bytes in a single block, e.g. the bytes known to be
+  ///        pending in the socket. If the space left is not enough, a block of the size class fitting
+  ///        `expected_size` (up to the largest class) replaces the current one.
+  /// @param expected_size Number of bytes expected to be written next
+  void Reserve(std::size_t expected_size) {
+    if (SizeAvailable() < expected_size) {
+      AllocateBuffer(expected_size);
+    }
+  }
+
+  /// @brief Replace the current block with one of fixed size if it is larger, so that a connection going idle after
+  ///        a burst of large reads does not keep a large block.
+  void Shrink() {
+    if (capacity_ > GetBlockMaxAvailableSize()) {
+      AllocateBuffer();
+    }
+  }
+
   /// @brief Clear memory block.
   void Clear() { current_.Reset(); }
 
@@ -275,13 +293,15 @@ class BufferBuilder {
 
   /// @brief Maximum available memory size.
   /// @return The maximum size of availavle memory
-  std::size_t SizeAvailable() const noexcept { return GetBlockMaxAvailableSize() - used_; }
+  std::size_t SizeAvailable() const noexcept { return capacity_ - used_; }
 
  private:
-  void AllocateBuffer();
+  // Allocate a block fitting `expected_size` bytes, a block of fixed size is allocated if `expected_size` is 0.
+  void AllocateBuffer(std::size_t expected_size = 0);
 
  private:
   std::size_t used_;
+  std::size_t capacity_;
   RefPtr<memory_pool::MemBlock> current_;
 };
 
@@ -515,13 +535,20 @@ class NoncontiguousBufferBuilder {
  public:
   NoncontiguousBufferBuilder() { InitializeNextBlock(); }
 
+  /// @brief Construct with a hint of the total size to be written, so that blocks of proper size class are used
+  ///        (e.g. a small header does not occupy a whole block, and a large body is split into fewer blocks).
+  /// @param expected_size The expected number of bytes to be written, it is only a hint.
+  explicit NoncontiguousBufferBuilder(std::size_t expected_size) : expected_size_(expected_size) {
+    InitializeNextBlock();
+  }
+
   /// @brief Get available addresses.
   /// @return Available address pointer.
   char* data() const noexcept { return current_->data + used_; }
 
   /// @brief Get maximum size of available memory.
   /// @return The maximum size of available memory.
-  std::size_t SizeAvailable() const noexcept { return GetBlockMaxAvailableSize() - used_; }
+  std::size_t SizeAvailable() const noexcept { return capacity_ - used_; }
 
   /// @brief Mark `bytes` bytes. If the current intermediate BufferBlock is fully utilized,
   ///        a new one will be constructed.
@@ -546,7 +573,8 @@ class NoncontiguousBufferBuilder {
     if (SizeAvailable() < bytes) {
       // There is not enough space available in the intermediate contiguous buffer, so a new one needs to be created.
       FlushCurrentBlock();
-      InitializeNextBlock();
+      current_.Reset();
+      InitializeNextBlock(bytes);
     }
     auto* ptr = data();
     MarkWritten(bytes);
@@ -579,7 +607,7 @@ class NoncontiguousBufferBuilder {
     // First, increase the value of `used_`. This operation may cause `used_` to temporarily overflow.
     // If it overflows, use the `AppendSlow` method to continue the operation.
     used_ += length;
-    if (TRPC_LIKELY(used_ < GetBlockMaxAvailableSize())) {
+    if (TRPC_LIKELY(used_ < capacity_)) {
       // If the current size of the intermediate contiguous buffer is sufficient, simply perform a direct copy.
 #if __GNUC__ == 10
 #pragma GCC diagnostic push
@@ -636,7 +664,7 @@ class NoncontiguousBufferBuilder {
     auto current = data();
     auto total = (detail::size(buffers) + ...);
     used_ += total;
-    if (TRPC_LIKELY(used_ < GetBlockMaxAvailableSize())) {
+    if (TRPC_LIKELY(used_ < capacity_)) {
       UncheckedAppend(current, buffers...);
       return;
     }
@@ -646,8 +674,8 @@ class NoncontiguousBufferBuilder {
   }
 
  private:
-  // Allocate a new contiguous buffer.
-  void InitializeNextBlock();
+  // Allocate a new contiguous buffer, which is able to hold at least `min_bytes` bytes.
+  void InitializeNextBlock(std::size_t min_bytes = 0);
 
   // Move the currently used contiguous buffer to NoncontiguousBuffer.
   void FlushCurrentBlock();
@@ -667,7 +695,9 @@ class NoncontiguousBufferBuilder {
 
  private:
   NoncontiguousBuffer nb_;
+  std::size_t expected_size_{0};
   std::size_t used_{0};
+  std::size_t capacity_{0};
   RefPtr<memory_pool::MemBlock> current_;
 };
 
@@ -354,4 +354,55 @@ TEST(NoncontiguousBuffer, BufferBlock) {
   ASSERT_TRUE(b2.size() == 0);
 }
 
+TEST(NoncontiguousBufferBuilder, ExpectedSize) {
+  // A small message takes a block no larger than necessary.
+  NoncontiguousBufferBuilder small(40);
+  ASSERT_GE(small.SizeAvailable(), 40);
+  ASSERT_LT(small.SizeAvailable(), GetBlockMaxAvailableSize());
+  small.Append(std::string(40, 'a'));
+  ASSERT_EQ(std::string(40, 'a'), FlattenSlow(small.DestructiveGet()));
+
+  // A large message is split into fewer blocks.
+  std::string large(1024 * 1024, 'b');
+  NoncontiguousBufferBuilder builder(large.size());
+  builder.Append(large);
+  auto buffer = builder.DestructiveGet();
+  ASSERT_EQ(large, FlattenSlow(buffer));
+  ASSERT_LT(buffer.size(), large.size() / GetBlockMaxAvailableSize());
+
+  // Reserve more than a small block holds.
+  NoncontiguousBufferBuilder reserve(10);
+  auto* ptr = reserve.Reserve(1000);
+  memset(ptr, 'c', 1000);
+  ASSERT_EQ(std::string(1000, 'c'), FlattenSlow(reserve.DestructiveGet()));
+}
+
+TEST(BufferBuilder, ReserveAndShrink) {
+  BufferBuilder builder;
+  std::size_t initial = builder.SizeAvailable();
+  ASSERT_EQ(initial, GetBlockMaxAvailableSize());
+
+  // Enough space left, nothing changes.
+  builder.Reserve(initial / 2);
+  ASSERT_EQ(builder.SizeAvailable(), initial);
+
+  // A block of larger size class is taken for a large read.
+  builder.Seal(initial / 2);
+  builder.Reserve(initial * 4);
+  ASSERT_GE(builder.SizeAvailable(), initial * 4);
+  auto block = builder.Seal(initial * 4);
+  ASSERT_EQ(block->size(), initial * 4);
+
+  // Back to the fixed size once shrunk.
+  builder.Shrink();
+  ASSERT_EQ(builder.SizeAvailable(), initial);
+  builder.Shrink();
+  ASSERT_EQ(builder.SizeAvailable(), initial);
+
+  // Full blocks are followed by blocks of fixed size.
+  builder.Reserve(initial * 4);
+  builder.Seal(builder.SizeAvailable());
+  ASSERT_EQ(builder.SizeAvailable(), initial);
+}
+
 }  // namespace trpc
@@ -0,0 +1,216 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace trpc::container {
+
+/// @brief A vector which keeps up to `kInlineSize` elements inside the object itself, and spills to the heap only when
+///        it grows beyond that.
+/// @note Unlike `std::vector`, moving a vector whose elements are stored inline moves the elements one by one, so the
+///       iterators and references to them are invalidated by moving as well.
+template <typename T, std::size_t kInlineSize>
+class SmallVector {
+  static_assert(kInlineSize > 0, "Inline size must be positive.");
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  SmallVector() noexcept = default;
+
+  SmallVector(std::initializer_list<T> init) {
+    reserve(init.size());
+    for (const auto& e : init) {
+      emplace_back(e);
+    }
+  }
+
+  SmallVector(const SmallVector& other) {
+    reserve(other.size_);
+    std::uninitialized_copy(other.begin(), other.end(), data_);
+    size_ = other.size_;
+  }
+
+  SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) { MoveFrom(std::move(other)); }
+
+  SmallVector& operator=(const SmallVector& other) {
+    if (this != &other) {
+      clear();
+      reserve(other.size_);
+      std::uninitialized_copy(other.begin(), other.end(), data_);
+      size_ = other.size_;
+    }
+    return *this;
+  }
+
+  SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+      clear();
+      FreeHeap();
+      MoveFrom(std::move(other));
+    }
+    return *this;
+  }
+
+  ~SmallVector() {
+    clear();
+    FreeHeap();
+  }
+
+  iterator begin() noexcept { return data_; }
+  const_iterator begin() const noexcept { return data_; }
+  const_iterator cbegin() const noexcept { return data_; }
+  iterator end() noexcept { return data_ + size_; }
+  const_iterator end() const noexcept { return data_ + size_; }
+  const_iterator cend() const noexcept { return data_ + size_; }
+
+  T* data() noexcept { return data_; }
+  const T* data() const noexcept { return data_; }
+
+  T& operator[](size_type index) noexcept { return data_[index]; }
+  const T& operator[](size_type index) const noexcept { return data_[index]; }
+
+  T& front() noexcept { return data_[0]; }
+  const T& front() const noexcept { return data_[0]; }
+  T& back() noexcept { return data_[size_ - 1]; }
+  const T& back() const noexcept { return data_[size_ - 1]; }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  size_type capacity() const noexcept { return capacity_; }
+
+  /// @brief Reports whether the elements are stored inside the object.
+  bool is_inline() const noexcept { return data_ == InlineData(); }
+
+  /// @brief Makes sure that `capacity()` is no less than `new_capacity`.
+  void reserve(size_type new_capacity) {
+    if (new_capacity > capacity_) {
+      Reallocate(new_capacity);
+    }
+  }
+
+  template <typename... Args>
+  T& emplace_back(Args&&... args) {
+    if (size_ == capacity_) {
+      // Constructs the element first, `args` may refer to an element of this vector.
+      T value(std::forward<Args>(args)...);
+      Reallocate(capacity_ * 2);
+      return *new (data_ + size_++) T(std::move(value));
+    }
+    return *new (data_ + size_++) T(std::forward<Args>(args)...);
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  void pop_back() noexcept { data_[--size_].~T(); }
+
+  /// @brief Inserts an element constructed from `args` before `pos`.
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args) {
+    size_type index = pos - data_;
+    if (index == size_) {
+      emplace_back(std::forward<Args>(args)...);
+      return data_ + index;
+    }
+    T value(std::forward<Args>(args)...);
+    if (size_ == capacity_) {
+      Reallocate(capacity_ * 2);
+    }
+    new (data_ + size_) T(std::move(data_[size_ - 1]));
+    std::move_backward(data_ + index, data_ + size_ - 1, data_ + size_);
+    ++size_;
+    data_[index] = std::move(value);
+    return data_ + index;
+  }
+
+  iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+  iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+  /// @brief Erases the elements in `[first, last)`, returns the iterator following the last erased element.
+  iterator erase(const_iterator first, const_iterator last) {
+    iterator dst = data_ + (first - data_);
+    if (first != last) {
+      iterator new_end = std::move(data_ + (last - data_), end(), dst);
+      std::destroy(new_end, end());
+      size_ = new_end - data_;
+    }
+    return dst;
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  /// @brief Destroys all elements, the heap memory (if any) is kept for reuse.
+  void clear() noexcept {
+    std::destroy(begin(), end());
+    size_ = 0;
+  }
+
+ private:
+  T* InlineData() noexcept { return reinterpret_cast<T*>(inline_); }
+  const T* InlineData() const noexcept { return reinterpret_cast<const T*>(inline_); }
+
+  void Reallocate(size_type new_capacity) {
+    T* new_data = static_cast<T*>(::operator new(new_capacity * sizeof(T), std::align_val_t{alignof(T)}));
+    std::uninitialized_move(begin(), end(), new_data);
+    std::destroy(begin(), end());
+    FreeHeap();
+    data_ = new_data;
+    capacity_ = new_capacity;
+  }
+
+  void FreeHeap() noexcept {
+    if (!is_inline()) {
+      ::operator delete(data_, std::align_val_t{alignof(T)});
+      data_ = InlineData();
+      capacity_ = kInlineSize;
+    }
+  }
+
+  // `this` holds no element and no heap memory on entry.
+  void MoveFrom(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    if (!other.is_inline()) {
+      data_ = std::exchange(other.data_, other.InlineData());
+      size_ = std::exchange(other.size_, 0);
+      capacity_ = std::exchange(other.capacity_, kInlineSize);
+      return;
+    }
+    std::uninitialized_move(other.begin(), other.end(), data_);
+    size_ = other.size_;
+    other.clear();
+  }
+
+ private:
+  alignas(T) unsigned char inline_[kInlineSize * sizeof(T)];
+  T* data_{InlineData()};
+  size_type size_{0};
+  size_type capacity_{kInlineSize};
+};
+
+}  // namespace trpc::container
@@ -0,0 +1,95 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#include "trpc/util/container/small_vector.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::container::testing {
+
+namespace {
+
+template <typename T, std::size_t N>
+std::vector<T> ToVector(const SmallVector<T, N>& v) {
+  return std::vector<T>(v.begin(), v.end());
+}
+
+}  // namespace
+
+TEST(SmallVectorTest, InlineThenHeap) {
+  SmallVector<std::string, 2> v;
+  ASSERT_TRUE(v.empty());
+  ASSERT_EQ(2, v.capacity());
+
+  v.emplace_back("a");
+  v.push_back("b");
+  ASSERT_TRUE(v.is_inline());
+  ASSERT_EQ(2, v.size());
+
+  // Grows beyond inline storage, the element referred to must be copied before growing.
+  v.push_back(v[0]);
+  ASSERT_FALSE(v.is_inline());
+  ASSERT_EQ((std::vector<std::string>{"a", "b", "a"}), ToVector(v));
+
+  v.clear();
+  ASSERT_TRUE(v.empty());
+  ASSERT_FALSE(v.is_inline());  // Heap memory is kept for reuse.
+}
+
+TEST(SmallVectorTest, InsertAndErase) {
+  SmallVector<std::string, 4> v{"b", "d"};
+  v.insert(v.begin(), "a");
+  v.emplace(v.begin() + 2, "c");
+  v.insert(v.end(), "e");
+  ASSERT_EQ((std::vector<std::string>{"a", "b", "c", "d", "e"}), ToVector(v));
+
+  auto it = v.erase(v.begin() + 1, v.begin() + 3);
+  ASSERT_EQ("d", *it);
+  ASSERT_EQ((std::vector<std::string>{"a", "d", "e"}), ToVector(v));
+
+  it = v.erase(v.end() - 1);
+  ASSERT_EQ(v.end(), it);
+  v.pop_back();
+  ASSERT_EQ((std::vector<std::string>{"a"}), ToVector(v));
+}
+
+TEST(SmallVectorTest, CopyAndMove) {
+  SmallVector<std::unique_ptr<int>, 2> inline_v;
+  inline_v.emplace_back(std::make_unique<int>(1));
+
+  auto moved = std::move(inline_v);
+  ASSERT_TRUE(inline_v.empty());
+  ASSERT_EQ(1, *moved[0]);
+
+  SmallVector<std::unique_ptr<int>, 2> heap_v;
+  for (int i = 0; i != 3; ++i) {
+    heap_v.emplace_back(std::make_unique<int>(i));
+  }
+  int* data = heap_v[0].get();
+  moved = std::move(heap_v);
+  ASSERT_TRUE(heap_v.empty());
+  ASSERT_TRUE(heap_v.is_inline());
+  ASSERT_EQ(3, moved.size());
+  ASSERT_EQ(data, moved[0].get());
+
+  SmallVector<std::string, 2> strs{"x", "y", "z"};
+  SmallVector<std::string, 2> copied(strs);
+  ASSERT_EQ(ToVector(strs), ToVector(copied));
+  copied = SmallVector<std::string, 2>{"w"};
+  ASSERT_EQ((std::vector<std::string>{"w"}), ToVector(copied));
+}
+
+}  // namespace trpc::container::testing
@@ -13,18 +13,93 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <cstring>
 #include <functional>
-#include <map>
+#include <iterator>
+#include <ostream>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+#include "trpc/util/container/small_vector.h"
+
 namespace trpc::http {
 
 /// @brief Namespace of details for http sub-module.
 /// @private For internal use purpose only.
 namespace detail {
+/// @brief Folds the ASCII upper case letters among the 8 bytes of |word| to lower case, other bytes are kept as is.
+/// All bytes are handled at once without branches, which compilers are able to vectorize further.
+/// @private For internal use purpose only.
+inline std::uint64_t FoldAsciiCase(std::uint64_t word) {
+  constexpr std::uint64_t kOnes = 0x0101010101010101ULL;
+  constexpr std::uint64_t kHighBits = kOnes * 0x80;
+  // Adding to the low 7 bits of each byte never carries into the next byte, the high bit of the sum tells whether
+  // the byte reaches the bound.
+  std::uint64_t low_bits = word & ~kHighBits;
+  std::uint64_t ge_a = low_bits + kOnes * (0x80 - 'A');
+  std::uint64_t gt_z = low_bits + kOnes * (0x80 - 'Z' - 1);
+  std::uint64_t upper = (ge_a ^ gt_z) & ~word & kHighBits;
+  return word | (upper >> 2);
+}
+
+/// @brief Reports whether the |size| bytes of |lhs| and |rhs| are equal. (Case ignored)
+/// @private For internal use purpose only.
+inline bool CaseInsensitiveEqual(const char* lhs, const char* rhs, std::size_t size) {
+  // Bytes of the same case, which is the usual case, are equal without folding.
+  auto equal = [](std::uint64_t l, std::uint64_t r) { return l == r || FoldAsciiCase(l) == FoldAsciiCase(r); };
+  std::uint64_t l = 0, r = 0;
+  if (size < 8) {
+    memcpy(&l, lhs, size);
+    memcpy(&r, rhs, size);
+    return equal(l, r);
+  }
+  for (std::size_t i = 0; i + 8 < size; i += 8) {
+    memcpy(&l, lhs + i, 8);
+    memcpy(&r, rhs + i, 8);
+    if (!equal(l, r)) {
+      return false;
+    }
+  }
+  // The last 8 bytes, which may overlap the ones compared above.
+  memcpy(&l, lhs + size - 8, 8);
+  memcpy(&r, rhs + size - 8, 8);
+  return equal(l, r);
+}
+
+/// @brief Compares two strings like `strncasecmp` does in the "C" locale, a string is less than the strings it's a
+/// prefix of. (Case ignored)
+/// @private For internal use purpose only.
+inline int CaseInsensitiveCompare(std::string_view lhs, std::string_view rhs) {
+  std::size_t size = std::min(lhs.size(), rhs.size());
+  std::size_t i = 0;
+  // Skips the equal prefix 8 bytes at a time, the first different byte is located byte by byte below.
+  for (; i + 8 <= size; i += 8) {
+    if (!CaseInsensitiveEqual(lhs.data() + i, rhs.data() + i, 8)) {
+      break;
+    }
+  }
+  if (i + 8 > size && CaseInsensitiveEqual(lhs.data() + i, rhs.data() + i, size - i)) {
+    i = size;
+  }
+  for (; i < size; ++i) {
+    unsigned l = static_cast<unsigned char>(lhs[i]);
+    unsigned r = static_cast<unsigned char>(rhs[i]);
+    l = l - 'A' < 26u ? (l | 0x20) : l;
+    r = r - 'A' < 26u ? (r | 0x20) : r;
+    if (l != r) {
+      return l < r ? -1 : 1;
+    }
+  }
+  return lhs.size() == rhs.size() ? 0 : (lhs.size() < rhs.size() ? -1 : 1);
+}
+
 /// @brief Compares two strings, reports whether |lhs| less than |rhs|.
 /// @private For internal use purpose only.
 struct CaseSensitiveLess : public std::less<> {
@@ -37,18 +112,21 @@ struct CaseInsensitiveLess : public std::less<> {
   bool operator()(std::string_view lhs, std::string_view rhs) const {
     // HTTP/2 uses special pseudo-header fields beginning with ':' character (ASCII 0x3a).
     // All pseudo-header fields MUST appear in the header block before regular header fields.
-    if (lhs.size() != rhs.size() && lhs.front() != ':' && rhs.front() != ':') {
+    if (lhs.size() != rhs.size() && !IsPseudo(lhs) && !IsPseudo(rhs)) {
       return lhs.size() < rhs.size();
     }
-    return strncasecmp(lhs.data(), rhs.data(), lhs.size()) < 0;
+    return CaseInsensitiveCompare(lhs, rhs) < 0;
   }
+
+ private:
+  static bool IsPseudo(std::string_view name) { return !name.empty() && name.front() == ':'; }
 };
 
 /// @brief Compares two strings, reports whether |lhs| equals |rhs|. (Case ignored)
 /// @private For internal use purpose only.
 struct CaseInsensitiveEqualTo : public std::equal_to<> {
   bool operator()(std::string_view lhs, std::string_view rhs) const {
-    return lhs.size() == rhs.size() && strncasecmp(lhs.data(), rhs.data(), lhs.size()) == 0;
+    return lhs.size() == rhs.size() && CaseInsensitiveEqual(lhs.data(), rhs.data(), lhs.size());
   }
 };
 
@@ -56,47 +134,261 @@ struct CaseInsensitiveEqualTo : public std::equal_to<> {
 /// @private For internal use purpose only.
 using EqualTo = std::function<bool(std::string_view lhs, std::string_view rhs)>;
 
+/// @brief Header fields looked up for nearly every message. A case-insensitive `FieldMap` keeps track of where they
+/// are, so that they are found without searching.
+/// @private For internal use purpose only.
+enum WellKnownField : int {
+  kWellKnownHost,
+  kWellKnownAccept,
+  kWellKnownConnection,
+  kWellKnownUserAgent,
+  kWellKnownContentType,
+  kWellKnownContentLength,
+  kWellKnownAcceptEncoding,
+  kWellKnownContentEncoding,
+  kWellKnownTransferEncoding,
+  kWellKnownFieldNum,
+};
+
+/// @private For internal use purpose only.
+inline constexpr std::string_view kWellKnownFieldNames[kWellKnownFieldNum] = {
+    "Host",           "Accept",          "Connection",       "User-Agent",        "Content-Type",
+    "Content-Length", "Accept-Encoding", "Content-Encoding", "Transfer-Encoding",
+};
+
+/// @brief Returns the well-known field named |name|, or -1 if |name| isn't well-known. (Case ignored)
+/// @private For internal use purpose only.
+inline int GetWellKnownField(std::string_view name) {
+  int field;
+  // The names of the well-known fields have distinct lengths, except "Connection" and "User-Agent".
+  switch (name.size()) {
+    case 4:
+      field = kWellKnownHost;
+      break;
+    case 6:
+      field = kWellKnownAccept;
+      break;
+    case 10:
+      field = (name.front() | 0x20) == 'c' ? kWellKnownConnection : kWellKnownUserAgent;
+      break;
+    case 12:
+      field = kWellKnownContentType;
+      break;
+    case 14:
+      field = kWellKnownContentLength;
+      break;
+    case 15:
+      field = kWellKnownAcceptEncoding;
+      break;
+    case 16:
+      field = kWellKnownContentEncoding;
+      break;
+    case 17:
+      field = kWellKnownTransferEncoding;
+      break;
+    default:
+      return -1;
+  }
+  return CaseInsensitiveEqualTo()(name, kWellKnownFieldNames[field]) ? field : -1;
+}
+
+/// @brief A key or value of FieldMap. It either owns its bytes, or refers to bytes pinned by the map without copying
+/// them.
+/// @private For internal use purpose only.
+class FieldString {
+ public:
+  FieldString() = default;
+  FieldString(std::string str) : str_(std::move(str)) {}
+  FieldString(std::string_view str) : str_(str) {}
+  FieldString(const char* str) : str_(str) {}
+
+  /// @brief Refers to |view| without copying it, the bytes of |view| must outlive the returned object.
+  static FieldString Pinned(std::string_view view) {
+    FieldString pinned;
+    pinned.view_ = view;
+    return pinned;
+  }
+
+  /// @brief Returns the bytes without copying them.
+  std::string_view View() const { return IsPinned() ? view_ : std::string_view{str_}; }
+  operator std::string_view() const { return View(); }
+
+  /// @brief Returns the bytes as a string, the bytes referred to are copied into the object on the first call.
+  const std::string& Str() const {
+    if (IsPinned()) {
+      str_.assign(view_.data(), view_.size());
+      view_ = {};
+    }
+    return str_;
+  }
+
+  friend bool operator==(const FieldString& lhs, std::string_view rhs) { return lhs.View() == rhs; }
+  friend bool operator==(std::string_view lhs, const FieldString& rhs) { return lhs == rhs.View(); }
+  friend bool operator!=(const FieldString& lhs, std::string_view rhs) { return lhs.View() != rhs; }
+  friend bool operator!=(std::string_view lhs, const FieldString& rhs) { return lhs != rhs.View(); }
+  friend std::ostream& operator<<(std::ostream& os, const FieldString& str) { return os << str.View(); }
+
+ private:
+  // An empty pinned view behaves the same as an empty string, so a null view is taken as "not pinned".
+  bool IsPinned() const { return view_.data() != nullptr; }
+
+ private:
+  mutable std::string str_;
+  mutable std::string_view view_;
+};
+
 /// @brief A map represents the key-value pairs, a key may map to many values, key is compared by "Compare" parameter.
+///
+/// The pairs are stored flat in the order they are added, the first `kInlinePairs` of them inside the map itself, so a
+/// typical message needs no allocation for its fields. A sorted index of their positions keeps the iteration order by
+/// key, adding a pair moves a few positions rather than the pairs. A case-insensitive map (the HTTP header) also keeps
+/// the position of the well-known fields (see `WellKnownField`), looking them up costs no search.
+///
+/// Fields parsed from received bytes are usually added by `AddPinned`, which refers to the bytes pinned by the map
+/// rather than copying them. A value of them is copied only when it is got as `std::string` by `Get`, so `GetView` is
+/// preferred on hot paths. Like the other accessors, `Get` must not be called concurrently with each other on the same
+/// map.
+///
+/// @note The references, views and iterators returned by the map are invalidated by the next modification of the map.
 /// @private For internal use purpose only.
-template <typename Compare>
+template <typename Compare, std::size_t kInlinePairs = 16>
 class FieldMap {
+  using Pair = std::pair<FieldString, FieldString>;
+  using PairVector = container::SmallVector<Pair, kInlinePairs>;
+  // Positions of pairs in `PairVector`, sorted by the key of the pairs.
+  using Order = container::SmallVector<std::uint32_t, kInlinePairs>;
+
  public:
+  /// @brief Iterates over the key-value pairs in key order.
+  class ConstPairtIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Pair;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Pair*;
+    using reference = const Pair&;
+
+    ConstPairtIterator() = default;
+    ConstPairtIterator(const Pair* pairs, typename Order::const_iterator pos) : pairs_(pairs), pos_(pos) {}
+
+    reference operator*() const { return pairs_[*pos_]; }
+    pointer operator->() const { return &pairs_[*pos_]; }
+
+    ConstPairtIterator& operator++() {
+      ++pos_;
+      return *this;
+    }
+    ConstPairtIterator operator++(int) { return ConstPairtIterator(pairs_, pos_++); }
+    ConstPairtIterator& operator--() {
+      --pos_;
+      return *this;
+    }
+    ConstPairtIterator operator--(int) { return ConstPairtIterator(pairs_, pos_--); }
+
+    friend bool operator==(const ConstPairtIterator& lhs, const ConstPairtIterator& rhs) {
+      return lhs.pos_ == rhs.pos_;
+    }
+    friend bool operator!=(const ConstPairtIterator& lhs, const ConstPairtIterator& rhs) {
+      return lhs.pos_ != rhs.pos_;
+    }
+
+   private:
+    const Pair* pairs_{nullptr};
+    typename Order::const_iterator pos_{nullptr};
+  };
+
+  FieldMap() = default;
+  FieldMap(const FieldMap&) = default;
+  FieldMap& operator=(const FieldMap&) = default;
+  FieldMap(FieldMap&& other) noexcept
+      : pairs_(std::move(other.pairs_)),
+        order_(std::move(other.order_)),
+        slots_(std::exchange(other.slots_, kNoSlots)),
+        pinned_(std::move(other.pinned_)) {}
+  FieldMap& operator=(FieldMap&& other) noexcept {
+    if (this != &other) {
+      pairs_ = std::move(other.pairs_);
+      order_ = std::move(other.order_);
+      slots_ = std::exchange(other.slots_, kNoSlots);
+      pinned_ = std::move(other.pinned_);
+    }
+    return *this;
+  }
+
   /// @brief Adds the key-value pair to the map.
   /// It appends to any existing values associated with key.
   template <typename K, typename V>
   void Add(K&& key, V&& value) {
-    pairs_.emplace(std::forward<K>(key), std::forward<V>(value));
+    const Pair& added = pairs_.emplace_back(std::forward<K>(key), std::forward<V>(value));
+    OnAdded(UpperBound(added.first.View()), GetField(added.first.View()));
   }
 
   /// @brief Sets the map entries associated with the key to the single element value.
   /// It replaces any existing values associated with key.
   template <typename K, typename V>
   void Set(K&& key, V&& value) {
-    Delete(key);
-    Add(std::forward<K>(key), std::forward<V>(value));
+    auto [begin, end] = EqualRange(std::string_view{key});
+    if (begin == end) {
+      Add(std::forward<K>(key), std::forward<V>(value));
+      return;
+    }
+    // Replaces the first pair in place, the position of it stays the same as the key compares equal.
+    Pair& first = pairs_[order_[begin]];
+    first.first = FieldString(std::forward<K>(key));
+    first.second = FieldString(std::forward<V>(value));
+    Erase(begin + 1, end);
   }
 
   /// @brief  Does same thing as Set method, but only works when key does not exist in the map.
   template <typename K, typename V>
   void SetIfNotPresent(K&& key, V&& value) {
-    if (auto it = pairs_.lower_bound(key); it == pairs_.end() || !CaseInsensitiveEqualTo()(it->first, key)) {
-      pairs_.emplace_hint(it, std::forward<K>(key), std::forward<V>(value));
+    std::string_view key_view{key};
+    if (auto pos = LowerBound(key_view);
+        pos == order_.size() || !CaseInsensitiveEqualTo()(pairs_[order_[pos]].first.View(), key_view)) {
+      int field = GetField(key_view);
+      pairs_.emplace_back(std::forward<K>(key), std::forward<V>(value));
+      OnAdded(pos, field);
     }
   }
 
+  /// @brief Keeps |bytes| alive along with the map, so that the fields added by `AddPinned` can refer to them.
+  /// @note It's expected to be called once for the received head of a message.
+  void Pin(NoncontiguousBuffer&& bytes) {
+    if (pinned_.Empty()) {
+      pinned_ = std::move(bytes);
+    } else {
+      pinned_.Append(std::move(bytes));
+    }
+  }
+
+  /// @brief Adds the key-value pair referring to the bytes pinned by `Pin`, nothing is copied.
+  void AddPinned(std::string_view key, std::string_view value) {
+    pairs_.emplace_back(FieldString::Pinned(key), FieldString::Pinned(value));
+    OnAdded(UpperBound(key), GetField(key));
+  }
+
   /// @brief Gets the first value associated with the given key.
   /// If there are no associated with the key, it returns empty string.
   const std::string& Get(std::string_view key) const {
-    auto found = pairs_.find(key);
-    if (found == pairs_.end()) {
+    const Pair* found = Find(key);
+    if (found == nullptr) {
       static const std::string default_value;
       return default_value;
     }
-    return found->second;
+    return found->second.Str();
+  }
+
+  /// @brief Same as `Get`, but the value is returned without being copied.
+  std::string_view GetView(std::string_view key) const {
+    const Pair* found = Find(key);
+    return found != nullptr ? found->second.View() : std::string_view{};
   }
 
   /// @brief Deletes the values associated with the given key.
-  void Delete(const std::string& key) { pairs_.erase(key); }
+  void Delete(std::string_view key) {
+    auto [begin, end] = EqualRange(key);
+    Erase(begin, end);
+  }
 
   /// @brief Deletes the value associated with the given key when values are equal.
   /// The value is case-sensitive.
@@ -108,13 +400,15 @@ class FieldMap {
   /// @brief Deletes the value associated with the given key when values are equal.
   /// Values are compared by value_equal_to function.
   void Delete(std::string_view key, std::string_view value, const EqualTo& value_equal_to) {
-    auto [begin, end] = pairs_.equal_range(key);
-    for (auto iter = begin; iter != end;) {
-      auto pos = iter++;
-      if (value_equal_to(pos->second, value)) {
-        pairs_.erase(pos);
+    auto [begin, end] = EqualRange(key);
+    // Moves the positions of the pairs kept forward in their order, the rest are erased.
+    std::size_t kept = begin;
+    for (std::size_t pos = begin; pos != end; ++pos) {
+      if (!value_equal_to(pairs_[order_[pos]].second.View(), value)) {
+        std::swap(order_[kept++], order_[pos]);
       }
     }
+    Erase(kept, end);
   }
 
   /// @brief Returns all values associated with the given key. If there are no associated values with the key,
@@ -123,7 +417,7 @@ class FieldMap {
     std::vector<std::string_view> values;
     auto [iter, end] = ValueIterator(key);
     for (; iter != end; iter++) {
-      values.emplace_back(iter->second);
+      values.emplace_back(iter->second.View());
     }
     return values;
   }
@@ -131,8 +425,9 @@ class FieldMap {
   /// @brief Returns all key-value pairs.
   std::vector<std::pair<std::string_view, std::string_view>> Pairs() const {
     std::vector<std::pair<std::string_view, std::string_view>> pairs;
-    for (const auto& [key, value] : pairs_) {
-      pairs.emplace_back(key, value);
+    pairs.reserve(pairs_.size());
+    for (auto pos : order_) {
+      pairs.emplace_back(pairs_[pos].first.View(), pairs_[pos].second.View());
     }
     return pairs;
   }
@@ -140,25 +435,25 @@ class FieldMap {
   /// @brief Calls f sequentially for each key and value present in the map.
   /// If f returns false, range stops the iteration.
   void Range(const std::function<bool(std::string_view key, std::string_view value)>& f) const {
-    for (auto iter = pairs_.cbegin(); iter != pairs_.cend(); iter++) {
-      if (!f(iter->first, iter->second)) {
+    for (auto pos : order_) {
+      if (!f(pairs_[pos].first.View(), pairs_[pos].second.View())) {
         return;
       }
     }
   }
 
   /// @brief Reports whether map contains the key.
-  bool Has(std::string_view key) const { return pairs_.find(key) != pairs_.end(); }
+  bool Has(std::string_view key) const { return Find(key) != nullptr; }
 
   /// @brief Returns a string for all key-value pairs.
   /// Format: *("Key: Value\r\n")
   std::string ToString() const {
     std::string content;
     content.reserve(ByteSizeLong());
-    for (const auto& [key, value] : pairs_) {
-      content.append(key);
+    for (auto pos : order_) {
+      content.append(pairs_[pos].first.View());
       content.append(kSeparator);
-      content.append(value);
+      content.append(pairs_[pos].second.View());
       content.append(kDelimiter);
     }
     return content;
@@ -167,8 +462,8 @@ class FieldMap {
   /// @brief Writes key-value pairs to string.
   template <typename T>
   void WriteToStringStream(T& stream, std::string_view delimiter = kDelimiter) const {
-    for (const auto& [key, value] : pairs_) {
-      stream << key << kSeparator << value << delimiter;
+    for (auto pos : order_) {
+      stream << pairs_[pos].first.View() << kSeparator << pairs_[pos].second.View() << delimiter;
     }
   }
 
@@ -177,7 +472,7 @@ class FieldMap {
     std::size_t byte_size{0};
     for (const auto& [key, value] : pairs_) {
       // Appends: Separator + Delimiter
-      byte_size += key.size() + value.size() + kSeparator.size() + kDelimiter.size();
+      byte_size += key.View().size() + value.View().size() + kSeparator.size() + kDelimiter.size();
     }
     return byte_size;
   }
@@ -186,12 +481,18 @@ class FieldMap {
   std::size_t FlatPairsCount() const { return pairs_.size(); }
 
   /// @brief Clears the map.
-  void Clear() { pairs_.clear(); }
+  void Clear() {
+    pairs_.clear();
+    order_.clear();
+    slots_ = kNoSlots;
+    pinned_.Clear();
+  }
 
   /// @brief Returns key-value pairs iterator of specific key.
-  using ConstPairtIterator = typename std::multimap<std::string, std::string, Compare>::const_iterator;
   std::pair<ConstPairtIterator, ConstPairtIterator> ValueIterator(std::string_view key) const {
-    return pairs_.equal_range(key);
+    auto [begin, end] = EqualRange(key);
+    return {ConstPairtIterator(pairs_.data(), order_.begin() + begin),
+            ConstPairtIterator(pairs_.data(), order_.begin() + end)};
   }
 
   /// @brief Reports whether key-value pairs is empty.
@@ -200,11 +501,128 @@ class FieldMap {
   /// @brief Returns size of key-values pairs.
   std::size_t Size() const { return pairs_.size(); }
 
+ private:
+  using Slots = std::array<std::uint32_t, kWellKnownFieldNum>;
+
+  // Only the case-insensitive map (HTTP header) keeps track of the well-known fields.
+  static constexpr bool kIndexed = std::is_same_v<Compare, CaseInsensitiveLess>;
+
+  static constexpr std::uint32_t kNoSlot = UINT32_MAX;
+
+  static constexpr Slots kNoSlots = [] {
+    Slots slots{};
+    for (std::size_t i = 0; i != slots.size(); ++i) {
+      slots[i] = kNoSlot;
+    }
+    return slots;
+  }();
+
+  static int GetField(std::string_view key) {
+    if constexpr (kIndexed) {
+      return GetWellKnownField(key);
+    }
+    return -1;
+  }
+
+  // Returns the first position in `order_` whose key is not less than |key|.
+  std::size_t LowerBound(std::string_view key, std::size_t begin = 0) const {
+    return std::lower_bound(order_.begin() + begin, order_.end(), key,
+                            [this](std::uint32_t pos, std::string_view key) {
+                              return Compare()(pairs_[pos].first.View(), key);
+                            }) -
+           order_.begin();
+  }
+
+  // Returns the first position in `order_` whose key is greater than |key|.
+  std::size_t UpperBound(std::string_view key, std::size_t begin = 0) const {
+    return std::upper_bound(order_.begin() + begin, order_.end(), key,
+                            [this](std::string_view key, std::uint32_t pos) {
+                              return Compare()(key, pairs_[pos].first.View());
+                            }) -
+           order_.begin();
+  }
+
+  const Pair* Find(std::string_view key) const {
+    if (int field = GetField(key); field >= 0) {
+      return slots_[field] != kNoSlot ? &pairs_[slots_[field]] : nullptr;
+    }
+    auto pos = LowerBound(key);
+    return pos != order_.size() && !Compare()(key, pairs_[order_[pos]].first.View()) ? &pairs_[order_[pos]] : nullptr;
+  }
+
+  // Returns the range of positions in `order_` of |key|.
+  std::pair<std::size_t, std::size_t> EqualRange(std::string_view key) const {
+    if (int field = GetField(key); field >= 0 && slots_[field] == kNoSlot) {
+      return {order_.size(), order_.size()};
+    }
+    auto begin = LowerBound(key);
+    return {begin, UpperBound(key, begin)};
+  }
+
+  // The last pair of `pairs_` was just added, puts it at |pos| in `order_`.
+  void OnAdded(std::size_t pos, int field) {
+    auto added = static_cast<std::uint32_t>(pairs_.size() - 1);
+    order_.insert(order_.begin() + pos, added);
+    // A pair is ordered after the pairs of the same key, the slot is set only if it's the first of its key.
+    if (field >= 0 && slots_[field] == kNoSlot) {
+      slots_[field] = added;
+    }
+  }
+
+  // Erases the pairs at positions [first, last) in `order_`.
+  void Erase(std::size_t first, std::size_t last) {
+    if (first == last) {
+      return;
+    }
+    // Pairs are erased from the back, so that the ones yet to be erased are not moved.
+    std::sort(order_.begin() + first, order_.begin() + last, std::greater<>());
+    // Bit `field` is set if the first pair of the well-known field is erased.
+    std::uint32_t lost_slots = 0;
+    for (std::size_t i = first; i != last; ++i) {
+      std::uint32_t erased = order_[i];
+      pairs_.erase(pairs_.begin() + erased);
+      for (std::size_t pos = 0; pos != order_.size(); ++pos) {
+        if ((pos < first || pos >= last) && order_[pos] > erased) {
+          --order_[pos];
+        }
+      }
+      for (int field = 0; field != kWellKnownFieldNum; ++field) {
+        auto& slot = slots_[field];
+        if (slot == erased) {
+          slot = kNoSlot;
+          lost_slots |= 1u << field;
+        } else if (slot != kNoSlot && slot > erased) {
+          --slot;
+        }
+      }
+    }
+    order_.erase(order_.begin() + first, order_.begin() + last);
+
+    // The remaining pairs (if any) of the well-known fields which lost their first pair are searched.
+    for (int field = 0; lost_slots != 0; ++field, lost_slots >>= 1) {
+      if (lost_slots & 1) {
+        std::string_view name = kWellKnownFieldNames[field];
+        if (auto pos = LowerBound(name);
+            pos != order_.size() && CaseInsensitiveEqualTo()(pairs_[order_[pos]].first.View(), name)) {
+          slots_[field] = order_[pos];
+        }
+      }
+    }
+  }
+
  private:
   static constexpr std::string_view kSeparator{": "};
   static constexpr std::string_view kDelimiter{"\r\n"};
 
-  std::multimap<std::string, std::string, Compare> pairs_;
+  PairVector pairs_;
+
+  Order order_;
+
+  // Indexed by `WellKnownField`, position in `pairs_` of the first pair of each well-known field.
+  Slots slots_{kNoSlots};
+
+  // Received bytes which the pinned fields refer to.
+  NoncontiguousBuffer pinned_;
 };
 
 }  // namespace detail
@@ -13,12 +13,17 @@
 
 #include "trpc/util/http/field_map.h"
 
+#include <strings.h>
+
+#include <algorithm>
 #include <sstream>
 #include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
 
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
 namespace trpc::http::testing {
 
 class FieldMapTest : public ::testing::Test {
@@ -225,4 +230,113 @@ TEST_F(FieldMapTest, SetIfNotPresentOk) {
   EXPECT_EQ("user-defined-value01", header_.Get("user-defined-key01"));
 }
 
+TEST(FieldMapPinnedTest, AddPinnedOk) {
+  std::string head = "Content-Type: text/html\r\nX-Pinned: pinned-value\r\n";
+  NoncontiguousBuffer bytes = CreateBufferSlow(head);
+  std::string_view received{bytes.FirstContiguous().data(), bytes.FirstContiguous().size()};
+
+  http::detail::FieldMap<http::detail::CaseInsensitiveLess> header;
+  header.Pin(std::move(bytes));
+  header.AddPinned(received.substr(0, 12), received.substr(14, 9));
+  header.AddPinned(received.substr(25, 8), received.substr(35, 12));
+  header.Add("X-Owned", "owned-value");
+
+  // Values are viewed in place, and copied only when got as std::string.
+  ASSERT_EQ(received.data() + 35, header.GetView("x-pinned").data());
+  ASSERT_EQ("pinned-value", header.Get("X-Pinned"));
+  ASSERT_NE(received.data() + 35, header.Get("X-Pinned").data());
+  ASSERT_EQ("text/html", header.GetView("Content-Type"));
+  ASSERT_EQ("owned-value", header.GetView("X-Owned"));
+  ASSERT_EQ("", header.GetView("Not-Exists"));
+  ASSERT_EQ(3, header.Size());
+
+  // Copies share the pinned bytes.
+  auto copied = header;
+  header.Clear();
+  ASSERT_TRUE(header.Empty());
+  ASSERT_EQ("text/html", copied.Get("content-type"));
+  ASSERT_EQ("pinned-value", copied.GetView("X-Pinned"));
+
+  copied.Delete("X-Pinned");
+  ASSERT_FALSE(copied.Has("X-Pinned"));
+}
+
+TEST(CaseInsensitiveCompareTest, SameAsStrncasecmp) {
+  auto sign = [](int v) { return (v > 0) - (v < 0); };
+  std::vector<std::string> strs = {"",
+                                   "a",
+                                   "A",
+                                   "@[`{",
+                                   "Content-Length",
+                                   "content-length",
+                                   "CONTENT-LENGTH",
+                                   "content-lengtH",
+                                   "content-lengti",
+                                   "Content-Lengt",
+                                   "Transfer-Encoding",
+                                   "transfer-encodinG",
+                                   "transfer-encoding\xc3\x80",
+                                   "transfer-encoding\xc3\xa0"};
+  for (const auto& lhs : strs) {
+    for (const auto& rhs : strs) {
+      // Both strings are terminated by '\0', which makes `strncasecmp` take a prefix as the lesser.
+      int expected = sign(strncasecmp(lhs.c_str(), rhs.c_str(), std::max(lhs.size(), rhs.size())));
+      ASSERT_EQ(expected, sign(http::detail::CaseInsensitiveCompare(lhs, rhs))) << lhs << " vs " << rhs;
+      ASSERT_EQ(expected == 0, http::detail::CaseInsensitiveEqualTo()(lhs, rhs));
+    }
+  }
+}
+
+TEST(FieldMapWellKnownTest, SlotsFollowModification) {
+  http::detail::FieldMap<http::detail::CaseInsensitiveLess> header;
+  // Exceeds the inline storage, and the well-known fields are added after many other fields which are erased later.
+  for (int i = 0; i != 20; ++i) {
+    header.Add("X-Key-" + std::to_string(i), std::to_string(i));
+    header.Add("ab", std::to_string(i));
+  }
+  header.Add("content-length", "10");
+  header.Add("Content-Length", "20");
+  header.Add("Host", "example.com");
+  header.Add("z", "z");
+  header.SetIfNotPresent("CONNECTION", "close");
+  header.SetIfNotPresent("Connection", "keep-alive");
+
+  ASSERT_EQ(45, header.Size());
+  ASSERT_EQ("10", header.Get("CONTENT-LENGTH"));
+  ASSERT_EQ((std::vector<std::string_view>{"10", "20"}), header.Values("Content-Length"));
+  ASSERT_EQ("example.com", header.GetView("host"));
+  ASSERT_EQ("close", header.GetView("Connection"));
+  ASSERT_FALSE(header.Has("Content-Type"));
+
+  // Deletes the first value of a well-known field, the next one takes its place.
+  header.Delete("Content-Length", "10");
+  ASSERT_EQ("20", header.Get("content-length"));
+  header.Delete("ab");
+  ASSERT_EQ(24, header.Size());
+  ASSERT_EQ("20", header.Get("content-length"));
+  ASSERT_EQ("example.com", header.GetView("Host"));
+
+  header.Add("Content-Type", "text/plain");
+  header.Set("Content-Length", "30");
+  header.Set("host", "example.org");
+  ASSERT_EQ("30", header.Get("Content-Length"));
+  ASSERT_EQ("example.org", header.Get("Host"));
+  ASSERT_EQ("text/plain", header.Get("Content-Type"));
+  ASSERT_NE(std::string::npos, header.ToString().find("\r\nhost: example.org\r\n"));
+
+  header.Delete("Host");
+  ASSERT_FALSE(header.Has("Host"));
+  ASSERT_EQ("30", header.Get("Content-Length"));
+
+  // The moved-from map is left empty and usable.
+  auto moved = std::move(header);
+  ASSERT_EQ("30", moved.Get("Content-Length"));
+  ASSERT_FALSE(header.Has("Content-Length"));
+  header.Add("Content-Length", "40");
+  ASSERT_EQ("40", header.Get("Content-Length"));
+
+  moved.Clear();
+  ASSERT_FALSE(moved.Has("Connection"));
+}
+
 }  // namespace trpc::http::testing
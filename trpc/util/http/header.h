@@ -151,6 +151,9 @@ class Header {
   /// If there are no associated with the key, it returns empty string.
   const std::string& GetHeader(std::string_view key) const { return headers_.Get(key); }
 
+  /// @brief Same as `GetHeader`, but the value is returned without being copied.
+  std::string_view GetHeaderView(std::string_view key) const { return headers_.GetView(key); }
+
   /// @brief Returns all header values associated with the given key. If there are no associated values with the key,
   /// it returns emtpy list.
   std::vector<std::string_view> GetHeaderValues(std::string_view key) const { return headers_.Values(key); }
@@ -13,6 +13,10 @@
 
 #include "trpc/util/http/http_parser.h"
 
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
 #include "picohttpparser.h"
 
 namespace trpc::http {
@@ -20,6 +24,81 @@ namespace trpc::http {
 namespace {
 constexpr int kLessBuffer = -2;
 constexpr int kErrBuffer = -1;
+
+// Returns the length of the head ended by "\r\n\r\n" at the front of |in|, the marker may span blocks.
+// It returns 0 if the marker is not found in the first |max_bytes| bytes or so.
+size_t FindHeadSize(const NoncontiguousBuffer& in, size_t max_bytes) {
+  constexpr std::string_view kMarker{http::kEndOfHeaderMarker};
+  constexpr size_t kTailSize = kMarker.size() - 1;
+
+  // The last bytes of the blocks walked through, for the marker spanning blocks.
+  char tail[kTailSize];
+  size_t tail_size = 0;
+  size_t offset = 0;
+  for (auto iter = in.begin(); iter != in.end() && offset <= max_bytes; ++iter) {
+    std::string_view block{iter->data(), iter->size()};
+    char window[kTailSize * 2];
+    size_t head_bytes = std::min(kTailSize, block.size());
+    memcpy(window, tail, tail_size);
+    memcpy(window + tail_size, block.data(), head_bytes);
+    if (auto pos = std::string_view(window, tail_size + head_bytes).find(kMarker); pos != std::string_view::npos) {
+      return offset - tail_size + pos + kMarker.size();
+    }
+    if (auto pos = block.find(kMarker); pos != std::string_view::npos) {
+      return offset + pos + kMarker.size();
+    }
+
+    size_t window_size = tail_size + head_bytes;
+    if (block.size() > kTailSize) {
+      memcpy(tail, block.data() + block.size() - kTailSize, kTailSize);
+      tail_size = kTailSize;
+    } else {
+      tail_size = std::min(kTailSize, window_size);
+      memcpy(tail, window + window_size - tail_size, tail_size);
+    }
+    offset += block.size();
+  }
+  return 0;
+}
+
+// Runs |parse| (a picohttpparser function bound to its outputs) over the head at the front of |in|, and cuts the
+// parsed head from |in| into |head|, which the outputs of |parse| point to.
+template <typename F>
+int ParseHeadInPlace(NoncontiguousBuffer& in, size_t max_head_size, size_t min_bytes, F&& parse,
+                     NoncontiguousBuffer* head) {
+  if (in.ByteSize() < min_bytes) {
+    return kLessBuffer;
+  }
+
+  // Fast path: the head lies in the first block, which is parsed in place and shared with |head|.
+  BufferView first = in.FirstContiguous();
+  int nparse = parse(first.data(), std::min(first.size(), max_head_size));
+  if (nparse > 0) {
+    *head = in.Cut(nparse);
+    return nparse;
+  } else if (nparse == kErrBuffer || first.size() >= max_head_size) {
+    return kErrBuffer;
+  } else if (in.size() == 1) {
+    return kLessBuffer;
+  }
+
+  // Slow path: the head spans blocks, only the head is copied.
+  size_t head_size = FindHeadSize(in, max_head_size);
+  if (head_size == 0 || head_size > max_head_size) {
+    return in.ByteSize() > max_head_size ? kErrBuffer : kLessBuffer;
+  }
+  char* copied = new char[head_size];
+  FlattenToSlow(in, copied, head_size);
+  head->Clear();
+  head->Append(copied, head_size);
+  nparse = parse(copied, head_size);
+  if (nparse > 0) {
+    in.Skip(nparse);
+    return nparse;
+  }
+  return nparse == kErrBuffer ? kErrBuffer : kLessBuffer;
+}
+
 }  // namespace
 
 bool HeaderEqual(const phr_header& header, const char* check_name, size_t check_len) {
@@ -146,6 +225,74 @@ int ParseHead(const char* buf, size_t size, HttpRequest* out) {
 
 int ParseHead(const std::string& buf, HttpRequest* out) { return ParseHead(buf.c_str(), buf.size(), out); }
 
+int ParseHead(NoncontiguousBuffer& in, size_t max_head_size, HttpResponse* out) {
+  int minor_version{0};
+  int status{200};
+  const char* msg{nullptr};
+  size_t msg_len{0};
+  struct phr_header headers[http::kMaxHeaderNum];
+  size_t num_headers{0};
+
+  NoncontiguousBuffer head;
+  int nparse = ParseHeadInPlace(
+      in, max_head_size, http::kMinResponseBytes,
+      [&](const char* buf, size_t size) {
+        num_headers = http::kMaxHeaderNum;
+        return phr_parse_response(buf, size, &minor_version, &status, &msg, &msg_len, headers, &num_headers, 0);
+      },
+      &head);
+  if (nparse < 0) {
+    return nparse;
+  }
+
+  HeaderPairs* pairs = out->GetMutableHeader();
+  pairs->Pin(std::move(head));
+  for (size_t i = 0; i < num_headers; ++i) {
+    pairs->AddPinned(std::string_view{headers[i].name, headers[i].name_len},
+                     std::string_view{headers[i].value, headers[i].value_len});
+  }
+
+  out->SetVersion(minor_version == 0 ? http::kVersion10 : http::kVersion11);
+  out->SetStatus(http::HttpResponse::StatusCode(status));
+  out->SetReasonPhrase(std::string{msg, msg_len});
+  return nparse;
+}
+
+int ParseHead(NoncontiguousBuffer& in, size_t max_head_size, HttpRequest* out) {
+  const char* method{nullptr};
+  size_t method_len{0};
+  const char* path{nullptr};
+  size_t path_len{0};
+  int minor_version{0};
+  struct phr_header headers[http::kMaxHeaderNum];
+  size_t num_headers{0};
+
+  NoncontiguousBuffer head;
+  int nparse = ParseHeadInPlace(
+      in, max_head_size, http::kMinRequestBytes,
+      [&](const char* buf, size_t size) {
+        num_headers = http::kMaxHeaderNum;
+        return phr_parse_request(buf, size, &method, &method_len, &path, &path_len, &minor_version, headers,
+                                 &num_headers, 0);
+      },
+      &head);
+  if (nparse < 0) {
+    return nparse;
+  }
+
+  HeaderPairs* pairs = out->GetMutableHeader();
+  pairs->Pin(std::move(head));
+  for (size_t i = 0; i < num_headers; ++i) {
+    pairs->AddPinned(std::string_view{headers[i].name, headers[i].name_len},
+                     std::string_view{headers[i].value, headers[i].value_len});
+  }
+
+  out->SetMethodType(StringToType(std::string_view{method, method_len}));
+  out->SetUrl(std::string{path, path_len});
+  out->SetVersion(minor_version == 0 ? http::kVersion10 : http::kVersion11);
+  return nparse;
+}
+
 int Parse(const char* buf, size_t size, trpc::http::HttpResponse* out) {
   int idx_already_parse{0};
   HttpResponse rsp;
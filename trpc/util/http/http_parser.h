@@ -17,6 +17,7 @@
 #include <deque>
 #include <utility>
 
+#include "trpc/util/buffer/noncontiguous_buffer.h"
 #include "trpc/util/http/response.h"
 #include "trpc/util/http/request.h"
 
@@ -48,6 +49,25 @@ int ParseHead(const std::string& buf, trpc::http::HttpResponse* out);
 int ParseHead(const char* buf, size_t size, trpc::http::HttpRequest* out);
 int ParseHead(const std::string& buf, trpc::http::HttpRequest* out);
 
+/// @brief Parses the response line and header from the front of the received bytes without copying them, and store
+/// them in a single HttpResponse object.
+/// The parser runs over the first block of |in| in place, the head is copied only if it spans blocks. The head is cut
+/// from |in| and pinned by |out|, the header fields of |out| refer to it rather than owning a copy. Unlike the overloads
+/// above, header fields are kept as received, no Content-Length is added.
+/// @param in The received bytes. The head is removed from it unless the head is incomplete.
+/// @param max_head_size The maximum length of the head, a longer head is an error.
+/// @param out The parsed HttpResponse object.
+/// @return The return value represents the parsing result of in.
+/// -1: Error
+/// -2: Incomplete head
+/// >0: The number of characters successfully parsed (response line + response header + blank line)
+int ParseHead(NoncontiguousBuffer& in, size_t max_head_size, trpc::http::HttpResponse* out);
+
+/// @brief Parses the request line and header from the front of the received bytes without copying them, and store
+/// them in a single HttpRequest object.
+/// Same as the HttpResponse one above.
+int ParseHead(NoncontiguousBuffer& in, size_t max_head_size, trpc::http::HttpRequest* out);
+
 /// @brief Parses one or more HttpResponse objects from buf.
 /// @param buf The HTTP response message.
 /// @param size The length of buf.
@@ -13,6 +13,9 @@
 
 #include "trpc/util/http/http_parser.h"
 
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 namespace trpc {
@@ -436,6 +439,118 @@ TEST_F(HttpParserTest, MutiNotFullChunkedRequest) {
   EXPECT_EQ(req.GetHeader("Content-Length"), "10");
 }
 
+namespace {
+
+// Splits |s| into blocks at |positions|.
+NoncontiguousBuffer MakeBuffer(const std::string& s, std::vector<size_t> positions) {
+  NoncontiguousBuffer buffer;
+  size_t begin = 0;
+  positions.push_back(s.size());
+  for (size_t end : positions) {
+    buffer.Append(CreateBufferSlow(s.substr(begin, end - begin)));
+    begin = end;
+  }
+  return buffer;
+}
+
+// Reports whether |view| refers to the bytes of the first block of |buffer|.
+bool InFirstBlock(std::string_view view, const char* first_block, size_t size) {
+  return view.data() >= first_block && view.data() + view.size() <= first_block + size;
+}
+
+}  // namespace
+
+TEST_F(HttpParserTest, ParseRequestHeadInFirstBlock) {
+  std::string s = "POST /form.html HTTP/1.1\r\nContent-Length: 5\r\nContent-Type: text/html\r\n\r\nhello";
+  NoncontiguousBuffer in = MakeBuffer(s, {s.size() - 2});
+  const char* first_block = in.FirstContiguous().data();
+
+  http::HttpRequest req;
+  int ret = http::ParseHead(in, s.size(), &req);
+
+  ASSERT_EQ(ret, s.size() - 5);
+  ASSERT_EQ(FlattenSlow(in), "hello");
+  EXPECT_EQ(req.GetMethodType(), http::OperationType::POST);
+  EXPECT_EQ(req.GetUrl(), "/form.html");
+  EXPECT_EQ(req.GetVersion(), http::kVersion11);
+  EXPECT_EQ(req.GetHeader("Content-Length"), "5");
+  EXPECT_EQ(req.GetHeaderView("content-type"), "text/html");
+  // Nothing is copied, header fields refer to the received bytes.
+  EXPECT_TRUE(InFirstBlock(req.GetHeaderView("Content-Type"), first_block, s.size()));
+  EXPECT_EQ(req.GetHeader().FlatPairsCount(), 2);
+
+  // Header fields outlive the received bytes.
+  in.Clear();
+  http::HttpRequest copied = req;
+  req = http::HttpRequest{};
+  EXPECT_EQ(copied.GetHeaderView("Content-Type"), "text/html");
+}
+
+TEST_F(HttpParserTest, ParseRequestHeadSpanningBlocks) {
+  std::string head = "GET /index.html HTTP/1.0\r\nHost: www.example.com\r\nUser-Agent: trpc\r\n\r\n";
+  std::string s = head + "GET /";
+  // Both in the middle of a header field and in the middle of the end of the head.
+  for (size_t pos : {size_t{30}, head.size() - 3, head.size() - 1}) {
+    NoncontiguousBuffer in = MakeBuffer(s, {pos});
+
+    http::HttpRequest req;
+    int ret = http::ParseHead(in, s.size(), &req);
+
+    ASSERT_EQ(ret, head.size());
+    ASSERT_EQ(FlattenSlow(in), "GET /");
+    EXPECT_EQ(req.GetMethodType(), http::OperationType::GET);
+    EXPECT_EQ(req.GetUrl(), "/index.html");
+    EXPECT_EQ(req.GetVersion(), http::kVersion10);
+    EXPECT_EQ(req.GetHeader("Host"), "www.example.com");
+    EXPECT_EQ(req.GetHeaderView("User-Agent"), "trpc");
+  }
+}
+
+TEST_F(HttpParserTest, ParseRequestHeadIncompleteOrError) {
+  std::string s = "POST /form.html HTTP/1.1\r\nContent-Length: 5\r\n\r";
+  http::HttpRequest req;
+
+  NoncontiguousBuffer in = MakeBuffer(s, {});
+  ASSERT_EQ(http::ParseHead(in, 1024, &req), -2);
+  ASSERT_EQ(in.ByteSize(), s.size());
+
+  in = MakeBuffer(s, {20, 40});
+  ASSERT_EQ(http::ParseHead(in, 1024, &req), -2);
+  ASSERT_EQ(in.ByteSize(), s.size());
+
+  // Head too large.
+  in = MakeBuffer(s + "\n", {20, 40});
+  ASSERT_EQ(http::ParseHead(in, 30, &req), -1);
+  in = MakeBuffer(s, {});
+  ASSERT_EQ(http::ParseHead(in, 30, &req), -1);
+
+  // Bad message.
+  s = "POST /form.html HTTP/1.1\rContent-Length: 5\r\n\r\n";
+  in = MakeBuffer(s, {});
+  ASSERT_EQ(http::ParseHead(in, 1024, &req), -1);
+  in = MakeBuffer(s, {30});
+  ASSERT_EQ(http::ParseHead(in, 1024, &req), -1);
+}
+
+TEST_F(HttpParserTest, ParseResponseHead) {
+  std::string head = "HTTP/1.1 404 Not Found\r\nContent-Length: 6\r\nConnection: close\r\n\r\n";
+  std::string s = head + "123456";
+  for (auto positions : {std::vector<size_t>{}, std::vector<size_t>{10}}) {
+    NoncontiguousBuffer in = MakeBuffer(s, positions);
+
+    http::HttpResponse rsp;
+    int ret = http::ParseHead(in, s.size(), &rsp);
+
+    ASSERT_EQ(ret, head.size());
+    ASSERT_EQ(FlattenSlow(in), "123456");
+    EXPECT_EQ(rsp.GetVersion(), "1.1");
+    EXPECT_EQ(rsp.GetStatus(), http::HttpResponse::StatusCode::kNotFound);
+    EXPECT_EQ(rsp.GetReasonPhrase(), "Not Found");
+    EXPECT_EQ(rsp.GetHeader("Content-Length"), "6");
+    EXPECT_EQ(rsp.GetHeaderView("Connection"), "close");
+  }
+}
+
 }  // namespace testing
 
 }  // namespace trpc
@@ -34,7 +34,8 @@ namespace trpc::http {
 /// sign ("#") character or by the end of the URI.
 ///
 /// RFC : https://www.rfc-editor.org/rfc/rfc3986#section-3.4
-using QueryParameters = detail::FieldMap<detail::CaseSensitiveLess>;
+/// @note A query string usually carries fewer pairs than a header, so fewer of them are stored inline.
+using QueryParameters = detail::FieldMap<detail::CaseSensitiveLess, 8>;
 
 // The following source codes are from seastar.
 // Copied and modified from
@@ -0,0 +1,271 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/util/http/radix_router.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace trpc::http {
+
+namespace {
+
+constexpr std::string_view kPlaceholderBegin = "<ph(";
+constexpr std::string_view kPlaceholderEnd = ")>";
+constexpr std::string_view kRegexBegin = "<regex";
+constexpr std::string_view kRegexMetaChars = ".^$|()[]{}*+?\\";
+
+bool StartsWith(std::string_view s, std::string_view prefix) { return s.substr(0, prefix.size()) == prefix; }
+
+bool EndsWith(std::string_view s, std::string_view suffix) {
+  return s.size() >= suffix.size() && s.substr(s.size() - suffix.size()) == suffix;
+}
+
+bool IsWordChar(char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; }
+
+// A compiled rule: literals and placeholders in order, the placeholders have the names in `names`.
+struct Pattern {
+  struct Token {
+    std::string literal;
+    bool is_param{false};
+  };
+  std::vector<Token> tokens;
+  std::vector<std::string> names;
+};
+
+// Parses the template of "<ph(...)>", each placeholder must occupy a whole path segment and the literal parts must
+// have no regular expression meta character, otherwise it's not equivalent to the regular expression evaluated by
+// `PlaceholderMatcher`.
+bool ParsePlaceholderTemplate(std::string_view tmpl, Pattern* pattern) {
+  std::string literal;
+  std::size_t i = 0;
+  while (i < tmpl.size()) {
+    char c = tmpl[i];
+    if (c == '<') {
+      std::size_t end = i + 1;
+      while (end < tmpl.size() && IsWordChar(tmpl[end])) ++end;
+      if (end > i + 1 && end < tmpl.size() && tmpl[end] == '>') {
+        bool segment_begin = !literal.empty() && literal.back() == '/';
+        bool segment_end = end + 1 == tmpl.size() || tmpl[end + 1] == '/';
+        if (!segment_begin || !segment_end) {
+          return false;
+        }
+        pattern->tokens.push_back({std::move(literal), false});
+        pattern->tokens.push_back({std::string{}, true});
+        pattern->names.emplace_back(tmpl.substr(i + 1, end - i - 1));
+        literal.clear();
+        i = end + 1;
+        continue;
+      }
+    }
+    if (kRegexMetaChars.find(c) != std::string_view::npos) {
+      return false;
+    }
+    literal.push_back(c);
+    ++i;
+  }
+  pattern->tokens.push_back({std::move(literal), false});
+  return true;
+}
+
+}  // namespace
+
+struct RadixRouter::Leaf {
+  std::shared_ptr<HandlerBase> handler;
+  uint64_t seq;
+  // Names of the placeholders on the way from root, followed by the name of remainder parameter for `kPrefix`.
+  std::vector<std::string> names;
+};
+
+struct RadixRouter::Node {
+  // Label of the edge from parent, empty for root and placeholder nodes.
+  std::string prefix;
+  // Children labeled by literals, first characters of their labels are distinct.
+  std::vector<std::unique_ptr<Node>> children;
+  // Child matching a non-empty path segment.
+  std::unique_ptr<Node> param_child;
+  std::unique_ptr<Leaf> leaves[kLeafKindNum];
+
+  // Walks down along `literal`, splits edges and creates nodes if necessary.
+  Node* Insert(std::string_view literal) {
+    Node* node = this;
+    while (!literal.empty()) {
+      auto it = std::find_if(node->children.begin(), node->children.end(),
+                             [&](const auto& child) { return child->prefix[0] == literal[0]; });
+      if (it == node->children.end()) {
+        auto child = std::make_unique<Node>();
+        child->prefix = std::string{literal};
+        node->children.push_back(std::move(child));
+        return node->children.back().get();
+      }
+
+      Node* child = it->get();
+      auto mismatch = std::mismatch(child->prefix.begin(), child->prefix.end(), literal.begin(), literal.end());
+      std::size_t common = mismatch.first - child->prefix.begin();
+      if (common < child->prefix.size()) {
+        auto middle = std::make_unique<Node>();
+        middle->prefix = child->prefix.substr(0, common);
+        child->prefix.erase(0, common);
+        middle->children.push_back(std::move(*it));
+        *it = std::move(middle);
+        child = it->get();
+      }
+      node = child;
+      literal.remove_prefix(common);
+    }
+    return node;
+  }
+};
+
+RadixRouter::RadixRouter() : root_(std::make_unique<Node>()) {}
+
+RadixRouter::~RadixRouter() = default;
+
+void RadixRouter::Add(const Path& path, std::shared_ptr<HandlerBase> handler) {
+  uint64_t seq = next_seq_++;
+  if (Compile(path, handler, seq)) {
+    return;
+  }
+  auto rule = std::make_shared<MatchRule>(std::move(handler));
+  rule->AddString(path.GetPath());
+  if (!path.GetParam().empty()) {
+    rule->AddParam(path.GetParam(), true);
+  }
+  fallback_rules_.emplace_back(seq, std::move(rule));
+}
+
+void RadixRouter::Add(std::shared_ptr<MatchRule> rule) { fallback_rules_.emplace_back(next_seq_++, std::move(rule)); }
+
+bool RadixRouter::Compile(const Path& path, const std::shared_ptr<HandlerBase>& handler, uint64_t seq) {
+  std::string_view str = path.GetPath();
+  Pattern pattern;
+  LeafKind kind = kLoose;
+  if (StartsWith(str, kPlaceholderBegin) && EndsWith(str, kPlaceholderEnd)) {
+    std::string_view tmpl =
+        str.substr(kPlaceholderBegin.size(), str.size() - kPlaceholderBegin.size() - kPlaceholderEnd.size());
+    // Remainder parameter of a placeholder rule can only be empty, leave such rare rules to `MatchRule`.
+    if (!path.GetParam().empty() || !ParsePlaceholderTemplate(tmpl, &pattern)) {
+      return false;
+    }
+    kind = kStrict;
+  } else if (StartsWith(str, kRegexBegin) && EndsWith(str, ">")) {
+    return false;
+  } else {
+    pattern.tokens.push_back({std::string{str}, false});
+    if (!path.GetParam().empty()) {
+      pattern.names.push_back(path.GetParam());
+      kind = kPrefix;
+    }
+  }
+
+  if (pattern.names.size() > kMaxParams) {
+    return false;
+  }
+
+  Node* node = root_.get();
+  for (const auto& token : pattern.tokens) {
+    if (token.is_param) {
+      if (!node->param_child) {
+        node->param_child = std::make_unique<Node>();
+      }
+      node = node->param_child.get();
+    } else {
+      node = node->Insert(token.literal);
+    }
+  }
+
+  // A later rule taking the same place as an earlier one is never matched, just like in the insertion order.
+  if (!node->leaves[kind]) {
+    node->leaves[kind] = std::make_unique<Leaf>(Leaf{handler, seq, std::move(pattern.names)});
+  }
+  return true;
+}
+
+bool RadixRouter::Find(std::string_view path, Match* match) const {
+  std::string_view captures[kMaxParams];
+  Search(root_.get(), path, 0, captures, 0, match);
+  return match->handler != nullptr;
+}
+
+void RadixRouter::Search(const Node* node, std::string_view path, std::size_t pos, std::string_view* captures,
+                         std::size_t captures_count, Match* match) const {
+  std::string_view rest = path.substr(pos);
+  if (rest.empty()) {
+    Accept(node->leaves[kStrict].get(), captures, captures_count, rest, match);
+    Accept(node->leaves[kLoose].get(), captures, captures_count, rest, match);
+    Accept(node->leaves[kPrefix].get(), captures, captures_count, rest, match);
+    return;
+  }
+
+  if (rest[0] == '/') {
+    if (rest.size() == 1) {
+      Accept(node->leaves[kLoose].get(), captures, captures_count, rest, match);
+    }
+    Accept(node->leaves[kPrefix].get(), captures, captures_count, rest, match);
+  }
+
+  for (const auto& child : node->children) {
+    if (child->prefix[0] == rest[0]) {
+      if (StartsWith(rest, child->prefix)) {
+        Search(child.get(), path, pos + child->prefix.size(), captures, captures_count, match);
+      }
+      break;
+    }
+  }
+
+  if (node->param_child && rest[0] != '/') {
+    std::size_t len = std::min(rest.find('/'), rest.size());
+    captures[captures_count] = rest.substr(0, len);
+    Search(node->param_child.get(), path, pos + len, captures, captures_count + 1, match);
+  }
+}
+
+void RadixRouter::Accept(const Leaf* leaf, std::string_view* captures, std::size_t captures_count,
+                         std::string_view remainder, Match* match) {
+  if (leaf == nullptr || leaf->seq >= match->seq) {
+    return;
+  }
+  match->handler = leaf->handler.get();
+  match->seq = leaf->seq;
+  match->params_count = leaf->names.size();
+  for (std::size_t i = 0; i < captures_count; ++i) {
+    match->params[i] = {leaf->names[i], captures[i]};
+  }
+  if (match->params_count > captures_count) {
+    match->params[captures_count] = {leaf->names[captures_count], remainder};
+  }
+}
+
+HandlerBase* RadixRouter::Get(const std::string& path, Parameters& params) const {
+  Match match;
+  Find(path, &match);
+
+  // Rules evaluated by `MatchRule` only take precedence if they are added earlier.
+  for (const auto& [seq, rule] : fallback_rules_) {
+    if (seq > match.seq) {
+      break;
+    }
+    HandlerBase* handler = rule->Get(path, params);
+    if (handler != nullptr) {
+      return handler;
+    }
+    params.Clear();
+  }
+
+  for (std::size_t i = 0; i < match.params_count; ++i) {
+    params.Set(std::string{match.params[i].first}, std::string{match.params[i].second});
+  }
+  return match.handler;
+}
+
+}  // namespace trpc::http
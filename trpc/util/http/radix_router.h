@@ -0,0 +1,111 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "trpc/util/http/handler.h"
+#include "trpc/util/http/match_rule.h"
+#include "trpc/util/http/parameter.h"
+#include "trpc/util/http/path.h"
+
+namespace trpc::http {
+
+/// @brief Routing rules of one HTTP method, organized as a compressed radix tree.
+///
+/// Rules added by `Path` are compiled into the tree:
+///   - "/api": matches "/api" and "/api/".
+///   - Path("/api").Remainder("path"): matches "/api" and everything below it, the rest of URI path is stored in
+///     parameter "path".
+///   - "<ph(/channels/<channel_id>/clients/<client_id>)>": each placeholder matches one non-empty path segment.
+/// Rules the tree can not express (regular expressions, placeholders not occupying a whole segment, user defined
+/// `MatchRule`) are kept in a fallback list and evaluated by `MatchRule` as before.
+///
+/// A request matching several rules is dispatched to the earliest added one, the same as matching the rules one by
+/// one in insertion order.
+class RadixRouter {
+ public:
+  /// @brief Max number of path parameters of a rule compiled into the tree.
+  static constexpr std::size_t kMaxParams = 16;
+
+  /// @brief Result of looking up the tree.
+  struct Match {
+    HandlerBase* handler{nullptr};
+    /// Insertion sequence of the matched rule.
+    uint64_t seq{std::numeric_limits<uint64_t>::max()};
+    std::size_t params_count{0};
+    /// Name and value of the path parameters, values refer to the URI path being looked up.
+    std::pair<std::string_view, std::string_view> params[kMaxParams];
+  };
+
+  RadixRouter();
+  ~RadixRouter();
+
+  RadixRouter(const RadixRouter&) = delete;
+  RadixRouter& operator=(const RadixRouter&) = delete;
+
+  /// @brief Adds a rule matching `path`.
+  void Add(const Path& path, std::shared_ptr<HandlerBase> handler);
+
+  /// @brief Adds a user defined rule, it's always evaluated by `MatchRule::Get`.
+  void Add(std::shared_ptr<MatchRule> rule);
+
+  /// @brief Looks up the rules compiled into the tree, it allocates nothing.
+  /// @param path is the URI path.
+  /// @param match is the matched result, values of path parameters refer to `path`.
+  /// @return Returns true if a rule is matched.
+  bool Find(std::string_view path, Match* match) const;
+
+  /// @brief Gets the handler of the earliest added rule matching `path`, and fills the path parameters.
+  /// @return Returns nullptr if no rule matches.
+  HandlerBase* Get(const std::string& path, Parameters& params) const;
+
+  /// @brief Returns the number of rules evaluated by `MatchRule`.
+  std::size_t FallbackRulesCount() const { return fallback_rules_.size(); }
+
+ private:
+  struct Leaf;
+  struct Node;
+
+  // Where the URI path should end relative to the end of a rule.
+  enum LeafKind : uint8_t {
+    kStrict = 0,  // Ends with the rule, placeholder rules.
+    kLoose,       // Ends with the rule, a trailing slash is permitted, plain string rules.
+    kPrefix,      // Ends with the rule or continues with a slash, rules having remainder parameter.
+    kLeafKindNum,
+  };
+
+  // Compiles `path` into the tree, returns false if it can not be expressed by the tree.
+  bool Compile(const Path& path, const std::shared_ptr<HandlerBase>& handler, uint64_t seq);
+
+  void Search(const Node* node, std::string_view path, std::size_t pos, std::string_view* captures,
+              std::size_t captures_count, Match* match) const;
+
+  static void Accept(const Leaf* leaf, std::string_view* captures, std::size_t captures_count,
+                     std::string_view remainder, Match* match);
+
+ private:
+  std::unique_ptr<Node> root_;
+  std::vector<std::pair<uint64_t, std::shared_ptr<MatchRule>>> fallback_rules_;
+  uint64_t next_seq_{0};
+};
+
+}  // namespace trpc::http
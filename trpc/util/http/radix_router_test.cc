@@ -0,0 +1,160 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/util/http/radix_router.h"
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+namespace {
+
+class TestHandler : public http::HandlerBase {
+ public:
+  Status Handle(const std::string& path, ServerContextPtr context, http::RequestPtr req,
+                http::Response* rsp) override {
+    return kDefaultStatus;
+  }
+};
+
+}  // namespace
+
+class RadixRouterTest : public ::testing::Test {
+ protected:
+  http::HandlerBase* Get(const std::string& path) {
+    params_.Clear();
+    return router_.Get(path, params_);
+  }
+
+  std::shared_ptr<http::HandlerBase> Handler() { return std::make_shared<TestHandler>(); }
+
+ protected:
+  http::RadixRouter router_;
+  http::Parameters params_;
+};
+
+TEST_F(RadixRouterTest, StaticPath) {
+  auto h0 = Handler();
+  auto h1 = Handler();
+  auto h2 = Handler();
+  router_.Add(http::Path("/api/user"), h0);
+  router_.Add(http::Path("/api/users"), h1);
+  router_.Add(http::Path("/api"), h2);
+  ASSERT_EQ(0, router_.FallbackRulesCount());
+
+  ASSERT_EQ(h0.get(), Get("/api/user"));
+  ASSERT_EQ(h0.get(), Get("/api/user/"));
+  ASSERT_EQ(h1.get(), Get("/api/users"));
+  ASSERT_EQ(h2.get(), Get("/api"));
+  ASSERT_EQ(h2.get(), Get("/api/"));
+  ASSERT_EQ(nullptr, Get("/api/use"));
+  ASSERT_EQ(nullptr, Get("/api/user/1"));
+  ASSERT_EQ(nullptr, Get("/apix"));
+  ASSERT_EQ(nullptr, Get("/"));
+}
+
+TEST_F(RadixRouterTest, Remainder) {
+  auto h0 = Handler();
+  auto h1 = Handler();
+  router_.Add(http::Path("/static").Remainder("file"), h0);
+  router_.Add(http::Path("").Remainder("path"), h1);
+  ASSERT_EQ(0, router_.FallbackRulesCount());
+
+  ASSERT_EQ(h0.get(), Get("/static/css/main.css"));
+  ASSERT_EQ("/css/main.css", params_.At("file"));
+  ASSERT_EQ(h0.get(), Get("/static"));
+  ASSERT_EQ("", params_.At("file"));
+  ASSERT_EQ(h1.get(), Get("/staticx"));
+  ASSERT_EQ("/staticx", params_.At("path"));
+}
+
+TEST_F(RadixRouterTest, Placeholder) {
+  auto h0 = Handler();
+  auto h1 = Handler();
+  auto h2 = Handler();
+  router_.Add(http::Path("<ph(/channels/<channel_id>/clients/<client_id>)>"), h0);
+  router_.Add(http::Path("<ph(/channels/<id>)>"), h1);
+  router_.Add(http::Path("<ph(/channels/<id>/clients)>"), h2);
+  ASSERT_EQ(0, router_.FallbackRulesCount());
+
+  ASSERT_EQ(h0.get(), Get("/channels/abc/clients/123"));
+  ASSERT_EQ("abc", params_.Path("channel_id"));
+  ASSERT_EQ("123", params_.Path("client_id"));
+  ASSERT_EQ(h1.get(), Get("/channels/abc"));
+  ASSERT_EQ("abc", params_.Path("id"));
+  ASSERT_EQ(h2.get(), Get("/channels/abc/clients"));
+  ASSERT_EQ("abc", params_.Path("id"));
+  ASSERT_EQ(nullptr, Get("/channels/abc/"));
+  ASSERT_EQ(nullptr, Get("/channels//clients/123"));
+  ASSERT_EQ(nullptr, Get("/channels/abc/clients/123/"));
+}
+
+TEST_F(RadixRouterTest, InsertionOrder) {
+  auto h0 = Handler();
+  auto h1 = Handler();
+  auto h2 = Handler();
+  router_.Add(http::Path("<ph(/users/<id>)>"), h0);
+  router_.Add(http::Path("/users/me"), h1);
+  router_.Add(http::Path("/users").Remainder("path"), h2);
+
+  // The placeholder rule is added earlier than the static one.
+  ASSERT_EQ(h0.get(), Get("/users/me"));
+  ASSERT_EQ("me", params_.Path("id"));
+  ASSERT_EQ(h1.get(), Get("/users/me/"));
+  ASSERT_EQ(h2.get(), Get("/users/me/profile"));
+  ASSERT_EQ("/me/profile", params_.Path("path"));
+}
+
+TEST_F(RadixRouterTest, Fallback) {
+  auto h0 = Handler();
+  auto h1 = Handler();
+  auto h2 = Handler();
+  auto h3 = Handler();
+  router_.Add(http::Path("/exact"), h0);
+  router_.Add(http::Path("<regex(^/v[0-9]+/.*$)>"), h1);
+  router_.Add(http::Path("<ph(/files/<name>.json)>"), h2);
+  router_.Add(http::Path("/v1/later"), h3);
+  ASSERT_EQ(2, router_.FallbackRulesCount());
+
+  ASSERT_EQ(h0.get(), Get("/exact"));
+  ASSERT_EQ(h1.get(), Get("/v2/abc"));
+  // Added later than the regular expression rule.
+  ASSERT_EQ(h1.get(), Get("/v1/later"));
+  ASSERT_EQ(h2.get(), Get("/files/a.json"));
+  ASSERT_EQ("a", params_.Path("name"));
+  ASSERT_EQ(nullptr, Get("/files/a"));
+}
+
+TEST_F(RadixRouterTest, FindWithoutCopy) {
+  auto h0 = Handler();
+  router_.Add(http::Path("<ph(/a/<x>/b/<y>)>"), h0);
+
+  std::string path = "/a/1/b/22";
+  http::RadixRouter::Match match;
+  ASSERT_TRUE(router_.Find(path, &match));
+  ASSERT_EQ(h0.get(), match.handler);
+  ASSERT_EQ(2, match.params_count);
+  ASSERT_EQ("x", match.params[0].first);
+  ASSERT_EQ("1", match.params[0].second);
+  ASSERT_EQ(path.data() + 3, match.params[0].second.data());
+  ASSERT_EQ("y", match.params[1].first);
+  ASSERT_EQ("22", match.params[1].second);
+
+  http::RadixRouter::Match no_match;
+  ASSERT_FALSE(router_.Find("/a/1/b", &no_match));
+}
+
+}  // namespace trpc::testing
@@ -28,17 +28,13 @@ namespace trpc::http {
 // https://github.com/scylladb/seastar/blob/seastar-22.11.0/src/http/routes.cc.
 
 Routes& Routes::Add(std::shared_ptr<MatchRule> rule, MethodType type) {
-  rules_[type].push_back(std::move(rule));
+  rules_[type].Add(std::move(rule));
   return *this;
 }
 
 Routes& Routes::Add(MethodType type, const http::Path& path, std::shared_ptr<HandlerBase> handler) {
-  auto rule = std::make_shared<MatchRule>(std::move(handler));
-  rule->AddString(path.GetPath());
-  if (!path.GetParam().empty()) {
-    rule->AddParam(path.GetParam(), true);
-  }
-  return Add(std::move(rule), type);
+  rules_[type].Add(path, std::move(handler));
+  return *this;
 }
 
 HandlerBase* Routes::GetHandler(MethodType type, const std::string& path, Parameters& params) {
@@ -46,14 +42,7 @@ HandlerBase* Routes::GetHandler(MethodType type, const std::string& path, Parame
   if (handler != nullptr) {
     return handler;
   }
-  for (const auto& rule : rules_[type]) {
-    handler = rule->Get(path, params);
-    if (handler != nullptr) {
-      return handler;
-    }
-    params.Clear();
-  }
-  return nullptr;
+  return rules_[type].Get(path, params);
 }
 
 HandlerBase* Routes::GetHandler(const std::string& path, RequestPtr& req) {
@@ -29,6 +29,7 @@
 #include "trpc/util/http/method.h"
 #include "trpc/util/http/parameter.h"
 #include "trpc/util/http/path.h"
+#include "trpc/util/http/radix_router.h"
 #include "trpc/util/http/request.h"
 #include "trpc/util/http/response.h"
 #include "trpc/util/http/util.h"
@@ -44,7 +45,8 @@ namespace http {
 // https://github.com/scylladb/seastar/blob/seastar-22.11.0/include/seastar/http/routes.hh.
 
 /// @brief Dispatches requests based on URL. Performs extract matching first (Leading slash is permitted),
-/// and if it fails, matches one by one according to the order of the routing rules (Insertion order).
+/// and if it fails, dispatches to the earliest added routing rule that matches (Insertion order). Routing rules are
+/// organized as a radix tree, see `RadixRouter`.
 class Routes {
  public:
   /// @brief Adds a matching rule which is only used when the extract matching rule is not found, and is searched
@@ -133,7 +135,7 @@ class Routes {
 
  private:
   std::unordered_map<std::string, std::shared_ptr<HandlerBase>> exact_rules_[MethodType::UNKNOWN+1];
-  std::vector<std::shared_ptr<MatchRule>> rules_[MethodType::UNKNOWN+1];
+  RadixRouter rules_[MethodType::UNKNOWN+1];
 };
 
 using HttpRoutes = Routes;
@@ -233,7 +233,7 @@ SharedNothingPoolImp<T>::~SharedNothingPoolImp() {
     if (slot_chunk.freeslot.length == chunk_size_) {
       free_chunk_count++;
       free(slot_chunk.chunk_addr);
-      current_slot_num_.fetch_sub(chunk_size_, std::memory_order::memory_order_relaxed);
+      current_slot_num_.fetch_sub(chunk_size_, std::memory_order_relaxed);
     } else {
       TRPC_FMT_ERROR("Memory leak, chunk_id = {}, chunk_addr = {}", chunk_id, slot_chunk.chunk_addr);
     }
@@ -267,7 +267,7 @@ T* SharedNothingPoolImp<T>::New() {
     }
 
     // If slot_chunk_manager_ cannot allocate goal number of targets, then allocate from the system.
-    uint32_t current_slot_num = current_slot_num_.load(std::memory_order::memory_order_relaxed);
+    uint32_t current_slot_num = current_slot_num_.load(std::memory_order_relaxed);
     while (freeslots_.length < goal_num_ && current_slot_num < max_slot_num_) {
       void* chunk_addr = aligned_alloc(alignof(Slot<T>), sizeof(Slot<T>) * chunk_size_);
       if (TRPC_UNLIKELY(chunk_addr == nullptr)) {
@@ -293,7 +293,7 @@ T* SharedNothingPoolImp<T>::New() {
 
       // Increment the allocation count in data statistics.
       ++GetTlsStatistics<T>().slot_chunks_alloc_num;
-      current_slot_num_.fetch_add(chunk_size_, std::memory_order::memory_order_relaxed);
+      current_slot_num_.fetch_add(chunk_size_, std::memory_order_relaxed);
     }
   }
 
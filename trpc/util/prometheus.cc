@@ -16,6 +16,7 @@
 
 #include "trpc/admin/base_funcs.h"
 #include "trpc/util/log/logging.h"
+#include "trpc/util/prometheus_bound_metrics.h"
 
 namespace trpc::prometheus {
 
@@ -100,6 +101,7 @@ std::once_flag init_flag;
 std::vector<::prometheus::MetricFamily> Collect() {
   std::call_once(init_flag, InitProcessMetrics);
   UpdateProcessMetric();
+  FlushBoundMetrics();
   return collector->Collect();
 }
 
@@ -31,7 +31,7 @@ namespace trpc::prometheus {
 /// @return Returns The globally default used registry.
 std::shared_ptr<::prometheus::Registry> GetRegistry();
 
-/// @brief Gets monitoring data collected by Prometheus.
+/// @brief Gets monitoring data collected by Prometheus, updates of bound metrics are merged first.
 std::vector<::prometheus::MetricFamily> Collect();
 
 /// @brief Gets a counter type monitoring family.
@@ -0,0 +1,183 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
+#include "trpc/util/prometheus_bound_metrics.h"
+
+#include <utility>
+
+#include "trpc/util/internal/never_destroyed.h"
+
+namespace trpc::prometheus {
+
+namespace detail {
+
+std::size_t AllocateBoundMetricIndex() {
+  static std::atomic<std::size_t> next_index{0};
+  return next_index.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace detail
+
+namespace {
+
+// Registers `shard` as the shard of the bound metric `index` of current thread.
+void SetLocalShard(std::size_t index, void* shard) {
+  auto& shards = detail::GetLocalBoundMetricShards();
+  if (shards.size() <= index) {
+    shards.resize(index + 1, nullptr);
+  }
+  shards[index] = shard;
+}
+
+::prometheus::Histogram::BucketBoundaries GetBucketBoundaries(::prometheus::Histogram* histogram) {
+  ::prometheus::Histogram::BucketBoundaries buckets;
+  const auto& collected = histogram->Collect().histogram.bucket;
+  // The last bucket is the implicit +Inf one.
+  for (std::size_t i = 0; i + 1 < collected.size(); ++i) {
+    buckets.push_back(collected[i].upper_bound);
+  }
+  return buckets;
+}
+
+struct BoundMetricsRegistry {
+  std::mutex mutex;
+  // Keyed by the underlying metric, which the family returns the same for the same labels.
+  std::map<::prometheus::Counter*, std::unique_ptr<BoundCounter>> counters;
+  std::map<::prometheus::Histogram*, std::unique_ptr<BoundHistogram>> histograms;
+};
+
+BoundMetricsRegistry* GetBoundMetricsRegistry() {
+  // Never destroyed, bound metrics may be updated by threads still running during process exit.
+  static internal::NeverDestroyed<BoundMetricsRegistry> registry;
+  return registry.Get();
+}
+
+}  // namespace
+
+BoundCounter::BoundCounter(::prometheus::Counter* counter)
+    : counter_(counter), index_(detail::AllocateBoundMetricIndex()) {}
+
+BoundCounter::Shard* BoundCounter::AddShard() {
+  auto shard = std::make_unique<Shard>();
+  Shard* ptr = shard.get();
+  {
+    std::scoped_lock _(mutex_);
+    shards_.push_back(std::move(shard));
+  }
+  SetLocalShard(index_, ptr);
+  return ptr;
+}
+
+void BoundCounter::Flush() {
+  double total = 0;
+  {
+    std::scoped_lock _(mutex_);
+    for (auto& shard : shards_) {
+      total += shard->value.load(std::memory_order_relaxed);
+    }
+  }
+  // Rounding may make the sum of shards go backwards slightly, counters never do.
+  if (total > flushed_) {
+    counter_->Increment(total - flushed_);
+    flushed_ = total;
+  }
+}
+
+BoundHistogram::BoundHistogram(::prometheus::Histogram* histogram)
+    : histogram_(histogram),
+      buckets_(GetBucketBoundaries(histogram)),
+      index_(detail::AllocateBoundMetricIndex()),
+      flushed_counts_(buckets_.size() + 1, 0) {}
+
+BoundHistogram::Shard* BoundHistogram::AddShard() {
+  auto shard = std::make_unique<Shard>(buckets_.size() + 1);
+  Shard* ptr = shard.get();
+  {
+    std::scoped_lock _(mutex_);
+    shards_.push_back(std::move(shard));
+  }
+  SetLocalShard(index_, ptr);
+  return ptr;
+}
+
+void BoundHistogram::Flush() {
+  std::vector<std::uint64_t> counts(buckets_.size() + 1, 0);
+  double sum = 0;
+  {
+    std::scoped_lock _(mutex_);
+    for (auto& shard : shards_) {
+      for (std::size_t i = 0; i != counts.size(); ++i) {
+        counts[i] += shard->counts[i].load(std::memory_order_relaxed);
+      }
+      sum += shard->sum.load(std::memory_order_relaxed);
+    }
+  }
+
+  std::vector<double> increments(counts.size(), 0);
+  bool changed = false;
+  for (std::size_t i = 0; i != counts.size(); ++i) {
+    // The count and the sum of a shard are not updated atomically as a whole, a count read before its increment is
+    // stored is simply merged by the next flush.
+    if (counts[i] > flushed_counts_[i]) {
+      increments[i] = static_cast<double>(counts[i] - flushed_counts_[i]);
+      flushed_counts_[i] = counts[i];
+      changed = true;
+    }
+  }
+  if (!changed) {
+    return;
+  }
+  histogram_->ObserveMultiple(increments, sum - flushed_sum_);
+  flushed_sum_ = sum;
+}
+
+BoundCounter* GetBoundCounter(::prometheus::Family<::prometheus::Counter>* family,
+                              const std::map<std::string, std::string>& labels) {
+  ::prometheus::Counter* counter = &family->Add(labels);
+  auto* registry = GetBoundMetricsRegistry();
+  std::scoped_lock _(registry->mutex);
+  auto& bound = registry->counters[counter];
+  if (!bound) {
+    bound = std::make_unique<BoundCounter>(counter);
+  }
+  return bound.get();
+}
+
+BoundHistogram* GetBoundHistogram(::prometheus::Family<::prometheus::Histogram>* family,
+                                  const std::map<std::string, std::string>& labels,
+                                  const ::prometheus::Histogram::BucketBoundaries& buckets) {
+  ::prometheus::Histogram* histogram = &family->Add(labels, buckets);
+  auto* registry = GetBoundMetricsRegistry();
+  std::scoped_lock _(registry->mutex);
+  auto& bound = registry->histograms[histogram];
+  if (!bound) {
+    bound = std::make_unique<BoundHistogram>(histogram);
+  }
+  return bound.get();
+}
+
+void FlushBoundMetrics() {
+  auto* registry = GetBoundMetricsRegistry();
+  // Also serializes flushes from scraping and pushing.
+  std::scoped_lock _(registry->mutex);
+  for (auto& counter : registry->counters) {
+    counter.second->Flush();
+  }
+  for (auto& histogram : registry->histograms) {
+    histogram.second->Flush();
+  }
+}
+
+}  // namespace trpc::prometheus
+#endif
@@ -0,0 +1,169 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "prometheus/counter.h"
+#include "prometheus/family.h"
+#include "prometheus/histogram.h"
+
+#include "trpc/util/align.h"
+#include "trpc/util/likely.h"
+
+namespace trpc::prometheus {
+
+/// @private
+namespace detail {
+
+/// @brief Allocates the index of a bound metric in the thread-local shard tables. Bound metrics are never destroyed,
+///        so indexes are never reused.
+std::size_t AllocateBoundMetricIndex();
+
+/// @brief Gets the shards of bound metrics owned by current thread, indexed by the index of each bound metric.
+inline std::vector<void*>& GetLocalBoundMetricShards() {
+  thread_local std::vector<void*> shards;
+  return shards;
+}
+
+}  // namespace detail
+
+/// @brief A counter bound to a label set of a counter family.
+///        Increments go to a shard owned by the calling thread with plain loads and stores, and are merged into the
+///        underlying counter by `FlushBoundMetrics`, which runs on every collection.
+/// @note Obtained by `GetBoundCounter`, it lives as long as the process.
+class BoundCounter {
+ public:
+  explicit BoundCounter(::prometheus::Counter* counter);
+
+  /// @brief Increments the counter by `value`, which must not be negative.
+  void Increment(double value = 1) noexcept {
+    Shard* shard = GetShard();
+    shard->value.store(shard->value.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+  }
+
+  /// @brief Merges the increments made since the last flush into the underlying counter.
+  void Flush();
+
+ private:
+  struct alignas(hardware_destructive_interference_size) Shard {
+    std::atomic<double> value{0};
+  };
+
+  Shard* GetShard() noexcept {
+    auto& shards = detail::GetLocalBoundMetricShards();
+    if (TRPC_LIKELY(index_ < shards.size() && shards[index_])) {
+      return static_cast<Shard*>(shards[index_]);
+    }
+    return AddShard();
+  }
+
+  Shard* AddShard();
+
+ private:
+  ::prometheus::Counter* counter_;
+
+  const std::size_t index_;
+
+  // Protects `shards_`, taken on the first update of each thread and on flush.
+  std::mutex mutex_;
+
+  // Shards are owned here rather than by the threads, so increments of exited threads are not lost.
+  std::vector<std::unique_ptr<Shard>> shards_;
+
+  double flushed_{0};
+};
+
+/// @brief A histogram bound to a label set of a histogram family, see `BoundCounter` for how updates are aggregated.
+/// @note Obtained by `GetBoundHistogram`, it lives as long as the process.
+class BoundHistogram {
+ public:
+  explicit BoundHistogram(::prometheus::Histogram* histogram);
+
+  /// @brief Observes `value`, the bucket is chosen in the same way as `::prometheus::Histogram::Observe`.
+  void Observe(double value) noexcept {
+    std::size_t bucket = std::lower_bound(buckets_.begin(), buckets_.end(), value) - buckets_.begin();
+    Shard* shard = GetShard();
+    auto& count = shard->counts[bucket];
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    shard->sum.store(shard->sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+  }
+
+  /// @brief Merges the observations made since the last flush into the underlying histogram.
+  void Flush();
+
+ private:
+  struct alignas(hardware_destructive_interference_size) Shard {
+    explicit Shard(std::size_t bucket_num) : counts(new std::atomic<std::uint64_t>[bucket_num]()) {}
+
+    std::atomic<double> sum{0};
+    std::unique_ptr<std::atomic<std::uint64_t>[]> counts;
+  };
+
+  Shard* GetShard() noexcept {
+    auto& shards = detail::GetLocalBoundMetricShards();
+    if (TRPC_LIKELY(index_ < shards.size() && shards[index_])) {
+      return static_cast<Shard*>(shards[index_]);
+    }
+    return AddShard();
+  }
+
+  Shard* AddShard();
+
+ private:
+  ::prometheus::Histogram* histogram_;
+
+  // Taken from the underlying histogram, which may have been created with other boundaries than the binder asked.
+  const ::prometheus::Histogram::BucketBoundaries buckets_;
+
+  const std::size_t index_;
+
+  std::mutex mutex_;
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+
+  // Per bucket counts and sum merged so far, the last bucket is the implicit +Inf one.
+  std::vector<std::uint64_t> flushed_counts_;
+  double flushed_sum_{0};
+};
+
+/// @brief Binds the counter of `family` with `labels`.
+/// @return Returns the same handle for the same family and labels. Takes locks, callers on hot paths are expected to
+///         cache the result.
+BoundCounter* GetBoundCounter(::prometheus::Family<::prometheus::Counter>* family,
+                              const std::map<std::string, std::string>& labels);
+
+/// @brief Binds the histogram of `family` with `labels`, `buckets` is only used when the histogram is created.
+/// @return Returns the same handle for the same family and labels. Takes locks, callers on hot paths are expected to
+///         cache the result.
+BoundHistogram* GetBoundHistogram(::prometheus::Family<::prometheus::Histogram>* family,
+                                  const std::map<std::string, std::string>& labels,
+                                  const ::prometheus::Histogram::BucketBoundaries& buckets);
+
+/// @brief Merges the updates of all bound metrics into their underlying metrics.
+/// @note Called by `Collect` and before pushing to the gateway, users reading the underlying metrics directly should
+///       call it first.
+void FlushBoundMetrics();
+
+}  // namespace trpc::prometheus
+#endif
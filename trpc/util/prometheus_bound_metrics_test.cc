@@ -0,0 +1,85 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 Tencent.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
+#include "trpc/util/prometheus_bound_metrics.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+TEST(BoundMetricsTest, BoundCounter) {
+  ::prometheus::Family<::prometheus::Counter> family("bound_counter", "help", {});
+  auto* bound = trpc::prometheus::GetBoundCounter(&family, {{"k", "v"}});
+  ASSERT_EQ(bound, trpc::prometheus::GetBoundCounter(&family, {{"k", "v"}}));
+  ASSERT_NE(bound, trpc::prometheus::GetBoundCounter(&family, {{"k", "w"}}));
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i != 4; ++i) {
+    threads.emplace_back([bound] {
+      for (int j = 0; j != 1000; ++j) {
+        bound->Increment();
+      }
+    });
+  }
+  bound->Increment(2);
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  // Nothing is visible before flush, increments of exited threads are not lost.
+  auto& counter = family.Add({{"k", "v"}});
+  ASSERT_EQ(0, counter.Value());
+  trpc::prometheus::FlushBoundMetrics();
+  ASSERT_EQ(4002, counter.Value());
+
+  bound->Increment();
+  trpc::prometheus::FlushBoundMetrics();
+  trpc::prometheus::FlushBoundMetrics();
+  ASSERT_EQ(4003, counter.Value());
+}
+
+TEST(BoundMetricsTest, BoundHistogram) {
+  ::prometheus::Family<::prometheus::Histogram> family("bound_histogram", "help", {});
+  auto* bound = trpc::prometheus::GetBoundHistogram(&family, {{"k", "v"}}, {1, 10});
+  // The boundaries of the existing histogram are kept.
+  ASSERT_EQ(bound, trpc::prometheus::GetBoundHistogram(&family, {{"k", "v"}}, {5}));
+
+  std::thread([bound] { bound->Observe(1); }).join();
+  bound->Observe(5);
+  bound->Observe(20);
+
+  auto& histogram = family.Add({{"k", "v"}}, ::prometheus::Histogram::BucketBoundaries{1, 10});
+  trpc::prometheus::FlushBoundMetrics();
+  auto collected = histogram.Collect().histogram;
+  ASSERT_EQ(3, collected.sample_count);
+  ASSERT_EQ(26, collected.sample_sum);
+  ASSERT_EQ(3, collected.bucket.size());
+  ASSERT_EQ(1, collected.bucket[0].cumulative_count);
+  ASSERT_EQ(2, collected.bucket[1].cumulative_count);
+  ASSERT_EQ(3, collected.bucket[2].cumulative_count);
+
+  bound->Observe(2);
+  trpc::prometheus::FlushBoundMetrics();
+  collected = histogram.Collect().histogram;
+  ASSERT_EQ(4, collected.sample_count);
+  ASSERT_EQ(28, collected.sample_sum);
+  ASSERT_EQ(1, collected.bucket[0].cumulative_count);
+  ASSERT_EQ(3, collected.bucket[1].cumulative_count);
+}
+
+}  // namespace trpc::testing
+#endif
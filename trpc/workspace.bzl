@@ -110,6 +110,21 @@ def trpc_workspace(path_prefix = "", repo_name = "", **kwargs):
         urls = com_github_lz4_lz4_urls,
     )
 
+    # com_github_facebook_zstd
+    com_github_facebook_zstd_ver = kwargs.get("com_github_facebook_zstd_ver", "1.5.5")
+    com_github_facebook_zstd_sha256 = kwargs.get("com_github_facebook_zstd_sha256", "9c4396cc829cfae319a6e2615202e82aad41372073482fce286fac78646d3ee4")
+    com_github_facebook_zstd_name = "zstd-{ver}".format(ver = com_github_facebook_zstd_ver)
+    com_github_facebook_zstd_urls = [
+        "https://github.com/facebook/zstd/releases/download/v{ver}/zstd-{ver}.tar.gz".format(ver = com_github_facebook_zstd_ver),
+    ]
+    http_archive(
+        name = "com_github_facebook_zstd",
+        build_file = clean_dep("//third_party/com_github_facebook_zstd:zstd.BUILD"),
+        sha256 = com_github_facebook_zstd_sha256,
+        strip_prefix = com_github_facebook_zstd_name,
+        urls = com_github_facebook_zstd_urls,
+    )
+
     # protobuf version and summary
     com_google_protobuf_ver = kwargs.get("com_google_protobuf_ver", "3.15.8")
     com_google_protobuf_sha256 = kwargs.get("com_google_protobuf_sha256", "0cbdc9adda01f6d2facc65a22a2be5cecefbefe5a09e5382ee8879b522c04441")
@@ -137,6 +152,19 @@ def trpc_workspace(path_prefix = "", repo_name = "", **kwargs):
         urls = com_google_googletest_urls,
     )
 
+    # com_github_google_benchmark
+    com_github_google_benchmark_ver = kwargs.get("com_github_google_benchmark_ver", "1.7.1")
+    com_github_google_benchmark_sha256 = kwargs.get("com_github_google_benchmark_sha256", "6430e4092653380d9dc4ccb45a1e2dc9259d581f4866dc0759713126056bc1d7")
+    com_github_google_benchmark_urls = [
+        "https://github.com/google/benchmark/archive/v{ver}.tar.gz".format(ver = com_github_google_benchmark_ver),
+    ]
+    http_archive(
+        name = "com_github_google_benchmark",
+        sha256 = com_github_google_benchmark_sha256,
+        strip_prefix = "benchmark-{ver}".format(ver = com_github_google_benchmark_ver),
+        urls = com_github_google_benchmark_urls,
+    )
+
     # com_github_gflags_gflags
     com_github_gflags_gflags_ver = kwargs.get("com_github_gflags_gflags_ver", "2.2.2")
     com_github_gflags_gflags_sha256 = kwargs.get("com_github_gflags_gflags_sha256", "34af2f15cf7367513b352bdcd2493ab14ce43692d2dcd9dfc499492966c64dcf")